@@ -36,6 +36,15 @@
 #define KEY_RELEASED_NOTIFICATION_VALUE       	(0x02u)
 #define KEY_PRESSED_LONG_NOTIFICATION_VALUE   	(0x04u)
 #define KEY_RELEASED_LONG_NOTIFICATION_VALUE  	(0x08u)
+#define DRV_SCR_DONE_NOTIFICATION_VALUE       	(0x10u)
+#define DRV_SCR_ABORT_NOTIFICATION_VALUE      	(0x20u)
+#define DRV_MOVE_DONE_NOTIFICATION_VALUE      	(0x40u)
+#define DRV_TURNED_NOTIFICATION_VALUE         	(0x80u)
+#define DRV_STOP_DONE_NOTIFICATION_VALUE      	(0x100u)
+#define DRV_STOP_TIMEOUT_NOTIFICATION_VALUE   	(0x200u)
+
+#define KEY_NOTIFICATION_MSK                  	(0x0Fu)  /* bits of the notifications of the key */
+#define DRV_NOTIFICATION_MSK                  	(0x3F0u) /* bits of the notifications of the drive */
 
 #define CAU_SUMO_PLT_MOTOR_LEFT_INVERTED 		(TRUE)
 #define CAU_SUMO_PLT_MOTOR_RIGHT_INVERTED 		(TRUE)
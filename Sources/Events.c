@@ -36,6 +36,9 @@ extern "C" {
 
 /* User includes (#include below this line is not maintained by Processor Expert) */
 #include "Tacho.h"
+#include "tacho_cfg.h"
+#include "drv_cfg.h"
+#include "drv_isr.h"
 #include "rte.h"
 #include "task_api.h"
 #include "Platform.h"
@@ -302,8 +305,13 @@ void KEY1_OnKeyPressedLong(uint8_t keys)
 */
 void QuadInt_OnInterrupt(void)
 {
+#if !TACHO_USES_FTM_QD
   Q4CLeft_Sample();
   Q4CRight_Sample();
+#endif
+#if DRV_USES_ISR_LOOP
+  DRV_Isr_Step();
+#endif
   /* Write your code here ... */
 }
 
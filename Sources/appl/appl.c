@@ -209,8 +209,9 @@ static inline StdRtn_t Sync_StateMachineWithISR()
   CS1_CriticalVariable();
 
   CS1_EnterCritical();
+  /* only the key notifications are cleared, the drive notifications are read by the ASW */
   notfRes = FRTOS1_xTaskNotifyWait( pdFALSE,
-				    UINT32_MAX,
+				    KEY_NOTIFICATION_MSK,
 				    (uint32_t *)&notfVal,
 				    pdMS_TO_TICKS( 0u ) );
 
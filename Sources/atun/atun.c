@@ -0,0 +1,730 @@
+/***********************************************************************************************//**
+ * @file		atun.c
+ * @ingroup		atun
+ * @brief 		Implementation of a relay autotuner for the PID controllers of the SWC @ref drv
+ *
+ * This module runs a relay experiment according to Astroem and Haegglund on one item of
+ * atun_cfg.c. The control value switches between bias+amp and bias-amp depending on the sign of
+ * the control error, which leads to a limit cycle of the controlled variable. After some settling
+ * periods the period and the peak-to-peak value of the oscillation are averaged. They yield the
+ * ultimate period Tu and, by the describing function of a relay with hysteresis, the ultimate gain
+ * Ku = 4*amp / (pi*sqrt(a^2 - hyst^2)). The PID gains are calculated from Ku and Tu by the selected
+ * tuning rule and are converted into the decimal scaled representation of the SWC @ref pid. They are
+ * applied and saved to the @ref nvm on request only.\n
+ * The step experiment verifies the tuning. It closes the loops of the step items by their PID items
+ * without feedforward, applies a step to the desired value and passes the samples to the step
+ * response analyzer of atun_step.c.\n
+ * The linearization experiment sweeps the duty cycle of a motor, bypassing its linearization table,
+ * and measures the steady-state speed at each point. atun_lin.c calculates the new table from the
+ * speeds, which is applied and saved on request only.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	20.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#define MASTER_atun_C_
+
+/*======================================= >> #INCLUDES << ========================================*/
+#include "atun.h"
+#include "atun_api.h"
+#include "atun_cfg.h"
+#include "atun_step.h"
+#include "atun_lin.h"
+#include "drv_api.h"
+#include "pid_cfg.h"
+#include "pid_api.h"
+#include "nvm_api.h"
+#include "mtx_api.h"
+
+
+
+/*======================================= >> #DEFINES << =========================================*/
+/**
+ * Number of oscillation periods which are ignored until the limit cycle has settled
+ */
+#define ATUN_SETTLE_PER_CNT		(2u)
+
+/**
+ * Number of oscillation periods which are averaged
+ */
+#define ATUN_MEAS_PER_CNT		(4u)
+
+/**
+ * Maximum duration of an experiment in samples, i.e. 10s
+ */
+#define ATUN_TIMEOUT_SMPL_CNT	(10000u / ATUN_SMPL_TIME_MS)
+
+/**
+ * Duration of the step experiment in samples
+ */
+#define ATUN_STEP_SMPL_CNT		(ATUN_STEP_DURATION_MS / ATUN_SMPL_TIME_MS)
+
+/**
+ * Samples per point of the duty sweep until the speed has settled and over which it is averaged
+ */
+#define ATUN_LIN_SETTLE_SMPL_CNT	(ATUN_LIN_SETTLE_MS / ATUN_SMPL_TIME_MS)
+#define ATUN_LIN_MEAS_SMPL_CNT		(ATUN_LIN_MEAS_MS / ATUN_SMPL_TIME_MS)
+
+/**
+ * Approximation of pi as fraction
+ */
+#define ATUN_PI_NUM				(355u)
+#define ATUN_PI_DEN				(113u)
+
+/**
+ * Scaling factors of the gains in descending order of resolution
+ */
+#define ATUN_MAX_SCALE			(100u)
+#define ATUN_GAIN_MAX			(0xFFFFu)
+
+
+
+/*=================================== >> TYPE DEFINITIONS << =====================================*/
+/**
+ * @brief Coefficients of a tuning rule in per mille, Kp = kp*Ku, Ti = ti*Tu, Td = td*Tu
+ */
+typedef struct ATUN_RuleCoef_s
+{
+	uint16_t kp;
+	uint16_t ti;
+	uint16_t td;
+}ATUN_RuleCoef_t;
+
+/**
+ * @brief Kind of the current or last experiment
+ */
+typedef enum ATUN_Exp_e
+{
+	 ATUN_EXP_RELAY = 0
+	,ATUN_EXP_STEP
+	,ATUN_EXP_LIN
+}ATUN_Exp_t;
+
+typedef struct ATUN_Data_s
+{
+	ATUN_State_t state;
+	ATUN_Exp_t exp;
+	bool startReq;
+	bool stepReq;
+	bool linReq;
+	bool abortReq;
+	uint8_t reqItmIdx;
+	ATUN_Rule_t reqRule;
+	const ATUN_Itm_t *pItm;
+	int32_t setVal;
+	int8_t relay;				/**< current relay state, +1 or -1 */
+	uint32_t smplCntr;
+	uint32_t lastSwitch;		/**< sample of the last switch from -1 to +1 */
+	uint8_t perCntr;			/**< number of completed periods */
+	int32_t minVal;
+	int32_t maxVal;
+	uint32_t sumPer;			/**< sum of measured periods in samples */
+	uint32_t sumPtp;			/**< sum of measured peak-to-peak values */
+	bool isRsltAvail;
+	ATUN_Rslt_t rslt;
+	int32_t stepSetVal;			/**< desired value after the step */
+	ATUN_StepAnl_t aStepAnl[ATUN_STEP_CH_CNT];
+	bool isStepRsltAvail;
+	ATUN_StepRslt_t aStepRslt[ATUN_STEP_CH_CNT];
+	const ATUN_LinItm_t *pLinItm;
+	uint8_t linPtIdx;			/**< current point of the duty sweep */
+	int32_t linSpdSum;			/**< sum of the speeds at the current point */
+	bool isLinRsltAvail;
+	ATUN_LinRslt_t linRslt;
+}ATUN_Data_t;
+
+
+
+/*============================= >> LOKAL FUNCTION DECLARATIONS << ================================*/
+static void ATUN_Start(void);
+static void ATUN_Stop(ATUN_State_t state_);
+static void ATUN_Step(void);
+static void ATUN_Ctrl_StepItm(uint8_t ch_, int32_t val_);
+static void ATUN_Start_StepExp(void);
+static void ATUN_Step_StepExp(void);
+static StdRtn_t ATUN_Calc_Gains(void);
+static void ATUN_Start_LinExp(void);
+static void ATUN_Step_LinExp(void);
+static StdRtn_t ATUN_Save_LinRslt(void);
+static void ATUN_Reset_MotLimCnt(void);
+
+
+
+/*=================================== >> GLOBAL VARIABLES << =====================================*/
+static const ATUN_RuleCoef_t ATUN_RuleCoefs[ATUN_RULE_CNT] =
+{
+		{600u,  500u, 125u},	/* ATUN_RULE_ZN_PID */
+		{450u,  833u,   0u},	/* ATUN_RULE_ZN_PI */
+		{455u, 2200u, 159u},	/* ATUN_RULE_TL_PID */
+		{313u, 2200u,   0u},	/* ATUN_RULE_TL_PI */
+		{200u,  500u, 333u},	/* ATUN_RULE_NO_OS */
+};
+
+static ATUN_Data_t data = {ATUN_STATE_IDLE};
+
+
+
+/*============================== >> LOKAL FUNCTION DEFINITIONS << ================================*/
+/**
+ * @brief Resets the counters of the motor limiters, so they count the updates of the experiment
+ */
+static void ATUN_Reset_MotLimCnt(void)
+{
+	MOT_Reset_LimCnt(MOT_GetMotorHandle(MOT_MOTOR_LEFT));
+	MOT_Reset_LimCnt(MOT_GetMotorHandle(MOT_MOTOR_RIGHT));
+}
+
+static void ATUN_Start(void)
+{
+	int32_t val = 0;
+	const ATUN_ItmTbl_t *pTbl = Get_pAtunItmTbl();
+
+	data.pItm = &pTbl->aItms[data.reqItmIdx];
+	(void)data.pItm->readFct(&val);
+	data.setVal      = data.pItm->setVal + ( (TRUE == data.pItm->isRelSetVal) ? val : 0 );
+	data.relay       = 1;
+	data.smplCntr    = 0u;
+	data.lastSwitch  = 0u;
+	data.perCntr     = 0u;
+	data.minVal      = val;
+	data.maxVal      = val;
+	data.sumPer      = 0u;
+	data.sumPtp      = 0u;
+	data.isRsltAvail = FALSE;
+	data.rslt.itmIdx = data.reqItmIdx;
+	data.rslt.rule   = data.reqRule;
+	data.state       = ATUN_STATE_RUN;
+	ATUN_Reset_MotLimCnt();
+}
+
+static void ATUN_Stop(ATUN_State_t state_)
+{
+	const ATUN_ItmTbl_t *pTbl = Get_pAtunItmTbl();
+	uint8_t ch = 0u;
+
+	if( ATUN_EXP_STEP == data.exp )
+	{
+		for(ch = 0u; ch < pTbl->stepCnt; ch++)
+		{
+			pTbl->aItms[pTbl->stepIdx + ch].writeFct(0);
+		}
+	}
+	else if( ATUN_EXP_LIN == data.exp )
+	{
+		data.pLinItm->writeFct(0);
+	}
+	else
+	{
+		data.pItm->writeFct(0);
+	}
+	data.state = state_;
+}
+
+static void ATUN_Step(void)
+{
+	int32_t val = 0, err = 0;
+
+	(void)data.pItm->readFct(&val);
+	err = data.setVal - val;
+
+	if( val < data.minVal )
+	{
+		data.minVal = val;
+	}
+	if( val > data.maxVal )
+	{
+		data.maxVal = val;
+	}
+
+	/* relay with hysteresis */
+	if( ( err > data.pItm->hyst ) && ( data.relay < 0 ) )
+	{
+		data.relay = 1;
+		if( data.perCntr > ATUN_SETTLE_PER_CNT )
+		{
+			data.sumPer += data.smplCntr - data.lastSwitch;
+			data.sumPtp += (uint32_t)(data.maxVal - data.minVal);
+		}
+		data.minVal = val;
+		data.maxVal = val;
+		data.lastSwitch = data.smplCntr;
+		data.perCntr++;
+	}
+	else if( ( err < -data.pItm->hyst ) && ( data.relay > 0 ) )
+	{
+		data.relay = -1;
+	}
+	else
+	{
+		/* keep relay state within hysteresis */
+	}
+
+	data.smplCntr++;
+	if( data.perCntr > ( ATUN_SETTLE_PER_CNT + ATUN_MEAS_PER_CNT ) )
+	{
+		ATUN_Stop( ( ERR_OK == ATUN_Calc_Gains() ) ? ATUN_STATE_DONE : ATUN_STATE_FAILED );
+	}
+	else if( data.smplCntr >= ATUN_TIMEOUT_SMPL_CNT )
+	{
+		ATUN_Stop(ATUN_STATE_FAILED);
+	}
+	else
+	{
+		data.pItm->writeFct(data.pItm->bias + data.relay * data.pItm->amp);
+	}
+}
+
+/**
+ * @brief Calculates the control value of a step item from its PID item and writes it
+ */
+static void ATUN_Ctrl_StepItm(uint8_t ch_, int32_t val_)
+{
+	const ATUN_ItmTbl_t *pTbl = Get_pAtunItmTbl();
+	const ATUN_Itm_t *pItm = &pTbl->aItms[pTbl->stepIdx + ch_];
+	int32_t ctrlVal = 0;
+
+	(void)PID(data.stepSetVal, val_, pItm->pidIdx, &ctrlVal);
+	pItm->writeFct(ctrlVal * pItm->ctrlFactor);
+}
+
+static void ATUN_Start_StepExp(void)
+{
+	const ATUN_ItmTbl_t *pTbl = Get_pAtunItmTbl();
+	int32_t val = 0;
+	uint8_t ch = 0u;
+
+	data.exp             = ATUN_EXP_STEP;
+	data.smplCntr        = 0u;
+	data.isStepRsltAvail = FALSE;
+	data.state           = ATUN_STATE_RUN;
+	ATUN_Reset_MotLimCnt();
+	for(ch = 0u; ch < pTbl->stepCnt; ch++)
+	{
+		(void)pTbl->aItms[pTbl->stepIdx + ch].readFct(&val);
+		(void)PID_Reset(pTbl->aItms[pTbl->stepIdx + ch].pidIdx);
+		ATUN_StepAnl_Init(&data.aStepAnl[ch], val, data.stepSetVal);
+		data.aStepRslt[ch].itmIdx = pTbl->stepIdx + ch;
+		ATUN_Ctrl_StepItm(ch, val);
+	}
+}
+
+static void ATUN_Step_StepExp(void)
+{
+	const ATUN_ItmTbl_t *pTbl = Get_pAtunItmTbl();
+	int32_t val = 0;
+	uint8_t ch = 0u;
+
+	data.smplCntr++;
+	for(ch = 0u; ch < pTbl->stepCnt; ch++)
+	{
+		(void)pTbl->aItms[pTbl->stepIdx + ch].readFct(&val);
+		ATUN_StepAnl_Upd(&data.aStepAnl[ch], val);
+		if( data.smplCntr < ATUN_STEP_SMPL_CNT )
+		{
+			ATUN_Ctrl_StepItm(ch, val);
+		}
+	}
+
+	if( data.smplCntr >= ATUN_STEP_SMPL_CNT )
+	{
+		for(ch = 0u; ch < pTbl->stepCnt; ch++)
+		{
+			ATUN_StepAnl_Get(&data.aStepAnl[ch], ATUN_SMPL_TIME_MS, &data.aStepRslt[ch]);
+		}
+		data.isStepRsltAvail = TRUE;
+		ATUN_Stop(ATUN_STATE_DONE);
+	}
+}
+
+static void ATUN_Start_LinExp(void)
+{
+	data.pLinItm         = &Get_pAtunItmTbl()->aLinItms[data.reqItmIdx];
+	data.exp             = ATUN_EXP_LIN;
+	data.smplCntr        = 0u;
+	data.linPtIdx        = 0u;
+	data.linSpdSum       = 0;
+	data.isLinRsltAvail  = FALSE;
+	data.linRslt.itmIdx  = data.reqItmIdx;
+	data.state           = ATUN_STATE_RUN;
+	ATUN_Reset_MotLimCnt();
+	data.pLinItm->writeFct((int32_t)ATUN_Lin_Get_SweepDuty(data.linPtIdx));
+}
+
+static void ATUN_Step_LinExp(void)
+{
+	int32_t val = 0;
+
+	data.smplCntr++;
+	if( data.smplCntr > ATUN_LIN_SETTLE_SMPL_CNT )
+	{
+		(void)data.pLinItm->readFct(&val);
+		data.linSpdSum += val;
+	}
+
+	if( data.smplCntr >= ATUN_LIN_SETTLE_SMPL_CNT + ATUN_LIN_MEAS_SMPL_CNT )
+	{
+		data.linRslt.aSpd[data.linPtIdx] = data.linSpdSum / (int32_t)ATUN_LIN_MEAS_SMPL_CNT;
+		data.linSpdSum = 0;
+		data.smplCntr  = 0u;
+		data.linPtIdx++;
+		if( data.linPtIdx < ATUN_LIN_PT_CNT )
+		{
+			data.pLinItm->writeFct((int32_t)ATUN_Lin_Get_SweepDuty(data.linPtIdx));
+		}
+		else if( ERR_OK == ATUN_Lin_Calc(data.linRslt.aSpd, data.linRslt.aDuty) )
+		{
+			data.isLinRsltAvail = TRUE;
+			ATUN_Stop(ATUN_STATE_DONE);
+		}
+		else
+		{
+			ATUN_Stop(ATUN_STATE_FAILED);
+		}
+	}
+}
+
+/**
+ * @brief Applies the linearization table to the motor and saves it to the NVM
+ */
+static StdRtn_t ATUN_Save_LinRslt(void)
+{
+	StdRtn_t retVal = ERR_VALUE;
+	NVM_MotLinCfg_t nvmCfg = {0u};
+	uint8_t i = 0u;
+
+	if( ( TRUE == data.isLinRsltAvail ) && ( ATUN_STATE_RUN != data.state ) )
+	{
+		retVal = data.pLinItm->applyFct(data.linRslt.aDuty);
+		if( ( ERR_OK == retVal ) && ( NULL != data.pLinItm->saveFct ) )
+		{
+			nvmCfg.IsEna = TRUE;
+			for(i = 0u; i < ATUN_LIN_PT_CNT; i++)
+			{
+				nvmCfg.aDuty[i] = data.linRslt.aDuty[i];
+			}
+			retVal = data.pLinItm->saveFct(&nvmCfg);
+		}
+	}
+	return retVal;
+}
+
+/**
+ * @brief Calculates ultimate gain and period and derives the gains by the tuning rule.
+ * Time constants are handled in samples, so the gains are valid for the sample time of the
+ * relay experiment.
+ */
+static StdRtn_t ATUN_Calc_Gains(void)
+{
+	StdRtn_t retVal = ERR_RANGE;
+	const ATUN_RuleCoef_t *pCoef = &ATUN_RuleCoefs[data.rslt.rule];
+	uint64_t ampQ8 = 0u, hystQ8 = 0u, kuQ8 = 0u, tuQ8 = 0u, den = 0u;
+	uint64_t kP = 0u, kI = 0u, kD = 0u;
+	uint16_t scale = ATUN_MAX_SCALE;
+
+	/* amplitude and period as Q8 */
+	ampQ8  = ( (uint64_t)data.sumPtp << 8 ) / ( 2u * ATUN_MEAS_PER_CNT );
+	hystQ8 = (uint64_t)data.pItm->hyst << 8;
+	tuQ8   = ( (uint64_t)data.sumPer << 8 ) / ATUN_MEAS_PER_CNT;
+
+	if( ( ampQ8 > hystQ8 ) && ( 0u != tuQ8 ) )
+	{
+		ampQ8 = MTX_ISqrt(ampQ8*ampQ8 - hystQ8*hystQ8);
+		kuQ8  = ( 4u * (uint64_t)data.pItm->amp * ATUN_PI_DEN << 16 ) / ( ATUN_PI_NUM * ampQ8 );
+		den   = (uint64_t)data.pItm->ctrlFactor;
+
+		/* reduce the scaling until all gains fit into 16 bit */
+		do
+		{
+			kP = ( (uint64_t)pCoef->kp * kuQ8 * scale + 128000u * den ) / ( 256000u * den );
+			kI = ( (uint64_t)pCoef->kp * kuQ8 * scale + ( (pCoef->ti * tuQ8 * den) >> 1 ) ) / ( pCoef->ti * tuQ8 * den );
+			kD = ( (uint64_t)pCoef->kp * pCoef->td * ( (kuQ8 * tuQ8) >> 8 ) * scale + 128000000u * den ) / ( 256000000u * den );
+			if( ( kP > ATUN_GAIN_MAX ) || ( kI > ATUN_GAIN_MAX ) || ( kD > ATUN_GAIN_MAX ) )
+			{
+				scale /= 10u;
+			}
+			else
+			{
+				retVal = ERR_OK;
+			}
+		} while( ( ERR_OK != retVal ) && ( 0u != scale ) );
+
+		if( ERR_OK == retVal )
+		{
+			data.rslt.kuQ8    = (uint32_t)kuQ8;
+			data.rslt.tuMs    = (uint32_t)( ( tuQ8 * ATUN_SMPL_TIME_MS ) >> 8 );
+			data.rslt.kP_scld = (uint16_t)kP;
+			data.rslt.kI_scld = (uint16_t)kI;
+			data.rslt.kD_scld = (uint16_t)kD;
+			data.rslt.nScale  = scale;
+			data.isRsltAvail  = TRUE;
+		}
+	}
+	return retVal;
+}
+
+
+
+/*============================= >> GLOBAL FUNCTION DEFINITIONS << ================================*/
+void ATUN_Init(const void *pvPar_)
+{
+	(void)pvPar_;
+	data.state       = ATUN_STATE_IDLE;
+	data.exp         = ATUN_EXP_RELAY;
+	data.startReq    = FALSE;
+	data.stepReq     = FALSE;
+	data.linReq      = FALSE;
+	data.abortReq    = FALSE;
+	data.isRsltAvail = FALSE;
+	data.isStepRsltAvail = FALSE;
+	data.isLinRsltAvail  = FALSE;
+}
+
+void ATUN_MainFct(void)
+{
+	if( TRUE == data.abortReq )
+	{
+		data.abortReq = FALSE;
+		data.startReq = FALSE;
+		data.stepReq  = FALSE;
+		data.linReq   = FALSE;
+		if( ATUN_STATE_RUN == data.state )
+		{
+			ATUN_Stop(ATUN_STATE_FAILED);
+		}
+	}
+	if( TRUE == data.startReq )
+	{
+		data.startReq = FALSE;
+		data.exp      = ATUN_EXP_RELAY;
+		ATUN_Start();
+	}
+	if( TRUE == data.linReq )
+	{
+		data.linReq = FALSE;
+		ATUN_Start_LinExp();
+	}
+	else if( TRUE == data.stepReq )
+	{
+		data.stepReq = FALSE;
+		ATUN_Start_StepExp();
+	}
+	else if( ATUN_STATE_RUN == data.state )
+	{
+		if( ATUN_EXP_STEP == data.exp )
+		{
+			ATUN_Step_StepExp();
+		}
+		else if( ATUN_EXP_LIN == data.exp )
+		{
+			ATUN_Step_LinExp();
+		}
+		else
+		{
+			ATUN_Step();
+		}
+	}
+	else
+	{
+		/* nothing to do */
+	}
+}
+
+void ATUN_Deinit(void)
+{
+	if( ATUN_STATE_RUN == data.state )
+	{
+		ATUN_Stop(ATUN_STATE_FAILED);
+	}
+}
+
+StdRtn_t ATUN_Set_StartReq(uint8_t itmIdx_, ATUN_Rule_t rule_)
+{
+	StdRtn_t retVal = ERR_PARAM_INDEX;
+
+	if( ( itmIdx_ < Get_pAtunItmTbl()->numItms ) && ( rule_ < ATUN_RULE_CNT ) )
+	{
+		retVal = ERR_BUSY;
+		if( ( ATUN_STATE_RUN != data.state ) && ( FALSE == data.startReq ) && ( FALSE == data.stepReq )
+				&& ( FALSE == data.linReq ) )
+		{
+			/* the drive must not access the motors or only run the inner loops during the experiment */
+			retVal = DRV_SetMode(Get_pAtunItmTbl()->aItms[itmIdx_].drvMode);
+			if( ERR_OK == retVal )
+			{
+				data.reqItmIdx = itmIdx_;
+				data.reqRule   = rule_;
+				data.startReq  = TRUE;
+			}
+		}
+	}
+	return retVal;
+}
+
+StdRtn_t ATUN_Set_StepReq(int32_t setVal_)
+{
+	StdRtn_t retVal = ERR_PARAM_INDEX;
+
+	if( Get_pAtunItmTbl()->stepCnt > ATUN_STEP_CH_CNT )
+	{
+		/* invalid configuration */
+	}
+	else if( ( ATUN_STATE_RUN == data.state ) || ( TRUE == data.startReq ) || ( TRUE == data.stepReq )
+			|| ( TRUE == data.linReq ) )
+	{
+		retVal = ERR_BUSY;
+	}
+	else
+	{
+		/* the step items write the motors directly */
+		retVal = DRV_SetMode(DRV_MODE_NONE);
+		if( ERR_OK == retVal )
+		{
+			data.stepSetVal = setVal_;
+			data.stepReq    = TRUE;
+		}
+	}
+	return retVal;
+}
+
+StdRtn_t ATUN_Set_LinReq(uint8_t itmIdx_)
+{
+	StdRtn_t retVal = ERR_PARAM_INDEX;
+
+	if( itmIdx_ < Get_pAtunItmTbl()->numLinItms )
+	{
+		retVal = ERR_BUSY;
+		if( ( ATUN_STATE_RUN != data.state ) && ( FALSE == data.startReq ) && ( FALSE == data.stepReq )
+				&& ( FALSE == data.linReq ) )
+		{
+			/* the sweep writes the motor directly */
+			retVal = DRV_SetMode(DRV_MODE_NONE);
+			if( ERR_OK == retVal )
+			{
+				data.reqItmIdx = itmIdx_;
+				data.linReq    = TRUE;
+			}
+		}
+	}
+	return retVal;
+}
+
+StdRtn_t ATUN_Set_AbortReq(void)
+{
+	data.abortReq = TRUE;
+	return ERR_OK;
+}
+
+StdRtn_t ATUN_Read_State(ATUN_State_t *pState_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+
+	if( NULL != pState_ )
+	{
+		*pState_ = data.state;
+		retVal = ERR_OK;
+	}
+	return retVal;
+}
+
+StdRtn_t ATUN_Read_Rslt(ATUN_Rslt_t *pRslt_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+
+	if( NULL != pRslt_ )
+	{
+		retVal = ERR_VALUE;
+		if( TRUE == data.isRsltAvail )
+		{
+			*pRslt_ = data.rslt;
+			retVal = ERR_OK;
+		}
+	}
+	return retVal;
+}
+
+StdRtn_t ATUN_Read_StepRslt(uint8_t ch_, ATUN_StepRslt_t *pRslt_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+
+	if( NULL != pRslt_ )
+	{
+		retVal = ERR_PARAM_INDEX;
+		if( ch_ < Get_pAtunItmTbl()->stepCnt )
+		{
+			retVal = ERR_VALUE;
+			if( TRUE == data.isStepRsltAvail )
+			{
+				*pRslt_ = data.aStepRslt[ch_];
+				retVal = ERR_OK;
+			}
+		}
+	}
+	return retVal;
+}
+
+StdRtn_t ATUN_Read_LinRslt(ATUN_LinRslt_t *pRslt_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+
+	if( NULL != pRslt_ )
+	{
+		retVal = ERR_VALUE;
+		if( TRUE == data.isLinRsltAvail )
+		{
+			*pRslt_ = data.linRslt;
+			retVal = ERR_OK;
+		}
+	}
+	return retVal;
+}
+
+StdRtn_t ATUN_Save_Rslt(void)
+{
+	StdRtn_t retVal = ERR_VALUE;
+	const ATUN_Itm_t *pItm = NULL;
+	PID_ItmTbl_t *pPidTbl = Get_pPidItmTbl();
+	PID_Gain_t gain = {0u};
+	NVM_PidCfg_t nvmCfg = {0u};
+	uint8_t i = 0u;
+
+	if( ATUN_EXP_LIN == data.exp )
+	{
+		retVal = ATUN_Save_LinRslt();
+	}
+	else if( ( TRUE == data.isRsltAvail ) && ( ATUN_STATE_RUN != data.state ) && ( NULL != pPidTbl ) )
+	{
+		retVal = ERR_OK;
+		pItm = &Get_pAtunItmTbl()->aItms[data.rslt.itmIdx];
+
+		/* the anti-windup bound is kept */
+		gain.intSatVal = pPidTbl->aPids[pItm->pidIdx].cfg.gain.intSatVal;
+		gain.kP_scld   = data.rslt.kP_scld;
+		gain.kI_scld   = data.rslt.kI_scld;
+		gain.kD_scld   = data.rslt.kD_scld;
+		gain.nScale    = data.rslt.nScale;
+		for(i = 0u; i < pItm->pidCnt; i++)
+		{
+			retVal |= PID_Set_Gain(pItm->pidIdx + i, &gain);
+		}
+
+		if( ( ERR_OK == retVal ) && ( NULL != pItm->saveFct ) )
+		{
+			nvmCfg.KP_scld = gain.kP_scld;
+			nvmCfg.KI_scld = gain.kI_scld;
+			nvmCfg.KD_scld = gain.kD_scld;
+			nvmCfg.Scale   = gain.nScale;
+			nvmCfg.SaturationVal = gain.intSatVal;
+			retVal = pItm->saveFct(&nvmCfg);
+		}
+	}
+	return retVal;
+}
+
+
+
+#ifdef MASTER_atun_C_
+#undef MASTER_atun_C_
+#endif /* !MASTER_atun_C_ */
@@ -0,0 +1,72 @@
+/***********************************************************************************************//**
+ * @file		atun.h
+ * @ingroup		atun
+ * @brief 		Interface of the SWC @a Autotuner for initialisation- and runtime-calls.
+ *
+ * This header file provides the internal interface between the SWC @ref atun and the
+ * SWC @ref task which runs the initialisation and periodic main function within a FreeRTOS task.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	20.04.2018
+ *
+ * @note Interface for BSW-specific use only
+ *
+ * @copyright 	@LGPL2_1
+ *
+ **************************************************************************************************/
+
+#ifndef ATUN_H_
+#define ATUN_H_
+
+/*======================================= >> #INCLUDES << ========================================*/
+#include "Platform.h"
+
+
+#ifdef MASTER_atun_C_
+#define EXTERNAL_
+#else
+#define EXTERNAL_ extern
+#endif
+
+/**
+ * @addtogroup atun
+ * @{
+ */
+/*======================================= >> #DEFINES << =========================================*/
+/**
+ * String identification of the SWC @ref atun
+ */
+#define ATUN_SWC_STRING ("autotuner")
+
+
+
+/*=================================== >> TYPE DEFINITIONS << =====================================*/
+
+
+
+/*============================ >> GLOBAL FUNCTION DECLARATIONS << ================================*/
+/**
+ * @brief Initialization of the module
+ */
+EXTERNAL_ void ATUN_Init(const void *pvPar_);
+
+/**
+ * @brief Main function of the module, runs one sample of the current experiment. It has to be called
+ * within the task and with the period of the SWC @ref drv.
+ */
+EXTERNAL_ void ATUN_MainFct(void);
+
+/**
+ * @brief De-initialization of the module
+ */
+EXTERNAL_ void ATUN_Deinit(void);
+
+
+/**
+ * @}
+ */
+#ifdef EXTERNAL_
+#undef EXTERNAL_
+#endif
+
+#endif /* !ATUN_H_ */
@@ -0,0 +1,223 @@
+/***********************************************************************************************//**
+ * @file		atun_api.h
+ * @ingroup		atun
+ * @brief 		API for the SWC @a Autotuner
+ *
+ * This API provides a BSW-internal interface of the SWC @ref atun. It is supposed to be
+ * available to all other Basic Software Components.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	20.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ ***************************************************************************************************/
+
+#ifndef ATUN_API_H_
+#define ATUN_API_H_
+
+/*======================================= >> #INCLUDES << ========================================*/
+#include "Platform.h"
+#include "ACon_Types.h"
+#include "mot_api.h"
+
+
+
+#ifdef MASTER_atun_C_
+#define EXTERNAL_
+#else
+#define EXTERNAL_ extern
+#endif
+
+/**
+ * @addtogroup atun
+ * @{
+ */
+/*======================================= >> #DEFINES << =========================================*/
+/**
+ * Maximum number of items which are stepped together, e.g. both wheels
+ */
+#define ATUN_STEP_CH_CNT		(2u)
+
+/**
+ * Half width of the settling band of the step response in per mille of the step
+ */
+#define ATUN_STEP_BAND_PML		(20)
+
+/**
+ * Time of the step response which hasn't been reached
+ */
+#define ATUN_STEP_TIME_INVLD	(0xFFFFu)
+
+/**
+ * Number of points of the duty sweep and of the resulting linearization table of a motor
+ */
+#define ATUN_LIN_PT_CNT			(MOT_LIN_PT_CNT)
+
+
+
+/*=================================== >> TYPE DEFINITIONS << =====================================*/
+/**
+ * @brief Tuning rules which derive the PID gains from the ultimate gain and period
+ */
+typedef enum ATUN_Rule_e
+{
+	 ATUN_RULE_ZN_PID = 0	/**< Ziegler-Nichols PID */
+	,ATUN_RULE_ZN_PI		/**< Ziegler-Nichols PI */
+	,ATUN_RULE_TL_PID		/**< Tyreus-Luyben PID */
+	,ATUN_RULE_TL_PI		/**< Tyreus-Luyben PI */
+	,ATUN_RULE_NO_OS		/**< PID without overshoot */
+	,ATUN_RULE_CNT
+}ATUN_Rule_t;
+
+/**
+ * @brief States of the relay or step experiment
+ */
+typedef enum ATUN_State_e
+{
+	 ATUN_STATE_IDLE = 0	/**< no experiment has been run */
+	,ATUN_STATE_RUN			/**< experiment is running */
+	,ATUN_STATE_DONE		/**< experiment finished, gains are available */
+	,ATUN_STATE_FAILED		/**< experiment aborted or no stable oscillation within the timeout */
+}ATUN_State_t;
+
+/**
+ * @brief Result of the relay experiment
+ */
+typedef struct ATUN_Rslt_s
+{
+	uint8_t itmIdx;			/**< index of the tuned item in atun_cfg.c */
+	ATUN_Rule_t rule;		/**< tuning rule */
+	uint32_t kuQ8;			/**< ultimate gain in control value per unit of the measurement as Q24.8 */
+	uint32_t tuMs;			/**< ultimate period in [ms] */
+	uint16_t kP_scld;		/**< resulting proportional gain, scaled by nScale */
+	uint16_t kI_scld;		/**< resulting integral gain per sample, scaled by nScale */
+	uint16_t kD_scld;		/**< resulting differential gain per sample, scaled by nScale */
+	uint16_t nScale;		/**< scaling factor of the gains */
+}ATUN_Rslt_t;
+
+/**
+ * @brief Characteristics of the step response of an item
+ */
+typedef struct ATUN_StepRslt_s
+{
+	uint8_t itmIdx;			/**< index of the item in atun_cfg.c */
+	int32_t initVal;		/**< value before the step */
+	int32_t setVal;			/**< desired value after the step */
+	uint16_t riseMs;		/**< rise time from 10 % to 90 % of the step in [ms] */
+	uint16_t ovrPml;		/**< overshoot in per mille of the step */
+	uint16_t settleMs;		/**< settling time into the band of ATUN_STEP_BAND_PML in [ms] */
+	uint32_t iae;			/**< integral of the absolute error in units of the controlled variable times [ms] */
+}ATUN_StepRslt_t;
+
+/**
+ * @brief Result of the linearization experiment of a motor
+ */
+typedef struct ATUN_LinRslt_s
+{
+	uint8_t itmIdx;						/**< index of the linearization item in atun_cfg.c */
+	int32_t aSpd[ATUN_LIN_PT_CNT];		/**< steady-state speeds of the duty sweep */
+	uint16_t aDuty[ATUN_LIN_PT_CNT];	/**< linearization table */
+}ATUN_LinRslt_t;
+
+
+
+/*============================ >> GLOBAL FUNCTION DECLARATIONS << ================================*/
+/**
+ * @brief Requests to start a relay experiment. The drive is switched off and the experiment is
+ * run by the next call of the main function.
+ * @param itmIdx_ Index of the item in atun_cfg.c
+ * @param rule_   Tuning rule for the calculation of the gains
+ * @return Error code,  ERR_OK if everything was fine,
+ *                      ERR_PARAM_INDEX if the item or rule doesn't exist,
+ *                      ERR_BUSY if an experiment is already running
+ */
+EXTERNAL_ StdRtn_t ATUN_Set_StartReq(uint8_t itmIdx_, ATUN_Rule_t rule_);
+
+/**
+ * @brief Requests a step experiment. The drive is switched off and the next call of the main
+ * function applies a step to the desired value of the PID items of the step items in atun_cfg.c.
+ * The loops are closed by the PID items alone and are sampled for ATUN_STEP_DURATION_MS.
+ * @param setVal_ Desired value after the step
+ * @return Error code,  ERR_OK if everything was fine,
+ *                      ERR_PARAM_INDEX if there are more step items than ATUN_STEP_CH_CNT,
+ *                      ERR_BUSY if an experiment is already running,
+ *                      error code of the SWC @ref drv otherwise
+ */
+EXTERNAL_ StdRtn_t ATUN_Set_StepReq(int32_t setVal_);
+
+/**
+ * @brief Requests a linearization experiment. The drive is switched off and the next call of the
+ * main function starts a sweep of the duty cycle of the motor of the linearization item in
+ * atun_cfg.c. The duty cycle is held for ATUN_LIN_SETTLE_MS plus ATUN_LIN_MEAS_MS at each point,
+ * the speed is averaged over the latter.
+ * @param itmIdx_ Index of the linearization item in atun_cfg.c
+ * @return Error code,  ERR_OK if everything was fine,
+ *                      ERR_PARAM_INDEX if the item doesn't exist,
+ *                      ERR_BUSY if an experiment is already running,
+ *                      error code of the SWC @ref drv otherwise
+ */
+EXTERNAL_ StdRtn_t ATUN_Set_LinReq(uint8_t itmIdx_);
+
+/**
+ * @brief Requests to abort a running experiment
+ * @return Error code, always ERR_OK
+ */
+EXTERNAL_ StdRtn_t ATUN_Set_AbortReq(void);
+
+/**
+ * @brief Returns the state of the relay experiment
+ * @param pState_ Pointer to the state
+ * @return Error code,  ERR_OK if everything was fine,
+ *                      ERR_PARAM_ADDRESS otherwise
+ */
+EXTERNAL_ StdRtn_t ATUN_Read_State(ATUN_State_t *pState_);
+
+/**
+ * @brief Returns the result of the last relay experiment
+ * @param pRslt_ Pointer to the result
+ * @return Error code,  ERR_OK if everything was fine,
+ *                      ERR_VALUE if there is no result available,
+ *                      ERR_PARAM_ADDRESS otherwise
+ */
+EXTERNAL_ StdRtn_t ATUN_Read_Rslt(ATUN_Rslt_t *pRslt_);
+
+/**
+ * @brief Returns the step response of one item of the last step experiment
+ * @param ch_    Index of the item within the step items, 0 for the first step item
+ * @param pRslt_ Pointer to the result
+ * @return Error code,  ERR_OK if everything was fine,
+ *                      ERR_PARAM_INDEX if ch_ isn't a step item,
+ *                      ERR_VALUE if there is no result available,
+ *                      ERR_PARAM_ADDRESS otherwise
+ */
+EXTERNAL_ StdRtn_t ATUN_Read_StepRslt(uint8_t ch_, ATUN_StepRslt_t *pRslt_);
+
+/**
+ * @brief Returns the result of the last linearization experiment
+ * @param pRslt_ Pointer to the result
+ * @return Error code,  ERR_OK if everything was fine,
+ *                      ERR_VALUE if there is no result available,
+ *                      ERR_PARAM_ADDRESS otherwise
+ */
+EXTERNAL_ StdRtn_t ATUN_Read_LinRslt(ATUN_LinRslt_t *pRslt_);
+
+/**
+ * @brief Applies the result of the last relay experiment, i.e. the gains to the PID items of the
+ * tuned item, or of the last linearization experiment, i.e. the table to the motor, and saves it to
+ * the NVM
+ * @return Error code,  ERR_OK if everything was fine,
+ *                      ERR_VALUE if there is no result available,
+ *                      error code of the SWC @ref pid, @ref mot or @ref nvm otherwise
+ */
+EXTERNAL_ StdRtn_t ATUN_Save_Rslt(void);
+
+
+/**
+ * @}
+ */
+#ifdef EXTERNAL_
+#undef EXTERNAL_
+#endif
+
+#endif /* !ATUN_API_H_ */
@@ -0,0 +1,199 @@
+/***********************************************************************************************//**
+ * @file		atun_cfg.c
+ * @ingroup		atun
+ * @brief 		This file contains the relay experiments of the SWC @ref atun
+ *
+ * Each item connects a relay experiment to the controlled variable, the motor and the PID items
+ * whose gains are tuned. The experiment itself only accesses the plant through the functions of
+ * this file, hence it can be run against a simulated motor model by replacing them.\n
+ * The position loops are cascaded with the speed loops of @ref drv, so their experiment switches the
+ * speed setpoint of the closed speed loops instead of the motor value.\n
+ * The step experiment steps both speed loops together, each is closed by its own PID item.\n
+ * The linearization items sweep the duty cycle of a motor past its linearization table.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	20.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ ***************************************************************************************************/
+
+#define MASTER_atun_cfg_C_
+
+/*======================================= >> #INCLUDES << ========================================*/
+#include "atun_cfg.h"
+#include "pid_cfg.h"
+#include "tacho_api.h"
+#include "mot_api.h"
+#include "nvm_api.h"
+#include "drv_api.h"
+
+
+
+/*======================================= >> #DEFINES << =========================================*/
+#define ATUN_SPD_LE_STR		("speed L")
+#define ATUN_SPD_RI_STR		("speed R")
+#define ATUN_POS_STR		("pos")
+
+#define ATUN_MOT_MAX_VAL	(0xFFFF)
+
+
+
+/*=================================== >> TYPE DEFINITIONS << =====================================*/
+
+
+
+/*============================= >> LOKAL FUNCTION DECLARATIONS << ================================*/
+static void ATUN_Write_Mot(int32_t ctrlVal_, MOT_MotorSide_t side_);
+static void ATUN_Write_MotLe(int32_t ctrlVal_);
+static void ATUN_Write_MotRi(int32_t ctrlVal_);
+static void ATUN_Write_SpdSetVal(int32_t ctrlVal_);
+static StdRtn_t ATUN_Read_SpdLe(int32_t *pVal_);
+static StdRtn_t ATUN_Read_SpdRi(int32_t *pVal_);
+static void ATUN_Write_MotRaw(int32_t ctrlVal_, MOT_MotorSide_t side_);
+static void ATUN_Write_MotRawLe(int32_t ctrlVal_);
+static void ATUN_Write_MotRawRi(int32_t ctrlVal_);
+static StdRtn_t ATUN_Apply_MotLinLe(const uint16_t *aDuty_);
+static StdRtn_t ATUN_Apply_MotLinRi(const uint16_t *aDuty_);
+
+
+
+/*=================================== >> GLOBAL VARIABLES << =====================================*/
+static const ATUN_Itm_t items[] =
+{
+	{ATUN_SPD_LE_STR, DRV_MODE_NONE,  PID_ID_SPD_LE, 1u, FALSE, 1000, 0x2000, 0x1000, 20, 1,
+			ATUN_Read_SpdLe, ATUN_Write_MotLe, NVM_Save_PIDSpdLeCfg},
+	{ATUN_SPD_RI_STR, DRV_MODE_NONE,  PID_ID_SPD_RI, 1u, FALSE, 1000, 0x2000, 0x1000, 20, 1,
+			ATUN_Read_SpdRi, ATUN_Write_MotRi, NVM_Save_PIDSpdRiCfg},
+	{ATUN_POS_STR,    DRV_MODE_SPEED, PID_ID_POS_LE, 2u, TRUE,     0,      0,    500,  2, 1,
+			TACHO_Read_PosLe, ATUN_Write_SpdSetVal, NVM_Save_PIDPosCfg},
+};
+
+static const ATUN_LinItm_t linItems[] =
+{
+	{ATUN_SPD_LE_STR, ATUN_Read_SpdLe, ATUN_Write_MotRawLe, ATUN_Apply_MotLinLe, NVM_Save_MotLinLeCfg},
+	{ATUN_SPD_RI_STR, ATUN_Read_SpdRi, ATUN_Write_MotRawRi, ATUN_Apply_MotLinRi, NVM_Save_MotLinRiCfg},
+};
+
+static const ATUN_ItmTbl_t itemTable =
+{
+	items,
+	sizeof(items)/sizeof(items[0]),
+	0u,
+	2u,
+	linItems,
+	sizeof(linItems)/sizeof(linItems[0]),
+};
+
+
+
+/*============================== >> LOKAL FUNCTION DEFINITIONS << ================================*/
+static void ATUN_Write_Mot(int32_t ctrlVal_, MOT_MotorSide_t side_)
+{
+	MOT_Direction_t direction = MOT_DIR_FORWARD;
+	MOT_MotorDevice_t *motHandle = MOT_GetMotorHandle(side_);
+
+	if( ctrlVal_ < 0 )
+	{
+		ctrlVal_ = -ctrlVal_;
+		direction = MOT_DIR_BACKWARD;
+	}
+	if( ctrlVal_ > ATUN_MOT_MAX_VAL )
+	{
+		ctrlVal_ = ATUN_MOT_MAX_VAL;
+	}
+	if( NULL != motHandle )
+	{
+		MOT_SetDirection(motHandle, direction);
+		MOT_SetVal(motHandle, (uint16_t)(ATUN_MOT_MAX_VAL - ctrlVal_)); /* PWM is low active */
+		MOT_UpdatePercent(motHandle, direction);
+	}
+}
+
+static void ATUN_Write_MotLe(int32_t ctrlVal_)
+{
+	ATUN_Write_Mot(ctrlVal_, MOT_MOTOR_LEFT);
+}
+
+static void ATUN_Write_MotRi(int32_t ctrlVal_)
+{
+	ATUN_Write_Mot(ctrlVal_, MOT_MOTOR_RIGHT);
+}
+
+static void ATUN_Write_SpdSetVal(int32_t ctrlVal_)
+{
+	(void)DRV_SetSpeed(ctrlVal_, ctrlVal_);
+}
+
+static StdRtn_t ATUN_Read_SpdLe(int32_t *pVal_)
+{
+	int16_t spd = 0;
+	StdRtn_t retVal = TACHO_Read_SpdLe(&spd);
+
+	*pVal_ = (int32_t)spd;
+	return retVal;
+}
+
+static StdRtn_t ATUN_Read_SpdRi(int32_t *pVal_)
+{
+	int16_t spd = 0;
+	StdRtn_t retVal = TACHO_Read_SpdRi(&spd);
+
+	*pVal_ = (int32_t)spd;
+	return retVal;
+}
+
+
+
+static void ATUN_Write_MotRaw(int32_t ctrlVal_, MOT_MotorSide_t side_)
+{
+	MOT_Direction_t direction = MOT_DIR_FORWARD;
+	MOT_MotorDevice_t *motHandle = MOT_GetMotorHandle(side_);
+
+	if( ctrlVal_ < 0 )
+	{
+		ctrlVal_ = -ctrlVal_;
+		direction = MOT_DIR_BACKWARD;
+	}
+	if( ctrlVal_ > ATUN_MOT_MAX_VAL )
+	{
+		ctrlVal_ = ATUN_MOT_MAX_VAL;
+	}
+	if( NULL != motHandle )
+	{
+		MOT_SetDirection(motHandle, direction);
+		MOT_SetRawVal(motHandle, (uint16_t)(ATUN_MOT_MAX_VAL - ctrlVal_)); /* PWM is low active */
+		MOT_UpdatePercent(motHandle, direction);
+	}
+}
+
+static void ATUN_Write_MotRawLe(int32_t ctrlVal_)
+{
+	ATUN_Write_MotRaw(ctrlVal_, MOT_MOTOR_LEFT);
+}
+
+static void ATUN_Write_MotRawRi(int32_t ctrlVal_)
+{
+	ATUN_Write_MotRaw(ctrlVal_, MOT_MOTOR_RIGHT);
+}
+
+static StdRtn_t ATUN_Apply_MotLinLe(const uint16_t *aDuty_)
+{
+	return MOT_Set_LinTbl(MOT_GetMotorHandle(MOT_MOTOR_LEFT), aDuty_);
+}
+
+static StdRtn_t ATUN_Apply_MotLinRi(const uint16_t *aDuty_)
+{
+	return MOT_Set_LinTbl(MOT_GetMotorHandle(MOT_MOTOR_RIGHT), aDuty_);
+}
+
+
+
+/*============================= >> GLOBAL FUNCTION DEFINITIONS << ================================*/
+const ATUN_ItmTbl_t *Get_pAtunItmTbl(void) {return &itemTable;}
+
+
+
+#ifdef MASTER_atun_cfg_C_
+#undef MASTER_atun_cfg_C_
+#endif /* !MASTER_atun_cfg_C_ */
@@ -0,0 +1,137 @@
+/***********************************************************************************************//**
+ * @file		atun_cfg.h
+ * @ingroup		atun
+ * @brief 		This header file contains the type definitions of the items of the SWC @ref atun
+ *
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	20.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ ***************************************************************************************************/
+
+#ifndef ATUN_CFG_H_
+#define ATUN_CFG_H_
+
+/*======================================= >> #INCLUDES << ========================================*/
+#include "Platform.h"
+#include "ACon_Types.h"
+#include "nvm_api.h"
+#include "drv_api.h"
+
+
+
+#ifdef MASTER_atun_cfg_C_
+#define EXTERNAL_
+#else
+#define EXTERNAL_ extern
+#endif
+
+
+/*======================================= >> #DEFINES << =========================================*/
+/**
+ * Sample time of the relay experiment and the tuned PID controllers in [ms]
+ */
+#define ATUN_SMPL_TIME_MS (5u)
+
+/**
+ * Duration of the step experiment in [ms]
+ */
+#define ATUN_STEP_DURATION_MS (2000u)
+
+/**
+ * Time in [ms] until the speed has settled at a point of the duty sweep
+ */
+#define ATUN_LIN_SETTLE_MS (400u)
+
+/**
+ * Time in [ms] over which the speed is averaged at a point of the duty sweep
+ */
+#define ATUN_LIN_MEAS_MS (200u)
+
+
+
+/*=================================== >> TYPE DEFINITIONS << =====================================*/
+/**
+ * @brief Reads the controlled variable
+ */
+typedef StdRtn_t ATUN_ReadFct_t(int32_t *pVal_);
+
+/**
+ * @brief Writes the control value of the relay
+ */
+typedef void ATUN_WriteFct_t(int32_t ctrlVal_);
+
+/**
+ * @brief Saves the gains to the NVM
+ */
+typedef StdRtn_t ATUN_SaveFct_t(const NVM_PidCfg_t *pCfg_);
+
+/**
+ * @brief Applies a linearization table to the motor
+ */
+typedef StdRtn_t ATUN_LinApplyFct_t(const uint16_t *aDuty_);
+
+/**
+ * @brief Saves a linearization table to the NVM
+ */
+typedef StdRtn_t ATUN_LinSaveFct_t(const NVM_MotLinCfg_t *pCfg_);
+
+/**
+ * @brief Configuration of a relay experiment
+ */
+typedef struct ATUN_Itm_s
+{
+	const uchar_t *pItmName;
+	DRV_Mode_t drvMode;			/**< drive mode during the experiment, DRV_MODE_NONE if the motors are written directly */
+	uint8_t pidIdx;				/**< first PID item which gets the resulting gains */
+	uint8_t pidCnt;				/**< number of consecutive PID items sharing the gains */
+	bool isRelSetVal;			/**< setVal is relative to the value at the start of the experiment */
+	int32_t setVal;				/**< setpoint of the relay */
+	int32_t bias;				/**< control value around which the relay switches */
+	int32_t amp;				/**< amplitude of the relay */
+	int32_t hyst;				/**< hysteresis of the relay in units of the controlled variable */
+	int32_t ctrlFactor;			/**< factor between the PID output and the control value */
+	ATUN_ReadFct_t *readFct;
+	ATUN_WriteFct_t *writeFct;
+	ATUN_SaveFct_t *saveFct;
+}ATUN_Itm_t;
+
+/**
+ * @brief Configuration of a linearization experiment
+ */
+typedef struct ATUN_LinItm_s
+{
+	const uchar_t *pItmName;
+	ATUN_ReadFct_t *readFct;		/**< reads the speed */
+	ATUN_WriteFct_t *writeFct;		/**< writes the duty cycle without linearization */
+	ATUN_LinApplyFct_t *applyFct;
+	ATUN_LinSaveFct_t *saveFct;
+}ATUN_LinItm_t;
+
+/**
+ * @brief Table of the relay experiments
+ */
+typedef struct ATUN_ItmTbl_s
+{
+	const ATUN_Itm_t *aItms;
+	uint8_t numItms;
+	uint8_t stepIdx;			/**< first item of the step experiment */
+	uint8_t stepCnt;			/**< number of consecutive items which are stepped together */
+	const ATUN_LinItm_t *aLinItms;
+	uint8_t numLinItms;
+}ATUN_ItmTbl_t;
+
+
+
+/*============================ >> GLOBAL FUNCTION DECLARATIONS << ================================*/
+EXTERNAL_ const ATUN_ItmTbl_t *Get_pAtunItmTbl(void);
+
+
+
+#ifdef EXTERNAL_
+#undef EXTERNAL_
+#endif
+
+#endif /* !ATUN_CFG_H_ */
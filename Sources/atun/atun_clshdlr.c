@@ -0,0 +1,439 @@
+/***********************************************************************************************//**
+ * @file		atun_clshdlr.c
+ * @ingroup		atun
+ * @brief 		Implementation of the command line shell handler for the SWC @a Autotuner
+ *
+ * This module implements the interface of the SWC @ref atun which is addressed to
+ * the SWC @ref sh. It introduces application specific commands for starting and aborting relay
+ * experiments, for linearization experiments of the motors, for requests of their results, and for
+ * saving the resulting gains or linearization tables to the NVM via command line shell (@b CLS).
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	20.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#define MASTER_atun_clshdlr_C_
+
+/*======================================= >> #INCLUDES << ========================================*/
+#include "atun_clshdlr.h"
+#include "atun_api.h"
+#include "atun_cfg.h"
+#include "atun.h"
+#include "UTIL1.h"
+
+/*======================================= >> #DEFINES << =========================================*/
+#define ATUN_SHORT_STRING ("atun")
+
+
+
+/*=================================== >> TYPE DEFINITIONS << =====================================*/
+
+
+
+/*============================= >> LOKAL FUNCTION DECLARATIONS << ================================*/
+static void Print_AtunStatus(const CLS1_StdIOType *io_);
+static void Print_AtunHelp(const CLS1_StdIOType *io_);
+static void Parse_AtunStart(const uchar_t *cmd_, const CLS1_StdIOType *io_);
+static void Print_AtunStepRslt(const ATUN_StepRslt_t *pRslt_, const CLS1_StdIOType *io_);
+static void Parse_AtunStep(const uchar_t *cmd_, const CLS1_StdIOType *io_);
+static void Print_AtunLinRslt(const ATUN_LinRslt_t *pRslt_, const CLS1_StdIOType *io_);
+static void Parse_AtunLin(const uchar_t *cmd_, const CLS1_StdIOType *io_);
+
+
+/*=================================== >> GLOBAL VARIABLES << =====================================*/
+static const char_t *ATUN_RuleStr[ATUN_RULE_CNT] =
+{
+		"zn-pid",
+		"zn-pi",
+		"tl-pid",
+		"tl-pi",
+		"no-os",
+};
+
+static const char_t *ATUN_StateStr[] =
+{
+		"idle",
+		"running",
+		"done",
+		"failed",
+};
+
+
+
+/*============================== >> LOKAL FUNCTION DEFINITIONS << ================================*/
+/*!
+ * \brief Prints the state of the autotuner and the result of the last experiment
+ * \param io_ I/O channel to use for printing status
+ */
+static void Print_AtunStatus(const CLS1_StdIOType *io_)
+{
+	const ATUN_ItmTbl_t *pTbl = Get_pAtunItmTbl();
+	ATUN_State_t state = ATUN_STATE_IDLE;
+	ATUN_Rslt_t rslt = {0u};
+	ATUN_StepRslt_t stepRslt = {0u};
+	ATUN_LinRslt_t linRslt = {0u};
+	MOT_LimCnt_t limCntLe = {0u}, limCntRi = {0u};
+	uchar_t buf[48];
+	uint8_t i = 0u;
+
+	CLS1_SendStatusStr((uchar_t*)ATUN_SWC_STRING, (uchar_t*)"\r\n", io_->stdOut);
+
+	for(i = 0u; i < pTbl->numItms; i++)
+	{
+		UTIL1_strcpy(buf, sizeof(buf), (uchar_t*)"  #");
+		UTIL1_strcatNum8u(buf, sizeof(buf), i);
+		CLS1_SendStatusStr(buf, (uchar_t*)pTbl->aItms[i].pItmName, io_->stdOut);
+		CLS1_SendStr((uchar_t*)"\r\n", io_->stdOut);
+	}
+	for(i = 0u; i < pTbl->numLinItms; i++)
+	{
+		UTIL1_strcpy(buf, sizeof(buf), (uchar_t*)"  lin #");
+		UTIL1_strcatNum8u(buf, sizeof(buf), i);
+		CLS1_SendStatusStr(buf, (uchar_t*)pTbl->aLinItms[i].pItmName, io_->stdOut);
+		CLS1_SendStr((uchar_t*)"\r\n", io_->stdOut);
+	}
+
+	(void)ATUN_Read_State(&state);
+	CLS1_SendStatusStr((uchar_t*)"  state", (uchar_t*)ATUN_StateStr[state], io_->stdOut);
+	CLS1_SendStr((uchar_t*)"\r\n", io_->stdOut);
+
+	/* a limited motor output distorts the experiment */
+	(void)MOT_Read_LimCnt(MOT_GetMotorHandle(MOT_MOTOR_LEFT), &limCntLe);
+	(void)MOT_Read_LimCnt(MOT_GetMotorHandle(MOT_MOTOR_RIGHT), &limCntRi);
+	UTIL1_strcpy(buf, sizeof(buf), (uchar_t*)"L ");
+	UTIL1_strcatNum32u(buf, sizeof(buf), limCntLe.slewCnt + limCntLe.coastCnt);
+	UTIL1_strcat(buf, sizeof(buf), (uchar_t*)", R ");
+	UTIL1_strcatNum32u(buf, sizeof(buf), limCntRi.slewCnt + limCntRi.coastCnt);
+	UTIL1_strcat(buf, sizeof(buf), (uchar_t*)" updates\r\n");
+	CLS1_SendStatusStr((uchar_t*)"  mot limited", buf, io_->stdOut);
+
+	if( ERR_OK == ATUN_Read_Rslt(&rslt) )
+	{
+		UTIL1_strcpy(buf, sizeof(buf), (uchar_t*)"#");
+		UTIL1_strcatNum8u(buf, sizeof(buf), rslt.itmIdx);
+		UTIL1_strcat(buf, sizeof(buf), (uchar_t*)" ");
+		UTIL1_strcat(buf, sizeof(buf), (uchar_t*)ATUN_RuleStr[rslt.rule]);
+		UTIL1_strcat(buf, sizeof(buf), (uchar_t*)"\r\n");
+		CLS1_SendStatusStr((uchar_t*)"  result", buf, io_->stdOut);
+
+		buf[0] = '\0';
+		UTIL1_strcatNum32u(buf, sizeof(buf), rslt.kuQ8 >> 8);
+		UTIL1_strcat(buf, sizeof(buf), (uchar_t*)".");
+		UTIL1_strcatNum16uFormatted(buf, sizeof(buf), (uint16_t)( ((rslt.kuQ8 & 0xFFu) * 100u) >> 8 ), '0', 2);
+		UTIL1_strcat(buf, sizeof(buf), (uchar_t*)"\r\n");
+		CLS1_SendStatusStr((uchar_t*)"  Ku", buf, io_->stdOut);
+
+		buf[0] = '\0';
+		UTIL1_strcatNum32u(buf, sizeof(buf), rslt.tuMs);
+		UTIL1_strcat(buf, sizeof(buf), (uchar_t*)" ms\r\n");
+		CLS1_SendStatusStr((uchar_t*)"  Tu", buf, io_->stdOut);
+
+		UTIL1_strcpy(buf, sizeof(buf), (uchar_t*)"p: ");
+		UTIL1_strcatNum16u(buf, sizeof(buf), rslt.kP_scld);
+		UTIL1_strcat(buf, sizeof(buf), (uchar_t*)"  i: ");
+		UTIL1_strcatNum16u(buf, sizeof(buf), rslt.kI_scld);
+		UTIL1_strcat(buf, sizeof(buf), (uchar_t*)"  d: ");
+		UTIL1_strcatNum16u(buf, sizeof(buf), rslt.kD_scld);
+		UTIL1_strcat(buf, sizeof(buf), (uchar_t*)"  / ");
+		UTIL1_strcatNum16u(buf, sizeof(buf), rslt.nScale);
+		UTIL1_strcat(buf, sizeof(buf), (uchar_t*)"\r\n");
+		CLS1_SendStatusStr((uchar_t*)"  gains", buf, io_->stdOut);
+	}
+
+	for(i = 0u; ERR_OK == ATUN_Read_StepRslt(i, &stepRslt); i++)
+	{
+		Print_AtunStepRslt(&stepRslt, io_);
+	}
+
+	if( ERR_OK == ATUN_Read_LinRslt(&linRslt) )
+	{
+		Print_AtunLinRslt(&linRslt, io_);
+	}
+}
+
+/*!
+ * \brief Prints the speeds of the duty sweep and the resulting linearization table
+ * \param pRslt_ Linearization result to be printed
+ * \param io_ I/O channel to be used
+ */
+static void Print_AtunLinRslt(const ATUN_LinRslt_t *pRslt_, const CLS1_StdIOType *io_)
+{
+	uchar_t buf[48];
+	uint8_t i = 0u;
+
+	UTIL1_strcpy(buf, sizeof(buf), (uchar_t*)"lin #");
+	UTIL1_strcatNum8u(buf, sizeof(buf), pRslt_->itmIdx);
+	UTIL1_strcat(buf, sizeof(buf), (uchar_t*)", speed of sweep, duty of table\r\n");
+	CLS1_SendStatusStr((uchar_t*)"  result", buf, io_->stdOut);
+
+	for(i = 0u; i < ATUN_LIN_PT_CNT; i++)
+	{
+		UTIL1_strcpy(buf, sizeof(buf), (uchar_t*)"    pt ");
+		UTIL1_strcatNum8u(buf, sizeof(buf), i);
+		UTIL1_Num32sToStr(&buf[sizeof(buf)/2u], sizeof(buf)/2u, pRslt_->aSpd[i]);
+		UTIL1_strcat(&buf[sizeof(buf)/2u], sizeof(buf)/2u, (uchar_t*)" steps/s, 0x");
+		UTIL1_strcatNum16Hex(&buf[sizeof(buf)/2u], sizeof(buf)/2u, pRslt_->aDuty[i]);
+		UTIL1_strcat(&buf[sizeof(buf)/2u], sizeof(buf)/2u, (uchar_t*)"\r\n");
+		CLS1_SendStatusStr(buf, &buf[sizeof(buf)/2u], io_->stdOut);
+	}
+}
+
+/*!
+ * \brief Prints the step response of one item
+ * \param pRslt_ Step response to be printed
+ * \param io_ I/O channel to be used
+ */
+static void Print_AtunStepRslt(const ATUN_StepRslt_t *pRslt_, const CLS1_StdIOType *io_)
+{
+	uchar_t buf[48];
+
+	UTIL1_strcpy(buf, sizeof(buf), (uchar_t*)"#");
+	UTIL1_strcatNum8u(buf, sizeof(buf), pRslt_->itmIdx);
+	UTIL1_strcat(buf, sizeof(buf), (uchar_t*)" ");
+	UTIL1_strcatNum32s(buf, sizeof(buf), pRslt_->initVal);
+	UTIL1_strcat(buf, sizeof(buf), (uchar_t*)" -> ");
+	UTIL1_strcatNum32s(buf, sizeof(buf), pRslt_->setVal);
+	UTIL1_strcat(buf, sizeof(buf), (uchar_t*)"\r\n");
+	CLS1_SendStatusStr((uchar_t*)"  step", buf, io_->stdOut);
+
+	buf[0] = '\0';
+	if( ATUN_STEP_TIME_INVLD != pRslt_->riseMs )
+	{
+		UTIL1_strcatNum16u(buf, sizeof(buf), pRslt_->riseMs);
+		UTIL1_strcat(buf, sizeof(buf), (uchar_t*)" ms\r\n");
+	}
+	else
+	{
+		UTIL1_strcat(buf, sizeof(buf), (uchar_t*)"90% not reached\r\n");
+	}
+	CLS1_SendStatusStr((uchar_t*)"    rise", buf, io_->stdOut);
+
+	buf[0] = '\0';
+	UTIL1_strcatNum16u(buf, sizeof(buf), pRslt_->ovrPml / 10u);
+	UTIL1_strcat(buf, sizeof(buf), (uchar_t*)".");
+	UTIL1_strcatNum16u(buf, sizeof(buf), pRslt_->ovrPml % 10u);
+	UTIL1_strcat(buf, sizeof(buf), (uchar_t*)" %\r\n");
+	CLS1_SendStatusStr((uchar_t*)"    overshoot", buf, io_->stdOut);
+
+	buf[0] = '\0';
+	if( ATUN_STEP_TIME_INVLD != pRslt_->settleMs )
+	{
+		UTIL1_strcatNum16u(buf, sizeof(buf), pRslt_->settleMs);
+		UTIL1_strcat(buf, sizeof(buf), (uchar_t*)" ms\r\n");
+	}
+	else
+	{
+		UTIL1_strcat(buf, sizeof(buf), (uchar_t*)"not settled\r\n");
+	}
+	CLS1_SendStatusStr((uchar_t*)"    settling", buf, io_->stdOut);
+
+	buf[0] = '\0';
+	UTIL1_strcatNum32u(buf, sizeof(buf), pRslt_->iae);
+	UTIL1_strcat(buf, sizeof(buf), (uchar_t*)" ms\r\n");
+	CLS1_SendStatusStr((uchar_t*)"    IAE", buf, io_->stdOut);
+}
+
+/*!
+ * \brief Prints the help text to the console
+ * \param io_ I/O channel to be used
+ */
+static void Print_AtunHelp(const CLS1_StdIOType *io_)
+{
+	CLS1_SendHelpStr((uchar_t*)ATUN_SHORT_STRING, (uchar_t*)"Group of autotuner commands\r\n", io_->stdOut);
+	CLS1_SendHelpStr((uchar_t*)"  help|status", (uchar_t*)"Shows autotuner help or status\r\n", io_->stdOut);
+	CLS1_SendHelpStr((uchar_t*)"  start #ID [rule]", (uchar_t*)"Switches the drive off and runs a relay experiment for #ID\r\n", io_->stdOut);
+	CLS1_SendHelpStr((uchar_t*)"", (uchar_t*)"rule: zn-pid (default), zn-pi, tl-pid, tl-pi, no-os\r\n", io_->stdOut);
+	CLS1_SendHelpStr((uchar_t*)"  step <val>", (uchar_t*)"Switches the drive off and steps the desired value of the step items to <val>\r\n", io_->stdOut);
+	CLS1_SendHelpStr((uchar_t*)"  lin #ID", (uchar_t*)"Switches the drive off and sweeps the duty cycle of the motor of lin #ID\r\n", io_->stdOut);
+	CLS1_SendHelpStr((uchar_t*)"", (uchar_t*)"The robot turns on the spot, the sweep takes about 10 s\r\n", io_->stdOut);
+	CLS1_SendHelpStr((uchar_t*)"  abort", (uchar_t*)"Aborts a running experiment\r\n", io_->stdOut);
+	CLS1_SendHelpStr((uchar_t*)"  save", (uchar_t*)"Applies the resulting gains or table and saves them to the NVM\r\n", io_->stdOut);
+}
+
+/*!
+ * \brief Parses the arguments of the start command and requests the experiment
+ * \param cmd_ Arguments after "atun start"
+ * \param io_ I/O channel to be used
+ */
+static void Parse_AtunStart(const uchar_t *cmd_, const CLS1_StdIOType *io_)
+{
+	const uchar_t *p = cmd_;
+	uint8_t id = 0u;
+	uint8_t rule = (uint8_t)ATUN_RULE_ZN_PID;
+	uint8_t i = 0u;
+	StdRtn_t retVal = ERR_OK;
+
+	while( (' ' == *p) || ('#' == *p) )
+	{
+		p++;
+	}
+	if( ERR_OK != UTIL1_ScanDecimal8uNumber(&p, &id) )
+	{
+		CLS1_SendStr((uchar_t*)"*** ERROR: Invalid argument - #ID not specified ***\r\n", io_->stdErr);
+		retVal = ERR_FAILED;
+	}
+	else
+	{
+		while( ' ' == *p )
+		{
+			p++;
+		}
+		if( '\0' != *p )
+		{
+			rule = (uint8_t)ATUN_RULE_CNT;
+			for(i = 0u; i < (uint8_t)ATUN_RULE_CNT; i++)
+			{
+				if( 0 == UTIL1_strcmp((char*)p, ATUN_RuleStr[i]) )
+				{
+					rule = i;
+				}
+			}
+		}
+
+		retVal = ATUN_Set_StartReq(id, (ATUN_Rule_t)rule);
+		if( ERR_OK == retVal )
+		{
+			CLS1_SendStr((uchar_t*)">>> Relay experiment started...\r\n", io_->stdOut);
+		}
+		else if( ERR_BUSY == retVal )
+		{
+			CLS1_SendStr((uchar_t*)"*** ERROR: Relay experiment already running ***\r\n", io_->stdErr);
+		}
+		else
+		{
+			CLS1_SendStr((uchar_t*)"*** ERROR: Invalid argument - #ID or rule not found ***\r\n", io_->stdErr);
+		}
+	}
+}
+
+/*!
+ * \brief Parses the argument of the step command and requests the experiment
+ * \param cmd_ Arguments after "atun step"
+ * \param io_ I/O channel to be used
+ */
+static void Parse_AtunStep(const uchar_t *cmd_, const CLS1_StdIOType *io_)
+{
+	const uchar_t *p = cmd_;
+	int32_t val = 0;
+	StdRtn_t retVal = ERR_OK;
+
+	if( ERR_OK != UTIL1_xatoi(&p, &val) )
+	{
+		CLS1_SendStr((uchar_t*)"*** ERROR: Invalid argument - <val> not specified ***\r\n", io_->stdErr);
+	}
+	else
+	{
+		retVal = ATUN_Set_StepReq(val);
+		if( ERR_OK == retVal )
+		{
+			CLS1_SendStr((uchar_t*)">>> Step experiment started...\r\n", io_->stdOut);
+		}
+		else if( ERR_BUSY == retVal )
+		{
+			CLS1_SendStr((uchar_t*)"*** ERROR: Experiment already running ***\r\n", io_->stdErr);
+		}
+		else
+		{
+			CLS1_SendStr((uchar_t*)"*** ERROR: Step experiment couldn't be started ***\r\n", io_->stdErr);
+		}
+	}
+}
+
+/*!
+ * \brief Parses the argument of the lin command and requests the experiment
+ * \param cmd_ Arguments after "atun lin"
+ * \param io_ I/O channel to be used
+ */
+static void Parse_AtunLin(const uchar_t *cmd_, const CLS1_StdIOType *io_)
+{
+	const uchar_t *p = cmd_;
+	uint8_t id = 0u;
+	StdRtn_t retVal = ERR_OK;
+
+	while( (' ' == *p) || ('#' == *p) )
+	{
+		p++;
+	}
+	if( ERR_OK != UTIL1_ScanDecimal8uNumber(&p, &id) )
+	{
+		CLS1_SendStr((uchar_t*)"*** ERROR: Invalid argument - #ID not specified ***\r\n", io_->stdErr);
+	}
+	else
+	{
+		retVal = ATUN_Set_LinReq(id);
+		if( ERR_OK == retVal )
+		{
+			CLS1_SendStr((uchar_t*)">>> Linearization experiment started...\r\n", io_->stdOut);
+		}
+		else if( ERR_BUSY == retVal )
+		{
+			CLS1_SendStr((uchar_t*)"*** ERROR: Experiment already running ***\r\n", io_->stdErr);
+		}
+		else
+		{
+			CLS1_SendStr((uchar_t*)"*** ERROR: Invalid argument - #ID not found ***\r\n", io_->stdErr);
+		}
+	}
+}
+
+
+/*============================= >> GLOBAL FUNCTION DEFINITIONS << ================================*/
+uint8_t ATUN_ParseCommand(const uchar_t *cmd, bool *handled, const CLS1_StdIOType *io_)
+{
+	if (UTIL1_strcmp((char*)cmd, (char*)CLS1_CMD_HELP)==0 || UTIL1_strcmp((char*)cmd, (char*)"atun help")==0)
+	{
+		Print_AtunHelp(io_);
+		*handled = TRUE;
+	}
+	else if (UTIL1_strcmp((char*)cmd, (char*)CLS1_CMD_STATUS)==0 || UTIL1_strcmp((char*)cmd, (char*)"atun status")==0)
+	{
+		Print_AtunStatus(io_);
+		*handled = TRUE;
+	}
+	else if (UTIL1_strncmp((char*)cmd, (char*)"atun start", sizeof("atun start")-1)==0)
+	{
+		Parse_AtunStart(cmd+sizeof("atun start")-1, io_);
+		*handled = TRUE;
+	}
+	else if (UTIL1_strncmp((char*)cmd, (char*)"atun step", sizeof("atun step")-1)==0)
+	{
+		Parse_AtunStep(cmd+sizeof("atun step")-1, io_);
+		*handled = TRUE;
+	}
+	else if (UTIL1_strncmp((char*)cmd, (char*)"atun lin", sizeof("atun lin")-1)==0)
+	{
+		Parse_AtunLin(cmd+sizeof("atun lin")-1, io_);
+		*handled = TRUE;
+	}
+	else if (UTIL1_strcmp((char*)cmd, (char*)"atun abort")==0)
+	{
+		(void)ATUN_Set_AbortReq();
+		*handled = TRUE;
+	}
+	else if (UTIL1_strcmp((char*)cmd, (char*)"atun save")==0)
+	{
+		if( ERR_OK == ATUN_Save_Rslt() )
+		{
+			CLS1_SendStr((uchar_t*)">>> Saving to NVM successful...\r\n", io_->stdOut);
+		}
+		else
+		{
+			CLS1_SendStr((uchar_t*)"*** ERROR: Saving failed - no result available or NVM write failed ***\r\n", io_->stdErr);
+		}
+		*handled = TRUE;
+	}
+	else
+	{
+		/* error handling */
+	}
+	return ERR_OK;
+}
+
+
+
+#ifdef MASTER_atun_clshdlr_C_
+#undef MASTER_atun_clshdlr_C_
+#endif /* !MASTER_atun_clshdlr_C_ */
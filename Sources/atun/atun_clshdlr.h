@@ -0,0 +1,57 @@
+/***********************************************************************************************//**
+ * @file		atun_clshdlr.h
+ * @ingroup		atun
+ * @brief		Interface for the command line shell handler of the SWC @a Autotuner
+ *
+ * This header files provides the interface from the SWC @ref atun to the SWC @ref sh.
+ * It introduces application specific commands for starting relay experiments and for requests
+ * of their results via command line shell (@b CLS).
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	20.04.2018
+ *  
+ * @note Interface for CLS-specific use only
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#ifndef ATUN_CLSHDLR_H_
+#define ATUN_CLSHDLR_H_
+
+/*======================================= >> #INCLUDES << ========================================*/
+#include "CLS1.h"
+
+
+
+#ifdef MASTER_atun_clshdlr_C_
+#define EXTERNAL_
+#else
+#define EXTERNAL_ extern
+#endif
+
+/*======================================= >> #DEFINES << =========================================*/
+
+
+
+/*=================================== >> TYPE DEFINITIONS << =====================================*/
+
+
+
+/*============================ >> GLOBAL FUNCTION DECLARATIONS << ================================*/
+/*!
+ * @brief Parses a command
+ * @param cmd_ Command string to be parsed
+ * @param handled_ Sets this variable to TRUE if command was handled
+ * @param io_ I/O stream to be used for input/output
+ * @return Error code, ERR_OK if everything was fine
+ */
+uint8_t ATUN_ParseCommand(const unsigned char *cmd_, bool *handled_, const CLS1_StdIOType *io_);
+
+
+
+#ifdef EXTERNAL_
+#undef EXTERNAL_
+#endif
+
+#endif /* !ATUN_CLSHDLR_H_ */
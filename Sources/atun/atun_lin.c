@@ -0,0 +1,131 @@
+/***********************************************************************************************//**
+ * @file		atun_lin.c
+ * @ingroup		atun
+ * @brief 		Implementation of the calculation of the motor linearization of the SWC @ref atun
+ *
+ * This module calculates the linearization table of a motor from a sweep of the duty cycle. The
+ * duty cycles of the sweep are the points of the table. The steady-state speeds are made monotone
+ * first, then the table is found by inverse linear interpolation: each point k gets the duty cycle
+ * which yields k/(ATUN_LIN_PT_CNT-1) of the speed at full duty cycle. The dead band ends where the
+ * speed exceeds 1/64 of the speed at full duty cycle, which is the first point of the table.\n
+ * The module doesn't access any hardware, hence it gives the same results on the target and
+ * against a simulated motor on the host.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#define MASTER_atun_lin_C_
+
+/*======================================= >> #INCLUDES << ========================================*/
+#include "atun_lin.h"
+#include "atun_api.h"
+#include "mot_api.h"
+
+
+
+/*======================================= >> #DEFINES << =========================================*/
+/**
+ * Maximum duty cycle
+ */
+#define ATUN_LIN_DUTY_MAX		(0xFFFF)
+
+/**
+ * Speed which ends the dead band, as right shift of the speed at full duty cycle
+ */
+#define ATUN_LIN_DEAD_SHIFT		(6u)
+
+
+
+/*=================================== >> TYPE DEFINITIONS << =====================================*/
+
+
+
+/*============================= >> LOKAL FUNCTION DECLARATIONS << ================================*/
+static uint16_t ATUN_Lin_Interp(const int32_t *aSpd_, uint8_t ptIdx_, int32_t spd_);
+
+
+
+/*=================================== >> GLOBAL VARIABLES << =====================================*/
+
+
+
+/*============================== >> LOKAL FUNCTION DEFINITIONS << ================================*/
+/**
+ * @brief Returns the duty cycle at the speed spd_ within the segment of the sweep from point ptIdx_
+ * to point ptIdx_+1
+ */
+static uint16_t ATUN_Lin_Interp(const int32_t *aSpd_, uint8_t ptIdx_, int32_t spd_)
+{
+	int32_t duty = (int32_t)ATUN_Lin_Get_SweepDuty(ptIdx_);
+	int32_t dDuty = (int32_t)ATUN_Lin_Get_SweepDuty(ptIdx_ + 1u) - duty;
+	int32_t dSpd = aSpd_[ptIdx_ + 1u] - aSpd_[ptIdx_];
+
+	if( dSpd > 0 )
+	{
+		duty += (int32_t)( ( (int64_t)( spd_ - aSpd_[ptIdx_] ) * dDuty + ( dSpd >> 1 ) ) / dSpd );
+	}
+	/* the speed at the first point of the sweep may be above spd_ by noise or an offset */
+	duty = ( duty < 0 ) ? 0 : duty;
+	return (uint16_t)( ( duty > ATUN_LIN_DUTY_MAX ) ? ATUN_LIN_DUTY_MAX : duty );
+}
+
+
+
+/*============================= >> GLOBAL FUNCTION DEFINITIONS << ================================*/
+uint16_t ATUN_Lin_Get_SweepDuty(uint8_t ptIdx_)
+{
+	uint32_t duty = (uint32_t)ptIdx_ << MOT_LIN_SEG_SHIFT;
+
+	return (uint16_t)( ( duty > (uint32_t)ATUN_LIN_DUTY_MAX ) ? (uint32_t)ATUN_LIN_DUTY_MAX : duty );
+}
+
+StdRtn_t ATUN_Lin_Calc(const int32_t *aSpd_, uint16_t *aDuty_)
+{
+	StdRtn_t retVal = ERR_RANGE;
+	int32_t aSpd[ATUN_LIN_PT_CNT] = {0};
+	int32_t spdMax = 0, spd = 0;
+	uint8_t i = 0u, k = 0u;
+
+	/* the speed is monotone over the duty cycle, measurement noise isn't */
+	for(i = 0u; i < ATUN_LIN_PT_CNT; i++)
+	{
+		aSpd[i] = ( aSpd_[i] > spdMax ) ? aSpd_[i] : spdMax;
+		spdMax  = aSpd[i];
+	}
+
+	if( spdMax > 0 )
+	{
+		/* end of the dead band */
+		spd = spdMax >> ATUN_LIN_DEAD_SHIFT;
+		while( aSpd[k + 1u] <= spd )
+		{
+			k++;
+		}
+		aDuty_[0] = ATUN_Lin_Interp(aSpd, k, spd);
+
+		for(i = 1u; i < ATUN_LIN_PT_CNT - 1u; i++)
+		{
+			spd = (int32_t)( ( (int64_t)spdMax * i ) >> ( 16u - MOT_LIN_SEG_SHIFT ) );
+			while( aSpd[k + 1u] < spd )
+			{
+				k++;
+			}
+			aDuty_[i] = ATUN_Lin_Interp(aSpd, k, spd);
+			aDuty_[i] = ( aDuty_[i] < aDuty_[i - 1u] ) ? aDuty_[i - 1u] : aDuty_[i];
+		}
+		/* full duty cycle stays reachable */
+		aDuty_[ATUN_LIN_PT_CNT - 1u] = ATUN_LIN_DUTY_MAX;
+		retVal = ERR_OK;
+	}
+	return retVal;
+}
+
+
+
+#ifdef MASTER_atun_lin_C_
+#undef MASTER_atun_lin_C_
+#endif /* !MASTER_atun_lin_C_ */
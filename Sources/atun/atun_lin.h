@@ -0,0 +1,73 @@
+/***********************************************************************************************//**
+ * @file		atun_lin.h
+ * @ingroup		atun
+ * @brief 		Interface of the calculation of the motor linearization of the SWC @a Autotuner
+ *
+ * This header file provides the internal interface of the calculation of the linearization table
+ * of a motor. It depends on the measured speeds only, so the same calculation runs on the target
+ * and against a simulated motor.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @note Interface for BSW-specific use only
+ *
+ * @copyright 	@LGPL2_1
+ *
+ **************************************************************************************************/
+
+#ifndef ATUN_LIN_H_
+#define ATUN_LIN_H_
+
+/*======================================= >> #INCLUDES << ========================================*/
+#include "Platform.h"
+#include "ACon_Types.h"
+#include "atun_api.h"
+
+
+#ifdef MASTER_atun_lin_C_
+#define EXTERNAL_
+#else
+#define EXTERNAL_ extern
+#endif
+
+/**
+ * @addtogroup atun
+ * @{
+ */
+/*======================================= >> #DEFINES << =========================================*/
+
+
+
+/*=================================== >> TYPE DEFINITIONS << =====================================*/
+
+
+
+/*============================ >> GLOBAL FUNCTION DECLARATIONS << ================================*/
+/**
+ * @brief Returns the duty cycle of a point of the duty sweep
+ * @param ptIdx_ Index of the point, 0...ATUN_LIN_PT_CNT-1
+ * @return duty cycle (active high)
+ */
+EXTERNAL_ uint16_t ATUN_Lin_Get_SweepDuty(uint8_t ptIdx_);
+
+/**
+ * @brief Calculates the linearization table from the steady-state speeds of the duty sweep. The
+ * table inverts the speed over the duty cycle, i.e. its points yield speeds which are equally
+ * spaced between zero and the speed at full duty cycle. The first point is the end of the dead band.
+ * @param aSpd_  Steady-state speeds at the duty cycles of ATUN_Lin_Get_SweepDuty()
+ * @param aDuty_ Linearization table of ATUN_LIN_PT_CNT duty cycles (call by ref)
+ * @return Error code,  ERR_OK if everything was fine,
+ *                      ERR_RANGE if the motor hasn't turned forward at full duty cycle
+ */
+EXTERNAL_ StdRtn_t ATUN_Lin_Calc(const int32_t *aSpd_, uint16_t *aDuty_);
+
+
+/**
+ * @}
+ */
+#ifdef EXTERNAL_
+#undef EXTERNAL_
+#endif
+
+#endif /* !ATUN_LIN_H_ */
@@ -0,0 +1,130 @@
+/***********************************************************************************************//**
+ * @file		atun_step.c
+ * @ingroup		atun
+ * @brief 		Implementation of the step response analyzer of the SWC @ref atun
+ *
+ * This module characterises the response of a closed loop to a step of its desired value. The
+ * samples are analysed as they arrive, so no record of the response is needed. The rise time is
+ * measured from 10 % to 90 % of the step, the overshoot is related to the height of the step and
+ * the settling time is the time until the response stays within ATUN_STEP_BAND_PML of the step
+ * around the desired value. The integral of the absolute error (IAE) sums up the error of all
+ * samples. The module doesn't access any hardware, hence it gives the same results on the target
+ * and against a simulated plant on the host.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#define MASTER_atun_step_C_
+
+/*======================================= >> #INCLUDES << ========================================*/
+#include "atun_step.h"
+#include "atun_api.h"
+
+
+
+/*======================================= >> #DEFINES << =========================================*/
+
+
+
+/*=================================== >> TYPE DEFINITIONS << =====================================*/
+
+
+
+/*============================= >> LOKAL FUNCTION DECLARATIONS << ================================*/
+static uint16_t ATUN_StepAnl_SmplToMs(uint32_t smpl_, uint16_t smplTimeMs_);
+
+
+
+/*=================================== >> GLOBAL VARIABLES << =====================================*/
+
+
+
+/*============================== >> LOKAL FUNCTION DEFINITIONS << ================================*/
+/**
+ * @brief Converts a number of samples into [ms], saturated below ATUN_STEP_TIME_INVLD
+ */
+static uint16_t ATUN_StepAnl_SmplToMs(uint32_t smpl_, uint16_t smplTimeMs_)
+{
+	uint32_t ms = smpl_ * (uint32_t)smplTimeMs_;
+
+	return ( ms < (uint32_t)ATUN_STEP_TIME_INVLD ) ? (uint16_t)ms : (uint16_t)(ATUN_STEP_TIME_INVLD - 1u);
+}
+
+
+
+/*============================= >> GLOBAL FUNCTION DEFINITIONS << ================================*/
+void ATUN_StepAnl_Init(ATUN_StepAnl_t *pAnl_, int32_t initVal_, int32_t setVal_)
+{
+	pAnl_->initVal   = initVal_;
+	pAnl_->setVal    = setVal_;
+	pAnl_->dir       = ( setVal_ < initVal_ ) ? -1 : 1;
+	pAnl_->step      = ( (int64_t)setVal_ - (int64_t)initVal_ ) * pAnl_->dir;
+	pAnl_->band      = ( pAnl_->step * ATUN_STEP_BAND_PML ) / 1000;
+	pAnl_->band      = ( pAnl_->band < 1 ) ? 1 : pAnl_->band;
+	pAnl_->peak      = 0;
+	pAnl_->sumAbsErr = 0u;
+	pAnl_->smplCntr  = 0u;
+	pAnl_->t10       = 0u;
+	pAnl_->t90       = 0u;
+	pAnl_->tSettle   = 0u;
+}
+
+void ATUN_StepAnl_Upd(ATUN_StepAnl_t *pAnl_, int32_t val_)
+{
+	int64_t val = ( (int64_t)val_ - (int64_t)pAnl_->initVal ) * pAnl_->dir;
+	int64_t err = pAnl_->step - val;
+
+	pAnl_->smplCntr++;
+	if( ( 0u == pAnl_->t10 ) && ( 10 * val >= pAnl_->step ) )
+	{
+		pAnl_->t10 = pAnl_->smplCntr;
+	}
+	if( ( 0u == pAnl_->t90 ) && ( 10 * val >= 9 * pAnl_->step ) )
+	{
+		pAnl_->t90 = pAnl_->smplCntr;
+	}
+	if( val > pAnl_->peak )
+	{
+		pAnl_->peak = val;
+	}
+	if( ( err > pAnl_->band ) || ( err < -pAnl_->band ) )
+	{
+		pAnl_->tSettle = pAnl_->smplCntr;
+	}
+	pAnl_->sumAbsErr += (uint64_t)( ( err < 0 ) ? -err : err );
+}
+
+void ATUN_StepAnl_Get(const ATUN_StepAnl_t *pAnl_, uint16_t smplTimeMs_, ATUN_StepRslt_t *pRslt_)
+{
+	uint64_t iae = pAnl_->sumAbsErr * smplTimeMs_;
+
+	pRslt_->initVal = pAnl_->initVal;
+	pRslt_->setVal  = pAnl_->setVal;
+
+	/* the 10 % crossing is always found before the 90 % crossing */
+	pRslt_->riseMs = ( 0u != pAnl_->t90 ) ?
+			ATUN_StepAnl_SmplToMs(pAnl_->t90 - pAnl_->t10, smplTimeMs_) : ATUN_STEP_TIME_INVLD;
+
+	pRslt_->ovrPml = 0u;
+	if( ( pAnl_->peak > pAnl_->step ) && ( 0 != pAnl_->step ) )
+	{
+		pRslt_->ovrPml = (uint16_t)( ( ( pAnl_->peak - pAnl_->step ) * 1000 < 0xFFFF * pAnl_->step ) ?
+				( ( pAnl_->peak - pAnl_->step ) * 1000 ) / pAnl_->step : 0xFFFF );
+	}
+
+	/* the response has to be within the band at the last sample */
+	pRslt_->settleMs = ( pAnl_->tSettle < pAnl_->smplCntr ) ?
+			ATUN_StepAnl_SmplToMs(pAnl_->tSettle + 1u, smplTimeMs_) : ATUN_STEP_TIME_INVLD;
+
+	pRslt_->iae = ( iae < 0xFFFFFFFFu ) ? (uint32_t)iae : 0xFFFFFFFFu;
+}
+
+
+
+#ifdef MASTER_atun_step_C_
+#undef MASTER_atun_step_C_
+#endif /* !MASTER_atun_step_C_ */
@@ -0,0 +1,96 @@
+/***********************************************************************************************//**
+ * @file		atun_step.h
+ * @ingroup		atun
+ * @brief 		Interface of the step response analyzer of the SWC @a Autotuner
+ *
+ * This header file provides the internal interface of the step response analyzer. It depends on
+ * the sampled values only, so the same analysis runs on the target and against a simulated plant.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @note Interface for BSW-specific use only
+ *
+ * @copyright 	@LGPL2_1
+ *
+ **************************************************************************************************/
+
+#ifndef ATUN_STEP_H_
+#define ATUN_STEP_H_
+
+/*======================================= >> #INCLUDES << ========================================*/
+#include "Platform.h"
+#include "ACon_Types.h"
+#include "atun_api.h"
+
+
+#ifdef MASTER_atun_step_C_
+#define EXTERNAL_
+#else
+#define EXTERNAL_ extern
+#endif
+
+/**
+ * @addtogroup atun
+ * @{
+ */
+/*======================================= >> #DEFINES << =========================================*/
+
+
+
+/*=================================== >> TYPE DEFINITIONS << =====================================*/
+/**
+ * @brief Runtime data of the analysis of one step response. The values are normalised to the
+ * direction of the step, so that the analysis of a negative step is the same as of a positive one.
+ */
+typedef struct ATUN_StepAnl_s
+{
+	int32_t initVal;		/**< value before the step */
+	int32_t setVal;			/**< desired value after the step */
+	int32_t dir;			/**< direction of the step, +1 or -1 */
+	int64_t step;			/**< absolute height of the step */
+	int64_t band;			/**< half width of the settling band */
+	int64_t peak;			/**< largest normalised value */
+	uint64_t sumAbsErr;		/**< sum of the absolute errors */
+	uint32_t smplCntr;		/**< number of analysed samples */
+	uint32_t t10;			/**< sample which reached 10 % of the step, 0 if not reached yet */
+	uint32_t t90;			/**< sample which reached 90 % of the step, 0 if not reached yet */
+	uint32_t tSettle;		/**< sample after the last one outside the settling band */
+}ATUN_StepAnl_t;
+
+
+
+/*============================ >> GLOBAL FUNCTION DECLARATIONS << ================================*/
+/**
+ * @brief Starts the analysis of a step response
+ * @param pAnl_    Runtime data of the analysis
+ * @param initVal_ Value before the step
+ * @param setVal_  Desired value after the step
+ */
+EXTERNAL_ void ATUN_StepAnl_Init(ATUN_StepAnl_t *pAnl_, int32_t initVal_, int32_t setVal_);
+
+/**
+ * @brief Adds the next sample of the response, the first sample is taken one sample time after
+ * the step
+ * @param pAnl_ Runtime data of the analysis
+ * @param val_  Sampled value
+ */
+EXTERNAL_ void ATUN_StepAnl_Upd(ATUN_StepAnl_t *pAnl_, int32_t val_);
+
+/**
+ * @brief Calculates the characteristics of the step response from the samples so far
+ * @param pAnl_       Runtime data of the analysis
+ * @param smplTimeMs_ Sample time in [ms]
+ * @param pRslt_      Pointer to the result, the index of the item isn't changed
+ */
+EXTERNAL_ void ATUN_StepAnl_Get(const ATUN_StepAnl_t *pAnl_, uint16_t smplTimeMs_, ATUN_StepRslt_t *pRslt_);
+
+
+/**
+ * @}
+ */
+#ifdef EXTERNAL_
+#undef EXTERNAL_
+#endif
+
+#endif /* !ATUN_STEP_H_ */
@@ -4,7 +4,10 @@
  * @brief 		Implementation of battery voltage measurement via ADC
  *
  * This module implements measurement functionality of a battery voltage by means of an ADC
- * provided by the firmware component @b AD1.
+ * provided by the firmware component @b AD1.\n
+ * The main function measures the voltage every BATT_MEAS_CNT calls and filters it by a first order
+ * low-pass, so load peaks of the motors don't show up in the filtered voltage. Other SWCs read the
+ * last measured and the filtered voltage, they don't access the ADC themselves.
  *
  * @author 	(c) 2014 Erich Styger, erich.styger@hslu.ch, Hochschule Luzern
  * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
@@ -30,6 +33,16 @@
 #define BAT_V_DIVIDER_UP   62 /* voltage divider pull-up */
 #define BAT_V_DIVIDER_DOWN 30 /* voltage divider pull-down */
 
+/**
+ * Number of calls of BATT_MainFct() per measurement
+ */
+#define BATT_MEAS_CNT		(10u)
+
+/**
+ * Time constant of the low-pass as right shift, i.e. in multiples of the measurement period
+ */
+#define BATT_FLT_SHIFT		(3u)
+
 
 
 /*=================================== >> TYPE DEFINITIONS << =====================================*/
@@ -41,6 +54,10 @@
 
 
 /*=================================== >> GLOBAL VARIABLES << =====================================*/
+static uint8_t battMeasCntr = 0u;
+static bool isBattValid = FALSE;
+static uint16_t battCV = 0u;
+static uint32_t battFltCV = 0u;	/* filtered voltage scaled by 1 << BATT_FLT_SHIFT */
 
 
 
@@ -76,7 +93,8 @@ StdRtn_t BATT_MeasureBatteryVoltage(uint16_t *cvP)
 /*============================= >> GLOBAL FUNCTION DEFINITIONS << ================================*/
 void BATT_Init(void)
 {
-	/* nothing to do */
+	battMeasCntr = 0u;
+	isBattValid  = FALSE;
 }
 
 void BATT_Deinit(void)
@@ -84,6 +102,53 @@ void BATT_Deinit(void)
 	/* nothing to do */
 }
 
+void BATT_MainFct(void)
+{
+	uint16_t cv = 0u;
+
+	if( 0u == battMeasCntr )
+	{
+		if( ERR_OK == BATT_MeasureBatteryVoltage(&cv) )
+		{
+			battCV = cv;
+			if( FALSE == isBattValid )
+			{
+				battFltCV   = (uint32_t)cv << BATT_FLT_SHIFT;
+				isBattValid = TRUE;
+			}
+			else
+			{
+				battFltCV = battFltCV - ( battFltCV >> BATT_FLT_SHIFT ) + cv;
+			}
+		}
+	}
+	battMeasCntr = ( battMeasCntr + 1u < BATT_MEAS_CNT ) ? battMeasCntr + 1u : 0u;
+}
+
+StdRtn_t BATT_Read_Volt(uint16_t *cvP)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+
+	if( NULL != cvP )
+	{
+		*cvP   = battCV;
+		retVal = ( TRUE == isBattValid ) ? ERR_OK : ERR_VALUE;
+	}
+	return retVal;
+}
+
+StdRtn_t BATT_Read_FltVolt(uint16_t *cvP)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+
+	if( NULL != cvP )
+	{
+		*cvP   = (uint16_t)( battFltCV >> BATT_FLT_SHIFT );
+		retVal = ( TRUE == isBattValid ) ? ERR_OK : ERR_VALUE;
+	}
+	return retVal;
+}
+
 
 
 #ifdef MASTER_batt_C_
@@ -34,6 +34,8 @@
  * @{
  */
 /*======================================= >> #DEFINES << =========================================*/
+/** String identification of the SWC @ref batt */
+#define BATT_SWC_STRING ("battery")
 
 
 
@@ -52,6 +54,12 @@ EXTERNAL_ void BATT_Init(void);
  */
 EXTERNAL_ void BATT_Deinit(void);
 
+/**
+ * @brief Main function of the SWC, which measures and filters the battery voltage periodically.
+ * The measurement waits for the ADC, hence the function must not run in a time-critical task.
+ */
+EXTERNAL_ void BATT_MainFct(void);
+
 
 
 /**
@@ -49,6 +49,24 @@
  */
 EXTERNAL_ StdRtn_t BATT_MeasureBatteryVoltage(uint16_t *cvP);
 
+/**
+ * @brief Reads the battery voltage of the last periodic measurement
+ * @param cvP Pointer to variable where to store the voltage in centi-voltage units (330 is 3.3V)
+ * @return Error code, ERR_OK if everything was fine,
+ *                     ERR_VALUE if there hasn't been a measurement yet,
+ *                     ERR_PARAM_ADDRESS otherwise
+ */
+EXTERNAL_ StdRtn_t BATT_Read_Volt(uint16_t *cvP);
+
+/**
+ * @brief Reads the low-pass filtered battery voltage of the periodic measurements
+ * @param cvP Pointer to variable where to store the voltage in centi-voltage units (330 is 3.3V)
+ * @return Error code, ERR_OK if everything was fine,
+ *                     ERR_VALUE if there hasn't been a measurement yet,
+ *                     ERR_PARAM_ADDRESS otherwise
+ */
+EXTERNAL_ StdRtn_t BATT_Read_FltVolt(uint16_t *cvP);
+
 
 
 /**
@@ -47,13 +47,21 @@ static uint8_t BATT_PrintStatus(const CLS1_StdIOType *io_)
 
   CLS1_SendStatusStr((unsigned char*)"battery", (unsigned char*)"\r\n", io_->stdOut);
   buf[0] = '\0';
-  if (BATT_MeasureBatteryVoltage(&cv)==ERR_OK) {
+  if (BATT_Read_Volt(&cv)==ERR_OK) {
     UTIL1_strcatNum32sDotValue100(buf, sizeof(buf), cv);
     UTIL1_strcat(buf, sizeof(buf), (uint8_t*)" V\r\n");
   } else {
     UTIL1_strcat(buf, sizeof(buf), (uint8_t*)"ERROR\r\n");
   }
   CLS1_SendStatusStr((unsigned char*)"  Voltage", buf, io_->stdOut);
+  buf[0] = '\0';
+  if (BATT_Read_FltVolt(&cv)==ERR_OK) {
+    UTIL1_strcatNum32sDotValue100(buf, sizeof(buf), cv);
+    UTIL1_strcat(buf, sizeof(buf), (uint8_t*)" V\r\n");
+  } else {
+    UTIL1_strcat(buf, sizeof(buf), (uint8_t*)"ERROR\r\n");
+  }
+  CLS1_SendStatusStr((unsigned char*)"  filtered", buf, io_->stdOut);
   return ERR_OK;
 }
 
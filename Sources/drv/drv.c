@@ -8,8 +8,26 @@
  * > - STOP for standstill control
  * > - SPEED for velocity control and
  * > - POSITION control which provides to drive to a certain odometer target value.
- * It decouples the drive control algorithm from the actual application using a @a queue for the
- * communication between the application and this component.\n
+ * It decouples the drive control algorithm from the actual application using a @a mailbox for the
+ * communication between the application and this component. The mailbox keeps the latest command
+ * of each kind, mode, speed and position, in a slot which is protected by a sequence number. A set
+ * call overwrites the slot without waiting and the drive task takes over all slots which have
+ * changed at the beginning of each cycle, in the order of the set calls. The latency from the set
+ * call to the motor output is measured.\n
+ * A motion script is a sequence of segments, which the drive task executes back-to-back without
+ * waiting for the application. It notifies the task which has started the script when the last
+ * segment has completed.\n
+ * In speed mode the target speed is approached by a ramp and the speed controllers in velocity form
+ * are supported by a feedforward part from a motor model. When the mode changes, the
+ * controller taking over the motors continues from the last motor values without a bump. If
+ * @ref DRV_USES_ISR_LOOP is set, the speed loops run in the interrupt of the timer, which samples the
+ * quadrature decoders, and this component hands the speed setpoints over to them.\n
+ * In position mode the position controllers are cascaded with the speed controllers. A motion
+ * profile leads each wheel from its current state to the target within the configured limits of
+ * speed, acceleration and jerk. The position controllers follow the position reference of the
+ * profile and their output corrects its speed reference, which is the speed setpoint. A new target
+ * is taken over by the profile from its current state. A settle detection reports when both sides
+ * have reached the target.
  *
  * @author 	(c) 2014 Erich Styger, erich.styger@hslu.ch, Hochschule Luzern
  * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
@@ -25,27 +43,38 @@
 /*======================================= >> #INCLUDES << ========================================*/
 #include "drv.h"
 #include "drv_api.h"
+#include "drv_cfg.h"
+#include "drv_prof.h"
+#include "drv_kin.h"
+#include "drv_isr.h"
+#include "drv_trac.h"
 #include "pid_api.h"
 #include "tacho_api.h"
 #include "mot.h"
 #include "mot_api.h"
+#include "CS1.h"
 
 #include "FRTOS1.h"
 #include "UTIL1.h"
 #include "CLS1.h"
-#include "Q4CLeft.h"
-#include "Q4CRight.h"
-#include "WAIT1.h"
 
 
 
 /*======================================= >> #DEFINES << =========================================*/
 #define PRINT_DRIVE_INFO  	(0) /* if we print debug info */
-#define QUEUE_LENGTH      	(4) /* number of items in queue, that's my buffer size */
-#define QUEUE_ITEM_SIZE   	(sizeof(DRV_Command)) /* each item is a single drive command */
 #define MATCH_MARGIN		(50)
 #define DRV_TURN_SPEED_LOW  (50)
 
+/**
+ * Keeps the compiler from moving accesses of the mailbox slots across the sequence number
+ */
+#define DRV_BARRIER() __asm__ volatile ("" : : : "memory")
+
+/**
+ * Synchronization error in steps as Q15.16 per sample and step/sec of speed difference, as Q16.16
+ */
+#define DRV_SYNC_ERR_PER_SPD	((int64_t)( (((int64_t)DRV_SMPL_TIME_MS << 32) + 500) / 1000 ))
+
 
 /*=================================== >> TYPE DEFINITIONS << =====================================*/
 typedef enum DRV_Cmd_e
@@ -53,6 +82,8 @@ typedef enum DRV_Cmd_e
 	DRV_SET_MODE,
 	DRV_SET_SPEED,
 	DRV_SET_POS,
+	DRV_SET_SCR,
+	DRV_CMD_CNT,
 } DRV_Cmd_t;
 
 typedef enum DRV_Pid_e
@@ -61,6 +92,7 @@ typedef enum DRV_Pid_e
 	,DRV_PID_SPEED_RIGHT
 	,DRV_PID_POS_LEFT
 	,DRV_PID_POS_RIGHT
+	,DRV_PID_SYNC
 	,DRV_PID_CNT
 } DRV_Pid_t;
 
@@ -75,83 +107,426 @@ typedef struct DRV_Command_s {
 	union {
 		DRV_Mode_t mode;    /* DRV_SET_MODE */
 		DRV_Int32_t speed;	/* DRV_SET_SPEED */
-		DRV_Int32_t pos;		/* DRV_SET_POS */
+		DRV_Int32_t pos;		/* DRV_SET_POS, DRV_SET_SCR has no data */
 	};
 } DRV_Command;
 
+typedef struct DRV_Scr_s
+{
+	DRV_Seg_t aSeg[DRV_SCR_SEG_MAX];
+	uint8_t numSeg;
+	TASK_Hdl_t notfTask;
+} DRV_Scr_t;
+
+typedef struct DRV_Notf_s
+{
+	TASK_Hdl_t task;		/* registered task, NULL for a free entry */
+	uint32_t evtMsk;		/* events the task is notified of on every occurrence */
+	bool isStpPend;		/* the task waits for the robot to stop */
+	TickType_t stpTick;		/* tick count of the start of the wait */
+	TickType_t stpTicks;	/* timeout of the wait in ticks */
+} DRV_Notf_t;
+
+typedef struct DRV_MbxMsg_s
+{
+	DRV_Command cmd;
+	uint32_t ordNo;			/* order of the set call among all slots */
+	TickType_t setTick;		/* tick count of the set call */
+} DRV_MbxMsg_t;
+
+typedef struct DRV_MbxSlot_s
+{
+	volatile uint32_t seq;	/* odd while the slot is written */
+	uint32_t rdSeq;			/* sequence number taken over by the drive task */
+	DRV_MbxMsg_t msg;
+} DRV_MbxSlot_t;
+
 
 
 /*============================= >> LOKAL FUNCTION DECLARATIONS << ================================*/
-static uint8_t GetCmd(void);
+static void DRV_Mbx_Write(const DRV_Command *pCmd_);
+static bool DRV_Mbx_Take(DRV_MbxSlot_t *pSlot_, DRV_MbxMsg_t *pMsg_);
+static bool DRV_Mbx_IsPend(void);
+static void DRV_Proc_Cmd(const DRV_Command *pCmd_);
+static void DRV_Proc_Mbx(void);
+static bool DRV_Is_SegVld(const DRV_Seg_t *pSeg_);
+static void DRV_End_Scr(uint32_t notfVal_);
+static void DRV_Start_Seg(const DRV_Seg_t *pSeg_);
+static bool DRV_Is_SegDone(const DRV_Seg_t *pSeg_);
+static void DRV_Run_Scr(void);
+static DRV_Notf_t *DRV_Get_Notf(TASK_Hdl_t task_);
+static void DRV_Upd_Notf(void);
+static StdRtn_t DRV_Wait_Stpd(int32_t timeoutMs_);
+static uint32_t DRV_Take_Notf(uint32_t evtMsk_, uint32_t *pOthVal_);
 static bool match(int16_t pos, int16_t target);
 static void Parse_CtrlValToMotor(int32_t ctrlVal_, bool isLeft_);
+static int32_t DRV_Calc_FfVal(int32_t spd_, int32_t acc_);
+static void DRV_Ramp_SpdSetVal(int32_t rate_);
+static StdRtn_t DRV_Ctrl_Pos(void);
+static StdRtn_t DRV_Ctrl_Sync(void);
+static StdRtn_t DRV_Ctrl_Spd(void);
+static void DRV_Init_Sync(void);
+static void DRV_Init_Bumpless(void);
 
 
 
 /*=================================== >> GLOBAL VARIABLES << =====================================*/
 static DRV_Status_t DRV_Status;
-static xQueueHandle DRV_Queue;
+static DRV_MbxSlot_t DRV_Mbx[DRV_CMD_CNT];		/* one slot per kind of command */
+static uint32_t DRV_MbxOrdNo = 0u;
+static bool DRV_LatPend = FALSE;			/* a command has been taken over, its latency is pending */
+static TickType_t DRV_LatTick = 0u;		/* tick count of the oldest set call taken over */
+static uint16_t DRV_LatMs = 0u;
+static uint16_t DRV_LatMaxMs = 0u;
+static DRV_Scr_t DRV_ScrPend;				/* script of the last start call */
+static DRV_Scr_t DRV_Scr;					/* script taken over by the drive task */
+static uint8_t DRV_ScrSegIdx = 0u;		/* running segment, DRV_Scr.numSeg if no script is running */
+static bool DRV_ScrSegStrtd = FALSE;		/* the running segment has been started */
+static uint16_t DRV_ScrSegCntr = 0u;		/* calls since the start of the running segment */
+static int32_t DRV_SpdTrgtVal[TACHO_ID_CNT];		/* speed targets of the speed mode or the position loops */
+static int32_t DRV_SpdSetVal[TACHO_ID_CNT];		/* ramped speed setpoints */
+static int32_t DRV_SpdAccVal[TACHO_ID_CNT];		/* change of the speed setpoints of the last call */
+static DRV_Prof_t DRV_Prof[TACHO_ID_CNT];		/* motion profiles of the position loops */
+static uint16_t DRV_SettleCntr = 0u;
+static int32_t DRV_CtrlVal[TACHO_ID_CNT];		/* last motor values */
+static volatile uint8_t DRV_SyncModeMsk = 0u;	/* modes with synchronization, bit n for DRV_Mode_t n */
+static int32_t DRV_SyncErr = 0;				/* synchronization error in steps as Q15.16 */
+static int32_t DRV_SyncPos[TACHO_ID_CNT];		/* wheel positions of the last call */
+static int32_t DRV_SyncCorr = 0;				/* speed correction of the synchronization in steps/sec */
+static bool DRV_ModeChgd = FALSE;
+static DRV_Notf_t DRV_Notf[DRV_NOTF_TASK_MAX];	/* tasks which are notified of drive events */
+static bool DRV_WasStpd = FALSE;			/* DRV_IsStopped() of the last call */
+static bool DRV_HadTurned = FALSE;			/* DRV_HasTurned() of the last call */
 
 
 
 /*============================== >> LOKAL FUNCTION DEFINITIONS << ================================*/
-static StdRtn_t GetCmd(void) {
-	DRV_Command cmd = {0u};
-	StdRtn_t retVal = ERR_OK;
+/**
+ * @brief Overwrites the slot of the command pCmd_. Several tasks may set commands, so the writers
+ * exclude each other for the few instructions of the copy.
+ */
+static void DRV_Mbx_Write(const DRV_Command *pCmd_)
+{
+	DRV_MbxSlot_t *pSlot = &DRV_Mbx[pCmd_->cmd];
+	TickType_t tick = FRTOS1_xTaskGetTickCount();
+	CS1_CriticalVariable();
+
+	CS1_EnterCritical();
+	pSlot->seq++;
+	DRV_BARRIER();
+	pSlot->msg.cmd     = *pCmd_;
+	pSlot->msg.ordNo   = ++DRV_MbxOrdNo;
+	pSlot->msg.setTick = tick;
+	DRV_BARRIER();
+	pSlot->seq++;
+	CS1_ExitCritical();
+}
+
+/**
+ * @brief Copies the message of a slot if it has been written since it was taken over the last
+ * time, the copy is repeated if a writer intervened
+ * @return TRUE if the slot contained a new message
+ */
+static bool DRV_Mbx_Take(DRV_MbxSlot_t *pSlot_, DRV_MbxMsg_t *pMsg_)
+{
+	uint32_t seq = 0u;
+	bool isNew = FALSE;
+
+	do
+	{
+		seq = pSlot_->seq;
+		DRV_BARRIER();
+		isNew = ( seq != pSlot_->rdSeq );
+		if( TRUE == isNew )
+		{
+			*pMsg_ = pSlot_->msg;
+		}
+		DRV_BARRIER();
+	} while( ( 0u != ( seq & 1u ) ) || ( seq != pSlot_->seq ) );
+	pSlot_->rdSeq = seq;
+	return isNew;
+}
+
+/**
+ * @brief Returns TRUE if a slot has been written, which hasn't been taken over yet
+ */
+static bool DRV_Mbx_IsPend(void)
+{
+	bool retVal = FALSE;
+	uint8_t i = 0u;
+
+	for(i = 0u; i < DRV_CMD_CNT; i++)
+	{
+		retVal |= ( DRV_Mbx[i].seq != DRV_Mbx[i].rdSeq );
+	}
+	return retVal;
+}
 
-	if (errQUEUE_EMPTY == FRTOS1_xQueueReceive(DRV_Queue, &cmd, 0)) {
-		retVal = ERR_RXEMPTY; /* no command */
+static void DRV_Proc_Cmd(const DRV_Command *pCmd_)
+{
+	if (pCmd_->cmd==DRV_SET_MODE)
+	{
+		/* reset PID, especially integral counters */
+		PID_Reset(DRV_PID_SPEED_LEFT);
+		PID_Reset(DRV_PID_SPEED_RIGHT);
+		PID_Reset(DRV_PID_POS_LEFT);
+		PID_Reset(DRV_PID_POS_RIGHT);
+		PID_Reset(DRV_PID_SYNC);
+		DRV_ModeChgd = TRUE;
+		DRV_Status.mode = pCmd_->mode;
+	}
+	else if (pCmd_->cmd==DRV_SET_SPEED)
+	{
+		DRV_Status.speed.left = pCmd_->speed.left;
+		DRV_Status.speed.right = pCmd_->speed.right;
+	}
+	else if (pCmd_->cmd==DRV_SET_POS)
+	{
+		if ( (DRV_Status.pos.left != pCmd_->pos.left) || (DRV_Status.pos.right != pCmd_->pos.right) )
+		{
+			DRV_Status.posState = DRV_POS_STATE_MOVE;
+			DRV_SettleCntr = 0u;
+		}
+		DRV_Status.pos.left = pCmd_->pos.left;
+		DRV_Status.pos.right = pCmd_->pos.right;
+	}
+#if PRINT_DRIVE_INFO
+	{
+		uint8_t buf[32];
+
+		if (pCmd_->cmd==DRV_SET_MODE) {
+			UTIL1_strcpy(buf, sizeof(buf), "SETMODE: ");
+			UTIL1_strcat(buf, sizeof(buf), DRV_GetModeStr(DRV_Status.mode));
+		} else if (pCmd_->cmd==DRV_SET_SPEED) {
+			UTIL1_strcpy(buf, sizeof(buf), "SETSPEED: ");
+			UTIL1_strcatNum32s(buf, sizeof(buf), DRV_Status.speed.left);
+			UTIL1_strcat(buf, sizeof(buf), ", ");
+			UTIL1_strcatNum32s(buf, sizeof(buf), DRV_Status.speed.right);
+		} else if (pCmd_->cmd==DRV_SET_POS) {
+			UTIL1_strcpy(buf, sizeof(buf), "SETPOS: ");
+			UTIL1_strcatNum32s(buf, sizeof(buf), DRV_Status.pos.left);
+			UTIL1_strcat(buf, sizeof(buf), ", ");
+			UTIL1_strcatNum32s(buf, sizeof(buf), DRV_Status.pos.right);
+		} else {
+			UTIL1_strcpy(buf, sizeof(buf), "ERROR!");
+		}
+		UTIL1_strcat(buf, sizeof(buf), "\r\n");
+		SHELL_SendString(buf);
+	}
+#endif
+}
+
+/**
+ * @brief Takes over the new commands of all slots and processes them in the order of their set
+ * calls, e.g. the position of a stop before the change to the position mode
+ */
+static void DRV_Proc_Mbx(void)
+{
+	DRV_MbxMsg_t aMsg[DRV_CMD_CNT];
+	DRV_MbxMsg_t tmp;
+	uint8_t cnt = 0u, i = 0u, j = 0u;
+	CS1_CriticalVariable();
+
+	for(i = 0u; i < DRV_CMD_CNT; i++)
+	{
+		if( TRUE == DRV_Mbx_Take(&DRV_Mbx[i], &aMsg[cnt]) )
+		{
+			cnt++;
+		}
+	}
+	for(i = 1u; i < cnt; i++)
+	{
+		/* the order number may wrap around */
+		for(j = i; ( j > 0u ) && ( (int32_t)(aMsg[j].ordNo - aMsg[j-1u].ordNo) < 0 ); j--)
+		{
+			tmp = aMsg[j];
+			aMsg[j] = aMsg[j-1u];
+			aMsg[j-1u] = tmp;
+		}
+	}
+	for(i = 0u; i < cnt; i++)
+	{
+		/* a command of the application overrides a running script, the notification of its task
+		 * is sent outside of any critical section */
+		if( DRV_ScrSegIdx < DRV_Scr.numSeg )
+		{
+			DRV_End_Scr(DRV_SCR_ABORT_NOTIFICATION_VALUE);
+		}
+		if( DRV_SET_SCR == aMsg[i].cmd.cmd )
+		{
+			/* the pending script belongs to the latest write of the slot, which is taken over
+			 * with it, as the writers copy both within one critical section of CS1 */
+			CS1_EnterCritical();
+			DRV_Scr = DRV_ScrPend;
+			DRV_Mbx[DRV_SET_SCR].rdSeq = DRV_Mbx[DRV_SET_SCR].seq;
+			CS1_ExitCritical();
+			DRV_ScrSegIdx   = 0u;
+			DRV_ScrSegStrtd = FALSE;
+		}
+		else
+		{
+			DRV_Proc_Cmd(&aMsg[i].cmd);
+		}
+	}
+	if( ( 0u != cnt ) && ( FALSE == DRV_LatPend ) )
+	{
+		DRV_LatPend = TRUE;
+		DRV_LatTick = aMsg[0].setTick;
+	}
+}
+
+
+/**
+ * @brief Returns TRUE if the kind and the completion condition of a segment are valid and fit
+ */
+static bool DRV_Is_SegVld(const DRV_Seg_t *pSeg_)
+{
+	bool retVal = FALSE;
+
+	if( ( DRV_SEG_TYPE_INVALID > pSeg_->type ) && ( DRV_SEG_DONE_INVALID > pSeg_->done ) )
+	{
+		retVal = ( ( DRV_SEG_POS == pSeg_->type ) || ( DRV_SEG_TURN == pSeg_->type )
+				|| ( DRV_SEG_DONE_TIME == pSeg_->done ) );
+	}
+	return retVal;
+}
+
+/**
+ * @brief Ends the running script and notifies its task by notfVal_
+ */
+static void DRV_End_Scr(uint32_t notfVal_)
+{
+	DRV_ScrSegIdx = DRV_Scr.numSeg;
+	if( NULL != DRV_Scr.notfTask )
+	{
+		(void)FRTOS1_xTaskNotify(DRV_Scr.notfTask, notfVal_, eSetBits);
+	}
+}
+
+/**
+ * @brief Applies the commands of a segment directly, i.e. without the mailbox. Position and turn
+ * segments move relative to the target of the position mode or to the current position.
+ */
+static void DRV_Start_Seg(const DRV_Seg_t *pSeg_)
+{
+	DRV_Command cmd = {0};
+	int32_t turnSteps = 0;
+
+	if( DRV_SEG_SPEED == pSeg_->type )
+	{
+		cmd.cmd = DRV_SET_SPEED;
+		cmd.speed.left  = pSeg_->valLe;
+		cmd.speed.right = pSeg_->valRi;
+		DRV_Proc_Cmd(&cmd);
+		if( DRV_MODE_SPEED != DRV_Status.mode )
+		{
+			cmd.cmd  = DRV_SET_MODE;
+			cmd.mode = DRV_MODE_SPEED;
+			DRV_Proc_Cmd(&cmd);
+		}
 	}
 	else
 	{
-		/* process command */
-			FRTOS1_taskENTER_CRITICAL();
-			if (cmd.cmd==DRV_SET_MODE)
-			{
-				/* reset PID, especially integral counters */
-				PID_Reset(DRV_PID_SPEED_LEFT);
-				PID_Reset(DRV_PID_SPEED_RIGHT);
-				PID_Reset(DRV_PID_POS_LEFT);
-				PID_Reset(DRV_PID_POS_LEFT);
-				DRV_Status.mode = cmd.mode;
-			}
-			else if (cmd.cmd==DRV_SET_SPEED)
-			{
-				DRV_Status.speed.left = cmd.speed.left;
-				DRV_Status.speed.right = cmd.speed.right;
-			}
-			else if (cmd.cmd==DRV_SET_POS)
+		cmd.cmd = DRV_SET_POS;
+		if( DRV_MODE_POS == DRV_Status.mode )
+		{
+			cmd.pos.left  = DRV_Status.pos.left;
+			cmd.pos.right = DRV_Status.pos.right;
+		}
+		else
+		{
+			(void)TACHO_Read_PosLe(&cmd.pos.left);
+			(void)TACHO_Read_PosRi(&cmd.pos.right);
+		}
+		if( DRV_SEG_POS == pSeg_->type )
+		{
+			cmd.pos.left  += pSeg_->valLe;
+			cmd.pos.right += pSeg_->valRi;
+		}
+		else if( DRV_SEG_TURN == pSeg_->type )
+		{
+			turnSteps = DRV_Kin_HdgToSteps(pSeg_->valLe);
+			cmd.pos.left  -= turnSteps;
+			cmd.pos.right += turnSteps;
+		}
+		else
+		{
+			/* wait at the target or the current position */
+		}
+		DRV_Proc_Cmd(&cmd);
+		if( DRV_MODE_POS != DRV_Status.mode )
+		{
+			cmd.cmd  = DRV_SET_MODE;
+			cmd.mode = DRV_MODE_POS;
+			DRV_Proc_Cmd(&cmd);
+		}
+	}
+	DRV_ScrSegCntr = 0u;
+}
+
+/**
+ * @brief Returns TRUE if the completion condition of the running segment is fulfilled
+ */
+static bool DRV_Is_SegDone(const DRV_Seg_t *pSeg_)
+{
+	bool retVal = FALSE;
+
+	if( DRV_SEG_DONE_TIME == pSeg_->done )
+	{
+		retVal = ( (uint32_t)DRV_ScrSegCntr * DRV_SMPL_TIME_MS >= pSeg_->timeMs );
+	}
+	else if( DRV_SEG_DONE_PROF == pSeg_->done )
+	{
+		retVal = ( ( TRUE == DRV_Prof_Is_Done(&DRV_Prof[TACHO_ID_LEFT]) )
+				&& ( TRUE == DRV_Prof_Is_Done(&DRV_Prof[TACHO_ID_RIGHT]) ) );
+	}
+	else
+	{
+		retVal = ( DRV_POS_STATE_SETTLED == DRV_Status.posState );
+	}
+	return retVal;
+}
+
+/**
+ * @brief Runs the script before the controllers of this call. A completed segment is followed by
+ * the next one within the same call, so there's no dead time between the segments.
+ */
+static void DRV_Run_Scr(void)
+{
+	const DRV_Seg_t *pSeg = NULL;
+
+	while( DRV_ScrSegIdx < DRV_Scr.numSeg )
+	{
+		pSeg = &DRV_Scr.aSeg[DRV_ScrSegIdx];
+		if( FALSE == DRV_ScrSegStrtd )
+		{
+			DRV_Start_Seg(pSeg);
+			DRV_ScrSegStrtd = TRUE;
+			break;
+		}
+		if( DRV_ScrSegCntr < 0xFFFFu )
+		{
+			DRV_ScrSegCntr++;
+		}
+		if( TRUE == DRV_Is_SegDone(pSeg) )
+		{
+			DRV_ScrSegIdx++;
+			DRV_ScrSegStrtd = FALSE;
+			if( DRV_ScrSegIdx >= DRV_Scr.numSeg )
 			{
-				DRV_Status.pos.left = cmd.pos.left;
-				DRV_Status.pos.right = cmd.pos.right;
+				DRV_End_Scr(DRV_SCR_DONE_NOTIFICATION_VALUE);
 			}
-			FRTOS1_taskEXIT_CRITICAL();
-		#if PRINT_DRIVE_INFO
+		}
+		else
+		{
+			if( ( DRV_SEG_DONE_TIME != pSeg->done ) && ( 0u != pSeg->timeMs )
+					&& ( (uint32_t)DRV_ScrSegCntr * DRV_SMPL_TIME_MS >= pSeg->timeMs ) )
 			{
-				uint8_t buf[32];
-
-				if (cmd.cmd==DRV_SET_MODE) {
-					UTIL1_strcpy(buf, sizeof(buf), "SETMODE: ");
-					UTIL1_strcat(buf, sizeof(buf), DRV_GetModeStr(DRV_Status.mode));
-				} else if (cmd.cmd==DRV_SET_SPEED) {
-					UTIL1_strcpy(buf, sizeof(buf), "SETSPEED: ");
-					UTIL1_strcatNum32s(buf, sizeof(buf), DRV_Status.speed.left);
-					UTIL1_strcat(buf, sizeof(buf), ", ");
-					UTIL1_strcatNum32s(buf, sizeof(buf), DRV_Status.speed.right);
-				} else if (cmd.cmd==DRV_SET_POS) {
-					UTIL1_strcpy(buf, sizeof(buf), "SETPOS: ");
-					UTIL1_strcatNum32s(buf, sizeof(buf), DRV_Status.pos.left);
-					UTIL1_strcat(buf, sizeof(buf), ", ");
-					UTIL1_strcatNum32s(buf, sizeof(buf), DRV_Status.pos.right);
-				} else {
-					UTIL1_strcpy(buf, sizeof(buf), "ERROR!");
-				}
-				UTIL1_strcat(buf, sizeof(buf), "\r\n");
-				SHELL_SendString(buf);
+				DRV_End_Scr(DRV_SCR_ABORT_NOTIFICATION_VALUE);
 			}
-		#endif
+			break;
+		}
 	}
-	return retVal;
 }
 
 
@@ -179,8 +554,8 @@ static void Parse_CtrlValToMotor(int32_t ctrlVal_, bool isLeft_)
 	else				motHandle = MOT_GetMotorHandle(MOT_MOTOR_RIGHT);
 	if(NULL != motHandle)
 	{
-		MOT_SetVal(motHandle, 0xFFFF-ctrlVal_); /* PWM is low active */
 		MOT_SetDirection(motHandle, direction);
+		MOT_SetVal(motHandle, 0xFFFF-ctrlVal_); /* PWM is low active */
 		MOT_UpdatePercent(motHandle, direction);
 	}
 	else
@@ -189,26 +564,497 @@ static void Parse_CtrlValToMotor(int32_t ctrlVal_, bool isLeft_)
 	}
 	return;
 }
+
+/**
+ * @brief Calculates the feedforward motor value of the speed spd_ from the motor model, acc_ is the
+ * change of the speed per call
+ */
+static int32_t DRV_Calc_FfVal(int32_t spd_, int32_t acc_)
+{
+	const DRV_Cfg_t *pCfg = Get_pDrvCfg();
+	int32_t ffVal = (int32_t)( ( (int64_t)spd_ * pCfg->ffGain + (int64_t)acc_ * pCfg->ffAccGain ) >> 16 );
+
+	if( spd_ > 0 )
+	{
+		ffVal += pCfg->ffOffset;
+	}
+	else if( spd_ < 0 )
+	{
+		ffVal -= pCfg->ffOffset;
+	}
+	return ffVal;
+}
+
+/**
+ * @brief Moves the ramped speed setpoints towards the speed targets by rate_ per call at most
+ */
+static void DRV_Ramp_SpdSetVal(int32_t rate_)
+{
+	uint8_t i = 0u;
+
+	for(i = 0u; i < TACHO_ID_CNT; i++)
+	{
+		DRV_SpdAccVal[i] = DRV_SpdSetVal[i];
+		if( DRV_SpdTrgtVal[i] > DRV_SpdSetVal[i] + rate_ )
+		{
+			DRV_SpdSetVal[i] += rate_;
+		}
+		else if( DRV_SpdTrgtVal[i] < DRV_SpdSetVal[i] - rate_ )
+		{
+			DRV_SpdSetVal[i] -= rate_;
+		}
+		else
+		{
+			DRV_SpdSetVal[i] = DRV_SpdTrgtVal[i];
+		}
+		DRV_SpdAccVal[i] = DRV_SpdSetVal[i] - DRV_SpdAccVal[i];
+	}
+}
+
+/**
+ * @brief Advances the motion profiles, runs the position loops, which set the speed setpoints, and
+ * the settle detection
+ */
+static StdRtn_t DRV_Ctrl_Pos(void)
+{
+	StdRtn_t retVal = ERR_OK;
+	const DRV_Cfg_t *pCfg = Get_pDrvCfg();
+	int32_t aTrgtVal[TACHO_ID_CNT] = {DRV_Status.pos.left, DRV_Status.pos.right};
+	int32_t aSetVal[TACHO_ID_CNT] = {0};
+	int32_t aActVal[TACHO_ID_CNT] = {0};
+	int32_t aSpdVal[TACHO_ID_CNT] = {0};
+	int32_t aRefSpd[TACHO_ID_CNT] = {0};
+	int32_t err = 0;
+	int16_t i16ActVal = 0;
+	bool isInMargin = TRUE;
+	uint8_t i = 0u;
+
+	retVal |= TACHO_Read_PosLe(&aActVal[TACHO_ID_LEFT]);
+	retVal |= TACHO_Read_PosRi(&aActVal[TACHO_ID_RIGHT]);
+
+	for(i = 0u; i < TACHO_ID_CNT; i++)
+	{
+		DRV_Prof_Set_Trgt(&DRV_Prof[i], aTrgtVal[i]);
+		aRefSpd[i] = DRV_Prof_Get_Spd(&DRV_Prof[i]);
+		DRV_Prof_Step(&DRV_Prof[i]);
+		aSetVal[i] = DRV_Prof_Get_Pos(&DRV_Prof[i]);
+		DRV_SpdAccVal[i] = DRV_Prof_Get_Spd(&DRV_Prof[i]) - aRefSpd[i];
+		aRefSpd[i] = DRV_Prof_Get_Spd(&DRV_Prof[i]);
+	}
+
+	/* settle detection, the profiles have to be finished */
+	for(i = 0u; i < TACHO_ID_CNT; i++)
+	{
+		err = aTrgtVal[i] - aActVal[i];
+		retVal |= (TACHO_ID_LEFT == i) ? TACHO_Read_SpdLe(&i16ActVal) : TACHO_Read_SpdRi(&i16ActVal);
+		if( (err > pCfg->posSettleMargin) || (err < -pCfg->posSettleMargin)
+				|| ((int32_t)i16ActVal > pCfg->posSettleSpd) || ((int32_t)i16ActVal < -pCfg->posSettleSpd)
+				|| (FALSE == DRV_Prof_Is_Done(&DRV_Prof[i])) )
+		{
+			isInMargin = FALSE;
+		}
+	}
+	if( FALSE == isInMargin )
+	{
+		DRV_Status.posState = DRV_POS_STATE_MOVE;
+		DRV_SettleCntr = 0u;
+	}
+	else if( DRV_POS_STATE_SETTLED != DRV_Status.posState )
+	{
+		DRV_Status.posState = DRV_POS_STATE_SETTLING;
+		DRV_SettleCntr++;
+		if( DRV_SettleCntr >= pCfg->posSettleCnt )
+		{
+			DRV_Status.posState = DRV_POS_STATE_SETTLED;
+		}
+	}
+	else
+	{
+		/* stay settled */
+	}
+
+	/* conditional integration, the profile is tracked by its speed reference and the proportional
+	 * part, the integral part only removes the remaining error at the target */
+	for(i = 0u; i < TACHO_ID_CNT; i++)
+	{
+		retVal |= PID_Set_IntHold(DRV_PID_POS_LEFT + i, ( (FALSE == DRV_Prof_Is_Done(&DRV_Prof[i]))
+				|| (DRV_POS_STATE_SETTLED == DRV_Status.posState) ));
+	}
+
+	/* DRV_PID_POS_LEFT and DRV_PID_POS_RIGHT are consecutive items */
+	retVal |= PID_Batch(DRV_PID_POS_LEFT, TACHO_ID_CNT, aSetVal, aActVal, NULL, aSpdVal);
+
+	for(i = 0u; i < TACHO_ID_CNT; i++)
+	{
+		if( DRV_POS_STATE_SETTLED == DRV_Status.posState )
+		{
+			DRV_SpdTrgtVal[i] = 0;
+		}
+		else
+		{
+			DRV_SpdTrgtVal[i] = aRefSpd[i] + aSpdVal[i];
+		}
+		/* the profile is limited in acceleration already */
+		DRV_SpdSetVal[i] = DRV_SpdTrgtVal[i];
+	}
+	return retVal;
+}
+
+/**
+ * @brief Runs the cross-coupled synchronization of both wheels. Its error is the difference of
+ * the tracking errors of both wheels, i.e. the deviation of the robot from the commanded curvature
+ * in steps. In position mode the tracking errors refer to the motion profiles. In speed mode the
+ * difference of the ramped speed setpoints is integrated instead. The correction speeds up the
+ * lagging wheel and slows down the leading wheel by the same amount.
+ */
+static StdRtn_t DRV_Ctrl_Sync(void)
+{
+	StdRtn_t retVal = ERR_OK;
+	const DRV_Cfg_t *pCfg = Get_pDrvCfg();
+	int32_t aPos[TACHO_ID_CNT] = {0};
+	int64_t errMax = (int64_t)pCfg->syncErrMax * 65536;
+	int64_t err = 0;
+	int32_t errSet = 0, errAct = 0;
+
+	retVal |= TACHO_Read_PosLe(&aPos[TACHO_ID_LEFT]);
+	retVal |= TACHO_Read_PosRi(&aPos[TACHO_ID_RIGHT]);
+
+	if( DRV_MODE_POS == DRV_Status.mode )
+	{
+		err = ( ( (int64_t)DRV_Prof_Get_Pos(&DRV_Prof[TACHO_ID_LEFT]) - aPos[TACHO_ID_LEFT] )
+				- ( (int64_t)DRV_Prof_Get_Pos(&DRV_Prof[TACHO_ID_RIGHT]) - aPos[TACHO_ID_RIGHT] ) ) * 65536;
+	}
+	else
+	{
+		err = (int64_t)DRV_SyncErr
+				+ ( ( (int64_t)( DRV_SpdSetVal[TACHO_ID_LEFT] - DRV_SpdSetVal[TACHO_ID_RIGHT] ) * DRV_SYNC_ERR_PER_SPD
+						+ ( 1 << 15 ) ) >> 16 )
+				- (int64_t)( ( aPos[TACHO_ID_LEFT] - DRV_SyncPos[TACHO_ID_LEFT] )
+						- ( aPos[TACHO_ID_RIGHT] - DRV_SyncPos[TACHO_ID_RIGHT] ) ) * 65536;
+	}
+	/* a blocked wheel mustn't build up an error, which turns the robot once it is free again, the
+	 * error is limited in 64 bit before it is narrowed to Q15.16 */
+	DRV_SyncErr = (int32_t)( ( err > errMax ) ? errMax : ( ( err < -errMax ) ? -errMax : err ) );
+	DRV_SyncPos[TACHO_ID_LEFT]  = aPos[TACHO_ID_LEFT];
+	DRV_SyncPos[TACHO_ID_RIGHT] = aPos[TACHO_ID_RIGHT];
+
+	/* settled position loops hold the wheels, the synchronization only corrects moving wheels */
+	if( ( 0u != ( DRV_SyncModeMsk & ( 1u << DRV_Status.mode ) ) )
+			&& ( ( DRV_MODE_POS != DRV_Status.mode ) || ( DRV_POS_STATE_SETTLED != DRV_Status.posState ) ) )
+	{
+		errSet = ( DRV_SyncErr + ( 1 << 15 ) ) >> 16;
+		retVal |= PID_Batch(DRV_PID_SYNC, 1u, &errSet, &errAct, NULL, &DRV_SyncCorr);
+	}
+	else
+	{
+		DRV_SyncCorr = 0;
+		(void)PID_Reset(DRV_PID_SYNC);
+	}
+	return retVal;
+}
+
+/**
+ * @brief Runs the speed loops, which follow the ramped speed setpoints with the correction of the
+ * synchronization, and sets the motors. If the speed loops run in the timer interrupt, they take
+ * over the setpoints instead. A wheel, which slips or stalls, is limited and its integral part
+ * is frozen as configured.
+ */
+static StdRtn_t DRV_Ctrl_Spd(void)
+{
+	StdRtn_t retVal = ERR_OK;
+	int32_t aSetVal[TACHO_ID_CNT] = {0};
+	int32_t aFfVal[TACHO_ID_CNT] = {0};
+	int32_t aCtrlMax[TACHO_ID_CNT] = {0};
+#if DRV_USES_ISR_LOOP
+	bool aIntHold[TACHO_ID_CNT] = {FALSE};
+#else
+	int32_t aActVal[TACHO_ID_CNT] = {0};
+	int16_t i16ActVal = 0;
+#endif
+	uint8_t i = 0u;
+
+	DRV_Trac_Step();
+
+	aSetVal[TACHO_ID_LEFT]  = DRV_SpdSetVal[TACHO_ID_LEFT]  + DRV_SyncCorr;
+	aSetVal[TACHO_ID_RIGHT] = DRV_SpdSetVal[TACHO_ID_RIGHT] - DRV_SyncCorr;
+	for(i = 0u; i < TACHO_ID_CNT; i++)
+	{
+		aFfVal[i]   = DRV_Calc_FfVal(aSetVal[i], DRV_SpdAccVal[i]);
+		aCtrlMax[i] = DRV_Trac_Get_CtrlMax(i);
+	}
+
+#if DRV_USES_ISR_LOOP
+	for(i = 0u; i < TACHO_ID_CNT; i++)
+	{
+		aIntHold[i] = DRV_Trac_Is_IntHold(i);
+	}
+	DRV_Isr_Set_Ref(aSetVal, aFfVal, aCtrlMax, aIntHold);
+	DRV_Isr_Read_CtrlVal(DRV_CtrlVal);
+#else
+	retVal |= TACHO_Read_SpdLe(&i16ActVal);
+	aActVal[TACHO_ID_LEFT]  = (int32_t)i16ActVal;
+	retVal |= TACHO_Read_SpdRi(&i16ActVal);
+	aActVal[TACHO_ID_RIGHT] = (int32_t)i16ActVal;
+
+	for(i = 0u; i < TACHO_ID_CNT; i++)
+	{
+		/* conditional integration, the ramp or the profile is tracked by the proportional and
+		 * feedforward part */
+		retVal |= PID_Set_IntHold(DRV_PID_SPEED_LEFT + i, ( (0 != DRV_SpdAccVal[i])
+				|| (TRUE == DRV_Trac_Is_IntHold(i)) ));
+	}
+
+	/* DRV_PID_SPEED_LEFT and DRV_PID_SPEED_RIGHT are consecutive items */
+	retVal |= PID_Batch(DRV_PID_SPEED_LEFT, TACHO_ID_CNT, aSetVal, aActVal, aFfVal, DRV_CtrlVal);
+	for(i = 0u; i < TACHO_ID_CNT; i++)
+	{
+		if( (DRV_CtrlVal[i] > aCtrlMax[i]) || (DRV_CtrlVal[i] < -aCtrlMax[i]) )
+		{
+			/* the loop continues from the limited motor value */
+			DRV_CtrlVal[i] = (DRV_CtrlVal[i] > 0) ? aCtrlMax[i] : -aCtrlMax[i];
+			retVal |= PID_Set_Bumpless(DRV_PID_SPEED_LEFT + i, aSetVal[i], aActVal[i], aFfVal[i], DRV_CtrlVal[i]);
+		}
+	}
+	Parse_CtrlValToMotor(DRV_CtrlVal[TACHO_ID_LEFT], TRUE);
+	Parse_CtrlValToMotor(DRV_CtrlVal[TACHO_ID_RIGHT], FALSE);
+#endif
+	return retVal;
+}
+
+/**
+ * @brief Returns the entry of a task, or a free entry if the task isn't registered, or NULL if
+ * there is no entry left. It has to be called within a critical section.
+ */
+static DRV_Notf_t *DRV_Get_Notf(TASK_Hdl_t task_)
+{
+	DRV_Notf_t *pNotf = NULL;
+	uint8_t i = 0u;
+
+	for(i = 0u; i < DRV_NOTF_TASK_MAX; i++)
+	{
+		if( task_ == DRV_Notf[i].task )
+		{
+			pNotf = &DRV_Notf[i];
+			break;
+		}
+		else if( ( NULL == pNotf ) && ( NULL == DRV_Notf[i].task ) )
+		{
+			pNotf = &DRV_Notf[i];
+		}
+		else
+		{
+			/* entry of another task */
+		}
+	}
+	return pNotf;
+}
+
+/**
+ * @brief Notifies the registered tasks of the events of this call, i.e. the robot has stopped or
+ * turned, and the waiting tasks of the end of their wait. The notifications are collected within
+ * the critical section and sent after it.
+ */
+static void DRV_Upd_Notf(void)
+{
+	TASK_Hdl_t aTask[DRV_NOTF_TASK_MAX] = {NULL};
+	uint32_t aVal[DRV_NOTF_TASK_MAX] = {0u};
+	uint32_t evt = 0u;
+	TickType_t tick = FRTOS1_xTaskGetTickCount();
+	bool isStpd = DRV_IsStopped();
+	/* DRV_HasTurned() holds in any other mode than the position mode */
+	bool hasTurned = ( DRV_MODE_POS == DRV_Status.mode ) && ( TRUE == DRV_HasTurned() );
+	DRV_Notf_t *pNotf = NULL;
+	uint8_t i = 0u;
+	CS1_CriticalVariable();
+
+	if( ( TRUE == isStpd ) && ( FALSE == DRV_WasStpd ) )
+	{
+		evt |= DRV_MOVE_DONE_NOTIFICATION_VALUE;
+	}
+	if( ( TRUE == hasTurned ) && ( FALSE == DRV_HadTurned ) )
+	{
+		evt |= DRV_TURNED_NOTIFICATION_VALUE;
+	}
+	DRV_WasStpd   = isStpd;
+	DRV_HadTurned = hasTurned;
+
+	CS1_EnterCritical();
+	for(i = 0u; i < DRV_NOTF_TASK_MAX; i++)
+	{
+		pNotf    = &DRV_Notf[i];
+		aTask[i] = pNotf->task;
+		aVal[i]  = evt & pNotf->evtMsk;
+		if( TRUE == pNotf->isStpPend )
+		{
+			if( TRUE == isStpd )
+			{
+				aVal[i] |= DRV_STOP_DONE_NOTIFICATION_VALUE;
+				pNotf->isStpPend = FALSE;
+			}
+			else if( (TickType_t)( tick - pNotf->stpTick ) >= pNotf->stpTicks )
+			{
+				aVal[i] |= DRV_STOP_TIMEOUT_NOTIFICATION_VALUE;
+				pNotf->isStpPend = FALSE;
+			}
+			else
+			{
+				/* keep waiting */
+			}
+		}
+		if( ( 0u == pNotf->evtMsk ) && ( FALSE == pNotf->isStpPend ) )
+		{
+			pNotf->task = NULL;
+		}
+	}
+	CS1_ExitCritical();
+
+	for(i = 0u; i < DRV_NOTF_TASK_MAX; i++)
+	{
+		if( ( NULL != aTask[i] ) && ( 0u != aVal[i] ) )
+		{
+			(void)FRTOS1_xTaskNotify(aTask[i], aVal[i], eSetBits);
+		}
+	}
+}
+
+/**
+ * @brief Blocks the calling task until the drive task notifies it of the end of its wait for the
+ * robot to stop. Other notifications, which arrive meanwhile, are handed back to the task.
+ * @return ERR_OK if the robot has stopped, ERR_BUSY for timeout condition
+ */
+static StdRtn_t DRV_Wait_Stpd(int32_t timeoutMs_)
+{
+	const uint32_t stpMsk = DRV_STOP_DONE_NOTIFICATION_VALUE | DRV_STOP_TIMEOUT_NOTIFICATION_VALUE;
+	StdRtn_t retVal = ERR_BUSY;
+	uint32_t notfVal = 0u, othVal = 0u;
+	TickType_t strtTick = FRTOS1_xTaskGetTickCount();
+	/* the drive task sends the timeout, the own timeout only guards against a drive task which
+	 * doesn't run */
+	TickType_t maxTicks = pdMS_TO_TICKS( ( ( timeoutMs_ > 0 ) ? (uint32_t)timeoutMs_ : 0u )
+			+ 4u * DRV_SMPL_TIME_MS ) + 1u;
+	TickType_t elpsTicks = 0u;
+	bool isDone = FALSE;
+
+	while( FALSE == isDone )
+	{
+		notfVal = 0u;
+		if( pdPASS == FRTOS1_xTaskNotifyWait(0u, stpMsk, &notfVal, maxTicks - elpsTicks) )
+		{
+			othVal |= notfVal & ~stpMsk;
+			if( 0u != ( notfVal & DRV_STOP_DONE_NOTIFICATION_VALUE ) )
+			{
+				retVal = ERR_OK;
+				isDone = TRUE;
+			}
+			else if( 0u != ( notfVal & DRV_STOP_TIMEOUT_NOTIFICATION_VALUE ) )
+			{
+				isDone = TRUE;
+			}
+		}
+		elpsTicks = (TickType_t)( FRTOS1_xTaskGetTickCount() - strtTick );
+		if( ( FALSE == isDone ) && ( elpsTicks >= maxTicks ) )
+		{
+			(void)DRV_Notf_Stpd(NULL, 0);
+			isDone = TRUE;
+		}
+	}
+	if( 0u != othVal )
+	{
+		/* the wait has taken the pending state of these notifications */
+		(void)FRTOS1_xTaskNotify(FRTOS1_xTaskGetCurrentTaskHandle(), othVal, eSetBits);
+	}
+	return retVal;
+}
+
+/**
+ * @brief Reads and clears the drive notifications of evtMsk_ of the calling task, whether they are
+ * pending or have been read already by a wait of the task for other notifications. The bits
+ * outside of DRV_NOTIFICATION_MSK, whose pending state the read has taken, are added to pOthVal_.
+ * @return notification values of evtMsk_, which were set
+ */
+static uint32_t DRV_Take_Notf(uint32_t evtMsk_, uint32_t *pOthVal_)
+{
+	uint32_t notfVal = 0u;
+
+	FRTOS1_taskENTER_CRITICAL();
+	if( pdPASS == FRTOS1_xTaskNotifyWait(0u, evtMsk_, &notfVal, 0u) )
+	{
+		*pOthVal_ |= notfVal & ~DRV_NOTIFICATION_MSK;
+	}
+	else
+	{
+		/* FreeRTOS clears on exit of a pending notification only, but on entry of a wait without */
+		(void)FRTOS1_xTaskNotifyWait(notfVal & evtMsk_, 0u, NULL, 0u);
+	}
+	FRTOS1_taskEXIT_CRITICAL();
+	return notfVal & evtMsk_;
+}
+
+/**
+ * @brief Starts the synchronization without error at the current positions of the wheels
+ */
+static void DRV_Init_Sync(void)
+{
+	(void)TACHO_Read_PosLe(&DRV_SyncPos[TACHO_ID_LEFT]);
+	(void)TACHO_Read_PosRi(&DRV_SyncPos[TACHO_ID_RIGHT]);
+	DRV_SyncErr  = 0;
+	DRV_SyncCorr = 0;
+	(void)PID_Reset(DRV_PID_SYNC);
+}
+
+/**
+ * @brief Hands the motors over to the controllers of the new mode, which continue from the last
+ * motor values. The speed ramp starts at the current speed. The motion profiles start at the
+ * current position and speed of the wheels, the position loops start from zero.
+ */
+static void DRV_Init_Bumpless(void)
+{
+	int32_t aPos[TACHO_ID_CNT] = {0};
+	int16_t i16ActVal = 0;
+	uint8_t i = 0u;
+
+	if ( (DRV_Status.mode==DRV_MODE_SPEED) || (DRV_Status.mode==DRV_MODE_STOP) || (DRV_Status.mode==DRV_MODE_POS) )
+	{
+		(void)TACHO_Read_SpdLe(&i16ActVal);
+		DRV_SpdSetVal[TACHO_ID_LEFT]  = (int32_t)i16ActVal;
+		(void)TACHO_Read_SpdRi(&i16ActVal);
+		DRV_SpdSetVal[TACHO_ID_RIGHT] = (int32_t)i16ActVal;
+		for(i = 0u; i < TACHO_ID_CNT; i++)
+		{
+			DRV_SpdTrgtVal[i] = DRV_SpdSetVal[i];
+			DRV_SpdAccVal[i]  = 0;
+			(void)PID_Set_Bumpless(DRV_PID_SPEED_LEFT + i, DRV_SpdSetVal[i], DRV_SpdSetVal[i],
+					DRV_Calc_FfVal(DRV_SpdSetVal[i], 0), DRV_CtrlVal[i]);
+		}
+	}
+	if (DRV_Status.mode==DRV_MODE_POS)
+	{
+		(void)TACHO_Read_PosLe(&aPos[TACHO_ID_LEFT]);
+		(void)TACHO_Read_PosRi(&aPos[TACHO_ID_RIGHT]);
+		for(i = 0u; i < TACHO_ID_CNT; i++)
+		{
+			DRV_Prof_Init(&DRV_Prof[i], Get_pDrvCfg(), aPos[i], DRV_SpdSetVal[i]);
+		}
+		(void)PID_Reset(DRV_PID_POS_LEFT);
+		(void)PID_Reset(DRV_PID_POS_RIGHT);
+		DRV_Status.posState = DRV_POS_STATE_MOVE;
+		DRV_SettleCntr = 0u;
+	}
+	DRV_Init_Sync();
+}
+
 /*============================= >> GLOBAL FUNCTION DEFINITIONS << ================================*/
 uint8_t DRV_SetMode(DRV_Mode_t mode) {
 	DRV_Command cmd;
-	uint8_t i = 0u;
 	if (mode==DRV_MODE_STOP) {
-		(void)DRV_SetPos(Q4CLeft_GetPos(), Q4CRight_GetPos()); /* set current position */
-		/* reset PID, especially integral counters */
-		PID_Reset(DRV_PID_SPEED_LEFT);
-		PID_Reset(DRV_PID_SPEED_RIGHT);
-		PID_Reset(DRV_PID_POS_LEFT);
-		PID_Reset(DRV_PID_POS_LEFT);
+		(void)DRV_SetPos(TACHO_Get_CntPosLe(), TACHO_Get_CntPosRi()); /* set current position */
+		/* PIDs are initialised by the drive task when it processes the mode change */
 		mode = DRV_MODE_POS;
 	}
 
 	cmd.cmd = DRV_SET_MODE;
 	cmd.mode = mode;
-	if (FRTOS1_xQueueSendToBack(DRV_Queue, &cmd, portMAX_DELAY)!=pdPASS) {
-		return ERR_FAILED;
-	}
-	FRTOS1_taskYIELD(); /* yield so drive task has a chance to read message */
+	DRV_Mbx_Write(&cmd);
 	return ERR_OK;
 }
 
@@ -218,10 +1064,7 @@ uint8_t DRV_SetSpeed(int32_t left, int32_t right) {
 	cmd.cmd = DRV_SET_SPEED;
 	cmd.speed.left = left;
 	cmd.speed.right = right;
-	if (FRTOS1_xQueueSendToBack(DRV_Queue, &cmd, portMAX_DELAY)!=pdPASS) {
-		return ERR_FAILED;
-	}
-	FRTOS1_taskYIELD(); /* yield so drive task has a chance to read message */
+	DRV_Mbx_Write(&cmd);
 	return ERR_OK;
 }
 
@@ -231,36 +1074,96 @@ uint8_t DRV_SetPos(int32_t left, int32_t right) {
 	cmd.cmd = DRV_SET_POS;
 	cmd.pos.left = left;
 	cmd.pos.right = right;
-	if (FRTOS1_xQueueSendToBack(DRV_Queue, &cmd, portMAX_DELAY)!=pdPASS) {
-		return ERR_FAILED;
-	}
-	FRTOS1_taskYIELD(); /* yield so drive task has a chance to read message */
+	DRV_Mbx_Write(&cmd);
 	return ERR_OK;
 }
 
+StdRtn_t DRV_SetVel(int32_t lin_, int32_t ang_)
+{
+	int32_t spdLe = 0, spdRi = 0;
+
+	(void)DRV_Kin_UniToWhl(lin_, ang_, Get_pDrvCfg()->kinSpdMax, &spdLe, &spdRi);
+	return DRV_SetSpeed(spdLe, spdRi);
+}
+
+StdRtn_t DRV_MoveRel(int32_t dist_, int32_t hdg_, TASK_Hdl_t notfTask_)
+{
+	StdRtn_t retVal = ERR_OK;
+	DRV_Seg_t aSeg[2u] = {{0}};
+	uint8_t numSeg = 0u;
+
+	/* turn on the spot first, then drive straight along the new heading */
+	if( 0 != hdg_ )
+	{
+		aSeg[numSeg].type  = DRV_SEG_TURN;
+		aSeg[numSeg].done  = DRV_SEG_DONE_PROF;
+		aSeg[numSeg].valLe = hdg_;
+		numSeg++;
+	}
+	if( 0 != dist_ )
+	{
+		aSeg[numSeg].type  = DRV_SEG_POS;
+		aSeg[numSeg].done  = DRV_SEG_DONE_PROF;
+		aSeg[numSeg].valLe = DRV_Kin_MmToSteps(dist_);
+		aSeg[numSeg].valRi = aSeg[numSeg].valLe;
+		numSeg++;
+	}
+	if( 0u < numSeg )
+	{
+		/* the move is done when the robot has settled at the end of the last segment */
+		aSeg[numSeg - 1u].done = DRV_SEG_DONE_SETTLED;
+		retVal = DRV_Start_Scr(aSeg, numSeg, notfTask_);
+	}
+	else if( NULL != notfTask_ )
+	{
+		/* nothing to move, the move is done right away */
+		(void)FRTOS1_xTaskNotify(notfTask_, DRV_SCR_DONE_NOTIFICATION_VALUE, eSetBits);
+	}
+	return retVal;
+}
+
+StdRtn_t DRV_Start_Scr(const DRV_Seg_t *aSeg_, uint8_t numSeg_, TASK_Hdl_t notfTask_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+	DRV_Command cmd = {0};
+	uint8_t i = 0u;
+	CS1_CriticalVariable();
+
+	if( NULL != aSeg_ )
+	{
+		retVal = ( ( 0u < numSeg_ ) && ( DRV_SCR_SEG_MAX >= numSeg_ ) ) ? ERR_OK : ERR_PARAM_VALUE;
+		for(i = 0u; ( ERR_OK == retVal ) && ( i < numSeg_ ); i++)
+		{
+			retVal = ( TRUE == DRV_Is_SegVld(&aSeg_[i]) ) ? ERR_OK : ERR_PARAM_VALUE;
+		}
+		if( ERR_OK == retVal )
+		{
+			cmd.cmd = DRV_SET_SCR;
+			CS1_EnterCritical();
+			for(i = 0u; i < numSeg_; i++)
+			{
+				DRV_ScrPend.aSeg[i] = aSeg_[i];
+			}
+			DRV_ScrPend.numSeg   = numSeg_;
+			DRV_ScrPend.notfTask = notfTask_;
+			DRV_Mbx_Write(&cmd);
+			CS1_ExitCritical();
+		}
+	}
+	return retVal;
+}
+
 
 DRV_Mode_t DRV_GetMode(void) {
 	return DRV_Status.mode;
 }
 
 bool DRV_IsStopped(void) {
-	Q4CLeft_QuadCntrType leftPos;
-	Q4CRight_QuadCntrType rightPos;
-
-	if (FRTOS1_uxQueueMessagesWaiting(DRV_Queue)>0) {
-		return FALSE; /* still messages in command queue, so there is something pending */
+	if (DRV_Mbx_IsPend() || (DRV_ScrSegIdx < DRV_Scr.numSeg)) {
+		return FALSE; /* command in the mailbox or running script, so there is something pending */
 	}
-	/* do *not* use/calculate speed: too slow! Use position encoder instead */
-	leftPos  = Q4CLeft_GetPos();
-	rightPos = Q4CRight_GetPos();
 	if (DRV_Status.mode==DRV_MODE_POS) {
-		if (DRV_Status.pos.left!=(int32_t)leftPos) {
-			return FALSE;
-		}
-		if (DRV_Status.pos.right!=(int32_t)rightPos) {
-			return FALSE;
-		}
-		return TRUE;
+		return (DRV_Status.posState==DRV_POS_STATE_SETTLED);
 	} if (DRV_Status.mode==DRV_MODE_STOP) {
 		return TRUE;
 	} else {
@@ -270,18 +1173,112 @@ bool DRV_IsStopped(void) {
 }
 
 uint8_t DRV_Stop(int32_t timeoutMs) {
+	StdRtn_t retVal = DRV_Stop_Async(timeoutMs, FRTOS1_xTaskGetCurrentTaskHandle());
+
+	if (ERR_OK == retVal) {
+		retVal = DRV_Wait_Stpd(timeoutMs);
+	}
+	return retVal;
+}
+
+StdRtn_t DRV_Stop_Async(int32_t timeoutMs_, TASK_Hdl_t notfTask_)
+{
 	(void)DRV_SetMode(DRV_MODE_STOP); /* stop it */
-	do {
-		if (DRV_IsStopped()) {
-			break;
+	return ( NULL != notfTask_ ) ? DRV_Notf_Stpd(notfTask_, timeoutMs_) : ERR_OK;
+}
+
+StdRtn_t DRV_Wait_Stopped(int32_t timeoutMs_)
+{
+	StdRtn_t retVal = DRV_Notf_Stpd(FRTOS1_xTaskGetCurrentTaskHandle(), timeoutMs_);
+
+	if( ERR_OK == retVal )
+	{
+		retVal = DRV_Wait_Stpd(timeoutMs_);
+	}
+	return retVal;
+}
+
+StdRtn_t DRV_Notf_Stpd(TASK_Hdl_t notfTask_, int32_t timeoutMs_)
+{
+	StdRtn_t retVal = ERR_OVERFLOW;
+	TASK_Hdl_t task = ( NULL != notfTask_ ) ? notfTask_ : FRTOS1_xTaskGetCurrentTaskHandle();
+	DRV_Notf_t *pNotf = NULL;
+	CS1_CriticalVariable();
+
+	CS1_EnterCritical();
+	pNotf = DRV_Get_Notf(task);
+	if( NULL != pNotf )
+	{
+		pNotf->task = task;
+		if( NULL != notfTask_ )
+		{
+			pNotf->isStpPend = TRUE;
+			pNotf->stpTick   = FRTOS1_xTaskGetTickCount();
+			pNotf->stpTicks  = pdMS_TO_TICKS( ( timeoutMs_ > 0 ) ? (uint32_t)timeoutMs_ : 0u );
+		}
+		else
+		{
+			/* cancel the wait of the calling task, the entry is released by the drive task */
+			pNotf->isStpPend = FALSE;
 		}
-		WAIT1_WaitOSms(5);
-		timeoutMs -= 5;
-	} while (timeoutMs>0);
-	if (timeoutMs<0) {
-		return ERR_BUSY; /* timeout */
+		retVal = ERR_OK;
 	}
-	return ERR_OK;
+	CS1_ExitCritical();
+	return retVal;
+}
+
+StdRtn_t DRV_Reg_EvtNotf(TASK_Hdl_t notfTask_, uint32_t evtMsk_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+	DRV_Notf_t *pNotf = NULL;
+	CS1_CriticalVariable();
+
+	if( NULL != notfTask_ )
+	{
+		retVal = ERR_OVERFLOW;
+		CS1_EnterCritical();
+		pNotf = DRV_Get_Notf(notfTask_);
+		if( NULL != pNotf )
+		{
+			pNotf->task   = notfTask_;
+			pNotf->evtMsk = evtMsk_ & ( DRV_MOVE_DONE_NOTIFICATION_VALUE | DRV_TURNED_NOTIFICATION_VALUE );
+			retVal = ERR_OK;
+		}
+		CS1_ExitCritical();
+	}
+	return retVal;
+}
+
+StdRtn_t DRV_Wait_Notf(uint32_t evtMsk_, uint32_t *pEvt_, int32_t timeoutMs_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+	uint32_t notfVal = 0u, othVal = 0u;
+	TickType_t strtTick = FRTOS1_xTaskGetTickCount();
+	TickType_t maxTicks = pdMS_TO_TICKS( ( timeoutMs_ > 0 ) ? (uint32_t)timeoutMs_ : 0u );
+	TickType_t elpsTicks = 0u;
+
+	if( NULL != pEvt_ )
+	{
+		evtMsk_ &= DRV_NOTIFICATION_MSK;
+		*pEvt_ = DRV_Take_Notf(evtMsk_, &othVal);
+		while( ( 0u == *pEvt_ ) && ( elpsTicks < maxTicks ) )
+		{
+			notfVal = 0u;
+			if( pdPASS == FRTOS1_xTaskNotifyWait(0u, 0u, &notfVal, maxTicks - elpsTicks) )
+			{
+				othVal |= notfVal & ~DRV_NOTIFICATION_MSK;
+			}
+			*pEvt_ = DRV_Take_Notf(evtMsk_, &othVal);
+			elpsTicks = (TickType_t)( FRTOS1_xTaskGetTickCount() - strtTick );
+		}
+		if( 0u != othVal )
+		{
+			/* the wait has taken the pending state of these notifications */
+			(void)FRTOS1_xTaskNotify(FRTOS1_xTaskGetCurrentTaskHandle(), othVal, eSetBits);
+		}
+		retVal = ( 0u != *pEvt_ ) ? ERR_OK : ERR_BUSY;
+	}
+	return retVal;
 }
 
 bool DRV_IsDrivingBackward(void) {
@@ -293,8 +1290,8 @@ bool DRV_IsDrivingBackward(void) {
 bool DRV_HasTurned(void) {
 	int16_t pos;
 
-	if (FRTOS1_uxQueueMessagesWaiting(DRV_Queue)>0) {
-		return FALSE; /* still messages in command queue, so there is something pending */
+	if (DRV_Mbx_IsPend()) {
+		return FALSE; /* command in the mailbox, so there is something pending */
 	}
 	if (DRV_Status.mode==DRV_MODE_POS) {
 		int16_t speedL, speedR;
@@ -302,9 +1299,9 @@ bool DRV_HasTurned(void) {
 		TACHO_Read_SpdLe(&speedL);
 		TACHO_Read_SpdRi(&speedR);
 		if (speedL>-DRV_TURN_SPEED_LOW && speedL<DRV_TURN_SPEED_LOW && speedR>-DRV_TURN_SPEED_LOW && speedR<DRV_TURN_SPEED_LOW) { /* speed close to zero */
-			pos = Q4CLeft_GetPos();
+			pos = TACHO_Get_CntPosLe();
 			if (match(pos, DRV_Status.pos.left)) {
-				pos = Q4CRight_GetPos();
+				pos = TACHO_Get_CntPosRi();
 				if (match(pos, DRV_Status.pos.right)) {
 					return TRUE;
 				}
@@ -317,11 +1314,12 @@ bool DRV_HasTurned(void) {
 
 
 void DRV_DeInit(void) {
-	FRTOS1_vQueueDelete(DRV_Queue);
 	return;
 }
 
 void DRV_Init(const void *pvPar_) {
+	uint8_t i = 0u;
+
 	MOT_Init();
 
 	DRV_Status.mode = DRV_MODE_NONE;
@@ -329,67 +1327,105 @@ void DRV_Init(const void *pvPar_) {
 	DRV_Status.speed.right = 0;
 	DRV_Status.pos.left = 0;
 	DRV_Status.pos.right = 0;
-	DRV_Queue = FRTOS1_xQueueCreate(QUEUE_LENGTH, QUEUE_ITEM_SIZE);
-	if (DRV_Queue==NULL)
+	DRV_Status.posState = DRV_POS_STATE_MOVE;
+	DRV_SpdTrgtVal[TACHO_ID_LEFT] = 0;
+	DRV_SpdTrgtVal[TACHO_ID_RIGHT] = 0;
+	DRV_SpdSetVal[TACHO_ID_LEFT]  = 0;
+	DRV_SpdSetVal[TACHO_ID_RIGHT] = 0;
+	DRV_SpdAccVal[TACHO_ID_LEFT]  = 0;
+	DRV_SpdAccVal[TACHO_ID_RIGHT] = 0;
+	DRV_Prof_Init(&DRV_Prof[TACHO_ID_LEFT], Get_pDrvCfg(), 0, 0);
+	DRV_Prof_Init(&DRV_Prof[TACHO_ID_RIGHT], Get_pDrvCfg(), 0, 0);
+	DRV_SettleCntr = 0u;
+	DRV_CtrlVal[TACHO_ID_LEFT]    = 0;
+	DRV_CtrlVal[TACHO_ID_RIGHT]   = 0;
+	DRV_SyncModeMsk = Get_pDrvCfg()->syncModeMsk;
+	DRV_SyncErr  = 0;
+	DRV_SyncCorr = 0;
+	DRV_ModeChgd = FALSE;
+	for(i = 0u; i < DRV_CMD_CNT; i++)
 	{
-		for(;;){} /* out of memory? */
+		DRV_Mbx[i].seq   = 0u;
+		DRV_Mbx[i].rdSeq = 0u;
 	}
-	FRTOS1_vQueueAddToRegistry(DRV_Queue, "Drive");
+	DRV_MbxOrdNo = 0u;
+	DRV_Scr.numSeg     = 0u;
+	DRV_ScrPend.numSeg = 0u;
+	DRV_ScrSegIdx   = 0u;
+	DRV_ScrSegStrtd = FALSE;
+	DRV_LatPend  = FALSE;
+	DRV_LatMs    = 0u;
+	DRV_LatMaxMs = 0u;
+	for(i = 0u; i < DRV_NOTF_TASK_MAX; i++)
+	{
+		DRV_Notf[i].task      = NULL;
+		DRV_Notf[i].evtMsk    = 0u;
+		DRV_Notf[i].isStpPend = FALSE;
+	}
+	DRV_WasStpd   = FALSE;
+	DRV_HadTurned = FALSE;
+	DRV_Trac_Init();
+#if DRV_USES_ISR_LOOP
+	DRV_Isr_Init();
+#endif
 	return;
 }
 
 void DRV_MainFct(void)
 {
 	StdRtn_t retVal = ERR_OK;
-	int32_t PIDVal = 0;
-	int32_t i32ActVal = 0;
-	int16_t i16ActVal = 0;
+	uint32_t latMs = 0u;
 
-	while (GetCmd()==ERR_OK)  /* returns ERR_RXEMPTY if queue is empty */
-	{
-		/* process incoming commands */
-	}
+	DRV_Proc_Mbx();
+	DRV_Run_Scr();
 
-	if (DRV_Status.mode==DRV_MODE_SPEED)
+	if (TRUE == DRV_ModeChgd)
 	{
-		retVal |= TACHO_Read_SpdLe(&i16ActVal);
-		retVal |= PID(DRV_Status.speed.left, (int32_t)i16ActVal ,DRV_PID_SPEED_LEFT, &PIDVal);
-		Parse_CtrlValToMotor(PIDVal, TRUE);
-
-		retVal |= TACHO_Read_SpdRi(&i16ActVal);
-		retVal |= PID(DRV_Status.speed.right, (int32_t)i16ActVal ,DRV_PID_SPEED_RIGHT, &PIDVal);
-		Parse_CtrlValToMotor(PIDVal, FALSE);
+		DRV_ModeChgd = FALSE;
+		DRV_Init_Bumpless();
 	}
-	else if (DRV_Status.mode==DRV_MODE_STOP)
-	{
-		DRV_SetSpeed(0, 0);
-
-		retVal |= TACHO_Read_SpdLe(&i16ActVal);
-		retVal |= PID(DRV_Status.speed.left, (int32_t)i16ActVal ,DRV_PID_SPEED_LEFT, &PIDVal);
-		Parse_CtrlValToMotor(PIDVal, TRUE);
 
-		retVal |= TACHO_Read_SpdRi(&i16ActVal);
-		retVal |= PID(DRV_Status.speed.right, (int32_t)i16ActVal ,DRV_PID_SPEED_RIGHT, &PIDVal);
-		Parse_CtrlValToMotor(PIDVal, FALSE);
+	if ( (DRV_Status.mode==DRV_MODE_SPEED) || (DRV_Status.mode==DRV_MODE_STOP) )
+	{
+		if (DRV_Status.mode==DRV_MODE_STOP)
+		{
+			DRV_Status.speed.left = 0;
+			DRV_Status.speed.right = 0;
+		}
+		DRV_SpdTrgtVal[TACHO_ID_LEFT]  = DRV_Status.speed.left;
+		DRV_SpdTrgtVal[TACHO_ID_RIGHT] = DRV_Status.speed.right;
+		DRV_Ramp_SpdSetVal(Get_pDrvCfg()->spdRampRate);
+		retVal |= DRV_Ctrl_Sync();
+		retVal |= DRV_Ctrl_Spd();
 	}
 	else if (DRV_Status.mode==DRV_MODE_POS)
 	{
-		retVal |= TACHO_Read_PosLe(&i32ActVal);
-		retVal |= PID(DRV_Status.pos.left, i32ActVal ,DRV_PID_POS_LEFT, &PIDVal);
-		//TODO
-		PIDVal = PIDVal*50;
-		Parse_CtrlValToMotor(PIDVal, TRUE);
-
-		retVal |= TACHO_Read_PosRi(&i32ActVal);
-		retVal |= PID(DRV_Status.pos.right, i32ActVal ,DRV_PID_POS_RIGHT, &PIDVal);
-		//TODO
-		PIDVal = PIDVal*50;
-		Parse_CtrlValToMotor(PIDVal, FALSE);
+		retVal |= DRV_Ctrl_Pos();
+		retVal |= DRV_Ctrl_Sync();
+		retVal |= DRV_Ctrl_Spd();
 	}
 	else
 	{
-		/* do nothing */
+		/* without the loops there is no reaction to slip or stall */
+		DRV_Trac_Init();
+#if DRV_USES_ISR_LOOP
+		/* the motors keep their last values as without the speed loops in the interrupt */
+		DRV_Isr_Stop();
+#endif
+	}
+
+	/* latency of the set call, whose command has just reached the motors */
+	if (TRUE == DRV_LatPend)
+	{
+		DRV_LatPend = FALSE;
+		latMs = (uint32_t)(FRTOS1_xTaskGetTickCount() - DRV_LatTick) * portTICK_PERIOD_MS;
+		DRV_LatMs = (latMs < 0xFFFFu) ? (uint16_t)latMs : 0xFFFFu;
+		if (DRV_LatMs > DRV_LatMaxMs)
+		{
+			DRV_LatMaxMs = DRV_LatMs;
+		}
 	}
+	DRV_Upd_Notf();
 	return;
 }
 
@@ -442,5 +1478,107 @@ StdRtn_t DRV_Read_RghtPosTrgtVal(int32_t* pos_)
 	return retVal;
 }
 
+StdRtn_t DRV_Read_LftPosRefVal(int32_t* pos_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+	if(NULL != pos_)
+	{
+		*pos_ 	= DRV_Prof_Get_Pos(&DRV_Prof[TACHO_ID_LEFT]);
+		retVal 	= ERR_OK;
+	}
+	return retVal;
+}
+
+StdRtn_t DRV_Read_RghtPosRefVal(int32_t* pos_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+	if(NULL != pos_)
+	{
+		*pos_ 	= DRV_Prof_Get_Pos(&DRV_Prof[TACHO_ID_RIGHT]);
+		retVal 	= ERR_OK;
+	}
+	return retVal;
+}
+
+StdRtn_t DRV_Read_ScrSegIdx(uint8_t *pIdx_, uint8_t *pNum_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+	if( (NULL != pIdx_) && (NULL != pNum_) )
+	{
+		*pIdx_ 	= DRV_ScrSegIdx;
+		*pNum_ 	= DRV_Scr.numSeg;
+		retVal 	= ERR_OK;
+	}
+	return retVal;
+}
+
+StdRtn_t DRV_Read_CmdLatency(uint16_t *pLatMs_, uint16_t *pMaxMs_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+	if( (NULL != pLatMs_) && (NULL != pMaxMs_) )
+	{
+		*pLatMs_ = DRV_LatMs;
+		*pMaxMs_ = DRV_LatMaxMs;
+		retVal 	 = ERR_OK;
+	}
+	return retVal;
+}
+
+StdRtn_t DRV_Set_SyncEna(DRV_Mode_t mode_, bool isEna_)
+{
+	StdRtn_t retVal = ERR_PARAM_VALUE;
+	CS1_CriticalVariable();
+
+	if( ( DRV_MODE_STOP == mode_ ) || ( DRV_MODE_SPEED == mode_ ) || ( DRV_MODE_POS == mode_ ) )
+	{
+		CS1_EnterCritical();
+		if( TRUE == isEna_ )
+		{
+			DRV_SyncModeMsk |= (uint8_t)( 1u << mode_ );
+		}
+		else
+		{
+			DRV_SyncModeMsk &= (uint8_t)~( 1u << mode_ );
+		}
+		CS1_ExitCritical();
+		retVal = ERR_OK;
+	}
+	return retVal;
+}
+
+StdRtn_t DRV_Read_SyncEna(DRV_Mode_t mode_, bool *pIsEna_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+	if( NULL != pIsEna_ )
+	{
+		*pIsEna_ = ( 0u != ( DRV_SyncModeMsk & ( 1u << mode_ ) ) ) ? TRUE : FALSE;
+		retVal   = ERR_OK;
+	}
+	return retVal;
+}
+
+StdRtn_t DRV_Read_SyncErr(int32_t *pErr_, int32_t *pCorr_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+	if( (NULL != pErr_) && (NULL != pCorr_) )
+	{
+		*pErr_  = ( DRV_SyncErr + ( 1 << 15 ) ) >> 16;
+		*pCorr_ = DRV_SyncCorr;
+		retVal  = ERR_OK;
+	}
+	return retVal;
+}
+
+StdRtn_t DRV_Read_PosState(DRV_PosState_t *pState_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+	if(NULL != pState_)
+	{
+		*pState_ = DRV_Status.posState;
+		retVal 	 = ERR_OK;
+	}
+	return retVal;
+}
+
 
 
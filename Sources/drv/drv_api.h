@@ -22,6 +22,7 @@
 /*======================================= >> #INCLUDES << ========================================*/
 #include "rte_Types.h"
 #include "Platform.h"
+#include "task_api.h"
 
 
 #ifdef MASTER_drv_C_
@@ -35,6 +36,15 @@
  * @{
  */
 /*======================================= >> #DEFINES << =========================================*/
+/**
+ * @brief Maximum number of segments of a motion script
+ */
+#define DRV_SCR_SEG_MAX		(8u)
+
+/**
+ * @brief Maximum number of tasks which are notified of drive events at the same time
+ */
+#define DRV_NOTF_TASK_MAX	(4u)
 
 
 
@@ -62,6 +72,86 @@ typedef enum DRV_Mode_e {
 } DRV_Mode_t;
 #endif
 
+/**
+ * @typedef DRV_Seg_t
+ * @brief DRV_Seg_t is either inherited from DrvSeg_t or defined as the struct @ref DRV_Seg_s
+ *
+ * For inheritance DRV_Seg_t must be defined within the Real-time environment (@ref rte) in
+ * rte_Types.h together with the kinds of segments and their completion conditions.
+ */
+#ifdef DRV_SEG_T
+typedef DrvSegType_t DRV_SegType_t;
+typedef DrvSegDone_t DRV_SegDone_t;
+typedef DrvSeg_t DRV_Seg_t;
+#else
+/**
+ * @enum DRV_SegType_e
+ * @brief Kinds of segments of a motion script
+ */
+typedef enum DRV_SegType_e {
+  DRV_SEG_POS = 0,		/**< moves the wheels by the given steps in position mode */
+  DRV_SEG_TURN,			/**< turns on the spot by the given angle in 0.1 degrees, counter-clockwise if positive */
+  DRV_SEG_SPEED,		/**< drives with the given speeds in steps/sec in speed mode */
+  DRV_SEG_WAIT,			/**< stands still in position mode */
+  DRV_SEG_TYPE_INVALID,
+} DRV_SegType_t;
+
+/**
+ * @enum DRV_SegDone_e
+ * @brief Completion conditions of the segments of a motion script
+ */
+typedef enum DRV_SegDone_e {
+  DRV_SEG_DONE_TIME = 0,	/**< the duration has elapsed */
+  DRV_SEG_DONE_PROF,		/**< the motion profiles have reached the target, the loops settle during the next segment */
+  DRV_SEG_DONE_SETTLED,		/**< the position loops have settled */
+  DRV_SEG_DONE_INVALID,
+} DRV_SegDone_t;
+
+/**
+ * @struct DRV_Seg_s
+ * @brief Segment of a motion script
+ */
+typedef struct DRV_Seg_s {
+  DRV_SegType_t type;		/**< kind of the segment */
+  DRV_SegDone_t done;		/**< completion condition, speed and wait segments complete after their duration */
+  int32_t valLe;			/**< steps or steps/sec of the left wheel, angle in 0.1 degrees of a turn */
+  int32_t valRi;			/**< steps or steps/sec of the right wheel, unused by a turn */
+  uint16_t timeMs;			/**< duration, a position or turn segment aborts the script after it unless 0 */
+} DRV_Seg_t;
+#endif
+
+/**
+ * @typedef DRV_Trac_t
+ * @brief DRV_Trac_t is either inherited from DrvTrac_t or defined as the enumeration
+ * @ref DRV_Trac_e
+ *
+ * For inheritance DRV_Trac_t must be defined within the Real-time environment (@ref rte) in
+ * rte_Types.h.
+ */
+#ifdef DRV_TRAC_T
+typedef DrvTrac_t DRV_Trac_t;
+#else
+/**
+ * @enum DRV_Trac_e
+ * @brief Traction state of a wheel
+ */
+typedef enum DRV_Trac_e {
+  DRV_TRAC_OK = 0,		/**< the wheel follows the motor model */
+  DRV_TRAC_SLIP,		/**< the wheel spins, it accelerates faster than the motor value explains */
+  DRV_TRAC_STALL,		/**< the wheel is blocked despite a high motor value */
+} DRV_Trac_t;
+#endif
+
+/**
+ * @enum DRV_PosState_e
+ * @brief State of the settle detection in [DRV_MODE_POS](@ref DRV_Mode_t)
+ */
+typedef enum DRV_PosState_e {
+	DRV_POS_STATE_MOVE = 0,	/**< at least one side is outside the settle margins */
+	DRV_POS_STATE_SETTLING,	/**< both sides are within the settle margins */
+	DRV_POS_STATE_SETTLED,	/**< both sides have been within the settle margins for the configured time */
+} DRV_PosState_t;
+
 /**
  * @typedef DRV_Status_t
  * @brief The driving status information is hold in the struct @ref DRV_Status_s.
@@ -79,16 +169,16 @@ typedef struct DRV_Status_s {
 		int32_t left;
 		int32_t right;
 	} pos;					/**< current controller target values in case of [DRV_MODE_POS](@ref DRV_Mode_t) implemented as anonymous struct */
+	DRV_PosState_t posState;	/**< [settle state](@ref DRV_PosState_t) of the position loops */
 } DRV_Status_t;
 
 
 
 /*============================ >> GLOBAL FUNCTION DECLARATIONS << ================================*/
 /**
- * @brief Sends a command to the queue to set a target [drive mode](@ref DRV_Mode_t)
+ * @brief Overwrites the command in the mailbox with a target [drive mode](@ref DRV_Mode_t)
  * @param mode target mode
- * @return Error code, ERR_OK if everything was fine\n
- * ERR_FAILED if sending to queues fails.
+ * @return Error code, ERR_OK, the call doesn't wait for the drive task
  */
 EXTERNAL_ uint8_t DRV_SetMode(DRV_Mode_t mode);
 
@@ -99,23 +189,43 @@ EXTERNAL_ uint8_t DRV_SetMode(DRV_Mode_t mode);
 EXTERNAL_ DRV_Mode_t DRV_GetMode(void);
 
 /**
- * @brief Sends a command to the queue to set target speed values
+ * @brief Overwrites the command in the mailbox with target speed values
  * @param left target speed value for the left-hand side in steps/sec
  * @param right target speed value for the right-hand side in steps/sec
- * @return Error code, ERR_OK if everything was fine\n
- * ERR_FAILED if sending to queues fails.
+ * @return Error code, ERR_OK, the call doesn't wait for the drive task
  */
 EXTERNAL_ uint8_t DRV_SetSpeed(int32_t left, int32_t right);
 
 /**
- * @brief Sends a command to the queue to set target position values
+ * @brief Overwrites the command in the mailbox with target position values
  * @param left target position value for the left-hand side in steps
  * @param right target position value for the right-hand side in steps
- * @return Error code, ERR_OK if everything was fine\n
- * ERR_FAILED if sending to queues fails.
+ * @return Error code, ERR_OK, the call doesn't wait for the drive task
  */
 EXTERNAL_ uint8_t DRV_SetPos(int32_t left, int32_t right);
 
+/**
+ * @brief Overwrites the command in the mailbox with the target speed values of both wheels which
+ * result from the linear and angular velocity of the robot. If a wheel exceeds the configured speed
+ * limit, both wheels are slowed down by the same factor, so the curvature of the path is kept.
+ * @param lin_ linear velocity in [mm/sec]
+ * @param ang_ angular velocity in 0.1 degrees/sec, counter-clockwise if positive
+ * @return Error code, ERR_OK, the call doesn't wait for the drive task
+ */
+EXTERNAL_ StdRtn_t DRV_SetVel(int32_t lin_, int32_t ang_);
+
+/**
+ * @brief Moves the robot relative to its current pose by a [motion script](@ref DRV_Start_Scr),
+ * which turns on the spot first and then drives straight along the new heading
+ * @param dist_     distance in [mm], backwards if negative
+ * @param hdg_      change of heading in 0.1 degrees, counter-clockwise if positive
+ * @param notfTask_ task which is notified by DRV_SCR_DONE_NOTIFICATION_VALUE when the robot has
+ * settled at the end of the move and by DRV_SCR_ABORT_NOTIFICATION_VALUE when it has been aborted,
+ * NULL for none. The task receives them by @ref DRV_Wait_Notf.
+ * @return Error code, ERR_OK if everything was fine
+ */
+EXTERNAL_ StdRtn_t DRV_MoveRel(int32_t dist_, int32_t hdg_, TASK_Hdl_t notfTask_);
+
 /**
  * @brief Returns TRUE if the robot is driving backwards.
  * @return TRUE/FALSE
@@ -124,6 +234,9 @@ EXTERNAL_ bool DRV_IsDrivingBackward(void);
 
 /**
  * @brief Returns TRUE if the robot is at standstill
+ *
+ * In [position mode](@ref DRV_Mode_t) the robot is at standstill as soon as the position loops
+ * have [settled](@ref DRV_POS_STATE_SETTLED).
  * @return TRUE/FALSE
  */
 EXTERNAL_ bool DRV_IsStopped(void);
@@ -136,12 +249,73 @@ EXTERNAL_ bool DRV_IsStopped(void);
 EXTERNAL_ bool DRV_HasTurned(void);
 
 /**
- * @brief Stops the engines
+ * @brief Stops the engines and blocks the calling task until the robot is at standstill. The task
+ * waits for a notification of the drive task and doesn't consume CPU time meanwhile.
  * @param timeoutMs timout in milliseconds for operation
- * @return ERR_OK if stopped, ERR_BUSY for timeout condition.
+ * @return ERR_OK if stopped, ERR_BUSY for timeout condition,
+ * ERR_OVERFLOW if too many tasks are registered for notifications.
  */
 EXTERNAL_ uint8_t DRV_Stop(int32_t timeoutMs);
 
+/**
+ * @brief Stops the engines without waiting. The drive task notifies the task by
+ * DRV_STOP_DONE_NOTIFICATION_VALUE as soon as the robot is at standstill or by
+ * DRV_STOP_TIMEOUT_NOTIFICATION_VALUE after the timeout, which it receives by @ref DRV_Wait_Notf.
+ * @param timeoutMs_ timout in milliseconds
+ * @param notfTask_  task which is notified, NULL for none
+ * @return Error code, ERR_OK if everything was fine,\n
+ * ERR_OVERFLOW if too many tasks are registered for notifications
+ */
+EXTERNAL_ StdRtn_t DRV_Stop_Async(int32_t timeoutMs_, TASK_Hdl_t notfTask_);
+
+/**
+ * @brief Blocks the calling task until the robot is at standstill, e.g. at the end of a position
+ * move, without changing the drive commands
+ * @param timeoutMs_ timout in milliseconds
+ * @return Error code, ERR_OK if stopped, ERR_BUSY for timeout condition,\n
+ * ERR_OVERFLOW if too many tasks are registered for notifications
+ */
+EXTERNAL_ StdRtn_t DRV_Wait_Stopped(int32_t timeoutMs_);
+
+/**
+ * @brief Requests a single notification when the robot is at standstill without waiting, e.g. at
+ * the end of a position move. The drive task notifies the task by DRV_STOP_DONE_NOTIFICATION_VALUE
+ * as soon as @ref DRV_IsStopped holds or by DRV_STOP_TIMEOUT_NOTIFICATION_VALUE after the timeout,
+ * which it receives by @ref DRV_Wait_Notf. A request of the same task replaces the previous one.
+ * @param notfTask_  task which is notified, NULL cancels the request of the calling task
+ * @param timeoutMs_ timout in milliseconds
+ * @return Error code, ERR_OK if everything was fine,\n
+ * ERR_OVERFLOW if too many tasks are registered for notifications
+ */
+EXTERNAL_ StdRtn_t DRV_Notf_Stpd(TASK_Hdl_t notfTask_, int32_t timeoutMs_);
+
+/**
+ * @brief Registers a task for notifications of drive events on every occurrence, which replaces
+ * polling @ref DRV_IsStopped and @ref DRV_HasTurned. The drive task notifies the task by
+ * DRV_MOVE_DONE_NOTIFICATION_VALUE when DRV_IsStopped() becomes TRUE and by
+ * DRV_TURNED_NOTIFICATION_VALUE when DRV_HasTurned() becomes TRUE in position mode. The task
+ * receives them by @ref DRV_Wait_Notf.
+ * @param notfTask_ task which is notified
+ * @param evtMsk_   mask of the notification values of the events, 0 unregisters the task
+ * @return Error code, ERR_OK if everything was fine,\n
+ * ERR_PARAM_ADDRESS if the task is invalid,\n
+ * ERR_OVERFLOW if too many tasks are registered for notifications
+ */
+EXTERNAL_ StdRtn_t DRV_Reg_EvtNotf(TASK_Hdl_t notfTask_, uint32_t evtMsk_);
+
+/**
+ * @brief Reads and clears the drive notifications of the calling task, which shares its task
+ * notification with other senders, e.g. the application task with the keys. Other notifications
+ * stay pending for the task.
+ * @param evtMsk_    mask of the notification values, bits outside of DRV_NOTIFICATION_MSK are ignored
+ * @param pEvt_      notification values of evtMsk_, which were set
+ * @param timeoutMs_ time in milliseconds to wait for one of them, 0 returns at once
+ * @return Error code, ERR_OK if a notification was set,\n
+ * ERR_BUSY if none was set within the timeout,\n
+ * ERR_PARAM_ADDRESS if pEvt_ is invalid
+ */
+EXTERNAL_ StdRtn_t DRV_Wait_Notf(uint32_t evtMsk_, uint32_t *pEvt_, int32_t timeoutMs_);
+
 /**
  * @brief Returns the reference to the current [status information](@ref DRV_Status_t).
  * @return pointer to the status information
@@ -154,6 +328,115 @@ EXTERNAL_ StdRtn_t DRV_Read_LftPosTrgtVal(int32_t* pos_);
 
 EXTERNAL_ StdRtn_t DRV_Read_RghtPosTrgtVal(int32_t* pos_);
 
+/**
+ * @brief Reads the position reference of the motion profile of the left position loop
+ * @param pos_ pointer to the position reference in steps
+ * @return Error code, ERR_OK if everything was fine,\n
+ * ERR_PARAM_ADDRESS if the address is invalid
+ */
+EXTERNAL_ StdRtn_t DRV_Read_LftPosRefVal(int32_t* pos_);
+
+/**
+ * @brief Reads the position reference of the motion profile of the right position loop
+ * @param pos_ pointer to the position reference in steps
+ * @return Error code, ERR_OK if everything was fine,\n
+ * ERR_PARAM_ADDRESS if the address is invalid
+ */
+EXTERNAL_ StdRtn_t DRV_Read_RghtPosRefVal(int32_t* pos_);
+
+/**
+ * @brief Hands a motion script over to the drive task, which executes its segments back-to-back.
+ * A running script is aborted. A position or turn segment moves relative to the target of the
+ * previous segment or to the current position. A later mode, speed or position command aborts
+ * the script as well.
+ * @param aSeg_     array of the segments, it is copied
+ * @param numSeg_   number of segments, at most DRV_SCR_SEG_MAX
+ * @param notfTask_ task which is notified by DRV_SCR_DONE_NOTIFICATION_VALUE when the script has
+ * completed and by DRV_SCR_ABORT_NOTIFICATION_VALUE when it has been aborted, NULL for none
+ * @return Error code, ERR_OK if everything was fine,\n
+ * ERR_PARAM_ADDRESS if the address is invalid,\n
+ * ERR_PARAM_VALUE if the number of segments or a segment is invalid
+ */
+EXTERNAL_ StdRtn_t DRV_Start_Scr(const DRV_Seg_t *aSeg_, uint8_t numSeg_, TASK_Hdl_t notfTask_);
+
+/**
+ * @brief Reads the index of the running segment of the motion script
+ * @param pIdx_ pointer to the index, the number of segments if no script is running
+ * @param pNum_ pointer to the number of segments of the last script
+ * @return Error code, ERR_OK if everything was fine,\n
+ * ERR_PARAM_ADDRESS if an address is invalid
+ */
+EXTERNAL_ StdRtn_t DRV_Read_ScrSegIdx(uint8_t *pIdx_, uint8_t *pNum_);
+
+/**
+ * @brief Reads the latency from a set call to the motor output in [ms], i.e. from the oldest set
+ * call of the commands taken over together. The resolution is a tick of the RTOS.
+ * @param pLatMs_ pointer to the latency of the last command
+ * @param pMaxMs_ pointer to the maximum latency since the initialisation
+ * @return Error code, ERR_OK if everything was fine,\n
+ * ERR_PARAM_ADDRESS if an address is invalid
+ */
+EXTERNAL_ StdRtn_t DRV_Read_CmdLatency(uint16_t *pLatMs_, uint16_t *pMaxMs_);
+
+/**
+ * @brief Enables or disables the cross-coupled synchronization of the wheels in a drive mode. It
+ * feeds the difference of the tracking errors of both wheels back to both speed loops, so the
+ * robot keeps its curvature despite different motors.
+ * @param mode_  drive mode, DRV_MODE_STOP, DRV_MODE_SPEED or DRV_MODE_POS
+ * @param isEna_ TRUE to enable the synchronization
+ * @return Error code, ERR_OK if everything was fine,\n
+ * ERR_PARAM_VALUE if the mode is invalid
+ */
+EXTERNAL_ StdRtn_t DRV_Set_SyncEna(DRV_Mode_t mode_, bool isEna_);
+
+/**
+ * @brief Reads whether the synchronization of the wheels is enabled in a drive mode
+ * @param mode_   drive mode
+ * @param pIsEna_ pointer to TRUE if the synchronization is enabled
+ * @return Error code, ERR_OK if everything was fine,\n
+ * ERR_PARAM_ADDRESS if the address is invalid
+ */
+EXTERNAL_ StdRtn_t DRV_Read_SyncEna(DRV_Mode_t mode_, bool *pIsEna_);
+
+/**
+ * @brief Reads the state of the synchronization of the wheels
+ * @param pErr_  pointer to the synchronization error in steps, positive if the left wheel lags
+ * @param pCorr_ pointer to the speed correction in steps/sec, which is added to the left wheel
+ * and subtracted from the right wheel
+ * @return Error code, ERR_OK if everything was fine,\n
+ * ERR_PARAM_ADDRESS if an address is invalid
+ */
+EXTERNAL_ StdRtn_t DRV_Read_SyncErr(int32_t *pErr_, int32_t *pCorr_);
+
+/**
+ * @brief Reads the load of the speed loops in the timer interrupt, which is averaged over about one
+ * second. Both values are zero unless @ref DRV_USES_ISR_LOOP is set.
+ * @param pLoad_   pointer to the interrupt load in 0.01 percent of the core
+ * @param pCycMax_ pointer to the maximum core cycles of a call since the initialisation
+ * @return Error code, ERR_OK if everything was fine,\n
+ * ERR_PARAM_ADDRESS if an address is invalid
+ */
+EXTERNAL_ StdRtn_t DRV_Read_IsrLoad(uint16_t *pLoad_, uint32_t *pCycMax_);
+
+/**
+ * @brief Reads the [traction state](@ref DRV_Trac_t) of both wheels. The detection compares the
+ * motor values with the speed and the acceleration of the wheels and limits the motors according
+ * to the reactions in the configuration.
+ * @param pTracLe_ pointer to the traction state of the left wheel
+ * @param pTracRi_ pointer to the traction state of the right wheel
+ * @return Error code, ERR_OK if everything was fine,\n
+ * ERR_PARAM_ADDRESS if an address is invalid
+ */
+EXTERNAL_ StdRtn_t DRV_Read_Trac(DRV_Trac_t *pTracLe_, DRV_Trac_t *pTracRi_);
+
+/**
+ * @brief Reads the [settle state](@ref DRV_PosState_t) of the position loops
+ * @param pState_ pointer to the state
+ * @return Error code, ERR_OK if everything was fine,\n
+ * ERR_PARAM_ADDRESS if the address is invalid
+ */
+EXTERNAL_ StdRtn_t DRV_Read_PosState(DRV_PosState_t *pState_);
+
 EXTERNAL_ DRV_Status_t *DRV_GetCurStatus(void);
 
 
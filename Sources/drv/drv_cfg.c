@@ -0,0 +1,171 @@
+/***********************************************************************************************//**
+ * @file		drv_cfg.c
+ * @ingroup		drv
+ * @brief 		This file contains the configuration of the SWC @ref drv
+ *
+ * The feedforward part of the speed loops is a motor model, which assumes the speed to be
+ * proportional to the motor value beyond a constant offset for static friction. A change of the
+ * speed setpoint is supported in addition by the mechanical time constant of the motors.\n
+ * The position loops are cascaded with the speed loops. They follow a motion profile towards the
+ * position target, which is limited in speed, acceleration and, for the S-curve profile, in jerk.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	18.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ ***************************************************************************************************/
+
+#define MASTER_drv_cfg_C_
+
+/*======================================= >> #INCLUDES << ========================================*/
+#include "drv_cfg.h"
+#include "drv_api.h"
+
+
+
+/*======================================= >> #DEFINES << =========================================*/
+/**
+ * Change of the speed setpoint per call of @ref DRV_MainFct in steps/sec, i.e. 20000 steps/sec^2
+ * at a cycle time of 5ms
+ */
+#define DRV_SPD_RAMP_RATE		(100)
+
+/**
+ * Speed at the wheels in steps/sec at full motor value without load
+ */
+#define DRV_MOT_NO_LOAD_SPD		(8000)
+
+/**
+ * Motor value which is required to overcome static friction
+ */
+#define DRV_MOT_FRICTION_VAL	(0)
+
+/**
+ * Mechanical time constant of the motors with the robot in [ms]
+ */
+#define DRV_MOT_TIME_CONST_MS	(80)
+
+/**
+ * Speed limit of the motion profile in steps/sec
+ */
+#define DRV_POS_SPD_MAX			(2000)
+
+/**
+ * Change of the speed of the motion profile per call in steps/sec, i.e. 12000 steps/sec^2 at a
+ * cycle time of 5ms. The profile brakes along the same deceleration.
+ */
+#define DRV_POS_ACC_MAX			(60)
+
+/**
+ * Jerk limit of the S-curve profile in steps/sec^3, i.e. the acceleration is built up within 40ms
+ */
+#define DRV_POS_JERK_MAX		(300000)
+
+/**
+ * Settle detection: position error in steps, speed in steps/sec and dwell time of 100ms in calls
+ */
+#define DRV_POS_SETTLE_MARGIN	(5)
+#define DRV_POS_SETTLE_SPD		(50)
+#define DRV_POS_SETTLE_CNT		(100u / DRV_SMPL_TIME_MS)
+
+/**
+ * Speed limit of the wheels in steps/sec for linear and angular velocity commands, derived from the
+ * maximum velocity of the robot in [mm/sec]
+ */
+#define DRV_KIN_SPD_MAX			((int32_t)( (CAU_SUMO_VELOCITY_MAX * CAU_SUMO_STEPS_PER_REV_AT_WHEEL) / \
+										(PI * CAU_SUMO_WHEEL_DIAMETER) ))
+
+/**
+ * Synchronization of the wheels in speed and position mode, its error is limited to 100 steps,
+ * i.e. about 9 degrees of heading
+ */
+#define DRV_SYNC_MODE_MSK		((1u << DRV_MODE_SPEED) | (1u << DRV_MODE_POS))
+#define DRV_SYNC_ERR_MAX		(100)
+
+/**
+ * Gains of the speed loops in the interrupt, the integral part acts on the integral of the speed
+ * error, i.e. on the position error against the integrated speed setpoint
+ */
+#define DRV_ISR_KP				(8)
+#define DRV_ISR_KI				(800)
+
+/**
+ * Slip is detected if the wheel accelerates by more than 1/8 of the full motor value faster than
+ * the motor model predicts for 15ms. The slipping wheel is limited to 1/16 of the full motor value
+ * below the value at the onset of slip, so the tyre can grip again.
+ */
+#define DRV_SLIP_RESID			(0x2000)
+#define DRV_SLIP_CNT			(15u / DRV_SMPL_TIME_MS)
+#define DRV_SLIP_CTRL_RED		(0x1000)
+
+/**
+ * Stall is detected if the wheel stands still despite at least 1/4 of the full motor value for
+ * 200ms. A stalled wheel isn't limited, it is pushing against the opponent or the border.
+ */
+#define DRV_STALL_CTRL_MIN		(0x4000)
+#define DRV_STALL_SPD			(50)
+#define DRV_STALL_CNT			(200u / DRV_SMPL_TIME_MS)
+
+/**
+ * Reactions to slip and stall and their release after 100ms without either. The traction state is
+ * only reported by default, until the reactions have been tried on the target.
+ */
+#ifndef DRV_TRAC_RCT
+#define DRV_TRAC_RCT			(DRV_TRAC_RCT_NONE)
+#endif
+#define DRV_TRAC_RLS_CNT		(100u / DRV_SMPL_TIME_MS)
+
+
+
+/*=================================== >> TYPE DEFINITIONS << =====================================*/
+
+
+
+/*============================= >> LOKAL FUNCTION DECLARATIONS << ================================*/
+
+
+
+/*=================================== >> GLOBAL VARIABLES << =====================================*/
+static const DRV_Cfg_t drvCfg =
+{
+	DRV_SPD_RAMP_RATE,
+	(int32_t)( ((int64_t)0xFFFF << 16) / DRV_MOT_NO_LOAD_SPD ),
+	DRV_MOT_FRICTION_VAL,
+	(int32_t)( (((int64_t)0xFFFF << 16) * DRV_MOT_TIME_CONST_MS) / ((int64_t)DRV_MOT_NO_LOAD_SPD * DRV_SMPL_TIME_MS) ),
+	DRV_POS_SPD_MAX,
+	DRV_POS_ACC_MAX,
+	DRV_POS_JERK_MAX,
+	DRV_PROF_SCURVE,
+	DRV_POS_SETTLE_MARGIN,
+	DRV_POS_SETTLE_SPD,
+	DRV_POS_SETTLE_CNT,
+	DRV_KIN_SPD_MAX,
+	DRV_SYNC_MODE_MSK,
+	DRV_SYNC_ERR_MAX,
+	(int32_t)DRV_ISR_KP << 16,
+	(int32_t)DRV_ISR_KI << 16,
+	DRV_TRAC_RCT,
+	DRV_SLIP_RESID,
+	DRV_SLIP_CNT,
+	DRV_SLIP_CTRL_RED,
+	DRV_STALL_CTRL_MIN,
+	DRV_STALL_SPD,
+	DRV_STALL_CNT,
+	DRV_TRAC_RLS_CNT,
+};
+
+
+
+/*============================== >> LOKAL FUNCTION DEFINITIONS << ================================*/
+
+
+
+/*============================= >> GLOBAL FUNCTION DEFINITIONS << ================================*/
+const DRV_Cfg_t *Get_pDrvCfg(void) {return &drvCfg;}
+
+
+
+#ifdef MASTER_drv_cfg_C_
+#undef MASTER_drv_cfg_C_
+#endif /* !MASTER_drv_cfg_C_ */
@@ -0,0 +1,134 @@
+/***********************************************************************************************//**
+ * @file		drv_cfg.h
+ * @ingroup		drv
+ * @brief 		This header file contains the type definition of the configuration of the SWC @ref drv
+ *
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	18.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ ***************************************************************************************************/
+
+#ifndef DRV_CFG_H_
+#define DRV_CFG_H_
+
+/*======================================= >> #INCLUDES << ========================================*/
+#include "Platform.h"
+#include "ACon_Types.h"
+
+
+
+#ifdef MASTER_drv_cfg_C_
+#define EXTERNAL_
+#else
+#define EXTERNAL_ extern
+#endif
+
+
+/*======================================= >> #DEFINES << =========================================*/
+/**
+ * Cycle time of @ref DRV_MainFct in [ms]
+ */
+#define DRV_SMPL_TIME_MS	(5u)
+
+/**
+ * Runs the speed loops in the interrupt of the timer QuadInt, which samples the quadrature
+ * decoders, instead of @ref DRV_MainFct. The drive task only runs the outer loops then.
+ * It stays FALSE until the interrupt loop is fixed: in the host test test_drv_loop its mean speed
+ * error is 2.9 steps/s against 0.6 steps/s of the task loop, and no pair of DRV_ISR_KP and
+ * DRV_ISR_KI closes the gap without a larger error or a position move which doesn't settle.
+ */
+#ifndef DRV_USES_ISR_LOOP
+#define DRV_USES_ISR_LOOP	(FALSE)
+#endif
+
+/**
+ * Period of the timer QuadInt in [us]
+ */
+#define DRV_ISR_TMR_PERIOD_US	(70u)
+
+/**
+ * Number of interrupts of QuadInt per call of the speed loops in the interrupt, i.e. 980us
+ */
+#define DRV_ISR_DECIM		(14u)
+
+/**
+ * Cycle time of the speed loops in the interrupt in [us]
+ */
+#define DRV_ISR_SMPL_TIME_US	(DRV_ISR_TMR_PERIOD_US * DRV_ISR_DECIM)
+
+/**
+ * Number of calls of the speed loops in the interrupt, over which the speed is measured as the
+ * difference of the position
+ */
+#define DRV_ISR_WIN_LEN		(8u)
+
+
+/*=================================== >> TYPE DEFINITIONS << =====================================*/
+/**
+ * @brief Motion profiles of the position loops
+ */
+typedef enum DRV_ProfType_e
+{
+	DRV_PROF_TRAPEZ = 0,	/**< time-optimal trapezoidal speed profile */
+	DRV_PROF_SCURVE,		/**< jerk-limited S-curve speed profile */
+}DRV_ProfType_t;
+
+/**
+ * @brief Reactions to slip and stall of a wheel, which can be combined
+ */
+typedef enum DRV_TracRct_e
+{
+	DRV_TRAC_RCT_NONE     = 0x00,	/**< the traction state is reported only */
+	DRV_TRAC_RCT_INT_HOLD = 0x01,	/**< the integral part of the speed loop is frozen */
+	DRV_TRAC_RCT_TRQ_LIM  = 0x02,	/**< the motor value of a slipping wheel is limited */
+}DRV_TracRct_t;
+
+/**
+ * @brief Configuration of the setpoint ramp and the feedforward motor model of the speed loops and
+ * of the motion profile and the settle detection of the position loops, of the kinematics, of
+ * the synchronization of the wheels, of the speed loops in the interrupt and of the slip and stall
+ * detection
+ */
+typedef struct DRV_Cfg_s
+{
+	int32_t spdRampRate;	/**< maximum change of the speed setpoint per call in steps/sec */
+	int32_t ffGain;			/**< feedforward gain in motor value per steps/sec as Q15.16 */
+	int32_t ffOffset;		/**< feedforward motor value for overcoming static friction */
+	int32_t ffAccGain;		/**< feedforward gain in motor value per change of the speed per call in steps/sec as Q15.16 */
+	int32_t posSpdMax;		/**< maximum speed of the motion profile in steps/sec */
+	int32_t posAccMax;		/**< maximum change of the speed of the motion profile per call in steps/sec */
+	int32_t posJerkMax;		/**< maximum jerk of the S-curve profile in steps/sec^3 */
+	DRV_ProfType_t posProf;	/**< motion profile of the position loops */
+	int32_t posSettleMargin;/**< maximum position error in steps of a settled position loop */
+	int32_t posSettleSpd;	/**< maximum speed in steps/sec of a settled position loop */
+	uint16_t posSettleCnt;	/**< number of calls both loops have to be within the margins until settled */
+	int32_t kinSpdMax;		/**< speed limit of the wheels in steps/sec for linear and angular velocity commands */
+	uint8_t syncModeMsk;	/**< modes with synchronization of the wheels, bit n enables DRV_Mode_t n */
+	int32_t syncErrMax;		/**< limit of the synchronization error in steps */
+	int32_t isrKp;			/**< proportional gain of the speed loops in the interrupt in motor value per steps/sec as Q15.16 */
+	int32_t isrKi;			/**< integral gain of the speed loops in the interrupt in motor value per step of the position error as Q15.16 */
+	uint8_t tracRct;		/**< reactions to slip and stall, combination of DRV_TracRct_t */
+	int32_t slipResid;		/**< motor value, by which the motor model exceeds the motor value of a slipping wheel */
+	uint16_t slipCnt;		/**< number of calls the residual has to exceed slipResid until slip is detected */
+	int32_t slipCtrlRed;	/**< reduction of the motor value at the onset of slip to the limit of a slipping wheel */
+	int32_t stallCtrlMin;	/**< minimum motor value of a stalled wheel */
+	int32_t stallSpd;		/**< maximum speed in steps/sec of a stalled wheel */
+	uint16_t stallCnt;		/**< number of calls within the stall margins until stall is detected */
+	uint16_t tracRlsCnt;	/**< number of calls without slip or stall until the traction state is released */
+}DRV_Cfg_t;
+
+
+
+/*============================ >> GLOBAL FUNCTION DECLARATIONS << ================================*/
+EXTERNAL_ const DRV_Cfg_t *Get_pDrvCfg(void);
+
+
+
+#ifdef EXTERNAL_
+#undef EXTERNAL_
+#endif
+
+#endif /* !DRV_CFG_H_ */
@@ -20,8 +20,8 @@
 /*======================================= >> #INCLUDES << ========================================*/
 #include "drv_clshdlr.h"
 #include "drv_api.h"
-#include "Q4CLeft.h"
-#include "Q4CRight.h"
+#include "drv_cfg.h"
+#include "tacho_api.h"
 
 /*======================================= >> #DEFINES << =========================================*/
 
@@ -33,6 +33,8 @@
 
 /*============================= >> LOKAL FUNCTION DECLARATIONS << ================================*/
 static uint8_t *DRV_GetModeStr(DRV_Mode_t mode);
+static uint8_t *DRV_GetPosStateStr(DRV_PosState_t state);
+static uint8_t *DRV_GetTracStr(DRV_Trac_t trac);
 
 
 
@@ -51,6 +53,24 @@ static uint8_t *DRV_GetModeStr(DRV_Mode_t mode) {
 	}
 }
 
+static uint8_t *DRV_GetPosStateStr(DRV_PosState_t state) {
+	switch(state) {
+	case DRV_POS_STATE_MOVE:     return (uint8_t*)"MOVE";
+	case DRV_POS_STATE_SETTLING: return (uint8_t*)"SETTLING";
+	case DRV_POS_STATE_SETTLED:  return (uint8_t*)"SETTLED";
+	default: return (uint8_t*)"UNKNOWN";
+	}
+}
+
+static uint8_t *DRV_GetTracStr(DRV_Trac_t trac) {
+	switch(trac) {
+	case DRV_TRAC_OK:    return (uint8_t*)"OK";
+	case DRV_TRAC_SLIP:  return (uint8_t*)"SLIP";
+	case DRV_TRAC_STALL: return (uint8_t*)"STALL";
+	default: return (uint8_t*)"UNKNOWN";
+	}
+}
+
 static void DRV_PrintHelp(const CLS1_StdIOType *io_) {
 	CLS1_SendHelpStr((unsigned char*)"drive", (unsigned char*)"Group of drive commands\r\n", io_->stdOut);
 	CLS1_SendHelpStr((unsigned char*)"  help|status", (unsigned char*)"Shows drive help or status\r\n", io_->stdOut);
@@ -58,10 +78,23 @@ static void DRV_PrintHelp(const CLS1_StdIOType *io_) {
 	CLS1_SendHelpStr((unsigned char*)"  speed <left> <right>", (unsigned char*)"Move left and right motors with given speed\r\n", io_->stdOut);
 	CLS1_SendHelpStr((unsigned char*)"  pos <left> <right>", (unsigned char*)"Move left and right wheels to given position\r\n", io_->stdOut);
 	CLS1_SendHelpStr((unsigned char*)"  pos reset", (unsigned char*)"Reset drive and wheel position\r\n", io_->stdOut);
+	CLS1_SendHelpStr((unsigned char*)"  vel <mm/s> <0.1deg/s>", (unsigned char*)"Move robot with given linear and angular velocity\r\n", io_->stdOut);
+	CLS1_SendHelpStr((unsigned char*)"  move <mm> <0.1deg>", (unsigned char*)"Turn robot by given angle, then move it by given distance\r\n", io_->stdOut);
+	CLS1_SendHelpStr((unsigned char*)"  sync <mode> on|off", (unsigned char*)"Enable wheel synchronization in given mode (stop|speed|pos)\r\n", io_->stdOut);
 }
 
 static void DRV_PrintStatus(const CLS1_StdIOType *io_) {
-	uint8_t buf[24];
+	uint8_t buf[40];
+	int32_t posRef = 0;
+	uint16_t latMs = 0u, latMaxMs = 0u;
+	uint8_t segIdx = 0u, numSeg = 0u;
+	int32_t syncErr = 0, syncCorr = 0;
+	bool isSyncEna = FALSE;
+	DRV_Trac_t tracLe = DRV_TRAC_OK, tracRi = DRV_TRAC_OK;
+#if DRV_USES_ISR_LOOP
+	uint16_t isrLoad = 0u;
+	uint32_t isrCycMax = 0u;
+#endif
 
 	CLS1_SendStatusStr((unsigned char*)"drive", (unsigned char*)"\r\n", io_->stdOut);
 
@@ -78,15 +111,81 @@ static void DRV_PrintStatus(const CLS1_StdIOType *io_) {
 
 	UTIL1_Num32sToStr(buf, sizeof(buf), DRV_GetCurStatus()->pos.left);
 	UTIL1_strcat(buf, sizeof(buf), (unsigned char*)" (curr: ");
-	UTIL1_strcatNum32s(buf, sizeof(buf), (int32_t)Q4CLeft_GetPos());
+	UTIL1_strcatNum32s(buf, sizeof(buf), TACHO_Get_CntPosLe());
 	UTIL1_strcat(buf, sizeof(buf), (unsigned char*)")\r\n");
 	CLS1_SendStatusStr((unsigned char*)"  pos left", buf, io_->stdOut);
 
 	UTIL1_Num32sToStr(buf, sizeof(buf), DRV_GetCurStatus()->pos.right);
 	UTIL1_strcat(buf, sizeof(buf), (unsigned char*)" (curr: ");
-	UTIL1_strcatNum32s(buf, sizeof(buf), (int32_t)Q4CRight_GetPos());
+	UTIL1_strcatNum32s(buf, sizeof(buf), TACHO_Get_CntPosRi());
 	UTIL1_strcat(buf, sizeof(buf), (unsigned char*)")\r\n");
 	CLS1_SendStatusStr((unsigned char*)"  pos right", buf, io_->stdOut);
+
+	(void)DRV_Read_LftPosRefVal(&posRef);
+	UTIL1_Num32sToStr(buf, sizeof(buf), posRef);
+	UTIL1_strcat(buf, sizeof(buf), (unsigned char*)" left, ");
+	(void)DRV_Read_RghtPosRefVal(&posRef);
+	UTIL1_strcatNum32s(buf, sizeof(buf), posRef);
+	UTIL1_strcat(buf, sizeof(buf), (unsigned char*)" right\r\n");
+	CLS1_SendStatusStr((unsigned char*)"  pos ref", buf, io_->stdOut);
+
+	(void)DRV_Read_CmdLatency(&latMs, &latMaxMs);
+	UTIL1_Num16uToStr(buf, sizeof(buf), latMs);
+	UTIL1_strcat(buf, sizeof(buf), (unsigned char*)" ms (max ");
+	UTIL1_strcatNum16u(buf, sizeof(buf), latMaxMs);
+	UTIL1_strcat(buf, sizeof(buf), (unsigned char*)" ms)\r\n");
+	CLS1_SendStatusStr((unsigned char*)"  cmd latency", buf, io_->stdOut);
+
+	(void)DRV_Read_ScrSegIdx(&segIdx, &numSeg);
+	if( segIdx < numSeg )
+	{
+		UTIL1_strcpy(buf, sizeof(buf), (unsigned char*)"segment ");
+		UTIL1_strcatNum8u(buf, sizeof(buf), segIdx + 1u);
+		UTIL1_strcat(buf, sizeof(buf), (unsigned char*)" of ");
+		UTIL1_strcatNum8u(buf, sizeof(buf), numSeg);
+		UTIL1_strcat(buf, sizeof(buf), (unsigned char*)"\r\n");
+	}
+	else
+	{
+		UTIL1_strcpy(buf, sizeof(buf), (unsigned char*)"none\r\n");
+	}
+	CLS1_SendStatusStr((unsigned char*)"  script", buf, io_->stdOut);
+
+	(void)DRV_Read_SyncEna(DRV_GetCurStatus()->mode, &isSyncEna);
+	(void)DRV_Read_SyncErr(&syncErr, &syncCorr);
+	if( TRUE == isSyncEna )
+	{
+		UTIL1_Num32sToStr(buf, sizeof(buf), syncErr);
+		UTIL1_strcat(buf, sizeof(buf), (unsigned char*)" steps, corr ");
+		UTIL1_strcatNum32s(buf, sizeof(buf), syncCorr);
+		UTIL1_strcat(buf, sizeof(buf), (unsigned char*)" steps/sec\r\n");
+	}
+	else
+	{
+		UTIL1_strcpy(buf, sizeof(buf), (unsigned char*)"off\r\n");
+	}
+	CLS1_SendStatusStr((unsigned char*)"  sync", buf, io_->stdOut);
+
+	(void)DRV_Read_Trac(&tracLe, &tracRi);
+	UTIL1_strcpy(buf, sizeof(buf), DRV_GetTracStr(tracLe));
+	UTIL1_strcat(buf, sizeof(buf), (unsigned char*)" left, ");
+	UTIL1_strcat(buf, sizeof(buf), DRV_GetTracStr(tracRi));
+	UTIL1_strcat(buf, sizeof(buf), (unsigned char*)" right\r\n");
+	CLS1_SendStatusStr((unsigned char*)"  traction", buf, io_->stdOut);
+
+#if DRV_USES_ISR_LOOP
+	(void)DRV_Read_IsrLoad(&isrLoad, &isrCycMax);
+	UTIL1_Num16uToStr(buf, sizeof(buf), isrLoad / 100u);
+	UTIL1_chcat(buf, sizeof(buf), '.');
+	UTIL1_strcatNum16uFormatted(buf, sizeof(buf), isrLoad % 100u, '0', 2);
+	UTIL1_strcat(buf, sizeof(buf), (unsigned char*)" % (max ");
+	UTIL1_strcatNum32u(buf, sizeof(buf), isrCycMax);
+	UTIL1_strcat(buf, sizeof(buf), (unsigned char*)" cycles)\r\n");
+	CLS1_SendStatusStr((unsigned char*)"  isr load", buf, io_->stdOut);
+#endif
+
+	CLS1_SendStatusStr((unsigned char*)"  pos state", DRV_GetPosStateStr(DRV_GetCurStatus()->posState), io_->stdOut);
+	CLS1_SendStr((unsigned char*)"\r\n", io_->stdOut);
 }
 
 
@@ -119,8 +218,7 @@ uint8_t DRV_ParseCommand(const unsigned char *cmd_, bool *handled_, const CLS1_S
 			res = ERR_FAILED;
 		}
 	} else if (UTIL1_strncmp((char*)cmd_, (char*)"drive pos reset", sizeof("drive pos reset")-1)==0) {
-		Q4CLeft_SetPos(0);
-		Q4CRight_SetPos(0);
+		TACHO_Set_CntPos(0, 0);
 		if (DRV_SetPos(0, 0)!=ERR_OK) {
 			CLS1_SendStr((unsigned char*)"failed\r\n", io_->stdErr);
 		}
@@ -140,6 +238,57 @@ uint8_t DRV_ParseCommand(const unsigned char *cmd_, bool *handled_, const CLS1_S
 			CLS1_SendStr((unsigned char*)"Wrong argument(s)\r\n", io_->stdErr);
 			res = ERR_FAILED;
 		}
+	} else if (UTIL1_strncmp((char*)cmd_, (char*)"drive vel ", sizeof("drive vel ")-1)==0) {
+		p = cmd_+sizeof("drive vel");
+		if (UTIL1_xatoi(&p, &val1)==ERR_OK) {
+			if (UTIL1_xatoi(&p, &val2)==ERR_OK) {
+				if (DRV_SetVel(val1, val2)!=ERR_OK) {
+					CLS1_SendStr((unsigned char*)"failed\r\n", io_->stdErr);
+				}
+				*handled_ = TRUE;
+			} else {
+				CLS1_SendStr((unsigned char*)"failed\r\n", io_->stdErr);
+			}
+		} else {
+			CLS1_SendStr((unsigned char*)"Wrong argument(s)\r\n", io_->stdErr);
+			res = ERR_FAILED;
+		}
+	} else if (UTIL1_strncmp((char*)cmd_, (char*)"drive move ", sizeof("drive move ")-1)==0) {
+		p = cmd_+sizeof("drive move");
+		if (UTIL1_xatoi(&p, &val1)==ERR_OK) {
+			if (UTIL1_xatoi(&p, &val2)==ERR_OK) {
+				if (DRV_MoveRel(val1, val2, NULL)!=ERR_OK) {
+					CLS1_SendStr((unsigned char*)"failed\r\n", io_->stdErr);
+				}
+				*handled_ = TRUE;
+			} else {
+				CLS1_SendStr((unsigned char*)"failed\r\n", io_->stdErr);
+			}
+		} else {
+			CLS1_SendStr((unsigned char*)"Wrong argument(s)\r\n", io_->stdErr);
+			res = ERR_FAILED;
+		}
+	} else if (UTIL1_strncmp((char*)cmd_, (char*)"drive sync ", sizeof("drive sync ")-1)==0) {
+		p = cmd_+sizeof("drive sync");
+		if (UTIL1_strcmp((char*)p, (char*)"stop on")==0) {
+			res = DRV_Set_SyncEna(DRV_MODE_STOP, TRUE);
+		} else if (UTIL1_strcmp((char*)p, (char*)"stop off")==0) {
+			res = DRV_Set_SyncEna(DRV_MODE_STOP, FALSE);
+		} else if (UTIL1_strcmp((char*)p, (char*)"speed on")==0) {
+			res = DRV_Set_SyncEna(DRV_MODE_SPEED, TRUE);
+		} else if (UTIL1_strcmp((char*)p, (char*)"speed off")==0) {
+			res = DRV_Set_SyncEna(DRV_MODE_SPEED, FALSE);
+		} else if (UTIL1_strcmp((char*)p, (char*)"pos on")==0) {
+			res = DRV_Set_SyncEna(DRV_MODE_POS, TRUE);
+		} else if (UTIL1_strcmp((char*)p, (char*)"pos off")==0) {
+			res = DRV_Set_SyncEna(DRV_MODE_POS, FALSE);
+		} else {
+			res = ERR_FAILED;
+		}
+		if (res!=ERR_OK) {
+			CLS1_SendStr((unsigned char*)"failed\r\n", io_->stdErr);
+		}
+		*handled_ = TRUE;
 	} else if (UTIL1_strncmp((char*)cmd_, (char*)"drive mode ", sizeof("drive mode ")-1)==0) {
 		p = cmd_+sizeof("drive mode");
 		if (UTIL1_strcmp((char*)p, (char*)"none")==0) {
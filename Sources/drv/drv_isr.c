@@ -0,0 +1,296 @@
+/***********************************************************************************************//**
+ * @file		drv_isr.c
+ * @ingroup		drv
+ * @brief 		Implementation of the speed loops of the SWC @ref drv in the timer interrupt
+ *
+ * This module runs the speed loops of both wheels in the interrupt of the timer QuadInt, which
+ * samples the quadrature decoders, at about 1 kHz instead of the 5ms of the drive task. The loops
+ * read the positions of the decoders directly and write the motor values. The drive task runs the
+ * outer loops and hands the speed setpoints and the feedforward motor values over.\n
+ * The proportional part acts on the speed, which is measured as the difference of the position
+ * over a window of calls. The integral part acts on the position error against the integrated
+ * speed setpoint, which is free of the quantization of the measured speed. Its integration is
+ * suspended while the motor value is saturated.\n
+ * The cycles of the loops are counted by the cycle counter of the core and averaged to the
+ * interrupt load over about one second.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#define MASTER_drv_isr_C_
+
+/*======================================= >> #INCLUDES << ========================================*/
+#include "drv_isr.h"
+#include "drv_api.h"
+#include "drv_cfg.h"
+#include "tacho_api.h"
+#include "mot.h"
+#include "mot_api.h"
+#include "CS1.h"
+#include "KIN1.h"
+#include "Cpu.h"
+
+
+
+/*======================================= >> #DEFINES << =========================================*/
+/**
+ * @brief Speed in steps/sec as Q15.16 per step of the position difference over the window
+ */
+#define DRV_ISR_SPD_FCTR	((int64_t)( ( (int64_t)1000000 << 16 ) / ( (int64_t)DRV_ISR_WIN_LEN * DRV_ISR_SMPL_TIME_US ) ))
+
+/**
+ * @brief Steps per call as Q31.32 per steps/sec of the speed setpoint
+ */
+#define DRV_ISR_POS_FCTR	((int64_t)( ( ( (int64_t)DRV_ISR_SMPL_TIME_US << 32 ) + 500000 ) / 1000000 ))
+
+/**
+ * @brief Maximum motor value as Q15.16
+ */
+#define DRV_ISR_CTRL_MAX	((int64_t)0xFFFF << 16)
+
+/**
+ * @brief Number of calls, over which the interrupt load is averaged, i.e. about one second
+ */
+#define DRV_ISR_LOAD_CNT	(1000000u / DRV_ISR_SMPL_TIME_US)
+
+
+
+/*=================================== >> TYPE DEFINITIONS << =====================================*/
+typedef struct DRV_IsrWhl_s
+{
+	int32_t spdSetVal;		/* speed setpoint in steps/sec */
+	int32_t ffVal;			/* feedforward motor value */
+	int32_t ctrlMax;		/* limit of the absolute motor value */
+	bool isIntHold;			/* the integral part is frozen */
+	int32_t prevPos;		/* position of the last call */
+	int32_t aWinPos[DRV_ISR_WIN_LEN];	/* positions of the last calls */
+	int64_t intVal;			/* integral part as Q47.16 */
+	int32_t ctrlVal;		/* last motor value */
+} DRV_IsrWhl_t;
+
+
+
+/*============================= >> LOKAL FUNCTION DECLARATIONS << ================================*/
+static void DRV_Isr_Ctrl(DRV_IsrWhl_t *pWhl_, int32_t pos_);
+static void DRV_Isr_Set_Mot(int32_t ctrlVal_, MOT_MotorSide_t side_);
+static void DRV_Isr_Upd_Load(uint32_t cyc_);
+
+
+
+/*=================================== >> GLOBAL VARIABLES << =====================================*/
+static DRV_IsrWhl_t DRV_IsrWhl[TACHO_ID_CNT];
+static volatile bool DRV_IsrIsAct = FALSE;		/* the loops have setpoints and drive the motors */
+static uint8_t DRV_IsrDecimCntr = 0u;
+static uint8_t DRV_IsrWinIdx = 0u;				/* oldest position of the window */
+static uint32_t DRV_IsrCycSum = 0u;
+static uint32_t DRV_IsrLoadCntr = 0u;
+static volatile uint16_t DRV_IsrLoad = 0u;		/* interrupt load in 0.01 percent */
+static volatile uint32_t DRV_IsrCycMax = 0u;		/* maximum cycles of a call */
+
+
+
+/*============================== >> LOKAL FUNCTION DEFINITIONS << ================================*/
+/**
+ * @brief Runs the speed loop of a wheel at the position pos_
+ */
+static void DRV_Isr_Ctrl(DRV_IsrWhl_t *pWhl_, int32_t pos_)
+{
+	const DRV_Cfg_t *pCfg = Get_pDrvCfg();
+	int64_t spdErr = ( (int64_t)pWhl_->spdSetVal * 65536 )
+			- (int64_t)( pos_ - pWhl_->aWinPos[DRV_IsrWinIdx] ) * DRV_ISR_SPD_FCTR;
+	int64_t posErr = ( ( (int64_t)pWhl_->spdSetVal * DRV_ISR_POS_FCTR ) >> 16 )
+			- ( (int64_t)( pos_ - pWhl_->prevPos ) * 65536 );
+	int64_t intVal = pWhl_->intVal;
+	int64_t ctrlMax = (int64_t)pWhl_->ctrlMax * 65536;
+	int64_t ctrlVal = 0;
+
+	if( FALSE == pWhl_->isIntHold )
+	{
+		intVal += ( (int64_t)pCfg->isrKi * posErr ) >> 16;
+	}
+
+	intVal  = ( intVal > DRV_ISR_CTRL_MAX ) ? DRV_ISR_CTRL_MAX : ( ( intVal < -DRV_ISR_CTRL_MAX ) ? -DRV_ISR_CTRL_MAX : intVal );
+	ctrlVal = ( (int64_t)pWhl_->ffVal * 65536 ) + ( ( (int64_t)pCfg->isrKp * spdErr ) >> 16 ) + intVal;
+	if( ctrlVal > ctrlMax )
+	{
+		ctrlVal = ctrlMax;
+		intVal  = ( posErr > 0 ) ? pWhl_->intVal : intVal;
+	}
+	else if( ctrlVal < -ctrlMax )
+	{
+		ctrlVal = -ctrlMax;
+		intVal  = ( posErr < 0 ) ? pWhl_->intVal : intVal;
+	}
+	else
+	{
+		/* not saturated, integrate */
+	}
+	pWhl_->intVal   = intVal;
+	pWhl_->ctrlVal  = (int32_t)( ctrlVal >> 16 );
+	pWhl_->prevPos  = pos_;
+	pWhl_->aWinPos[DRV_IsrWinIdx] = pos_;
+}
+
+/**
+ * @brief Sets the motor value and the direction of a motor
+ */
+static void DRV_Isr_Set_Mot(int32_t ctrlVal_, MOT_MotorSide_t side_)
+{
+	MOT_Direction_t direction = ( ctrlVal_ >= 0 ) ? MOT_DIR_FORWARD : MOT_DIR_BACKWARD;
+	MOT_MotorDevice_t *motHandle = MOT_GetMotorHandle(side_);
+
+	if(NULL != motHandle)
+	{
+		MOT_SetDirection(motHandle, direction);
+		MOT_SetVal(motHandle, (uint16_t)( 0xFFFF - ( ( ctrlVal_ >= 0 ) ? ctrlVal_ : -ctrlVal_ ) )); /* PWM is low active */
+		MOT_UpdatePercent(motHandle, direction);
+	}
+}
+
+/**
+ * @brief Adds the cycles of a call to the interrupt load, which is updated every
+ * DRV_ISR_LOAD_CNT calls
+ */
+static void DRV_Isr_Upd_Load(uint32_t cyc_)
+{
+	DRV_IsrCycSum += cyc_;
+	DRV_IsrCycMax  = ( cyc_ > DRV_IsrCycMax ) ? cyc_ : DRV_IsrCycMax;
+	DRV_IsrLoadCntr++;
+	if( DRV_IsrLoadCntr >= DRV_ISR_LOAD_CNT )
+	{
+		DRV_IsrLoad = (uint16_t)( ( (uint64_t)DRV_IsrCycSum * 10000u )
+				/ ( (uint64_t)DRV_ISR_LOAD_CNT * DRV_ISR_SMPL_TIME_US * ( CPU_CORE_CLK_HZ / 1000000u ) ) );
+		DRV_IsrCycSum   = 0u;
+		DRV_IsrLoadCntr = 0u;
+	}
+}
+
+
+
+/*============================= >> GLOBAL FUNCTION DEFINITIONS << ================================*/
+void DRV_Isr_Init(void)
+{
+	int32_t aPos[TACHO_ID_CNT] = {TACHO_Get_CntPosLe(), TACHO_Get_CntPosRi()};
+	uint8_t i = 0u, j = 0u;
+	CS1_CriticalVariable();
+
+	CS1_EnterCritical();
+	DRV_IsrIsAct = FALSE;
+	for(i = 0u; i < TACHO_ID_CNT; i++)
+	{
+		DRV_IsrWhl[i].spdSetVal = 0;
+		DRV_IsrWhl[i].ffVal     = 0;
+		DRV_IsrWhl[i].ctrlMax   = 0xFFFF;
+		DRV_IsrWhl[i].isIntHold = FALSE;
+		DRV_IsrWhl[i].prevPos   = aPos[i];
+		for(j = 0u; j < DRV_ISR_WIN_LEN; j++)
+		{
+			DRV_IsrWhl[i].aWinPos[j] = aPos[i];
+		}
+		DRV_IsrWhl[i].intVal    = 0;
+		DRV_IsrWhl[i].ctrlVal   = 0;
+	}
+	DRV_IsrDecimCntr = 0u;
+	DRV_IsrWinIdx    = 0u;
+	DRV_IsrCycSum    = 0u;
+	DRV_IsrLoadCntr  = 0u;
+	DRV_IsrLoad      = 0u;
+	DRV_IsrCycMax    = 0u;
+	CS1_ExitCritical();
+
+	/* the counter runs freely, mot keeps its timestamps in it and the load is a difference */
+	KIN1_InitCycleCounter();
+	KIN1_EnableCycleCounter();
+}
+
+void DRV_Isr_Step(void)
+{
+	uint32_t cycStrt = KIN1_GetCycleCounter();
+	int32_t aPos[TACHO_ID_CNT] = {0};
+	uint8_t i = 0u;
+
+	DRV_IsrDecimCntr++;
+	if( DRV_IsrDecimCntr >= DRV_ISR_DECIM )
+	{
+		DRV_IsrDecimCntr = 0u;
+		aPos[TACHO_ID_LEFT]  = TACHO_Get_CntPosLe();
+		aPos[TACHO_ID_RIGHT] = TACHO_Get_CntPosRi();
+		for(i = 0u; i < TACHO_ID_CNT; i++)
+		{
+			if( TRUE == DRV_IsrIsAct )
+			{
+				DRV_Isr_Ctrl(&DRV_IsrWhl[i], aPos[i]);
+			}
+			else
+			{
+				/* inactive loops follow the wheels, so they start without a jump of the speed */
+				DRV_IsrWhl[i].prevPos = aPos[i];
+				DRV_IsrWhl[i].aWinPos[DRV_IsrWinIdx] = aPos[i];
+			}
+		}
+		if( TRUE == DRV_IsrIsAct )
+		{
+			DRV_Isr_Set_Mot(DRV_IsrWhl[TACHO_ID_LEFT].ctrlVal, MOT_MOTOR_LEFT);
+			DRV_Isr_Set_Mot(DRV_IsrWhl[TACHO_ID_RIGHT].ctrlVal, MOT_MOTOR_RIGHT);
+		}
+		DRV_IsrWinIdx = ( DRV_IsrWinIdx + 1u < DRV_ISR_WIN_LEN ) ? DRV_IsrWinIdx + 1u : 0u;
+		DRV_Isr_Upd_Load(KIN1_GetCycleCounter() - cycStrt);
+	}
+}
+
+void DRV_Isr_Set_Ref(const int32_t *aSpdSetVal_, const int32_t *aFfVal_,
+		const int32_t *aCtrlMax_, const bool *aIntHold_)
+{
+	uint8_t i = 0u;
+	CS1_CriticalVariable();
+
+	CS1_EnterCritical();
+	for(i = 0u; i < TACHO_ID_CNT; i++)
+	{
+		if( FALSE == DRV_IsrIsAct )
+		{
+			/* the integral part takes over the last motor value */
+			DRV_IsrWhl[i].intVal = (int64_t)( DRV_IsrWhl[i].ctrlVal - aFfVal_[i] ) * 65536;
+		}
+		DRV_IsrWhl[i].spdSetVal = aSpdSetVal_[i];
+		DRV_IsrWhl[i].ffVal     = aFfVal_[i];
+		DRV_IsrWhl[i].ctrlMax   = aCtrlMax_[i];
+		DRV_IsrWhl[i].isIntHold = aIntHold_[i];
+	}
+	DRV_IsrIsAct = TRUE;
+	CS1_ExitCritical();
+}
+
+void DRV_Isr_Stop(void)
+{
+	DRV_IsrIsAct = FALSE;
+}
+
+void DRV_Isr_Read_CtrlVal(int32_t *aCtrlVal_)
+{
+	aCtrlVal_[TACHO_ID_LEFT]  = DRV_IsrWhl[TACHO_ID_LEFT].ctrlVal;
+	aCtrlVal_[TACHO_ID_RIGHT] = DRV_IsrWhl[TACHO_ID_RIGHT].ctrlVal;
+}
+
+StdRtn_t DRV_Read_IsrLoad(uint16_t *pLoad_, uint32_t *pCycMax_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+
+	if( ( NULL != pLoad_ ) && ( NULL != pCycMax_ ) )
+	{
+		*pLoad_   = DRV_IsrLoad;
+		*pCycMax_ = DRV_IsrCycMax;
+		retVal    = ERR_OK;
+	}
+	return retVal;
+}
+
+
+
+#ifdef MASTER_drv_isr_C_
+#undef MASTER_drv_isr_C_
+#endif /* !MASTER_drv_isr_C_ */
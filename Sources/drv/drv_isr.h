@@ -0,0 +1,89 @@
+/***********************************************************************************************//**
+ * @file		drv_isr.h
+ * @ingroup		drv
+ * @brief 		Interface of the speed loops of the SWC @ref drv in the timer interrupt
+ *
+ * This header file provides the internal interface between the drive task, which hands the speed
+ * setpoints over, and the speed loops, which run in the interrupt of the timer QuadInt if
+ * @ref DRV_USES_ISR_LOOP is set.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @note Interface for BSW-specific use only
+ *
+ * @copyright 	@LGPL2_1
+ *
+ **************************************************************************************************/
+
+#ifndef DRV_ISR_H_
+#define DRV_ISR_H_
+
+/*======================================= >> #INCLUDES << ========================================*/
+#include "Platform.h"
+#include "ACon_Types.h"
+
+
+#ifdef MASTER_drv_isr_C_
+#define EXTERNAL_
+#else
+#define EXTERNAL_ extern
+#endif
+
+/**
+ * @addtogroup drv
+ * @{
+ */
+/*======================================= >> #DEFINES << =========================================*/
+
+
+
+/*=================================== >> TYPE DEFINITIONS << =====================================*/
+
+
+
+/*============================ >> GLOBAL FUNCTION DECLARATIONS << ================================*/
+/**
+ * @brief Initialises the speed loops in the interrupt and the measurement of the interrupt load.
+ * The loops are inactive until the first setpoints are handed over.
+ */
+EXTERNAL_ void DRV_Isr_Init(void);
+
+/**
+ * @brief Runs the speed loops every @ref DRV_ISR_DECIM calls. It reads the positions of the
+ * quadrature decoders and sets the motors, hence it has to be called from the interrupt of QuadInt
+ * after the decoders have been sampled.
+ */
+EXTERNAL_ void DRV_Isr_Step(void);
+
+/**
+ * @brief Hands the speed setpoints and the feedforward motor values of both wheels over to the
+ * speed loops and activates them. Inactive loops start from the last motor values.
+ * @param aSpdSetVal_ speed setpoints in steps/sec, indexed by TACHO_ID_LEFT and TACHO_ID_RIGHT
+ * @param aFfVal_     feedforward motor values
+ * @param aCtrlMax_   limits of the absolute motor values
+ * @param aIntHold_   TRUE freezes the integral part of a loop
+ */
+EXTERNAL_ void DRV_Isr_Set_Ref(const int32_t *aSpdSetVal_, const int32_t *aFfVal_,
+		const int32_t *aCtrlMax_, const bool *aIntHold_);
+
+/**
+ * @brief Deactivates the speed loops, the motors keep their last values
+ */
+EXTERNAL_ void DRV_Isr_Stop(void);
+
+/**
+ * @brief Reads the last motor values of the speed loops
+ * @param aCtrlVal_ motor values, indexed by TACHO_ID_LEFT and TACHO_ID_RIGHT
+ */
+EXTERNAL_ void DRV_Isr_Read_CtrlVal(int32_t *aCtrlVal_);
+
+
+/**
+ * @}
+ */
+#ifdef EXTERNAL_
+#undef EXTERNAL_
+#endif
+
+#endif /* !DRV_ISR_H_ */
@@ -0,0 +1,108 @@
+/***********************************************************************************************//**
+ * @file		drv_kin.c
+ * @ingroup		drv
+ * @brief 		Implementation of the kinematics of the differential drive of the SWC @ref drv
+ *
+ * This module converts the motion of the robot into the references of both wheels. A distance d
+ * and a change of heading phi on the spot move the wheels by d -/+ phi * axis length / 2, the
+ * linear and angular velocity are converted alike. The conversion factors are derived from the
+ * robot parameters in Platform.h at compile time and applied in fixed-point arithmetic.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#define MASTER_drv_kin_C_
+
+/*======================================= >> #INCLUDES << ========================================*/
+#include "drv_kin.h"
+
+
+
+/*======================================= >> #DEFINES << =========================================*/
+/**
+ * @brief Steps per mm travelled by a wheel as Q15.16, i.e. steps per revolution divided by
+ * pi * wheel diameter
+ */
+#define DRV_KIN_STEPS_PER_MM	((int64_t)( (CAU_SUMO_STEPS_PER_REV_AT_WHEEL * 65536.0) / \
+										(PI * CAU_SUMO_WHEEL_DIAMETER) + 0.5 ))
+
+/**
+ * @brief Steps per wheel and 0.1 degrees of heading as Q15.16, i.e. the arc of the wheel
+ * pi * axis length / 3600 divided by pi * wheel diameter per revolution, pi cancels
+ */
+#define DRV_KIN_STEPS_PER_HDG	((int64_t)( ((int64_t)CAU_SUMO_AXIS_LENGTH * CAU_SUMO_STEPS_PER_REV_AT_WHEEL * 65536 \
+										+ 1800 * CAU_SUMO_WHEEL_DIAMETER) / (3600 * CAU_SUMO_WHEEL_DIAMETER) ))
+
+
+
+/*=================================== >> TYPE DEFINITIONS << =====================================*/
+
+
+
+/*============================= >> LOKAL FUNCTION DECLARATIONS << ================================*/
+static int32_t DRV_Kin_Round(int64_t val_);
+
+
+
+/*=================================== >> GLOBAL VARIABLES << =====================================*/
+
+
+
+/*============================== >> LOKAL FUNCTION DEFINITIONS << ================================*/
+/**
+ * @brief Rounds a Q47.16 value to an integer
+ */
+static int32_t DRV_Kin_Round(int64_t val_)
+{
+	return (int32_t)( ( val_ + ( (int64_t)1 << 15 ) ) >> 16 );
+}
+
+
+
+/*============================= >> GLOBAL FUNCTION DEFINITIONS << ================================*/
+int32_t DRV_Kin_MmToSteps(int32_t mm_)
+{
+	return DRV_Kin_Round( (int64_t)mm_ * DRV_KIN_STEPS_PER_MM );
+}
+
+int32_t DRV_Kin_HdgToSteps(int32_t hdg_)
+{
+	return DRV_Kin_Round( (int64_t)hdg_ * DRV_KIN_STEPS_PER_HDG );
+}
+
+bool DRV_Kin_UniToWhl(int32_t lin_, int32_t ang_, int32_t lim_, int32_t *pSpdLe_, int32_t *pSpdRi_)
+{
+	int64_t lin = (int64_t)lin_ * DRV_KIN_STEPS_PER_MM;
+	int64_t ang = (int64_t)ang_ * DRV_KIN_STEPS_PER_HDG;
+	int64_t spdLe = lin - ang;
+	int64_t spdRi = lin + ang;
+	int64_t absLe = ( spdLe < 0 ) ? -spdLe : spdLe;
+	int64_t absRi = ( spdRi < 0 ) ? -spdRi : spdRi;
+	int64_t absMax = ( absLe > absRi ) ? absLe : absRi;
+	int64_t lim = ( lim_ < 0 ) ? 0 : ( (int64_t)lim_ << 16 );
+	int64_t scl = 0;
+	bool isScld = FALSE;
+
+	if( absMax > lim )
+	{
+		/* the faster wheel is set to the limit, the ratio of both wheels is kept. The common
+		 * factor is Q0.16, the speeds are reduced to Q.8 beforehand to stay within 64 bit. */
+		scl    = ( lim << 16 ) / absMax;
+		spdLe  = ( ( spdLe >> 8 ) * scl ) >> 8;
+		spdRi  = ( ( spdRi >> 8 ) * scl ) >> 8;
+		isScld = TRUE;
+	}
+	*pSpdLe_ = DRV_Kin_Round(spdLe);
+	*pSpdRi_ = DRV_Kin_Round(spdRi);
+	return isScld;
+}
+
+
+
+#ifdef MASTER_drv_kin_C_
+#undef MASTER_drv_kin_C_
+#endif /* !MASTER_drv_kin_C_ */
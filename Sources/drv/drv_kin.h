@@ -0,0 +1,81 @@
+/***********************************************************************************************//**
+ * @file		drv_kin.h
+ * @ingroup		drv
+ * @brief 		Interface of the kinematics of the differential drive of the SWC @ref drv
+ *
+ * This header file provides the internal interface of the conversions between the motion of the
+ * robot, i.e. its linear and angular velocity or its travelled distance and change of heading, and
+ * the references of both wheels.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @note Interface for BSW-specific use only
+ *
+ * @copyright 	@LGPL2_1
+ *
+ **************************************************************************************************/
+
+#ifndef DRV_KIN_H_
+#define DRV_KIN_H_
+
+/*======================================= >> #INCLUDES << ========================================*/
+#include "Platform.h"
+#include "ACon_Types.h"
+
+
+#ifdef MASTER_drv_kin_C_
+#define EXTERNAL_
+#else
+#define EXTERNAL_ extern
+#endif
+
+/**
+ * @addtogroup drv
+ * @{
+ */
+/*======================================= >> #DEFINES << =========================================*/
+
+
+
+/*=================================== >> TYPE DEFINITIONS << =====================================*/
+
+
+
+/*============================ >> GLOBAL FUNCTION DECLARATIONS << ================================*/
+/**
+ * @brief Converts a distance travelled by a wheel into steps, rounded
+ * @param mm_ distance in [mm]
+ * @return distance in steps
+ */
+EXTERNAL_ int32_t DRV_Kin_MmToSteps(int32_t mm_);
+
+/**
+ * @brief Converts a change of heading on the spot into the steps of each wheel, rounded
+ * @param hdg_ change of heading in 0.1 degrees, counter-clockwise if positive
+ * @return steps of the right wheel, the left wheel turns by the same steps in the opposite direction
+ */
+EXTERNAL_ int32_t DRV_Kin_HdgToSteps(int32_t hdg_);
+
+/**
+ * @brief Converts the linear and angular velocity of the robot into the speeds of the wheels. If a
+ * wheel exceeds the speed limit, both wheels are scaled down by the same factor, so the curvature
+ * of the path is kept.
+ * @param lin_   linear velocity in [mm/sec]
+ * @param ang_   angular velocity in 0.1 degrees/sec, counter-clockwise if positive
+ * @param lim_   speed limit of the wheels in steps/sec
+ * @param pSpdLe_ pointer to the speed of the left wheel in steps/sec
+ * @param pSpdRi_ pointer to the speed of the right wheel in steps/sec
+ * @return TRUE if the speeds have been scaled down
+ */
+EXTERNAL_ bool DRV_Kin_UniToWhl(int32_t lin_, int32_t ang_, int32_t lim_, int32_t *pSpdLe_, int32_t *pSpdRi_);
+
+
+/**
+ * @}
+ */
+#ifdef EXTERNAL_
+#undef EXTERNAL_
+#endif
+
+#endif /* !DRV_KIN_H_ */
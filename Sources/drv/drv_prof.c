@@ -0,0 +1,182 @@
+/***********************************************************************************************//**
+ * @file		drv_prof.c
+ * @ingroup		drv
+ * @brief 		Implementation of the motion profile generator of the SWC @ref drv
+ *
+ * This module generates the position and speed references of one wheel towards a target position,
+ * one sample per call. The trapezoidal profile is planned online: each sample it accelerates by
+ * the maximum acceleration up to the maximum speed, unless the remaining distance requires to brake
+ * with the maximum acceleration already. This makes the profile time-optimal and lets a new target
+ * be taken over from the current state of the profile at any time, including a reversal.\n
+ * The S-curve profile averages the position increments of the trapezoidal profile over a window
+ * of samples. It hence takes the acceleration from zero to its maximum within the window, which
+ * limits the jerk, and ends at the same target after the additional length of the window.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#define MASTER_drv_prof_C_
+
+/*======================================= >> #INCLUDES << ========================================*/
+#include "drv_prof.h"
+#include "mtx_api.h"
+
+
+
+/*======================================= >> #DEFINES << =========================================*/
+/**
+ * @brief Remaining distance of 2^18 steps as Q47.16, beyond which the profile runs at maximum
+ * speed without calculating the braking speed. It keeps the calculation within 64 bit.
+ */
+#define DRV_PROF_DIST_MAX		((int64_t)1 << 34)
+
+
+
+/*=================================== >> TYPE DEFINITIONS << =====================================*/
+
+
+
+/*============================= >> LOKAL FUNCTION DECLARATIONS << ================================*/
+
+
+
+/*=================================== >> GLOBAL VARIABLES << =====================================*/
+
+
+
+/*============================== >> LOKAL FUNCTION DEFINITIONS << ================================*/
+
+
+
+/*============================= >> GLOBAL FUNCTION DEFINITIONS << ================================*/
+void DRV_Prof_Init(DRV_Prof_t *pProf_, const DRV_Cfg_t *pCfg_, int32_t pos_, int32_t spd_)
+{
+	/* time to build up the maximum acceleration with the maximum jerk in samples, rounded up */
+	uint64_t jerkSmpl = (uint64_t)pCfg_->posJerkMax * DRV_SMPL_TIME_MS * DRV_SMPL_TIME_MS;
+	uint64_t winLen = 1u;
+	uint8_t i = 0u;
+
+	if( ( DRV_PROF_SCURVE == pCfg_->posProf ) && ( 0u != jerkSmpl ) )
+	{
+		winLen = ( (uint64_t)pCfg_->posAccMax * 1000000u + jerkSmpl - 1u ) / jerkSmpl;
+		winLen = ( winLen < 1u ) ? 1u : ( ( winLen > DRV_PROF_WIN_MAX ) ? DRV_PROF_WIN_MAX : winLen );
+	}
+	pProf_->winLen    = (uint8_t)winLen;
+	pProf_->winRecip  = ( (int64_t)1 << 32 ) / (int64_t)winLen;
+	pProf_->spdMax    = (int32_t)( ( (int64_t)pCfg_->posSpdMax << 16 ) * DRV_SMPL_TIME_MS / 1000 );
+	pProf_->accMax    = (int32_t)( ( (int64_t)pCfg_->posAccMax << 16 ) * DRV_SMPL_TIME_MS / 1000 );
+
+	/* the window is filled with the current speed, so the trapezoidal profile runs ahead by
+	 * the position increments, which haven't been averaged yet */
+	pProf_->trapSpd   = (int32_t)( ( (int64_t)spd_ << 16 ) * DRV_SMPL_TIME_MS / 1000 );
+	pProf_->spd       = pProf_->trapSpd;
+	pProf_->pos       = (int64_t)pos_ << 16;
+	pProf_->trapPos   = pProf_->pos + ( (int64_t)pProf_->trapSpd * (int64_t)( winLen - 1u ) ) / 2;
+	pProf_->trgtPos   = pProf_->pos;
+	pProf_->winSum    = (int64_t)pProf_->trapSpd * (int64_t)winLen;
+	for(i = 0u; i < DRV_PROF_WIN_MAX; i++)
+	{
+		pProf_->aWinIncr[i] = ( i < winLen ) ? pProf_->trapSpd : 0;
+	}
+	pProf_->winIdx    = 0u;
+	pProf_->isDone    = ( 0 == pProf_->trapSpd ) ? TRUE : FALSE;
+	pProf_->idleCnt   = ( TRUE == pProf_->isDone ) ? pProf_->winLen : 0u;
+}
+
+void DRV_Prof_Set_Trgt(DRV_Prof_t *pProf_, int32_t trgt_)
+{
+	int64_t trgtPos = (int64_t)trgt_ << 16;
+
+	if( trgtPos != pProf_->trgtPos )
+	{
+		pProf_->trgtPos = trgtPos;
+		pProf_->isDone  = FALSE;
+	}
+}
+
+void DRV_Prof_Step(DRV_Prof_t *pProf_)
+{
+	int64_t err  = pProf_->trgtPos - pProf_->trapPos;
+	int64_t dir  = ( err < 0 ) ? -1 : 1;
+	int64_t dist = err * dir;
+	int64_t spd  = (int64_t)pProf_->trapSpd * dir;	/* speed towards the target */
+	int64_t acc  = (int64_t)pProf_->accMax;
+	int64_t spdNew = 0, lim = 0, disc = 0;
+	int32_t incr = 0;
+
+	if( ( 2 * dist <= acc ) && ( spd <= acc ) && ( spd >= -acc ) )
+	{
+		/* the rest of the distance is covered within this sample */
+		incr = (int32_t)err;
+		pProf_->trapPos = pProf_->trgtPos;
+		pProf_->trapSpd = 0;
+	}
+	else
+	{
+		lim = (int64_t)pProf_->spdMax;
+		if( dist < DRV_PROF_DIST_MAX )
+		{
+			/* braking from v by a per sample covers v^2/(2a), so the speed v' at the end of this
+			 * sample has to satisfy v'^2 <= 2a * (d - (v + v')/2) */
+			disc = acc * acc + 4 * acc * ( 2 * dist - spd );
+			lim  = ( disc > acc * acc ) ? ( ( (int64_t)MTX_ISqrt((uint64_t)disc) - acc ) >> 1 ) : 0;
+			lim  = ( lim > (int64_t)pProf_->spdMax ) ? (int64_t)pProf_->spdMax : lim;
+		}
+		spdNew = ( lim > spd + acc ) ? ( spd + acc ) : ( ( lim < spd - acc ) ? ( spd - acc ) : lim );
+		incr   = (int32_t)( ( ( spd + spdNew ) >> 1 ) * dir );
+		pProf_->trapPos += incr;
+		pProf_->trapSpd  = (int32_t)( spdNew * dir );
+	}
+
+	/* moving average of the position increments */
+	pProf_->winSum += (int64_t)incr - (int64_t)pProf_->aWinIncr[pProf_->winIdx];
+	pProf_->aWinIncr[pProf_->winIdx] = incr;
+	pProf_->winIdx  = ( pProf_->winIdx + 1u < pProf_->winLen ) ? pProf_->winIdx + 1u : 0u;
+	if( 0 != incr )
+	{
+		pProf_->idleCnt = 0u;
+	}
+	else if( pProf_->idleCnt < pProf_->winLen )
+	{
+		pProf_->idleCnt++;
+	}
+
+	if( ( pProf_->idleCnt >= pProf_->winLen ) && ( pProf_->trapPos == pProf_->trgtPos ) )
+	{
+		/* the window is empty, the rounding errors of the average are removed at the target */
+		pProf_->pos    = pProf_->trgtPos;
+		pProf_->spd    = 0;
+		pProf_->isDone = TRUE;
+	}
+	else
+	{
+		pProf_->spd    = (int32_t)( ( pProf_->winSum * pProf_->winRecip ) >> 32 );
+		pProf_->pos   += pProf_->spd;
+		pProf_->isDone = FALSE;
+	}
+}
+
+int32_t DRV_Prof_Get_Pos(const DRV_Prof_t *pProf_)
+{
+	return (int32_t)( ( pProf_->pos + ( (int64_t)1 << 15 ) ) >> 16 );
+}
+
+int32_t DRV_Prof_Get_Spd(const DRV_Prof_t *pProf_)
+{
+	return (int32_t)( ( (int64_t)pProf_->spd * 1000 / DRV_SMPL_TIME_MS ) >> 16 );
+}
+
+bool DRV_Prof_Is_Done(const DRV_Prof_t *pProf_)
+{
+	return pProf_->isDone;
+}
+
+
+
+#ifdef MASTER_drv_prof_C_
+#undef MASTER_drv_prof_C_
+#endif /* !MASTER_drv_prof_C_ */
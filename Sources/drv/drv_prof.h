@@ -0,0 +1,117 @@
+/***********************************************************************************************//**
+ * @file		drv_prof.h
+ * @ingroup		drv
+ * @brief 		Interface of the motion profile generator of the SWC @ref drv
+ *
+ * This header file provides the internal interface of the motion profile generator, which
+ * generates the position and speed references of the position loops. It depends on the
+ * configured limits only, so the same profiles are generated on the target and on the host.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @note Interface for BSW-specific use only
+ *
+ * @copyright 	@LGPL2_1
+ *
+ **************************************************************************************************/
+
+#ifndef DRV_PROF_H_
+#define DRV_PROF_H_
+
+/*======================================= >> #INCLUDES << ========================================*/
+#include "Platform.h"
+#include "ACon_Types.h"
+#include "drv_cfg.h"
+
+
+#ifdef MASTER_drv_prof_C_
+#define EXTERNAL_
+#else
+#define EXTERNAL_ extern
+#endif
+
+/**
+ * @addtogroup drv
+ * @{
+ */
+/*======================================= >> #DEFINES << =========================================*/
+/**
+ * @brief Maximum number of samples of the averaging window of the S-curve profile
+ */
+#define DRV_PROF_WIN_MAX		(32u)
+
+
+
+/*=================================== >> TYPE DEFINITIONS << =====================================*/
+/**
+ * @brief Runtime data of the profile of one wheel. Positions are in steps as Q47.16, speeds in
+ * steps per sample as Q15.16 and accelerations in steps per sample^2 as Q15.16.
+ */
+typedef struct DRV_Prof_s
+{
+	int64_t trgtPos;		/**< target position */
+	int64_t trapPos;		/**< position of the trapezoidal profile */
+	int32_t trapSpd;		/**< speed of the trapezoidal profile */
+	int64_t pos;			/**< position reference */
+	int32_t spd;			/**< speed reference */
+	int32_t spdMax;			/**< speed limit */
+	int32_t accMax;			/**< acceleration limit */
+	int64_t winRecip;		/**< 2^32 divided by the number of samples of the averaging window */
+	int64_t winSum;			/**< sum of the position increments within the averaging window */
+	int32_t aWinIncr[DRV_PROF_WIN_MAX];	/**< position increments of the trapezoidal profile */
+	uint8_t winLen;			/**< number of samples of the averaging window, 1 for the trapezoidal profile */
+	uint8_t winIdx;			/**< index of the oldest position increment */
+	uint8_t idleCnt;		/**< number of consecutive samples without position increment */
+	bool isDone;			/**< the position reference has reached the target */
+}DRV_Prof_t;
+
+
+
+/*============================ >> GLOBAL FUNCTION DECLARATIONS << ================================*/
+/**
+ * @brief Starts a profile at the current state of a wheel, the target is the current position
+ * @param pProf_ Runtime data of the profile
+ * @param pCfg_  Configuration with the limits and the type of the profile
+ * @param pos_   Current position in steps
+ * @param spd_   Current speed in steps/sec
+ */
+EXTERNAL_ void DRV_Prof_Init(DRV_Prof_t *pProf_, const DRV_Cfg_t *pCfg_, int32_t pos_, int32_t spd_);
+
+/**
+ * @brief Sets the target position, a running profile is replanned from its current state
+ * @param pProf_ Runtime data of the profile
+ * @param trgt_  Target position in steps
+ */
+EXTERNAL_ void DRV_Prof_Set_Trgt(DRV_Prof_t *pProf_, int32_t trgt_);
+
+/**
+ * @brief Advances the profile by one sample
+ * @param pProf_ Runtime data of the profile
+ */
+EXTERNAL_ void DRV_Prof_Step(DRV_Prof_t *pProf_);
+
+/**
+ * @brief Returns the position reference in steps, rounded
+ */
+EXTERNAL_ int32_t DRV_Prof_Get_Pos(const DRV_Prof_t *pProf_);
+
+/**
+ * @brief Returns the speed reference in steps/sec
+ */
+EXTERNAL_ int32_t DRV_Prof_Get_Spd(const DRV_Prof_t *pProf_);
+
+/**
+ * @brief Returns TRUE if the position reference has reached the target and stands still
+ */
+EXTERNAL_ bool DRV_Prof_Is_Done(const DRV_Prof_t *pProf_);
+
+
+/**
+ * @}
+ */
+#ifdef EXTERNAL_
+#undef EXTERNAL_
+#endif
+
+#endif /* !DRV_PROF_H_ */
@@ -0,0 +1,220 @@
+/***********************************************************************************************//**
+ * @file		drv_trac.c
+ * @ingroup		drv
+ * @brief 		Implementation of the slip and stall detection of the SWC @ref drv
+ *
+ * This module detects the traction state of each wheel from the mismatch between the motor value
+ * and the motion of the wheel. The motor value, which has been applied since the last call, is
+ * compared with the feedforward motor model of the speed loops at the measured speed and
+ * acceleration of the wheel:
+ * > - A wheel slips if it accelerates in the direction of the motor value and the model requires a
+ * >   considerably larger motor value than the applied one, i.e. the wheel has lost the load of the
+ * >   robot.
+ * > - A wheel stalls if it stands still despite a high motor value.
+ * Both conditions have to hold for the configured number of calls. The state is released after the
+ * configured number of calls without either condition.\n
+ * A slipping wheel is limited below the motor value at the onset of slip, so the tyre can grip
+ * again. A stalled wheel isn't limited, as it is pushing. The integral part of the speed loop can
+ * be frozen in both states, so it doesn't wind up.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#define MASTER_drv_trac_C_
+
+/*======================================= >> #INCLUDES << ========================================*/
+#include "drv_trac.h"
+#include "drv_cfg.h"
+#include "tacho_api.h"
+#include "mot.h"
+#include "mot_api.h"
+
+
+
+/*======================================= >> #DEFINES << =========================================*/
+/**
+ * @brief Maximum motor value
+ */
+#define DRV_TRAC_CTRL_MAX	(0xFFFF)
+
+
+
+/*=================================== >> TYPE DEFINITIONS << =====================================*/
+typedef struct DRV_TracWhl_s
+{
+	DRV_Trac_t trac;		/* traction state */
+	int32_t prevSpd;		/* speed of the last call */
+	uint16_t slipCntr;		/* calls with the slip condition */
+	uint16_t stallCntr;		/* calls with the stall condition */
+	uint16_t rlsCntr;		/* calls without either condition */
+	int32_t ctrlMax;		/* limit of the absolute motor value */
+} DRV_TracWhl_t;
+
+
+
+/*============================= >> LOKAL FUNCTION DECLARATIONS << ================================*/
+static int32_t DRV_Trac_Read_CtrlVal(MOT_MotorSide_t side_);
+static int32_t DRV_Trac_Calc_MdlVal(int32_t spd_, int32_t acc_);
+static void DRV_Trac_Upd_Whl(DRV_TracWhl_t *pWhl_, int32_t ctrlVal_, int32_t spd_);
+
+
+
+/*=================================== >> GLOBAL VARIABLES << =====================================*/
+static DRV_TracWhl_t DRV_TracWhl[TACHO_ID_CNT];
+
+
+
+/*============================== >> LOKAL FUNCTION DEFINITIONS << ================================*/
+/**
+ * @brief Returns the signed motor value of a motor
+ */
+static int32_t DRV_Trac_Read_CtrlVal(MOT_MotorSide_t side_)
+{
+	MOT_MotorDevice_t *motHandle = MOT_GetMotorHandle(side_);
+	int32_t ctrlVal = 0;
+
+	if(NULL != motHandle)
+	{
+		ctrlVal = DRV_TRAC_CTRL_MAX - (int32_t)MOT_GetVal(motHandle); /* PWM is low active */
+		ctrlVal = ( MOT_DIR_BACKWARD == MOT_GetDirection(motHandle) ) ? -ctrlVal : ctrlVal;
+	}
+	return ctrlVal;
+}
+
+/**
+ * @brief Returns the motor value of the feedforward motor model at the speed spd_ and the change of
+ * the speed per call acc_
+ */
+static int32_t DRV_Trac_Calc_MdlVal(int32_t spd_, int32_t acc_)
+{
+	const DRV_Cfg_t *pCfg = Get_pDrvCfg();
+	int32_t mdlVal = (int32_t)( ( (int64_t)spd_ * pCfg->ffGain + (int64_t)acc_ * pCfg->ffAccGain ) >> 16 );
+
+	if( spd_ > 0 )
+	{
+		mdlVal += pCfg->ffOffset;
+	}
+	else if( spd_ < 0 )
+	{
+		mdlVal -= pCfg->ffOffset;
+	}
+	return mdlVal;
+}
+
+/**
+ * @brief Updates the traction state of a wheel from the applied motor value and its speed
+ */
+static void DRV_Trac_Upd_Whl(DRV_TracWhl_t *pWhl_, int32_t ctrlVal_, int32_t spd_)
+{
+	const DRV_Cfg_t *pCfg = Get_pDrvCfg();
+	int32_t dir = ( ctrlVal_ < 0 ) ? -1 : 1;
+	int32_t acc = spd_ - pWhl_->prevSpd;
+	int32_t resid = ( ctrlVal_ - DRV_Trac_Calc_MdlVal(spd_, acc) ) * dir;
+	bool isSlip  = ( ( resid < -pCfg->slipResid ) && ( acc * dir > 0 ) ) ? TRUE : FALSE;
+	bool isStall = ( ( ctrlVal_ * dir >= pCfg->stallCtrlMin ) && ( spd_ <= pCfg->stallSpd )
+			&& ( spd_ >= -pCfg->stallSpd ) ) ? TRUE : FALSE;
+
+	pWhl_->prevSpd   = spd_;
+	pWhl_->slipCntr  = ( TRUE == isSlip ) ? ( ( pWhl_->slipCntr < pCfg->slipCnt ) ? pWhl_->slipCntr + 1u : pWhl_->slipCntr ) : 0u;
+	pWhl_->stallCntr = ( TRUE == isStall ) ? ( ( pWhl_->stallCntr < pCfg->stallCnt ) ? pWhl_->stallCntr + 1u : pWhl_->stallCntr ) : 0u;
+
+	if( pWhl_->stallCntr >= pCfg->stallCnt )
+	{
+		pWhl_->trac    = DRV_TRAC_STALL;
+		pWhl_->ctrlMax = DRV_TRAC_CTRL_MAX;
+		pWhl_->rlsCntr = 0u;
+	}
+	else if( pWhl_->slipCntr >= pCfg->slipCnt )
+	{
+		if( DRV_TRAC_SLIP != pWhl_->trac )
+		{
+			/* the tyre has broken away at the current motor value */
+			pWhl_->ctrlMax = ctrlVal_ * dir - pCfg->slipCtrlRed;
+			pWhl_->ctrlMax = ( pWhl_->ctrlMax < 0 ) ? 0 : pWhl_->ctrlMax;
+		}
+		pWhl_->trac    = DRV_TRAC_SLIP;
+		pWhl_->rlsCntr = 0u;
+	}
+	else if( DRV_TRAC_OK != pWhl_->trac )
+	{
+		if( ( FALSE == isSlip ) && ( FALSE == isStall ) )
+		{
+			pWhl_->rlsCntr++;
+		}
+		if( pWhl_->rlsCntr >= pCfg->tracRlsCnt )
+		{
+			pWhl_->trac    = DRV_TRAC_OK;
+			pWhl_->ctrlMax = DRV_TRAC_CTRL_MAX;
+			pWhl_->rlsCntr = 0u;
+		}
+	}
+	else
+	{
+		/* traction is fine */
+	}
+}
+
+
+
+/*============================= >> GLOBAL FUNCTION DEFINITIONS << ================================*/
+void DRV_Trac_Init(void)
+{
+	int16_t i16Spd = 0;
+	uint8_t i = 0u;
+
+	for(i = 0u; i < TACHO_ID_CNT; i++)
+	{
+		(void)( ( TACHO_ID_LEFT == i ) ? TACHO_Read_SpdLe(&i16Spd) : TACHO_Read_SpdRi(&i16Spd) );
+		DRV_TracWhl[i].trac      = DRV_TRAC_OK;
+		DRV_TracWhl[i].prevSpd   = (int32_t)i16Spd;
+		DRV_TracWhl[i].slipCntr  = 0u;
+		DRV_TracWhl[i].stallCntr = 0u;
+		DRV_TracWhl[i].rlsCntr   = 0u;
+		DRV_TracWhl[i].ctrlMax   = DRV_TRAC_CTRL_MAX;
+	}
+}
+
+void DRV_Trac_Step(void)
+{
+	int16_t i16Spd = 0;
+
+	(void)TACHO_Read_SpdLe(&i16Spd);
+	DRV_Trac_Upd_Whl(&DRV_TracWhl[TACHO_ID_LEFT], DRV_Trac_Read_CtrlVal(MOT_MOTOR_LEFT), (int32_t)i16Spd);
+	(void)TACHO_Read_SpdRi(&i16Spd);
+	DRV_Trac_Upd_Whl(&DRV_TracWhl[TACHO_ID_RIGHT], DRV_Trac_Read_CtrlVal(MOT_MOTOR_RIGHT), (int32_t)i16Spd);
+}
+
+bool DRV_Trac_Is_IntHold(uint8_t id_)
+{
+	return ( ( id_ < TACHO_ID_CNT ) && ( DRV_TRAC_OK != DRV_TracWhl[id_].trac )
+			&& ( 0u != ( Get_pDrvCfg()->tracRct & DRV_TRAC_RCT_INT_HOLD ) ) ) ? TRUE : FALSE;
+}
+
+int32_t DRV_Trac_Get_CtrlMax(uint8_t id_)
+{
+	return ( ( id_ < TACHO_ID_CNT ) && ( 0u != ( Get_pDrvCfg()->tracRct & DRV_TRAC_RCT_TRQ_LIM ) ) )
+			? DRV_TracWhl[id_].ctrlMax : DRV_TRAC_CTRL_MAX;
+}
+
+StdRtn_t DRV_Read_Trac(DRV_Trac_t *pTracLe_, DRV_Trac_t *pTracRi_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+
+	if( ( NULL != pTracLe_ ) && ( NULL != pTracRi_ ) )
+	{
+		*pTracLe_ = DRV_TracWhl[TACHO_ID_LEFT].trac;
+		*pTracRi_ = DRV_TracWhl[TACHO_ID_RIGHT].trac;
+		retVal    = ERR_OK;
+	}
+	return retVal;
+}
+
+
+
+#ifdef MASTER_drv_trac_C_
+#undef MASTER_drv_trac_C_
+#endif /* !MASTER_drv_trac_C_ */
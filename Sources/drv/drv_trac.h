@@ -0,0 +1,80 @@
+/***********************************************************************************************//**
+ * @file		drv_trac.h
+ * @ingroup		drv
+ * @brief 		Interface of the slip and stall detection of the SWC @ref drv
+ *
+ * This header file provides the internal interface of the detection of the traction state of
+ * both wheels and of the reactions of the speed loops to slip and stall.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @note Interface for BSW-specific use only
+ *
+ * @copyright 	@LGPL2_1
+ *
+ **************************************************************************************************/
+
+#ifndef DRV_TRAC_H_
+#define DRV_TRAC_H_
+
+/*======================================= >> #INCLUDES << ========================================*/
+#include "Platform.h"
+#include "ACon_Types.h"
+#include "drv_api.h"
+
+
+#ifdef MASTER_drv_trac_C_
+#define EXTERNAL_
+#else
+#define EXTERNAL_ extern
+#endif
+
+/**
+ * @addtogroup drv
+ * @{
+ */
+/*======================================= >> #DEFINES << =========================================*/
+
+
+
+/*=================================== >> TYPE DEFINITIONS << =====================================*/
+
+
+
+/*============================ >> GLOBAL FUNCTION DECLARATIONS << ================================*/
+/**
+ * @brief Resets the traction state of both wheels to @ref DRV_TRAC_OK at their current speed
+ */
+EXTERNAL_ void DRV_Trac_Init(void);
+
+/**
+ * @brief Updates the traction state of both wheels. It compares the motor values, which have
+ * been applied since the last call, with the measured speed and acceleration of the wheels, hence
+ * it has to be called once per cycle before the speed loops set the motors.
+ */
+EXTERNAL_ void DRV_Trac_Step(void);
+
+/**
+ * @brief Returns whether the integral part of the speed loop of a wheel has to be frozen
+ * @param id_ wheel, TACHO_ID_LEFT or TACHO_ID_RIGHT
+ * @return TRUE if the wheel slips or stalls and the reaction is configured
+ */
+EXTERNAL_ bool DRV_Trac_Is_IntHold(uint8_t id_);
+
+/**
+ * @brief Returns the limit of the motor value of a wheel
+ * @param id_ wheel, TACHO_ID_LEFT or TACHO_ID_RIGHT
+ * @return limit of the absolute motor value, 0xFFFF if the motor isn't limited
+ */
+EXTERNAL_ int32_t DRV_Trac_Get_CtrlMax(uint8_t id_);
+
+
+/**
+ * @}
+ */
+#ifdef EXTERNAL_
+#undef EXTERNAL_
+#endif
+
+#endif /* !DRV_TRAC_H_ */
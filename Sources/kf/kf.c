@@ -24,7 +24,6 @@
 #include "kf.h"
 #include "kf_cfg.h"
 #include "kf_api.h"
-#include "fixarray.h" /* dot product in Bierman update */
 
 
 /*======================================= >> #DEFINES << =========================================*/
@@ -35,13 +34,13 @@
 
 /*============================= >> LOKAL FUNCTION DECLARATIONS << ================================*/
 static void KF_Reset(KF_Itm_t *kf_);
-int64_t KF_48d16Dot(const fix16_t *a, uint_fast8_t a_stride, const fix16_t *b, uint_fast8_t b_stride, uint_fast8_t n);
+static void KF_Restart(KF_Itm_t *kf_, int32_t dym_, uint8_t m_);
 static StdRtn_t KF_UpdateModuloCounter(KF_Data_t *data_);
 static StdRtn_t KF_Predict_x(KF_Itm_t *kf_);
-static StdRtn_t KF_Predict_P(KF_Itm_t *kf_);
+static StdRtn_t KF_Predict_P(KF_Itm_t *kf_, fix16_t *aScr_, uint16_t numScr_);
 static StdRtn_t KF_Correct(KF_Itm_t *kf_);
-static StdRtn_t KF_ThorntonTemporalUpdate(MTX_t *mUPapri_, MTX_t *mDPapri_, const MTX_t *Phi_, const MTX_t *mUPapost_, const MTX_t *mDPapost_, MTX_t *mGUQ_, const MTX_t *mDQ_);
-static StdRtn_t KF_BiermanObservationalUpdate(MTX_t *vXapost_, MTX_t *mUPapost_, MTX_t *mDPapost_, int32_t dym_, int32_t rmm_, const MTX_t *mH_, uint8_t m_);
+static StdRtn_t KF_ThorntonTemporalUpdate(MTX_t *mUPapri_, MTX_t *mDPapri_, const MTX_t *Phi_, const MTX_t *mUPapost_, const MTX_t *mDPapost_, MTX_t *mGUQ_, const MTX_t *mDQ_, MTX_t *mTmp_);
+static StdRtn_t KF_BiermanObservationalUpdate(MTX_t *vXapost_, MTX_t *mUPapost_, MTX_t *mDPapost_, int32_t dym_, int32_t rmm_, const MTX_t *mH_, uint8_t m_, fix16_t nisThld_);
 
 
 /*=================================== >> GLOBAL VARIABLES << =====================================*/
@@ -68,36 +67,25 @@ static void KF_Reset(KF_Itm_t *kf_)
 	}
 }
 
-/* same as fa16_dot but without overflow detection and returns a Q48.16 variable */
-int64_t KF_48d16Dot(const fix16_t *a, uint_fast8_t a_stride,
-                 const fix16_t *b, uint_fast8_t b_stride,
-                 uint_fast8_t n)
+static void KF_Restart(KF_Itm_t *kf_, int32_t dym_, uint8_t m_)
 {
-    int64_t sum = 0;
-
-    while (n--)
-    {
-        if (*a != 0 && *b != 0)
-        {
-            sum += (int64_t)(*a) * (*b);
-        }
-
-        // Go to next item
-        a += a_stride;
-        b += b_stride;
-    }
-    if (sum < 0)
-    {
-        #ifndef FIXMATH_NO_ROUNDING
-        // This adjustment is required in order to round -1/2 correctly
-        sum--;
-        #endif
-    }
-    sum = (sum >> 16);
-    #ifndef FIXMATH_NO_ROUNDING
-    sum += (sum & 0x8000) >> 15;
-    #endif
-    return sum;
+	uint8_t i = 0u;
+	fix16_t hh = 0;
+	if(NULL != kf_)
+	{
+		/* moves the estimate onto the measurement along h_m' and reinflates P to its initial value */
+		hh = MTX_Dot(&MTX_AT(&kf_->cfg.mtx.mH, m_, 0), 1, &MTX_AT(&kf_->cfg.mtx.mH, m_, 0), 1, kf_->cfg.mtx.mH.columns);
+		if( (0 < hh) && (fix16_overflow != hh) )
+		{
+			for(i = 0u; i < kf_->data.vXapost.rows; i++)
+			{
+				MTX_AT(&kf_->data.vXapost, i, 0) = fix16_add(MTX_AT(&kf_->data.vXapost, i, 0),
+															 fix16_mul(fix16_div(MTX_AT(&kf_->cfg.mtx.mH, m_, i), hh), dym_));
+			}
+		}
+		MTX_FillDiagonal( &(kf_->data.mUPapost), fix16_one );
+		MTX_FillDiagonal( &(kf_->data.mDPapost), fix16_from_int(KF_DFLT_ALPHA) );
+	}
 }
 
 static StdRtn_t KF_UpdateModuloCounter(KF_Data_t *data_)
@@ -109,14 +97,14 @@ static StdRtn_t KF_UpdateModuloCounter(KF_Data_t *data_)
 		retVal = ERR_OK;
 		for(i = 0u; i < data_->vXapost.rows; i++)
 		{
-			if( (int32_t)(KF_DFLT_MAX_MOD_VAL<<16) <= data_->vXapost.data[i][0] )
+			if( (int32_t)(KF_DFLT_MAX_MOD_VAL<<16) <= MTX_AT(&data_->vXapost, i, 0) )
 			{
-				data_->vXapost.data[i][0] %= KF_DFLT_MAX_MOD_VAL;
+				MTX_AT(&data_->vXapost, i, 0) %= KF_DFLT_MAX_MOD_VAL;
 				data_->aModCntr[i]++;
 			}
-			else if( -(int32_t)(KF_DFLT_MAX_MOD_VAL<<16) >= data_->vXapost.data[i][0] )
+			else if( -(int32_t)(KF_DFLT_MAX_MOD_VAL<<16) >= MTX_AT(&data_->vXapost, i, 0) )
 			{
-				data_->vXapost.data[i][0] %= KF_DFLT_MAX_MOD_VAL;
+				MTX_AT(&data_->vXapost, i, 0) %= KF_DFLT_MAX_MOD_VAL;
 				data_->aModCntr[i]--;
 			}
 		}
@@ -128,115 +116,141 @@ static StdRtn_t KF_Predict_x(KF_Itm_t *kf_)
 {
 	StdRtn_t retVal = ERR_PARAM_ADDRESS;
 	uint8_t l = 0;
-	MTX_t vU = {kf_->cfg.mtx.mGamma.columns, 1, 0, {0u}};
 	if(NULL != kf_)
 	{
 		retVal = ERR_OK;
 		MTX_Mult(&(kf_->data.vXapri), &(kf_->cfg.mtx.mPhi), &(kf_->data.vXapost));
-		if( (NULL != kf_->cfg.aInptValFct) && (0 != kf_->cfg.mtx.mGamma.columns) )
+		if( (NULL != kf_->cfg.aInptValFct) && (0 != kf_->cfg.mtx.mGamma.columns) && (NULL != kf_->data.vU.data) )
 		{
 			for(l = 0u; l < kf_->cfg.mtx.mGamma.columns; l++)
 			{
-				kf_->cfg.aInptValFct[l](&vU.data[l][0]);
-				vU.data[l][0] = fix16_from_int(vU.data[l][0]);
+				kf_->cfg.aInptValFct[l](&MTX_AT(&kf_->data.vU, l, 0));
+				MTX_AT(&kf_->data.vU, l, 0) = fix16_from_int(MTX_AT(&kf_->data.vU, l, 0));
 			}
-			MTX_Mult(&(kf_->data.vXapost), &(kf_->cfg.mtx.mGamma), &(vU));
+			MTX_Mult(&(kf_->data.vXapost), &(kf_->cfg.mtx.mGamma), &(kf_->data.vU));
 			MTX_Add(&(kf_->data.vXapri), &(kf_->data.vXapri), &(kf_->data.vXapost));
 		}
 	}
 	return retVal;
 }
 
-static StdRtn_t KF_Predict_P(KF_Itm_t *kf_)
+static StdRtn_t KF_Predict_P(KF_Itm_t *kf_, fix16_t *aScr_, uint16_t numScr_)
 {
 	StdRtn_t retVal = ERR_PARAM_ADDRESS;
-	MTX_t mG = kf_->cfg.mtx.mG; /* necessary because G is overwritten in thornton update */
-	if( NULL != kf_ )
+	uint8_t n = 0u;
+	MTX_t mGUQ, mTmp;
+	if( (NULL != kf_) && (NULL != aScr_) )
 	{
-		retVal  = ERR_OK;
-		retVal |= KF_ThorntonTemporalUpdate(&(kf_->data.mUPapri),  &(kf_->data.mDPapri),  &(kf_->cfg.mtx.mPhi),
-											&(kf_->data.mUPapost), &(kf_->data.mDPapost), &(mG), &(kf_->cfg.mtx.mQ));
+		n = kf_->data.vXapost.rows;
+		retVal = ERR_PARAM_RANGE;
+		if( (2u*n*n) <= numScr_ )
+		{
+			/* n x n views on the scratch shared by all filters */
+			mGUQ = (MTX_t)MTX_VIEW_INIT(n, n, &aScr_[0]);
+			mTmp = (MTX_t)MTX_VIEW_INIT(n, n, &aScr_[n*n]);
+			retVal  = ERR_OK;
+			MTX_Copy(&mGUQ, &(kf_->cfg.mtx.mG)); /* necessary because G is overwritten in thornton update */
+			retVal |= KF_ThorntonTemporalUpdate(&(kf_->data.mUPapri),  &(kf_->data.mDPapri),  &(kf_->cfg.mtx.mPhi),
+												&(kf_->data.mUPapost), &(kf_->data.mDPapost), &mGUQ, &(kf_->cfg.mtx.mQ),
+												&mTmp);
+		}
 	}
 	return retVal;
 }
 
 static StdRtn_t KF_Correct(KF_Itm_t *kf_)
 {
-	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+	StdRtn_t retVal = ERR_PARAM_ADDRESS, rtnVal = ERR_OK;
 	uint8_t m = 0u;
 	int32_t dy = 0, ym = 0;
 	int64_t ymHat = 0;
 	if( (NULL != kf_) && (NULL != kf_->cfg.aMeasValFct) )
 	{
 		retVal             = ERR_OK;
-		kf_->data.vXapost  = kf_->data.vXapri;
-		kf_->data.mUPapost = kf_->data.mUPapri;
-		kf_->data.mDPapost = kf_->data.mDPapri;
+		MTX_Copy(&(kf_->data.vXapost),  &(kf_->data.vXapri));
+		MTX_Copy(&(kf_->data.mUPapost), &(kf_->data.mUPapri));
+		MTX_Copy(&(kf_->data.mDPapost), &(kf_->data.mDPapri));
 		for(m = 0; m < kf_->cfg.mtx.mH.rows; m++)
 		{
 			kf_->cfg.aMeasValFct[m](&ym);
 			if(TRUE == kf_->cfg.bModCntrFlag)
 			{
-				ymHat  = KF_48d16Dot( &(kf_->cfg.mtx.mH.data[m][0]), 1, &(kf_->data.vXapost.data[0][0]), FIXMATRIX_MAX_SIZE, kf_->data.vXapost.rows);
-				ymHat += (int64_t)( KF_48d16Dot(&(kf_->cfg.mtx.mH.data[m][0]), 1, kf_->data.aModCntr, 1, kf_->data.vXapost.rows) * (KF_DFLT_MAX_MOD_VAL<<16) );
+				ymHat  = MTX_Dot48d16( &MTX_AT(&kf_->cfg.mtx.mH, m, 0), 1, &MTX_AT(&kf_->data.vXapost, 0, 0), kf_->data.vXapost.stride, kf_->data.vXapost.rows);
+				ymHat += (int64_t)( MTX_Dot48d16(&MTX_AT(&kf_->cfg.mtx.mH, m, 0), 1, kf_->data.aModCntr, 1, kf_->data.vXapost.rows) * (KF_DFLT_MAX_MOD_VAL<<16) );
 				dy = (int32_t)( (((int64_t)ym)<<16) - ymHat );
 			}
 			else
 			{
 				ym <<= 16;
-				dy = fix16_sub(ym, fa16_dot( &(kf_->cfg.mtx.mH.data[m][0]), 1, &(kf_->data.vXapost.data[0][0]), FIXMATRIX_MAX_SIZE, kf_->data.vXapost.rows) );
+				dy = fix16_sub(ym, MTX_Dot( &MTX_AT(&kf_->cfg.mtx.mH, m, 0), 1, &MTX_AT(&kf_->data.vXapost, 0, 0), kf_->data.vXapost.stride, kf_->data.vXapost.rows) );
+			}
+			rtnVal = KF_BiermanObservationalUpdate(&(kf_->data.vXapost), &(kf_->data.mUPapost), &(kf_->data.mDPapost),
+													dy, MTX_AT(&kf_->cfg.mtx.mR, m, m), &(kf_->cfg.mtx.mH), m, kf_->cfg.nisThld);
+			if(ERR_RANGE == rtnVal)
+			{
+				kf_->data.nRejCntr++; /* outlier, estimate keeps the a priori value for this measurement */
+				kf_->data.aRejSeqCntr[m]++;
+				if(KF_DFLT_MAX_REJ_SEQ <= kf_->data.aRejSeqCntr[m])
+				{
+					/* no outlier but a true step which the gate would reject forever */
+					KF_Restart(kf_, dy, m);
+					kf_->data.aRejSeqCntr[m] = 0u;
+				}
+			}
+			else
+			{
+				kf_->data.aRejSeqCntr[m] = 0u;
+				retVal |= rtnVal;
 			}
-			retVal |= KF_BiermanObservationalUpdate(&(kf_->data.vXapost), &(kf_->data.mUPapost), &(kf_->data.mDPapost),
-													dy, kf_->cfg.mtx.mR.data[m][m], &(kf_->cfg.mtx.mH), m);
 		}
 	}
+	return retVal;
 }
 
-static StdRtn_t KF_ThorntonTemporalUpdate(MTX_t *mUPapri_, MTX_t *mDPapri_, const MTX_t *Phi_, const MTX_t *mUPapost_, const MTX_t *mDPapost_, MTX_t *mGUQ_, const MTX_t *mDQ_)
+static StdRtn_t KF_ThorntonTemporalUpdate(MTX_t *mUPapri_, MTX_t *mDPapri_, const MTX_t *Phi_, const MTX_t *mUPapost_, const MTX_t *mDPapost_, MTX_t *mGUQ_, const MTX_t *mDQ_, MTX_t *mTmp_)
 {
 	StdRtn_t retVal = ERR_PARAM_ADDRESS;
 	int8_t  i = 0;
 	uint8_t j = 0u, k = 0u, dim = 0u;
-	MTX_t tmp = {0};
 	int32_t sigma = 0;
 
-	if( (NULL != mUPapri_) && (NULL != mDPapri_) && (NULL != mGUQ_) )
+	if( (NULL != mUPapri_) && (NULL != mDPapri_) && (NULL != mGUQ_) && (NULL != mTmp_) )
 	{
 		retVal = ERR_OK;
 		dim = Phi_->rows;
-		MTX_Mult(&tmp, Phi_, mUPapost_); /* tmp = PhiU */
+		MTX_Mult(mTmp_, Phi_, mUPapost_); /* tmp = PhiU */
 		for(i = (dim-1); i >= 0; i--)
 		{
 			sigma = 0;
 			for(j = 0; j < dim; j++)
 			{
-				sigma = fix16_add(sigma, fix16_mul(fix16_sq(tmp.data[i][j]), mDPapost_->data[j][j]));
+				sigma = fix16_add(sigma, fix16_mul(fix16_sq(MTX_AT(mTmp_, i, j)), MTX_AT(mDPapost_, j, j)));
 				if(j <= (dim-1))
 				{
-					sigma = fix16_add(sigma, fix16_mul(fix16_sq(mGUQ_->data[i][j]), mDQ_->data[j][j]));
+					sigma = fix16_add(sigma, fix16_mul(fix16_sq(MTX_AT(mGUQ_, i, j)), MTX_AT(mDQ_, j, j)));
 				}
 			}
-			mDPapri_->data[i][i] = sigma;
-			mUPapri_->data[i][i] = fix16_one;
+			MTX_AT(mDPapri_, i, i) = sigma;
+			MTX_AT(mUPapri_, i, i) = fix16_one;
 			for(j = 0; j <= (i-1); j++)
 			{
 				sigma = 0;
 				for(k = 0; k < (dim); k++)
 				{
-					sigma = fix16_add(sigma, fix16_mul(tmp.data[i][k], fix16_mul(mDPapost_->data[k][k], tmp.data[j][k])));
+					sigma = fix16_add(sigma, fix16_mul(MTX_AT(mTmp_, i, k), fix16_mul(MTX_AT(mDPapost_, k, k), MTX_AT(mTmp_, j, k))));
 				}
 				for(k = 0; k < (dim); k++)
 				{
-					sigma = fix16_add(sigma, fix16_mul(mGUQ_->data[i][k], fix16_mul(mDQ_->data[k][k], mGUQ_->data[j][k])));
+					sigma = fix16_add(sigma, fix16_mul(MTX_AT(mGUQ_, i, k), fix16_mul(MTX_AT(mDQ_, k, k), MTX_AT(mGUQ_, j, k))));
 				}
-				mUPapri_->data[j][i] = fix16_div(sigma, mDPapri_->data[i][i]);
+				MTX_AT(mUPapri_, j, i) = fix16_div(sigma, MTX_AT(mDPapri_, i, i));
 				for(k = 0; k < (dim); k++)
 				{
-					tmp.data[j][k] = fix16_sub(tmp.data[j][k], fix16_mul(mUPapri_->data[j][i], tmp.data[i][k]));
+					MTX_AT(mTmp_, j, k) = fix16_sub(MTX_AT(mTmp_, j, k), fix16_mul(MTX_AT(mUPapri_, j, i), MTX_AT(mTmp_, i, k)));
 				}
 				for(k = 0; k < (dim); k++)
 				{
-					mGUQ_->data[j][k] = fix16_sub(mGUQ_->data[j][k], fix16_mul(mUPapri_->data[j][i], mGUQ_->data[i][k]));
+					MTX_AT(mGUQ_, j, k) = fix16_sub(MTX_AT(mGUQ_, j, k), fix16_mul(MTX_AT(mUPapri_, j, i), MTX_AT(mGUQ_, i, k)));
 				}
 			}
 		}
@@ -244,11 +258,12 @@ static StdRtn_t KF_ThorntonTemporalUpdate(MTX_t *mUPapri_, MTX_t *mDPapri_, cons
 	return retVal;
 }
 
-static StdRtn_t KF_BiermanObservationalUpdate(MTX_t *vXapost_, MTX_t *mUPapost_, MTX_t *mDPapost_, int32_t dym_, int32_t rmm_, const MTX_t *mH_, uint8_t m_)
+static StdRtn_t KF_BiermanObservationalUpdate(MTX_t *vXapost_, MTX_t *mUPapost_, MTX_t *mDPapost_, int32_t dym_, int32_t rmm_, const MTX_t *mH_, uint8_t m_, fix16_t nisThld_)
 {
 	StdRtn_t retVal = ERR_PARAM_ADDRESS;
 	uint8_t i = 0u, j = 0u;
 	int32_t alpha = 0, beta = 0, gamma = 0, gammaOld = 0, tmp = 0;
+	int64_t innVar = 0;
 	bool overFlowFlag = FALSE;
 	int32_t a[vXapost_->rows], b[vXapost_->rows];
 
@@ -258,56 +273,65 @@ static StdRtn_t KF_BiermanObservationalUpdate(MTX_t *vXapost_, MTX_t *mUPapost_,
 		/* a = U'h_m', b = Da can be in this loop because D is a diagonal matrix */
 		for(i = 0u; i < mUPapost_->rows; i++)
 		{
-			a[i] = fa16_dot(&(mUPapost_->data[0][i]), FIXMATRIX_MAX_SIZE, &(mH_->data[m_][0]), 1, mUPapost_->rows);
-			b[i] = fix16_mul(mDPapost_->data[i][i], a[i]);
+			a[i] = MTX_Dot(&MTX_AT(mUPapost_, 0, i), mUPapost_->stride, &MTX_AT(mH_, m_, 0), 1, mUPapost_->rows);
+			b[i] = fix16_mul(MTX_AT(mDPapost_, i, i), a[i]);
 		}
-		alpha = rmm_;
-		gamma = alpha;
-		for(j = 0u; j < vXapost_->rows; j++)
+		/* h P h' + r in Q48.16, it exceeds the Q16.16 range long before the gate should open */
+		innVar = (int64_t)rmm_ + MTX_Dot48d16(a, 1, b, 1, mUPapost_->rows);
+		if( TRUE == KF_IsNisGated(dym_, innVar, nisThld_) )
 		{
-			beta     = alpha;
-			alpha    = fix16_add( alpha, fix16_mul(a[j], b[j]) );
-			gammaOld = gamma;
-			gamma    = alpha;
-			tmp = fix16_div(mDPapost_->data[j][j], gamma);
-			mDPapost_->data[j][j] = fix16_mul(tmp, beta);
-			for(i = 0u; i < j; i++)
-			{
-				beta = mUPapost_->data[i][j];
-				tmp = fix16_mul(b[i],a[j]);
-				tmp = fix16_div(tmp, gammaOld);
-				mUPapost_->data[i][j] = fix16_sub( beta, tmp );
-				tmp = fix16_mul(b[j], beta);
-				b[i] = fix16_add( b[i], tmp );
-			}
+			retVal = ERR_RANGE;
 		}
-		for(i = 0; i < vXapost_->rows; i++) /* update x_apost */
+		else
 		{
-			if ( (fix16_abs(dym_) >= fix16_one) || (fix16_abs(b[i]) >= fix16_one) )
+			alpha = rmm_;
+			gamma = alpha;
+			for(j = 0u; j < vXapost_->rows; j++)
 			{
-				tmp = fix16_mul(dym_, b[i]);
-				if(fix16_overflow == tmp)
+				beta     = alpha;
+				alpha    = fix16_add( alpha, fix16_mul(a[j], b[j]) );
+				gammaOld = gamma;
+				gamma    = alpha;
+				tmp = fix16_div(MTX_AT(mDPapost_, j, j), gamma);
+				MTX_AT(mDPapost_, j, j) = fix16_mul(tmp, beta);
+				for(i = 0u; i < j; i++)
 				{
-					overFlowFlag = TRUE;
+					beta = MTX_AT(mUPapost_, i, j);
+					tmp = fix16_mul(b[i],a[j]);
+					tmp = fix16_div(tmp, gammaOld);
+					MTX_AT(mUPapost_, i, j) = fix16_sub( beta, tmp );
+					tmp = fix16_mul(b[j], beta);
+					b[i] = fix16_add( b[i], tmp );
 				}
-				else
-				{
-					tmp = fix16_div(tmp, gamma);
-				}
-			}
-			if( (fix16_abs(dym_) > fix16_abs(b[i])) && (TRUE == overFlowFlag) )
-			{
-				tmp = fix16_div(dym_, gamma);
-				tmp = fix16_mul(tmp, b[i]);
-				overFlowFlag = FALSE;
 			}
-			if(TRUE == overFlowFlag)
+			for(i = 0; i < vXapost_->rows; i++) /* update x_apost */
 			{
-				tmp = fix16_div(b[i], gamma);
-				tmp = fix16_mul(tmp, dym_);
-				overFlowFlag = FALSE;
+				if ( (fix16_abs(dym_) >= fix16_one) || (fix16_abs(b[i]) >= fix16_one) )
+				{
+					tmp = fix16_mul(dym_, b[i]);
+					if(fix16_overflow == tmp)
+					{
+						overFlowFlag = TRUE;
+					}
+					else
+					{
+						tmp = fix16_div(tmp, gamma);
+					}
+				}
+				if( (fix16_abs(dym_) > fix16_abs(b[i])) && (TRUE == overFlowFlag) )
+				{
+					tmp = fix16_div(dym_, gamma);
+					tmp = fix16_mul(tmp, b[i]);
+					overFlowFlag = FALSE;
+				}
+				if(TRUE == overFlowFlag)
+				{
+					tmp = fix16_div(b[i], gamma);
+					tmp = fix16_mul(tmp, dym_);
+					overFlowFlag = FALSE;
+				}
+				MTX_AT(vXapost_, i, 0) = fix16_add(MTX_AT(vXapost_, i, 0), tmp);
 			}
-			vXapost_->data[i][0] = fix16_add(vXapost_->data[i][0], tmp);
 		}
 	}
 	return retVal;
@@ -315,15 +339,41 @@ static StdRtn_t KF_BiermanObservationalUpdate(MTX_t *vXapost_, MTX_t *mUPapost_,
 
 
 /*============================= >> GLOBAL FUNCTION DEFINITIONS << ================================*/
+bool KF_IsNisGated(int32_t dym_, int64_t innVar_, fix16_t nisThld_)
+{
+	uint64_t dySq = (uint64_t)((int64_t)dym_ * dym_);
+	uint64_t hi = 0u, lo = 0u, bound = 0u;
+	bool isGated = FALSE;
+
+	if( 0 < nisThld_ )
+	{
+		/* thld * (h P h' + r) in Q32.32 like dy^2, 64x32 bit in two halves, saturated at 2^63 which
+		 * no dy^2 reaches, a variance <= 0 leaves a bound of 0 */
+		if( 0 < innVar_ )
+		{
+			hi = ((uint64_t)innVar_ >> 32) * (uint32_t)nisThld_;
+			lo = ((uint64_t)innVar_ & 0xFFFFFFFFu) * (uint32_t)nisThld_;
+			bound = ( hi >= (((uint64_t)1) << 31) ) ? (((uint64_t)1) << 63) : ( (hi << 32) + lo );
+		}
+		isGated = ( dySq > bound ) ? TRUE : FALSE;
+	}
+	return isGated;
+}
+
 void KF_Init(void)
 {
-	uint8_t i = 0u;
+	uint8_t i = 0u, m = 0u;
 	KF_pTbl = Get_pKfItmTbl();
 	if( (NULL != KF_pTbl) && (NULL != KF_pTbl->aKfs) )
 	{
 		for(i = 0u; i < KF_pTbl->numKfs; i++)
 		{
 			KF_Reset( &(KF_pTbl->aKfs[i]) );
+			KF_pTbl->aKfs[i].data.nRejCntr = 0u;
+			for(m = 0u; m < KF_pTbl->aKfs[i].cfg.mtx.mH.rows; m++)
+			{
+				KF_pTbl->aKfs[i].data.aRejSeqCntr[m] = 0u;
+			}
 		}
 	}
 }
@@ -336,7 +386,7 @@ void KF_Main(void)
 		for(i = 0u; i < KF_pTbl->numKfs; i++)
 		{
 			KF_Predict_x(&KF_pTbl->aKfs[i]);
-			KF_Predict_P(&KF_pTbl->aKfs[i]);
+			KF_Predict_P(&KF_pTbl->aKfs[i], KF_pTbl->aThorntonScr, KF_pTbl->numThorntonScr);
 			KF_Correct(&KF_pTbl->aKfs[i]);
 			if( TRUE == KF_pTbl->aKfs[i].cfg.bModCntrFlag )
 			{
@@ -362,19 +412,34 @@ StdRtn_t KF_Read_i16EstdVal(int16_t *pVal_, const uint8_t idx_)
 			retVal = ERR_OK;
 			if(TRUE == KF_pTbl->aKfs[idx_].cfg.bModCntrFlag)
 			{
-				*pVal_ = KF_pTbl->aKfs[idx_].data.aModCntr[1]*KF_DFLT_MAX_MOD_VAL + (KF_pTbl->aKfs[idx_].data.vXapost.data[1][0]>>16);
+				*pVal_ = KF_pTbl->aKfs[idx_].data.aModCntr[1]*KF_DFLT_MAX_MOD_VAL + (MTX_AT(&KF_pTbl->aKfs[idx_].data.vXapost, 1, 0)>>16);
 			}
 			else
 			{
 			    /* TODO This returns the second state hard-coded... should introduce an index variable
 			     * for corresponding state */
-				*pVal_ = (int16_t)((KF_pTbl->aKfs[idx_].data.vXapost.data[1][0])>>16);
+				*pVal_ = (int16_t)((MTX_AT(&KF_pTbl->aKfs[idx_].data.vXapost, 1, 0))>>16);
 			}
 		}
 	}
 	return retVal;
 }
 
+StdRtn_t KF_Read_RejCntr(uint32_t *pCnt_, const uint8_t idx_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+	if( (NULL != pCnt_) && (NULL != KF_pTbl) && (NULL != KF_pTbl->aKfs) )
+	{
+		retVal = ERR_PARAM_VALUE;
+		if(idx_ < KF_pTbl->numKfs )
+		{
+			retVal = ERR_OK;
+			*pCnt_ = KF_pTbl->aKfs[idx_].data.nRejCntr;
+		}
+	}
+	return retVal;
+}
+
 /**
  * @}
  */
@@ -15,7 +15,7 @@
 #define KF_H_
 
 /*======================================= >> #INCLUDES << ========================================*/
-
+#include "kf_cfg.h"
 
 
 #ifdef MASTER_KF_C_
@@ -80,6 +80,20 @@ EXTERNAL_ void KF_Main(void);
 EXTERNAL_ void KF_Deinit(void);
 
 
+
+/**
+ * @brief Innovation gate of the Bierman update, checks dy^2 / thld > h P h' + r
+ *
+ * The comparison is done as dy^2 > thld * (h P h' + r) with a saturating 64x32 bit multiplication,
+ * hence it doesn't need a division.
+ * @param dym_ innovation of the measurement in Q16.16
+ * @param innVar_ innovation variance h P h' + r in Q48.16
+ * @param nisThld_ gate in Q16.16, 0 or less disables the gate
+ * @return TRUE if the measurement is rejected, FALSE otherwise
+ */
+EXTERNAL_ bool KF_IsNisGated(int32_t dym_, int64_t innVar_, fix16_t nisThld_);
+
+
 /**
  * @}
  */
@@ -48,6 +48,17 @@
  */
 EXTERNAL_ StdRtn_t KF_Read_i16EstdVal(int16_t *pVal_, const uint8_t idx_);
 
+/**
+ * @brief Returns the number of measurements rejected by the innovation gate since initialization.
+ * @param[in,out] pCnt_ number of rejected measurements
+ * @param[in] idx_ current kf id
+ * @return Error code,  ERR_OK if everything was fine,
+ *                      ERR_PARAM_VALUE if idx_ exceeds total number of KFs
+ *                      ERR_PARAM_ADDRESS otherwise
+ *
+ */
+EXTERNAL_ StdRtn_t KF_Read_RejCntr(uint32_t *pCnt_, const uint8_t idx_);
+
 
 #ifdef EXTERNAL_
 #undef EXTERNAL_
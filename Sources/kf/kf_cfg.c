@@ -29,23 +29,42 @@
 #define KF_DIM_TACHO_N (2u)
 #define KF_DIM_TACHO_M (2u)
 
+/**
+ * @brief Largest number of states of all Kalman filters, sizes the scratch of the Thornton update
+ */
+#define KF_MAX_DIM_N (KF_DIM_TACHO_N)
+
+
+/**
+ *	@brief Macro to initialize constant 2-by-2 matrices, the storage is a constant compound literal
+ *	in flash since the system matrices are only read
+ */
+#define MTX_INIT_2X2(dim_, m11_, m12_, m21_, m22_) MTX_VIEW_INIT(dim_, dim_, ((fix16_t *)(const fix16_t[4]){m11_, m12_, m21_, m22_}))
 
 /**
- *	@brief Macro to initialize 2-by-2 matrices
+ *	@brief Macro to initialize a zeroed matrix of exactly rows_ x cols_ elements
  */
-#define MTX_INIT_2X2(dim_, m11_, m12_, m21_, m22_) {dim_, dim_, 0, {{m11_, m12_}, {m21_, m22_}}}
+#define MTX_INIT_ZERO(rows_, cols_) MTX_VIEW_INIT(rows_, cols_, ((fix16_t[(rows_)*(cols_)]){0}))
 
 /**
- * @brief Macro for default runtime data init
+ *	@brief Macro to initialize an empty matrix without storage
  */
-#define KF_DFLT_DATA_INIT(n_) {\
-              /*  vXapri    */  {n_, 1,  0, {0u}},\
-              /*  vXapost   */  {n_, 1,  0, {0u}},\
-              /*  mUPapri   */  {n_, n_, 0, {0u}},\
-              /*  mDPapri   */  {n_, n_, 0, {0u}},\
-              /*  mUPapost  */  {n_, n_, 0, {0u}},\
-              /*  mDPapost  */  {n_, n_, 0, {0u}},\
-              /*  nMdCntr   */  {0}\
+#define MTX_INIT_EMPTY(rows_) MTX_VIEW_INIT(rows_, 0u, NULL)
+
+/**
+ * @brief Macro for default runtime data init of a filter with n_ states, m_ measurements and without inputs
+ */
+#define KF_DFLT_DATA_INIT(n_, m_) {\
+              /*  vXapri    */  MTX_INIT_ZERO(n_, 1u),\
+              /*  vXapost   */  MTX_INIT_ZERO(n_, 1u),\
+              /*  mUPapri   */  MTX_INIT_ZERO(n_, n_),\
+              /*  mDPapri   */  MTX_INIT_ZERO(n_, n_),\
+              /*  mUPapost  */  MTX_INIT_ZERO(n_, n_),\
+              /*  mDPapost  */  MTX_INIT_ZERO(n_, n_),\
+              /*  vU        */  MTX_INIT_EMPTY(0u),\
+              /*  nMdCntr   */  ((int32_t[n_]){0}),\
+              /*  nRejCntr  */  0u,\
+              /*  aRejSeqCntr */ ((uint8_t[m_]){0u})\
                               }
 
 
@@ -77,7 +96,7 @@ static KF_Itm_t KF_Items[] =
 	/* Sample Time */	TACHO_SAMPLE_PERIOD_MS,
 	/* Matrices */	{
 		/* Phi */		    MTX_INIT_2X2(KF_DIM_TACHO_N,     1<<16, ((TACHO_SAMPLE_PERIOD_MS<<16)/1000), 0, 1<<16),
-		/* Gamma */		  {0u},
+		/* Gamma */		  MTX_INIT_EMPTY(KF_DIM_TACHO_N),
 		/* H */			    MTX_INIT_2X2(KF_DIM_TACHO_N,     1<<16,  0,                                  0, 1<<16),
 		/* R */			    MTX_INIT_2X2(KF_DIM_TACHO_M,     3<<16,  0, 								                 0, 20000<<16),
 		/* G */			    MTX_INIT_2X2(KF_DIM_TACHO_N,     1<<16,  0, 								                 0, 1<<16),
@@ -85,9 +104,10 @@ static KF_Itm_t KF_Items[] =
 					        },
 	/* MeasFcts */	KF_MeasValFctHdlsLe,
 	/* InptFcts */	NULL,
-  /* Mod cntr */  TRUE
+  /* Mod cntr */  TRUE,
+  /* NIS gate */  KF_DFLT_NIS_THLD
 				      },
-/* Data */		KF_DFLT_DATA_INIT(KF_DIM_TACHO_N)
+/* Data */		KF_DFLT_DATA_INIT(KF_DIM_TACHO_N, KF_DIM_TACHO_M)
 			},
 /*======================== tacho right =========================*/
 			{
@@ -96,7 +116,7 @@ static KF_Itm_t KF_Items[] =
 	/* Sample Time */	TACHO_SAMPLE_PERIOD_MS,
 	/* Matrices */	  {
 		/* Phi */		      MTX_INIT_2X2(KF_DIM_TACHO_N,     1<<16, ((TACHO_SAMPLE_PERIOD_MS<<16)/1000), 0, 1<<16),
-		/* Gamma */		    {0u},
+		/* Gamma */		    MTX_INIT_EMPTY(KF_DIM_TACHO_N),
 		/* H */			      MTX_INIT_2X2(KF_DIM_TACHO_N,     1<<16,  0,                                  0, 1<<16),
 		/* R */			      MTX_INIT_2X2(KF_DIM_TACHO_M,     3<<16,  0, 								                 0, 20000<<16),
 		/* G */			      MTX_INIT_2X2(KF_DIM_TACHO_N,     1<<16,  0, 								                 0, 1<<16),
@@ -104,12 +124,21 @@ static KF_Itm_t KF_Items[] =
 					          },
 	/* MeasFcts */    KF_MeasValFctHdlsRi,
 	/* InptFcts */    NULL,
-	/* Mod cntr */    TRUE
+	/* Mod cntr */    TRUE,
+	/* NIS gate */    KF_DFLT_NIS_THLD
 				      },
-/* Data */		KF_DFLT_DATA_INIT(KF_DIM_TACHO_N)
+/* Data */		KF_DFLT_DATA_INIT(KF_DIM_TACHO_N, KF_DIM_TACHO_M)
 			},
 };
 
+/**
+ *
+ */
+/**
+ * Scratch of the Thornton update, the filters are updated one after another and share it
+ */
+static fix16_t KF_ThorntonScr[2u*KF_MAX_DIM_N*KF_MAX_DIM_N];
+
 /**
  *
  */
@@ -117,6 +146,8 @@ static KF_ItmTbl_t KF_ItemTable =
 {
 	KF_Items,
 	sizeof(KF_Items)/(sizeof(KF_Items[0])),
+	KF_ThorntonScr,
+	sizeof(KF_ThorntonScr)/(sizeof(KF_ThorntonScr[0])),
 };
 
 /*============================== >> LOKAL FUNCTION DEFINITIONS << ================================*/
@@ -39,6 +39,18 @@
  */
 #define KF_DFLT_ALPHA (100u)
 
+/**
+ * @brief Defines the default gate for the normalized innovation squared of a single measurement in Q16.16,
+ * 11 is about the 99.9% quantile of the chi-square distribution with one degree of freedom
+ */
+#define KF_DFLT_NIS_THLD (11<<16)
+
+/**
+ * @brief Defines the number of consecutive rejections of a measurement after which the filter is
+ * restarted from this measurement, a true step of the measured value is gated out forever otherwise
+ */
+#define KF_DFLT_MAX_REJ_SEQ (10u)
+
 
 /*=================================== >> TYPE DEFINITIONS << =====================================*/
 /**
@@ -57,7 +69,10 @@ typedef struct KF_Data_s
 	MTX_t  mDPapri;							/**< the a priori diagonal matrix matrix */
 	MTX_t  mUPapost;						/**< the a priori unit upper triangular matrix */
 	MTX_t  mDPapost;						/**< the a aposteriori diagonal matrix */
-	int32_t aModCntr[FIXMATRIX_MAX_SIZE];	/**< modulo counter for state variables. Change FIXMATRIX_MAX_SIZE in compiler flags */
+	MTX_t  vU;								/**< scratch input vector, l x 1 (no storage if no inputs) */
+	int32_t *aModCntr;						/**< modulo counter for state variables, n elements */
+	uint32_t nRejCntr;						/**< number of measurements rejected by the innovation gate */
+	uint8_t *aRejSeqCntr;					/**< number of consecutive rejections per measurement, m elements */
 }KF_Data_t;
 
 /**
@@ -84,6 +99,7 @@ typedef struct KF_Cfg_s
 	KF_ReadFct_t  *aMeasValFct;		/**< array of function pointers for measurements */
 	KF_ReadFct_t  *aInptValFct;		/**< array of function pointers for inputs */
 	bool bModCntrFlag;				    /**< flag to indicate usage of modulo counter for state variables */
+	fix16_t nisThld;				    /**< gate for the normalized innovation squared in Q16.16, 0 disables gating */
 }KF_Cfg_t;
 
 /**
@@ -102,6 +118,8 @@ typedef struct KF_ItmTbl_s
 {
 	KF_Itm_t *aKfs;			  /**< array of Kalman filter items */
 	const uint8_t numKfs;	/**< total number of Kalman filters*/
+	fix16_t *aThorntonScr;	/**< scratch of the Thornton update shared by all filters, 2*n*n elements of the largest filter */
+	const uint16_t numThorntonScr;	/**< number of elements of aThorntonScr */
 }KF_ItmTbl_t;
 
 
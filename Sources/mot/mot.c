@@ -5,7 +5,21 @@
  *
  * This software component implements a  driver for up to two small DC motors. It uses @a PWM and
  * @a BitIO firmware components from Kinets to influence the speed and direction of the motors.
- * The driver can handle inverted polarity from assembly point of view.
+ * The driver can handle inverted polarity from assembly point of view.\n
+ * Optionally, the PWM values are linearized by a table of each motor, which is loaded from the
+ * @ref nvm. It maps the motor value onto the duty cycle which yields a proportional steady-state
+ * speed and skips the dead band of the motor. The table is interpolated without division.\n
+ * The duty cycles are scaled by the ratio of the nominal and the filtered battery voltage, so the
+ * same motor value yields the same motor voltage over the whole battery range. The gain follows the
+ * voltage slowly, otherwise the voltage drop of a loaded battery and the raised duty cycle would
+ * amplify each other. Below MOT_BATT_DERATE_HI_CV the gain is derated linearly, so an empty
+ * battery isn't drained by peak currents.\n
+ * The rise of the motor value is limited by a slew rate and the motor coasts for a short interval
+ * on a reversal, so jumps of the controller outputs don't cause current spikes. The limiter runs
+ * on the cycle counter, hence it doesn't depend on the rate of the calls, e.g. from the drive task
+ * or from the interrupt of the speed loops. Its limits are loaded from the @ref nvm.\n
+ * The conversions between percent, Q15 duty cycles and PWM values multiply by reciprocals instead
+ * of dividing, they give the same results as the division over the whole range of the inputs.
  *
  * @author 	(c) 2014 Erich Styger, erich.styger@hslu.ch, Hochschule Luzern
  * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
@@ -24,10 +38,29 @@
 #include "DIRL.h"
 #include "PWMR.h"
 #include "PWML.h"
+#include "nvm_api.h"
+#include "batt_api.h"
+#include "KIN1.h"
+#include "Cpu.h"
+#include "CS1.h"
 
 
 
 /*======================================= >> #DEFINES << =========================================*/
+#if MOT_LIN_PT_CNT != NVM_MOT_LIN_PT_CNT
+#error Size of the linearization table differs from the NVM
+#endif
+
+#define MOT_LIN_SEG_MASK	((1u << MOT_LIN_SEG_SHIFT) - 1u)
+
+#define MOT_BATT_GAIN_ONE	(1u << MOT_BATT_GAIN_SHIFT)
+
+#define MOT_LIM_CYC_PER_US	(CPU_CORE_CLK_HZ / 1000000u)
+#define MOT_LIM_CYC_PER_MS	(CPU_CORE_CLK_HZ / 1000u)
+#define MOT_LIM_DT_MAX_US	(0xFFFFu) /* keeps the slew step within 32 bit */
+
+#define MOT_PERC_TO_VAL_MUL		(42949018u) /* 0xFFFF/100 << 16 rounded up, exact for 0...100 % */
+#define MOT_PERC_TO_VAL_SHIFT	(16u)
 
 
 
@@ -40,12 +73,24 @@ static uint8_t PWMLSetRatio16(uint16_t ratio);
 static uint8_t PWMRSetRatio16(uint16_t ratio);
 static void DirLPutVal(bool val);
 static void DirRPutVal(bool val);
+static uint16_t MOT_Lin_Val(const MOT_MotorDevice_t *motor, uint16_t val);
+static void MOT_Init_LinTbl(MOT_MotorDevice_t *motor, StdRtn_t (*readFct)(NVM_MotLinCfg_t *), StdRtn_t (*readDfltFct)(NVM_MotLinCfg_t *));
+static uint16_t MOT_Comp_Val(uint16_t val);
+static uint16_t MOT_Calc_BattGain(uint16_t cv);
+static int32_t MOT_Lim_Val(MOT_MotorDevice_t *motor, int32_t val);
+static void MOT_Upd_Out(MOT_MotorDevice_t *motor);
+static void MOT_Trk_Lim(MOT_MotorDevice_t *motor);
+static void MOT_Init_Lim(void);
 
 
 
 /*=================================== >> GLOBAL VARIABLES << =====================================*/
 static MOT_MotorDevice_t motorL, motorR;
 static bool isMotorOn = TRUE;
+static uint16_t battGain = MOT_BATT_GAIN_ONE;
+static bool isBattGainInit = FALSE;
+static uint16_t limSlewRate = 0u;
+static uint16_t limCoastMs = 0u;
 
 
 
@@ -66,6 +111,154 @@ static void DirRPutVal(bool val) {
 	DIRR_PutVal(val);
 }
 
+/**
+ * @brief Returns the linearized PWM value of a PWM value, both are low active
+ */
+static uint16_t MOT_Lin_Val(const MOT_MotorDevice_t *motor, uint16_t val) {
+	uint32_t ctrlVal = 0xFFFFu - val;
+	uint32_t idx = ctrlVal >> MOT_LIN_SEG_SHIFT;
+	int32_t duty = 0;
+
+	if (motor->isLinEna && (0u != ctrlVal)) {
+		duty = (int32_t)motor->aLinDuty[idx]
+			+ ( ( ((int32_t)motor->aLinDuty[idx+1u] - (int32_t)motor->aLinDuty[idx]) * (int32_t)(ctrlVal & MOT_LIN_SEG_MASK) ) >> MOT_LIN_SEG_SHIFT );
+		val = (uint16_t)(0xFFFF - duty);
+	}
+	return val;
+}
+
+/**
+ * @brief Loads the linearization table of a motor from the NVM or from the ROM if the NVM is erased
+ */
+static void MOT_Init_LinTbl(MOT_MotorDevice_t *motor, StdRtn_t (*readFct)(NVM_MotLinCfg_t *), StdRtn_t (*readDfltFct)(NVM_MotLinCfg_t *)) {
+	NVM_MotLinCfg_t nvmLin = {0u};
+	StdRtn_t retVal = readFct(&nvmLin);
+
+	if (ERR_OK != retVal) {
+		retVal = readDfltFct(&nvmLin);
+	}
+	(void)MOT_Set_LinTbl(motor, ( (ERR_OK == retVal) && (FALSE != nvmLin.IsEna) ) ? nvmLin.aDuty : NULL);
+}
+
+
+/**
+ * @brief Returns the PWM value compensated by the battery voltage, both are low active
+ */
+static uint16_t MOT_Comp_Val(uint16_t val) {
+	uint32_t duty = ((uint32_t)(0xFFFFu - val) * battGain) >> MOT_BATT_GAIN_SHIFT;
+
+	return (uint16_t)(0xFFFFu - ((duty > 0xFFFFu) ? 0xFFFFu : duty));
+}
+
+/**
+ * @brief Returns the compensation gain at the battery voltage cv in [cV]
+ */
+static uint16_t MOT_Calc_BattGain(uint16_t cv) {
+	uint32_t gain = ((uint32_t)MOT_BATT_NOM_CV << MOT_BATT_GAIN_SHIFT) / cv;
+	uint32_t derate = MOT_BATT_GAIN_ONE;
+
+	if (cv <= MOT_BATT_DERATE_LO_CV) {
+		derate = MOT_BATT_DERATE_MIN;
+	} else if (cv < MOT_BATT_DERATE_HI_CV) {
+		derate = MOT_BATT_DERATE_MIN + ((MOT_BATT_GAIN_ONE - MOT_BATT_DERATE_MIN) * (uint32_t)(cv - MOT_BATT_DERATE_LO_CV))
+				/ (MOT_BATT_DERATE_HI_CV - MOT_BATT_DERATE_LO_CV);
+	}
+	gain = (gain * derate) >> MOT_BATT_GAIN_SHIFT;
+	return (uint16_t)((gain > MOT_BATT_GAIN_MAX) ? MOT_BATT_GAIN_MAX : gain);
+}
+
+/**
+ * @brief Returns the signed motor value limited by the slew rate and the coast interval
+ */
+static int32_t MOT_Lim_Val(MOT_MotorDevice_t *motor, int32_t val) {
+	uint32_t cyc = KIN1_GetCycleCounter();
+	uint32_t dtUs = (cyc - motor->limCyc) / MOT_LIM_CYC_PER_US;
+	uint32_t absVal = (uint32_t)((val < 0) ? -val : val);
+	uint32_t absLim = (uint32_t)((motor->limVal < 0) ? -motor->limVal : motor->limVal);
+	uint32_t acc = 0u, step = 0u;
+
+	motor->limCyc = cyc;
+	dtUs = (dtUs > MOT_LIM_DT_MAX_US) ? MOT_LIM_DT_MAX_US : dtUs;
+	if (motor->isCoast && ((cyc - motor->coastCyc) < (uint32_t)limCoastMs * MOT_LIM_CYC_PER_MS)) {
+		val = 0;
+		motor->limCnt.coastCnt++;
+	} else {
+		motor->isCoast = FALSE;
+		if (((val < 0) && (motor->limVal > 0)) || ((val > 0) && (motor->limVal < 0))) { /* reversal */
+			absLim = 0u;
+			motor->limFrac = 0u;
+			if (0u != limCoastMs) {
+				motor->isCoast = TRUE;
+				motor->coastCyc = cyc;
+				val = 0;
+				motor->limCnt.coastCnt++;
+			}
+		}
+		if (!motor->isCoast && (0u != limSlewRate) && (absVal > absLim)) {
+			acc = (uint32_t)limSlewRate * dtUs + motor->limFrac;
+			step = acc / 1000u;
+			if (absVal - absLim > step) {
+				motor->limFrac = acc - step * 1000u;
+				val = (val < 0) ? -(int32_t)(absLim + step) : (int32_t)(absLim + step);
+				motor->limCnt.slewCnt++;
+			} else {
+				motor->limFrac = 0u;
+			}
+		} else {
+			motor->limFrac = 0u;
+		}
+	}
+	motor->limVal = val;
+	return val;
+}
+
+/**
+ * @brief Applies the PWM value and the direction of the motor via the limiter, the compensation of
+ * the battery voltage and the linearization. The direction bit follows the sign of the limited
+ * value and is written here only, with the H-bridge switched off, so it never toggles at a duty
+ * cycle of the other direction whatever the order of MOT_SetVal() and MOT_SetDirection().
+ */
+static void MOT_Upd_Out(MOT_MotorDevice_t *motor) {
+	int32_t val = 0xFFFF - (int32_t)motor->currPWMvalue;
+	uint16_t pwm = 0u;
+	bool dirPinVal = motor->dirPinVal;
+
+	val = MOT_Lim_Val(motor, (MOT_DIR_BACKWARD == motor->dir) ? -val : val);
+	pwm = (uint16_t)(0xFFFF - ((val < 0) ? -val : val)); /* H-Bridge is low active! */
+	if (0 != val) { /* a coasting output keeps the direction bit */
+		dirPinVal = ((val > 0) != (FALSE != motor->inverted)) ? 1 : 0;
+	}
+	if (dirPinVal != motor->dirPinVal) {
+		(void)motor->SetRatio16(0xFFFF);
+		motor->DirPutVal(dirPinVal);
+		motor->dirPinVal = dirPinVal;
+	}
+	(void)motor->SetRatio16(MOT_Comp_Val(motor->isRawVal ? pwm : MOT_Lin_Val(motor, pwm)));
+}
+
+/**
+ * @brief Updates the output of the motor, if it hasn't reached the PWM value because of the limiter
+ */
+static void MOT_Trk_Lim(MOT_MotorDevice_t *motor) {
+	int32_t val = 0xFFFF - (int32_t)motor->currPWMvalue;
+
+	if (motor->isCoast || (((MOT_DIR_BACKWARD == motor->dir) ? -val : val) != motor->limVal)) {
+		MOT_Upd_Out(motor);
+	}
+}
+
+/**
+ * @brief Loads the limits of the motor outputs from the NVM or from the ROM if the NVM is erased
+ */
+static void MOT_Init_Lim(void) {
+	NVM_MotLimCfg_t nvmLim = {0u};
+
+	if (ERR_OK != NVM_Read_MotLimCfg(&nvmLim)) {
+		(void)NVM_Read_Dflt_MotLimCfg(&nvmLim);
+	}
+	MOT_Set_Lim(nvmLim.slewRate, nvmLim.coastMs);
+}
+
 
 
 /*============================= >> GLOBAL FUNCTION DEFINITIONS << ================================*/
@@ -81,13 +274,62 @@ MOT_MotorDevice_t *MOT_GetMotorHandle(MOT_MotorSide_t side) {
 void MOT_SetVal(MOT_MotorDevice_t *motor, uint16_t val) {
 	if (isMotorOn) {
 		motor->currPWMvalue = val;
-		(void)motor->SetRatio16(val);
+		motor->isRawVal = FALSE;
+		MOT_Upd_Out(motor);
+	} else { /* have motor stopped */
+		motor->currPWMvalue = 0xFFFF;
+		motor->limVal = 0;
+		motor->isCoast = FALSE;
+		(void)motor->SetRatio16(0xFFFF);
+	}
+}
+
+void MOT_SetRawVal(MOT_MotorDevice_t *motor, uint16_t val) {
+	if (isMotorOn) {
+		motor->currPWMvalue = val;
+		motor->isRawVal = TRUE;
+		MOT_Upd_Out(motor);
 	} else { /* have motor stopped */
 		motor->currPWMvalue = 0xFFFF;
+		motor->limVal = 0;
+		motor->isCoast = FALSE;
 		(void)motor->SetRatio16(0xFFFF);
 	}
 }
 
+StdRtn_t MOT_Set_LinTbl(MOT_MotorDevice_t *motor, const uint16_t *aDuty) {
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+	uint8_t i = 0u;
+
+	if (NULL != motor) {
+		motor->isLinEna = FALSE; /* the table isn't used while it is changed */
+		if (NULL != aDuty) {
+			for (i = 0u; i < MOT_LIN_PT_CNT; i++) {
+				motor->aLinDuty[i] = aDuty[i];
+			}
+			motor->isLinEna = TRUE;
+		}
+		retVal = ERR_OK;
+	}
+	return retVal;
+}
+
+StdRtn_t MOT_Read_LinTbl(const MOT_MotorDevice_t *motor, uint16_t *aDuty) {
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+	uint8_t i = 0u;
+
+	if ((NULL != motor) && (NULL != aDuty)) {
+		retVal = ERR_VALUE;
+		if (motor->isLinEna) {
+			for (i = 0u; i < MOT_LIN_PT_CNT; i++) {
+				aDuty[i] = motor->aLinDuty[i];
+			}
+			retVal = ERR_OK;
+		}
+	}
+	return retVal;
+}
+
 void MOT_OnOff(bool on) {
 	isMotorOn = on;
 	if (!on) {
@@ -119,12 +361,14 @@ void MOT_SetSpeedPercent(MOT_MotorDevice_t *motor, MOT_SpeedPercent percent) {
 	} else {
 		MOT_SetDirection(motor, MOT_DIR_FORWARD);
 	}
-	val = ((100-percent)*0xffff)/100; /* H-Bridge is low active! */
+	val = ((uint32_t)(100-percent)*MOT_PERC_TO_VAL_MUL) >> MOT_PERC_TO_VAL_SHIFT; /* H-Bridge is low active! */
 	MOT_SetVal(motor, (uint16_t)val);
 }
 
 void MOT_UpdatePercent(MOT_MotorDevice_t *motor, MOT_Direction_t dir) {
-	motor->currSpeedPercent = ((0xffff-motor->currPWMvalue)*100)/0xffff;
+	uint32_t val = (uint32_t)(0xffff-motor->currPWMvalue)*100u;
+
+	motor->currSpeedPercent = (MOT_SpeedPercent)((val + (val >> 16) + 1u) >> 16); /* val/0xffff */
 	if (dir==MOT_DIR_BACKWARD) {
 		motor->currSpeedPercent = -motor->currSpeedPercent;
 	}
@@ -134,6 +378,26 @@ MOT_SpeedPercent MOT_GetSpeedPercent(const MOT_MotorDevice_t *motor) {
 	return motor->currSpeedPercent;
 }
 
+void MOT_SetDutyQ15(MOT_MotorDevice_t *motor, int16_t duty) {
+	uint32_t mag = (uint32_t)((duty < 0) ? -(int32_t)duty : duty);
+	MOT_SpeedPercent percent = (MOT_SpeedPercent)((mag * 100u) >> 15);
+
+	if (duty < 0) {
+		MOT_SetDirection(motor, MOT_DIR_BACKWARD);
+		motor->currSpeedPercent = -percent;
+	} else {
+		MOT_SetDirection(motor, MOT_DIR_FORWARD);
+		motor->currSpeedPercent = percent;
+	}
+	MOT_SetVal(motor, (uint16_t)(0xFFFFu - ((mag << 1) - ((mag + 0x3FFFu) >> 15)))); /* mag*0xFFFF/0x8000 rounded */
+}
+
+int16_t MOT_GetDutyQ15(const MOT_MotorDevice_t *motor) {
+	uint32_t mag = ((uint32_t)(0xFFFFu - motor->currPWMvalue) + 1u) >> 1; /* val*0x8000/0xFFFF rounded */
+
+	return (int16_t)((MOT_DIR_BACKWARD == motor->dir) ? -(int32_t)mag : (int32_t)((mag > 0x7FFFu) ? 0x7FFFu : mag));
+}
+
 void MOT_ChangeSpeedPercent(MOT_MotorDevice_t *motor, MOT_SpeedPercent relPercent) {
 	relPercent += motor->currSpeedPercent; /* make absolute number */
 	if (relPercent>100) { /* check for overflow */
@@ -145,25 +409,25 @@ void MOT_ChangeSpeedPercent(MOT_MotorDevice_t *motor, MOT_SpeedPercent relPercen
 }
 
 void MOT_SetDirection(MOT_MotorDevice_t *motor, MOT_Direction_t dir) {
+	bool isChanged = (dir != motor->dir);
+
+	motor->dir = dir; /* the direction bit is latched by MOT_Upd_Out() */
 	if (dir==MOT_DIR_FORWARD ) {
-		motor->DirPutVal(motor->inverted?0:1);
 		if (motor->currSpeedPercent<0) {
 			motor->currSpeedPercent = -motor->currSpeedPercent;
 		}
 	} else if (dir==MOT_DIR_BACKWARD) {
-		motor->DirPutVal(motor->inverted?1:0);
 		if (motor->currSpeedPercent>0) {
 			motor->currSpeedPercent = -motor->currSpeedPercent;
 		}
 	}
+	if (isMotorOn && isChanged) {
+		MOT_Upd_Out(motor);
+	}
 }
 
 MOT_Direction_t MOT_GetDirection(const MOT_MotorDevice_t *motor) {
-	if (motor->currSpeedPercent<0) {
-		return MOT_DIR_BACKWARD;
-	} else {
-		return MOT_DIR_FORWARD;
-	}
+	return motor->dir;
 }
 
 uint8_t MOT_Get_IsMotorOn(void)
@@ -171,6 +435,68 @@ uint8_t MOT_Get_IsMotorOn(void)
 	return (uint8_t)isMotorOn;
 }
 
+uint16_t MOT_Get_BattGain(void) {
+	return battGain;
+}
+
+void MOT_Set_Lim(uint16_t slewRate, uint16_t coastMs) {
+	limSlewRate = slewRate;
+	limCoastMs = coastMs;
+}
+
+StdRtn_t MOT_Read_Lim(uint16_t *pSlewRate, uint16_t *pCoastMs) {
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+
+	if ((NULL != pSlewRate) && (NULL != pCoastMs)) {
+		*pSlewRate = limSlewRate;
+		*pCoastMs = limCoastMs;
+		retVal = ERR_OK;
+	}
+	return retVal;
+}
+
+StdRtn_t MOT_Read_LimCnt(const MOT_MotorDevice_t *motor, MOT_LimCnt_t *pCnt) {
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+
+	if ((NULL != motor) && (NULL != pCnt)) {
+		*pCnt = motor->limCnt;
+		retVal = ERR_OK;
+	}
+	return retVal;
+}
+
+void MOT_Reset_LimCnt(MOT_MotorDevice_t *motor) {
+	motor->limCnt.slewCnt = 0u;
+	motor->limCnt.coastCnt = 0u;
+}
+
+void MOT_MainFct(void) {
+	CS1_CriticalVariable();
+#if MOT_USES_BATT_COMP
+	uint16_t cv = 0u;
+	uint16_t gain = 0u;
+
+	if ((ERR_OK == BATT_Read_FltVolt(&cv)) && (0u != cv)) {
+		gain = MOT_Calc_BattGain(cv);
+		if (!isBattGainInit) { /* first voltage, no need to limit */
+			isBattGainInit = TRUE;
+		} else if (gain > battGain + MOT_BATT_GAIN_SLEW) {
+			gain = battGain + MOT_BATT_GAIN_SLEW;
+		} else if (gain + MOT_BATT_GAIN_SLEW < battGain) {
+			gain = battGain - MOT_BATT_GAIN_SLEW;
+		}
+		battGain = gain;
+	}
+#endif
+	/* outputs, which are set once, e.g. from the shell, still reach their value */
+	CS1_EnterCritical();
+	if (isMotorOn) {
+		MOT_Trk_Lim(&motorL);
+		MOT_Trk_Lim(&motorR);
+	}
+	CS1_ExitCritical();
+}
+
 
 void MOT_Deinit(void) {
 	/* nothig needed for now */
@@ -183,6 +509,26 @@ void MOT_Init(void) {
 	motorR.DirPutVal = DirRPutVal;
 	motorL.SetRatio16 = PWMLSetRatio16;
 	motorR.SetRatio16 = PWMRSetRatio16;
+	motorL.dir = MOT_DIR_FORWARD;
+	motorR.dir = MOT_DIR_FORWARD;
+	motorL.dirPinVal = motorL.inverted?0:1;
+	motorR.dirPinVal = motorR.inverted?0:1;
+	motorL.DirPutVal(motorL.dirPinVal);
+	motorR.DirPutVal(motorR.dirPinVal);
+	MOT_Init_LinTbl(&motorL, NVM_Read_MotLinLeCfg, NVM_Read_Dflt_MotLinLeCfg);
+	MOT_Init_LinTbl(&motorR, NVM_Read_MotLinRiCfg, NVM_Read_Dflt_MotLinRiCfg);
+	MOT_Init_Lim();
+	KIN1_InitCycleCounter();
+	KIN1_EnableCycleCounter();
+	/* the limiters start at standstill, their timestamps are differences in the free running counter */
+	motorL.limVal = 0;
+	motorR.limVal = 0;
+	motorL.limFrac = 0u;
+	motorR.limFrac = 0u;
+	motorL.isCoast = FALSE;
+	motorR.isCoast = FALSE;
+	motorL.limCyc = KIN1_GetCycleCounter();
+	motorR.limCyc = motorL.limCyc;
 	MOT_SetSpeedPercent(&motorL, 0);
 	MOT_SetSpeedPercent(&motorR, 0);
 	(void)PWML_Enable();
@@ -34,6 +34,43 @@
  * @{
  */
 /*======================================= >> #DEFINES << =========================================*/
+/** String identification of the SWC @ref mot */
+#define MOT_SWC_STRING ("motor")
+
+/**
+ * Compensation of the battery voltage, TRUE scales the duty cycles to MOT_BATT_NOM_CV
+ */
+#define MOT_USES_BATT_COMP		(TRUE)
+
+/**
+ * Nominal battery voltage in [cV], at which the duty cycles aren't changed by the compensation
+ */
+#define MOT_BATT_NOM_CV			(480u)
+
+/**
+ * Battery voltage in [cV], below which the compensation is derated
+ */
+#define MOT_BATT_DERATE_HI_CV	(420u)
+
+/**
+ * Battery voltage in [cV], at and below which the compensation is derated to MOT_BATT_DERATE_MIN
+ */
+#define MOT_BATT_DERATE_LO_CV	(380u)
+
+/**
+ * Derating factor of the compensation gain at MOT_BATT_DERATE_LO_CV, 0.5
+ */
+#define MOT_BATT_DERATE_MIN		(0x0800u)
+
+/**
+ * Maximum compensation gain, 2.0
+ */
+#define MOT_BATT_GAIN_MAX		(0x2000u)
+
+/**
+ * Maximum change of the compensation gain per call of MOT_MainFct(), about 5%/s at 10ms
+ */
+#define MOT_BATT_GAIN_SLEW		(2u)
 
 
 
@@ -52,6 +89,13 @@ void MOT_Deinit(void);
  */
 void MOT_Init(void);
 
+/**
+ * This function updates the compensation of the battery voltage from the filtered voltage of the
+ * SWC @ref batt. The change of the compensation gain is limited per call. Besides, it continues
+ * motor outputs, which are held back by the limiter and aren't set periodically.
+ */
+void MOT_MainFct(void);
+
 
 /**
  * @}
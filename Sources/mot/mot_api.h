@@ -20,6 +20,7 @@
 
 /*======================================= >> #INCLUDES << ========================================*/
 #include "Platform.h"
+#include "ACon_Types.h"
 
 
 #ifdef MASTER_mot_C_
@@ -33,6 +34,21 @@
  * @{
  */
 /*======================================= >> #DEFINES << =========================================*/
+/**
+ * @brief Number of bits of the motor value within a segment of the linearization table
+ */
+#define MOT_LIN_SEG_SHIFT		(12u)
+
+/**
+ * @brief Number of points of the linearization table, the points are equally spaced over the
+ * motor value by 1 << MOT_LIN_SEG_SHIFT
+ */
+#define MOT_LIN_PT_CNT			((0x10000u >> MOT_LIN_SEG_SHIFT) + 1u)
+
+/**
+ * @brief Number of bits of the fractional part of the gain of the battery voltage compensation
+ */
+#define MOT_BATT_GAIN_SHIFT		(12u)
 
 
 
@@ -42,6 +58,31 @@
  */
 typedef int8_t MOT_SpeedPercent; 		/*!< -100%...+100%, where negative is backward */
 
+/**
+ * @typedef MOT_Direction_t
+ * @brief Data type definition of the enumeration MOT_Direction_e
+ *
+ * @enum MOT_Direction_e
+ * @brief This enumeration the driving direction property
+ * forward and backward of the robots a unique identification value
+ */
+typedef enum MOT_Direction_e {
+	MOT_DIR_FORWARD,  /*!< Motor forward direction */ //!< MOT_DIR_FORWARD
+	MOT_DIR_BACKWARD  /*!< Motor backward direction *///!< MOT_DIR_BACKWARD
+} MOT_Direction_t;
+
+/**
+ * @typedef MOT_LimCnt_t
+ * @brief Data type definition of the structure MOT_LimCnt_s
+ *
+ * @struct MOT_LimCnt_s
+ * @brief This struct counts the updates of a motor output, which have been changed by the limiter
+ */
+typedef struct MOT_LimCnt_s {
+	uint32_t slewCnt;					/**< updates limited by the slew rate */
+	uint32_t coastCnt;					/**< updates within the coast interval of a reversal */
+} MOT_LimCnt_t;
+
 /**
  * @typedef MOT_MotorDevice_t
  * @brief Data type definition of the structure MOT_MotorDevice_s
@@ -55,22 +96,20 @@ typedef struct MOT_MotorDevice_s {
 	uint16_t currPWMvalue; 				/**< PWM value currently used */
 	uint8_t (*SetRatio16)(uint16_t); 	/**< function to set the ratio */
 	void (*DirPutVal)(bool); 			/**< function to set the direction bit */
+	bool isLinEna;						/**< PWM values are linearized by aLinDuty */
+	uint16_t aLinDuty[MOT_LIN_PT_CNT];	/**< duty cycles at equally spaced motor values, the first one is the end of the dead band */
+	MOT_Direction_t dir;				/**< direction set by MOT_SetDirection() */
+	bool dirPinVal;						/**< value of the direction bit, written by the output update only */
+	bool isRawVal;						/**< PWM value has been set by MOT_SetRawVal() */
+	bool isCoast;						/**< output coasts after a reversal */
+	int32_t limVal;						/**< signed motor value at the output of the limiter */
+	uint32_t limCyc;					/**< cycle counter at the last update of the limiter */
+	uint32_t limFrac;					/**< remainder of the slew rate in motor value/1000 */
+	uint32_t coastCyc;					/**< cycle counter at the start of the coast interval */
+	MOT_LimCnt_t limCnt;				/**< updates changed by the limiter */
 
 } MOT_MotorDevice_t;
 
-/**
- * @typedef MOT_Direction_t
- * @brief Data type definition of the enumeration MOT_Direction_e
- *
- * @enum MOT_Direction_e
- * @brief This enumeration the driving direction property
- * forward and backward of the robots a unique identification value
- */
-typedef enum MOT_Direction_e {
-	MOT_DIR_FORWARD,  /*!< Motor forward direction */ //!< MOT_DIR_FORWARD
-	MOT_DIR_BACKWARD  /*!< Motor backward direction *///!< MOT_DIR_BACKWARD
-} MOT_Direction_t;
-
 /**
  * @typedef MOT_MotorSide_t
  * @brief Data type definition of the enumeration MOT_MotorSide_e
@@ -122,6 +161,22 @@ MOT_SpeedPercent MOT_GetSpeedPercent(const MOT_MotorDevice_t *motor);
  */
 void MOT_SetSpeedPercent(MOT_MotorDevice_t *motor, MOT_SpeedPercent percent);
 
+/**
+ * @brief Sets the duty cycle of a motor as signed Q15 value, i.e. -32768 is full speed backward and
+ * 32767 is almost full speed forward. The conversion is rounded and doesn't divide.
+ * @param motor Motor handle.
+ * @param duty Duty cycle as Q15, negative values are backward.
+ */
+void MOT_SetDutyQ15(MOT_MotorDevice_t *motor, int16_t duty);
+
+/**
+ * @brief Returns the duty cycle of a motor as signed Q15 value, it is the inverse of
+ * MOT_SetDutyQ15(), i.e. a value set is read back exactly.
+ * @param motor Motor handle.
+ * @return Duty cycle as Q15, negative values are backward.
+ */
+int16_t MOT_GetDutyQ15(const MOT_MotorDevice_t *motor);
+
 /**
  * @brief Updates the motor % speed based on actual PWM value.
  * @param motor Motor handle.
@@ -130,12 +185,43 @@ void MOT_SetSpeedPercent(MOT_MotorDevice_t *motor, MOT_SpeedPercent percent);
 void MOT_UpdatePercent(MOT_MotorDevice_t *motor, MOT_Direction_t dir);
 
 /**
- * @brief Sets the PWM value for the motor.
+ * @brief Sets the PWM value for the motor. The motor value, i.e. the complement of the PWM value,
+ * is limited by the slew rate and coasts on a reversal of the direction, see MOT_Set_Lim().
  * @param motor Motor handle
  * @param val New PWM value.
  */
 void MOT_SetVal(MOT_MotorDevice_t *motor, uint16_t val);
 
+/**
+ * @brief Sets the PWM value for the motor without linearization, e.g. to calibrate the motor. The
+ * compensation of the battery voltage is still applied.
+ * @param motor Motor handle
+ * @param val New PWM value.
+ */
+void MOT_SetRawVal(MOT_MotorDevice_t *motor, uint16_t val);
+
+/**
+ * @brief Sets the linearization table of the motor. The PWM values of MOT_SetVal() are mapped
+ * onto the duty cycles by linear interpolation between the points of the table, a motor value of
+ * zero keeps the motor off.
+ * @param motor Motor handle
+ * @param aDuty Table of MOT_LIN_PT_CNT duty cycles (active high) at the motor values
+ * k << MOT_LIN_SEG_SHIFT, NULL disables the linearization
+ * @return Error code, ERR_OK if everything was fine,
+ *                     ERR_PARAM_ADDRESS otherwise
+ */
+StdRtn_t MOT_Set_LinTbl(MOT_MotorDevice_t *motor, const uint16_t *aDuty);
+
+/**
+ * @brief Reads the linearization table of the motor
+ * @param motor Motor handle
+ * @param aDuty Table of MOT_LIN_PT_CNT duty cycles (call by ref)
+ * @return Error code, ERR_OK if everything was fine,
+ *                     ERR_VALUE if the linearization is disabled,
+ *                     ERR_PARAM_ADDRESS otherwise
+ */
+StdRtn_t MOT_Read_LinTbl(const MOT_MotorDevice_t *motor, uint16_t *aDuty);
+
 /**
  * @brief Return the current PWM value of the motor.
  * @param motor Motor handle
@@ -144,7 +230,9 @@ void MOT_SetVal(MOT_MotorDevice_t *motor, uint16_t val);
 uint16_t MOT_GetVal(const MOT_MotorDevice_t *motor);
 
 /**
- * @brief Change the direction of the motor
+ * @brief Change the direction of the motor. The direction bit changes with the output, after the
+ * motor has coasted and with the H-bridge switched off, so the direction may be set before or
+ * after the PWM value.
  * @param motor Motor handle
  * @param dir Direction to be used
  */
@@ -169,6 +257,43 @@ void MOT_OnOff(bool on);
  */
 uint8_t MOT_Get_IsMotorOn(void);
 
+/*!
+ * @brief Function returns the gain of the battery voltage compensation
+ * @return gain, 1 << MOT_BATT_GAIN_SHIFT is 1.0
+ */
+uint16_t MOT_Get_BattGain(void);
+
+/**
+ * @brief Sets the limits of the outputs of both motors
+ * @param slewRate Maximum rise of the motor value per ms, 0 disables the limit
+ * @param coastMs Interval in ms, for which the motor coasts on a reversal, 0 disables the coast
+ */
+void MOT_Set_Lim(uint16_t slewRate, uint16_t coastMs);
+
+/**
+ * @brief Reads the limits of the outputs of both motors
+ * @param pSlewRate Maximum rise of the motor value per ms (call by ref)
+ * @param pCoastMs Coast interval in ms (call by ref)
+ * @return Error code, ERR_OK if everything was fine,
+ *                     ERR_PARAM_ADDRESS otherwise
+ */
+StdRtn_t MOT_Read_Lim(uint16_t *pSlewRate, uint16_t *pCoastMs);
+
+/**
+ * @brief Reads the number of updates of the motor output, which have been changed by the limiter
+ * @param motor Motor handle
+ * @param pCnt Counters of the limiter (call by ref)
+ * @return Error code, ERR_OK if everything was fine,
+ *                     ERR_PARAM_ADDRESS otherwise
+ */
+StdRtn_t MOT_Read_LimCnt(const MOT_MotorDevice_t *motor, MOT_LimCnt_t *pCnt);
+
+/**
+ * @brief Resets the counters of the limiter of the motor
+ * @param motor Motor handle
+ */
+void MOT_Reset_LimCnt(MOT_MotorDevice_t *motor);
+
 
 
 /**
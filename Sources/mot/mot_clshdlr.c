@@ -19,6 +19,7 @@
 /*======================================= >> #INCLUDES << ========================================*/
 #include "mot_clshdlr.h"
 #include "mot_api.h"
+#include "nvm_api.h"
 
 
 
@@ -32,6 +33,8 @@
 
 /*============================= >> LOKAL FUNCTION DECLARATIONS << ================================*/
 static void MOT_PrintHelp(const CLS1_StdIOType *io);
+static void MOT_PrintLimCnt(const unsigned char *title, const MOT_MotorDevice_t *motor, const CLS1_StdIOType *io);
+static StdRtn_t MOT_SaveLim(uint16_t slewRate, uint16_t coastMs, const CLS1_StdIOType *io);
 
 
 
@@ -46,17 +49,68 @@ static void MOT_PrintHelp(const CLS1_StdIOType *io) {
 	CLS1_SendHelpStr((unsigned char*)"  on|off", (unsigned char*)"Enables or disables motor\r\n", io->stdOut);
 	CLS1_SendHelpStr((unsigned char*)"  (L|R) forward|backward", (unsigned char*)"Change motor direction\r\n", io->stdOut);
 	CLS1_SendHelpStr((unsigned char*)"  (L|R) duty <number>", (unsigned char*)"Change motor PWM (-100..+100)%\r\n", io->stdOut);
+	CLS1_SendHelpStr((unsigned char*)"  slew <number>", (unsigned char*)"Sets the slew rate (0..65535 per ms, 0 is off) and saves it to the NVM\r\n", io->stdOut);
+	CLS1_SendHelpStr((unsigned char*)"  coast <ms>", (unsigned char*)"Sets the coast interval on reversal (0 is off) and saves it to the NVM\r\n", io->stdOut);
+	CLS1_SendHelpStr((unsigned char*)"  lim restore", (unsigned char*)"Restores the default limits and saves them to the NVM\r\n", io->stdOut);
+	CLS1_SendHelpStr((unsigned char*)"  lim reset", (unsigned char*)"Resets the counters of the limiters\r\n", io->stdOut);
+}
+
+static void MOT_PrintLimCnt(const unsigned char *title, const MOT_MotorDevice_t *motor, const CLS1_StdIOType *io) {
+	unsigned char buf[40];
+	MOT_LimCnt_t cnt = {0u};
+
+	(void)MOT_Read_LimCnt(motor, &cnt);
+	UTIL1_strcpy(buf, sizeof(buf), (unsigned char*)"slew ");
+	UTIL1_strcatNum32u(buf, sizeof(buf), cnt.slewCnt);
+	UTIL1_strcat(buf, sizeof(buf), (unsigned char*)", coast ");
+	UTIL1_strcatNum32u(buf, sizeof(buf), cnt.coastCnt);
+	UTIL1_strcat(buf, sizeof(buf), (unsigned char*)"\r\n");
+	CLS1_SendStatusStr(title, buf, io->stdOut);
+}
+
+static StdRtn_t MOT_SaveLim(uint16_t slewRate, uint16_t coastMs, const CLS1_StdIOType *io) {
+	NVM_MotLimCfg_t nvmLim = {0u};
+	StdRtn_t res = ERR_OK;
+
+	MOT_Set_Lim(slewRate, coastMs);
+	nvmLim.slewRate = slewRate;
+	nvmLim.coastMs = coastMs;
+	res = NVM_Save_MotLimCfg(&nvmLim);
+	if (ERR_OK != res) {
+		CLS1_SendStr((unsigned char*)"*** ERROR: Saving limits to the NVM failed ***\r\n", io->stdErr);
+	}
+	return res;
 }
 
 static void MOT_PrintStatus(const CLS1_StdIOType *io) {
 	unsigned char buf[32];
+	uint16_t slewRate = 0u, coastMs = 0u;
 
 	CLS1_SendStatusStr((unsigned char*)"Motor", (unsigned char*)"\r\n", io->stdOut);
 
 	CLS1_SendStatusStr((unsigned char*)"  inverted L", MOT_GetMotorHandle(MOT_MOTOR_LEFT)->inverted?(unsigned char*)"yes\r\n":(unsigned char*)"no\r\n", io->stdOut);
 	CLS1_SendStatusStr((unsigned char*)"  inverted R", MOT_GetMotorHandle(MOT_MOTOR_RIGHT)->inverted?(unsigned char*)"yes\r\n":(unsigned char*)"no\r\n", io->stdOut);
 
+	CLS1_SendStatusStr((unsigned char*)"  linearized L", MOT_GetMotorHandle(MOT_MOTOR_LEFT)->isLinEna?(unsigned char*)"yes\r\n":(unsigned char*)"no\r\n", io->stdOut);
+	CLS1_SendStatusStr((unsigned char*)"  linearized R", MOT_GetMotorHandle(MOT_MOTOR_RIGHT)->isLinEna?(unsigned char*)"yes\r\n":(unsigned char*)"no\r\n", io->stdOut);
+
 	CLS1_SendStatusStr((unsigned char*)"  on/off", MOT_Get_IsMotorOn()?(unsigned char*)"on\r\n":(unsigned char*)"off\r\n", io->stdOut);
+	buf[0] = '\0';
+	UTIL1_strcatNum32sDotValue100(buf, sizeof(buf), (int32_t)(((uint32_t)MOT_Get_BattGain()*100u) >> MOT_BATT_GAIN_SHIFT));
+	UTIL1_strcat(buf, sizeof(buf), (unsigned char*)"\r\n");
+	CLS1_SendStatusStr((unsigned char*)"  batt gain", buf, io->stdOut);
+
+	(void)MOT_Read_Lim(&slewRate, &coastMs);
+	buf[0] = '\0';
+	UTIL1_strcatNum16u(buf, sizeof(buf), slewRate);
+	UTIL1_strcat(buf, sizeof(buf), (unsigned char*)(0u == slewRate ? " (off)\r\n" : " per ms\r\n"));
+	CLS1_SendStatusStr((unsigned char*)"  slew rate", buf, io->stdOut);
+	buf[0] = '\0';
+	UTIL1_strcatNum16u(buf, sizeof(buf), coastMs);
+	UTIL1_strcat(buf, sizeof(buf), (unsigned char*)(0u == coastMs ? " ms (off)\r\n" : " ms\r\n"));
+	CLS1_SendStatusStr((unsigned char*)"  coast", buf, io->stdOut);
+	MOT_PrintLimCnt((unsigned char*)"  limited L", MOT_GetMotorHandle(MOT_MOTOR_LEFT), io);
+	MOT_PrintLimCnt((unsigned char*)"  limited R", MOT_GetMotorHandle(MOT_MOTOR_RIGHT), io);
 	CLS1_SendStatusStr((unsigned char*)"  motor L", (unsigned char*)"", io->stdOut);
 	buf[0] = '\0';
 
@@ -86,6 +140,8 @@ static void MOT_PrintStatus(const CLS1_StdIOType *io) {
 uint8_t MOT_ParseCommand(const unsigned char *cmd, bool *handled, const CLS1_StdIOType *io) {
 	uint8_t res = ERR_OK;
 	int32_t val;
+	uint16_t slewRate = 0u, coastMs = 0u;
+	NVM_MotLimCfg_t nvmLim = {0u};
 	const unsigned char *p;
 	unsigned char buf[32];
 
@@ -135,6 +191,34 @@ uint8_t MOT_ParseCommand(const unsigned char *cmd, bool *handled, const CLS1_Std
 				res = ERR_FAILED;
 			}
 		}
+	} else if (UTIL1_strncmp((char*)cmd, (char*)"motor slew ", sizeof("motor slew ")-1)==0) {
+		p = cmd+sizeof("motor slew");
+		(void)MOT_Read_Lim(&slewRate, &coastMs);
+		if (UTIL1_xatoi(&p, &val)==ERR_OK && val >=0 && val<=0xFFFF) {
+			res = MOT_SaveLim((uint16_t)val, coastMs, io);
+			*handled = TRUE;
+		} else {
+			CLS1_SendStr((unsigned char*)"Wrong argument, must be in the range 0..65535\r\n", io->stdErr);
+			res = ERR_FAILED;
+		}
+	} else if (UTIL1_strncmp((char*)cmd, (char*)"motor coast ", sizeof("motor coast ")-1)==0) {
+		p = cmd+sizeof("motor coast");
+		(void)MOT_Read_Lim(&slewRate, &coastMs);
+		if (UTIL1_xatoi(&p, &val)==ERR_OK && val >=0 && val<=100) {
+			res = MOT_SaveLim(slewRate, (uint16_t)val, io);
+			*handled = TRUE;
+		} else {
+			CLS1_SendStr((unsigned char*)"Wrong argument, must be in the range 0..100\r\n", io->stdErr);
+			res = ERR_FAILED;
+		}
+	} else if (UTIL1_strcmp((char*)cmd, (char*)"motor lim restore")==0) {
+		(void)NVM_Read_Dflt_MotLimCfg(&nvmLim);
+		res = MOT_SaveLim(nvmLim.slewRate, nvmLim.coastMs, io);
+		*handled = TRUE;
+	} else if (UTIL1_strcmp((char*)cmd, (char*)"motor lim reset")==0) {
+		MOT_Reset_LimCnt(MOT_GetMotorHandle(MOT_MOTOR_LEFT));
+		MOT_Reset_LimCnt(MOT_GetMotorHandle(MOT_MOTOR_RIGHT));
+		*handled = TRUE;
 	} else if (UTIL1_strncmp((char*)cmd, (char*)"motor on", sizeof("motor on")-1)==0) {
 		 MOT_OnOff(TRUE);
 		*handled = TRUE;
@@ -0,0 +1,668 @@
+/***********************************************************************************************//**
+ * @file		mtx.c
+ * @ingroup		mtx
+ * @brief 		This module implements the basic matrix operations on matrix views
+ *
+ *	This module implements the operations behind the MTX_* macros for the view type MTX_t. A view
+ *	refers to row-major storage of exactly the needed size provided by the caller, hence no
+ *	operation reserves FIXMATRIX_MAX_SIZE x FIXMATRIX_MAX_SIZE elements. Only the decompositions
+ *	and the solver of the fixmatrix library are bridged through a temporary mf16 object.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	12.04.2018
+ *
+ * @copyright @<LGPL2_1>
+ *
+ ***************************************************************************************************/
+
+#define MASTER_mtx_C_
+
+/*======================================= >> #INCLUDES << ========================================*/
+#include "Platform.h"
+#include "fixmatrix.h"
+#include "mtx_api.h"
+
+
+
+/*======================================= >> #DEFINES << =========================================*/
+/**
+ * @brief Sum of squares in Q32.32 whose square root doesn't fit into Q16.16 anymore
+ */
+#define MTX_NORM_SQ_MAX		(((int64_t)1) << 62)
+
+/**
+ * @brief Norms below this value are treated as zero by the QR decomposition, same as fixmatrix
+ */
+#define MTX_NORM_MIN		(5)
+
+/**
+ * @brief Negative values above this limit are treated as rounding errors in the Cholesky
+ * decomposition, same as fixmatrix
+ */
+#define MTX_CHOL_NEG_LIM	(-65)
+
+
+
+/*=================================== >> TYPE DEFINITIONS << =====================================*/
+
+
+
+/*============================= >> LOKAL FUNCTION DECLARATIONS << ================================*/
+static bool MTX_HasDim(const MTX_t *mtx_, uint8_t rows_, uint8_t columns_);
+static bool MTX_IsPartialAlias(const MTX_t *a_, const MTX_t *b_);
+static fix16_t MTX_Narrow(int64_t val_, uint8_t *errors_);
+static uint32_t MTX_Sqrt64(uint64_t val_);
+static fix16_t MTX_Norm(const fix16_t *v_, uint8_t stride_, uint8_t n_, uint8_t *errors_);
+
+
+
+/*=================================== >> GLOBAL VARIABLES << =====================================*/
+
+
+
+/*============================== >> LOKAL FUNCTION DEFINITIONS << ================================*/
+static bool MTX_HasDim(const MTX_t *mtx_, uint8_t rows_, uint8_t columns_)
+{
+	return (bool)( (rows_ == mtx_->rows) && (columns_ == mtx_->columns) );
+}
+
+/**
+ * @brief Checks whether two views overlap without referring to the same elements, such views can't
+ * be processed in place
+ */
+static bool MTX_IsPartialAlias(const MTX_t *a_, const MTX_t *b_)
+{
+	return (bool)( MTX_IS_ALIAS(a_, b_) && !MTX_IS_SAME(a_, b_) );
+}
+
+/**
+ * @brief Converts a Q48.16 value to Q16.16, sets FIXMATRIX_OVERFLOW if it doesn't fit
+ */
+static fix16_t MTX_Narrow(int64_t val_, uint8_t *errors_)
+{
+	fix16_t retVal = (fix16_t)val_;
+
+	if( (val_ > (int64_t)fix16_maximum) || (val_ <= (int64_t)fix16_minimum) )
+	{
+		*errors_ |= FIXMATRIX_OVERFLOW;
+		retVal = fix16_overflow;
+	}
+	return retVal;
+}
+
+/**
+ * @brief Square root of a 64 bit integer rounded to the nearest integer, val_ must be less than 2^62
+ */
+static uint32_t MTX_Sqrt64(uint64_t val_)
+{
+	uint32_t res = MTX_ISqrt(val_);
+
+	if( (val_ - (uint64_t)res * res) > res ) /* sqrt(val_) >= res + 1/2 if the remainder exceeds res */
+	{
+		res++;
+	}
+	return res;
+}
+
+/**
+ * @brief Euclidean norm of a strided Q16.16 vector, the squares are summed up in Q32.32
+ */
+static fix16_t MTX_Norm(const fix16_t *v_, uint8_t stride_, uint8_t n_, uint8_t *errors_)
+{
+	int64_t sq = MTX_Dot32d32(v_, stride_, v_, stride_, n_);
+	fix16_t retVal = fix16_overflow;
+
+	if( (sq < 0) || (sq >= MTX_NORM_SQ_MAX) )
+	{
+		*errors_ |= FIXMATRIX_OVERFLOW;
+	}
+	else
+	{
+		retVal = MTX_Narrow((int64_t)MTX_Sqrt64((uint64_t)sq), errors_);
+	}
+	return retVal;
+}
+
+
+
+/*============================= >> GLOBAL FUNCTION DEFINITIONS << ================================*/
+void MTX_ViewFill(MTX_t *dest_, fix16_t val_)
+{
+	uint8_t row = 0u, column = 0u;
+	for(row = 0u; row < dest_->rows; row++)
+	{
+		for(column = 0u; column < dest_->columns; column++)
+		{
+			MTX_AT(dest_, row, column) = val_;
+		}
+	}
+}
+
+void MTX_ViewFillDiagonal(MTX_t *dest_, fix16_t val_)
+{
+	uint8_t row = 0u;
+	MTX_ViewFill(dest_, 0);
+	for(row = 0u; (row < dest_->rows) && (row < dest_->columns); row++)
+	{
+		MTX_AT(dest_, row, row) = val_;
+	}
+}
+
+void MTX_ViewMult(MTX_t *dest_, const MTX_t *fac1_, const MTX_t *fac2_)
+{
+	uint8_t row = 0u, column = 0u;
+	fix16_t sum = 0;
+
+	dest_->errors = fac1_->errors | fac2_->errors;
+	if( (fac1_->columns != fac2_->rows) || (FALSE == MTX_HasDim(dest_, fac1_->rows, fac2_->columns)) )
+	{
+		dest_->errors |= FIXMATRIX_DIMERR;
+	}
+	else if( MTX_IS_ALIAS(dest_, fac1_) || MTX_IS_ALIAS(dest_, fac2_) )
+	{
+		dest_->errors |= FIXMATRIX_USEERR;
+	}
+	else
+	{
+		for(row = 0u; row < dest_->rows; row++)
+		{
+			for(column = 0u; column < dest_->columns; column++)
+			{
+				sum = MTX_Dot(&MTX_AT(fac1_, row, 0), 1, &MTX_AT(fac2_, 0, column), fac2_->stride, fac1_->columns);
+				if(fix16_overflow == sum)
+				{
+					dest_->errors |= FIXMATRIX_OVERFLOW;
+				}
+				MTX_AT(dest_, row, column) = sum;
+			}
+		}
+	}
+}
+
+void MTX_ViewMultAt(MTX_t *dest_, const MTX_t *fac1_, const MTX_t *fac2_)
+{
+	uint8_t row = 0u, column = 0u;
+	fix16_t sum = 0;
+
+	dest_->errors = fac1_->errors | fac2_->errors;
+	if( (fac1_->rows != fac2_->rows) || (FALSE == MTX_HasDim(dest_, fac1_->columns, fac2_->columns)) )
+	{
+		dest_->errors |= FIXMATRIX_DIMERR;
+	}
+	else if( MTX_IS_ALIAS(dest_, fac1_) || MTX_IS_ALIAS(dest_, fac2_) )
+	{
+		dest_->errors |= FIXMATRIX_USEERR;
+	}
+	else
+	{
+		for(row = 0u; row < dest_->rows; row++)
+		{
+			for(column = 0u; column < dest_->columns; column++)
+			{
+				sum = MTX_Dot(&MTX_AT(fac1_, 0, row), fac1_->stride, &MTX_AT(fac2_, 0, column), fac2_->stride, fac1_->rows);
+				if(fix16_overflow == sum)
+				{
+					dest_->errors |= FIXMATRIX_OVERFLOW;
+				}
+				MTX_AT(dest_, row, column) = sum;
+			}
+		}
+	}
+}
+
+void MTX_ViewMultBt(MTX_t *dest_, const MTX_t *fac1_, const MTX_t *fac2_)
+{
+	uint8_t row = 0u, column = 0u;
+	fix16_t sum = 0;
+
+	dest_->errors = fac1_->errors | fac2_->errors;
+	if( (fac1_->columns != fac2_->columns) || (FALSE == MTX_HasDim(dest_, fac1_->rows, fac2_->rows)) )
+	{
+		dest_->errors |= FIXMATRIX_DIMERR;
+	}
+	else if( MTX_IS_ALIAS(dest_, fac1_) || MTX_IS_ALIAS(dest_, fac2_) )
+	{
+		dest_->errors |= FIXMATRIX_USEERR;
+	}
+	else
+	{
+		for(row = 0u; row < dest_->rows; row++)
+		{
+			for(column = 0u; column < dest_->columns; column++)
+			{
+				sum = MTX_Dot(&MTX_AT(fac1_, row, 0), 1, &MTX_AT(fac2_, column, 0), 1, fac1_->columns);
+				if(fix16_overflow == sum)
+				{
+					dest_->errors |= FIXMATRIX_OVERFLOW;
+				}
+				MTX_AT(dest_, row, column) = sum;
+			}
+		}
+	}
+}
+
+void MTX_ViewAdd(MTX_t *dest_, const MTX_t *sum1_, const MTX_t *sum2_)
+{
+	uint8_t row = 0u, column = 0u;
+	fix16_t sum = 0;
+
+	dest_->errors = sum1_->errors | sum2_->errors;
+	if( (FALSE == MTX_HasDim(sum2_, sum1_->rows, sum1_->columns)) || (FALSE == MTX_HasDim(dest_, sum1_->rows, sum1_->columns)) )
+	{
+		dest_->errors |= FIXMATRIX_DIMERR;
+	}
+	else if( MTX_IsPartialAlias(dest_, sum1_) || MTX_IsPartialAlias(dest_, sum2_) )
+	{
+		dest_->errors |= FIXMATRIX_USEERR;
+	}
+	else
+	{
+		for(row = 0u; row < dest_->rows; row++)
+		{
+			for(column = 0u; column < dest_->columns; column++)
+			{
+				sum = fix16_add(MTX_AT(sum1_, row, column), MTX_AT(sum2_, row, column));
+				if(fix16_overflow == sum)
+				{
+					dest_->errors |= FIXMATRIX_OVERFLOW;
+				}
+				MTX_AT(dest_, row, column) = sum;
+			}
+		}
+	}
+}
+
+void MTX_ViewSub(MTX_t *dest_, const MTX_t *min_, const MTX_t *sub_)
+{
+	uint8_t row = 0u, column = 0u;
+	fix16_t diff = 0;
+
+	dest_->errors = min_->errors | sub_->errors;
+	if( (FALSE == MTX_HasDim(sub_, min_->rows, min_->columns)) || (FALSE == MTX_HasDim(dest_, min_->rows, min_->columns)) )
+	{
+		dest_->errors |= FIXMATRIX_DIMERR;
+	}
+	else if( MTX_IsPartialAlias(dest_, min_) || MTX_IsPartialAlias(dest_, sub_) )
+	{
+		dest_->errors |= FIXMATRIX_USEERR;
+	}
+	else
+	{
+		for(row = 0u; row < dest_->rows; row++)
+		{
+			for(column = 0u; column < dest_->columns; column++)
+			{
+				diff = fix16_sub(MTX_AT(min_, row, column), MTX_AT(sub_, row, column));
+				if(fix16_overflow == diff)
+				{
+					dest_->errors |= FIXMATRIX_OVERFLOW;
+				}
+				MTX_AT(dest_, row, column) = diff;
+			}
+		}
+	}
+}
+
+void MTX_ViewTranspose(MTX_t *dest_, const MTX_t *mtx_)
+{
+	uint8_t row = 0u, column = 0u;
+	fix16_t tmp = 0;
+
+	dest_->errors = mtx_->errors;
+	if( FALSE == MTX_HasDim(dest_, mtx_->columns, mtx_->rows) )
+	{
+		dest_->errors |= FIXMATRIX_DIMERR;
+	}
+	else if( MTX_IS_ALIAS(dest_, mtx_) )
+	{
+		if( (mtx_->rows != mtx_->columns) || !MTX_IS_SAME(dest_, mtx_) )
+		{
+			dest_->errors |= FIXMATRIX_USEERR;
+		}
+		else
+		{
+			for(row = 0u; row < dest_->rows; row++)
+			{
+				for(column = (row + 1u); column < dest_->columns; column++)
+				{
+					tmp = MTX_AT(dest_, row, column);
+					MTX_AT(dest_, row, column) = MTX_AT(dest_, column, row);
+					MTX_AT(dest_, column, row) = tmp;
+				}
+			}
+		}
+	}
+	else
+	{
+		for(row = 0u; row < dest_->rows; row++)
+		{
+			for(column = 0u; column < dest_->columns; column++)
+			{
+				MTX_AT(dest_, row, column) = MTX_AT(mtx_, column, row);
+			}
+		}
+	}
+}
+
+void MTX_ViewMultScalar(MTX_t *dest_, const MTX_t *mtx_, fix16_t val_)
+{
+	uint8_t row = 0u, column = 0u;
+	fix16_t prod = 0;
+
+	dest_->errors = mtx_->errors;
+	if( FALSE == MTX_HasDim(dest_, mtx_->rows, mtx_->columns) )
+	{
+		dest_->errors |= FIXMATRIX_DIMERR;
+	}
+	else if( MTX_IsPartialAlias(dest_, mtx_) )
+	{
+		dest_->errors |= FIXMATRIX_USEERR;
+	}
+	else
+	{
+		for(row = 0u; row < dest_->rows; row++)
+		{
+			for(column = 0u; column < dest_->columns; column++)
+			{
+				prod = fix16_mul(MTX_AT(mtx_, row, column), val_);
+				if(fix16_overflow == prod)
+				{
+					dest_->errors |= FIXMATRIX_OVERFLOW;
+				}
+				MTX_AT(dest_, row, column) = prod;
+			}
+		}
+	}
+}
+
+void MTX_ViewDivScalar(MTX_t *dest_, const MTX_t *mtx_, fix16_t val_)
+{
+	uint8_t row = 0u, column = 0u;
+	fix16_t quot = 0;
+
+	dest_->errors = mtx_->errors;
+	if( FALSE == MTX_HasDim(dest_, mtx_->rows, mtx_->columns) )
+	{
+		dest_->errors |= FIXMATRIX_DIMERR;
+	}
+	else if( MTX_IsPartialAlias(dest_, mtx_) )
+	{
+		dest_->errors |= FIXMATRIX_USEERR;
+	}
+	else
+	{
+		for(row = 0u; row < dest_->rows; row++)
+		{
+			for(column = 0u; column < dest_->columns; column++)
+			{
+				quot = fix16_div(MTX_AT(mtx_, row, column), val_);
+				if(fix16_overflow == quot)
+				{
+					dest_->errors |= FIXMATRIX_OVERFLOW;
+				}
+				MTX_AT(dest_, row, column) = quot;
+			}
+		}
+	}
+}
+
+void MTX_ViewCopy(MTX_t *dest_, const MTX_t *mtx_)
+{
+	uint8_t row = 0u, column = 0u;
+
+	dest_->errors = mtx_->errors;
+	if( FALSE == MTX_HasDim(dest_, mtx_->rows, mtx_->columns) )
+	{
+		dest_->errors |= FIXMATRIX_DIMERR;
+	}
+	else if( MTX_IsPartialAlias(dest_, mtx_) )
+	{
+		dest_->errors |= FIXMATRIX_USEERR;
+	}
+	else if( !MTX_IS_SAME(dest_, mtx_) )
+	{
+		for(row = 0u; row < dest_->rows; row++)
+		{
+			for(column = 0u; column < dest_->columns; column++)
+			{
+				MTX_AT(dest_, row, column) = MTX_AT(mtx_, row, column);
+			}
+		}
+	}
+}
+
+void MTX_ViewQrDecomposition(MTX_t *q_, MTX_t *r_, const MTX_t *mtx_, const uint8_t reOrthCnt_)
+{
+	uint8_t i = 0u, j = 0u, k = 0u, reOrth = 0u;
+	fix16_t dot = 0, norm = 0, tmp = 0;
+
+	/* modified Gram-Schmidt on the columns of Q, the previous columns are already normalized */
+	MTX_ViewCopy(q_, mtx_);
+	if( FALSE == MTX_HasDim(r_, mtx_->columns, mtx_->columns) )
+	{
+		q_->errors |= FIXMATRIX_DIMERR;
+	}
+	else if( MTX_IS_ALIAS(r_, q_) || MTX_IS_ALIAS(r_, mtx_) )
+	{
+		q_->errors |= FIXMATRIX_USEERR;
+	}
+	if( 0u == (q_->errors & (FIXMATRIX_DIMERR | FIXMATRIX_USEERR)) )
+	{
+		MTX_ViewFill(r_, 0);
+		for(j = 0u; j < q_->columns; j++)
+		{
+			for(reOrth = 0u; reOrth <= reOrthCnt_; reOrth++)
+			{
+				for(i = 0u; i < j; i++)
+				{
+					dot = MTX_Dot(&MTX_AT(q_, 0, j), q_->stride, &MTX_AT(q_, 0, i), q_->stride, q_->rows);
+					if(fix16_overflow == dot)
+					{
+						q_->errors |= FIXMATRIX_OVERFLOW;
+					}
+					for(k = 0u; k < q_->rows; k++)
+					{
+						tmp = fix16_sub(MTX_AT(q_, k, j), fix16_mul(dot, MTX_AT(q_, k, i)));
+						if(fix16_overflow == tmp)
+						{
+							q_->errors |= FIXMATRIX_OVERFLOW;
+						}
+						MTX_AT(q_, k, j) = tmp;
+					}
+					MTX_AT(r_, i, j) = fix16_add(MTX_AT(r_, i, j), dot);
+				}
+			}
+			norm = MTX_Norm(&MTX_AT(q_, 0, j), q_->stride, q_->rows, &q_->errors);
+			if(norm < MTX_NORM_MIN)
+			{
+				q_->errors |= FIXMATRIX_SINGULAR;
+				norm = 0;
+			}
+			else
+			{
+				for(k = 0u; k < q_->rows; k++)
+				{
+					MTX_AT(q_, k, j) = fix16_div(MTX_AT(q_, k, j), norm);
+				}
+			}
+			MTX_AT(r_, j, j) = norm;
+		}
+	}
+	r_->errors = q_->errors;
+}
+
+void MTX_ViewSolve(MTX_t *dest_, const MTX_t *q_, const MTX_t *r_, const MTX_t *mtx_)
+{
+	int8_t row = 0;
+	uint8_t column = 0u, n = r_->rows;
+	int64_t sum = 0;
+
+	dest_->errors = (q_->errors | r_->errors | mtx_->errors);
+	if( (q_->rows != mtx_->rows) || (FALSE == MTX_HasDim(r_, q_->columns, q_->columns)) ||
+		(FALSE == MTX_HasDim(dest_, r_->columns, mtx_->columns)) )
+	{
+		dest_->errors |= FIXMATRIX_DIMERR;
+	}
+	else if( MTX_IS_ALIAS(dest_, q_) || MTX_IS_ALIAS(dest_, r_) || MTX_IS_ALIAS(dest_, mtx_) )
+	{
+		dest_->errors |= FIXMATRIX_USEERR;
+	}
+	else
+	{
+		for(column = 0u; column < mtx_->columns; column++)
+		{
+			/* y = Q'b */
+			for(row = 0; row < n; row++)
+			{
+				MTX_AT(dest_, row, column) = MTX_Narrow(MTX_Dot48d16(&MTX_AT(q_, 0, row), q_->stride,
+																	 &MTX_AT(mtx_, 0, column), mtx_->stride, q_->rows), &dest_->errors);
+			}
+			/* Rx = y by back substitution */
+			for(row = (n-1); row >= 0; row--)
+			{
+				sum  = MTX_AT(dest_, row, column);
+				sum -= MTX_Dot48d16(&MTX_AT(r_, row, row+1), 1, &MTX_AT(dest_, row+1, column), dest_->stride, (n-1)-row);
+				if(0 == MTX_AT(r_, row, row))
+				{
+					dest_->errors |= FIXMATRIX_SINGULAR;
+					MTX_AT(dest_, row, column) = 0;
+				}
+				else
+				{
+					MTX_AT(dest_, row, column) = fix16_div(MTX_Narrow(sum, &dest_->errors), MTX_AT(r_, row, row));
+					if(fix16_overflow == MTX_AT(dest_, row, column))
+					{
+						dest_->errors |= FIXMATRIX_OVERFLOW;
+					}
+				}
+			}
+		}
+	}
+}
+
+void MTX_ViewCholesky(MTX_t *dest_, const MTX_t *mtx_)
+{
+	uint8_t row = 0u, column = 0u;
+	int64_t val = 0;
+
+	/* Cholesky-Banachiewicz, row by row, hence A can be overwritten by L in place */
+	dest_->errors = mtx_->errors;
+	if( (mtx_->rows != mtx_->columns) || (FALSE == MTX_HasDim(dest_, mtx_->rows, mtx_->columns)) )
+	{
+		dest_->errors |= FIXMATRIX_DIMERR;
+	}
+	else if( MTX_IsPartialAlias(dest_, mtx_) )
+	{
+		dest_->errors |= FIXMATRIX_USEERR;
+	}
+	else
+	{
+		for(row = 0u; row < dest_->rows; row++)
+		{
+			for(column = 0u; column <= row; column++)
+			{
+				/* A(i,j) - sum(L(i,k)*L(j,k), k = 0..j-1) */
+				val  = MTX_AT(mtx_, row, column);
+				val -= MTX_Dot48d16(&MTX_AT(dest_, row, 0), 1, &MTX_AT(dest_, column, 0), 1, column);
+				if(row == column)
+				{
+					if(val < 0)
+					{
+						if(val < MTX_CHOL_NEG_LIM)
+						{
+							dest_->errors |= FIXMATRIX_NEGATIVE;
+						}
+						val = 0;
+					}
+					if(val > (int64_t)fix16_maximum)
+					{
+						dest_->errors |= FIXMATRIX_OVERFLOW;
+						val = fix16_maximum;
+					}
+					MTX_AT(dest_, row, row) = (fix16_t)MTX_Sqrt64(((uint64_t)val) << 16);
+				}
+				else if(0 == MTX_AT(dest_, column, column))
+				{
+					dest_->errors |= FIXMATRIX_SINGULAR;
+					MTX_AT(dest_, row, column) = 0;
+				}
+				else
+				{
+					MTX_AT(dest_, row, column) = fix16_div(MTX_Narrow(val, &dest_->errors), MTX_AT(dest_, column, column));
+					if(fix16_overflow == MTX_AT(dest_, row, column))
+					{
+						dest_->errors |= FIXMATRIX_OVERFLOW;
+					}
+				}
+			}
+			for(column = (row + 1u); column < dest_->columns; column++)
+			{
+				MTX_AT(dest_, row, column) = 0;
+			}
+		}
+	}
+}
+
+void MTX_ViewInvertLowerTri(MTX_t *dest_, const MTX_t *mtx_)
+{
+	int8_t i = 0, j = 0;
+	uint8_t n = mtx_->rows, k = 0u;
+	fix16_t ljj = 0, tmp = 0;
+
+	/* A^-1 = L^-T * L^-1 is built in place in the lower triangle of dest_ and mirrored at the end */
+	MTX_ViewCopy(dest_, mtx_);
+	if(mtx_->rows != mtx_->columns)
+	{
+		dest_->errors |= FIXMATRIX_DIMERR;
+	}
+	if( 0u == (dest_->errors & (FIXMATRIX_DIMERR | FIXMATRIX_USEERR)) )
+	{
+		/* L^-1 column by column from the right, the inverted columns are right of column j */
+		for(j = (n-1); j >= 0; j--)
+		{
+			if(0 == MTX_AT(dest_, j, j))
+			{
+				dest_->errors |= FIXMATRIX_SINGULAR;
+				continue;
+			}
+			MTX_AT(dest_, j, j) = fix16_div(fix16_one, MTX_AT(dest_, j, j));
+			ljj = -MTX_AT(dest_, j, j);
+			if(fix16_overflow == MTX_AT(dest_, j, j))
+			{
+				dest_->errors |= FIXMATRIX_OVERFLOW;
+			}
+			/* x = -L^-1(j,j) * L^-1(j+1:n, j+1:n) * L(j+1:n, j) from the bottom up, hence in place */
+			for(i = (n-1); i > j; i--)
+			{
+				tmp = MTX_Narrow(MTX_Dot48d16(&MTX_AT(dest_, i, j+1), 1, &MTX_AT(dest_, j+1, j), dest_->stride, i-j), &dest_->errors);
+				tmp = fix16_mul(tmp, ljj);
+				if(fix16_overflow == tmp)
+				{
+					dest_->errors |= FIXMATRIX_OVERFLOW;
+				}
+				MTX_AT(dest_, i, j) = tmp;
+			}
+		}
+		/* lower triangle of L^-T * L^-1 row by row from the top, each row only needs the rows below */
+		for(i = 0; i < n; i++)
+		{
+			for(j = 0; j <= i; j++)
+			{
+				MTX_AT(dest_, i, j) = MTX_Narrow(MTX_Dot48d16(&MTX_AT(dest_, i, j), dest_->stride, &MTX_AT(dest_, i, i), dest_->stride, n-i), &dest_->errors);
+			}
+		}
+		for(i = 0; i < n; i++)
+		{
+			for(k = (i + 1u); k < n; k++)
+			{
+				MTX_AT(dest_, i, k) = MTX_AT(dest_, k, i);
+			}
+		}
+	}
+}
+
+
+
+#ifdef MASTER_mtx_C_
+#undef MASTER_mtx_C_
+#endif /* !MASTER_mtx_C_ */
@@ -24,7 +24,7 @@
 
 
 
-#ifdef MASTER_mtx_api_C_
+#if defined(MASTER_mtx_C_) || defined(MASTER_mtx_kernel_C_)
 #define EXTERNAL_
 #else
 #define EXTERNAL_ extern
@@ -35,97 +35,173 @@
  * @{
  */
 /*======================================= >> #DEFINES << =========================================*/
+/**
+ * @brief Selects the dot product kernels: 1 = Cortex-M4 DSP instruction SMLAL, 0 = portable C.
+ * Defaults to the DSP kernels if the compiler targets a core with the DSP extension.
+ */
+#ifndef MTX_CFG_DSP_KERNELS
+#if defined(__ARM_FEATURE_DSP) && (1 == __ARM_FEATURE_DSP)
+#define MTX_CFG_DSP_KERNELS (1)
+#else
+#define MTX_CFG_DSP_KERNELS (0)
+#endif
+#endif
+
+/**
+ * @brief Initializer for a matrix view over caller-provided storage
+ * @param[in] rows_ number of rows
+ * @param[in] cols_ number of columns
+ * @param[in] storage_ pointer to at least rows_*cols_ elements of type fix16_t (row-major)
+ */
+#define MTX_VIEW_INIT(rows_, cols_, storage_) {(rows_), (cols_), (cols_), 0u, (storage_)}
+
+/**
+ * @brief Element access A(row, col) of a matrix view
+ * @param[in] mtx_ pointer to the matrix view
+ * @param[in] row_ zero-based row index
+ * @param[in] col_ zero-based column index
+ */
+#define MTX_AT(mtx_, row_, col_) ((mtx_)->data[(row_)*(mtx_)->stride + (col_)])
+
+/**
+ * @brief Address behind the last element of a matrix view
+ * @param[in] mtx_ pointer to the matrix view, must have at least one element
+ */
+#define MTX_END(mtx_) (&MTX_AT(mtx_, (mtx_)->rows - 1, (mtx_)->columns))
+
+/**
+ * @brief Checks whether the storage of two matrix views overlaps. The address ranges from the first
+ * to the last element are compared, hence two views with interleaved rows, e.g. two column blocks of
+ * the same matrix, are reported as overlapping as well.
+ * @param[in] a_ pointer to the first matrix view
+ * @param[in] b_ pointer to the second matrix view
+ */
+#define MTX_IS_ALIAS(a_, b_) ( (0u != (a_)->rows) && (0u != (a_)->columns) &&\
+							   (0u != (b_)->rows) && (0u != (b_)->columns) &&\
+							   ((a_)->data < MTX_END(b_)) && ((b_)->data < MTX_END(a_)) )
+
+/**
+ * @brief Checks whether two matrix views of equal dimensions refer to the same elements
+ * @param[in] a_ pointer to the first matrix view
+ * @param[in] b_ pointer to the second matrix view
+ */
+#define MTX_IS_SAME(a_, b_) ( ((a_)->data == (b_)->data) && ((a_)->stride == (b_)->stride) )
+
 /**
  * @brief Produces A = ones(rows(A), cols(A)) * value
  * @param[in] val_ = value
  * @param[in,out] dest_ = A
  */
-#define MTX_Fill(dest_, val_) (mf16_fill(dest_, val_))
+#define MTX_Fill(dest_, val_) (MTX_ViewFill(dest_, val_))
 
 /**
  * @brief Produces A = diag{value}
  * @param[in] val_ = value
  * @param[in,out] dest_ = A
  */
-#define MTX_FillDiagonal(dest_, val_) (mf16_fill_diagonal(dest_, val_))
+#define MTX_FillDiagonal(dest_, val_) (MTX_ViewFillDiagonal(dest_, val_))
 
 /**
  * @brief Produces A = B * C
  * @param[in,out] dest_ = A
  * @param[in] fac1_ = B
  * @param[in] fac2_ = C
+ * @remark dest_ must not alias with fac1_ or fac2_
  * @return dest_->errors = FIXMATRIX_DIMERR if dimensions don't agree <br>
- * 		   dest_->errors = FIXMATRIX_OVERFLOW if any overflow occurred
+ * 		   dest_->errors = FIXMATRIX_OVERFLOW if any overflow occurred <br>
+ * 		   dest_->errors = FIXMATRIX_USEERR if dest_ aliases with an operand
  */
-#define MTX_Mult(dest_, fac1_, fac2_) (mf16_mul(dest_, fac1_, fac2_))
+#define MTX_Mult(dest_, fac1_, fac2_) (MTX_ViewMult(dest_, fac1_, fac2_))
 
 /**
  * @brief Produces A = B' * C
  * @param[in,out] dest_ = A
  * @param[in] fac1_ = B
  * @param[in] fac2_ = C
+ * @remark dest_ must not alias with fac1_ or fac2_
  * @return dest_->errors = FIXMATRIX_DIMERR if dimensions don't agree <br>
- * 		   dest_->errors FIXMATRIX_OVERFLOW if any overflow occurred
+ * 		   dest_->errors = FIXMATRIX_OVERFLOW if any overflow occurred <br>
+ * 		   dest_->errors = FIXMATRIX_USEERR if dest_ aliases with an operand
  */
-#define MTX_MultAt(dest_, fac1_, fac2_) (mf16_mul_at(dest_, fac1_, fac2_))
+#define MTX_MultAt(dest_, fac1_, fac2_) (MTX_ViewMultAt(dest_, fac1_, fac2_))
 
 /**
  * @brief Produces A = B * C'
  * @param[in,out] dest_ = A
  * @param[in] fac1_ = B
  * @param[in] fac2_ = C
+ * @remark dest_ must not alias with fac1_ or fac2_
  * @return dest_->errors = FIXMATRIX_DIMERR if dimensions don't agree <br>
- * 		   dest_->errors = FIXMATRIX_OVERFLOW if any overflow occurred
+ * 		   dest_->errors = FIXMATRIX_OVERFLOW if any overflow occurred <br>
+ * 		   dest_->errors = FIXMATRIX_USEERR if dest_ aliases with an operand
  */
-#define MTX_MultBt(dest_, fac1_, fac2_) (mf16_mul_bt(dest_, fac1_, fac2_))
+#define MTX_MultBt(dest_, fac1_, fac2_) (MTX_ViewMultBt(dest_, fac1_, fac2_))
 
 /**
  * @brief Produces A = B + C.
  * @param[in,out] dest_ = A
  * @param[in] sum1_ = B
  * @param[in] sum2_ = C
- * @remark sum1_ and sum2_ can alias with dest_, respectively
+ * @remark sum1_ and sum2_ can alias with dest_, respectively, if they refer to the same elements
  * @return dest_->errors = FIXMATRIX_DIMERR if dimensions don't agree <br>
- * 		   dest_->errors = FIXMATRIX_OVERFLOW if any overflow occurred
+ * 		   dest_->errors = FIXMATRIX_OVERFLOW if any overflow occurred <br>
+ * 		   dest_->errors = FIXMATRIX_USEERR if dest_ partially overlaps with an operand
  */
-#define MTX_Add(dest_, sum1_, sum2_) (mf16_add(dest_, sum1_, sum2_))
+#define MTX_Add(dest_, sum1_, sum2_) (MTX_ViewAdd(dest_, sum1_, sum2_))
 
 /**
  * @brief Produces A = B - C.
  * @param[in,out] dest_ = A
  * @param[in] min_ = B
  * @param[in] sub_ = C
- * @remark min_ and sub_ can alias with dest_, respectively
+ * @remark min_ and sub_ can alias with dest_, respectively, if they refer to the same elements
  * @return dest_->errors = FIXMATRIX_DIMERR if dimensions don't agree <br>
- * 		   dest_->errors = FIXMATRIX_OVERFLOW if any overflow occurred
+ * 		   dest_->errors = FIXMATRIX_OVERFLOW if any overflow occurred <br>
+ * 		   dest_->errors = FIXMATRIX_USEERR if dest_ partially overlaps with an operand
  */
-#define MTX_Sub(dest_, min_, sub_) (mf16_sub(dest_, min_, sub_))
+#define MTX_Sub(dest_, min_, sub_) (MTX_ViewSub(dest_, min_, sub_))
 
 /**
  * @brief Calculates the transpose A = B' and copies errors.
  * @param[in,out] dest_ = A
  * @param[in] mtx_ = B
- * @remark dest_ and mtx_ can alias
+ * @remark dest_ and mtx_ can only alias if B is square and they refer to the same elements
+ * @return dest_->errors = FIXMATRIX_DIMERR if dimensions don't agree <br>
+ * 		   dest_->errors = FIXMATRIX_USEERR if dest_ aliases with mtx_ otherwise
  */
-#define MTX_Transpose(dest_, mtx_) (mf16_transpose(dest_, mtx_))
+#define MTX_Transpose(dest_, mtx_) (MTX_ViewTranspose(dest_, mtx_))
 
 /**
  * @brief Produces A = B * s with s being a scalar
  * @param[in,out] dest_ = A
  * @param[in] mtx_ = B
  * @param[in] val_ = s
- * @return dest_->errors = FIXMATRIX_OVERFLOW if any overflow occurred
+ * @remark dest_ and mtx_ can alias if they refer to the same elements
+ * @return dest_->errors = FIXMATRIX_OVERFLOW if any overflow occurred <br>
+ * 		   dest_->errors = FIXMATRIX_USEERR if dest_ partially overlaps with mtx_
  */
-#define MTX_MultScalar(dest_, mtx_, val_) (mf16_mul_s(dest_, mtx_, val_))
+#define MTX_MultScalar(dest_, mtx_, val_) (MTX_ViewMultScalar(dest_, mtx_, val_))
 
 /**
  * @brief Produces A = B / s with s being a scalar
  * @param[in,out] dest_= A
  * @param[in] mtx_ = B
  * @param[in] val_ = s
- * @return dest_->errors = FIXMATRIX_OVERFLOW if any overflow occurred
+ * @remark dest_ and mtx_ can alias if they refer to the same elements
+ * @return dest_->errors = FIXMATRIX_OVERFLOW if any overflow occurred <br>
+ * 		   dest_->errors = FIXMATRIX_USEERR if dest_ partially overlaps with mtx_
  */
-#define MTX_DivScalar(dest_, mtx_, val_) (mf16_div_s(dest_, mtx_, val_))
+#define MTX_DivScalar(dest_, mtx_, val_) (MTX_ViewDivScalar(dest_, mtx_, val_))
+
+/**
+ * @brief Copies the elements and errors of B into A, i.e. A = B
+ * @param[in,out] dest_ = A
+ * @param[in] mtx_ = B
+ * @remark Assigning MTX_t objects only copies the view, use this macro to copy the content
+ * @return dest_->errors = FIXMATRIX_DIMERR if dimensions don't agree <br>
+ * 		   dest_->errors = FIXMATRIX_USEERR if dest_ partially overlaps with mtx_
+ */
+#define MTX_Copy(dest_, mtx_) (MTX_ViewCopy(dest_, mtx_))
 
 /**
  * @brief Decomposes a matrix A into a new set of orthonormal base vectors
@@ -134,12 +210,14 @@
  * @param[in,out] q_ = Q
  * @param[in,out] r_ = R <br>
  * @param[in] reOrthCnt_ reorthogonalizes the matrix which produces more accurate results.
- * @remark q_ and mtx_ and r_ and mtx_ may alias, respectively
- * @return q_->errors = r_->errors = FIXMATRIX_OVERFLOW if any overflow occurred <br>
- * 		   q_->errors = r_->errors = FIXMATRIX_SINGULAR if a division by 0 occurred
+ * @remark q_ and mtx_ may alias if they refer to the same elements, r_ must not alias with q_ or mtx_
+ * @return q_->errors = r_->errors = FIXMATRIX_DIMERR if dimensions don't agree <br>
+ * 		   q_->errors = r_->errors = FIXMATRIX_OVERFLOW if any overflow occurred <br>
+ * 		   q_->errors = r_->errors = FIXMATRIX_SINGULAR if a division by 0 occurred <br>
+ * 		   q_->errors = r_->errors = FIXMATRIX_USEERR if r_ aliases with q_ or mtx_
  *
  */
-#define MTX_QrDecomposition(q_, r_, mtx_, reOrthCnt_) (mf16_qr_decomposition(q_, r_, mtx_, reOrthCnt_))
+#define MTX_QrDecomposition(q_, r_, mtx_, reOrthCnt_) (MTX_ViewQrDecomposition(q_, r_, mtx_, reOrthCnt_))
 
 /**
  * @brief Solves a system of linear equations Ax = b by using QR-factors of A
@@ -148,43 +226,110 @@
  * @param[in,out] dest_ = x
  * @param[in] q_ = Q
  * @param[in] r_ = R
- * @remark dest_ can alias with mtx_ or q_ but not with r_
+ * @remark dest_ must not alias with mtx_, q_ or r_
  * @return dest_->errors = FIXMATRIX_OVERFLOW if any overflow occurred <br>
- * 		   dest_->errors = FIXMATRIX_USEERR if dimensions don't agree or r_=dest_<br>
+ * 		   dest_->errors = FIXMATRIX_DIMERR if dimensions don't agree <br>
+ * 		   dest_->errors = FIXMATRIX_USEERR if dest_ aliases with an operand <br>
  * 		   dest_->errors = FIXMATRIX_SINGULAR if a division by 0 occurred
  */
-#define MTX_Solve(dest_, q_, r_, mtx_) (mf16_solve(dest_, q_, r_, mtx_))
+#define MTX_Solve(dest_, q_, r_, mtx_) (MTX_ViewSolve(dest_, q_, r_, mtx_))
 
 /**
  * @brief Decomposes a symmetric, positive-definite matrix A such that A = L * L',
  * 		  L is a lower triangular matrix.
  * @param[in] mtx_ = A
  * @param[in,out] dest_ = L
- * @remark dest_ and mtx_ can alias
+ * @remark dest_ and mtx_ can alias if they refer to the same elements
  * @return dest_->errors = FIXMATRIX_DIMERR if A is not square <br>
  * 		   dest_->errors = FIXMATRIX_OVERFLOW if any overflow occurred <br>
- * 		   dest_->errors = FIXMATRIX_NEGATIVE if error in square root occurred
+ * 		   dest_->errors = FIXMATRIX_NEGATIVE if error in square root occurred <br>
+ * 		   dest_->errors = FIXMATRIX_SINGULAR if a division by 0 occurred <br>
+ * 		   dest_->errors = FIXMATRIX_USEERR if dest_ partially overlaps with mtx_
  */
-#define MTX_Cholesky(dest_, mtx_) (mf16_cholesky(dest_, mtx_))
+#define MTX_Cholesky(dest_, mtx_) (MTX_ViewCholesky(dest_, mtx_))
 
 /**
  * @brief Inversion of a matrix A through its decomposition A = L * L'.
  * 		  L may be obtained with MTX_Cholesky.
  * @param[in] mtx_ = L
  * @param[out] dest_ = A^{-1}
- * @remark dest_ and mtx_ can alias.
+ * @remark dest_ and mtx_ can alias if they refer to the same elements
+ * @return dest_->errors = FIXMATRIX_DIMERR if L is not square <br>
+ * 		   dest_->errors = FIXMATRIX_OVERFLOW if any overflow occurred <br>
+ * 		   dest_->errors = FIXMATRIX_SINGULAR if a division by 0 occurred <br>
+ * 		   dest_->errors = FIXMATRIX_USEERR if dest_ partially overlaps with mtx_
  */
-#define MTX_InvertLowerTri(dest_, mtx_) (mf16_invert_lt(dest_, mtx_))
+#define MTX_InvertLowerTri(dest_, mtx_) (MTX_ViewInvertLowerTri(dest_, mtx_))
 
 
 
 /*=================================== >> TYPE DEFINITIONS << =====================================*/
 /**
- * @brief The fix size of this type can be changed in fixmatrix.h through FIXMATRIX_MAX_SIZE
+ * @brief View of a row-major fixed-point matrix in caller-provided storage
+ *
+ * In contrast to the type mf16 of the fixmatrix library, this type does not reserve
+ * FIXMATRIX_MAX_SIZE x FIXMATRIX_MAX_SIZE elements but refers to storage of exactly the needed
+ * size. The dimensions of a view are fixed by its storage, hence all operations require the
+ * destination to already have the dimensions of the result.
  */
-typedef mf16 MTX_t;
+typedef struct MTX_s
+{
+	uint8_t rows;		/**< number of rows */
+	uint8_t columns;	/**< number of columns */
+	uint8_t stride;		/**< distance in elements between two consecutive rows */
+	uint8_t errors;		/**< FIXMATRIX_* error flags */
+	fix16_t *data;		/**< pointer to the first element */
+}MTX_t;
 
 /*============================ >> GLOBAL FUNCTION DECLARATIONS << ================================*/
+/**
+ * @brief Strided dot product a' * b of two Q16.16 vectors
+ * @param[in] a_ pointer to the first element of a
+ * @param[in] aStride_ distance in elements between two elements of a
+ * @param[in] b_ pointer to the first element of b
+ * @param[in] bStride_ distance in elements between two elements of b
+ * @param[in] n_ number of elements
+ * @return the dot product in Q16.16 or fix16_overflow if the result exceeds its range
+ */
+EXTERNAL_ fix16_t MTX_Dot(const fix16_t *a_, uint8_t aStride_, const fix16_t *b_, uint8_t bStride_, uint8_t n_);
+
+/**
+ * @brief Same as MTX_Dot but without overflow detection, the result is returned in Q48.16
+ */
+EXTERNAL_ int64_t MTX_Dot48d16(const fix16_t *a_, uint8_t aStride_, const fix16_t *b_, uint8_t bStride_, uint8_t n_);
+
+/**
+ * @brief Same as MTX_Dot48d16 but without rounding, the result is returned in Q32.32. The caller
+ * has to make sure that the sum of the products fits into 64 bit.
+ */
+EXTERNAL_ int64_t MTX_Dot32d32(const fix16_t *a_, uint8_t aStride_, const fix16_t *b_, uint8_t bStride_, uint8_t n_);
+
+/**
+ * @brief Integer square root of a 64 bit value rounded down, digit by digit without division
+ * @param[in] val_ radicand, the whole range of uint64_t is allowed
+ * @return floor(sqrt(val_))
+ */
+EXTERNAL_ uint32_t MTX_ISqrt(uint64_t val_);
+
+/**
+ * @brief View based implementations of the MTX_* macros above, see there for documentation
+ */
+EXTERNAL_ void MTX_ViewFill(MTX_t *dest_, fix16_t val_);
+EXTERNAL_ void MTX_ViewFillDiagonal(MTX_t *dest_, fix16_t val_);
+EXTERNAL_ void MTX_ViewMult(MTX_t *dest_, const MTX_t *fac1_, const MTX_t *fac2_);
+EXTERNAL_ void MTX_ViewMultAt(MTX_t *dest_, const MTX_t *fac1_, const MTX_t *fac2_);
+EXTERNAL_ void MTX_ViewMultBt(MTX_t *dest_, const MTX_t *fac1_, const MTX_t *fac2_);
+EXTERNAL_ void MTX_ViewAdd(MTX_t *dest_, const MTX_t *sum1_, const MTX_t *sum2_);
+EXTERNAL_ void MTX_ViewSub(MTX_t *dest_, const MTX_t *min_, const MTX_t *sub_);
+EXTERNAL_ void MTX_ViewTranspose(MTX_t *dest_, const MTX_t *mtx_);
+EXTERNAL_ void MTX_ViewMultScalar(MTX_t *dest_, const MTX_t *mtx_, fix16_t val_);
+EXTERNAL_ void MTX_ViewDivScalar(MTX_t *dest_, const MTX_t *mtx_, fix16_t val_);
+EXTERNAL_ void MTX_ViewCopy(MTX_t *dest_, const MTX_t *mtx_);
+EXTERNAL_ void MTX_ViewQrDecomposition(MTX_t *q_, MTX_t *r_, const MTX_t *mtx_, const uint8_t reOrthCnt_);
+EXTERNAL_ void MTX_ViewSolve(MTX_t *dest_, const MTX_t *q_, const MTX_t *r_, const MTX_t *mtx_);
+EXTERNAL_ void MTX_ViewCholesky(MTX_t *dest_, const MTX_t *mtx_);
+EXTERNAL_ void MTX_ViewInvertLowerTri(MTX_t *dest_, const MTX_t *mtx_);
+
 /**
  * @brief Appends matrix B to matrix A at a specified position
  * @param[in,out] dest_ = augmented matrix
@@ -192,8 +337,10 @@ typedef mf16 MTX_t;
  * @param[in] b_ = B
  * @param[in] posRow_ the row where B should be put
  * @param[in] posColumn_ the column where B should be put
- * @return dest_->errors = FIXMATRIX_USEERR if matrix exceeds FIXMATRIX_MAX_SIZE
- * 		   or if B would overwrite A
+ * @remark The dimensions of dest_ determine the size of the augmented matrix. A can be built in place
+ * 		   if a_ refers to the upper left elements of dest_, i.e. has the same data and stride.
+ * @return dest_->errors = FIXMATRIX_USEERR if B does not fit into dest_, if B would overwrite A,
+ * 		   if b_ aliases with dest_ or if a_ aliases with dest_ otherwise
  */
 EXTERNAL_ void MTX_AppendMatrix(MTX_t *dest_, const MTX_t *a_, const MTX_t *b_, const uint8_t posRow_, const uint8_t posColumn_);
 
@@ -203,8 +350,10 @@ EXTERNAL_ void MTX_AppendMatrix(MTX_t *dest_, const MTX_t *a_, const MTX_t *b_,
  * @param[in] mtx_ = A
  * @param[in,out] q_ = Q
  * @param[in,out] l_ = L
- * @param[in] reOrthCnt_ reorthogonalizes the matrix which produces more accurate results
- * @return q_->errors = l_->errors = FIXMATRIX_OVERFLOW if any overflow occurred
+ * @param[in] reOrthCnt_ number of additional Gram-Schmidt passes, each one improves the
+ * 		  orthogonality of Q and is accumulated into L
+ * @return q_->errors = l_->errors = FIXMATRIX_OVERFLOW if any overflow occurred,
+ * 		   FIXMATRIX_SINGULAR if a column of Q vanishes, i.e. the columns of A are linearly dependent
  */
 EXTERNAL_ void MTX_QlDecomposition(MTX_t *q_, MTX_t *l_, const MTX_t *mtx_, const uint8_t reOrthCnt_);
 
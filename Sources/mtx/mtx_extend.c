@@ -19,13 +19,17 @@
 #define MASTER_mtx_extend_C_
 
 /*======================================= >> #INCLUDES << ========================================*/
+#include "Platform.h"
 #include "fixmatrix.h"
-#include "fixarray.h"
 #include "mtx_api.h"
 
 
 
 /*======================================= >> #DEFINES << =========================================*/
+/**
+ * Squared norm in Q32.32 below which a column of Q is considered to be zero, one LSB of Q16.16
+ */
+#define MTX_QL_NORM_SQ_MIN	((int64_t)1 << 16)
 
 
 
@@ -34,7 +38,8 @@
 
 
 /*============================= >> LOKAL FUNCTION DECLARATIONS << ================================*/
-static void MTX_SubtractProjection(fix16_t *v, const fix16_t *u, fix16_t dot, int n, uint8_t *errors);
+static void MTX_SubtractProjection(fix16_t *v, uint8_t vStride, const fix16_t *u, uint8_t uStride, fix16_t dot, uint8_t n, uint8_t *errors);
+static fix16_t MTX_DivAcc(int64_t num_, int64_t den_, uint8_t *errors_);
 
 
 /*=================================== >> GLOBAL VARIABLES << =====================================*/
@@ -42,9 +47,9 @@ static void MTX_SubtractProjection(fix16_t *v, const fix16_t *u, fix16_t dot, in
 
 
 /*============================== >> LOKAL FUNCTION DEFINITIONS << ================================*/
-static void MTX_SubtractProjection(fix16_t *v, const fix16_t *u, fix16_t dot, int n, uint8_t *errors)
+static void MTX_SubtractProjection(fix16_t *v, uint8_t vStride, const fix16_t *u, uint8_t uStride, fix16_t dot, uint8_t n, uint8_t *errors)
 {
-    while (n--)
+    while (0u != n)
     {
         // For unit vector u, u[i] <= 1
         // Therefore this multiplication cannot overflow
@@ -54,47 +59,95 @@ static void MTX_SubtractProjection(fix16_t *v, const fix16_t *u, fix16_t dot, in
         fix16_t diff = fix16_sub(*v, product);
 
         if (diff == fix16_overflow)
+        {
             *errors |= FIXMATRIX_OVERFLOW;
+        }
 
         *v = diff;
 
-        v += FIXMATRIX_MAX_SIZE;
-        u += FIXMATRIX_MAX_SIZE;
+        v += vStride;
+        u += uStride;
+        n--;
     }
 }
 
+/**
+ * @brief Rounded quotient of two Q32.32 dot products in Q16.16, den_ has to be positive
+ */
+static fix16_t MTX_DivAcc(int64_t num_, int64_t den_, uint8_t *errors_)
+{
+	uint64_t num = (uint64_t)((num_ < 0) ? -num_ : num_);
+	uint64_t den = (uint64_t)den_;
+	uint64_t quot = 0u;
+	fix16_t retVal = fix16_overflow;
+
+	/* num << 16 has to fit into 64 bit, the denominator is scaled alike */
+	while(num >= ((uint64_t)1u << 47))
+	{
+		num >>= 1;
+		den >>= 1;
+	}
+	if(0u != den)
+	{
+		quot = ((num << 16) + (den >> 1)) / den;
+		if(quot <= (uint64_t)fix16_maximum)
+		{
+			retVal = (num_ < 0) ? -(fix16_t)quot : (fix16_t)quot;
+		}
+	}
+	if(fix16_overflow == retVal)
+	{
+		*errors_ |= FIXMATRIX_OVERFLOW;
+	}
+	return retVal;
+}
+
 
 
 /*============================= >> GLOBAL FUNCTION DEFINITIONS << ================================*/
 void MTX_AppendMatrix(MTX_t *dest_, const MTX_t *a_, const MTX_t *b_, const uint8_t posRow_, const uint8_t posColumn_)
 {
 	int row, column;
-
-	if( (posRow_ < a_->rows) || (posColumn_ < a_->columns))
-		dest_->errors |= FIXMATRIX_USEERR;
-
-	if(dest_ != a_)
-		*dest_ = *a_;
-
-	if(b_->rows < a_->rows && (posRow_ < a_->rows))
-		dest_->rows = a_->rows;
-	else
-		dest_->rows    = posRow_ + b_->rows - 1;
-	if(b_->columns < a_->columns && posColumn_ < a_->columns)
-		dest_->columns = a_->columns;
-	else
-		dest_->columns = posColumn_ + b_->columns - 1;
+	bool isInPlace = (bool)MTX_IS_SAME(dest_, a_);
 
 	dest_->errors  = (a_->errors | b_->errors);
 
-	if( (dest_->rows > FIXMATRIX_MAX_SIZE) || (dest_->columns > FIXMATRIX_MAX_SIZE) )
+	/* positions are one-based, B must not overlap with A and both must fit into dest_ */
+	if( (0u == posRow_) || (0u == posColumn_) ||
+	    ((posRow_ <= a_->rows) && (posColumn_ <= a_->columns)) ||
+	    (a_->rows > dest_->rows) || (a_->columns > dest_->columns) ||
+	    ((posRow_ + b_->rows - 1) > dest_->rows) || ((posColumn_ + b_->columns - 1) > dest_->columns) )
+	{
 		dest_->errors |= FIXMATRIX_USEERR;
+		return;
+	}
+	/* A can only be kept in place if it occupies the upper left elements of dest_ */
+	if( MTX_IS_ALIAS(dest_, b_) || (MTX_IS_ALIAS(dest_, a_) && (FALSE == isInPlace)) )
+	{
+		dest_->errors |= FIXMATRIX_USEERR;
+		return;
+	}
 
-	for(row = (posRow_-1); row < dest_->rows; row++)
+	for(row = 0; row < dest_->rows; row++)
 	{
-		for(column = (posColumn_-1); column < dest_->columns; column++)
+		for(column = 0; column < dest_->columns; column++)
 		{
-			dest_->data[row][column] = b_->data[row-(posRow_-1)][column-(posColumn_-1)];
+			if( (row < a_->rows) && (column < a_->columns) )
+			{
+				if(FALSE == isInPlace)
+				{
+					MTX_AT(dest_, row, column) = MTX_AT(a_, row, column);
+				}
+			}
+			else if( (row >= (posRow_-1)) && (row < (posRow_ + b_->rows - 1)) &&
+					 (column >= (posColumn_-1)) && (column < (posColumn_ + b_->columns - 1)) )
+			{
+				MTX_AT(dest_, row, column) = MTX_AT(b_, row-(posRow_-1), column-(posColumn_-1));
+			}
+			else
+			{
+				MTX_AT(dest_, row, column) = 0;
+			}
 		}
 	}
 }
@@ -102,21 +155,26 @@ void MTX_AppendMatrix(MTX_t *dest_, const MTX_t *a_, const MTX_t *b_, const uint
 void MTX_QlDecomposition(MTX_t *q_, MTX_t *l_, const MTX_t *mtx_, const uint8_t reOrthCnt_)
 {
     uint8_t i = 0u, j = 0u, reorth = 0u;
-    fix16_t dotaiqip1 = 0, dotqip1qip1 = 0;
-    uint8_t stride = FIXMATRIX_MAX_SIZE;
+    int64_t dotaiqip1 = 0, dotqip1qip1 = 0;
+    fix16_t lij = 0;
     uint8_t n = mtx_->rows;
 
     // We start with q_ = mtx_
-    if (q_ != mtx_)
-    {
-        *q_ = *mtx_;
-    }
+    MTX_ViewCopy(q_, mtx_);
 
     // l_ is initialized to have diagonal elements set to 1.
-    l_->columns = mtx_->columns;
-    l_->rows    = mtx_->columns;
     l_->errors  = 0;
-    mf16_fill_diagonal(l_, fix16_one);
+    if ( (l_->rows != mtx_->columns) || (l_->columns != mtx_->columns) )
+    {
+        l_->errors |= FIXMATRIX_DIMERR;
+    }
+    if ( (0 != (q_->errors & FIXMATRIX_DIMERR)) || (0 != l_->errors) )
+    {
+        q_->errors |= FIXMATRIX_DIMERR;
+        l_->errors  = q_->errors;
+        return;
+    }
+    MTX_ViewFillDiagonal(l_, fix16_one);
 
     // Now do the actual Gram-Schmidt for the rows.
     for (j = 1; j < q_->columns; j++)
@@ -125,16 +183,38 @@ void MTX_QlDecomposition(MTX_t *q_, MTX_t *l_, const MTX_t *mtx_, const uint8_t
         {
             for (i = 0; i < j; i++)
             {
-                fix16_t *ai   = &q_->data[0][(q_->columns-1)-j];
-                fix16_t *qip1 = &q_->data[0][(q_->columns-1)-i];
-
-                dotaiqip1   = fa16_dot(ai, stride, qip1, stride, n);
-                dotqip1qip1 = fa16_dot(qip1, stride, qip1, stride, n);
-                l_->data[(q_->columns-1)-i][(q_->columns-1)-j] = fix16_div(dotaiqip1, dotqip1qip1);
-                MTX_SubtractProjection(ai, qip1, l_->data[(q_->columns-1)-i][(q_->columns-1)-j], n, &q_->errors);
-
-                if ( (dotaiqip1 == fix16_overflow) || (dotqip1qip1 == fix16_overflow))
-                    q_->errors |= FIXMATRIX_OVERFLOW;
+                fix16_t *ai   = &MTX_AT(q_, 0, (q_->columns-1)-j);
+                fix16_t *qip1 = &MTX_AT(q_, 0, (q_->columns-1)-i);
+
+                // The projection coefficient is formed from the unrounded Q32.32 dot products,
+                // rounding them to Q16.16 first loses most digits for short columns
+                dotaiqip1   = MTX_Dot32d32(ai, q_->stride, qip1, q_->stride, n);
+                dotqip1qip1 = MTX_Dot32d32(qip1, q_->stride, qip1, q_->stride, n);
+
+                if (dotqip1qip1 < MTX_QL_NORM_SQ_MIN)
+                {
+                    // linearly dependent columns, the projection is undefined
+                    q_->errors |= FIXMATRIX_SINGULAR;
+                    continue;
+                }
+
+                lij = MTX_DivAcc(dotaiqip1, dotqip1qip1, &q_->errors);
+                MTX_SubtractProjection(ai, q_->stride, qip1, q_->stride, lij, n, &q_->errors);
+
+                // Each reorthogonalization removes the remaining part of the projection, which
+                // belongs to the same element of L
+                if (0u == reorth)
+                {
+                    MTX_AT(l_, (q_->columns-1)-i, (q_->columns-1)-j) = lij;
+                }
+                else
+                {
+                    MTX_AT(l_, (q_->columns-1)-i, (q_->columns-1)-j) = fix16_add(MTX_AT(l_, (q_->columns-1)-i, (q_->columns-1)-j), lij);
+                    if (fix16_overflow == MTX_AT(l_, (q_->columns-1)-i, (q_->columns-1)-j))
+                    {
+                        q_->errors |= FIXMATRIX_OVERFLOW;
+                    }
+                }
             }
         }
     }
@@ -151,25 +231,24 @@ void MTX_UdDecomposition(MTX_t *u_, MTX_t *d_, const MTX_t *mtx_)
 	d_->errors = mtx_->errors;
 	u_->errors = mtx_->errors;
 
-	if (mtx_->rows != mtx_->columns)
+	if ( (mtx_->rows != mtx_->columns) || (u_->rows != mtx_->rows) || (u_->columns != mtx_->rows) ||
+	     (d_->rows != mtx_->rows) || (d_->columns != mtx_->rows) )
 	{
 			u_->errors |= FIXMATRIX_DIMERR;
 			d_->errors |= FIXMATRIX_DIMERR;
+			return;
 	}
-	u_->rows    = mtx_->rows;
-	u_->columns = mtx_->rows;
-	d_->rows    = mtx_->rows;
-	d_->columns = mtx_->rows;
+	MTX_ViewFill(d_, 0);
 
 	for (j = (mtx_->rows-1); j >= 0; j--)
 	{
 		for (i = j; i >= 0; i--)
 		{
-				sigma = mtx_->data[i][j];
+				sigma = MTX_AT(mtx_, i, j);
 				for(k = (j+1); (k < mtx_->rows); k++)
 				{
-					tmp = fix16_mul(u_->data[i][k], d_->data[k][k]);
-					tmp = fix16_mul(tmp,           u_->data[j][k]);
+					tmp = fix16_mul(MTX_AT(u_, i, k), MTX_AT(d_, k, k));
+					tmp = fix16_mul(tmp,           MTX_AT(u_, j, k));
 					if(fix16_overflow == tmp)
 					{
 						u_->errors |= FIXMATRIX_OVERFLOW;
@@ -186,14 +265,20 @@ void MTX_UdDecomposition(MTX_t *u_, MTX_t *d_, const MTX_t *mtx_)
 				}
 				if(i == j)
 				{
-					d_->data[j][j] = sigma;
-					u_->data[j][j] = fix16_from_int(1);
+					MTX_AT(d_, j, j) = sigma;
+					MTX_AT(u_, j, j) = fix16_from_int(1);
+				}
+				else if(0 == MTX_AT(d_, j, j))
+				{
+					u_->errors |= FIXMATRIX_SINGULAR;
+					d_->errors |= FIXMATRIX_SINGULAR;
+					return;
 				}
 				else
 				{
-					u_->data[i][j] = fix16_div(sigma, d_->data[j][j]);
-					u_->data[j][i] = 0;
-					if(fix16_overflow == u_->data[i][j])
+					MTX_AT(u_, i, j) = fix16_div(sigma, MTX_AT(d_, j, j));
+					MTX_AT(u_, j, i) = 0;
+					if(fix16_overflow == MTX_AT(u_, i, j))
 					{
 						u_->errors |= FIXMATRIX_OVERFLOW;
 						d_->errors |= FIXMATRIX_OVERFLOW;
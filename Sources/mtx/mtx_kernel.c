@@ -0,0 +1,147 @@
+/***********************************************************************************************//**
+ * @file		mtx_kernel.c
+ * @ingroup		mtx
+ * @brief 		This module implements the dot product kernels of the SWC @a mtx
+ *
+ *	All matrix products of the SWC @ref mtx and the Bierman update of the SWC @ref kf reduce to
+ *	strided dot products of Q16.16 values. This module implements them once with a 64 bit
+ *	accumulator and without per-element checks. On a Cortex-M4 the multiply-accumulate is the DSP
+ *	instruction SMLAL through the CMSIS-style intrinsic __SMLAL, on any other target a portable C
+ *	implementation is used. The selection is done at compile time through MTX_CFG_DSP_KERNELS.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	13.04.2018
+ *
+ * @copyright @<LGPL2_1>
+ *
+ ***************************************************************************************************/
+
+#define MASTER_mtx_kernel_C_
+
+/*======================================= >> #INCLUDES << ========================================*/
+#include "mtx_api.h"
+
+
+
+/*======================================= >> #DEFINES << =========================================*/
+/**
+ * @brief Signed 32x32 bit multiplication accumulated into 64 bit, acc_ + a_ * b_
+ */
+#if (1 == MTX_CFG_DSP_KERNELS)
+#define MTX_MAC(acc_, a_, b_)	__SMLAL((acc_), (a_), (b_))
+#else
+#define MTX_MAC(acc_, a_, b_)	((acc_) + (int64_t)(a_) * (b_))
+#endif
+
+
+
+/*=================================== >> TYPE DEFINITIONS << =====================================*/
+
+
+
+/*============================= >> LOKAL FUNCTION DECLARATIONS << ================================*/
+#if (1 == MTX_CFG_DSP_KERNELS)
+static inline int64_t __SMLAL(int64_t acc_, int32_t a_, int32_t b_);
+#endif
+static inline int64_t MTX_DotAcc(const fix16_t *a_, uint8_t aStride_, const fix16_t *b_, uint8_t bStride_, uint8_t n_);
+
+
+
+/*=================================== >> GLOBAL VARIABLES << =====================================*/
+
+
+
+/*============================== >> LOKAL FUNCTION DEFINITIONS << ================================*/
+#if (1 == MTX_CFG_DSP_KERNELS)
+/**
+ * @brief CMSIS-style intrinsic of SMLAL. CMSIS-Core only provides the dual 16 bit __SMLALD, which
+ * doesn't apply to the 32 bit wide Q16.16 operands, and CMSIS isn't part of this project.
+ */
+__attribute__((always_inline)) static inline int64_t __SMLAL(int64_t acc_, int32_t a_, int32_t b_)
+{
+	__asm__ ("smlal %Q0, %R0, %1, %2" : "+r" (acc_) : "r" (a_), "r" (b_));
+	return acc_;
+}
+#endif
+
+/**
+ * @brief Strided dot product returning the unscaled Q32.32 accumulator, not unrolled since the
+ * filters of the project multiply 2-by-2 matrices
+ */
+static inline int64_t MTX_DotAcc(const fix16_t *a_, uint8_t aStride_, const fix16_t *b_, uint8_t bStride_, uint8_t n_)
+{
+	int64_t acc = 0;
+
+	while(0u != n_--)
+	{
+		acc = MTX_MAC(acc, *a_, *b_);
+		a_ += aStride_;
+		b_ += bStride_;
+	}
+	return acc;
+}
+
+
+
+/*============================= >> GLOBAL FUNCTION DEFINITIONS << ================================*/
+int64_t MTX_Dot32d32(const fix16_t *a_, uint8_t aStride_, const fix16_t *b_, uint8_t bStride_, uint8_t n_)
+{
+	return MTX_DotAcc(a_, aStride_, b_, bStride_, n_);
+}
+
+int64_t MTX_Dot48d16(const fix16_t *a_, uint8_t aStride_, const fix16_t *b_, uint8_t bStride_, uint8_t n_)
+{
+	int64_t acc = MTX_DotAcc(a_, aStride_, b_, bStride_, n_);
+	int64_t res = 0;
+
+#ifndef FIXMATH_NO_ROUNDING
+	/* nearest, -1/2 rounds away from zero, (acc >> 16) + bit 15 of acc without a branch */
+	res  = (acc - (int64_t)(acc < 0) + 0x8000) >> 16;
+#else
+	res  = (acc >> 16);
+#endif
+	return res;
+}
+
+fix16_t MTX_Dot(const fix16_t *a_, uint8_t aStride_, const fix16_t *b_, uint8_t bStride_, uint8_t n_)
+{
+	int64_t res = MTX_Dot48d16(a_, aStride_, b_, bStride_, n_);
+	fix16_t retVal = (fix16_t)res;
+
+	/* fix16_minimum+1...fix16_maximum by a single unsigned compare */
+	if( (uint64_t)(res - ((int64_t)fix16_minimum + 1)) > (uint64_t)((int64_t)fix16_maximum - fix16_minimum - 1) )
+	{
+		retVal = fix16_overflow;
+	}
+	return retVal;
+}
+
+uint32_t MTX_ISqrt(uint64_t val_)
+{
+	uint64_t res = 0u, bit = ((uint64_t)1u) << 62;
+
+	while( bit > val_ )
+	{
+		bit >>= 2;
+	}
+	while( 0u != bit )
+	{
+		if( val_ >= (res + bit) )
+		{
+			val_ -= res + bit;
+			res   = (res >> 1) + bit;
+		}
+		else
+		{
+			res >>= 1;
+		}
+		bit >>= 2;
+	}
+	return (uint32_t)res;
+}
+
+
+
+#ifdef MASTER_mtx_kernel_C_
+#undef MASTER_mtx_kernel_C_
+#endif /* !MASTER_mtx_kernel_C_ */
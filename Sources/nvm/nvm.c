@@ -248,6 +248,177 @@ StdRtn_t NVM_Read_Dflt_PIDSpdRiCfg(NVM_PidCfg_t *spdCfg_)
 }
 
 
+/* PID speed control gain schedule for the LEFT WHEEL */
+StdRtn_t NVM_Save_PIDSchedSpdLeCfg(const NVM_PidSchedCfg_t *schedCfg_)
+{
+	return SaveBlock2NVM((const NVM_DataAddr_t)schedCfg_,Get_PidSchedSpdLeCfgStrtAddr(), sizeof(NVM_PidSchedCfg_t),  Get_PidSchedCfgByteCnt());
+}
+
+StdRtn_t NVM_Read_PIDSchedSpdLeCfg(NVM_PidSchedCfg_t *schedCfg_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+
+	if (NULL != schedCfg_)
+	{
+		retVal = ReadBlockFromNVM((NVM_DataAddr_t)schedCfg_,Get_PidSchedSpdLeCfgStrtAddr(), sizeof(NVM_PidSchedCfg_t));
+	}
+	return retVal;
+}
+
+StdRtn_t NVM_Read_Dflt_PIDSchedSpdLeCfg(NVM_PidSchedCfg_t *schedCfg_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+	if (NULL != schedCfg_)
+	{
+		*schedCfg_ = romCfg->pidSchedSpdLe;
+		retVal = ERR_OK;
+	}
+	return  retVal;
+}
+
+
+/* PID speed control gain schedule for the RIGHT WHEEL */
+StdRtn_t NVM_Save_PIDSchedSpdRiCfg(const NVM_PidSchedCfg_t *schedCfg_)
+{
+	return SaveBlock2NVM((const NVM_DataAddr_t)schedCfg_,Get_PidSchedSpdRiCfgStrtAddr(), sizeof(NVM_PidSchedCfg_t),  Get_PidSchedCfgByteCnt());
+}
+
+StdRtn_t NVM_Read_PIDSchedSpdRiCfg(NVM_PidSchedCfg_t *schedCfg_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+
+	if (NULL != schedCfg_)
+	{
+		retVal = ReadBlockFromNVM((NVM_DataAddr_t)schedCfg_,Get_PidSchedSpdRiCfgStrtAddr(), sizeof(NVM_PidSchedCfg_t));
+	}
+	return retVal;
+}
+
+StdRtn_t NVM_Read_Dflt_PIDSchedSpdRiCfg(NVM_PidSchedCfg_t *schedCfg_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+	if (NULL != schedCfg_)
+	{
+		*schedCfg_ = romCfg->pidSchedSpdRi;
+		retVal = ERR_OK;
+	}
+	return  retVal;
+}
+
+
+/* PID synchronization control of BOTH WHEELS */
+StdRtn_t NVM_Save_PIDSyncCfg(const NVM_PidCfg_t *syncCfg_)
+{
+	return SaveBlock2NVM((const NVM_DataAddr_t)syncCfg_,Get_PidSyncCfgStrtAddr(), sizeof(NVM_PidCfg_t),  Get_PidCfgByteCnt());
+}
+
+StdRtn_t NVM_Read_PIDSyncCfg(NVM_PidCfg_t *syncCfg_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+
+	if (NULL != syncCfg_)
+	{
+		retVal = ReadBlockFromNVM((NVM_DataAddr_t)syncCfg_,Get_PidSyncCfgStrtAddr(), sizeof(NVM_PidCfg_t));
+	}
+	return retVal;
+}
+
+StdRtn_t NVM_Read_Dflt_PIDSyncCfg(NVM_PidCfg_t *syncCfg_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+	if (NULL != syncCfg_)
+	{
+		*syncCfg_ = romCfg->pidCfgSync;
+		retVal = ERR_OK;
+	}
+	return  retVal;
+}
+
+
+/* Linearization of the LEFT MOTOR */
+StdRtn_t NVM_Save_MotLinLeCfg(const NVM_MotLinCfg_t *linCfg_)
+{
+	return SaveBlock2NVM((const NVM_DataAddr_t)linCfg_,Get_MotLinLeCfgStrtAddr(), sizeof(NVM_MotLinCfg_t),  Get_MotLinCfgByteCnt());
+}
+
+StdRtn_t NVM_Read_MotLinLeCfg(NVM_MotLinCfg_t *linCfg_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+
+	if (NULL != linCfg_)
+	{
+		retVal = ReadBlockFromNVM((NVM_DataAddr_t)linCfg_,Get_MotLinLeCfgStrtAddr(), sizeof(NVM_MotLinCfg_t));
+	}
+	return retVal;
+}
+
+StdRtn_t NVM_Read_Dflt_MotLinLeCfg(NVM_MotLinCfg_t *linCfg_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+	if (NULL != linCfg_)
+	{
+		*linCfg_ = romCfg->motLinLe;
+		retVal = ERR_OK;
+	}
+	return  retVal;
+}
+
+
+/* Linearization of the RIGHT MOTOR */
+StdRtn_t NVM_Save_MotLinRiCfg(const NVM_MotLinCfg_t *linCfg_)
+{
+	return SaveBlock2NVM((const NVM_DataAddr_t)linCfg_,Get_MotLinRiCfgStrtAddr(), sizeof(NVM_MotLinCfg_t),  Get_MotLinCfgByteCnt());
+}
+
+StdRtn_t NVM_Read_MotLinRiCfg(NVM_MotLinCfg_t *linCfg_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+
+	if (NULL != linCfg_)
+	{
+		retVal = ReadBlockFromNVM((NVM_DataAddr_t)linCfg_,Get_MotLinRiCfgStrtAddr(), sizeof(NVM_MotLinCfg_t));
+	}
+	return retVal;
+}
+
+StdRtn_t NVM_Read_Dflt_MotLinRiCfg(NVM_MotLinCfg_t *linCfg_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+	if (NULL != linCfg_)
+	{
+		*linCfg_ = romCfg->motLinRi;
+		retVal = ERR_OK;
+	}
+	return  retVal;
+}
+
+StdRtn_t NVM_Save_MotLimCfg(const NVM_MotLimCfg_t *limCfg_)
+{
+	return SaveBlock2NVM((const NVM_DataAddr_t)limCfg_,Get_MotLimCfgStrtAddr(), sizeof(NVM_MotLimCfg_t),  Get_MotLimCfgByteCnt());
+}
+
+StdRtn_t NVM_Read_MotLimCfg(NVM_MotLimCfg_t *limCfg_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+	if (NULL != limCfg_)
+	{
+		retVal = ReadBlockFromNVM((NVM_DataAddr_t)limCfg_,Get_MotLimCfgStrtAddr(), sizeof(NVM_MotLimCfg_t));
+	}
+	return  retVal;
+}
+
+StdRtn_t NVM_Read_Dflt_MotLimCfg(NVM_MotLimCfg_t *limCfg_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+	if (NULL != limCfg_)
+	{
+		*limCfg_ = romCfg->motLim;
+		retVal = ERR_OK;
+	}
+	return  retVal;
+}
+
+
 /* Reflectance sensors */
 StdRtn_t NVM_Save_ReflCalibData(const NVM_ReflCalibData_t *pCalibData_)
 {
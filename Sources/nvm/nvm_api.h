@@ -45,6 +45,16 @@
 	#define NVM_UNIT_SIZE_ASW		(0x40u)
 #endif
 
+/**
+ * Maximum number of points of a gain schedule of a PID controller
+ */
+#define NVM_PID_SCHED_PT_CNT		(4u)
+
+/**
+ * Number of points of the linearization table of a motor
+ */
+#define NVM_MOT_LIN_PT_CNT			(17u)
+
 
 
 /*=================================== >> TYPE DEFINITIONS << =====================================*/
@@ -64,6 +74,66 @@ typedef struct NVM_PidCfg_s
 	uint32_t SaturationVal;		/**< maximum integral value for anti windup procedure */
 } NVM_PidCfg_t; /* 12Byte */
 
+/**
+ * @typedef NVM_PidSchedPt_t
+ * @brief Data type definition of the structure NVM_PidSchedPt_s
+ *
+ * @struct NVM_PidSchedPt_s
+ * @brief This structure defines a point of a gain schedule of a [PID controller](@ref pid). The
+ * gains are scaled by the scaling value of the controller configuration.
+ */
+typedef struct NVM_PidSchedPt_s
+{
+	uint16_t SchedVal;			/**< value of the scheduling variable at this point */
+	uint16_t KP_scld;			/**< proportional gain */
+	uint16_t KI_scld;			/**< integral gain */
+	uint16_t KD_scld;			/**< differential gain */
+} NVM_PidSchedPt_t; /* 8Byte */
+
+/**
+ * @typedef NVM_PidSchedCfg_t
+ * @brief Data type definition of the structure NVM_PidSchedCfg_s
+ *
+ * @struct NVM_PidSchedCfg_s
+ * @brief This structure defines the gain schedule of a [PID controller](@ref pid) stored in the NVM.
+ */
+typedef struct NVM_PidSchedCfg_s
+{
+	uint8_t NumPts;								/**< number of valid points, 0 disables the schedule */
+	uint8_t filler[3];							/**< filler */
+	NVM_PidSchedPt_t aPts[NVM_PID_SCHED_PT_CNT];	/**< points with ascending values of the scheduling variable */
+} NVM_PidSchedCfg_t; /* 4 + 4*8 = 36Byte */
+
+/**
+ * @typedef NVM_MotLinCfg_t
+ * @brief Data type definition of the structure NVM_MotLinCfg_s
+ *
+ * @struct NVM_MotLinCfg_s
+ * @brief This structure defines the linearization table of a [motor](@ref mot) stored in the NVM.
+ * The points are equally spaced over the motor value and hold the PWM duty cycles which yield the
+ * proportional steady-state speed.
+ */
+typedef struct NVM_MotLinCfg_s
+{
+	uint8_t IsEna;								/**< TRUE if the table is valid, FALSE disables the linearization */
+	uint8_t filler[1];							/**< filler */
+	uint16_t aDuty[NVM_MOT_LIN_PT_CNT];			/**< duty cycles, the first one is the end of the dead band */
+} NVM_MotLinCfg_t; /* 2 + 17*2 = 36Byte */
+
+/**
+ * @typedef NVM_MotLimCfg_t
+ * @brief Data type definition of the structure NVM_MotLimCfg_s
+ *
+ * @struct NVM_MotLimCfg_s
+ * @brief This structure defines the limits of the output of both [motors](@ref mot) stored in the
+ * NVM.
+ */
+typedef struct NVM_MotLimCfg_s
+{
+	uint16_t slewRate;							/**< maximum rise of the motor value per ms, 0 disables the limit */
+	uint16_t coastMs;							/**< coast interval on reversal in ms, 0 disables the coast */
+} NVM_MotLimCfg_t; /* 4Byte */
+
 /**
  * @typedef NVM_ReflCalibData_t
  * @brief Data type definition of the structure NVM_ReflCalibData_s
@@ -94,7 +164,13 @@ typedef struct NVM_RomCfg_s
 	NVM_PidCfg_t pidCfgSpdLe;			/**< PID speed control left config 	 	+12B mod4 0B */
 	NVM_PidCfg_t pidCfgSpdRi;			/**< PID speed control right config  	+12B mod4 0B */
 	NVM_ReflCalibData_t reflCalibData;	/**< Reflectance sensors calib data	 	+24B mod4 0B */
-} NVM_RomCfg_t; /* 1 + 3 + 3*12 + 24 = 65 Byte*/
+	NVM_PidSchedCfg_t pidSchedSpdLe;	/**< PID speed control left schedule	+36B mod4 0B */
+	NVM_PidSchedCfg_t pidSchedSpdRi;	/**< PID speed control right schedule	+36B mod4 0B */
+	NVM_PidCfg_t pidCfgSync;			/**< PID wheel synchronization config	+12B mod4 0B */
+	NVM_MotLinCfg_t motLinLe;			/**< motor left linearization table		+36B mod4 0B */
+	NVM_MotLinCfg_t motLinRi;			/**< motor right linearization table	+36B mod4 0B */
+	NVM_MotLimCfg_t motLim;				/**< motor output limits				+4B mod4 0B */
+} NVM_RomCfg_t; /* 1 + 3 + 3*12 + 24 + 2*36 + 12 + 2*36 + 4 = 224 Byte*/
 
 /*============================ >> GLOBAL FUNCTION DECLARATIONS << ================================*/
 /**
@@ -202,6 +278,150 @@ EXTERNAL_ StdRtn_t NVM_Read_PIDSpdRiCfg(NVM_PidCfg_t *spdCfg_);
  */
 EXTERNAL_ StdRtn_t NVM_Read_Dflt_PIDSpdRiCfg(NVM_PidCfg_t *spdCfg_);
 
+/**
+ * @brief This function saves the gain schedule of left speed control to the NVM
+ * @param schedCfg_ gain schedule
+ * @return Error code, ERR_OK if everything was fine,
+ *                     specific ERROR CODE otherwise
+ */
+EXTERNAL_ StdRtn_t NVM_Save_PIDSchedSpdLeCfg(const NVM_PidSchedCfg_t *schedCfg_);
+
+/**
+ * @brief This function reads the gain schedule of left speed control from the NVM
+ * @param schedCfg_ gain schedule (call by ref)
+ * @return Error code, ERR_OK if everything was fine,
+ *                     specific ERROR CODE otherwise
+ */
+EXTERNAL_ StdRtn_t NVM_Read_PIDSchedSpdLeCfg(NVM_PidSchedCfg_t *schedCfg_);
+
+/**
+ * @brief This function reads the default gain schedule of left speed control from the ROM
+ * @param schedCfg_ gain schedule (call by ref)
+ * @return Error code, ERR_OK if everything was fine,
+ *                     specific ERROR CODE otherwise
+ */
+EXTERNAL_ StdRtn_t NVM_Read_Dflt_PIDSchedSpdLeCfg(NVM_PidSchedCfg_t *schedCfg_);
+
+/**
+ * @brief This function saves the gain schedule of right speed control to the NVM
+ * @param schedCfg_ gain schedule
+ * @return Error code, ERR_OK if everything was fine,
+ *                     specific ERROR CODE otherwise
+ */
+EXTERNAL_ StdRtn_t NVM_Save_PIDSchedSpdRiCfg(const NVM_PidSchedCfg_t *schedCfg_);
+
+/**
+ * @brief This function reads the gain schedule of right speed control from the NVM
+ * @param schedCfg_ gain schedule (call by ref)
+ * @return Error code, ERR_OK if everything was fine,
+ *                     specific ERROR CODE otherwise
+ */
+EXTERNAL_ StdRtn_t NVM_Read_PIDSchedSpdRiCfg(NVM_PidSchedCfg_t *schedCfg_);
+
+/**
+ * @brief This function reads the default gain schedule of right speed control from the ROM
+ * @param schedCfg_ gain schedule (call by ref)
+ * @return Error code, ERR_OK if everything was fine,
+ *                     specific ERROR CODE otherwise
+ */
+EXTERNAL_ StdRtn_t NVM_Read_Dflt_PIDSchedSpdRiCfg(NVM_PidSchedCfg_t *schedCfg_);
+
+/**
+ * @brief This function saves PID parameters of the wheel synchronization to the NVM
+ * @param syncCfg_ synchronization control configuration
+ * @return Error code, ERR_OK if everything was fine,
+ *                     specific ERROR CODE otherwise
+ */
+EXTERNAL_ StdRtn_t NVM_Save_PIDSyncCfg(const NVM_PidCfg_t *syncCfg_);
+
+/**
+ * @brief This function reads PID parameters of the wheel synchronization from the NVM
+ * @param syncCfg_ synchronization control configuration (call by ref)
+ * @return Error code, ERR_OK if everything was fine,
+ *                     specific ERROR CODE otherwise
+ */
+EXTERNAL_ StdRtn_t NVM_Read_PIDSyncCfg(NVM_PidCfg_t *syncCfg_);
+
+/**
+ * @brief This function reads default PID parameters of the wheel synchronization from the ROM
+ * @param syncCfg_ synchronization control configuration (call by ref)
+ * @return Error code, ERR_OK if everything was fine,
+ *                     specific ERROR CODE otherwise
+ */
+EXTERNAL_ StdRtn_t NVM_Read_Dflt_PIDSyncCfg(NVM_PidCfg_t *syncCfg_);
+
+/**
+ * @brief This function saves the linearization table of the left motor to the NVM
+ * @param linCfg_ linearization table
+ * @return Error code, ERR_OK if everything was fine,
+ *                     specific ERROR CODE otherwise
+ */
+EXTERNAL_ StdRtn_t NVM_Save_MotLinLeCfg(const NVM_MotLinCfg_t *linCfg_);
+
+/**
+ * @brief This function reads the linearization table of the left motor from the NVM
+ * @param linCfg_ linearization table (call by ref)
+ * @return Error code, ERR_OK if everything was fine,
+ *                     specific ERROR CODE otherwise
+ */
+EXTERNAL_ StdRtn_t NVM_Read_MotLinLeCfg(NVM_MotLinCfg_t *linCfg_);
+
+/**
+ * @brief This function reads the default linearization table of the left motor from the ROM
+ * @param linCfg_ linearization table (call by ref)
+ * @return Error code, ERR_OK if everything was fine,
+ *                     specific ERROR CODE otherwise
+ */
+EXTERNAL_ StdRtn_t NVM_Read_Dflt_MotLinLeCfg(NVM_MotLinCfg_t *linCfg_);
+
+/**
+ * @brief This function saves the linearization table of the right motor to the NVM
+ * @param linCfg_ linearization table
+ * @return Error code, ERR_OK if everything was fine,
+ *                     specific ERROR CODE otherwise
+ */
+EXTERNAL_ StdRtn_t NVM_Save_MotLinRiCfg(const NVM_MotLinCfg_t *linCfg_);
+
+/**
+ * @brief This function reads the linearization table of the right motor from the NVM
+ * @param linCfg_ linearization table (call by ref)
+ * @return Error code, ERR_OK if everything was fine,
+ *                     specific ERROR CODE otherwise
+ */
+EXTERNAL_ StdRtn_t NVM_Read_MotLinRiCfg(NVM_MotLinCfg_t *linCfg_);
+
+/**
+ * @brief This function reads the default linearization table of the right motor from the ROM
+ * @param linCfg_ linearization table (call by ref)
+ * @return Error code, ERR_OK if everything was fine,
+ *                     specific ERROR CODE otherwise
+ */
+EXTERNAL_ StdRtn_t NVM_Read_Dflt_MotLinRiCfg(NVM_MotLinCfg_t *linCfg_);
+
+/**
+ * @brief This function saves the output limits of the motors to the NVM
+ * @param limCfg_ output limits
+ * @return Error code, ERR_OK if everything was fine,
+ *                     specific ERROR CODE otherwise
+ */
+EXTERNAL_ StdRtn_t NVM_Save_MotLimCfg(const NVM_MotLimCfg_t *limCfg_);
+
+/**
+ * @brief This function reads the output limits of the motors from the NVM
+ * @param limCfg_ output limits (call by ref)
+ * @return Error code, ERR_OK if everything was fine,
+ *                     specific ERROR CODE otherwise
+ */
+EXTERNAL_ StdRtn_t NVM_Read_MotLimCfg(NVM_MotLimCfg_t *limCfg_);
+
+/**
+ * @brief This function reads the default output limits of the motors from the ROM
+ * @param limCfg_ output limits (call by ref)
+ * @return Error code, ERR_OK if everything was fine,
+ *                     specific ERROR CODE otherwise
+ */
+EXTERNAL_ StdRtn_t NVM_Read_Dflt_MotLimCfg(NVM_MotLimCfg_t *limCfg_);
+
 /**
  * @brief This function saves calibration data of the reflectance sensors to the NVM
  * @param pCalibData_ calibration data
@@ -63,6 +63,17 @@
 #define REFL_CALIB_MAX_DATA_BYTE_COUNT  	(CAU_SUMO_PLT_NUM_OF_REFL_SENSORS*sizeof(uint16_t))
 #define REFL_CALIB_DATA_BYTE_COUNT			(REFL_CALIB_MIN_DATA_BYTE_COUNT + REFL_CALIB_MAX_DATA_BYTE_COUNT)
 
+#define PID_SCHED_NUM_PTS_BYTE_COUNT		(sizeof(uint8_t))
+#define PID_SCHED_PT_BYTE_COUNT				(4u*sizeof(uint16_t))
+#define PID_SCHED_CFG_BYTE_COUNT			(PID_SCHED_NUM_PTS_BYTE_COUNT + BYTE_FILLER(3u) \
+											+ NVM_PID_SCHED_PT_CNT*PID_SCHED_PT_BYTE_COUNT)
+
+#define MOT_LIN_IS_ENA_BYTE_COUNT			(sizeof(uint8_t))
+#define MOT_LIN_CFG_BYTE_COUNT				(MOT_LIN_IS_ENA_BYTE_COUNT + BYTE_FILLER(1u) \
+											+ NVM_MOT_LIN_PT_CNT*sizeof(uint16_t))
+
+#define MOT_LIM_CFG_BYTE_COUNT				(2u*sizeof(uint16_t))
+
 
 /* Define default values */
 #define PID_P_GAIN_POS_DEFAULT				(1000u)
@@ -75,12 +86,24 @@
 #define PID_D_GAIN_SPD_DEFAULT				(0u)
 #define PID_I_ANTIWINDUP_SPD_DEFAULT		(0xFFFFu)
 
+#define PID_P_GAIN_SYNC_DEFAULT				(800u)
+#define PID_I_GAIN_SYNC_DEFAULT				(20u)
+#define PID_D_GAIN_SYNC_DEFAULT				(0u)
+#define PID_I_ANTIWINDUP_SYNC_DEFAULT		(400u) /* correction of the wheel speeds in steps/sec */
+
 #define PID_MAX_SPEED_PERC_DEFAULT			(100u)
 
 
 #define REFL_CALIB_MIN_DATA_DEFAULT			(0xFFFFu)
 #define REFL_CALIB_MAX_DATA_DEFAULT			(0x0u)
 
+#define PID_SCHED_NUM_PTS_SPD_DEFAULT		(0u) /* gain scheduling is disabled */
+
+#define MOT_LIN_IS_ENA_DEFAULT				(0u) /* the duty cycle is proportional to the motor value */
+
+#define MOT_SLEW_RATE_DEFAULT				(3277u) /* full motor value within 20ms */
+#define MOT_COAST_MS_DEFAULT				(2u)
+
 
 
  /*  Define the memory areas
@@ -160,7 +183,27 @@
 #define REFL_CALIB_DATA_START_ADDR				(REFL_CALIB_MIN_DATA_START_ADDR)
 #define REFL_CALIB_DATA_END_ADDR				(REFL_CALIB_DATA_START_ADDR + REFL_CALIB_DATA_BYTE_COUNT)
 
-#define NVM_BSW_DFLASH_CFGRD_END_ADDR			(REFL_CALIB_DATA_END_ADDR)
+
+
+#define PID_SCHED_SPDLE_CFG_START_ADDR			(REFL_CALIB_DATA_END_ADDR)
+#define PID_SCHED_SPDLE_CFG_END_ADDR			(PID_SCHED_SPDLE_CFG_START_ADDR + PID_SCHED_CFG_BYTE_COUNT)
+
+#define PID_SCHED_SPDRI_CFG_START_ADDR			(PID_SCHED_SPDLE_CFG_END_ADDR)
+#define PID_SCHED_SPDRI_CFG_END_ADDR			(PID_SCHED_SPDRI_CFG_START_ADDR + PID_SCHED_CFG_BYTE_COUNT)
+
+#define PID_SYNC_CFG_START_ADDR					(PID_SCHED_SPDRI_CFG_END_ADDR)
+#define PID_SYNC_CFG_END_ADDR					(PID_SYNC_CFG_START_ADDR + PID_CFG_BYTE_COUNT)
+
+#define MOT_LIN_LE_CFG_START_ADDR				(PID_SYNC_CFG_END_ADDR)
+#define MOT_LIN_LE_CFG_END_ADDR					(MOT_LIN_LE_CFG_START_ADDR + MOT_LIN_CFG_BYTE_COUNT)
+
+#define MOT_LIN_RI_CFG_START_ADDR				(MOT_LIN_LE_CFG_END_ADDR)
+#define MOT_LIN_RI_CFG_END_ADDR					(MOT_LIN_RI_CFG_START_ADDR + MOT_LIN_CFG_BYTE_COUNT)
+
+#define MOT_LIM_CFG_START_ADDR					(MOT_LIN_RI_CFG_END_ADDR)
+#define MOT_LIM_CFG_END_ADDR					(MOT_LIM_CFG_START_ADDR + MOT_LIM_CFG_BYTE_COUNT)
+
+#define NVM_BSW_DFLASH_CFGRD_END_ADDR			(MOT_LIM_CFG_END_ADDR)
 #define NVM_BSW_DFLASH_CFGRD_BYTE_COUNT			(NVM_BSW_DFLASH_CFGRD_END_ADDR - NVM_BSW_DFLASH_START_ADDR)
 
 
@@ -183,6 +226,12 @@ const static NVM_RomCfg_t romCfg =
 		/* pidCfgSpdLe */	{PID_P_GAIN_SPD_DEFAULT, PID_I_GAIN_SPD_DEFAULT, PID_D_GAIN_SPD_DEFAULT, PID_MAX_SPEED_PERC_DEFAULT, PID_I_ANTIWINDUP_SPD_DEFAULT},
 		/* pidCfgSpdRi */	{PID_P_GAIN_SPD_DEFAULT, PID_I_GAIN_SPD_DEFAULT, PID_D_GAIN_SPD_DEFAULT, PID_MAX_SPEED_PERC_DEFAULT, PID_I_ANTIWINDUP_SPD_DEFAULT},
 		/* reflCalibData*/	{{REFL_CALIB_MIN_DATA_DEFAULT}, {REFL_CALIB_MAX_DATA_DEFAULT}},
+		/* pidSchedSpdLe*/	{PID_SCHED_NUM_PTS_SPD_DEFAULT, {0u}, {{0u}}},
+		/* pidSchedSpdRi*/	{PID_SCHED_NUM_PTS_SPD_DEFAULT, {0u}, {{0u}}},
+		/* pidCfgSync  */	{PID_P_GAIN_SYNC_DEFAULT, PID_I_GAIN_SYNC_DEFAULT, PID_D_GAIN_SYNC_DEFAULT, PID_MAX_SPEED_PERC_DEFAULT, PID_I_ANTIWINDUP_SYNC_DEFAULT},
+		/* motLinLe    */	{MOT_LIN_IS_ENA_DEFAULT, {0u}, {0u}},
+		/* motLinRi    */	{MOT_LIN_IS_ENA_DEFAULT, {0u}, {0u}},
+		/* motLim      */	{MOT_SLEW_RATE_DEFAULT, MOT_COAST_MS_DEFAULT},
 };
 
 
@@ -209,6 +258,19 @@ const uint8_t Get_PidCfgByteCnt(void)				{return PID_CFG_BYTE_COUNT;}
 const NVM_Addr_t Get_ReflCalibDataStrtAddr(void)	{return REFL_CALIB_DATA_START_ADDR;}
 const uint8_t Get_ReflCalibDataByteCnt(void)		{return REFL_CALIB_DATA_BYTE_COUNT;}
 
+const NVM_Addr_t Get_PidSchedSpdLeCfgStrtAddr(void)	{return PID_SCHED_SPDLE_CFG_START_ADDR;}
+const NVM_Addr_t Get_PidSchedSpdRiCfgStrtAddr(void)	{return PID_SCHED_SPDRI_CFG_START_ADDR;}
+const uint8_t Get_PidSchedCfgByteCnt(void)			{return PID_SCHED_CFG_BYTE_COUNT;}
+
+const NVM_Addr_t Get_PidSyncCfgStrtAddr(void)		{return PID_SYNC_CFG_START_ADDR;}
+
+const NVM_Addr_t Get_MotLinLeCfgStrtAddr(void)		{return MOT_LIN_LE_CFG_START_ADDR;}
+const NVM_Addr_t Get_MotLinRiCfgStrtAddr(void)		{return MOT_LIN_RI_CFG_START_ADDR;}
+const uint8_t Get_MotLinCfgByteCnt(void)			{return MOT_LIN_CFG_BYTE_COUNT;}
+
+const NVM_Addr_t Get_MotLimCfgStrtAddr(void)		{return MOT_LIM_CFG_START_ADDR;}
+const uint8_t Get_MotLimCfgByteCnt(void)			{return MOT_LIM_CFG_BYTE_COUNT;}
+
 const NVM_RomCfg_t *Get_pRomCfg(void)				{return &romCfg;}
 
 
@@ -129,6 +129,65 @@ EXTERNAL_ const NVM_Addr_t Get_ReflCalibDataStrtAddr(void);
  */
 EXTERNAL_ const uint8_t Get_ReflCalibDataByteCnt(void);
 
+/**
+ * @brief This function returns the NVM start address of the gain schedule
+ * for the PID speed controller of the wheel on the left-hand side
+ * @return data flash address
+ */
+EXTERNAL_ const NVM_Addr_t Get_PidSchedSpdLeCfgStrtAddr(void);
+
+/**
+ * @brief This function returns the NVM start address of the gain schedule
+ * for the PID speed controller of the wheel on the right-hand side
+ * @return data flash address
+ */
+EXTERNAL_ const NVM_Addr_t Get_PidSchedSpdRiCfgStrtAddr(void);
+
+/**
+ * @brief This function returns the byte count of NVM data for a gain schedule of a PID controller
+ * @return byte count
+ */
+EXTERNAL_ const uint8_t Get_PidSchedCfgByteCnt(void);
+
+/**
+ * @brief This function returns the NVM start address of the configuration data
+ * for the PID synchronization controller of both wheels
+ * @return data flash address
+ */
+EXTERNAL_ const NVM_Addr_t Get_PidSyncCfgStrtAddr(void);
+
+/**
+ * @brief This function returns the NVM start address of the linearization table
+ * of the motor on the left-hand side
+ * @return data flash address
+ */
+EXTERNAL_ const NVM_Addr_t Get_MotLinLeCfgStrtAddr(void);
+
+/**
+ * @brief This function returns the NVM start address of the linearization table
+ * of the motor on the right-hand side
+ * @return data flash address
+ */
+EXTERNAL_ const NVM_Addr_t Get_MotLinRiCfgStrtAddr(void);
+
+/**
+ * @brief This function returns the byte count of NVM data for a linearization table of a motor
+ * @return byte count
+ */
+EXTERNAL_ const uint8_t Get_MotLinCfgByteCnt(void);
+
+/**
+ * @brief This function returns the NVM start address of the output limits of the motors
+ * @return data flash address
+ */
+EXTERNAL_ const NVM_Addr_t Get_MotLimCfgStrtAddr(void);
+
+/**
+ * @brief This function returns the byte count of NVM data for the output limits of the motors
+ * @return byte count
+ */
+EXTERNAL_ const uint8_t Get_MotLimCfgByteCnt(void);
+
 
 
 /**
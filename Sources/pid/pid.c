@@ -7,6 +7,24 @@
  * Wind-Up algorithm avoids drifting of the integral part and the maximum allowed control value can
  * changed by parameter. Controller parameters are read from the [NVM software component](@ref nvm)
  * during initialisation and may be changed via [command line shell](@ref sh).
+ * The gains are stored with a decimal scaling factor. For the cyclic calculation they are converted
+ * once into binary point representation, so that the scaling is done by shifts instead of divisions
+ * and all intermediate results are saturated to the range of int32_t.
+ * Besides the positional form, the PID items can be run in velocity form with a feedforward part.
+ * The velocity form calculates only the increment of the control value, which allows to hand over
+ * a motor between PID items without a bump.
+ * The gains of a PID item can be scheduled by the absolute value of its desired or current value.
+ * The gains of the schedule share one binary point and are interpolated linearly between its
+ * points by a precalculated reciprocal of their distance. In positional form the integral part
+ * compensates the change of the proportional part, so that a change of the gains doesn't cause a
+ * jump of the control value.
+ * The derivative part is calculated from the difference of the error or, so that a step of the
+ * desired value doesn't kick, from the negative difference of the current value. The difference
+ * is smoothed by a first order filter with the filter constant 2^-nDFlt, which suppresses the
+ * quantisation noise of the encoders.
+ * The binary point parameters are double buffered. Changes from the shell or the autotuner are
+ * prepared in a pending set and are handed over at the start of the next calculation by a sequence
+ * number, hence the gains can be tuned while the drive is running without a torn parameter set.
  *
  * @author 	(c) 2014 Erich Styger, erich.styger@hslu.ch, Hochschule Luzern
  * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
@@ -24,18 +42,58 @@
 #include "pid_api.h"
 #include "mot_api.h"
 #include "nvm_api.h"
+#include "CS1.h"
 
 
 
 /*======================================= >> #DEFINES << =========================================*/
 #define PID_DEBUG 0 /* careful: this will slow down the PID loop frequency! */
 
+/**
+ * Largest value of the binary point gains, so that the conversion keeps one bit of headroom
+ */
+#define PID_Q_GAIN_MAX ((int64_t)INT32_MAX)
+
+/**
+ * Bound of the error differences in velocity form, so that the sum of the three products and the
+ * remainder of the increment can't overflow 64 bit
+ */
+#define PID_VEL_OPD_MAX ((int32_t)(1 << 29))
+
+/**
+ * Bound of the unfiltered difference of the derivative part, so that it keeps one bit of headroom
+ * in its fixed-point representation
+ */
+#define PID_D_DIFF_MAX ((int32_t)(1 << (30u - PID_D_FLT_FRAC)))
+
+/**
+ * Keeps the compiler from moving accesses of the parameter buffers across the sequence number
+ */
+#define PID_BARRIER() __asm__ volatile ("" : : : "memory")
+
 /*=================================== >> TYPE DEFINITIONS << =====================================*/
 
 
 
 /*============================= >> LOKAL FUNCTION DECLARATIONS << ================================*/
-
+static inline int32_t PID_Sat32(int64_t val_);
+static inline int32_t PID_SatBnd(int32_t val_, int32_t bnd_);
+static inline int32_t PID_MulShr(int32_t gain_, int32_t val_, uint8_t shift_);
+static uint8_t PID_Calc_Shift(uint16_t kMax_, uint16_t nScale_);
+static inline int32_t PID_Cvt_Q(uint16_t k_, uint8_t shift_, uint16_t nScale_);
+static void PID_Cvt_Gain(const PID_Gain_t *gain_, uint8_t shift_, PID_QGain_t *qGain_);
+static inline int32_t PID_Flt_D(const PID_QGain_t *qGain_, PID_Data_t *data_, int32_t err_, int32_t actVal_);
+static bool PID_Is_SchedValid(const PID_Sched_t *sched_);
+static PID_Prm_t *PID_Begin_Upd(PID_Itm_t *pItm_);
+static void PID_End_Upd(PID_Itm_t *pItm_);
+static void PID_Sync_Prm(PID_Itm_t *pItm_);
+static StdRtn_t PID_Upd_Q(PID_Itm_t *pItm_);
+static inline int32_t PID_Interp(int32_t k0_, int32_t k1_, uint32_t frac_);
+static void PID_Sched_Gain(const PID_Itm_t *pItm_, int32_t setVal_, int32_t actVal_, PID_QGain_t *qGain_);
+static void PID_Load_Sched(PID_Itm_t *pItm_);
+static void PID_Load_Gain(PID_Itm_t *pItm_);
+static StdRtn_t PID_Calc(PID_Itm_t *pItm_, int32_t setVal_, int32_t actVal_, int32_t ffVal_, int32_t* ctrlVal_);
+static void PID_Reset_Data(PID_Data_t *data_);
 
 
 /*=================================== >> GLOBAL VARIABLES << =====================================*/
@@ -44,6 +102,407 @@ static PID_ItmTbl_t *pPidTbl = NULL;
 
 
 /*============================== >> LOKAL FUNCTION DEFINITIONS << ================================*/
+/**
+ * @brief Saturates a 64 bit value to the range of int32_t
+ */
+static inline int32_t PID_Sat32(int64_t val_)
+{
+	int32_t retVal = (int32_t)val_;
+
+	if( val_ > (int64_t)INT32_MAX )
+	{
+		retVal = INT32_MAX;
+	}
+	else if( val_ < (int64_t)INT32_MIN )
+	{
+		retVal = INT32_MIN;
+	}
+	return retVal;
+}
+
+/**
+ * @brief Bounds a value to the symmetric range [-bnd_, bnd_]
+ */
+static inline int32_t PID_SatBnd(int32_t val_, int32_t bnd_)
+{
+	int32_t retVal = val_;
+
+	if( val_ < -bnd_ )
+	{
+		retVal = -bnd_;
+	}
+	else if( val_ > bnd_ )
+	{
+		retVal = bnd_;
+	}
+	return retVal;
+}
+
+/**
+ * @brief Multiplies a value with a binary point gain and rounds towards zero like the integer
+ * division of @ref PIDext does, the result is saturated to the range of int32_t
+ */
+static inline int32_t PID_MulShr(int32_t gain_, int32_t val_, uint8_t shift_)
+{
+	int64_t prod = (int64_t)gain_ * (int64_t)val_;
+
+	if( prod < 0 )
+	{
+		prod += ((int64_t)1 << shift_) - 1;
+	}
+	return PID_Sat32(prod >> shift_);
+}
+
+/**
+ * @brief Finds the largest number of fractional bits which keeps a gain of kMax_ in range
+ */
+static uint8_t PID_Calc_Shift(uint16_t kMax_, uint16_t nScale_)
+{
+	uint8_t shift = PID_Q_SHIFT_MAX;
+
+	while( ( shift > 0u ) && ( ( ( ((int64_t)kMax_ << shift) + nScale_ - 1 ) / nScale_ ) > PID_Q_GAIN_MAX ) )
+	{
+		shift--;
+	}
+	return shift;
+}
+
+/**
+ * @brief Converts a decimal scaled gain, it is rounded up, so that truncation of products matches
+ * the decimal scaling
+ */
+static inline int32_t PID_Cvt_Q(uint16_t k_, uint8_t shift_, uint16_t nScale_)
+{
+	return (int32_t)( ( ((int64_t)k_ << shift_) + nScale_ - 1 ) / nScale_ );
+}
+
+static void PID_Cvt_Gain(const PID_Gain_t *gain_, uint8_t shift_, PID_QGain_t *qGain_)
+{
+	qGain_->kP_q   = PID_Cvt_Q(gain_->kP_scld, shift_, gain_->nScale);
+	qGain_->kI_q   = PID_Cvt_Q(gain_->kI_scld, shift_, gain_->nScale);
+	qGain_->kD_q   = PID_Cvt_Q(gain_->kD_scld, shift_, gain_->nScale);
+	qGain_->satVal = ( gain_->intSatVal > (uint32_t)INT32_MAX ) ? INT32_MAX : (int32_t)gain_->intSatVal;
+	qGain_->nShift = shift_;
+}
+
+/**
+ * @brief Updates the filtered difference of the derivative part, the difference is taken from
+ * the source of qGain_ and the filter is y += (x - y) >> nDFlt
+ * @return filtered difference as Qx.PID_D_FLT_FRAC
+ */
+static inline int32_t PID_Flt_D(const PID_QGain_t *qGain_, PID_Data_t *data_, int32_t err_, int32_t actVal_)
+{
+	int32_t diff = 0;
+
+	if( PID_DSRC_MEAS == qGain_->dSrc )
+	{
+		if( TRUE == data_->dVld )
+		{
+			diff = PID_Sat32( (int64_t)data_->prevAct - (int64_t)actVal_ );
+		}
+	}
+	else
+	{
+		diff = PID_Sat32( (int64_t)err_ - (int64_t)data_->prevErr );
+	}
+	data_->prevAct = actVal_;
+	data_->dVld    = TRUE;
+
+	diff = PID_SatBnd(diff, PID_D_DIFF_MAX) * (int32_t)(1 << PID_D_FLT_FRAC);
+	data_->dFltVal += (int32_t)( ( (int64_t)diff - (int64_t)data_->dFltVal ) >> qGain_->nDFlt );
+	return data_->dFltVal;
+}
+
+static bool PID_Is_SchedValid(const PID_Sched_t *sched_)
+{
+	bool retVal = ( sched_->numPts <= PID_SCHED_PT_CNT );
+	uint8_t i = 0u;
+
+	for(i = 1u; ( TRUE == retVal ) && ( i < sched_->numPts ); i++)
+	{
+		retVal = ( sched_->aPts[i].schedVal > sched_->aPts[i-1u].schedVal );
+	}
+	return retVal;
+}
+
+/**
+ * @brief Marks the pending parameters of a PID item as being written, the calculation doesn't
+ * take them over until @ref PID_End_Upd
+ * @return pointer to the pending parameters
+ */
+static PID_Prm_t *PID_Begin_Upd(PID_Itm_t *pItm_)
+{
+	pItm_->cfg.prm.pendSeq++;
+	PID_BARRIER();
+	return &pItm_->cfg.prm.pend;
+}
+
+/**
+ * @brief Releases the pending parameters of a PID item for the handover
+ */
+static void PID_End_Upd(PID_Itm_t *pItm_)
+{
+	PID_BARRIER();
+	pItm_->cfg.prm.pendSeq++;
+}
+
+/**
+ * @brief Takes over the pending parameters of a PID item if they have been released since the
+ * last handover. The remainder of the velocity form is kept in the new binary point.
+ */
+static void PID_Sync_Prm(PID_Itm_t *pItm_)
+{
+	PID_PrmBuf_t *pBuf = &pItm_->cfg.prm;
+	uint8_t oldShift = 0u, newShift = 0u;
+	uint32_t seq = pBuf->pendSeq;
+	CS1_CriticalVariable();
+
+	if( ( seq != pBuf->actSeq ) && ( 0u == ( seq & 1u ) ) )
+	{
+		/* the copy mustn't be interrupted by a writer which starts the next update */
+		CS1_EnterCritical();
+		seq = pBuf->pendSeq;
+		PID_BARRIER();
+		if( 0u == ( seq & 1u ) )
+		{
+			oldShift = pBuf->act.qGain.nShift;
+			newShift = pBuf->pend.qGain.nShift;
+			pBuf->act    = pBuf->pend;
+			pBuf->actSeq = seq;
+		}
+		CS1_ExitCritical();
+
+		if( newShift > oldShift )
+		{
+			pItm_->data.remVal = (int32_t)( (uint32_t)pItm_->data.remVal << (newShift - oldShift) );
+		}
+		else
+		{
+			pItm_->data.remVal >>= (oldShift - newShift);
+		}
+	}
+}
+
+/**
+ * @brief Prepares the binary point gains of a PID item and of its gain schedule with a common
+ * number of fractional bits, they are applied by the next calculation
+ */
+static StdRtn_t PID_Upd_Q(PID_Itm_t *pItm_)
+{
+	StdRtn_t retVal = ERR_PARAM_VALUE;
+	const PID_Gain_t *pGain = &pItm_->cfg.gain;
+	const PID_Sched_t *pSched = &pItm_->cfg.sched;
+	PID_Prm_t *pPrm = NULL;
+	PID_QSchedPt_t *pQPt = NULL;
+	uint16_t kMax = pGain->kP_scld;
+	uint8_t shift = 0u, i = 0u;
+
+	if( 0u != pGain->nScale )
+	{
+		retVal = ERR_OK;
+
+		kMax = ( pGain->kI_scld > kMax ) ? pGain->kI_scld : kMax;
+		kMax = ( pGain->kD_scld > kMax ) ? pGain->kD_scld : kMax;
+		for(i = 0u; i < pSched->numPts; i++)
+		{
+			kMax = ( pSched->aPts[i].kP_scld > kMax ) ? pSched->aPts[i].kP_scld : kMax;
+			kMax = ( pSched->aPts[i].kI_scld > kMax ) ? pSched->aPts[i].kI_scld : kMax;
+			kMax = ( pSched->aPts[i].kD_scld > kMax ) ? pSched->aPts[i].kD_scld : kMax;
+		}
+		shift = PID_Calc_Shift(kMax, pGain->nScale);
+
+		pPrm = PID_Begin_Upd(pItm_);
+		PID_Cvt_Gain(pGain, shift, &pPrm->qGain);
+		pPrm->qGain.dSrc  = pItm_->cfg.dSrc;
+		pPrm->qGain.nDFlt = ( pItm_->cfg.nDFlt > PID_D_FLT_SHIFT_MAX ) ? PID_D_FLT_SHIFT_MAX : pItm_->cfg.nDFlt;
+		pPrm->numPts      = pSched->numPts;
+		for(i = 0u; i < pSched->numPts; i++)
+		{
+			pQPt = &pPrm->aQSchedPts[i];
+			pQPt->schedVal = (int32_t)pSched->aPts[i].schedVal;
+			pQPt->kP_q     = PID_Cvt_Q(pSched->aPts[i].kP_scld, shift, pGain->nScale);
+			pQPt->kI_q     = PID_Cvt_Q(pSched->aPts[i].kI_scld, shift, pGain->nScale);
+			pQPt->kD_q     = PID_Cvt_Q(pSched->aPts[i].kD_scld, shift, pGain->nScale);
+			pQPt->recip    = ( (i + 1u) < pSched->numPts ) ?
+					( 0xFFFFFFFFu / (uint32_t)( pSched->aPts[i+1u].schedVal - pSched->aPts[i].schedVal ) ) : 0u;
+		}
+		PID_End_Upd(pItm_);
+	}
+	return retVal;
+}
+
+/**
+ * @brief Interpolates linearly between two gains, frac_ is the fraction as Q0.16
+ */
+static inline int32_t PID_Interp(int32_t k0_, int32_t k1_, uint32_t frac_)
+{
+	return k0_ + (int32_t)( ( (int64_t)( k1_ - k0_ ) * (int64_t)frac_ ) >> 16 );
+}
+
+/**
+ * @brief Calculates the binary point gains of a PID item at the current value of its scheduling
+ * variable
+ */
+static void PID_Sched_Gain(const PID_Itm_t *pItm_, int32_t setVal_, int32_t actVal_, PID_QGain_t *qGain_)
+{
+	const PID_QSchedPt_t *pPts = pItm_->cfg.prm.act.aQSchedPts;
+	const uint8_t numPts = pItm_->cfg.prm.act.numPts;
+	int32_t val = ( PID_SCHED_ACT == pItm_->cfg.schedVar ) ? actVal_ : setVal_;
+	uint32_t frac = 0u;
+	uint8_t i = 0u;
+
+	*qGain_ = pItm_->cfg.prm.act.qGain;
+	if( ( PID_SCHED_NONE != pItm_->cfg.schedVar ) && ( 0u != numPts ) )
+	{
+		val = ( val < 0 ) ? PID_Sat32( -(int64_t)val ) : val;
+		while( ( (i + 1u) < numPts ) && ( val >= pPts[i+1u].schedVal ) )
+		{
+			i++;
+		}
+		qGain_->kP_q = pPts[i].kP_q;
+		qGain_->kI_q = pPts[i].kI_q;
+		qGain_->kD_q = pPts[i].kD_q;
+		if( ( (i + 1u) < numPts ) && ( val > pPts[i].schedVal ) )
+		{
+			frac = (uint32_t)( ( (uint64_t)(uint32_t)( val - pPts[i].schedVal ) * pPts[i].recip ) >> 16 );
+			qGain_->kP_q = PID_Interp(pPts[i].kP_q, pPts[i+1u].kP_q, frac);
+			qGain_->kI_q = PID_Interp(pPts[i].kI_q, pPts[i+1u].kI_q, frac);
+			qGain_->kD_q = PID_Interp(pPts[i].kD_q, pPts[i+1u].kD_q, frac);
+		}
+	}
+}
+
+/**
+ * @brief Calculates the control value of a PID item according to its form
+ */
+static StdRtn_t PID_Calc(PID_Itm_t *pItm_, int32_t setVal_, int32_t actVal_, int32_t ffVal_, int32_t* ctrlVal_)
+{
+	StdRtn_t retVal = ERR_OK;
+	PID_QGain_t qGain = {0};
+	int32_t err = 0;
+
+	PID_Sync_Prm(pItm_);
+	PID_Sched_Gain(pItm_, setVal_, actVal_, &qGain);
+	if( PID_FORM_VEL == pItm_->cfg.form )
+	{
+		retVal = PIDvel(setVal_, actVal_, ffVal_, &qGain, &pItm_->data, ctrlVal_);
+	}
+	else
+	{
+		if( ( pItm_->data.prevKP_q >= 0 )
+				&& ( ( pItm_->data.prevKP_q != qGain.kP_q ) || ( pItm_->data.prevNShift != qGain.nShift ) ) )
+		{
+			/* the integral part takes over the change of the proportional part */
+			err = PID_Sat32( (int64_t)setVal_ - (int64_t)actVal_ );
+			pItm_->data.intVal = PID_SatBnd( PID_Sat32( (int64_t)pItm_->data.intVal
+					+ PID_MulShr(pItm_->data.prevKP_q, err, pItm_->data.prevNShift)
+					- PID_MulShr(qGain.kP_q, err, qGain.nShift) ), qGain.satVal );
+		}
+		pItm_->data.prevKP_q   = qGain.kP_q;
+		pItm_->data.prevNShift = qGain.nShift;
+		retVal = PIDq(setVal_, actVal_, &qGain, &pItm_->data, ctrlVal_);
+		if( ( ERR_OK == retVal ) && ( 0 != ffVal_ ) )
+		{
+			*ctrlVal_ = PID_SatBnd( PID_Sat32( (int64_t)*ctrlVal_ + (int64_t)ffVal_ ), qGain.satVal );
+		}
+	}
+	return retVal;
+}
+
+static void PID_Reset_Data(PID_Data_t *data_)
+{
+	data_->sat      = PID_NO_SAT;
+	data_->intVal   = 0;
+	data_->prevErr  = 0;
+	data_->prevAct  = 0;
+	data_->dFltVal  = 0;
+	data_->dVld     = FALSE;
+	data_->remVal   = 0;
+	data_->intHold  = FALSE;
+	data_->prevKP_q = -1;
+	data_->prevNShift = 0u;
+}
+
+/**
+ * @brief Loads the gain schedule of a PID item from NVM, or from its defaults if reading fails. An
+ * invalid schedule is disabled.
+ */
+static void PID_Load_Sched(PID_Itm_t *pItm_)
+{
+	NVM_PidSchedCfg_t nvmSched = {0};
+	StdRtn_t retVal = ERR_VALUE;
+	uint8_t i = 0u;
+
+	if( NULL != pItm_->cfg.nvm.readSchedFct )
+	{
+		retVal = pItm_->cfg.nvm.readSchedFct(&nvmSched);
+	}
+	if( (ERR_OK != retVal) && (NULL != pItm_->cfg.nvm.readDfltSchedFct) )
+	{
+		retVal = pItm_->cfg.nvm.readDfltSchedFct(&nvmSched);
+	}
+	pItm_->cfg.sched.numPts = 0u;
+	if( ( ERR_OK == retVal ) && ( nvmSched.NumPts <= PID_SCHED_PT_CNT ) )
+	{
+		for(i = 0u; i < nvmSched.NumPts; i++)
+		{
+			pItm_->cfg.sched.aPts[i].schedVal = nvmSched.aPts[i].SchedVal;
+			pItm_->cfg.sched.aPts[i].kP_scld  = nvmSched.aPts[i].KP_scld;
+			pItm_->cfg.sched.aPts[i].kI_scld  = nvmSched.aPts[i].KI_scld;
+			pItm_->cfg.sched.aPts[i].kD_scld  = nvmSched.aPts[i].KD_scld;
+		}
+		pItm_->cfg.sched.numPts = nvmSched.NumPts;
+		if( FALSE == PID_Is_SchedValid(&pItm_->cfg.sched) )
+		{
+			pItm_->cfg.sched.numPts = 0u;
+		}
+	}
+}
+
+/**
+ * @brief Loads the gains of a PID item from NVM, or from its defaults if reading fails
+ */
+static void PID_Load_Gain(PID_Itm_t *pItm_)
+{
+	NVM_PidCfg_t nvmPid = {0};
+	PID_Prm_t *pPrm = NULL;
+	StdRtn_t retVal = ERR_VALUE;
+
+	if( NULL != pItm_->cfg.nvm.readFct )
+	{
+		retVal = pItm_->cfg.nvm.readFct(&nvmPid);
+	}
+	if( (ERR_OK != retVal) && (NULL != pItm_->cfg.nvm.readDfltFct) )
+	{
+		retVal = pItm_->cfg.nvm.readDfltFct(&nvmPid);
+	}
+	if( ERR_OK == retVal )
+	{
+		pItm_->cfg.gain.kP_scld   = nvmPid.KP_scld;
+		pItm_->cfg.gain.kI_scld   = nvmPid.KI_scld;
+		pItm_->cfg.gain.kD_scld   = nvmPid.KD_scld;
+		pItm_->cfg.gain.nScale    = nvmPid.Scale;
+		pItm_->cfg.gain.intSatVal = nvmPid.SaturationVal;
+	}
+	else
+	{
+		/* take initialized values from pid_cfg.c */
+	}
+	PID_Load_Sched(pItm_);
+	if( ERR_OK != PID_Upd_Q(pItm_) )
+	{
+		/* invalid scaling factor - disable controller output and gain schedule */
+		pItm_->cfg.sched.numPts = 0u;
+		pPrm = PID_Begin_Upd(pItm_);
+		pPrm->qGain.kP_q   = 0;
+		pPrm->qGain.kI_q   = 0;
+		pPrm->qGain.kD_q   = 0;
+		pPrm->qGain.satVal = 0;
+		pPrm->qGain.nShift = 0u;
+		pPrm->numPts       = 0u;
+		PID_End_Upd(pItm_);
+	}
+}
 
 
 
@@ -120,6 +579,114 @@ StdRtn_t PIDext(int32_t setVal_, int32_t actVal_, const PID_Gain_t *gain_, PID_D
 	return retVal;
 }
 
+StdRtn_t PIDq(int32_t setVal_, int32_t actVal_, const PID_QGain_t *qGain_, PID_Data_t *data_, int32_t* ctrlVal_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+	int32_t err = 0, pTerm = 0, dTerm = 0;
+
+	if( ( NULL != ctrlVal_ ) && ( NULL != data_) && ( NULL != qGain_ ) )
+	{
+		retVal = ERR_OK;
+
+		/* Calculate current error value */
+		err = PID_Sat32( (int64_t)setVal_ - (int64_t)actVal_ );
+
+		/* Integration part and anti windup part */
+		if( ( (data_->sat <= PID_NEG_SAT)  && (err < 0) ) || ( (data_->sat >= PID_POS_SAT) && (err > 0) )
+				|| ( TRUE == data_->intHold ) )
+		{
+			/* don't allow integrating in direction of saturation -> do nothing */
+		}
+		else //allow integrating in opposite direction to saturation
+		{
+			data_->intVal = PID_Sat32( (int64_t)data_->intVal + PID_MulShr(qGain_->kI_q, err, qGain_->nShift) );
+		}
+
+		if( data_->intVal <= -qGain_->satVal )
+		{
+			data_->intVal = -qGain_->satVal;
+			data_->sat  = PID_NEG_SAT;
+		}
+		else if( data_->intVal >= qGain_->satVal )
+		{
+			data_->intVal = qGain_->satVal;
+			data_->sat  = PID_POS_SAT;
+		}
+		else
+		{
+			data_->sat = PID_NO_SAT;
+		}
+
+		/* Proportional part */
+		pTerm = PID_SatBnd( PID_MulShr(qGain_->kP_q, err, qGain_->nShift), qGain_->satVal );
+
+		/* Derivative part */
+		dTerm = PID_MulShr(qGain_->kD_q, PID_Flt_D(qGain_, data_, err, actVal_), qGain_->nShift + PID_D_FLT_FRAC);
+		data_->prevErr = err;
+
+		/* Calculate and bound output */
+		*ctrlVal_ = PID_SatBnd( PID_Sat32( (int64_t)pTerm + (int64_t)dTerm + (int64_t)data_->intVal ), qGain_->satVal );
+	}
+	return retVal;
+}
+
+StdRtn_t PIDvel(int32_t setVal_, int32_t actVal_, int32_t ffVal_, const PID_QGain_t *qGain_, PID_Data_t *data_, int32_t* ctrlVal_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+	int32_t err = 0, dErr = 0, dFltOld = 0, fbVal = 0;
+	int64_t incr = 0, lwrBnd = 0, uprBnd = 0;
+
+	if( ( NULL != ctrlVal_ ) && ( NULL != data_) && ( NULL != qGain_ ) )
+	{
+		retVal = ERR_OK;
+
+		/* Calculate current error value and its differences, the derivative part changes by the
+		 * difference of the filtered difference */
+		err     = PID_Sat32( (int64_t)setVal_ - (int64_t)actVal_ );
+		dErr    = PID_SatBnd( PID_Sat32( (int64_t)err - (int64_t)data_->prevErr ), PID_VEL_OPD_MAX );
+		dFltOld = data_->dFltVal;
+		(void)PID_Flt_D(qGain_, data_, err, actVal_);
+		data_->prevErr = err;
+
+		/* Increment in binary point representation including the remainder of the last call */
+		incr  = (int64_t)qGain_->kP_q * dErr;
+		if( FALSE == data_->intHold )
+		{
+			incr += (int64_t)qGain_->kI_q * PID_SatBnd(err, PID_VEL_OPD_MAX);
+		}
+		incr += ( (int64_t)qGain_->kD_q * ( (int64_t)data_->dFltVal - (int64_t)dFltOld ) ) >> PID_D_FLT_FRAC;
+		incr += data_->remVal;
+		data_->remVal = (int32_t)( incr & ( ((int64_t)1 << qGain_->nShift) - 1 ) );
+
+		/* Feedback part is bounded so that feedback and feedforward part don't exceed the saturation */
+		lwrBnd = -(int64_t)qGain_->satVal - ffVal_;
+		uprBnd =  (int64_t)qGain_->satVal - ffVal_;
+		incr   = (int64_t)data_->intVal + ( incr >> qGain_->nShift );
+		if( incr <= lwrBnd )
+		{
+			incr = lwrBnd;
+			data_->remVal = 0;
+			data_->sat = PID_NEG_SAT;
+		}
+		else if( incr >= uprBnd )
+		{
+			incr = uprBnd;
+			data_->remVal = 0;
+			data_->sat = PID_POS_SAT;
+		}
+		else
+		{
+			data_->sat = PID_NO_SAT;
+		}
+		fbVal = PID_Sat32(incr);
+		data_->intVal = fbVal;
+
+		/* Calculate and bound output */
+		*ctrlVal_ = PID_SatBnd( PID_Sat32( (int64_t)fbVal + (int64_t)ffVal_ ), qGain_->satVal );
+	}
+	return retVal;
+}
+
 StdRtn_t PID(int32_t setVal_, int32_t actVal_, uint8_t idx_, int32_t* ctrlVal_)
 {
 	StdRtn_t retVal = ERR_PARAM_ADDRESS;
@@ -130,7 +697,177 @@ StdRtn_t PID(int32_t setVal_, int32_t actVal_, uint8_t idx_, int32_t* ctrlVal_)
 
 		if(idx_ < pPidTbl->numPids)
 		{
-			retVal = PIDext(setVal_, actVal_, &pPidTbl->aPids[idx_].cfg.gain, &pPidTbl->aPids[idx_].data, ctrlVal_);
+			retVal = PID_Calc(&pPidTbl->aPids[idx_], setVal_, actVal_, 0, ctrlVal_);
+		}
+	}
+	return retVal;
+}
+
+StdRtn_t PID_Batch(uint8_t idx_, uint8_t cnt_, const int32_t *aSetVal_, const int32_t *aActVal_,
+		const int32_t *aFfVal_, int32_t *aCtrlVal_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+	PID_Itm_t *pItm = NULL;
+	uint8_t i = 0u;
+
+	if( ( NULL != aSetVal_ ) && ( NULL != aActVal_ ) && ( NULL != aCtrlVal_ )
+			&& ( NULL != pPidTbl ) && ( NULL != pPidTbl->aPids ) )
+	{
+		retVal = ERR_PARAM_INDEX;
+
+		if( ( (uint16_t)idx_ + (uint16_t)cnt_ ) <= (uint16_t)pPidTbl->numPids )
+		{
+			retVal = ERR_OK;
+			pItm = &pPidTbl->aPids[idx_];
+			for(i = 0u; i < cnt_; i++)
+			{
+				retVal |= PID_Calc(&pItm[i], aSetVal_[i], aActVal_[i], (NULL != aFfVal_) ? aFfVal_[i] : 0, &aCtrlVal_[i]);
+			}
+		}
+	}
+	return retVal;
+}
+
+StdRtn_t PID_Cvt_GainToQ(const PID_Gain_t *gain_, PID_QGain_t *qGain_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+	uint16_t kMax = 0u;
+
+	if( ( NULL != gain_ ) && ( NULL != qGain_ ) )
+	{
+		retVal = ERR_PARAM_VALUE;
+
+		if( 0u != gain_->nScale )
+		{
+			retVal = ERR_OK;
+
+			kMax = gain_->kP_scld;
+			if( gain_->kI_scld > kMax )
+			{
+				kMax = gain_->kI_scld;
+			}
+			if( gain_->kD_scld > kMax )
+			{
+				kMax = gain_->kD_scld;
+			}
+			PID_Cvt_Gain(gain_, PID_Calc_Shift(kMax, gain_->nScale), qGain_);
+			qGain_->dSrc  = PID_DSRC_ERR;
+			qGain_->nDFlt = 0u;
+		}
+	}
+	return retVal;
+}
+
+StdRtn_t PID_Set_Gain(uint8_t idx_, const PID_Gain_t *gain_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+
+	if( ( NULL != gain_ ) && ( NULL != pPidTbl ) && ( NULL != pPidTbl->aPids )  )
+	{
+		retVal = ERR_PARAM_INDEX;
+
+		if(idx_ < pPidTbl->numPids)
+		{
+			retVal = ERR_PARAM_VALUE;
+			if( 0u != gain_->nScale )
+			{
+				pPidTbl->aPids[idx_].cfg.gain = *gain_;
+				retVal = PID_Upd_Q(&pPidTbl->aPids[idx_]);
+			}
+		}
+	}
+	return retVal;
+}
+
+StdRtn_t PID_Set_Sched(uint8_t idx_, const PID_Sched_t *sched_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+
+	if( ( NULL != sched_ ) && ( NULL != pPidTbl ) && ( NULL != pPidTbl->aPids )  )
+	{
+		retVal = ERR_PARAM_INDEX;
+
+		if(idx_ < pPidTbl->numPids)
+		{
+			retVal = ERR_PARAM_VALUE;
+			if( TRUE == PID_Is_SchedValid(sched_) )
+			{
+				pPidTbl->aPids[idx_].cfg.sched = *sched_;
+				retVal = PID_Upd_Q(&pPidTbl->aPids[idx_]);
+			}
+		}
+	}
+	return retVal;
+}
+
+StdRtn_t PID_Upd_QGain(uint8_t idx_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+
+	if( ( NULL != pPidTbl ) && ( NULL != pPidTbl->aPids )  )
+	{
+		retVal = ERR_PARAM_INDEX;
+
+		if(idx_ < pPidTbl->numPids)
+		{
+			retVal = PID_Upd_Q(&pPidTbl->aPids[idx_]);
+		}
+	}
+	return retVal;
+}
+
+StdRtn_t PID_Set_Bumpless(uint8_t idx_, int32_t setVal_, int32_t actVal_, int32_t ffVal_, int32_t ctrlVal_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+	PID_Itm_t *pItm = NULL;
+	PID_QGain_t qGain = {0};
+	int32_t err = 0;
+
+	if( ( NULL != pPidTbl ) && ( NULL != pPidTbl->aPids )  )
+	{
+		retVal = ERR_PARAM_INDEX;
+
+		if(idx_ < pPidTbl->numPids)
+		{
+			retVal = ERR_OK;
+			pItm = &pPidTbl->aPids[idx_];
+			err  = PID_Sat32( (int64_t)setVal_ - (int64_t)actVal_ );
+			PID_Sync_Prm(pItm);
+			PID_Sched_Gain(pItm, setVal_, actVal_, &qGain);
+			PID_Reset_Data(&pItm->data);
+			pItm->data.prevErr  = err;
+			pItm->data.prevAct  = actVal_;
+			pItm->data.dVld     = TRUE;
+			pItm->data.prevKP_q = qGain.kP_q;
+			pItm->data.prevNShift = qGain.nShift;
+			if( PID_FORM_VEL == pItm->cfg.form )
+			{
+				/* the feedback part continues from the remaining control value */
+				pItm->data.intVal = PID_Sat32( (int64_t)ctrlVal_ - (int64_t)ffVal_ );
+			}
+			else
+			{
+				/* the integral part takes what the proportional part doesn't provide */
+				pItm->data.intVal = PID_SatBnd( PID_Sat32( (int64_t)ctrlVal_ - (int64_t)ffVal_
+						- PID_MulShr(qGain.kP_q, err, qGain.nShift) ), qGain.satVal );
+			}
+		}
+	}
+	return retVal;
+}
+
+StdRtn_t PID_Set_IntHold(uint8_t idx_, bool hold_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+
+	if( ( NULL != pPidTbl ) && ( NULL != pPidTbl->aPids )  )
+	{
+		retVal = ERR_PARAM_INDEX;
+
+		if(idx_ < pPidTbl->numPids)
+		{
+			retVal = ERR_OK;
+			pPidTbl->aPids[idx_].data.intHold = hold_;
 		}
 	}
 	return retVal;
@@ -147,54 +884,25 @@ StdRtn_t PID_Reset(uint8_t idx_)
 		if(idx_ < pPidTbl->numPids)
 		{
 		  retVal = ERR_OK;
-			pPidTbl->aPids[idx_].data.intVal = 0;
-			pPidTbl->aPids[idx_].data.prevErr = 0;
-			pPidTbl->aPids[idx_].data.sat = PID_NO_SAT;
+			PID_Reset_Data(&pPidTbl->aPids[idx_].data);
 		}
 	}
+	return retVal;
 }
 
 void PID_Init(void)
 {
 	uint8_t i = 0u;
-	NVM_PidCfg_t nvmPid = {0};
-	StdRtn_t retVal = ERR_PARAM_ADDRESS;
 
 	pPidTbl = Get_pPidItmTbl();
 
-	if( NULL != pPidTbl )
+	if( ( NULL != pPidTbl ) && ( NULL != pPidTbl->aPids ) )
 	{
 		for(i = 0u; i < pPidTbl->numPids; i++)
 		{
-			if(NULL != &pPidTbl->aPids[i])
-			{
-				if(NULL != pPidTbl->aPids[i].cfg.nvm.readFct)
-				{
-					retVal = ERR_VALUE;
-					retVal = pPidTbl->aPids[i].cfg.nvm.readFct(&nvmPid);
-					pPidTbl->aPids[i].cfg.gain.kP_scld = nvmPid.KP_scld;
-					pPidTbl->aPids[i].cfg.gain.kI_scld = nvmPid.KI_scld;
-					pPidTbl->aPids[i].cfg.gain.kD_scld = nvmPid.KD_scld;
-					pPidTbl->aPids[i].cfg.gain.nScale  = nvmPid.Scale;
-					pPidTbl->aPids[i].cfg.gain.intSatVal  = nvmPid.SaturationVal;
-				}
-				if ( (NULL != pPidTbl->aPids[i].cfg.nvm.readDfltFct) && (ERR_OK != retVal) )
-				{
-					retVal = pPidTbl->aPids[i].cfg.nvm.readFct(&nvmPid);
-					pPidTbl->aPids[i].cfg.gain.kP_scld = nvmPid.KP_scld;
-					pPidTbl->aPids[i].cfg.gain.kI_scld = nvmPid.KI_scld;
-					pPidTbl->aPids[i].cfg.gain.kD_scld = nvmPid.KD_scld;
-					pPidTbl->aPids[i].cfg.gain.nScale  = nvmPid.Scale;
-					pPidTbl->aPids[i].cfg.gain.intSatVal  = nvmPid.SaturationVal;
-				}
-				else
-				{
-					/* take initialized values from pid_cfg.c */
-				}
-				pPidTbl->aPids[i].data.sat = PID_NO_SAT;
-				pPidTbl->aPids[i].data.intVal  = 0;
-				pPidTbl->aPids[i].data.prevErr = 0;
-			}
+			PID_Load_Gain(&pPidTbl->aPids[i]);
+			PID_Reset_Data(&pPidTbl->aPids[i].data);
+			PID_Sync_Prm(&pPidTbl->aPids[i]);
 		}
 	}
 	else
@@ -40,6 +40,28 @@
  */
 #define PID_SWC_STRING ("PID controller")
 
+/**
+ * Maximum number of fractional bits of the gains in binary point representation. The rounded up
+ * gains reproduce the decimal scaling exactly as long as |error| < 2^nShift / nScale, hence as
+ * many bits as the products in 64 bit and the remainder of the velocity form in 32 bit allow.
+ */
+#define PID_Q_SHIFT_MAX (30u)
+
+/**
+ * Maximum number of points of a gain schedule
+ */
+#define PID_SCHED_PT_CNT (NVM_PID_SCHED_PT_CNT)
+
+/**
+ * Number of fractional bits of the filtered difference of the derivative part
+ */
+#define PID_D_FLT_FRAC (8u)
+
+/**
+ * Maximum exponent of the derivative filter, the filter constant is 2^-nDFlt
+ */
+#define PID_D_FLT_SHIFT_MAX (PID_D_FLT_FRAC)
+
 
 
 /*=================================== >> TYPE DEFINITIONS << =====================================*/
@@ -55,6 +77,73 @@ typedef struct PID_Gain_s
 	uint32_t intSatVal;
 }PID_Gain_t;
 
+/**
+ * @brief Source of the derivative part of a PID item
+ */
+typedef enum PID_DSrc_e
+{
+	 PID_DSRC_ERR = 0	/**< difference of the control error */
+	,PID_DSRC_MEAS		/**< negative difference of the current value, a change of the desired value doesn't kick */
+}PID_DSrc_t;
+
+/**
+ * @brief Gains in binary point representation which are derived from @ref PID_Gain_t
+ *
+ * The gains are signed Qx.nShift values, hence the decimal scaling factor of @ref PID_Gain_t is
+ * replaced by a right shift of nShift bits.
+ */
+typedef struct PID_QGain_s
+{
+	int32_t kP_q;
+	int32_t kI_q;
+	int32_t kD_q;
+	int32_t satVal;
+	uint8_t nShift;
+	PID_DSrc_t dSrc;	/**< source of the derivative part */
+	uint8_t nDFlt;		/**< exponent of the first order filter of the derivative part, 0 disables it */
+}PID_QGain_t;
+
+/**
+ * @brief Algorithm of a PID item
+ */
+typedef enum PID_Form_e
+{
+	 PID_FORM_POS = 0	/**< positional form, the integral part is kept in the runtime data */
+	,PID_FORM_VEL		/**< velocity form, the increment of the control value is calculated */
+}PID_Form_t;
+
+/**
+ * @brief Scheduling variable of the gains of a PID item
+ */
+typedef enum PID_SchedVar_e
+{
+	 PID_SCHED_NONE = 0	/**< no gain scheduling */
+	,PID_SCHED_SET		/**< absolute value of the desired value */
+	,PID_SCHED_ACT		/**< absolute value of the current value */
+}PID_SchedVar_t;
+
+/**
+ * @brief Point of a gain schedule with decimal scaled gains, the scaling factor and the anti
+ * windup bound are taken from @ref PID_Gain_t
+ */
+typedef struct PID_SchedPt_s
+{
+	uint16_t schedVal;
+	uint16_t kP_scld;
+	uint16_t kI_scld;
+	uint16_t kD_scld;
+}PID_SchedPt_t;
+
+/**
+ * @brief Gain schedule, the gains between two points are interpolated linearly and the gains
+ * of the first and the last point are kept beyond them
+ */
+typedef struct PID_Sched_s
+{
+	uint8_t numPts;		/**< number of valid points, 0 disables the schedule */
+	PID_SchedPt_t aPts[PID_SCHED_PT_CNT];	/**< points with strictly ascending schedVal */
+}PID_Sched_t;
+
 /**
  *
  */
@@ -71,8 +160,15 @@ typedef enum PID_Sat_e
 typedef struct PID_Data_s
 {
 	PID_Sat_t sat;
-	int32_t	intVal;
+	int32_t	intVal;		/**< integral part, or feedback part of the control value in velocity form */
 	int32_t	prevErr;
+	int32_t	prevAct;	/**< current value of the last call */
+	int32_t	dFltVal;	/**< filtered difference of the derivative part as Qx.PID_D_FLT_FRAC */
+	bool	dVld;		/**< prevAct is valid, i.e. the item has been calculated since its reset */
+	int32_t	remVal;		/**< remainder of the increments below one LSB, velocity form only */
+	bool	intHold;	/**< integration is suspended, e.g. while the setpoint is ramped */
+	int32_t	prevKP_q;	/**< scheduled proportional gain of the last call, positional form only */
+	uint8_t	prevNShift;	/**< binary point of prevKP_q */
 }PID_Data_t;
 
 
@@ -103,6 +199,123 @@ EXTERNAL_ StdRtn_t PID(int32_t setVal_, int32_t actVal_, uint8_t idx_, int32_t*
  */
 EXTERNAL_ StdRtn_t PIDext(int32_t setVal_, int32_t actVal_, const PID_Gain_t *gain_, PID_Data_t *data_, int32_t* ctrlVal_);
 
+/**
+ * @brief Calculates control value from error between setVal_ and actVal_ similar to
+ *        @ref PIDext but with gains in binary point representation. All terms are calculated
+ *        without division and saturated to the range of int32_t. The derivative part is taken
+ *        from the error or the current value and is low pass filtered according to qGain_.
+ * @param setVal_ The desired value
+ * @param actVal_ The current value
+ * @param qGain_  Gains and saturation value in binary point representation
+ * @param data_   Contains previous error, integral value, and saturation type
+ * @param ctrlVal_ The output control value
+ * @return Error code,  ERR_OK if everything was fine,
+ *                      ERR_PARAM_ADDRESS otherwise
+ */
+EXTERNAL_ StdRtn_t PIDq(int32_t setVal_, int32_t actVal_, const PID_QGain_t *qGain_, PID_Data_t *data_, int32_t* ctrlVal_);
+
+/**
+ * @brief Calculates the control value in velocity form. Only the increment of the control value is
+ *        calculated from the change of the error, hence the proportional part doesn't kick on
+ *        switching and the anti windup reduces to bounding the output.
+ * @param setVal_ The desired value
+ * @param actVal_ The current value
+ * @param ffVal_  Feedforward part which is added to the control value
+ * @param qGain_  Gains and saturation value in binary point representation
+ * @param data_   Contains the feedback part of the control value, previous errors and saturation type
+ * @param ctrlVal_ The output control value
+ * @return Error code,  ERR_OK if everything was fine,
+ *                      ERR_PARAM_ADDRESS otherwise
+ */
+EXTERNAL_ StdRtn_t PIDvel(int32_t setVal_, int32_t actVal_, int32_t ffVal_, const PID_QGain_t *qGain_, PID_Data_t *data_, int32_t* ctrlVal_);
+
+/**
+ * @brief Calculates the control values of cnt_ consecutive PID items in one call
+ * @param idx_      ID of the first PID item in @ref PID_ItmTbl_t
+ * @param cnt_      Number of PID items to be calculated
+ * @param aSetVal_  Array of cnt_ desired values
+ * @param aActVal_  Array of cnt_ current values
+ * @param aFfVal_   Array of cnt_ feedforward values, or NULL if there is no feedforward part
+ * @param aCtrlVal_ Array of cnt_ output control values
+ * @return Error code,  ERR_OK if everything was fine,
+ *                      ERR_PARAM_INDEX if the items don't exist in @ref PID_ItmTbl_t,
+ *                      ERR_PARAM_ADDRESS otherwise
+ */
+EXTERNAL_ StdRtn_t PID_Batch(uint8_t idx_, uint8_t cnt_, const int32_t *aSetVal_, const int32_t *aActVal_,
+		const int32_t *aFfVal_, int32_t *aCtrlVal_);
+
+/**
+ * @brief Initialises the runtime data of a PID item, so that its next calculation continues
+ *        from ctrlVal_ without a bump, e.g. when it takes over the motor from another item
+ * @param idx_     ID of PID item in @ref PID_ItmTbl_t
+ * @param setVal_  The desired value
+ * @param actVal_  The current value
+ * @param ffVal_   Feedforward part of the control value
+ * @param ctrlVal_ The control value to continue from
+ * @return Error code,  ERR_OK if everything was fine,
+ *                      ERR_PARAM_INDEX if idx_ doesn't exist in @ref PID_ItmTbl_t,
+ *                      ERR_PARAM_ADDRESS otherwise
+ */
+EXTERNAL_ StdRtn_t PID_Set_Bumpless(uint8_t idx_, int32_t setVal_, int32_t actVal_, int32_t ffVal_, int32_t ctrlVal_);
+
+/**
+ * @brief Converts decimal scaled gains into binary point representation. The number of
+ *        fractional bits is chosen as large as possible, but not larger than @ref PID_Q_SHIFT_MAX.
+ *        The derivative part is set to the unfiltered difference of the error.
+ * @param gain_  Decimal scaled gains as stored in the NVM
+ * @param qGain_ Resulting gains in binary point representation
+ * @return Error code,  ERR_OK if everything was fine,
+ *                      ERR_PARAM_VALUE if the scaling factor is zero,
+ *                      ERR_PARAM_ADDRESS otherwise
+ */
+EXTERNAL_ StdRtn_t PID_Cvt_GainToQ(const PID_Gain_t *gain_, PID_QGain_t *qGain_);
+
+/**
+ * @brief Sets new decimal scaled gains of a PID item and updates its binary point gains. The
+ *        new gains are applied by the next calculation of the item, so they can be changed while
+ *        the item is running.
+ * @param idx_  ID of PID item in @ref PID_ItmTbl_t
+ * @param gain_ New gains
+ * @return Error code,  ERR_OK if everything was fine,
+ *                      ERR_PARAM_INDEX if idx_ doesn't exist in @ref PID_ItmTbl_t,
+ *                      ERR_PARAM_VALUE if the scaling factor is zero,
+ *                      ERR_PARAM_ADDRESS otherwise
+ */
+EXTERNAL_ StdRtn_t PID_Set_Gain(uint8_t idx_, const PID_Gain_t *gain_);
+
+/**
+ * @brief Updates the binary point gains of a PID item from its decimal scaled gains
+ * @param idx_ ID of PID item in @ref PID_ItmTbl_t
+ * @return Error code,  ERR_OK if everything was fine,
+ *                      ERR_PARAM_INDEX if idx_ doesn't exist in @ref PID_ItmTbl_t,
+ *                      ERR_PARAM_ADDRESS otherwise
+ */
+EXTERNAL_ StdRtn_t PID_Upd_QGain(uint8_t idx_);
+
+/**
+ * @brief Sets a new gain schedule of a PID item and updates its binary point gains. The gains of
+ *        all points share the binary point of the item's gains, so switching between them is
+ *        free of glitches.
+ * @param idx_   ID of PID item in @ref PID_ItmTbl_t
+ * @param sched_ New gain schedule
+ * @return Error code,  ERR_OK if everything was fine,
+ *                      ERR_PARAM_INDEX if idx_ doesn't exist in @ref PID_ItmTbl_t,
+ *                      ERR_PARAM_VALUE if the points aren't strictly ascending or too many,
+ *                      ERR_PARAM_ADDRESS otherwise
+ */
+EXTERNAL_ StdRtn_t PID_Set_Sched(uint8_t idx_, const PID_Sched_t *sched_);
+
+/**
+ * @brief Suspends or resumes the integration of a PID item (conditional integration). While the
+ *        setpoint is ramped, the tracking error of the ramp would wind up the integral part.
+ * @param idx_  ID of PID item in @ref PID_ItmTbl_t
+ * @param hold_ TRUE to suspend integration, FALSE to resume it
+ * @return Error code,  ERR_OK if everything was fine,
+ *                      ERR_PARAM_INDEX if idx_ doesn't exist in @ref PID_ItmTbl_t,
+ *                      ERR_PARAM_ADDRESS otherwise
+ */
+EXTERNAL_ StdRtn_t PID_Set_IntHold(uint8_t idx_, bool hold_);
+
 /**
  * @brief Resets a PID item by resetting runtime data
  * @param idx_ ID of PID item in @ref PID_ItmTbl_t that is to be resetted
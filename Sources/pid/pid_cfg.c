@@ -16,9 +16,7 @@
 #define MASTER_pid_cfg_C_
 
 // TODO
-// - rework scaling of gains from decimal point to binary point
 // - Add #ID in error message in cls handler
-// - Implement PID for ramps/trajectories
 // - Move strings to parent component DRV
 
 /*======================================= >> #INCLUDES << ========================================*/
@@ -36,6 +34,8 @@
 #define PID_RGHT_MTR_SPD_STR ("speed R")
 #define PID_LFT_MTR_POS_STR  ("pos L")
 #define PID_RGHT_MTR_POS_STR ("pos R")
+#define PID_SYNC_STR         ("sync")
+#define SYNC_MAX_VAL         (400u)
 
 
 
@@ -51,19 +51,25 @@
 static PID_Itm_t items[] =
 {
 		{	{PID_LFT_MTR_SPD_STR,  {2000u, 80u, 0u, 100u, MOTOR_MAX_VAL},
-			{NVM_Read_PIDSpdLeCfg, NVM_Read_Dflt_PIDSpdLeCfg, NVM_Save_PIDSpdLeCfg}},
+			{NVM_Read_PIDSpdLeCfg, NVM_Read_Dflt_PIDSpdLeCfg, NVM_Save_PIDSpdLeCfg,
+			 NVM_Read_PIDSchedSpdLeCfg, NVM_Read_Dflt_PIDSchedSpdLeCfg, NVM_Save_PIDSchedSpdLeCfg}, PID_FORM_VEL, PID_SCHED_SET, PID_DSRC_MEAS, 2u},
 			{0}
 		},
 		{	{PID_RGHT_MTR_SPD_STR, {2000u, 80u, 0u, 100u, MOTOR_MAX_VAL},
-			{NVM_Read_PIDSpdRiCfg, NVM_Read_Dflt_PIDSpdRiCfg, NVM_Save_PIDSpdRiCfg}},
+			{NVM_Read_PIDSpdRiCfg, NVM_Read_Dflt_PIDSpdRiCfg, NVM_Save_PIDSpdRiCfg,
+			 NVM_Read_PIDSchedSpdRiCfg, NVM_Read_Dflt_PIDSchedSpdRiCfg, NVM_Save_PIDSchedSpdRiCfg}, PID_FORM_VEL, PID_SCHED_SET, PID_DSRC_MEAS, 2u},
 			{0}
 		},
 		{ 	{PID_LFT_MTR_POS_STR,  {1000u, 1u, 50u, 100u, MOTOR_MAX_VAL},
-			{NVM_Read_PIDPosCfg, NVM_Read_Dflt_PIDPosCfg, NVM_Save_PIDPosCfg}},
+			{NVM_Read_PIDPosCfg, NVM_Read_Dflt_PIDPosCfg, NVM_Save_PIDPosCfg, NULL, NULL, NULL}, PID_FORM_POS, PID_SCHED_NONE, PID_DSRC_MEAS, 2u},
 			{0}
 		},
 		{ 	{PID_RGHT_MTR_POS_STR, {1000u, 1u, 50u, 100u, MOTOR_MAX_VAL},
-			{NVM_Read_PIDPosCfg, NVM_Read_Dflt_PIDPosCfg, NVM_Save_PIDPosCfg}},
+			{NVM_Read_PIDPosCfg, NVM_Read_Dflt_PIDPosCfg, NVM_Save_PIDPosCfg, NULL, NULL, NULL}, PID_FORM_POS, PID_SCHED_NONE, PID_DSRC_MEAS, 2u},
+			{0}
+		},
+		{ 	{PID_SYNC_STR,         {800u, 20u, 0u, 100u, SYNC_MAX_VAL},
+			{NVM_Read_PIDSyncCfg, NVM_Read_Dflt_PIDSyncCfg, NVM_Save_PIDSyncCfg, NULL, NULL, NULL}, PID_FORM_POS, PID_SCHED_NONE, PID_DSRC_ERR, 2u},
 			{0}
 		},
 };
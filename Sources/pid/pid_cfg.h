@@ -32,6 +32,19 @@
 
 
 /*=================================== >> TYPE DEFINITIONS << =====================================*/
+/**
+ * @brief IDs of the PID items in pid_cfg.c
+ */
+typedef enum PID_ID_e
+{
+	 PID_ID_SPD_LE = 0
+	,PID_ID_SPD_RI
+	,PID_ID_POS_LE
+	,PID_ID_POS_RI
+	,PID_ID_SYNC
+	,PID_ID_CNT
+}PID_ID_t;
+
 /**
  *
  */
@@ -45,12 +58,59 @@ typedef StdRtn_t PID_NVMSaveFct_t(const NVM_PidCfg_t *);
 /**
  *
  */
+typedef StdRtn_t PID_NVMReadSchedFct_t(NVM_PidSchedCfg_t*);
+
+/**
+ *
+ */
+typedef StdRtn_t PID_NVMSaveSchedFct_t(const NVM_PidSchedCfg_t *);
+
+/**
+ * @brief NVM access of the gains and of the gain schedule, the latter is optional
+ */
 typedef struct PID_NVM_s{
 	PID_NVMReadFct_t *readFct;
 	PID_NVMReadFct_t *readDfltFct;
 	PID_NVMSaveFct_t *saveFct;
+	PID_NVMReadSchedFct_t *readSchedFct;
+	PID_NVMReadSchedFct_t *readDfltSchedFct;
+	PID_NVMSaveSchedFct_t *saveSchedFct;
 } PID_NVM_t;
 
+/**
+ * @brief Point of a gain schedule in binary point representation
+ */
+typedef struct PID_QSchedPt_s
+{
+	int32_t schedVal;
+	uint32_t recip;		/**< 0xFFFFFFFF divided by the distance to the next point */
+	int32_t kP_q;
+	int32_t kI_q;
+	int32_t kD_q;
+}PID_QSchedPt_t;
+
+/**
+ * @brief Parameters of a PID item in binary point representation as used by the calculation
+ */
+typedef struct PID_Prm_s
+{
+	PID_QGain_t qGain;
+	uint8_t numPts;				/**< number of points of the gain schedule, 0 disables it */
+	PID_QSchedPt_t aQSchedPts[PID_SCHED_PT_CNT];
+}PID_Prm_t;
+
+/**
+ * @brief Double buffer of the parameters. New parameters are prepared in pend while the
+ * calculation keeps on using act. They are handed over at the start of the next calculation.
+ */
+typedef struct PID_PrmBuf_s
+{
+	PID_Prm_t act;				/**< parameters of the current calculation */
+	PID_Prm_t pend;				/**< parameters of the next calculation */
+	volatile uint32_t pendSeq;	/**< sequence number of pend, it is odd while pend is written */
+	uint32_t actSeq;			/**< sequence number of act */
+}PID_PrmBuf_t;
+
 /**
  *
  */
@@ -59,6 +119,12 @@ typedef struct PID_Cfg_s
 	const uchar_t *pItmName;
 	PID_Gain_t gain;
 	PID_NVM_t nvm;
+	PID_Form_t form;
+	PID_SchedVar_t schedVar;
+	PID_DSrc_t dSrc;			/**< source of the derivative part */
+	uint8_t nDFlt;				/**< exponent of the derivative filter, 0...PID_D_FLT_SHIFT_MAX */
+	PID_Sched_t sched;
+	PID_PrmBuf_t prm;
 }PID_Cfg_t;
 
 /**
@@ -5,8 +5,8 @@
  *
  * This module implements the interface of the SWC @ref pid which is addressed to
  * the SWC @ref sh. It introduces application specific commands for requests of status information,
- * changing PID controller parameters, or restoring them from NVM via command line shell (@b CLS).
- * The changed parameters are immediately saved to the @ref nvm.
+ * changing PID controller parameters and gain schedules, or restoring them from NVM via command line
+ * shell (@b CLS). The changed parameters are immediately saved to the @ref nvm.
  *
  * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
  * @date 	28.02.2017
@@ -55,12 +55,22 @@ typedef StdRtn_t ReadPIDCfg_t(NVM_PidCfg_t *);
  */
 typedef StdRtn_t SavePIDCfg_t(const NVM_PidCfg_t *);
 
+/**
+ *
+ */
+typedef StdRtn_t ReadPIDSchedCfg_t(NVM_PidSchedCfg_t *);
+
+/**
+ *
+ */
+typedef StdRtn_t SavePIDSchedCfg_t(const NVM_PidSchedCfg_t *);
+
 
 
 /*============================= >> LOKAL FUNCTION DECLARATIONS << ================================*/
 static StdRtn_t Parse_PidID(const uchar_t *cmd_, const uchar_t **p_, uint8_t *id_);
 static void Print_PidHelp(const CLS1_StdIOType *io_);
-static void Print_PidItmStatus(const PID_Gain_t* gain_, const PID_Data_t *data_,
+static void Print_PidItmStatus(const PID_Gain_t* gain_, const PID_QGain_t* qGain_, const PID_Data_t *data_,
 		const uchar_t *kindStr_, uint8_t id_, const CLS1_StdIOType *io_);
 static void Print_PidStatus(uint8_t id_, const CLS1_StdIOType *io_);
 static void Restore_PidGainCfg(ReadPIDCfg_t *readDfltCfg_, SavePIDCfg_t *saveCfg_,PID_Gain_t* gain_,
@@ -69,6 +79,13 @@ static uint8_t Parse_PidGainArgs(PID_Gain_t* gain_, const uchar_t *cmd_, bool *h
 		const CLS1_StdIOType *io_);
 static StdRtn_t Save_PidGainCfg(SavePIDCfg_t *saveCfg_, PID_Gain_t *gain_,
 		const CLS1_StdIOType *io_);
+static void Print_PidSchedStatus(const PID_Cfg_t *cfg_, const CLS1_StdIOType *io_);
+static uint8_t Parse_PidSchedArgs(PID_Sched_t *sched_, const uchar_t *cmd_, bool *handled_,
+		const CLS1_StdIOType *io_);
+static StdRtn_t Save_PidSchedCfg(SavePIDSchedCfg_t *saveCfg_, const PID_Sched_t *sched_,
+		const CLS1_StdIOType *io_);
+static void Restore_PidSchedCfg(ReadPIDSchedCfg_t *readDfltCfg_, SavePIDSchedCfg_t *saveCfg_, uint8_t id_,
+		const CLS1_StdIOType *io_);
 
 
 
@@ -117,17 +134,20 @@ static void Print_PidHelp(const CLS1_StdIOType *io_)
 	CLS1_SendHelpStr((uchar_t*)PID_SHORT_STRING, (uchar_t*)"Group of pid commands\r\n", io_->stdOut);
 	CLS1_SendHelpStr((unsigned char*)" [#ID] help|status", (unsigned char*)"Shows pid help or status\r\n", io_->stdOut);
 	CLS1_SendHelpStr((unsigned char*)"  #ID set (p|i|d) <value>", (unsigned char*)"Sets a new P-, I-, or D-gain value for #ID and saves it to the NVM\r\n", io_->stdOut);
-	CLS1_SendHelpStr((unsigned char*)"  #ID set bp <0...15>", (unsigned char*)"Sets a new binary point for the gains of #ID and saves it to the NVM\r\n", io_->stdOut);
+	CLS1_SendHelpStr((unsigned char*)"  #ID set bp <1...100>", (unsigned char*)"Sets a new scaling factor for the gains of #ID and saves it to the NVM\r\n", io_->stdOut);
 	CLS1_SendHelpStr((unsigned char*)"  #ID set a-wup <value>", (unsigned char*)"Sets a new anti-windup bound for #ID and saves it to the NVM\r\n", io_->stdOut);
+	CLS1_SendHelpStr((unsigned char*)"  #ID sched set <pt> <val> <p> <i> <d>", (unsigned char*)"Sets point <pt> of the gain schedule of #ID and saves it to the NVM\r\n", io_->stdOut);
+	CLS1_SendHelpStr((unsigned char*)"  #ID sched cnt <0...4>", (unsigned char*)"Sets the number of points of the gain schedule of #ID, 0 disables it\r\n", io_->stdOut);
+	CLS1_SendHelpStr((unsigned char*)"  #ID sched restore", (unsigned char*)"Restores the default gain schedule of #ID and saves it to the NVM\r\n", io_->stdOut);
 	CLS1_SendHelpStr((unsigned char*)"  #ID restore", (unsigned char*)"Restores default parameters for #ID and saves them to the NVM\r\n", io_->stdOut);
 	CLS1_SendHelpStr((unsigned char*)"  restore all", (unsigned char*)"Restores default parameters for all #IDs and saves them to the NVM\r\n", io_->stdOut);
 }
 
 
-static void Print_PidItmStatus(const PID_Gain_t* gain_, const PID_Data_t *data_,
+static void Print_PidItmStatus(const PID_Gain_t* gain_, const PID_QGain_t* qGain_, const PID_Data_t *data_,
 		const uchar_t *kindStr_, uint8_t id_, const CLS1_StdIOType *io_)
 {
-	uchar_t buf[48];
+	uchar_t buf[64];
 
 	UTIL1_strcpy(buf,sizeof(buf),(uchar_t*)PID_SHORT_STRING);
 	UTIL1_strcat(buf, sizeof(buf), (uchar_t*)" #");
@@ -152,6 +172,24 @@ static void Print_PidItmStatus(const PID_Gain_t* gain_, const PID_Data_t *data_,
 	UTIL1_strcat(buf, sizeof(buf), (uchar_t*)"\r\n");
 	CLS1_SendStatusStr("  bin point", buf, io_->stdOut);
 
+	buf[0] = '\0';
+	UTIL1_strcpy(buf, sizeof(buf), (uchar_t*)"p: ");
+	UTIL1_strcatNum32s(buf, sizeof(buf), qGain_->kP_q);
+	UTIL1_strcat(buf, sizeof(buf), (uchar_t*)"  i: ");
+	UTIL1_strcatNum32s(buf, sizeof(buf), qGain_->kI_q);
+	UTIL1_strcat(buf, sizeof(buf), (uchar_t*)"  d: ");
+	UTIL1_strcatNum32s(buf, sizeof(buf), qGain_->kD_q);
+	UTIL1_strcat(buf, sizeof(buf), (uchar_t*)"  >> ");
+	UTIL1_strcatNum8u(buf, sizeof(buf), qGain_->nShift);
+	UTIL1_strcat(buf, sizeof(buf), (uchar_t*)"\r\n");
+	CLS1_SendStatusStr((uchar_t*)"  q gains", buf, io_->stdOut);
+
+	UTIL1_strcpy(buf, sizeof(buf), (PID_DSRC_MEAS == qGain_->dSrc) ? (uchar_t*)"meas" : (uchar_t*)"error");
+	UTIL1_strcat(buf, sizeof(buf), (uchar_t*)"  filter 2^-");
+	UTIL1_strcatNum8u(buf, sizeof(buf), qGain_->nDFlt);
+	UTIL1_strcat(buf, sizeof(buf), (uchar_t*)"\r\n");
+	CLS1_SendStatusStr((uchar_t*)"  d-part", buf, io_->stdOut);
+
 	buf[0] = '\0';
 	UTIL1_strcpy(buf, sizeof(buf), (uchar_t*)"0x");
 	UTIL1_strcatNum32Hex(buf, sizeof(buf), gain_->intSatVal);
@@ -188,16 +226,18 @@ static void Print_PidStatus(uint8_t id_, const CLS1_StdIOType *io_)
 		{
 				for(i = 0u; i < pTbl->numPids; i++)
 				{
-					Print_PidItmStatus(&(pTbl->aPids[i].cfg.gain), &(pTbl->aPids[i].data),
+					Print_PidItmStatus(&(pTbl->aPids[i].cfg.gain), &(pTbl->aPids[i].cfg.prm.act.qGain), &(pTbl->aPids[i].data),
 							pTbl->aPids[i].cfg.pItmName, i, io_);
+					Print_PidSchedStatus(&(pTbl->aPids[i].cfg), io_);
 				}
 		}
 		else
 		{
 			if(id_ < pTbl->numPids)
 			{
-				Print_PidItmStatus(&(pTbl->aPids[id_].cfg.gain), &(pTbl->aPids[id_].data),
+				Print_PidItmStatus(&(pTbl->aPids[id_].cfg.gain), &(pTbl->aPids[id_].cfg.prm.act.qGain), &(pTbl->aPids[id_].data),
 						pTbl->aPids[id_].cfg.pItmName, id_, io_);
+				Print_PidSchedStatus(&(pTbl->aPids[id_].cfg), io_);
 			}
 			else
 			{
@@ -337,7 +377,7 @@ static uint8_t Parse_PidGainArgs(PID_Gain_t* gain_, const uchar_t *cmd_, bool *h
 		{
 			*handled_ = TRUE;
 			p = cmd_+sizeof("bp");
-			if (UTIL1_ScanDecimal8uNumber(&p, &val8u)==ERR_OK && val8u<=100)
+			if (UTIL1_ScanDecimal8uNumber(&p, &val8u)==ERR_OK && val8u>0u && val8u<=100)
 			{
 				gain_->nScale = val8u;
 				retVal = ERR_OK;
@@ -396,6 +436,192 @@ static StdRtn_t Save_PidGainCfg(SavePIDCfg_t *saveCfg_, PID_Gain_t *gain_, const
 		CLS1_SendStr((uchar_t*)"*** ERROR: Setting new parameters failed - "
 						"Invalid reference to gain configuration ***\r\n", io_->stdErr);
 	}
+	return retVal;
+}
+
+
+static void Print_PidSchedStatus(const PID_Cfg_t *cfg_, const CLS1_StdIOType *io_)
+{
+	uchar_t buf[64];
+	uchar_t name[16];
+	uint8_t i = 0u;
+
+	UTIL1_strcpy(buf, sizeof(buf), (uchar_t*)"act ");
+	UTIL1_strcatNum32u(buf, sizeof(buf), cfg_->prm.actSeq);
+	UTIL1_strcat(buf, sizeof(buf), (uchar_t*)"  pend ");
+	UTIL1_strcatNum32u(buf, sizeof(buf), cfg_->prm.pendSeq);
+	UTIL1_strcat(buf, sizeof(buf), (uchar_t*)"\r\n");
+	CLS1_SendStatusStr((uchar_t*)"  param seq", buf, io_->stdOut);
+
+	buf[0] = '\0';
+	UTIL1_Num8uToStr(buf, sizeof(buf), cfg_->sched.numPts);
+	UTIL1_strcat(buf, sizeof(buf), (uchar_t*)" pts by ");
+	UTIL1_strcat(buf, sizeof(buf), (PID_SCHED_SET == cfg_->schedVar) ? (uchar_t*)"set val" :
+			( (PID_SCHED_ACT == cfg_->schedVar) ? (uchar_t*)"act val" : (uchar_t*)"none" ) );
+	UTIL1_strcat(buf, sizeof(buf), (uchar_t*)"\r\n");
+	CLS1_SendStatusStr((uchar_t*)"  gain sched", buf, io_->stdOut);
+
+	for(i = 0u; i < cfg_->sched.numPts; i++)
+	{
+		UTIL1_strcpy(name, sizeof(name), (uchar_t*)"    pt ");
+		UTIL1_strcatNum8u(name, sizeof(name), i);
+		UTIL1_strcpy(buf, sizeof(buf), (uchar_t*)"val: ");
+		UTIL1_strcatNum16u(buf, sizeof(buf), cfg_->sched.aPts[i].schedVal);
+		UTIL1_strcat(buf, sizeof(buf), (uchar_t*)"  p: ");
+		UTIL1_strcatNum16u(buf, sizeof(buf), cfg_->sched.aPts[i].kP_scld);
+		UTIL1_strcat(buf, sizeof(buf), (uchar_t*)"  i: ");
+		UTIL1_strcatNum16u(buf, sizeof(buf), cfg_->sched.aPts[i].kI_scld);
+		UTIL1_strcat(buf, sizeof(buf), (uchar_t*)"  d: ");
+		UTIL1_strcatNum16u(buf, sizeof(buf), cfg_->sched.aPts[i].kD_scld);
+		UTIL1_strcat(buf, sizeof(buf), (uchar_t*)"\r\n");
+		CLS1_SendStatusStr(name, buf, io_->stdOut);
+	}
+}
+
+
+static uint8_t Parse_PidSchedArgs(PID_Sched_t *sched_, const uchar_t *cmd_, bool *handled_, const CLS1_StdIOType *io_)
+{
+	const uchar_t *p;
+	PID_SchedPt_t pt = {0u};
+	uint8_t idx = 0u;
+	uint8_t retVal = ERR_PARAM_ADDRESS;
+
+	if(NULL != sched_)
+	{
+		retVal = ERR_PARAM_DATA;
+		while( ' ' == *cmd_ )
+		{
+			cmd_++;
+		}
+
+		if ( ERR_OK == UTIL1_strncmp((char*)cmd_, (char*)"set ", sizeof("set ")-1) )
+		{
+			*handled_ = TRUE;
+			p = cmd_+sizeof("set");
+			if (   (UTIL1_ScanDecimal8uNumber(&p, &idx)==ERR_OK) && (idx < PID_SCHED_PT_CNT)
+				&& (UTIL1_ScanDecimal16uNumber(&p, &pt.schedVal)==ERR_OK)
+				&& (UTIL1_ScanDecimal16uNumber(&p, &pt.kP_scld)==ERR_OK)
+				&& (UTIL1_ScanDecimal16uNumber(&p, &pt.kI_scld)==ERR_OK)
+				&& (UTIL1_ScanDecimal16uNumber(&p, &pt.kD_scld)==ERR_OK) )
+			{
+				sched_->aPts[idx] = pt;
+				if( idx >= sched_->numPts )
+				{
+					sched_->numPts = idx + 1u;
+				}
+				retVal = ERR_OK;
+			}
+			else
+			{
+				CLS1_SendStr((uchar_t*)"Wrong argument\r\n", io_->stdErr);
+			}
+		}
+		else if ( ERR_OK == UTIL1_strncmp((char*)cmd_, (char*)"cnt ", sizeof("cnt ")-1) )
+		{
+			*handled_ = TRUE;
+			p = cmd_+sizeof("cnt");
+			if (UTIL1_ScanDecimal8uNumber(&p, &idx)==ERR_OK && idx<=PID_SCHED_PT_CNT)
+			{
+				sched_->numPts = idx;
+				retVal = ERR_OK;
+			}
+			else
+			{
+				CLS1_SendStr((uchar_t*)"Wrong argument\r\n", io_->stdErr);
+			}
+		}
+		else
+		{
+			*handled_ = FALSE;
+		}
+	}
+	return retVal;
+}
+
+
+static StdRtn_t Save_PidSchedCfg(SavePIDSchedCfg_t *saveCfg_, const PID_Sched_t *sched_, const CLS1_StdIOType *io_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+	NVM_PidSchedCfg_t tmp = {0u};
+	uint8_t i = 0u;
+
+	if ( NULL != saveCfg_ )
+	{
+		tmp.NumPts = sched_->numPts;
+		for(i = 0u; i < sched_->numPts; i++)
+		{
+			tmp.aPts[i].SchedVal = sched_->aPts[i].schedVal;
+			tmp.aPts[i].KP_scld  = sched_->aPts[i].kP_scld;
+			tmp.aPts[i].KI_scld  = sched_->aPts[i].kI_scld;
+			tmp.aPts[i].KD_scld  = sched_->aPts[i].kD_scld;
+		}
+		if (ERR_OK == saveCfg_(&tmp))
+		{
+			retVal = ERR_OK;
+			CLS1_SendStr((uchar_t*)">>> Saving to NVM successful...\r\n", io_->stdOut);
+		}
+		else
+		{
+			CLS_SEND_ERR_NVM_DATATYPE;
+		}
+	}
+	else
+	{
+		CLS1_SendStr((uchar_t*)"*** ERROR: Saving to NVM failed - "
+				"Invalid WRITE Function ***\r\n", io_->stdErr);
+	}
+	return retVal;
+}
+
+
+static void Restore_PidSchedCfg(ReadPIDSchedCfg_t *readDfltCfg_, SavePIDSchedCfg_t *saveCfg_, uint8_t id_,
+		const CLS1_StdIOType *io_)
+{
+	NVM_PidSchedCfg_t tmp = {0u};
+	PID_Sched_t sched = {0u};
+	uint8_t i = 0u;
+
+	if ( (NULL != readDfltCfg_) && (NULL != saveCfg_) )
+	{
+		if ( ( ERR_OK == readDfltCfg_(&tmp) ) && ( tmp.NumPts <= PID_SCHED_PT_CNT ) )
+		{
+			sched.numPts = tmp.NumPts;
+			for(i = 0u; i < tmp.NumPts; i++)
+			{
+				sched.aPts[i].schedVal = tmp.aPts[i].SchedVal;
+				sched.aPts[i].kP_scld  = tmp.aPts[i].KP_scld;
+				sched.aPts[i].kI_scld  = tmp.aPts[i].KI_scld;
+				sched.aPts[i].kD_scld  = tmp.aPts[i].KD_scld;
+			}
+			if ( ERR_OK == PID_Set_Sched(id_, &sched) )
+			{
+				CLS1_SendStr((uchar_t*)">>> Restoring successful...\r\n", io_->stdOut);
+				if (ERR_OK == saveCfg_(&tmp))
+				{
+					CLS1_SendStr((uchar_t*)">>> Saving to NVM successful...\r\n", io_->stdOut);
+				}
+				else
+				{
+					CLS_SEND_ERR_NVM_DATATYPE;
+				}
+			}
+			else
+			{
+				CLS1_SendStr((uchar_t*)"*** ERROR: Restoring failed - "
+						"Default gain schedule invalid ***\r\n", io_->stdErr);
+			}
+		}
+		else
+		{
+			CLS1_SendStr((uchar_t*)"*** ERROR: Restoring failed - "
+					"NVM configuration data type invalid ***\r\n", io_->stdErr);
+		}
+	}
+	else
+	{
+		CLS1_SendStr((uchar_t*)"*** ERROR: Restoring failed - "
+				"Invalid READ and/or WRITE Function(s) ***\r\n", io_->stdErr);
+	}
 }
 
 
@@ -406,7 +632,8 @@ uint8_t PID_ParseCommand(const uchar_t *cmd_, bool *handled_, const CLS1_StdIOTy
 	PID_ItmTbl_t *pPidTbl = Get_pPidItmTbl();
 	uint8_t pidID = 0u;
 	const uchar_t *p = NULL;
-	uchar_t buf[sizeof("pid #ID set a-wup 0xFFFFFFFFu")]={'\0'};
+	PID_Sched_t sched = {0u};
+	uchar_t buf[sizeof("pid #ID sched set 3 65535 65535 65535 65535")]={'\0'};
 
 	(void)Parse_PidID(cmd_,&p,&pidID);
 	UTIL1_strcpy(buf,sizeof(PID_SHORT_STRING),cmd_);
@@ -437,13 +664,62 @@ uint8_t PID_ParseCommand(const uchar_t *cmd_, bool *handled_, const CLS1_StdIOTy
 			if( pidID < pPidTbl->numPids )
 			{
 				Restore_PidGainCfg(pPidTbl->aPids[pidID].cfg.nvm.readDfltFct, pPidTbl->aPids[pidID].cfg.nvm.saveFct, &pPidTbl->aPids[pidID].cfg.gain, io_);
+				(void)PID_Upd_QGain(pidID);
+			}
+			else if (PID_ID_DUMP == pidID)
+			{
+				CLS_SEND_ERR_ID_NOT_SPECIFIED;
+			}
+			else
+			{
+				CLS_SEND_ERR_ID_NOT_FOUND;
+			}
+		}
+		else if (ERR_OK == UTIL1_strcmp((char*)buf, (char*)"pid sched restore") )
+		{
+			*handled_ = TRUE;
+			if( pidID < pPidTbl->numPids )
+			{
+				Restore_PidSchedCfg(pPidTbl->aPids[pidID].cfg.nvm.readDfltSchedFct, pPidTbl->aPids[pidID].cfg.nvm.saveSchedFct, pidID, io_);
+			}
+			else if (PID_ID_DUMP == pidID)
+			{
+				CLS_SEND_ERR_ID_NOT_SPECIFIED;
+			}
+			else
+			{
+				CLS_SEND_ERR_ID_NOT_FOUND;
+			}
+		}
+		else if (UTIL1_strncmp((char*)buf, (char*)"pid sched", sizeof("pid sched")-1)==0)
+		{
+			if( pidID < pPidTbl->numPids )
+			{
+				sched = pPidTbl->aPids[pidID].cfg.sched;
+				if( ERR_OK == Parse_PidSchedArgs( &sched, buf+sizeof("pid sched")-1u, handled_, io_) )
+				{
+					if( ERR_OK == PID_Set_Sched(pidID, &sched) )
+					{
+						CLS1_SendStr((uchar_t*)">>> Setting new gain schedule successful...\r\n", io_->stdOut);
+						if( ERR_OK != Save_PidSchedCfg(pPidTbl->aPids[pidID].cfg.nvm.saveSchedFct, &sched, io_) )
+						{
+							/* error handling */
+						}
+					}
+					else
+					{
+						CLS1_SendStr((uchar_t*)"*** ERROR: Values of the points must be strictly ascending ***\r\n", io_->stdErr);
+					}
+				}
 			}
 			else if (PID_ID_DUMP == pidID)
 			{
+				*handled_ = TRUE;
 				CLS_SEND_ERR_ID_NOT_SPECIFIED;
 			}
 			else
 			{
+				*handled_ = TRUE;
 				CLS_SEND_ERR_ID_NOT_FOUND;
 			}
 		}
@@ -453,6 +729,11 @@ uint8_t PID_ParseCommand(const uchar_t *cmd_, bool *handled_, const CLS1_StdIOTy
 			for(pidID = 0u; pidID < pPidTbl->numPids; pidID++ )
 			{
 				Restore_PidGainCfg(pPidTbl->aPids[pidID].cfg.nvm.readDfltFct, pPidTbl->aPids[pidID].cfg.nvm.saveFct, &pPidTbl->aPids[pidID].cfg.gain, io_);
+				(void)PID_Upd_QGain(pidID);
+				if( NULL != pPidTbl->aPids[pidID].cfg.nvm.saveSchedFct )
+				{
+					Restore_PidSchedCfg(pPidTbl->aPids[pidID].cfg.nvm.readDfltSchedFct, pPidTbl->aPids[pidID].cfg.nvm.saveSchedFct, pidID, io_);
+				}
 			}
 		}
 		else if (UTIL1_strncmp((char*)buf, (char*)"pid set", sizeof("pid set")-1)==0)
@@ -461,6 +742,7 @@ uint8_t PID_ParseCommand(const uchar_t *cmd_, bool *handled_, const CLS1_StdIOTy
 			{
 				if( ERR_OK == Parse_PidGainArgs( &pPidTbl->aPids[pidID].cfg.gain, buf+sizeof("pid set")-1u, handled_, io_) )
 				{
+					(void)PID_Upd_QGain(pidID);
 					CLS1_SendStr((uchar_t*)">>> Setting new parameters successful...\r\n", io_->stdOut);
 					if( ERR_OK != Save_PidGainCfg(pPidTbl->aPids[pidID].cfg.nvm.saveFct, &pPidTbl->aPids[pidID].cfg.gain, io_) )
 					{
@@ -0,0 +1,260 @@
+/***********************************************************************************************//**
+ * @file		pose.c
+ * @ingroup		pose
+ * @brief 		Implementation of a pose estimator for the differential drive
+ *
+ * This module fuses the increments of both wheels into the pose (x, y, heading) of the Sumo
+ * robot by dead reckoning. The heading is kept as binary angle, i.e. a full turn corresponds to
+ * 2^32, so that it wraps around without any extra handling. The translation of each sample is
+ * applied in the direction of the mean heading of the sample interval using a sine lookup table
+ * with linear interpolation. All calculations are done in fixed-point arithmetic.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	16.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#define MASTER_pose_C_
+
+/*======================================= >> #INCLUDES << ========================================*/
+#include "pose.h"
+#include "pose_api.h"
+#include "tacho_api.h"
+#include "CS1.h"
+
+
+
+/*======================================= >> #DEFINES << =========================================*/
+/**
+ * @brief Heading change in binary angle per step of difference between right and left wheel.
+ * It results from 2^32 * (pi * wheel diameter / steps per rev) / (2 * pi * axis length), pi cancels.
+ */
+#define POSE_HDG_PER_STEP		((int32_t)( (((uint64_t)1u << 31) * CAU_SUMO_WHEEL_DIAMETER) / \
+										((uint64_t)CAU_SUMO_AXIS_LENGTH * CAU_SUMO_STEPS_PER_REV_AT_WHEEL) ))
+
+/**
+ * @brief Travelled distance per step in [mm] as Q0.32
+ */
+#define POSE_MM_PER_STEP_Q32	((int64_t)( (PI * CAU_SUMO_WHEEL_DIAMETER * 4294967296.0) / CAU_SUMO_STEPS_PER_REV_AT_WHEEL ))
+
+/**
+ * @brief Number of interpolation intervals of the sine lookup table per quarter turn
+ */
+#define POSE_LUT_SEG_BITS		(7u)
+#define POSE_LUT_SEG_CNT		(1u << POSE_LUT_SEG_BITS)
+
+/**
+ * @brief Binary angle of a quarter turn
+ */
+#define POSE_QUARTER_TURN		(0x40000000u)
+
+
+
+/*=================================== >> TYPE DEFINITIONS << =====================================*/
+typedef struct POSE_Data_s
+{
+	int64_t x;					/**< x-coordinate in steps as Q47.16 */
+	int64_t y;					/**< y-coordinate in steps as Q47.16 */
+	uint32_t hdg;				/**< heading as binary angle */
+	int32_t prevPos[TACHO_ID_CNT];	/**< wheel positions of the previous call */
+	bool rstReq;				/**< request to reset the origin */
+}POSE_Data_t;
+
+
+
+/*============================= >> LOKAL FUNCTION DECLARATIONS << ================================*/
+static int32_t POSE_SinQ15(uint32_t ang_);
+static int32_t POSE_StepsToMm(int64_t steps_);
+static void POSE_Reset(void);
+
+
+
+/*=================================== >> GLOBAL VARIABLES << =====================================*/
+/**
+ * @brief Quarter wave of sin() in Q1.15 at POSE_LUT_SEG_CNT+1 equidistant points
+ */
+static const int16_t POSE_SinLut[POSE_LUT_SEG_CNT + 1u] =
+{
+		    0,   402,   804,  1206,  1608,  2009,  2410,  2811,
+		 3212,  3612,  4011,  4410,  4808,  5205,  5602,  5998,
+		 6393,  6786,  7179,  7571,  7962,  8351,  8739,  9126,
+		 9512,  9896, 10278, 10659, 11039, 11417, 11793, 12167,
+		12539, 12910, 13279, 13645, 14010, 14372, 14732, 15090,
+		15446, 15800, 16151, 16499, 16846, 17189, 17530, 17869,
+		18204, 18537, 18868, 19195, 19519, 19841, 20159, 20475,
+		20787, 21096, 21403, 21705, 22005, 22301, 22594, 22884,
+		23170, 23452, 23731, 24007, 24279, 24547, 24811, 25072,
+		25329, 25582, 25832, 26077, 26319, 26556, 26790, 27019,
+		27245, 27466, 27683, 27896, 28105, 28310, 28510, 28706,
+		28898, 29085, 29268, 29447, 29621, 29791, 29956, 30117,
+		30273, 30424, 30571, 30714, 30852, 30985, 31113, 31237,
+		31356, 31470, 31580, 31685, 31785, 31880, 31971, 32057,
+		32137, 32213, 32285, 32351, 32412, 32469, 32521, 32567,
+		32609, 32646, 32678, 32705, 32728, 32745, 32757, 32765,
+		32767,
+};
+
+static POSE_Data_t data = {0};
+
+
+
+/*============================== >> LOKAL FUNCTION DEFINITIONS << ================================*/
+/**
+ * @brief Calculates sin() of a binary angle using the quarter wave lookup table
+ * @param ang_ binary angle, 2^32 corresponds to a full turn
+ * @return sin(ang_) in Q1.15
+ */
+static int32_t POSE_SinQ15(uint32_t ang_)
+{
+	uint32_t qrtAng = ang_ & (POSE_QUARTER_TURN - 1u);
+	uint32_t idx = 0u, frac = 0u;
+	int32_t val = 0;
+
+	if( 0u != (ang_ & POSE_QUARTER_TURN) )
+	{
+		qrtAng = POSE_QUARTER_TURN - qrtAng; /* second and fourth quadrant are mirrored */
+	}
+	idx  = qrtAng >> (30u - POSE_LUT_SEG_BITS);
+	frac = (qrtAng >> (14u - POSE_LUT_SEG_BITS)) & 0xFFFFu;
+	val  = POSE_SinLut[idx];
+	if( idx < POSE_LUT_SEG_CNT )
+	{
+		val += (int32_t)( ((POSE_SinLut[idx + 1u] - POSE_SinLut[idx]) * (int32_t)frac) >> 16 );
+	}
+	if( 0u != (ang_ & (2u*POSE_QUARTER_TURN)) )
+	{
+		val = -val; /* third and fourth quadrant are negative */
+	}
+	return val;
+}
+
+/**
+ * @brief Converts a coordinate in steps as Q47.16 to [mm] with rounding
+ */
+static int32_t POSE_StepsToMm(int64_t steps_)
+{
+	return (int32_t)( ((steps_ >> 8) * POSE_MM_PER_STEP_Q32 + ((int64_t)1 << 39)) >> 40 );
+}
+
+static void POSE_Reset(void)
+{
+	data.x   = 0;
+	data.y   = 0;
+	data.hdg = 0u;
+	(void)TACHO_Read_PosLe(&data.prevPos[TACHO_ID_LEFT]);
+	(void)TACHO_Read_PosRi(&data.prevPos[TACHO_ID_RIGHT]);
+	data.rstReq = FALSE;
+}
+
+
+
+/*============================= >> GLOBAL FUNCTION DEFINITIONS << ================================*/
+void POSE_Init(const void *pvPar_)
+{
+	(void)pvPar_;
+	POSE_Reset();
+}
+
+void POSE_MainFct(void)
+{
+	int32_t curPos[TACHO_ID_CNT] = {0};
+	int32_t dLe = 0, dRi = 0, dSum = 0;
+	uint32_t hdgMid = 0u;
+	int32_t dHdg = 0;
+	CS1_CriticalVariable();
+
+	if( TRUE == data.rstReq )
+	{
+		CS1_EnterCritical();
+		POSE_Reset();
+		CS1_ExitCritical();
+	}
+	else
+	{
+		(void)TACHO_Read_PosLe(&curPos[TACHO_ID_LEFT]);
+		(void)TACHO_Read_PosRi(&curPos[TACHO_ID_RIGHT]);
+		dLe  = curPos[TACHO_ID_LEFT]  - data.prevPos[TACHO_ID_LEFT];
+		dRi  = curPos[TACHO_ID_RIGHT] - data.prevPos[TACHO_ID_RIGHT];
+		data.prevPos[TACHO_ID_LEFT]  = curPos[TACHO_ID_LEFT];
+		data.prevPos[TACHO_ID_RIGHT] = curPos[TACHO_ID_RIGHT];
+
+		/* dSum is twice the travelled distance of the center, hence dSum * sin() in Q1.15 is Q16 */
+		dSum   = dLe + dRi;
+		dHdg   = (dRi - dLe) * POSE_HDG_PER_STEP;
+		hdgMid = data.hdg + (uint32_t)(dHdg / 2);
+
+		CS1_EnterCritical();
+		data.x  += (int64_t)dSum * POSE_SinQ15(hdgMid + POSE_QUARTER_TURN);
+		data.y  += (int64_t)dSum * POSE_SinQ15(hdgMid);
+		data.hdg += (uint32_t)dHdg;
+		CS1_ExitCritical();
+	}
+}
+
+void POSE_Deinit(void)
+{
+	data.rstReq = FALSE;
+}
+
+StdRtn_t POSE_Read_PosX(int32_t *pX_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+	int64_t x = 0;
+	CS1_CriticalVariable();
+
+	if( NULL != pX_ )
+	{
+		CS1_EnterCritical();
+		x = data.x;
+		CS1_ExitCritical();
+		*pX_   = POSE_StepsToMm(x);
+		retVal = ERR_OK;
+	}
+	return retVal;
+}
+
+StdRtn_t POSE_Read_PosY(int32_t *pY_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+	int64_t y = 0;
+	CS1_CriticalVariable();
+
+	if( NULL != pY_ )
+	{
+		CS1_EnterCritical();
+		y = data.y;
+		CS1_ExitCritical();
+		*pY_   = POSE_StepsToMm(y);
+		retVal = ERR_OK;
+	}
+	return retVal;
+}
+
+StdRtn_t POSE_Read_Hdg(int16_t *pHdg_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+	int32_t hdg = 0;
+
+	if( NULL != pHdg_ )
+	{
+		/* signed binary angle scaled and rounded to [-POSE_HDG_HALF_TURN, POSE_HDG_HALF_TURN) */
+		hdg = (int32_t)( ((int64_t)(int32_t)data.hdg * (2*POSE_HDG_HALF_TURN) + ((int64_t)1 << 31)) >> 32 );
+		*pHdg_ = (int16_t)( (POSE_HDG_HALF_TURN <= hdg) ? -POSE_HDG_HALF_TURN : hdg );
+		retVal = ERR_OK;
+	}
+	return retVal;
+}
+
+StdRtn_t POSE_Set_RstReq(void)
+{
+	data.rstReq = TRUE;
+	return ERR_OK;
+}
+
+
+
+#ifdef MASTER_pose_C_
+#undef MASTER_pose_C_
+#endif /* !MASTER_pose_C_ */
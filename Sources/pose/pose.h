@@ -0,0 +1,71 @@
+/***********************************************************************************************//**
+ * @file		pose.h
+ * @ingroup		pose
+ * @brief 		Interface of the SWC @a Pose for initialisation- and runtime-calls.
+ *
+ * This header file provides the internal interface between the SWC @ref pose and the
+ * SWC @ref task which runs the initialisation and periodic main function within a FreeRTOS task.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	16.04.2018
+ *
+ * @note Interface for BSW-specific use only
+ *
+ * @copyright 	@LGPL2_1
+ *
+ **************************************************************************************************/
+
+#ifndef POSE_H_
+#define POSE_H_
+
+/*======================================= >> #INCLUDES << ========================================*/
+#include "Platform.h"
+
+
+#ifdef MASTER_pose_C_
+#define EXTERNAL_
+#else
+#define EXTERNAL_ extern
+#endif
+
+/**
+ * @addtogroup pose
+ * @{
+ */
+/*======================================= >> #DEFINES << =========================================*/
+/**
+ * String identification of the SWC @ref pose
+ */
+#define POSE_SWC_STRING ("pose")
+
+
+
+/*=================================== >> TYPE DEFINITIONS << =====================================*/
+
+
+
+/*============================ >> GLOBAL FUNCTION DECLARATIONS << ================================*/
+/**
+ * @brief Initialization of the module, the current location becomes the origin
+ */
+EXTERNAL_ void POSE_Init(const void *pvPar_);
+
+/**
+ * @brief Main function of the module, integrates the wheel increments since the last call
+ */
+EXTERNAL_ void POSE_MainFct(void);
+
+/**
+ * @brief De-initialization of the module
+ */
+EXTERNAL_ void POSE_Deinit(void);
+
+
+/**
+ * @}
+ */
+#ifdef EXTERNAL_
+#undef EXTERNAL_
+#endif
+
+#endif /* !POSE_H_ */
@@ -0,0 +1,90 @@
+/***********************************************************************************************//**
+ * @file		pose_api.h
+ * @ingroup		pose
+ * @brief 		API for the SWC @a Pose
+ *
+ * This API provides a BSW-internal interface of the SWC @ref pose. It is supposed to be
+ * available to all other Basic Software Components.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	16.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ ***************************************************************************************************/
+
+#ifndef POSE_API_H_
+#define POSE_API_H_
+
+/*======================================= >> #INCLUDES << ========================================*/
+#include "Platform.h"
+#include "ACon_Types.h"
+
+
+
+#ifdef MASTER_pose_C_
+#define EXTERNAL_
+#else
+#define EXTERNAL_ extern
+#endif
+
+/**
+ * @addtogroup pose
+ * @{
+ */
+/*======================================= >> #DEFINES << =========================================*/
+/**
+ * @brief Heading resolution, a full turn equals 2*POSE_HDG_HALF_TURN
+ */
+#define POSE_HDG_HALF_TURN (1800)
+
+
+
+/*=================================== >> TYPE DEFINITIONS << =====================================*/
+
+
+
+/*============================ >> GLOBAL FUNCTION DECLARATIONS << ================================*/
+/**
+ * @brief Returns the x-coordinate of the robot relative to the origin in [mm]. The x-axis points
+ * into the heading direction at the time of the last reset.
+ * @param pX_ Pointer to the x-coordinate
+ * @return Error code,  ERR_OK if everything was fine,
+ *                      ERR_PARAM_ADDRESS otherwise
+ */
+EXTERNAL_ StdRtn_t POSE_Read_PosX(int32_t *pX_);
+
+/**
+ * @brief Returns the y-coordinate of the robot relative to the origin in [mm]. The y-axis points
+ * to the left of the heading direction at the time of the last reset.
+ * @param pY_ Pointer to the y-coordinate
+ * @return Error code,  ERR_OK if everything was fine,
+ *                      ERR_PARAM_ADDRESS otherwise
+ */
+EXTERNAL_ StdRtn_t POSE_Read_PosY(int32_t *pY_);
+
+/**
+ * @brief Returns the heading of the robot rounded to [0.1 deg], counter-clockwise positive, within
+ * [-POSE_HDG_HALF_TURN, POSE_HDG_HALF_TURN)
+ * @param pHdg_ Pointer to the heading
+ * @return Error code,  ERR_OK if everything was fine,
+ *                      ERR_PARAM_ADDRESS otherwise
+ */
+EXTERNAL_ StdRtn_t POSE_Read_Hdg(int16_t *pHdg_);
+
+/**
+ * @brief Requests to make the current location and heading the new origin. The request is
+ * processed by the next call of the main function.
+ * @return Error code, always ERR_OK
+ */
+EXTERNAL_ StdRtn_t POSE_Set_RstReq(void);
+
+
+/**
+ * @}
+ */
+#ifdef EXTERNAL_
+#undef EXTERNAL_
+#endif
+
+#endif /* !POSE_API_H_ */
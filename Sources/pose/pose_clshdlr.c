@@ -0,0 +1,111 @@
+/***********************************************************************************************//**
+ * @file		pose_clshdlr.c
+ * @ingroup		pose
+ * @brief 		Implementation of the command line shell handler for the SWC @a Pose
+ *
+ * This module implements the interface of the SWC @ref pose which is addressed to
+ * the SWC @ref sh. It introduces application specific commands for requests
+ * of status information via command line shell (@b CLS).
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	16.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#define MASTER_pose_clshdlr_C_
+
+/*======================================= >> #INCLUDES << ========================================*/
+#include "pose_clshdlr.h"
+#include "pose_api.h"
+#include "pose.h"
+#include "UTIL1.h"
+
+/*======================================= >> #DEFINES << =========================================*/
+
+
+
+/*=================================== >> TYPE DEFINITIONS << =====================================*/
+
+
+
+/*============================= >> LOKAL FUNCTION DECLARATIONS << ================================*/
+static void Print_PoseStatus(const CLS1_StdIOType *io_);
+static void Print_PoseHelp(const CLS1_StdIOType *io_);
+
+
+/*=================================== >> GLOBAL VARIABLES << =====================================*/
+
+
+
+/*============================== >> LOKAL FUNCTION DEFINITIONS << ================================*/
+/*!
+ * \brief Prints the current pose
+ * \param io_ I/O channel to use for printing status
+ */
+static void Print_PoseStatus(const CLS1_StdIOType *io_)
+{
+	int32_t posTmp = 0;
+	int16_t hdgTmp = 0;
+
+	CLS1_SendStatusStr((uchar_t*)POSE_SWC_STRING, (uchar_t*)"\r\n", io_->stdOut);
+
+	CLS1_SendStatusStr((uchar_t*)"  x", (uchar_t*)"", io_->stdOut);
+	(void)POSE_Read_PosX(&posTmp);
+	CLS1_SendNum32s(posTmp, io_->stdOut);
+	CLS1_SendStr((uchar_t*)" mm\r\n", io_->stdOut);
+
+	CLS1_SendStatusStr((uchar_t*)"  y", (uchar_t*)"", io_->stdOut);
+	(void)POSE_Read_PosY(&posTmp);
+	CLS1_SendNum32s(posTmp, io_->stdOut);
+	CLS1_SendStr((uchar_t*)" mm\r\n", io_->stdOut);
+
+	CLS1_SendStatusStr((uchar_t*)"  heading", (uchar_t*)"", io_->stdOut);
+	(void)POSE_Read_Hdg(&hdgTmp);
+	CLS1_SendNum16s(hdgTmp, io_->stdOut);
+	CLS1_SendStr((uchar_t*)" 0.1 deg\r\n", io_->stdOut);
+}
+
+/*!
+ * \brief Prints the help text to the console
+ * \param io_ I/O channel to be used
+ */
+static void Print_PoseHelp(const CLS1_StdIOType *io_)
+{
+	CLS1_SendHelpStr((uchar_t*)POSE_SWC_STRING, (uchar_t*)"Group of pose commands\r\n", io_->stdOut);
+	CLS1_SendHelpStr((uchar_t*)"  help|status", (uchar_t*)"Shows pose help or status\r\n", io_->stdOut);
+	CLS1_SendHelpStr((uchar_t*)"  reset", (uchar_t*)"Makes the current pose the origin\r\n", io_->stdOut);
+}
+
+
+/*============================= >> GLOBAL FUNCTION DEFINITIONS << ================================*/
+uint8_t POSE_ParseCommand(const uchar_t *cmd, bool *handled, const CLS1_StdIOType *io_)
+{
+	if (UTIL1_strcmp((char*)cmd, (char*)CLS1_CMD_HELP)==0 || UTIL1_strcmp((char*)cmd, (char*)"pose help")==0)
+	{
+		Print_PoseHelp(io_);
+		*handled = TRUE;
+	}
+	else if (UTIL1_strcmp((char*)cmd, (char*)CLS1_CMD_STATUS)==0 || UTIL1_strcmp((char*)cmd, (char*)"pose status")==0)
+	{
+		Print_PoseStatus(io_);
+		*handled = TRUE;
+	}
+	else if (UTIL1_strcmp((char*)cmd, (char*)"pose reset")==0)
+	{
+		(void)POSE_Set_RstReq();
+		*handled = TRUE;
+	}
+	else
+	{
+		/* error handling */
+	}
+	return ERR_OK;
+}
+
+
+
+#ifdef MASTER_pose_clshdlr_C_
+#undef MASTER_pose_clshdlr_C_
+#endif /* !MASTER_pose_clshdlr_C_ */
@@ -26,6 +26,7 @@
 #include "rnet_api.h"
 #include "sh_api.h"
 #include "tacho_api.h"
+#include "pose_api.h"
 #include "nvm_api.h"
 #include "KEY1.h"
 #include "CS1.h"
@@ -372,6 +373,41 @@ StdRtn_t RTE_Write_DrvMode(DrvMode_t mode_)
 	return retVal;
 }
 
+StdRtn_t RTE_Write_DrvScr(const DrvSeg_t *aSeg_, uint8_t numSeg_)
+{
+	return DRV_Start_Scr(aSeg_, numSeg_, FRTOS1_xTaskGetCurrentTaskHandle());
+}
+
+StdRtn_t RTE_Write_DrvVelUni(int32_t lin_, int32_t ang_)
+{
+	return DRV_SetVel(lin_, ang_);
+}
+
+StdRtn_t RTE_Write_DrvMoveRel(int32_t dist_, int32_t hdg_)
+{
+	return DRV_MoveRel(dist_, hdg_, FRTOS1_xTaskGetCurrentTaskHandle());
+}
+
+StdRtn_t RTE_Write_DrvStop(int32_t timeoutMs_)
+{
+	return DRV_Stop_Async(timeoutMs_, FRTOS1_xTaskGetCurrentTaskHandle());
+}
+
+StdRtn_t RTE_Write_DrvEvtNotf(uint32_t evtMsk_)
+{
+	return DRV_Reg_EvtNotf(FRTOS1_xTaskGetCurrentTaskHandle(), evtMsk_);
+}
+
+StdRtn_t RTE_Read_DrvNotf(uint32_t evtMsk_, uint32_t *pEvt_)
+{
+	return DRV_Wait_Notf(evtMsk_, pEvt_, 0);
+}
+
+StdRtn_t RTE_Wait_DrvNotf(uint32_t evtMsk_, uint32_t *pEvt_, int32_t timeoutMs_)
+{
+	return DRV_Wait_Notf(evtMsk_, pEvt_, timeoutMs_);
+}
+
 StdRtn_t RTE_Read_DrvMode(DrvMode_t *mode_)
 {
 	StdRtn_t retVal = ERR_PARAM_ADDRESS;
@@ -416,6 +452,52 @@ StdRtn_t RTE_Read_DrvHasRvsd(uint8_t *hasRvsd_)
 	return retVal;
 }
 
+StdRtn_t RTE_Read_DrvTracLe(DrvTrac_t *trac_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+	DRV_Trac_t tracRi = DRV_TRAC_OK;
+	if(NULL != trac_)
+	{
+		retVal = DRV_Read_Trac(trac_, &tracRi);
+	}
+	return retVal;
+}
+
+StdRtn_t RTE_Read_DrvTracRi(DrvTrac_t *trac_)
+{
+	StdRtn_t retVal = ERR_PARAM_ADDRESS;
+	DRV_Trac_t tracLe = DRV_TRAC_OK;
+	if(NULL != trac_)
+	{
+		retVal = DRV_Read_Trac(&tracLe, trac_);
+	}
+	return retVal;
+}
+
+/*================================================================================================*/
+/*
+ * Interface implementation for the pose estimator
+ */
+StdRtn_t RTE_Read_PosePosX(int32_t *x_)
+{
+	return POSE_Read_PosX(x_);
+}
+
+StdRtn_t RTE_Read_PosePosY(int32_t *y_)
+{
+	return POSE_Read_PosY(y_);
+}
+
+StdRtn_t RTE_Read_PoseHdg(int16_t *hdg_)
+{
+	return POSE_Read_Hdg(hdg_);
+}
+
+StdRtn_t RTE_Write_PoseRst(void)
+{
+	return POSE_Set_RstReq();
+}
+
 /*================================================================================================*/
 /*
  * Interface implementation for the radio application layer
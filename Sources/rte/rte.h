@@ -281,6 +281,85 @@ EXTERNAL_ StdRtn_t RTE_Write_DrvPos(int32_t posLe_, int32_t posRi_);
  */
 EXTERNAL_ StdRtn_t RTE_Write_DrvMode(DrvMode_t mode_);
 
+/**
+ * @brief RTE interface to hand a motion script over to the drive, which executes its segments
+ * back-to-back. The calling task is notified by DRV_SCR_DONE_NOTIFICATION_VALUE when the script
+ * has completed and by DRV_SCR_ABORT_NOTIFICATION_VALUE when it has been aborted by another
+ * drive command, which it receives by @ref RTE_Read_DrvNotf or @ref RTE_Wait_DrvNotf.
+ * @param  aSeg_   array of the segments
+ * @param  numSeg_ number of segments
+ * @return Error code, ERR_OK if everything was fine,
+ *                     ERR_PARAM_ADDRESS for an invalid address,
+ *                     ERR_PARAM_VALUE for an invalid number of segments or segment
+ */
+EXTERNAL_ StdRtn_t RTE_Write_DrvScr(const DrvSeg_t *aSeg_, uint8_t numSeg_);
+
+/**
+ * @brief RTE interface to write the linear and angular velocity of the robot in speed mode. Both
+ * wheels are slowed down by the same factor if one of them exceeds its limit.
+ * @param  lin_ desired linear velocity in mm/sec
+ * @param  ang_ desired angular velocity in 0.1 degrees/sec, counter-clockwise if positive
+ * @return Error code, ERR_OK if everything was fine,
+ *                     ERR_FAILED otherwise
+ */
+EXTERNAL_ StdRtn_t RTE_Write_DrvVelUni(int32_t lin_, int32_t ang_);
+
+/**
+ * @brief RTE interface to move the robot relative to its current pose. It turns on the spot first
+ * and then drives straight. The calling task is notified by DRV_SCR_DONE_NOTIFICATION_VALUE when
+ * the robot has settled and by DRV_SCR_ABORT_NOTIFICATION_VALUE when the move has been aborted by
+ * another drive command, which it receives by @ref RTE_Read_DrvNotf or @ref RTE_Wait_DrvNotf.
+ * @param  dist_ distance in mm, backwards if negative
+ * @param  hdg_  change of heading in 0.1 degrees, counter-clockwise if positive
+ * @return Error code, ERR_OK if everything was fine
+ */
+EXTERNAL_ StdRtn_t RTE_Write_DrvMoveRel(int32_t dist_, int32_t hdg_);
+
+/**
+ * @brief RTE interface to stop the drive without waiting. The calling task is notified by
+ * DRV_STOP_DONE_NOTIFICATION_VALUE when the robot is at standstill and by
+ * DRV_STOP_TIMEOUT_NOTIFICATION_VALUE after the timeout, which it receives by
+ * @ref RTE_Read_DrvNotf or @ref RTE_Wait_DrvNotf.
+ * @param  timeoutMs_ timeout in ms
+ * @return Error code, ERR_OK if everything was fine,
+ *                     ERR_OVERFLOW if too many tasks are registered for notifications
+ */
+EXTERNAL_ StdRtn_t RTE_Write_DrvStop(int32_t timeoutMs_);
+
+/**
+ * @brief RTE interface to register the calling task for notifications of drive events. It is
+ * notified by DRV_MOVE_DONE_NOTIFICATION_VALUE when the robot has stopped and by
+ * DRV_TURNED_NOTIFICATION_VALUE when it has reached its target position in position mode, which
+ * it receives by @ref RTE_Read_DrvNotf or @ref RTE_Wait_DrvNotf.
+ * @param  evtMsk_ mask of the notification values, 0 unregisters the task
+ * @return Error code, ERR_OK if everything was fine,
+ *                     ERR_OVERFLOW if too many tasks are registered for notifications
+ */
+EXTERNAL_ StdRtn_t RTE_Write_DrvEvtNotf(uint32_t evtMsk_);
+
+/**
+ * @brief RTE interface to read and clear the drive notifications of the calling task without
+ * waiting, the notifications of the keys stay with the application task
+ * @param  evtMsk_ mask of the drive notification values
+ * @param  pEvt_   notification values of evtMsk_, which were set
+ * @return Error code, ERR_OK if a notification was set,
+ *                     ERR_BUSY if none was set,
+ *                     ERR_PARAM_ADDRESS otherwise
+ */
+EXTERNAL_ StdRtn_t RTE_Read_DrvNotf(uint32_t evtMsk_, uint32_t *pEvt_);
+
+/**
+ * @brief RTE interface to wait for one of the drive notifications of the calling task and to clear
+ * them, the notifications of the keys stay with the application task
+ * @param  evtMsk_    mask of the drive notification values
+ * @param  pEvt_      notification values of evtMsk_, which were set
+ * @param  timeoutMs_ timeout in ms
+ * @return Error code, ERR_OK if a notification was set,
+ *                     ERR_BUSY for timeout condition,
+ *                     ERR_PARAM_ADDRESS otherwise
+ */
+EXTERNAL_ StdRtn_t RTE_Wait_DrvNotf(uint32_t evtMsk_, uint32_t *pEvt_, int32_t timeoutMs_);
+
 /**
  * @brief RTE interface to read the current driving control mode
  * @param  *mode_ pointer to the current driving control mode (RTE_DrvMode_t)
@@ -321,6 +400,67 @@ EXTERNAL_ StdRtn_t RTE_Read_DrvHasStpd(uint8_t *hasStpd_);
  */
 EXTERNAL_ StdRtn_t RTE_Read_DrvHasRvsd(uint8_t *hasRvsd_);
 
+/**
+ * @brief RTE interface to read the traction state of the left wheel
+ *
+ * @param  *trac_ pointer to the traction state
+ *                        DRV_TRAC_OK    - the wheel grips,
+ *                        DRV_TRAC_SLIP  - the wheel spins without load,
+ *                        DRV_TRAC_STALL - the wheel is blocked
+ * @return Error code, ERR_OK if everything was fine,
+ *                     ERR_PARAM_ADDRESS otherwise
+ */
+EXTERNAL_ StdRtn_t RTE_Read_DrvTracLe(DrvTrac_t *trac_);
+
+/**
+ * @brief RTE interface to read the traction state of the right wheel
+ *
+ * @param  *trac_ pointer to the traction state
+ *                        DRV_TRAC_OK    - the wheel grips,
+ *                        DRV_TRAC_SLIP  - the wheel spins without load,
+ *                        DRV_TRAC_STALL - the wheel is blocked
+ * @return Error code, ERR_OK if everything was fine,
+ *                     ERR_PARAM_ADDRESS otherwise
+ */
+EXTERNAL_ StdRtn_t RTE_Read_DrvTracRi(DrvTrac_t *trac_);
+
+
+/*================================================================================================*/
+
+
+/**
+ * @brief RTE interface to read the x-coordinate of the Sumo relative to the origin. The x-axis
+ * points into the heading direction at the time of the last reset.
+ * @param  *x_ pointer to the x-coordinate in mm (call by reference)
+ * @return Error code, ERR_OK if everything was fine,
+ *                     ERR_PARAM_ADDRESS otherwise
+ */
+EXTERNAL_ StdRtn_t RTE_Read_PosePosX(int32_t *x_);
+
+/**
+ * @brief RTE interface to read the y-coordinate of the Sumo relative to the origin. The y-axis
+ * points to the left of the heading direction at the time of the last reset.
+ * @param  *y_ pointer to the y-coordinate in mm (call by reference)
+ * @return Error code, ERR_OK if everything was fine,
+ *                     ERR_PARAM_ADDRESS otherwise
+ */
+EXTERNAL_ StdRtn_t RTE_Read_PosePosY(int32_t *y_);
+
+/**
+ * @brief RTE interface to read the heading of the Sumo relative to the heading at the time
+ * of the last reset
+ * @param  *hdg_ pointer to the heading in 0.1 deg, counter-clockwise positive, within [-1800, 1800)
+ * @return Error code, ERR_OK if everything was fine,
+ *                     ERR_PARAM_ADDRESS otherwise
+ */
+EXTERNAL_ StdRtn_t RTE_Read_PoseHdg(int16_t *hdg_);
+
+/**
+ * @brief RTE interface to make the current location and heading of the Sumo the origin
+ * @return Error code, always ERR_OK
+ */
+EXTERNAL_ StdRtn_t RTE_Write_PoseRst(void);
+
 
 /*================================================================================================*/
 
@@ -60,6 +60,8 @@
 #define MAX_ID_OF_SUMOS        (NUM_OF_SUMOS-(1))
 
 #define DRV_MODE_T DrvMode_t
+#define DRV_SEG_T DrvSeg_t
+#define DRV_TRAC_T DrvTrac_t
 
 
 
@@ -133,6 +135,47 @@ typedef enum DrvMode_e {
   DRV_MODE_INVALID,
 } DrvMode_t;
 
+/**
+ * @brief Non-customizeable data type for the kinds of segments of a motion script
+ */
+typedef enum DrvSegType_e {
+  DRV_SEG_POS = 0,		/**< moves the wheels by the given steps in position mode */
+  DRV_SEG_TURN,			/**< turns on the spot by the given angle in 0.1 degrees, counter-clockwise if positive */
+  DRV_SEG_SPEED,		/**< drives with the given speeds in steps/sec in speed mode */
+  DRV_SEG_WAIT,			/**< stands still in position mode */
+  DRV_SEG_TYPE_INVALID,
+} DrvSegType_t;
+
+/**
+ * @brief Non-customizeable data type for the completion conditions of the segments of a motion script
+ */
+typedef enum DrvSegDone_e {
+  DRV_SEG_DONE_TIME = 0,	/**< the duration has elapsed */
+  DRV_SEG_DONE_PROF,		/**< the motion profiles have reached the target, the loops settle during the next segment */
+  DRV_SEG_DONE_SETTLED,		/**< the position loops have settled */
+  DRV_SEG_DONE_INVALID,
+} DrvSegDone_t;
+
+/**
+ * @brief Non-customizeable data type for a segment of a motion script
+ */
+typedef struct DrvSeg_s {
+  DrvSegType_t type;		/**< kind of the segment */
+  DrvSegDone_t done;		/**< completion condition, speed and wait segments complete after their duration */
+  int32_t valLe;			/**< steps or steps/sec of the left wheel, angle in 0.1 degrees of a turn */
+  int32_t valRi;			/**< steps or steps/sec of the right wheel, unused by a turn */
+  uint16_t timeMs;			/**< duration, a position or turn segment aborts the script after it unless 0 */
+} DrvSeg_t;
+
+/**
+ * @brief Non-customizeable data type for the traction state of a wheel
+ */
+typedef enum DrvTrac_e {
+  DRV_TRAC_OK = 0,		/**< the wheel follows the motor model */
+  DRV_TRAC_SLIP,		/**< the wheel spins, it accelerates faster than the motor value explains */
+  DRV_TRAC_STALL,		/**< the wheel is blocked despite a high motor value */
+} DrvTrac_t;
+
 /**
  * @brief
  */
@@ -28,6 +28,8 @@
 #include "tl_clshdlr.h"
 #include "mot_clshdlr.h"
 #include "tacho_clshdlr.h"
+#include "pose_clshdlr.h"
+#include "atun_clshdlr.h"
 #include "drv_clshdlr.h"
 #include "batt_clshdlr.h"
 #include "buz_clshdlr.h"
@@ -39,6 +41,7 @@
 #include "LED2.h"
 #include "Q4CLeft.h"
 #include "Q4CRight.h"
+#include "tacho_cfg.h"
 #include "KIN1.h"
 #include "FRTOS1.h"
 /* include Bluetooth PEx component if FreeMaster is not present */
@@ -70,10 +73,14 @@ static const CLS1_ParseCommandCallback CmdParserTable[] =
   MOT_ParseCommand,
   DRV_ParseCommand,
   TACHO_ParseCommand,
+  POSE_ParseCommand,
+  ATUN_ParseCommand,
   PID_ParseCommand,
   TL_ParseCommand,
+#if !TACHO_USES_FTM_QD
   Q4CLeft_ParseCommand,
   Q4CRight_ParseCommand,
+#endif
   BUZ_ParseCommand,
   LED1_ParseCommand,
   LED2_ParseCommand,
@@ -8,7 +8,8 @@
  * direction of movement. Furthermore, it provides access to filter components defined in the
  * tacho_cfg.c file to smooth the velocity signal. By default, it uses a moving average filter
  * to calulate the velocity. It samples the current position using component @a Q4C for
- * both, left- and right-hand side. Sampling rate is defined by TACHO_SAMPLING_PERIOD_MS.
+ * both, left- and right-hand side, or the quadrature decoders of tacho_qd.c if
+ * @ref TACHO_USES_FTM_QD is set. Sampling rate is defined by TACHO_SAMPLING_PERIOD_MS.
  *
  * @author 	(c) 2014 Erich Styger, erich.styger@hslu.ch, Hochschule Luzern
  * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
@@ -26,6 +27,7 @@
 #include "tacho.h"
 #include "tacho_cfg.h"
 #include "tacho_api.h"
+#include "tacho_qd.h"
 #include "Q4CLeft.h"
 #include "Q4CRight.h"
 #include "CS1.h"
@@ -147,8 +149,8 @@ void TACHO_Sample(void) {
 	data.prevPos[TACHO_ID_LEFT]  = data.curPos[TACHO_ID_LEFT];
 	data.prevPos[TACHO_ID_RIGHT] = data.curPos[TACHO_ID_RIGHT];
 
-	data.curPos[TACHO_ID_LEFT]  = (int32_t)Q4CLeft_GetPos();
-	data.curPos[TACHO_ID_RIGHT] = (int32_t)Q4CRight_GetPos();
+	data.curPos[TACHO_ID_LEFT]  = TACHO_Get_CntPosLe();
+	data.curPos[TACHO_ID_RIGHT] = TACHO_Get_CntPosRi();
 
 	if( ( NULL != data.pActFltr) && ( NULL != data.pActFltr->sampleCbFct) )
 	{
@@ -173,6 +175,9 @@ void TACHO_Init(const void *pvPar_)
 {
 	TACHO_FltrItmTbl_t *pFltrTbl = NULL;
 
+#if TACHO_USES_FTM_QD
+	TACHO_QD_Init();
+#endif
 	pFltrTbl = Get_pFltrTbl();
 
 	if( (NULL != pFltrTbl) && (NULL != pFltrTbl->aFltrs ) &&  (TACHO_MAX_NUM_OF_FILTERS >= pFltrTbl->numFltrs) )
@@ -251,6 +256,35 @@ StdRtn_t TACHO_Read_PosRi(int32_t* pos_)
 	return retVal;
 }
 
+int32_t TACHO_Get_CntPosLe(void)
+{
+#if TACHO_USES_FTM_QD
+	return TACHO_QD_Get_Pos(TACHO_ID_LEFT);
+#else
+	return (int32_t)Q4CLeft_GetPos();
+#endif
+}
+
+int32_t TACHO_Get_CntPosRi(void)
+{
+#if TACHO_USES_FTM_QD
+	return TACHO_QD_Get_Pos(TACHO_ID_RIGHT);
+#else
+	return (int32_t)Q4CRight_GetPos();
+#endif
+}
+
+void TACHO_Set_CntPos(int32_t left_, int32_t right_)
+{
+#if TACHO_USES_FTM_QD
+	TACHO_QD_Set_Pos(TACHO_ID_LEFT, left_);
+	TACHO_QD_Set_Pos(TACHO_ID_RIGHT, right_);
+#else
+	Q4CLeft_SetPos(left_);
+	Q4CRight_SetPos(right_);
+#endif
+}
+
 StdRtn_t TACHO_Read_RawSpdLe(int16_t* spd_)
 {
 	StdRtn_t retVal = ERR_PARAM_ADDRESS;
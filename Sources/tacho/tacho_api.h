@@ -77,6 +77,27 @@ EXTERNAL_ StdRtn_t TACHO_Read_PosLe(int32_t* pos_);
  */
 EXTERNAL_ StdRtn_t TACHO_Read_PosRi(int32_t* pos_);
 
+/**
+ * @brief Returns the current position of the counter of the left track in [steps]. In contrast to
+ * TACHO_Read_PosLe(), the position isn't the one of the last speed sample.
+ * @return position of the counter
+ */
+EXTERNAL_ int32_t TACHO_Get_CntPosLe(void);
+
+/**
+ * @brief Returns the current position of the counter of the right track in [steps]. In contrast to
+ * TACHO_Read_PosRi(), the position isn't the one of the last speed sample.
+ * @return position of the counter
+ */
+EXTERNAL_ int32_t TACHO_Get_CntPosRi(void);
+
+/**
+ * @brief Sets the positions of the counters of both tracks
+ * @param left_ position of the left track in [steps]
+ * @param right_ position of the right track in [steps]
+ */
+EXTERNAL_ void TACHO_Set_CntPos(int32_t left_, int32_t right_);
+
 /**
  * @brief Returns the unfiltered speed of the left track in [steps/second].
  * @param spd_ Pointer to the speed variable
@@ -31,6 +31,14 @@
 /*======================================= >> #DEFINES << =========================================*/
 #define TACHO_MAX_NUM_OF_FILTERS (0xFA)
 
+/**
+ * Counts the encoder steps with the quadrature decoders of the FlexTimers instead of the software
+ * counters @a Q4CLeft and @a Q4CRight, see tacho_qd.c
+ */
+#ifndef TACHO_USES_FTM_QD
+#define TACHO_USES_FTM_QD (FALSE)
+#endif
+
 
 /*=================================== >> TYPE DEFINITIONS << =====================================*/
 
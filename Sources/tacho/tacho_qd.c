@@ -0,0 +1,173 @@
+/***********************************************************************************************//**
+ * @file		tacho_qd.c
+ * @ingroup		tacho
+ * @brief 		Implementation of the quadrature decoder backend of the SWC @ref tacho
+ *
+ * This module counts the encoder steps of both wheels with the quadrature decoder mode of the
+ * FlexTimers FTM1 (left) and FTM2 (right) instead of sampling the phases in the interrupt of the
+ * timer @a QuadInt. FTM0 runs the PWM of the motors and FTM3 the counter @a RefCnt of the
+ * reflectance sensors, see ProcessorExpert.pe. The decoders count each edge of both phases, just
+ * like the software counters, and have a digital filter on the phase inputs.\n
+ * The counters of the FlexTimers are 16 bit wide and run freely between 0 and 0xFFFF. Each read
+ * of a position adds the change of the counter since the last read, taken modulo 2^16 as signed
+ * 16 bit value, to a 32 bit position. This extension is correct as long as the counter doesn't
+ * change by more than 32767 steps between two reads, independent of how often it has overflowed.
+ * It doesn't need the overflow interrupt, hence the counter can be read from any context.\n
+ * The module accesses the FlexTimers by the @a FTM_PDD macros only, so it runs against the register
+ * model of the FlexTimer in tests/host/tacho as well.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#define MASTER_tacho_qd_C_
+
+/*======================================= >> #INCLUDES << ========================================*/
+#include "tacho_qd.h"
+#include "tacho_cfg.h"
+#include "CS1.h"
+#if TACHO_USES_FTM_QD
+#include "IO_Map.h"
+#include "FTM_PDD.h"
+#include "PORT_PDD.h"
+#endif
+
+
+
+#if TACHO_USES_FTM_QD
+/*======================================= >> #DEFINES << =========================================*/
+/**
+ * Modulo of the counters, they use the full 16 bit range
+ */
+#define TACHO_QD_CNT_MOD		(0xFFFFu)
+
+
+
+/*=================================== >> TYPE DEFINITIONS << =====================================*/
+typedef struct TACHO_QD_Whl_s
+{
+	FTM_MemMapPtr pFtm;		/* FlexTimer in quadrature decoder mode */
+	uint16_t prevCnt;		/* counter at the last read */
+	int32_t pos;			/* position extended to 32 bit */
+} TACHO_QD_Whl_t;
+
+
+
+/*============================= >> LOKAL FUNCTION DECLARATIONS << ================================*/
+static void TACHO_QD_Init_Ftm(FTM_MemMapPtr pFtm_, bool isInv_);
+static void TACHO_QD_Upd_Pos(TACHO_QD_Whl_t *pWhl_);
+
+
+
+/*=================================== >> GLOBAL VARIABLES << =====================================*/
+static TACHO_QD_Whl_t TACHO_QDWhl[TACHO_ID_CNT] = {{FTM1_BASE_PTR, 0u, 0}, {FTM2_BASE_PTR, 0u, 0}};
+static bool TACHO_QDIsInit = FALSE;
+
+
+
+/*============================== >> LOKAL FUNCTION DEFINITIONS << ================================*/
+/**
+ * @brief Configures a FlexTimer as quadrature decoder of phase A and B with a free running counter
+ */
+static void TACHO_QD_Init_Ftm(FTM_MemMapPtr pFtm_, bool isInv_)
+{
+	uint32_t qdCtrl = FTM_QDCTRL_QUADEN_MASK | FTM_QDCTRL_PHAFLTREN_MASK | FTM_QDCTRL_PHBFLTREN_MASK;
+
+	FTM_PDD_WriteStatusControlReg(pFtm_, 0u); /* stop the counter */
+	FTM_PDD_WriteFeaturesModeReg(pFtm_, FTM_MODE_WPDIS_MASK | FTM_MODE_FTMEN_MASK);
+	FTM_PDD_WriteModuloReg(pFtm_, TACHO_QD_CNT_MOD);
+	FTM_PDD_WriteInitialValueReg(pFtm_, 0u);
+	FTM_PDD_WriteFilterReg(pFtm_, FTM_FILTER_CH0FVAL(TACHO_QD_FLTR_VAL) | FTM_FILTER_CH1FVAL(TACHO_QD_FLTR_VAL));
+	if( TRUE == isInv_ )
+	{
+		qdCtrl |= FTM_QDCTRL_PHBPOL_MASK;
+	}
+	FTM_PDD_WriteQuadratureDecoderReg(pFtm_, qdCtrl);
+	FTM_PDD_InitializeCounter(pFtm_);
+	/* the phases clock the counter, the bus clock only runs the filters */
+	FTM_PDD_WriteStatusControlReg(pFtm_, FTM_SC_CLKS(1u) | FTM_SC_PS(0u));
+}
+
+/**
+ * @brief Extends the counter of a wheel to its 32 bit position, has to be called in a critical
+ * section
+ */
+static void TACHO_QD_Upd_Pos(TACHO_QD_Whl_t *pWhl_)
+{
+	uint16_t cnt = (uint16_t)FTM_PDD_ReadCounterReg(pWhl_->pFtm);
+
+	pWhl_->pos    += (int32_t)(int16_t)(uint16_t)( cnt - pWhl_->prevCnt );
+	pWhl_->prevCnt = cnt;
+}
+
+
+
+/*============================= >> GLOBAL FUNCTION DEFINITIONS << ================================*/
+void TACHO_QD_Init(void)
+{
+	uint8_t i = 0u;
+	CS1_CriticalVariable();
+
+	SIM_SCGC5 |= SIM_SCGC5_PORTA_MASK | SIM_SCGC5_PORTB_MASK;
+	SIM_SCGC6 |= SIM_SCGC6_FTM1_MASK | SIM_SCGC6_FTM2_MASK;
+	PORT_PDD_SetPinMuxControl(TACHO_QD_LE_PORT, TACHO_QD_LE_PIN_A, TACHO_QD_LE_MUX);
+	PORT_PDD_SetPinMuxControl(TACHO_QD_LE_PORT, TACHO_QD_LE_PIN_B, TACHO_QD_LE_MUX);
+	PORT_PDD_SetPinMuxControl(TACHO_QD_RI_PORT, TACHO_QD_RI_PIN_A, TACHO_QD_RI_MUX);
+	PORT_PDD_SetPinMuxControl(TACHO_QD_RI_PORT, TACHO_QD_RI_PIN_B, TACHO_QD_RI_MUX);
+
+	TACHO_QD_Init_Ftm(TACHO_QDWhl[TACHO_ID_LEFT].pFtm, TACHO_QD_LE_INV);
+	TACHO_QD_Init_Ftm(TACHO_QDWhl[TACHO_ID_RIGHT].pFtm, TACHO_QD_RI_INV);
+
+	CS1_EnterCritical();
+	for(i = 0u; i < TACHO_ID_CNT; i++)
+	{
+		TACHO_QDWhl[i].prevCnt = (uint16_t)FTM_PDD_ReadCounterReg(TACHO_QDWhl[i].pFtm);
+		TACHO_QDWhl[i].pos     = 0;
+	}
+	TACHO_QDIsInit = TRUE;
+	CS1_ExitCritical();
+}
+
+int32_t TACHO_QD_Get_Pos(TACHO_ID_t id_)
+{
+	int32_t pos = 0;
+	CS1_CriticalVariable();
+
+	if( ( 0 <= id_ ) && ( TACHO_ID_CNT > id_ ) )
+	{
+		CS1_EnterCritical();
+		if( TRUE == TACHO_QDIsInit )
+		{
+			TACHO_QD_Upd_Pos(&TACHO_QDWhl[id_]);
+		}
+		pos = TACHO_QDWhl[id_].pos;
+		CS1_ExitCritical();
+	}
+	return pos;
+}
+
+void TACHO_QD_Set_Pos(TACHO_ID_t id_, int32_t pos_)
+{
+	CS1_CriticalVariable();
+
+	if( ( 0 <= id_ ) && ( TACHO_ID_CNT > id_ ) )
+	{
+		CS1_EnterCritical();
+		if( TRUE == TACHO_QDIsInit )
+		{
+			TACHO_QDWhl[id_].prevCnt = (uint16_t)FTM_PDD_ReadCounterReg(TACHO_QDWhl[id_].pFtm);
+		}
+		TACHO_QDWhl[id_].pos = pos_;
+		CS1_ExitCritical();
+	}
+}
+#endif /* !TACHO_USES_FTM_QD */
+
+
+
+#ifdef MASTER_tacho_qd_C_
+#undef MASTER_tacho_qd_C_
+#endif /* !MASTER_tacho_qd_C_ */
@@ -0,0 +1,104 @@
+/***********************************************************************************************//**
+ * @file		tacho_qd.h
+ * @ingroup		tacho
+ * @brief 		Interface of the quadrature decoder backend of the SWC @ref tacho
+ *
+ * This header file provides the internal interface of the hardware quadrature decoders, which
+ * count the encoder steps of both wheels instead of the software counters @a Q4CLeft and
+ * @a Q4CRight if @ref TACHO_USES_FTM_QD is set.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @note Interface for BSW-specific use only
+ *
+ * @copyright 	@LGPL2_1
+ *
+ **************************************************************************************************/
+
+#ifndef TACHO_QD_H_
+#define TACHO_QD_H_
+
+/*======================================= >> #INCLUDES << ========================================*/
+#include "Platform.h"
+#include "ACon_Types.h"
+#include "tacho_api.h"
+
+
+#ifdef MASTER_tacho_qd_C_
+#define EXTERNAL_
+#else
+#define EXTERNAL_ extern
+#endif
+
+/**
+ * @addtogroup tacho
+ * @{
+ */
+/*======================================= >> #DEFINES << =========================================*/
+/**
+ * Phase A and B of the left encoder, FTM1_QD_PHA and FTM1_QD_PHB on PTA12 and PTA13 (ALT7)
+ */
+#define TACHO_QD_LE_PORT		(PORTA_BASE_PTR)
+#define TACHO_QD_LE_PIN_A		(12u)
+#define TACHO_QD_LE_PIN_B		(13u)
+#define TACHO_QD_LE_MUX			(PORT_PDD_MUX_CONTROL_ALT7)
+
+/**
+ * Phase A and B of the right encoder, FTM2_QD_PHA and FTM2_QD_PHB on PTB18 and PTB19 (ALT6)
+ */
+#define TACHO_QD_RI_PORT		(PORTB_BASE_PTR)
+#define TACHO_QD_RI_PIN_A		(18u)
+#define TACHO_QD_RI_PIN_B		(19u)
+#define TACHO_QD_RI_MUX			(PORT_PDD_MUX_CONTROL_ALT6)
+
+/**
+ * Inverts the counting direction of an encoder, has to be set so a forward turn of the wheel
+ * counts up like the software counters do
+ */
+#define TACHO_QD_LE_INV			(FALSE)
+#define TACHO_QD_RI_INV			(FALSE)
+
+/**
+ * Digital filter of the phase inputs, the phases have to be stable for 4*TACHO_QD_FLTR_VAL cycles
+ * of the bus clock, 0...15
+ */
+#define TACHO_QD_FLTR_VAL		(4u)
+
+
+
+/*=================================== >> TYPE DEFINITIONS << =====================================*/
+
+
+
+/*============================ >> GLOBAL FUNCTION DECLARATIONS << ================================*/
+/**
+ * @brief Routes the encoder phases to the quadrature decoders and starts counting at position 0
+ */
+EXTERNAL_ void TACHO_QD_Init(void);
+
+/**
+ * @brief Returns the position of a wheel. The 16 bit counter of the quadrature decoder is extended
+ * to 32 bit on each call, hence the position has to be read at least once per 32767 steps, which
+ * the sampling of the speed in @ref TACHO_Sample() does.
+ * @param id_ wheel, TACHO_ID_LEFT or TACHO_ID_RIGHT
+ * @return position in [steps], 0 before TACHO_QD_Init() or for an invalid wheel
+ */
+EXTERNAL_ int32_t TACHO_QD_Get_Pos(TACHO_ID_t id_);
+
+/**
+ * @brief Sets the position of a wheel
+ * @param id_ wheel, TACHO_ID_LEFT or TACHO_ID_RIGHT
+ * @param pos_ position in [steps]
+ */
+EXTERNAL_ void TACHO_QD_Set_Pos(TACHO_ID_t id_, int32_t pos_);
+
+
+/**
+ * @}
+ */
+#ifdef EXTERNAL_
+#undef EXTERNAL_
+#endif
+
+#endif /* !TACHO_QD_H_ */
@@ -19,11 +19,15 @@
 /*======================================= >> #INCLUDES << ========================================*/
 #include "task_cfg.h"
 #include "tacho.h"
+#include "pose.h"
+#include "atun.h"
 #include "appl.h"
 #include "sh.h"
 #include "rnet.h"
 #include "drv.h"
 #include "refl.h"
+#include "batt.h"
+#include "mot.h"
 
 
 /*======================================= >> #DEFINES << =========================================*/
@@ -64,6 +68,8 @@
  */
 static const TASK_SwcCfg_t applTaskSwcCfg[] = {
 		{APPL_SWC_STRING, APPL_MainFct, APPL_Init},
+		{BATT_SWC_STRING, BATT_MainFct, NULL},
+		{MOT_SWC_STRING, MOT_MainFct, NULL},
 };
 
 /*
@@ -87,6 +93,8 @@ static const TASK_SwcCfg_t dbgTaskSwcCfg[] = {
 static const TASK_SwcCfg_t drvTaskSwcCfg[] = {
 		{DRV_SWC_STRING, DRV_MainFct, DRV_Init},
 		{TACHO_SWC_STRING, TACHO_Main, TACHO_Init},
+		{POSE_SWC_STRING, POSE_MainFct, POSE_Init},
+		{ATUN_SWC_STRING, ATUN_MainFct, ATUN_Init},
 };
 
 /*
@@ -0,0 +1,275 @@
+/***********************************************************************************************//**
+ * @file		test_atun.c
+ * @ingroup		test
+ * @brief 		Host simulation of the relay experiment of the SWC @a atun
+ *
+ * Runs the relay experiment against a first order motor model with dead time, sampled like the
+ * DRIVE task, and compares the ultimate gain and period found by the experiment with the analytic
+ * ultimate point of the model. Checks the gains of the tuning rules, the timeout if the motor
+ * doesn't oscillate, the abort and that saving writes the gains to the PID items and the NVM.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#include <string.h>
+#include "host_test.h"
+#include "Platform.h"
+#include "atun.h"
+#include "pid.h"
+#include "atun_api.h"
+#include "atun_cfg.h"
+#include "pid_cfg.h"
+#include "pid_api.h"
+#include "mot_api.h"
+#include "nvm_api.h"
+
+#define TS			(ATUN_SMPL_TIME_MS / 1000.0)
+#define MOT_TAU		(0.080)				/* mechanical time constant [s] */
+#define MOT_DEAD	(3)					/* dead time of PWM, tacho and filter [samples] */
+#define MOT_GAIN	(8000.0 / 0xFFFF)	/* speed at full duty cycle [steps/s] per duty cycle */
+#define MOT_MAX		(0xFFFF)
+#define N_RUN_MAX	(2u * 10000u / ATUN_SMPL_TIME_MS)
+
+/* motor model, the speed follows the duty cycle written MOT_DEAD samples ago */
+static struct
+{
+	double spd;
+	double noiseSd;
+	double gain;
+	int32_t aDuty[MOT_DEAD];
+	uint8_t idx;
+} Mot;
+
+static int DrvModeCalls = 0;
+static int SaveCalls = 0;
+static NVM_PidCfg_t SavedCfg;
+
+
+/*=========================================== motor model ========================================*/
+static double Gauss(void)
+{
+	double u1 = HT_Uniform(1e-12, 1.0), u2 = HT_Uniform(0.0, 1.0);
+	return sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+static void Mot_Reset(double gain_, double noiseSd_)
+{
+	memset(&Mot, 0, sizeof(Mot));
+	Mot.gain    = gain_;
+	Mot.noiseSd = noiseSd_;
+}
+
+/* advances the motor by one sample with the exact discretization of the first order lag */
+static void Mot_Step(void)
+{
+	double a = exp(-TS / MOT_TAU);
+	Mot.spd = a * Mot.spd + (1.0 - a) * Mot.gain * Mot.aDuty[Mot.idx];
+}
+
+static StdRtn_t Mot_Read(int32_t *pVal_)
+{
+	*pVal_ = (int32_t)lround(Mot.spd + ( (Mot.noiseSd > 0.0) ? Mot.noiseSd * Gauss() : 0.0 ));
+	return ERR_OK;
+}
+
+static void Mot_Write(int32_t ctrlVal_)
+{
+	ctrlVal_ = (ctrlVal_ > MOT_MAX) ? MOT_MAX : ( (ctrlVal_ < -MOT_MAX) ? -MOT_MAX : ctrlVal_ );
+	Mot.aDuty[Mot.idx] = ctrlVal_;
+	Mot.idx = (Mot.idx + 1u) % MOT_DEAD;
+}
+
+/* ultimate point of the sampled loop: the duty cycle written at sample k drives the motor from
+ * sample k+d-1 to k+d, i.e. G(z) = K(1-a) z^-d / (1 - a z^-1), phase -pi at theta = w*Ts */
+static void Mot_UltimatePt(double *pKu_, double *pTuMs_)
+{
+	double a = exp(-TS / MOT_TAU), lo = 1e-6, hi = M_PI, th = 0.0, ph = 0.0;
+	int i;
+
+	for(i = 0; i < 100; i++)
+	{
+		th = 0.5 * (lo + hi);
+		ph = -MOT_DEAD * th - atan2(a * sin(th), 1.0 - a * cos(th));
+		if(ph > -M_PI) { lo = th; } else { hi = th; }
+	}
+	*pKu_   = hypot(1.0 - a * cos(th), a * sin(th)) / (MOT_GAIN * (1.0 - a));
+	*pTuMs_ = 2.0 * M_PI / th * ATUN_SMPL_TIME_MS;
+}
+
+
+/*============================================= stubs ============================================*/
+StdRtn_t DRV_SetMode(DRV_Mode_t mode_)
+{
+	DrvModeCalls += (DRV_MODE_NONE == mode_);
+	return ERR_OK;
+}
+
+MOT_MotorDevice_t *MOT_GetMotorHandle(MOT_MotorSide_t side_) { (void)side_; return NULL; }
+void MOT_Reset_LimCnt(MOT_MotorDevice_t *pMot_) { (void)pMot_; }
+
+static StdRtn_t Save(const NVM_PidCfg_t *pCfg_)
+{
+	SaveCalls++;
+	SavedCfg = *pCfg_;
+	return ERR_OK;
+}
+
+/* the speed item of atun_cfg.c with the hysteresis of the default and a small one */
+static const ATUN_Itm_t Items[] =
+{
+	{"spd", DRV_MODE_NONE, PID_ID_SPD_LE, 1u, FALSE, 1000, 0x2000, 0x1000, 20, 1, Mot_Read, Mot_Write, Save},
+	{"spd", DRV_MODE_NONE, PID_ID_SPD_LE, 2u, FALSE, 1000, 0x2000, 0x1000,  1, 1, Mot_Read, Mot_Write, Save},
+};
+static const ATUN_ItmTbl_t ItemTable = {Items, sizeof(Items)/sizeof(Items[0]), 0u, 1u, NULL, 0u};
+
+const ATUN_ItmTbl_t *Get_pAtunItmTbl(void) {return &ItemTable;}
+
+#define ITM(form_) {{"", {2000u, 80u, 0u, 100u, 0xFFFFu}, {NULL, NULL, NULL, NULL, NULL, NULL}, form_, PID_SCHED_NONE, PID_DSRC_MEAS, 2u, {0}, {{{0}}}}, {0}}
+static PID_Itm_t PidItems[] = {ITM(PID_FORM_VEL), ITM(PID_FORM_VEL), ITM(PID_FORM_POS), ITM(PID_FORM_POS), ITM(PID_FORM_POS)};
+static PID_ItmTbl_t PidItemTable = {PidItems, sizeof(PidItems)/sizeof(PidItems[0])};
+
+PID_ItmTbl_t *Get_pPidItmTbl(void) {return &PidItemTable;}
+
+
+/*============================================ helpers ===========================================*/
+/* runs the experiment of item itmIdx_ like the DRIVE task, returns the final state */
+static ATUN_State_t Run(uint8_t itmIdx_, ATUN_Rule_t rule_, uint32_t abortSmpl_, uint32_t *pSmplCnt_)
+{
+	ATUN_State_t state = ATUN_STATE_RUN;
+	uint32_t k;
+
+	HT_CHECK(ERR_OK == ATUN_Set_StartReq(itmIdx_, rule_), "experiment not started");
+	HT_CHECK(ERR_BUSY == ATUN_Set_StartReq(itmIdx_, rule_), "second request accepted");
+	for(k = 0u; (k < N_RUN_MAX) && ( (0u == k) || (ATUN_STATE_RUN == state) ); k++)
+	{
+		if(k == abortSmpl_)
+		{
+			ATUN_Set_AbortReq();
+		}
+		Mot_Step();
+		ATUN_MainFct();
+		ATUN_Read_State(&state);
+	}
+	*pSmplCnt_ = k;
+	return state;
+}
+
+
+/*============================================= tests ============================================*/
+/* The experiment takes the peak of the speed for the amplitude of its fundamental. Behind the lag
+ * of the motor the speed is closer to a triangle than to a sine, whose peak exceeds the fundamental
+ * by up to pi^2/8, hence Ku is expected about 20 % low. The hysteresis delays the switching and
+ * lengthens the period. */
+static void Test_Relay(void)
+{
+	static const struct {uint8_t itm; double noiseSd; double kuLo; double kuHi; double tuTolMs; const char *name;} cases[] =
+	{
+		{1u,  0.0, -0.25, 0.05, 1.0 * ATUN_SMPL_TIME_MS, "hysteresis  1, no noise "},
+		{0u,  0.0, -0.40, 0.05, 3.0 * ATUN_SMPL_TIME_MS, "hysteresis 20, no noise "},
+		{0u,  8.0, -0.40, 0.05, 3.0 * ATUN_SMPL_TIME_MS, "hysteresis 20, noise  8 "},
+	};
+	ATUN_Rslt_t rslt;
+	double ku, tuMs, kuErr;
+	uint32_t n;
+	unsigned int c;
+
+	Mot_UltimatePt(&ku, &tuMs);
+	printf("analytic ultimate point: Ku %.2f, Tu %.1f ms\n", ku, tuMs);
+	for(c = 0u; c < sizeof(cases)/sizeof(cases[0]); c++)
+	{
+		Mot_Reset(MOT_GAIN, cases[c].noiseSd);
+		HT_CHECK(ATUN_STATE_DONE == Run(cases[c].itm, ATUN_RULE_ZN_PID, N_RUN_MAX, &n), "%s: experiment failed", cases[c].name);
+		HT_CHECK(ERR_OK == ATUN_Read_Rslt(&rslt), "%s: no result", cases[c].name);
+		kuErr = rslt.kuQ8 / 256.0 / ku - 1.0;
+		printf("%s: Ku %.2f (%+5.1f %%), Tu %u ms (%+4.0f ms) after %u samples\n", cases[c].name,
+				rslt.kuQ8 / 256.0, 100.0 * kuErr, rslt.tuMs, rslt.tuMs - tuMs, n);
+		HT_CHECK( (kuErr > cases[c].kuLo) && (kuErr < cases[c].kuHi), "%s: Ku %.2f instead of %.2f", cases[c].name, rslt.kuQ8 / 256.0, ku);
+		HT_CHECK(fabs(rslt.tuMs - tuMs) <= cases[c].tuTolMs, "%s: Tu %u ms instead of %.1f ms", cases[c].name, rslt.tuMs, tuMs);
+		HT_CHECK(0 == Mot.aDuty[(Mot.idx + MOT_DEAD - 1u) % MOT_DEAD], "%s: motor not stopped", cases[c].name);
+	}
+}
+
+static void Test_Rules(void)
+{
+	static const double coef[ATUN_RULE_CNT][3] =
+	{
+		{0.6, 0.5, 0.125}, {0.45, 0.833, 0.0}, {0.455, 2.2, 0.159}, {0.313, 2.2, 0.0}, {0.2, 0.5, 0.333},
+	};
+	ATUN_Rslt_t rslt;
+	double ku, tu, kP, kI, kD, sc;
+	uint32_t n;
+	int r;
+
+	for(r = 0; r < ATUN_RULE_CNT; r++)
+	{
+		Mot_Reset(MOT_GAIN, 0.0);
+		Run(1u, (ATUN_Rule_t)r, N_RUN_MAX, &n);
+		HT_CHECK(ERR_OK == ATUN_Read_Rslt(&rslt), "rule %d: no result", r);
+		HT_CHECK(r == (int)rslt.rule, "rule %d: result of rule %d", r, rslt.rule);
+		/* gains per sample from the measured ultimate point */
+		ku = rslt.kuQ8 / 256.0;
+		tu = (double)rslt.tuMs / ATUN_SMPL_TIME_MS;
+		kP = coef[r][0] * ku;
+		kI = kP / (coef[r][1] * tu);
+		kD = kP * coef[r][2] * tu;
+		sc = rslt.nScale;
+		printf("rule %d: kP %6.3f kI %6.4f kD %6.3f, scaled %5u/%5u/%5u by %u\n", r, kP, kI, kD,
+				rslt.kP_scld, rslt.kI_scld, rslt.kD_scld, rslt.nScale);
+		/* tuMs is truncated to full ms, tu is rounded by that */
+		HT_CHECK(fabs(rslt.kP_scld - kP * sc) <= 0.5 + 1e-3 * kP * sc, "rule %d: kP %u/%u instead of %f", r, rslt.kP_scld, rslt.nScale, kP);
+		HT_CHECK(fabs(rslt.kI_scld - kI * sc) <= 0.5 + 0.02 * kI * sc, "rule %d: kI %u/%u instead of %f", r, rslt.kI_scld, rslt.nScale, kI);
+		HT_CHECK(fabs(rslt.kD_scld - kD * sc) <= 0.5 + 0.02 * kD * sc, "rule %d: kD %u/%u instead of %f", r, rslt.kD_scld, rslt.nScale, kD);
+	}
+}
+
+static void Test_FailAbortSave(void)
+{
+	ATUN_Rslt_t rslt;
+	PID_Gain_t gain;
+	uint32_t n;
+
+	/* a motor which doesn't turn never crosses the setpoint */
+	Mot_Reset(0.0, 0.0);
+	HT_CHECK(ATUN_STATE_FAILED == Run(1u, ATUN_RULE_ZN_PID, N_RUN_MAX, &n), "experiment without oscillation not failed");
+	HT_CHECK(10000u / ATUN_SMPL_TIME_MS == n, "timeout after %u samples", n);
+	HT_CHECK(ERR_VALUE == ATUN_Read_Rslt(&rslt), "result of a failed experiment");
+	HT_CHECK(ERR_VALUE == ATUN_Save_Rslt(), "result of a failed experiment saved");
+
+	Mot_Reset(MOT_GAIN, 0.0);
+	HT_CHECK(ATUN_STATE_FAILED == Run(1u, ATUN_RULE_ZN_PID, 50u, &n), "aborted experiment not failed");
+	HT_CHECK(51u == n, "abort after %u samples", n);
+	HT_CHECK(0 == Mot.aDuty[(Mot.idx + MOT_DEAD - 1u) % MOT_DEAD], "motor not stopped by the abort");
+
+	Mot_Reset(MOT_GAIN, 0.0);
+	Run(1u, ATUN_RULE_TL_PI, N_RUN_MAX, &n);
+	ATUN_Read_Rslt(&rslt);
+	SaveCalls = 0;
+	HT_CHECK(ERR_OK == ATUN_Save_Rslt(), "result not saved");
+	HT_CHECK(1 == SaveCalls, "NVM written %d times", SaveCalls);
+	HT_CHECK( (rslt.kP_scld == SavedCfg.KP_scld) && (rslt.kI_scld == SavedCfg.KI_scld)
+			&& (rslt.kD_scld == SavedCfg.KD_scld) && (rslt.nScale == SavedCfg.Scale)
+			&& (0xFFFFu == SavedCfg.SaturationVal), "NVM config differs from the result");
+	/* item 1 shares its gains with the following PID item */
+	gain = PidItems[PID_ID_SPD_RI].cfg.gain;
+	HT_CHECK( (rslt.kP_scld == gain.kP_scld) && (rslt.kI_scld == gain.kI_scld) && (rslt.nScale == gain.nScale),
+			"gains not applied to the second PID item");
+	gain = PidItems[PID_ID_POS_LE].cfg.gain;
+	HT_CHECK( (2000u == gain.kP_scld) && (80u == gain.kI_scld), "gains applied to a third PID item");
+	HT_CHECK(DrvModeCalls > 0, "drive not switched off");
+}
+
+
+int main(void)
+{
+	HT_Seed(33u);
+	PID_Init();
+	ATUN_Init(NULL);
+	Test_Relay();
+	Test_Rules();
+	Test_FailAbortSave();
+	return HT_Result();
+}
@@ -0,0 +1,288 @@
+/***********************************************************************************************//**
+ * @file		test_atun_step.c
+ * @ingroup		test
+ * @brief 		Host simulation of the step experiment of the SWC @a atun
+ *
+ * Checks the step response analyzer sample by sample against a reference written in floating
+ * point, runs the step experiment with both speed loops closed around first order motor models
+ * and checks the reported rise time, overshoot, settling time and IAE against the reference
+ * analysis of the samples the experiment has read. Checks that the derivative part of the PID
+ * items doesn't kick on a step of the desired value and that its filter damps quantization noise.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#include <string.h>
+#include "host_test.h"
+#include "Platform.h"
+#include "atun.h"
+#include "atun_step.h"
+#include "pid.h"
+#include "atun_api.h"
+#include "atun_cfg.h"
+#include "pid_cfg.h"
+#include "pid_api.h"
+#include "mot_api.h"
+
+#define TS			(ATUN_SMPL_TIME_MS / 1000.0)
+#define MOT_GAIN	(8000.0 / 0xFFFF)	/* speed at full duty cycle [steps/s] per duty cycle */
+#define MOT_MAX		(0xFFFF)
+#define N_SMPL		(ATUN_STEP_DURATION_MS / ATUN_SMPL_TIME_MS)
+#define N_RAND		(20000)
+
+/* two motors with different mechanical time constants, the samples read by the experiment are
+ * recorded for the reference analysis */
+static struct
+{
+	double tau;
+	double spd;
+	int32_t duty;
+	int32_t aRec[N_SMPL + 1];
+	int recCnt;
+} Mot[ATUN_STEP_CH_CNT];
+
+
+/*=========================================== motor model ========================================*/
+static void Mot_Reset(double tauLe_, double tauRi_)
+{
+	memset(Mot, 0, sizeof(Mot));
+	Mot[0].tau = tauLe_;
+	Mot[1].tau = tauRi_;
+}
+
+static void Mot_Step(void)
+{
+	double a;
+	int ch;
+
+	for(ch = 0; ch < ATUN_STEP_CH_CNT; ch++)
+	{
+		a = exp(-TS / Mot[ch].tau);
+		Mot[ch].spd = a * Mot[ch].spd + (1.0 - a) * MOT_GAIN * Mot[ch].duty;
+	}
+}
+
+static StdRtn_t Mot_Read(int ch_, int32_t *pVal_)
+{
+	*pVal_ = (int32_t)lround(Mot[ch_].spd);
+	if(Mot[ch_].recCnt <= N_SMPL)
+	{
+		Mot[ch_].aRec[Mot[ch_].recCnt++] = *pVal_;
+	}
+	return ERR_OK;
+}
+
+static void Mot_Write(int ch_, int32_t ctrlVal_)
+{
+	Mot[ch_].duty = (ctrlVal_ > MOT_MAX) ? MOT_MAX : ( (ctrlVal_ < -MOT_MAX) ? -MOT_MAX : ctrlVal_ );
+}
+
+static StdRtn_t Mot_ReadLe(int32_t *pVal_) { return Mot_Read(0, pVal_); }
+static StdRtn_t Mot_ReadRi(int32_t *pVal_) { return Mot_Read(1, pVal_); }
+static void Mot_WriteLe(int32_t ctrlVal_) { Mot_Write(0, ctrlVal_); }
+static void Mot_WriteRi(int32_t ctrlVal_) { Mot_Write(1, ctrlVal_); }
+
+
+/*============================================= stubs ============================================*/
+StdRtn_t DRV_SetMode(DRV_Mode_t mode_) { (void)mode_; return ERR_OK; }
+MOT_MotorDevice_t *MOT_GetMotorHandle(MOT_MotorSide_t side_) { (void)side_; return NULL; }
+void MOT_Reset_LimCnt(MOT_MotorDevice_t *pMot_) { (void)pMot_; }
+
+static const ATUN_Itm_t Items[] =
+{
+	{"spd L", DRV_MODE_NONE, PID_ID_SPD_LE, 1u, FALSE, 1000, 0x2000, 0x1000, 20, 1, Mot_ReadLe, Mot_WriteLe, NULL},
+	{"spd R", DRV_MODE_NONE, PID_ID_SPD_RI, 1u, FALSE, 1000, 0x2000, 0x1000, 20, 1, Mot_ReadRi, Mot_WriteRi, NULL},
+};
+static const ATUN_ItmTbl_t ItemTable = {Items, sizeof(Items)/sizeof(Items[0]), 0u, 2u, NULL, 0u};
+
+const ATUN_ItmTbl_t *Get_pAtunItmTbl(void) {return &ItemTable;}
+
+/* the speed items of pid_cfg.c, followed by derivative-only items with both sources and filters */
+#define ITM(gain_, form_, dSrc_, nDFlt_) {{"", gain_, {NULL, NULL, NULL, NULL, NULL, NULL}, form_, PID_SCHED_NONE, dSrc_, nDFlt_, {0}, {{{0}}}}, {0}}
+#define SPD_GAIN	((PID_Gain_t){2000u, 80u,     0u, 100u, 0xFFFFu})
+#define D_GAIN		((PID_Gain_t){   0u,  0u, 10000u, 100u, 0xFFFFu})
+enum {PID_D_ERR = PID_ID_SPD_RI + 1, PID_D_MEAS, PID_D_MEAS_FLT};
+static PID_Itm_t PidItems[] =
+{
+	ITM(SPD_GAIN, PID_FORM_VEL, PID_DSRC_MEAS, 2u),
+	ITM(SPD_GAIN, PID_FORM_VEL, PID_DSRC_MEAS, 2u),
+	ITM(D_GAIN,   PID_FORM_POS, PID_DSRC_ERR,  0u),
+	ITM(D_GAIN,   PID_FORM_POS, PID_DSRC_MEAS, 0u),
+	ITM(D_GAIN,   PID_FORM_POS, PID_DSRC_MEAS, 2u),
+};
+static PID_ItmTbl_t PidItemTable = {PidItems, sizeof(PidItems)/sizeof(PidItems[0])};
+
+PID_ItmTbl_t *Get_pPidItmTbl(void) {return &PidItemTable;}
+
+
+/*============================================ reference =========================================*/
+/* analysis of the samples aVal_[0..n_-1], the first one taken one sample time after the step */
+static void Ref_Anl(int32_t initVal_, int32_t setVal_, const int32_t *aVal_, int n_, ATUN_StepRslt_t *pRslt_)
+{
+	double dir = (setVal_ < initVal_) ? -1.0 : 1.0, step = dir * ((double)setVal_ - initVal_);
+	double band = fmax(1.0, floor(step * ATUN_STEP_BAND_PML / 1000.0)), peak = 0.0, iae = 0.0, val;
+	int k, t10 = -1, t90 = -1, settled = 0;
+
+	for(k = 0; k < n_; k++)
+	{
+		val = dir * ((double)aVal_[k] - initVal_);
+		if( (t10 < 0) && (val >= 0.1 * step) ) { t10 = k; }
+		if( (t90 < 0) && (val >= 0.9 * step) ) { t90 = k; }
+		peak = fmax(peak, val);
+		iae += fabs(step - val);
+		if(fabs(step - val) > band) { settled = k + 1; }
+	}
+	pRslt_->initVal  = initVal_;
+	pRslt_->setVal   = setVal_;
+	pRslt_->riseMs   = (t90 < 0) ? ATUN_STEP_TIME_INVLD : (uint16_t)fmin((t90 - t10) * ATUN_SMPL_TIME_MS, ATUN_STEP_TIME_INVLD - 1.0);
+	pRslt_->ovrPml   = ( (peak > step) && (step > 0.0) ) ? (uint16_t)fmin(floor((peak - step) * 1000.0 / step), 0xFFFF) : 0u;
+	pRslt_->settleMs = (settled >= n_) ? ATUN_STEP_TIME_INVLD : (uint16_t)fmin((settled + 1) * ATUN_SMPL_TIME_MS, ATUN_STEP_TIME_INVLD - 1.0);
+	pRslt_->iae      = (uint32_t)fmin(iae * ATUN_SMPL_TIME_MS, 0xFFFFFFFFu);
+}
+
+static int Rslt_Eq(const ATUN_StepRslt_t *a_, const ATUN_StepRslt_t *b_)
+{
+	return (a_->initVal == b_->initVal) && (a_->setVal == b_->setVal) && (a_->riseMs == b_->riseMs)
+			&& (a_->ovrPml == b_->ovrPml) && (a_->settleMs == b_->settleMs) && (a_->iae == b_->iae);
+}
+
+static void Rslt_Print(const char *pName_, const ATUN_StepRslt_t *pRslt_)
+{
+	printf("%s %5d -> %5d: rise %5u ms, overshoot %4u pml, settling %5u ms, IAE %8u\n", pName_, pRslt_->initVal,
+			pRslt_->setVal, pRslt_->riseMs, pRslt_->ovrPml, pRslt_->settleMs, pRslt_->iae);
+}
+
+
+/*============================================= tests ============================================*/
+/* responses of damped second order systems of random height, direction, damping and noise */
+static void Test_Analyzer(void)
+{
+	static int32_t aVal[N_SMPL];
+	ATUN_StepAnl_t anl;
+	ATUN_StepRslt_t rslt, ref;
+	int32_t init, set;
+	double zeta, wn, wd, t, y, noise;
+	int i, k, n, bad = 0, ovr = 0, unsettled = 0;
+
+	for(i = 0; i < N_RAND; i++)
+	{
+		init  = (int32_t)HT_Uniform(-20000.0, 20000.0);
+		set   = (0 == i % 50) ? init : (int32_t)HT_Uniform(-20000.0, 20000.0);
+		zeta  = HT_Uniform(0.05, 1.5);
+		wn    = HT_Uniform(2.0, 60.0);
+		noise = (0 == i % 2) ? 0.0 : HT_Uniform(0.0, 50.0);
+		n     = 1 + (int)(HT_Rand() % N_SMPL);
+		for(k = 0; k < n; k++)
+		{
+			t  = (k + 1) * TS;
+			wd = wn * sqrt(fabs(1.0 - zeta * zeta));
+			y  = (zeta < 1.0) ? 1.0 - exp(-zeta * wn * t) * (cos(wd * t) + zeta * wn / wd * sin(wd * t))
+			                  : 1.0 - exp(-wn * t) * (1.0 + wn * t);
+			aVal[k] = (int32_t)lround(init + (set - init) * y + noise * HT_Uniform(-1.0, 1.0));
+		}
+		ATUN_StepAnl_Init(&anl, init, set);
+		for(k = 0; k < n; k++)
+		{
+			ATUN_StepAnl_Upd(&anl, aVal[k]);
+		}
+		ATUN_StepAnl_Get(&anl, ATUN_SMPL_TIME_MS, &rslt);
+		Ref_Anl(init, set, aVal, n, &ref);
+		if(!Rslt_Eq(&rslt, &ref))
+		{
+			if(0 == bad)
+			{
+				Rslt_Print("analyzer ", &rslt);
+				Rslt_Print("reference", &ref);
+			}
+			bad++;
+		}
+		ovr       += (0u != ref.ovrPml);
+		unsettled += (ATUN_STEP_TIME_INVLD == ref.settleMs);
+	}
+	printf("analyzer: %d random responses, %d with overshoot, %d not settled, %d differ from the reference\n",
+			N_RAND, ovr, unsettled, bad);
+	HT_CHECK(0 == bad, "analyzer differs from the reference in %d responses", bad);
+	HT_CHECK( (ovr > N_RAND / 10) && (unsettled > N_RAND / 10), "too few responses with overshoot or not settled");
+}
+
+static void Test_StepExp(void)
+{
+	static const int32_t setVals[] = {1000, 3000, -2000};
+	ATUN_StepRslt_t rslt, ref;
+	ATUN_State_t state = ATUN_STATE_RUN;
+	unsigned int s;
+	int k, ch;
+
+	for(s = 0u; s < sizeof(setVals)/sizeof(setVals[0]); s++)
+	{
+		Mot_Reset(0.08, 0.2);
+		HT_CHECK(ERR_OK == ATUN_Set_StepReq(setVals[s]), "step experiment not started");
+		HT_CHECK(ERR_BUSY == ATUN_Set_StepReq(setVals[s]), "second request accepted");
+		for(k = 0; (k <= N_SMPL + 1) && ( (0 == k) || (ATUN_STATE_RUN == state) ); k++)
+		{
+			ATUN_MainFct();
+			Mot_Step();
+			ATUN_Read_State(&state);
+		}
+		HT_CHECK( (ATUN_STATE_DONE == state) && (N_SMPL + 1 == k), "experiment done after %d samples in state %d", k, state);
+		for(ch = 0; ch < ATUN_STEP_CH_CNT; ch++)
+		{
+			HT_CHECK(ERR_OK == ATUN_Read_StepRslt((uint8_t)ch, &rslt), "no result of channel %d", ch);
+			HT_CHECK(N_SMPL + 1 == Mot[ch].recCnt, "channel %d read %d times", ch, Mot[ch].recCnt);
+			HT_CHECK(0 == Mot[ch].duty, "motor of channel %d not stopped", ch);
+			Ref_Anl(Mot[ch].aRec[0], setVals[s], &Mot[ch].aRec[1], N_SMPL, &ref);
+			Rslt_Print(Items[ch].pItmName, &rslt);
+			HT_CHECK(Rslt_Eq(&rslt, &ref), "channel %d differs from the reference", ch);
+			HT_CHECK(ch == rslt.itmIdx, "result of channel %d belongs to item %u", ch, rslt.itmIdx);
+			HT_CHECK(rslt.settleMs < ATUN_STEP_DURATION_MS, "channel %d not settled", ch);
+		}
+	}
+	HT_CHECK(ERR_PARAM_INDEX == ATUN_Read_StepRslt(ATUN_STEP_CH_CNT, &rslt), "channel beyond the table accepted");
+}
+
+static void Test_DerivKick(void)
+{
+	int32_t uErr = 0, uMeas = 0, uFlt = 0, act;
+	double sqMeas = 0.0, sqFlt = 0.0;
+	int k;
+
+	/* step of the desired value at constant current value */
+	PID_Reset(PID_D_ERR);
+	PID_Reset(PID_D_MEAS);
+	PID(0, 0, PID_D_ERR, &uErr);
+	PID(0, 0, PID_D_MEAS, &uMeas);
+	PID(100, 0, PID_D_ERR, &uErr);
+	PID(100, 0, PID_D_MEAS, &uMeas);
+	printf("derivative after a step of 100: %d from the error, %d from the current value\n", uErr, uMeas);
+	HT_CHECK(10000 == uErr, "derivative of the error %d instead of 10000", uErr);
+	HT_CHECK(0 == uMeas, "derivative of the current value kicks by %d", uMeas);
+
+	/* current value with one increment of quantization noise */
+	PID_Reset(PID_D_MEAS_FLT);
+	for(k = 0; k < 100000; k++)
+	{
+		act = (int32_t)(HT_Rand() % 3u) - 1;
+		PID(0, act, PID_D_MEAS, &uMeas);
+		PID(0, act, PID_D_MEAS_FLT, &uFlt);
+		sqMeas += (double)uMeas * uMeas;
+		sqFlt  += (double)uFlt * uFlt;
+	}
+	printf("derivative of quantization noise: rms %.3f unfiltered, %.3f filtered by 2^-2\n", sqrt(sqMeas / k), sqrt(sqFlt / k));
+	HT_CHECK(sqrt(sqFlt / k) < 0.5 * sqrt(sqMeas / k), "filter doesn't damp the noise");
+}
+
+
+int main(void)
+{
+	HT_Seed(36u);
+	PID_Init();
+	ATUN_Init(NULL);
+	Test_Analyzer();
+	Test_StepExp();
+	Test_DerivKick();
+	return HT_Result();
+}
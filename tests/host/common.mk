@@ -0,0 +1,57 @@
+#***************************************************************************************************
+# @file		common.mk
+# @brief	Common build rules of the host tests
+#
+# This makefile is included by the makefile of each test suite. A suite lists its test programs in
+# TESTS and the sources of a test program <t> in <t>_SRC, suite specific defines go to CPPFLAGS.
+# The tests are built with the host compiler against the sources in Sources/ and the stubs in
+# common/, the Processor Expert headers included by Platform.h are generated into the build
+# directory. The fixed point library is replaced by common/fix16.c, which reproduces the rounding
+# and overflow behavior of libfixmath in its default configuration, hence the submodules don't
+# have to be checked out. The Processor Expert components used by the SWCs under test are
+# implemented for a single threaded test without scheduler in common/pe_host.c.
+#
+# Targets:	all/run		builds and runs all test programs of the suite
+#			clean		removes the build directory
+#
+# @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+# @date 	23.04.2018
+#
+# @copyright @LGPL2_1
+#
+#***************************************************************************************************
+
+HOST_DIR := $(abspath $(dir $(lastword $(MAKEFILE_LIST))))
+REPO_DIR := $(abspath $(HOST_DIR)/../..)
+BLD      ?= build
+
+CC       ?= gcc
+CFLAGS   ?= -O2 -g
+CFLAGS   += -std=gnu99 -Wall -Wno-unused-function -Wno-pointer-sign
+CPPFLAGS += -I$(BLD)/gen -I. -I$(HOST_DIR)/common -I$(REPO_DIR)/Includes
+CPPFLAGS += $(patsubst %/,-I%,$(sort $(wildcard $(REPO_DIR)/Sources/*/)))
+CPPFLAGS += -DFIXMATRIX_MAX_SIZE=2
+LDLIBS   += -lm
+
+COMMON_SRC := $(HOST_DIR)/common/fix16.c $(HOST_DIR)/common/pe_host.c
+PE_GEN     := $(BLD)/gen/.stamp
+
+
+.PHONY: all run clean
+all: run
+
+run: $(addprefix $(BLD)/,$(TESTS))
+	@set -e; for t in $^; do echo "== $$t"; ./$$t; done
+
+$(PE_GEN):
+	@mkdir -p $(BLD)/gen
+	@printf '#include "PE_Types_host.h"\n' > '$(BLD)/gen/..\Generated_Code\PE_Types.h'
+	@printf '#include "PE_Error_host.h"\n' > '$(BLD)/gen/..\Generated_Code\PE_Error.h'
+	@touch $@
+
+.SECONDEXPANSION:
+$(addprefix $(BLD)/,$(TESTS)): $(BLD)/%: $$(%_SRC) $(COMMON_SRC) $(wildcard $(HOST_DIR)/common/*.h) $(PE_GEN)
+	$(CC) $(CPPFLAGS) $(CFLAGS) -o $@ $(filter %.c,$^) $(LDLIBS)
+
+clean:
+	rm -rf $(BLD)
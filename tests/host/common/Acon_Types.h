@@ -0,0 +1,16 @@
+/***********************************************************************************************//**
+ * @file		Acon_Types.h
+ * @ingroup		test
+ * @brief 		Forwards to Includes/ACon_Types.h
+ *
+ * Some sources include the header with a different case, which only resolves on the case
+ * insensitive file systems of the target tool chain.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#include "ACon_Types.h"
@@ -0,0 +1,25 @@
+/***********************************************************************************************//**
+ * @file		CLS1.h
+ * @ingroup		test
+ * @brief 		Host replacement of the Processor Expert shell component CLS1
+ *
+ * The shell handlers aren't part of the host tests, only the types are provided.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#ifndef CLS1_H_
+#define CLS1_H_
+
+typedef struct
+{
+	void *stdIn;
+	void *stdOut;
+	void *stdErr;
+} CLS1_StdIOType;
+
+#endif /* !CLS1_H_ */
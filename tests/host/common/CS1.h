@@ -0,0 +1,22 @@
+/***********************************************************************************************//**
+ * @file		CS1.h
+ * @ingroup		test
+ * @brief 		Host replacement of the Processor Expert critical section component CS1
+ *
+ * The host tests are single threaded, entering and leaving a critical section does nothing.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#ifndef CS1_H_
+#define CS1_H_
+
+#define CS1_CriticalVariable()	do {} while(0)
+#define CS1_EnterCritical()		do {} while(0)
+#define CS1_ExitCritical()		do {} while(0)
+
+#endif /* !CS1_H_ */
@@ -0,0 +1,21 @@
+/***********************************************************************************************//**
+ * @file		Cpu.h
+ * @ingroup		test
+ * @brief 		Host replacement of the Processor Expert CPU component
+ *
+ * Provides the core clock of the target, the host models convert their time to cycles of the
+ * cycle counter of KIN1 with it.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#ifndef CPU_H_
+#define CPU_H_
+
+#define CPU_CORE_CLK_HZ		120000000u
+
+#endif /* !CPU_H_ */
@@ -0,0 +1,25 @@
+/***********************************************************************************************//**
+ * @file		DIRL.h
+ * @ingroup		test
+ * @brief 		Host replacement of the Processor Expert bit IO component DIRL of the left motor
+ *
+ * The level of the direction pin written by the SWC mot is kept in HT_DirlVal, from where the host
+ * model of the motor reads it. See pe_host.c.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#ifndef DIRL_H_
+#define DIRL_H_
+
+#include <stdint.h>
+
+extern uint8_t HT_DirlVal;
+
+void DIRL_PutVal(uint8_t val_);
+
+#endif /* !DIRL_H_ */
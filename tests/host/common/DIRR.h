@@ -0,0 +1,25 @@
+/***********************************************************************************************//**
+ * @file		DIRR.h
+ * @ingroup		test
+ * @brief 		Host replacement of the Processor Expert bit IO component DIRR of the right motor
+ *
+ * The level of the direction pin written by the SWC mot is kept in HT_DirrVal, from where the host
+ * model of the motor reads it. See pe_host.c.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#ifndef DIRR_H_
+#define DIRR_H_
+
+#include <stdint.h>
+
+extern uint8_t HT_DirrVal;
+
+void DIRR_PutVal(uint8_t val_);
+
+#endif /* !DIRR_H_ */
@@ -0,0 +1,66 @@
+/***********************************************************************************************//**
+ * @file		FRTOS1.h
+ * @ingroup		test
+ * @brief 		Host replacement of the Processor Expert FreeRTOS component FRTOS1
+ *
+ * Provides the FreeRTOS types which appear in the APIs of the SWCs and the task functions used by
+ * them. The host tests are single threaded and don't run a scheduler: the tick count is advanced by
+ * the test, the calling task is set by the test and the task notifications are kept per task in
+ * HT_Task_t with the semantics of FreeRTOS, but xTaskNotifyWait doesn't block, it times out at once
+ * and advances the tick count if no notification is pending. See pe_host.c.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#ifndef FRTOS1_H_
+#define FRTOS1_H_
+
+#include <stdint.h>
+
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+typedef void *TaskHandle_t;
+
+#define pdFALSE					((BaseType_t)0)
+#define pdTRUE					((BaseType_t)1)
+#define pdPASS					(pdTRUE)
+#define pdFAIL					(pdFALSE)
+#define portMAX_DELAY			((TickType_t)0xFFFFFFFFu)
+#define portTICK_PERIOD_MS		((TickType_t)1u)
+#define pdMS_TO_TICKS(ms_)		((TickType_t)(ms_))
+
+typedef enum
+{
+	 eNoAction = 0
+	,eSetBits
+	,eIncrement
+	,eSetValueWithOverwrite
+	,eSetValueWithoutOverwrite
+} eNotifyAction;
+
+/* a task of the host tests, its address is the task handle */
+typedef struct HT_Task_s
+{
+	uint32_t notfVal;
+	BaseType_t isNotfPend;
+} HT_Task_t;
+
+extern TickType_t HT_Tick;
+extern HT_Task_t *HT_pCurTask;
+
+TickType_t FRTOS1_xTaskGetTickCount(void);
+TaskHandle_t FRTOS1_xTaskGetCurrentTaskHandle(void);
+BaseType_t FRTOS1_xTaskNotify(TaskHandle_t task_, uint32_t val_, eNotifyAction action_);
+BaseType_t FRTOS1_xTaskNotifyFromISR(TaskHandle_t task_, uint32_t val_, eNotifyAction action_, BaseType_t *pWoken_);
+BaseType_t FRTOS1_xTaskNotifyWait(uint32_t clrOnEntry_, uint32_t clrOnExit_, uint32_t *pVal_, TickType_t ticks_);
+void FRTOS1_taskENTER_CRITICAL(void);
+void FRTOS1_taskEXIT_CRITICAL(void);
+void FRTOS1_taskYIELD(void);
+void FRTOS1_vTaskDelay(TickType_t ticks_);
+
+#endif /* !FRTOS1_H_ */
@@ -0,0 +1,27 @@
+/***********************************************************************************************//**
+ * @file		KIN1.h
+ * @ingroup		test
+ * @brief 		Host replacement of the Processor Expert Kinetis utility component KIN1
+ *
+ * The DWT cycle counter is replaced by HT_CycCnt, which is advanced by the tests. There is no reset,
+ * the SWCs keep timestamps in the counter.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#ifndef KIN1_H_
+#define KIN1_H_
+
+#include <stdint.h>
+
+extern uint32_t HT_CycCnt;
+
+#define KIN1_InitCycleCounter()		do {} while(0)
+#define KIN1_EnableCycleCounter()	do {} while(0)
+#define KIN1_GetCycleCounter()		(HT_CycCnt)
+
+#endif /* !KIN1_H_ */
@@ -0,0 +1,41 @@
+/***********************************************************************************************//**
+ * @file		PE_Error_host.h
+ * @ingroup		test
+ * @brief 		Host replacement of the Processor Expert header PE_Error.h
+ *
+ * Provides the error codes of Generated_Code/PE_Error.h which are used by the sources under test.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#ifndef PE_ERROR_HOST_H_
+#define PE_ERROR_HOST_H_
+
+#define ERR_OK           0x00U
+#define ERR_SPEED        0x01U
+#define ERR_RANGE        0x02U
+#define ERR_VALUE        0x03U
+#define ERR_OVERFLOW     0x04U
+#define ERR_MATH         0x05U
+#define ERR_ENABLED      0x06U
+#define ERR_DISABLED     0x07U
+#define ERR_BUSY         0x08U
+#define ERR_NOTAVAIL     0x09U
+#define ERR_RXEMPTY      0x0AU
+#define ERR_TXFULL       0x0BU
+#define ERR_BUSOFF       0x0CU
+#define ERR_FAILED       0x1BU
+#define ERR_PARAM_MODE   0x81U
+#define ERR_PARAM_ADDRESS 0x86U
+#define ERR_PARAM_RANGE  0x87U
+#define ERR_PARAM_VALUE  0x89U
+#define ERR_PARAM_INDEX  0x8CU
+#define ERR_PARAM_DATA   0x8DU
+#define ERR_PARAM_ID     0x8EU
+#define ERR_PARAM_CONDITION 0x8FU
+
+#endif /* !PE_ERROR_HOST_H_ */
@@ -0,0 +1,39 @@
+/***********************************************************************************************//**
+ * @file		PE_Types_host.h
+ * @ingroup		test
+ * @brief 		Host replacement of the Processor Expert header PE_Types.h
+ *
+ * Provides the basic types of Generated_Code/PE_Types.h which are used by the sources under test.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#ifndef PE_TYPES_HOST_H_
+#define PE_TYPES_HOST_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef FALSE
+#define FALSE  0x00u
+#endif
+#ifndef TRUE
+#define TRUE   0x01u
+#endif
+
+typedef unsigned char bool;
+typedef unsigned char byte;
+typedef unsigned short word;
+typedef unsigned long dword;
+typedef unsigned char uint8;
+typedef unsigned short uint16;
+typedef unsigned long uint32;
+typedef signed char int8;
+typedef short int int16;
+typedef long int int32;
+
+#endif /* !PE_TYPES_HOST_H_ */
@@ -0,0 +1,26 @@
+/***********************************************************************************************//**
+ * @file		PWML.h
+ * @ingroup		test
+ * @brief 		Host replacement of the Processor Expert PWM component PWML of the left motor
+ *
+ * The ratio written by the SWC mot is kept in HT_PwmlRatio, from where the host model of
+ * the motor reads it. The ratio is low active like the H-bridge on the target. See pe_host.c.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#ifndef PWML_H_
+#define PWML_H_
+
+#include <stdint.h>
+
+extern uint16_t HT_PwmlRatio;
+
+uint8_t PWML_SetRatio16(uint16_t ratio_);
+uint8_t PWML_Enable(void);
+
+#endif /* !PWML_H_ */
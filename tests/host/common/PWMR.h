@@ -0,0 +1,26 @@
+/***********************************************************************************************//**
+ * @file		PWMR.h
+ * @ingroup		test
+ * @brief 		Host replacement of the Processor Expert PWM component PWMR of the right motor
+ *
+ * The ratio written by the SWC mot is kept in HT_PwmrRatio, from where the host model of
+ * the motor reads it. The ratio is low active like the H-bridge on the target. See pe_host.c.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#ifndef PWMR_H_
+#define PWMR_H_
+
+#include <stdint.h>
+
+extern uint16_t HT_PwmrRatio;
+
+uint8_t PWMR_SetRatio16(uint16_t ratio_);
+uint8_t PWMR_Enable(void);
+
+#endif /* !PWMR_H_ */
@@ -0,0 +1,25 @@
+/***********************************************************************************************//**
+ * @file		UTIL1.h
+ * @ingroup		test
+ * @brief 		Host replacement of the Processor Expert string utility component UTIL1
+ *
+ * Provides the string functions used by the SWCs under test. See pe_host.c.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#ifndef UTIL1_H_
+#define UTIL1_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+void UTIL1_strcpy(uint8_t *dst_, size_t dstSize_, const unsigned char *src_);
+void UTIL1_strcat(uint8_t *dst_, size_t dstSize_, const unsigned char *src_);
+void UTIL1_strcatNum32s(uint8_t *dst_, size_t dstSize_, int32_t num_);
+
+#endif /* !UTIL1_H_ */
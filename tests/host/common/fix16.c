@@ -0,0 +1,147 @@
+/***********************************************************************************************//**
+ * @file		fix16.c
+ * @ingroup		test
+ * @brief 		Host replacement of the implementation of libfixmath
+ *
+ * Implements the functions declared in fix16.h. The results are bit-identical to libfixmath in
+ * its default configuration: products and quotients are rounded to nearest, additions and
+ * subtractions return fix16_overflow if the result doesn't fit, the square root uses the same
+ * bitwise algorithm.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#include "fix16.h"
+
+
+fix16_t fix16_add(fix16_t a_, fix16_t b_)
+{
+	uint32_t a = (uint32_t)a_, b = (uint32_t)b_;
+	uint32_t sum = a + b;
+
+	/* overflow can only occur if the signs of a and b are equal and differ from the sign of sum */
+	if( (0u == ((a ^ b) & 0x80000000u)) && (0u != ((a ^ sum) & 0x80000000u)) )
+	{
+		return fix16_overflow;
+	}
+	return (fix16_t)sum;
+}
+
+fix16_t fix16_sub(fix16_t a_, fix16_t b_)
+{
+	uint32_t a = (uint32_t)a_, b = (uint32_t)b_;
+	uint32_t diff = a - b;
+
+	/* overflow can only occur if the signs of a and b differ and the sign of diff differs from a */
+	if( (0u != ((a ^ b) & 0x80000000u)) && (0u != ((a ^ diff) & 0x80000000u)) )
+	{
+		return fix16_overflow;
+	}
+	return (fix16_t)diff;
+}
+
+fix16_t fix16_mul(fix16_t a_, fix16_t b_)
+{
+	int64_t product = (int64_t)a_ * b_;
+	uint32_t upper = (uint32_t)(product >> 47);
+	fix16_t result = 0;
+
+	if(product < 0)
+	{
+		if(0u != ~upper)
+		{
+			return fix16_overflow;
+		}
+		product--; /* round -1/2 correctly */
+	}
+	else if(0u != upper)
+	{
+		return fix16_overflow;
+	}
+	result  = (fix16_t)(product >> 16);
+	result += (fix16_t)((product & 0x8000) >> 15);
+	return result;
+}
+
+fix16_t fix16_div(fix16_t a_, fix16_t b_)
+{
+	uint64_t num = 0u, quot = 0u;
+	fix16_t result = 0;
+
+	if(0 == b_)
+	{
+		return fix16_minimum;
+	}
+	/* libfixmath computes (|a| << 17) / |b| exactly and rounds the last bit away */
+	num  = (uint64_t)((a_ >= 0) ? (uint32_t)a_ : -(uint32_t)a_) << 17;
+	quot = num / ((b_ >= 0) ? (uint32_t)b_ : -(uint32_t)b_);
+	if(quot > 0xFFFFFFFFu)
+	{
+		return fix16_overflow;
+	}
+	result = (fix16_t)(uint32_t)((quot + 1u) >> 1);
+	if(0 != ((a_ ^ b_) & 0x80000000))
+	{
+		if(fix16_minimum == result)
+		{
+			return fix16_overflow;
+		}
+		result = -result;
+	}
+	return result;
+}
+
+fix16_t fix16_sqrt(fix16_t a_)
+{
+	uint8_t neg = (a_ < 0);
+	uint32_t num = (neg ? -(uint32_t)a_ : (uint32_t)a_);
+	uint32_t result = 0u, bit = 0u;
+	uint8_t n = 0u;
+
+	bit = (0u != (num & 0xFFF00000u)) ? ((uint32_t)1u << 30) : ((uint32_t)1u << 18);
+	while(bit > num)
+	{
+		bit >>= 2;
+	}
+	/* the upper 24 bit of the result in the first, the lower 8 bit in the second pass */
+	for(n = 0u; n < 2u; n++)
+	{
+		while(0u != bit)
+		{
+			if(num >= (result + bit))
+			{
+				num   -= result + bit;
+				result = (result >> 1) + bit;
+			}
+			else
+			{
+				result = (result >> 1);
+			}
+			bit >>= 2;
+		}
+		if(0u == n)
+		{
+			if(num > 65535u)
+			{
+				num   -= result;
+				num    = (num << 16) - 0x8000u;
+				result = (result << 16) + 0x8000u;
+			}
+			else
+			{
+				num   <<= 16;
+				result <<= 16;
+			}
+			bit = (uint32_t)1u << 14;
+		}
+	}
+	if(num > result)
+	{
+		result++;
+	}
+	return (neg ? -(fix16_t)result : (fix16_t)result);
+}
@@ -0,0 +1,44 @@
+/***********************************************************************************************//**
+ * @file		fix16.h
+ * @ingroup		test
+ * @brief 		Host replacement of the interface of libfixmath
+ *
+ * Declares the subset of libfixmath which is used by the sources under test. The functions are
+ * implemented in fix16.c with the rounding and overflow behavior of libfixmath in its default
+ * configuration, i.e. neither FIXMATH_NO_ROUNDING nor FIXMATH_NO_OVERFLOW are defined.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#ifndef FIX16_H_
+#define FIX16_H_
+
+#include <stdint.h>
+
+typedef int32_t fix16_t;
+
+static const fix16_t fix16_maximum  = 0x7FFFFFFF; /* the maximum value of fix16_t */
+static const fix16_t fix16_minimum  = 0x80000000; /* the minimum value of fix16_t */
+static const fix16_t fix16_overflow = 0x80000000; /* the value used to indicate overflows */
+static const fix16_t fix16_one      = 0x00010000; /* fix16_t value of 1 */
+static const fix16_t fix16_pi       = 205887;     /* fix16_t value of pi */
+
+static inline fix16_t fix16_from_int(int a)     { return a * fix16_one; }
+static inline int     fix16_to_int(fix16_t a)   { return (a >= 0) ? ((a + (fix16_one >> 1)) / fix16_one) : ((a - (fix16_one >> 1)) / fix16_one); }
+static inline fix16_t fix16_from_dbl(double a)  { double temp = a * fix16_one; temp += (temp >= 0) ? 0.5 : -0.5; return (fix16_t)temp; }
+static inline double  fix16_to_dbl(fix16_t a)   { return (double)a / fix16_one; }
+static inline fix16_t fix16_abs(fix16_t x)      { return (fix16_t)(x < 0 ? -(uint32_t)x : (uint32_t)x); }
+
+extern fix16_t fix16_add(fix16_t a_, fix16_t b_);
+extern fix16_t fix16_sub(fix16_t a_, fix16_t b_);
+extern fix16_t fix16_mul(fix16_t a_, fix16_t b_);
+extern fix16_t fix16_div(fix16_t a_, fix16_t b_);
+extern fix16_t fix16_sqrt(fix16_t a_);
+
+static inline fix16_t fix16_sq(fix16_t x)       { return fix16_mul(x, x); }
+
+#endif /* !FIX16_H_ */
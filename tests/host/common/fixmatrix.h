@@ -0,0 +1,39 @@
+/***********************************************************************************************//**
+ * @file		fixmatrix.h
+ * @ingroup		test
+ * @brief 		Host replacement of the interface of libfixmatrix
+ *
+ * Provides the error flags and the type mf16 of libfixmatrix, which the SWC @a mtx shares with the
+ * library. None of the functions of the library are used by the sources under test.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#ifndef FIXMATRIX_H_
+#define FIXMATRIX_H_
+
+#include <stdint.h>
+#include "fix16.h"
+
+#ifndef FIXMATRIX_MAX_SIZE
+#define FIXMATRIX_MAX_SIZE 8
+#endif
+
+#define FIXMATRIX_OVERFLOW 0x01
+#define FIXMATRIX_DIMERR   0x02
+#define FIXMATRIX_USEERR   0x04
+#define FIXMATRIX_SINGULAR 0x08
+#define FIXMATRIX_NEGATIVE 0x10
+
+typedef struct {
+	uint8_t rows;
+	uint8_t columns;
+	uint8_t errors;
+	fix16_t data[FIXMATRIX_MAX_SIZE][FIXMATRIX_MAX_SIZE];
+} mf16;
+
+#endif /* !FIXMATRIX_H_ */
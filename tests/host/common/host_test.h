@@ -0,0 +1,103 @@
+/***********************************************************************************************//**
+ * @file		host_test.h
+ * @ingroup		test
+ * @brief 		Minimal test harness of the host tests
+ *
+ * Provides checks which count and print failures, a reproducible pseudo random number generator
+ * and a monotonic clock for the timing of the benchmarks. Each test program consists of a single
+ * translation unit which includes this header, returns HT_Result() from main() and thereby fails
+ * the make target if any check failed.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#ifndef HOST_TEST_H_
+#define HOST_TEST_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+
+static unsigned int HT_NumChecks = 0u;
+static unsigned int HT_NumFails  = 0u;
+static uint64_t HT_RandState = 0x853C49E6748FEA9BULL;
+
+/**
+ * @brief Counts a check and prints the message if cond_ is false
+ */
+#define HT_CHECK(cond_, ...) do {                                        \
+		HT_NumChecks++;                                                  \
+		if( !(cond_) )                                                   \
+		{                                                                \
+			HT_NumFails++;                                               \
+			printf("FAIL %s:%d: ", __FILE__, __LINE__);                  \
+			printf(__VA_ARGS__);                                         \
+			printf("\n");                                                \
+		}                                                                \
+	} while(0)
+
+/**
+ * @brief Prints the summary of all checks, returns the exit code of the test program
+ */
+static inline int HT_Result(void)
+{
+	printf("%u checks, %u failed\n", HT_NumChecks, HT_NumFails);
+	return (0u == HT_NumFails) ? 0 : 1;
+}
+
+/**
+ * @brief Sets the seed of the random number generator
+ */
+static inline void HT_Seed(uint64_t seed_)
+{
+	HT_RandState = seed_ ? seed_ : 1u;
+}
+
+/**
+ * @brief Returns a uniformly distributed 32 bit random number (xorshift64*)
+ */
+static inline uint32_t HT_Rand(void)
+{
+	HT_RandState ^= HT_RandState >> 12;
+	HT_RandState ^= HT_RandState << 25;
+	HT_RandState ^= HT_RandState >> 27;
+	return (uint32_t)((HT_RandState * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+/**
+ * @brief Returns a uniformly distributed random number in [lo_, hi_)
+ */
+static inline double HT_Uniform(double lo_, double hi_)
+{
+	return lo_ + (hi_ - lo_) * ((double)HT_Rand() / 4294967296.0);
+}
+
+/**
+ * @brief Returns a monotonic time stamp in ns
+ */
+static inline uint64_t HT_Now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Runs stmt_ n_ times and stores the mean time per run in ns to nsPerRun_
+ */
+#define HT_TIME(nsPerRun_, n_, stmt_) do {                               \
+		unsigned long ht_i_ = 0u;                                        \
+		uint64_t ht_t0_ = HT_Now();                                      \
+		for(ht_i_ = 0u; ht_i_ < (unsigned long)(n_); ht_i_++)            \
+		{                                                                \
+			stmt_;                                                       \
+		}                                                                \
+		(nsPerRun_) = (double)(HT_Now() - ht_t0_) / (double)(n_);        \
+	} while(0)
+
+#endif /* !HOST_TEST_H_ */
@@ -0,0 +1,167 @@
+/***********************************************************************************************//**
+ * @file		pe_host.c
+ * @ingroup		test
+ * @brief 		Host implementation of the Processor Expert components used by the SWCs under test
+ *
+ * Implements the task functions of FRTOS1 for a single threaded test without scheduler, the cycle
+ * counter of KIN1, the string functions of UTIL1 and the PWM and direction outputs of the motors,
+ * which are read by the host models of the motors.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "PE_Error_host.h"
+#include "FRTOS1.h"
+#include "KIN1.h"
+#include "UTIL1.h"
+#include "PWML.h"
+#include "PWMR.h"
+#include "DIRL.h"
+#include "DIRR.h"
+
+TickType_t HT_Tick = 0u;
+HT_Task_t *HT_pCurTask = NULL;
+uint32_t HT_CycCnt = 0u;
+uint16_t HT_PwmlRatio = 0xFFFFu;
+uint16_t HT_PwmrRatio = 0xFFFFu;
+uint8_t HT_DirlVal = 0u;
+uint8_t HT_DirrVal = 0u;
+
+
+/*============================================ FRTOS1 ============================================*/
+TickType_t FRTOS1_xTaskGetTickCount(void)
+{
+	return HT_Tick;
+}
+
+TaskHandle_t FRTOS1_xTaskGetCurrentTaskHandle(void)
+{
+	return (TaskHandle_t)HT_pCurTask;
+}
+
+BaseType_t FRTOS1_xTaskNotify(TaskHandle_t task_, uint32_t val_, eNotifyAction action_)
+{
+	HT_Task_t *pTask = (HT_Task_t *)task_;
+	BaseType_t retVal = pdPASS;
+
+	switch(action_)
+	{
+		case eSetBits:					pTask->notfVal |= val_; break;
+		case eIncrement:				pTask->notfVal++; break;
+		case eSetValueWithOverwrite:	pTask->notfVal = val_; break;
+		case eSetValueWithoutOverwrite:
+			if(pdFALSE == pTask->isNotfPend)
+			{
+				pTask->notfVal = val_;
+			}
+			else
+			{
+				retVal = pdFAIL;
+			}
+			break;
+		default:						break;
+	}
+	pTask->isNotfPend = pdTRUE;
+	return retVal;
+}
+
+BaseType_t FRTOS1_xTaskNotifyFromISR(TaskHandle_t task_, uint32_t val_, eNotifyAction action_, BaseType_t *pWoken_)
+{
+	if(NULL != pWoken_)
+	{
+		*pWoken_ = pdTRUE;
+	}
+	return FRTOS1_xTaskNotify(task_, val_, action_);
+}
+
+/* doesn't block: no other task can notify during the wait, so a wait without pending notification
+ * times out at once and advances the tick count by its timeout */
+BaseType_t FRTOS1_xTaskNotifyWait(uint32_t clrOnEntry_, uint32_t clrOnExit_, uint32_t *pVal_, TickType_t ticks_)
+{
+	HT_Task_t *pTask = HT_pCurTask;
+	BaseType_t retVal = pdFALSE;
+
+	if(pdFALSE == pTask->isNotfPend)
+	{
+		pTask->notfVal &= ~clrOnEntry_;
+		HT_Tick += (portMAX_DELAY != ticks_) ? ticks_ : 0u;
+	}
+	if(NULL != pVal_)
+	{
+		*pVal_ = pTask->notfVal;
+	}
+	if(pdFALSE != pTask->isNotfPend)
+	{
+		pTask->notfVal   &= ~clrOnExit_;
+		pTask->isNotfPend = pdFALSE;
+		retVal = pdTRUE;
+	}
+	return retVal;
+}
+
+void FRTOS1_taskENTER_CRITICAL(void) {}
+void FRTOS1_taskEXIT_CRITICAL(void) {}
+void FRTOS1_taskYIELD(void) {}
+
+void FRTOS1_vTaskDelay(TickType_t ticks_)
+{
+	HT_Tick += ticks_;
+}
+
+
+/*============================================= UTIL1 ============================================*/
+void UTIL1_strcpy(uint8_t *dst_, size_t dstSize_, const unsigned char *src_)
+{
+	snprintf((char *)dst_, dstSize_, "%s", (const char *)src_);
+}
+
+void UTIL1_strcat(uint8_t *dst_, size_t dstSize_, const unsigned char *src_)
+{
+	size_t len = strlen((const char *)dst_);
+
+	if(len < dstSize_)
+	{
+		snprintf((char *)dst_ + len, dstSize_ - len, "%s", (const char *)src_);
+	}
+}
+
+void UTIL1_strcatNum32s(uint8_t *dst_, size_t dstSize_, int32_t num_)
+{
+	char buf[12];
+
+	snprintf(buf, sizeof(buf), "%d", num_);
+	UTIL1_strcat(dst_, dstSize_, (const unsigned char *)buf);
+}
+
+
+/*========================================= PWML/R, DIRL/R =======================================*/
+uint8_t PWML_SetRatio16(uint16_t ratio_)
+{
+	HT_PwmlRatio = ratio_;
+	return ERR_OK;
+}
+
+uint8_t PWMR_SetRatio16(uint16_t ratio_)
+{
+	HT_PwmrRatio = ratio_;
+	return ERR_OK;
+}
+
+uint8_t PWML_Enable(void) {return ERR_OK;}
+uint8_t PWMR_Enable(void) {return ERR_OK;}
+
+void DIRL_PutVal(uint8_t val_)
+{
+	HT_DirlVal = val_;
+}
+
+void DIRR_PutVal(uint8_t val_)
+{
+	HT_DirrVal = val_;
+}
@@ -0,0 +1,204 @@
+/***********************************************************************************************//**
+ * @file		drv_plant.c
+ * @ingroup		test
+ * @brief 		Host model of the drive of the Sumo robot for the tests of the SWC @a drv
+ *
+ * The SWC mot runs unchanged against the host PWM and direction outputs of pe_host.c, so the
+ * limiter, the compensation and the linearization act like on the target. The SWC tacho is
+ * replaced by the counters of the model, which are sampled at the tick hook. Its speed is the
+ * speed of the model at the tick hook, i.e. an ideal filter: the difference of the counters
+ * resolves 200 steps/sec only and the tracking loop of the target adds a lag, both would test the
+ * filter rather than the drive. The PID items use the default gains of pid_cfg.c without NVM.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#include <math.h>
+#include <string.h>
+#include "drv_plant.h"
+#include "drv.h"
+#include "drv_api.h"
+#include "drv_cfg.h"
+#include "drv_isr.h"
+#include "mot.h"
+#include "mot_api.h"
+#include "nvm_api.h"
+#include "batt_api.h"
+#include "pid.h"
+#include "pid_cfg.h"
+#include "pid_api.h"
+#include "KIN1.h"
+#include "Cpu.h"
+#include "PWML.h"
+#include "PWMR.h"
+#include "DIRL.h"
+#include "DIRR.h"
+
+#define PLANT_DT			(DRV_ISR_TMR_PERIOD_US * 1e-6)
+#define PLANT_CYC_PER_DT	((uint32_t)(CPU_CORE_CLK_HZ / 1000000u) * DRV_ISR_TMR_PERIOD_US)
+
+PLANT_Whl_t Plant[TACHO_ID_CNT];
+double PlantTime;
+
+static HT_Task_t DrvTask;
+static uint32_t PlantUs, TaskUs;
+static int32_t aCntOfs[TACHO_ID_CNT];
+static int32_t aCurPos[TACHO_ID_CNT];
+static int16_t aCurSpd[TACHO_ID_CNT];
+
+/* the items of pid_cfg.c with its default gains */
+#define ITM(gain_, form_, schedVar_, dSrc_) {{"", gain_, {NULL, NULL, NULL, NULL, NULL, NULL}, form_, schedVar_, dSrc_, 2u, {0}, {{{0}}}}, {0}}
+static PID_Itm_t Items[] =
+{
+	ITM(((PID_Gain_t){2000u, 80u,  0u, 100u, 0xFFFFu}), PID_FORM_VEL, PID_SCHED_SET,  PID_DSRC_MEAS),
+	ITM(((PID_Gain_t){2000u, 80u,  0u, 100u, 0xFFFFu}), PID_FORM_VEL, PID_SCHED_SET,  PID_DSRC_MEAS),
+	ITM(((PID_Gain_t){1000u,  1u, 50u, 100u, 0xFFFFu}), PID_FORM_POS, PID_SCHED_NONE, PID_DSRC_MEAS),
+	ITM(((PID_Gain_t){1000u,  1u, 50u, 100u, 0xFFFFu}), PID_FORM_POS, PID_SCHED_NONE, PID_DSRC_MEAS),
+	ITM(((PID_Gain_t){ 800u, 20u,  0u, 100u,    400u}), PID_FORM_POS, PID_SCHED_NONE, PID_DSRC_ERR),
+};
+static PID_ItmTbl_t ItemTable = {Items, sizeof(Items)/sizeof(Items[0])};
+
+PID_ItmTbl_t *Get_pPidItmTbl(void) {return &ItemTable;}
+
+
+/*========================================= NVM and BATT =========================================*/
+/* the NVM is erased, mot loads the defaults of nvm_cfg.c */
+StdRtn_t NVM_Read_MotLinLeCfg(NVM_MotLinCfg_t *linCfg_) {(void)linCfg_; return ERR_VALUE;}
+StdRtn_t NVM_Read_MotLinRiCfg(NVM_MotLinCfg_t *linCfg_) {(void)linCfg_; return ERR_VALUE;}
+StdRtn_t NVM_Read_MotLimCfg(NVM_MotLimCfg_t *limCfg_) {(void)limCfg_; return ERR_VALUE;}
+
+StdRtn_t NVM_Read_Dflt_MotLinLeCfg(NVM_MotLinCfg_t *linCfg_)
+{
+	memset(linCfg_, 0, sizeof(*linCfg_));
+	return ERR_OK;
+}
+
+StdRtn_t NVM_Read_Dflt_MotLinRiCfg(NVM_MotLinCfg_t *linCfg_)
+{
+	memset(linCfg_, 0, sizeof(*linCfg_));
+	return ERR_OK;
+}
+
+StdRtn_t NVM_Read_Dflt_MotLimCfg(NVM_MotLimCfg_t *limCfg_)
+{
+	limCfg_->slewRate = 3277u;
+	limCfg_->coastMs  = 2u;
+	return ERR_OK;
+}
+
+/* no voltage measured yet, the motor values aren't compensated */
+StdRtn_t BATT_Read_FltVolt(uint16_t *cvP) {(void)cvP; return ERR_VALUE;}
+
+
+/*============================================= TACHO ============================================*/
+int32_t TACHO_Get_CntPosLe(void) {return (int32_t)floor(Plant[TACHO_ID_LEFT].pos) - aCntOfs[TACHO_ID_LEFT];}
+int32_t TACHO_Get_CntPosRi(void) {return (int32_t)floor(Plant[TACHO_ID_RIGHT].pos) - aCntOfs[TACHO_ID_RIGHT];}
+
+void TACHO_Set_CntPos(int32_t left_, int32_t right_)
+{
+	aCntOfs[TACHO_ID_LEFT]  = (int32_t)floor(Plant[TACHO_ID_LEFT].pos) - left_;
+	aCntOfs[TACHO_ID_RIGHT] = (int32_t)floor(Plant[TACHO_ID_RIGHT].pos) - right_;
+}
+
+StdRtn_t TACHO_Read_PosLe(int32_t *pos_) {*pos_ = aCurPos[TACHO_ID_LEFT]; return ERR_OK;}
+StdRtn_t TACHO_Read_PosRi(int32_t *pos_) {*pos_ = aCurPos[TACHO_ID_RIGHT]; return ERR_OK;}
+
+StdRtn_t TACHO_Read_SpdLe(int16_t *spd_) {*spd_ = aCurSpd[TACHO_ID_LEFT]; return ERR_OK;}
+StdRtn_t TACHO_Read_SpdRi(int16_t *spd_) {*spd_ = aCurSpd[TACHO_ID_RIGHT]; return ERR_OK;}
+
+
+/*============================================= model ============================================*/
+/* signed motor value at the H-bridge from the low active PWM ratio and the direction pin */
+static int32_t Get_Duty(uint16_t ratio_, uint8_t dirVal_, bool isInv_)
+{
+	int32_t duty = 0xFFFF - (int32_t)ratio_;
+
+	return ((0u != dirVal_) == (isInv_ ? 0 : 1)) ? duty : -duty;
+}
+
+static void Step_Whl(PLANT_Whl_t *pWhl_)
+{
+	const PLANT_Mot_t *pMot = &pWhl_->mot;
+	double drv = pMot->gain * pWhl_->duty - pMot->load;
+
+	if(pMot->isBlocked)
+	{
+		pWhl_->spd = 0.0;
+	}
+	else if( (fabs(drv) <= pMot->fric) && (fabs(pWhl_->spd) <= pMot->fric) )
+	{
+		pWhl_->spd = 0.0; /* held by static friction */
+	}
+	else
+	{
+		drv -= (0.0 < drv) ? pMot->fric : -pMot->fric;
+		pWhl_->spd += PLANT_DT * (drv - pWhl_->spd) / pMot->tau;
+	}
+	pWhl_->pos += PLANT_DT * pWhl_->spd;
+}
+
+void PLANT_Init(PLANT_Mot_t motLe_, PLANT_Mot_t motRi_)
+{
+	memset(Plant, 0, sizeof(Plant));
+	memset(aCntOfs, 0, sizeof(aCntOfs));
+	memset(aCurPos, 0, sizeof(aCurPos));
+	memset(aCurSpd, 0, sizeof(aCurSpd));
+	memset(&DrvTask, 0, sizeof(DrvTask));
+	Plant[TACHO_ID_LEFT].mot  = motLe_;
+	Plant[TACHO_ID_RIGHT].mot = motRi_;
+	PlantTime   = 0.0;
+	PlantUs     = 0u;
+	TaskUs      = 0u;
+	HT_Tick     = 0u;
+	HT_pCurTask = &DrvTask;
+	PID_Init();
+	DRV_Init(NULL);
+}
+
+void PLANT_Run(uint32_t durMs_, void (*stepFct_)(void))
+{
+	uint32_t endUs = PlantUs + durMs_ * 1000u;
+
+	while(PlantUs < endUs)
+	{
+		if(TaskUs <= PlantUs)
+		{
+			/* tick hook with the tacho sampling, then the drive task */
+			aCurPos[TACHO_ID_LEFT]  = TACHO_Get_CntPosLe();
+			aCurPos[TACHO_ID_RIGHT] = TACHO_Get_CntPosRi();
+			aCurSpd[TACHO_ID_LEFT]  = (int16_t)lround(Plant[TACHO_ID_LEFT].spd);
+			aCurSpd[TACHO_ID_RIGHT] = (int16_t)lround(Plant[TACHO_ID_RIGHT].spd);
+			HT_pCurTask = &DrvTask;
+			DRV_MainFct();
+			MOT_MainFct();
+			if(NULL != stepFct_)
+			{
+				stepFct_();
+			}
+			HT_Tick += DRV_SMPL_TIME_MS;
+			TaskUs  += DRV_SMPL_TIME_MS * 1000u;
+		}
+		DRV_Isr_Step();
+		Plant[TACHO_ID_LEFT].duty  = Get_Duty(HT_PwmlRatio, HT_DirlVal, CAU_SUMO_PLT_MOTOR_LEFT_INVERTED);
+		Plant[TACHO_ID_RIGHT].duty = Get_Duty(HT_PwmrRatio, HT_DirrVal, CAU_SUMO_PLT_MOTOR_RIGHT_INVERTED);
+		Step_Whl(&Plant[TACHO_ID_LEFT]);
+		Step_Whl(&Plant[TACHO_ID_RIGHT]);
+		HT_CycCnt += PLANT_CYC_PER_DT;
+		PlantUs   += DRV_ISR_TMR_PERIOD_US;
+		PlantTime  = PlantUs * 1e-6;
+	}
+}
+
+double PLANT_Hdg(void)
+{
+	return PLANT_HDG_DEG(Plant[TACHO_ID_LEFT].pos, Plant[TACHO_ID_RIGHT].pos);
+}
+
+double PLANT_Dist(void)
+{
+	return (Plant[TACHO_ID_LEFT].pos + Plant[TACHO_ID_RIGHT].pos) / (2.0 * PLANT_STEPS_PER_MM);
+}
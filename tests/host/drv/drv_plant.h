@@ -0,0 +1,64 @@
+/***********************************************************************************************//**
+ * @file		drv_plant.h
+ * @ingroup		test
+ * @brief 		Host model of the drive of the Sumo robot for the tests of the SWC @a drv
+ *
+ * Replaces the SWC tacho, the PID configuration and the H-bridges by a model of two DC motors with
+ * the robot, which is integrated at the period of the timer QuadInt. The drive task and the
+ * interrupt of QuadInt are called at their periods like on the target, the SWC mot is linked.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#ifndef DRV_PLANT_H_
+#define DRV_PLANT_H_
+
+#include "Platform.h"
+#include "FRTOS1.h"
+#include "tacho_api.h"
+
+/* steps per mm of a wheel and the heading of the robot in degrees from the wheel positions */
+#define PLANT_STEPS_PER_MM		(CAU_SUMO_STEPS_PER_REV_AT_WHEEL / (M_PI * CAU_SUMO_WHEEL_DIAMETER))
+#define PLANT_HDG_DEG(le_, ri_)	(((ri_) - (le_)) / (PLANT_STEPS_PER_MM * CAU_SUMO_AXIS_LENGTH) * 180.0 / M_PI)
+
+/* motor of a wheel: v' = (gain * duty - friction - load - v) / tau, friction opposes the motion */
+typedef struct PLANT_Mot_s
+{
+	double gain;		/* speed at the wheel in steps/s per motor value */
+	double tau;			/* mechanical time constant in [s] */
+	double fric;		/* friction as speed in steps/s */
+	double load;		/* external load as speed in steps/s */
+	int isBlocked;		/* the wheel is held at its position */
+} PLANT_Mot_t;
+
+/* state of a wheel */
+typedef struct PLANT_Whl_s
+{
+	PLANT_Mot_t mot;
+	double spd;			/* speed in steps/s */
+	double pos;			/* position in steps */
+	int32_t duty;		/* motor value applied at the last integration step */
+} PLANT_Whl_t;
+
+/* nominal motor of drv_cfg.c, 8000 steps/s at full motor value and 80 ms */
+#define PLANT_MOT_NOM	((PLANT_Mot_t){8000.0 / 0xFFFF, 0.080, 0.0, 0.0, 0})
+
+extern PLANT_Whl_t Plant[TACHO_ID_CNT];
+extern double PlantTime;
+
+/* resets the model and the tick count and initializes the SWCs pid, drv and mot with the motors */
+void PLANT_Init(PLANT_Mot_t motLe_, PLANT_Mot_t motRi_);
+
+/* runs drive task, interrupt and model for durMs_ [ms], stepFct_ is called after each call of the
+ * drive task if not NULL */
+void PLANT_Run(uint32_t durMs_, void (*stepFct_)(void));
+
+/* heading of the robot in degrees and distance travelled by its centre in [mm] */
+double PLANT_Hdg(void);
+double PLANT_Dist(void);
+
+#endif /* !DRV_PLANT_H_ */
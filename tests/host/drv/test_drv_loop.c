@@ -0,0 +1,143 @@
+/***********************************************************************************************//**
+ * @file		test_drv_loop.c
+ * @ingroup		test
+ * @brief 		Host tests of the speed loops of the SWC @a drv in the task and in the interrupt
+ *
+ * The test is built twice, as test_drv_loop_tsk with the speed loops in @ref DRV_MainFct and as
+ * test_drv_loop_isr with DRV_USES_ISR_LOOP, which runs them in the interrupt of QuadInt. Both drive
+ * the model of drv_plant.c at 2000 steps/s, load the right wheel by 1500 steps/s for 0.5 s and move
+ * the wheels to 3000/-3000 in position mode, and report the speed error, the dip of the speed
+ * under load and the settle time. The cycle counter starts shortly before its overflow and must
+ * neither be reset by the initialization nor disturb the limiter of mot.c when it wraps.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#include <math.h>
+#include "host_test.h"
+#include "drv_plant.h"
+#include "drv_api.h"
+#include "drv_cfg.h"
+#include "KIN1.h"
+
+#define SPD				(2000)
+#define LOAD			(1500.0)
+#define CYC_STRT		(0xFFF00000u)	/* overflow of the cycle counter after about 9 ms */
+
+#if DRV_USES_ISR_LOOP
+#define LOOP_NAME		"interrupt"
+#else
+#define LOOP_NAME		"task"
+#endif
+/* the speed of the task loop is ideal in the model, see drv_plant.c, so both loops meet the same
+ * limits here, while the interrupt loop avoids the quantization of the speed on the target */
+#define ERR_MAX			(15.0)		/* mean speed error in steps/s */
+#define DIP_MAX			(400.0)		/* dip of the speed under load in steps/s */
+#define SPD_TOL			(40.0)		/* speed error 0.5 s after the load in steps/s */
+#define SETTLE_MAX_MS	(1860)
+
+static double ErrSum, Dip;
+static uint32_t NumErr;
+static int32_t SettleMs;
+
+static void Rec_Spd(void)
+{
+	if((PlantTime > 0.5) && (PlantTime <= 1.0))
+	{
+		ErrSum += fabs(Plant[TACHO_ID_LEFT].spd - SPD) + fabs(Plant[TACHO_ID_RIGHT].spd - SPD);
+		NumErr += 2u;
+	}
+	if((PlantTime > 1.0) && (SPD - Plant[TACHO_ID_RIGHT].spd > Dip))
+	{
+		Dip = SPD - Plant[TACHO_ID_RIGHT].spd;
+	}
+}
+
+static void Rec_Settle(void)
+{
+	if((0 > SettleMs) && DRV_IsStopped())
+	{
+		SettleMs = (int32_t)HT_Tick;
+	}
+}
+
+static void Init(void)
+{
+	HT_CycCnt = CYC_STRT;
+	PLANT_Init(PLANT_MOT_NOM, PLANT_MOT_NOM);
+	HT_CHECK(CYC_STRT == HT_CycCnt, "cycle counter changed by the initialization to 0x%08x", (unsigned int)HT_CycCnt);
+}
+
+static void Test_Spd(void)
+{
+	uint16_t load = 0u;
+	uint32_t cycMax = 0u;
+
+	Init();
+	ErrSum = 0.0;
+	NumErr = 0u;
+	Dip    = 0.0;
+	(void)DRV_Set_SyncEna(DRV_MODE_SPEED, FALSE);
+	HT_CHECK(ERR_OK == DRV_SetMode(DRV_MODE_SPEED), "speed mode not set");
+	(void)DRV_SetSpeed(SPD, SPD);
+	PLANT_Run(1000u, Rec_Spd);
+	Plant[TACHO_ID_RIGHT].mot.load = LOAD;
+	PLANT_Run(500u, Rec_Spd);
+	Plant[TACHO_ID_RIGHT].mot.load = 0.0;
+	PLANT_Run(500u, NULL);
+	(void)DRV_Read_IsrLoad(&load, &cycMax);
+	printf("%s loop: mean speed error %.1f steps/s, dip under load %.0f steps/s, final %.0f/%.0f steps/s\n",
+			LOOP_NAME, ErrSum / NumErr, Dip, Plant[TACHO_ID_LEFT].spd, Plant[TACHO_ID_RIGHT].spd);
+	HT_CHECK(ErrSum / NumErr <= ERR_MAX, "mean speed error %.1f steps/s", ErrSum / NumErr);
+	HT_CHECK(Dip <= DIP_MAX, "dip of %.0f steps/s under load", Dip);
+	HT_CHECK(fabs(Plant[TACHO_ID_RIGHT].spd - SPD) <= SPD_TOL, "speed %.0f steps/s after the load", Plant[TACHO_ID_RIGHT].spd);
+}
+
+static void Test_Pos(void)
+{
+	Init();
+	SettleMs = -1;
+	HT_CHECK(ERR_OK == DRV_SetMode(DRV_MODE_POS), "position mode not set");
+	PLANT_Run(10u, NULL);
+	(void)DRV_SetPos(3000, -3000);
+	PLANT_Run(3000u, Rec_Settle);
+	printf("%s loop: move to 3000/-3000 settled after %d ms, final %.1f/%.1f steps\n",
+			LOOP_NAME, SettleMs, Plant[TACHO_ID_LEFT].pos, Plant[TACHO_ID_RIGHT].pos);
+	HT_CHECK((0 <= SettleMs) && (SettleMs <= SETTLE_MAX_MS), "settled after %d ms", SettleMs);
+	HT_CHECK(fabs(Plant[TACHO_ID_LEFT].pos - 3000.0) <= Get_pDrvCfg()->posSettleMargin + 1, "left wheel ends at %.1f", Plant[TACHO_ID_LEFT].pos);
+	HT_CHECK(fabs(Plant[TACHO_ID_RIGHT].pos + 3000.0) <= Get_pDrvCfg()->posSettleMargin + 1, "right wheel ends at %.1f", Plant[TACHO_ID_RIGHT].pos);
+}
+
+/* the start of the cycle counter mustn't change the drive, its timestamps are differences */
+static void Test_CycWrap(void)
+{
+	double aPos[TACHO_ID_CNT];
+
+	HT_CycCnt = 0u;
+	PLANT_Init(PLANT_MOT_NOM, PLANT_MOT_NOM);
+	(void)DRV_SetMode(DRV_MODE_SPEED);
+	(void)DRV_SetSpeed(SPD, -SPD);
+	PLANT_Run(200u, NULL);
+	aPos[TACHO_ID_LEFT]  = Plant[TACHO_ID_LEFT].pos;
+	aPos[TACHO_ID_RIGHT] = Plant[TACHO_ID_RIGHT].pos;
+	Init();
+	(void)DRV_SetMode(DRV_MODE_SPEED);
+	(void)DRV_SetSpeed(SPD, -SPD);
+	PLANT_Run(200u, NULL);
+	HT_CHECK((aPos[TACHO_ID_LEFT] == Plant[TACHO_ID_LEFT].pos) && (aPos[TACHO_ID_RIGHT] == Plant[TACHO_ID_RIGHT].pos),
+			"overflow of the cycle counter changes the positions from %.4f/%.4f to %.4f/%.4f",
+			aPos[TACHO_ID_LEFT], aPos[TACHO_ID_RIGHT], Plant[TACHO_ID_LEFT].pos, Plant[TACHO_ID_RIGHT].pos);
+}
+
+
+int main(void)
+{
+	Test_Spd();
+	Test_Pos();
+	Test_CycWrap();
+	return HT_Result();
+}
@@ -0,0 +1,190 @@
+/***********************************************************************************************//**
+ * @file		test_drv_notf.c
+ * @ingroup		test
+ * @brief 		Host tests of the task notifications of the SWC @a drv
+ *
+ * The application task and the ASW share one task notification, the keys set their bits while the
+ * drive sets the bits of its scripts and events. The test runs the model of drv_plant.c, lets a
+ * task wait for the keys like the application task does and checks that the drive notifications
+ * are received by DRV_Wait_Notf and aren't lost by the wait for the keys, nor the keys by it.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#include <string.h>
+#include "host_test.h"
+#include "drv_plant.h"
+#include "drv_api.h"
+#include "drv_cfg.h"
+
+#define RUN_MAX_MS		(3000u)
+
+static HT_Task_t ApplTask;
+static uint32_t KeyVal;
+
+/* wait for the keys of Sync_StateMachineWithISR of appl.c, it collects the key bits in KeyVal */
+static void Wait_Key(void)
+{
+	uint32_t notfVal = 0u;
+
+	HT_pCurTask = &ApplTask;
+	if(pdPASS == FRTOS1_xTaskNotifyWait(pdFALSE, KEY_NOTIFICATION_MSK, &notfVal, 0u))
+	{
+		KeyVal |= notfVal & KEY_NOTIFICATION_MSK;
+	}
+}
+
+/* runs the model until one of the drive notifications of evtMsk_ is read by the application task,
+ * a key is pressed after 100 ms */
+static uint32_t Run_Until(uint32_t evtMsk_)
+{
+	uint32_t evt = 0u, ms = 0u;
+
+	for(ms = 0u; (0u == evt) && (ms < RUN_MAX_MS); ms += DRV_SMPL_TIME_MS)
+	{
+		if(100u == ms)
+		{
+			(void)FRTOS1_xTaskNotify(&ApplTask, KEY_PRESSED_NOTIFICATION_VALUE, eSetBits);
+		}
+		PLANT_Run(DRV_SMPL_TIME_MS, NULL);
+		Wait_Key();
+		(void)DRV_Wait_Notf(evtMsk_, &evt, 0);
+	}
+	return evt;
+}
+
+static void Init(void)
+{
+	PLANT_Init(PLANT_MOT_NOM, PLANT_MOT_NOM);
+	memset(&ApplTask, 0, sizeof(ApplTask));
+	KeyVal = 0u;
+	HT_CHECK(ERR_OK == DRV_SetMode(DRV_MODE_POS), "position mode not set");
+	PLANT_Run(10u, NULL);
+}
+
+static void Test_ScrDone(void)
+{
+	const DRV_Seg_t aSeg[] = {{DRV_SEG_POS, DRV_SEG_DONE_SETTLED, 500, 500, 0u}};
+	uint32_t evt = 0u;
+
+	Init();
+	HT_pCurTask = &ApplTask;
+	HT_CHECK(ERR_OK == DRV_Start_Scr(aSeg, 1u, &ApplTask), "script not started");
+	evt = Run_Until(DRV_SCR_DONE_NOTIFICATION_VALUE | DRV_SCR_ABORT_NOTIFICATION_VALUE);
+	printf("script done: drive notification 0x%03x, key notification 0x%02x at %u ms\n",
+			(unsigned int)evt, (unsigned int)KeyVal, (unsigned int)HT_Tick);
+	HT_CHECK(DRV_SCR_DONE_NOTIFICATION_VALUE == evt, "script done not received, 0x%x", (unsigned int)evt);
+	HT_CHECK(KEY_PRESSED_NOTIFICATION_VALUE == KeyVal, "key not received, 0x%x", (unsigned int)KeyVal);
+	HT_CHECK(ERR_BUSY == DRV_Wait_Notf(DRV_NOTIFICATION_MSK, &evt, 0), "script done read twice");
+}
+
+/* the drive notification arrives together with a key, the wait for the key mustn't clear it */
+static void Test_ScrAbort(void)
+{
+	const DRV_Seg_t aSeg[] = {{DRV_SEG_POS, DRV_SEG_DONE_SETTLED, 3000, 3000, 0u}};
+	uint32_t evt = 0u;
+
+	Init();
+	HT_pCurTask = &ApplTask;
+	HT_CHECK(ERR_OK == DRV_Start_Scr(aSeg, 1u, &ApplTask), "script not started");
+	PLANT_Run(200u, NULL);
+	(void)DRV_SetPos(0, 0);
+	PLANT_Run(DRV_SMPL_TIME_MS, NULL);
+	(void)FRTOS1_xTaskNotify(&ApplTask, KEY_RELEASED_NOTIFICATION_VALUE, eSetBits);
+	Wait_Key();
+	HT_CHECK(KEY_RELEASED_NOTIFICATION_VALUE == KeyVal, "key not received, 0x%x", (unsigned int)KeyVal);
+	HT_CHECK(ERR_OK == DRV_Wait_Notf(DRV_SCR_DONE_NOTIFICATION_VALUE | DRV_SCR_ABORT_NOTIFICATION_VALUE, &evt, 0),
+			"script abort lost by the wait for the key");
+	HT_CHECK(DRV_SCR_ABORT_NOTIFICATION_VALUE == evt, "script abort not received, 0x%x", (unsigned int)evt);
+}
+
+/* a relative move is a script, it notifies its end like one, a move of nothing at once */
+static void Test_MoveRel(void)
+{
+	uint32_t evt = 0u;
+
+	Init();
+	HT_pCurTask = &ApplTask;
+	HT_CHECK(ERR_OK == DRV_MoveRel(100, 900, &ApplTask), "move not started");
+	evt = Run_Until(DRV_SCR_DONE_NOTIFICATION_VALUE | DRV_SCR_ABORT_NOTIFICATION_VALUE);
+	printf("turn by 90 deg and move by 100 mm: drive notification 0x%03x, key notification 0x%02x at %u ms\n",
+			(unsigned int)evt, (unsigned int)KeyVal, (unsigned int)HT_Tick);
+	HT_CHECK(DRV_SCR_DONE_NOTIFICATION_VALUE == evt, "move done not received, 0x%x", (unsigned int)evt);
+	HT_CHECK(KEY_PRESSED_NOTIFICATION_VALUE == KeyVal, "key not received, 0x%x", (unsigned int)KeyVal);
+	HT_CHECK(ERR_OK == DRV_MoveRel(0, 0, &ApplTask), "move of nothing not accepted");
+	HT_CHECK(ERR_OK == DRV_Wait_Notf(DRV_NOTIFICATION_MSK, &evt, 0), "move of nothing not notified");
+	HT_CHECK(DRV_SCR_DONE_NOTIFICATION_VALUE == evt, "move of nothing notified 0x%x", (unsigned int)evt);
+}
+
+/* the events of a position move and the asynchronous stop */
+static void Test_Evt(void)
+{
+	uint32_t evt = 0u, evt2 = 0u;
+
+	Init();
+	HT_pCurTask = &ApplTask;
+	HT_CHECK(ERR_OK == DRV_Reg_EvtNotf(&ApplTask, DRV_MOVE_DONE_NOTIFICATION_VALUE | DRV_TURNED_NOTIFICATION_VALUE),
+			"task not registered");
+	(void)DRV_SetPos(500, 500);
+	/* the target is reached before the loops have settled, the turn stays pending meanwhile */
+	evt = Run_Until(DRV_MOVE_DONE_NOTIFICATION_VALUE);
+	(void)DRV_Wait_Notf(DRV_TURNED_NOTIFICATION_VALUE, &evt2, 0);
+	evt |= evt2;
+	printf("move by 500 steps: drive notification 0x%03x, key notification 0x%02x at %u ms\n",
+			(unsigned int)evt, (unsigned int)KeyVal, (unsigned int)HT_Tick);
+	HT_CHECK(0u != (evt & DRV_MOVE_DONE_NOTIFICATION_VALUE), "move done not received, 0x%x", (unsigned int)evt);
+	HT_CHECK(0u != (evt & DRV_TURNED_NOTIFICATION_VALUE), "turned not received, 0x%x", (unsigned int)evt);
+	HT_CHECK(KEY_PRESSED_NOTIFICATION_VALUE == KeyVal, "key not received, 0x%x", (unsigned int)KeyVal);
+
+	/* DRV_HasTurned() holds in speed mode, which isn't a turn */
+	(void)DRV_SetPos(3000, 3000);
+	PLANT_Run(200u, NULL);
+	HT_pCurTask = &ApplTask;
+	(void)DRV_Wait_Notf(DRV_NOTIFICATION_MSK, &evt, 0);
+	(void)DRV_SetMode(DRV_MODE_SPEED);
+	(void)DRV_SetSpeed(1000, 1000);
+	PLANT_Run(200u, NULL);
+	HT_pCurTask = &ApplTask;
+	HT_CHECK(ERR_BUSY == DRV_Wait_Notf(DRV_TURNED_NOTIFICATION_VALUE, &evt, 0), "turned received in speed mode");
+
+	HT_CHECK(ERR_OK == DRV_Stop_Async(1000, &ApplTask), "stop not started");
+	evt = Run_Until(DRV_STOP_DONE_NOTIFICATION_VALUE | DRV_STOP_TIMEOUT_NOTIFICATION_VALUE);
+	printf("stop from 1000 steps/s: drive notification 0x%03x at %u ms\n", (unsigned int)evt, (unsigned int)HT_Tick);
+	HT_CHECK(DRV_STOP_DONE_NOTIFICATION_VALUE == evt, "stop done not received, 0x%x", (unsigned int)evt);
+	HT_CHECK(TRUE == DRV_IsStopped(), "robot not stopped");
+	(void)DRV_Reg_EvtNotf(&ApplTask, 0u);
+}
+
+/* a key pending during the read of the drive notifications stays pending for the wait for the keys */
+static void Test_KeyKept(void)
+{
+	uint32_t evt = 0u, notfVal = 0u;
+	TickType_t strtTick = 0u;
+
+	Init();
+	HT_pCurTask = &ApplTask;
+	(void)FRTOS1_xTaskNotify(&ApplTask, KEY_PRESSED_LONG_NOTIFICATION_VALUE, eSetBits);
+	strtTick = HT_Tick;
+	HT_CHECK(ERR_BUSY == DRV_Wait_Notf(DRV_NOTIFICATION_MSK, &evt, 50), "drive notification without script");
+	HT_CHECK(0u == evt, "drive notification 0x%x without script", (unsigned int)evt);
+	HT_CHECK(50u == HT_Tick - strtTick, "wait returned after %u ms instead of 50 ms", (unsigned int)(HT_Tick - strtTick));
+	HT_CHECK(pdPASS == FRTOS1_xTaskNotifyWait(pdFALSE, KEY_NOTIFICATION_MSK, &notfVal, 0u), "key lost by the drive wait");
+	HT_CHECK(KEY_PRESSED_LONG_NOTIFICATION_VALUE == (notfVal & KEY_NOTIFICATION_MSK), "key 0x%x instead of 0x%x",
+			(unsigned int)notfVal, KEY_PRESSED_LONG_NOTIFICATION_VALUE);
+	HT_CHECK(ERR_PARAM_ADDRESS == DRV_Wait_Notf(DRV_NOTIFICATION_MSK, NULL, 0), "invalid address accepted");
+}
+
+
+int main(void)
+{
+	Test_ScrDone();
+	Test_ScrAbort();
+	Test_MoveRel();
+	Test_Evt();
+	Test_KeyKept();
+	return HT_Result();
+}
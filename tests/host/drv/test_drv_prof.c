@@ -0,0 +1,191 @@
+/***********************************************************************************************//**
+ * @file		test_drv_prof.c
+ * @ingroup		test
+ * @brief 		Host tests of the motion profile generator and the position loops of the SWC @a drv
+ *
+ * Runs the trapezoidal and the S-curve profile of drv_prof.c alone and checks the speed,
+ * acceleration and jerk limits of drv_cfg.c, that each profile ends exactly at its target and that
+ * a new target is taken over from the running profile, including a reversal. Then moves the model
+ * of drv_plant.c by the position loops and reports the settle time and the overshoot.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#include <stdlib.h>
+#include <math.h>
+#include "host_test.h"
+#include "drv_plant.h"
+#include "drv_api.h"
+#include "drv_cfg.h"
+#include "drv_prof.h"
+
+#define N_SMPL_MAX		(4000)
+
+typedef struct
+{
+	int32_t spdMax;		/* maximum speed in steps/sec */
+	int32_t accMax;		/* maximum change of the speed per sample in steps/sec */
+	int32_t jerkMax;	/* maximum change of the acceleration per sample in steps/sec */
+	int32_t posMin;		/* lowest and highest position reference */
+	int32_t posMax;
+	int n;				/* samples until the profile is done */
+} ProfStat_t;
+
+/* runs the profile until it is done, retargets it to trgt2_ after n2_ samples if n2_ > 0 */
+static ProfStat_t Run_Prof(DRV_Prof_t *pProf_, int32_t trgt_, int n2_, int32_t trgt2_)
+{
+	ProfStat_t st = {0, 0, 0, INT32_MAX, INT32_MIN, 0};
+	int32_t spd = DRV_Prof_Get_Spd(pProf_), acc = 0, prevAcc = 0, pos = 0;
+	int k = 0;
+
+	DRV_Prof_Set_Trgt(pProf_, trgt_);
+	for(k = 0; (k < N_SMPL_MAX) && ((0 == k) || !DRV_Prof_Is_Done(pProf_)); k++)
+	{
+		if((0 < n2_) && (k == n2_))
+		{
+			DRV_Prof_Set_Trgt(pProf_, trgt2_);
+		}
+		DRV_Prof_Step(pProf_);
+		pos = DRV_Prof_Get_Pos(pProf_);
+		acc = DRV_Prof_Get_Spd(pProf_) - spd;
+		spd += acc;
+		st.spdMax  = (abs(spd) > st.spdMax) ? abs(spd) : st.spdMax;
+		st.accMax  = (abs(acc) > st.accMax) ? abs(acc) : st.accMax;
+		st.jerkMax = (abs(acc - prevAcc) > st.jerkMax) ? abs(acc - prevAcc) : st.jerkMax;
+		st.posMin  = (pos < st.posMin) ? pos : st.posMin;
+		st.posMax  = (pos > st.posMax) ? pos : st.posMax;
+		prevAcc = acc;
+	}
+	st.n = k;
+	return st;
+}
+
+static void Test_Prof(void)
+{
+	static const int32_t aTrgt[] = {1, 37, 500, 3000, 20000, -7000};
+	DRV_Cfg_t cfg = *Get_pDrvCfg();
+	DRV_Prof_t prof;
+	ProfStat_t st;
+	int32_t jerkLim = 0;
+	unsigned int i = 0u;
+	int type = 0;
+
+	for(type = DRV_PROF_TRAPEZ; type <= DRV_PROF_SCURVE; type++)
+	{
+		cfg.posProf = (DRV_ProfType_t)type;
+		for(i = 0u; i < sizeof(aTrgt)/sizeof(aTrgt[0]); i++)
+		{
+			DRV_Prof_Init(&prof, &cfg, 0, 0);
+			st = Run_Prof(&prof, aTrgt[i], 0, 0);
+			/* the trapezoidal profile steps the acceleration, the S-curve ramps it over its window.
+			 * Without cruise phase the acceleration of a short move swaps its sign, which doubles the
+			 * jerk of the S-curve. */
+			jerkLim = (DRV_PROF_TRAPEZ == type) ? 2 * cfg.posAccMax : (2 * cfg.posAccMax) / prof.winLen + 1;
+			printf("%s to %6d: %4d ms, speed %4d, acc %2d, jerk %3d per sample, range %d..%d\n",
+					(DRV_PROF_TRAPEZ == type) ? "trapez" : "scurve", aTrgt[i], st.n * (int)DRV_SMPL_TIME_MS,
+					st.spdMax, st.accMax, st.jerkMax, st.posMin, st.posMax);
+			HT_CHECK(st.n < N_SMPL_MAX, "profile to %d not done", aTrgt[i]);
+			HT_CHECK(aTrgt[i] == DRV_Prof_Get_Pos(&prof), "profile ends at %d instead of %d", DRV_Prof_Get_Pos(&prof), aTrgt[i]);
+			HT_CHECK(0 == DRV_Prof_Get_Spd(&prof), "profile ends at speed %d", DRV_Prof_Get_Spd(&prof));
+			HT_CHECK(st.spdMax <= cfg.posSpdMax, "speed %d exceeds %d", st.spdMax, cfg.posSpdMax);
+			HT_CHECK(st.accMax <= cfg.posAccMax + 1, "acceleration %d exceeds %d", st.accMax, cfg.posAccMax);
+			HT_CHECK(st.jerkMax <= jerkLim, "jerk %d exceeds %d", st.jerkMax, jerkLim);
+			HT_CHECK((st.posMin >= ((aTrgt[i] < 0) ? aTrgt[i] : 0)) && (st.posMax <= ((aTrgt[i] > 0) ? aTrgt[i] : 0)),
+					"profile to %d overshoots to %d..%d", aTrgt[i], st.posMin, st.posMax);
+		}
+		/* shorter target while cruising, then a reversal from full speed */
+		DRV_Prof_Init(&prof, &cfg, 0, 0);
+		st = Run_Prof(&prof, 20000, 200, 2500);
+		printf("%s retarget 20000 -> 2500 after 1 s: %d ms, range %d..%d\n",
+				(DRV_PROF_TRAPEZ == type) ? "trapez" : "scurve", st.n * (int)DRV_SMPL_TIME_MS, st.posMin, st.posMax);
+		HT_CHECK(2500 == DRV_Prof_Get_Pos(&prof), "retarget ends at %d", DRV_Prof_Get_Pos(&prof));
+		HT_CHECK(st.accMax <= cfg.posAccMax + 1, "acceleration %d exceeds %d on retarget", st.accMax, cfg.posAccMax);
+		DRV_Prof_Init(&prof, &cfg, 0, 0);
+		st = Run_Prof(&prof, 20000, 200, -1000);
+		printf("%s reversal 20000 -> -1000 after 1 s: %d ms, range %d..%d\n",
+				(DRV_PROF_TRAPEZ == type) ? "trapez" : "scurve", st.n * (int)DRV_SMPL_TIME_MS, st.posMin, st.posMax);
+		HT_CHECK(-1000 == DRV_Prof_Get_Pos(&prof), "reversal ends at %d", DRV_Prof_Get_Pos(&prof));
+		HT_CHECK(st.accMax <= cfg.posAccMax + 1, "acceleration %d exceeds %d on reversal", st.accMax, cfg.posAccMax);
+		HT_CHECK(st.posMin == -1000, "reversal overshoots to %d", st.posMin);
+		/* start from a moving wheel */
+		DRV_Prof_Init(&prof, &cfg, 100, -1500);
+		st = Run_Prof(&prof, 100, 0, 0);
+		printf("%s from -1500 steps/s back to the start: %d ms, range %d..%d\n",
+				(DRV_PROF_TRAPEZ == type) ? "trapez" : "scurve", st.n * (int)DRV_SMPL_TIME_MS, st.posMin, st.posMax);
+		HT_CHECK(100 == DRV_Prof_Get_Pos(&prof), "profile from speed ends at %d", DRV_Prof_Get_Pos(&prof));
+		HT_CHECK(st.accMax <= cfg.posAccMax + 1, "acceleration %d exceeds %d from speed", st.accMax, cfg.posAccMax);
+	}
+}
+
+
+/*======================================== closed loop ===========================================*/
+static double aPeak[TACHO_ID_CNT];
+static int32_t aTrgt[TACHO_ID_CNT];
+static int32_t SettleMs;
+
+static void Rec_Move(void)
+{
+	int i = 0;
+
+	for(i = 0; i < TACHO_ID_CNT; i++)
+	{
+		/* overshoot in the direction of the move */
+		double pos = (0 <= aTrgt[i]) ? Plant[i].pos : -Plant[i].pos;
+		aPeak[i] = (pos > aPeak[i]) ? pos : aPeak[i];
+	}
+	if((0 > SettleMs) && DRV_IsStopped())
+	{
+		SettleMs = (int32_t)HT_Tick;
+	}
+}
+
+static void Move(int32_t trgtLe_, int32_t trgtRi_, int32_t settleMaxMs_)
+{
+	double aOvs[TACHO_ID_CNT];
+	int i = 0;
+
+	PLANT_Init(PLANT_MOT_NOM, PLANT_MOT_NOM);
+	aTrgt[TACHO_ID_LEFT]  = trgtLe_;
+	aTrgt[TACHO_ID_RIGHT] = trgtRi_;
+	aPeak[TACHO_ID_LEFT]  = aPeak[TACHO_ID_RIGHT] = 0.0;
+	SettleMs = -1;
+	HT_CHECK(ERR_OK == DRV_SetMode(DRV_MODE_POS), "position mode not set");
+	PLANT_Run(10u, NULL);
+	HT_CHECK(ERR_OK == DRV_SetPos(trgtLe_, trgtRi_), "target not set");
+	PLANT_Run(5000u, Rec_Move);
+	for(i = 0; i < TACHO_ID_CNT; i++)
+	{
+		aOvs[i] = aPeak[i] - abs(aTrgt[i]);
+	}
+	printf("move to %5d/%5d: settled after %4d ms, overshoot %.1f/%.1f, final %.1f/%.1f steps\n",
+			trgtLe_, trgtRi_, SettleMs, aOvs[TACHO_ID_LEFT], aOvs[TACHO_ID_RIGHT],
+			Plant[TACHO_ID_LEFT].pos, Plant[TACHO_ID_RIGHT].pos);
+	HT_CHECK((0 <= SettleMs) && (SettleMs <= settleMaxMs_), "settled after %d ms instead of %d ms", SettleMs, settleMaxMs_);
+	for(i = 0; i < TACHO_ID_CNT; i++)
+	{
+		HT_CHECK(fabs(Plant[i].pos - aTrgt[i]) <= Get_pDrvCfg()->posSettleMargin + 1,
+				"wheel %d ends at %.1f instead of %d", i, Plant[i].pos, aTrgt[i]);
+		HT_CHECK(aOvs[i] <= 2 * Get_pDrvCfg()->posSettleMargin, "wheel %d overshoots by %.1f", i, aOvs[i]);
+	}
+}
+
+static void Test_Move(void)
+{
+	/* the settle time is the S-curve profile plus the dwell time of 100 ms plus 50 ms */
+	Move(500, 500, 610);
+	Move(3000, 1500, 1860);
+	Move(3000, -3000, 1860);
+	Move(-7346, -7346, 4050);
+}
+
+
+int main(void)
+{
+	Test_Prof();
+	Test_Move();
+	return HT_Result();
+}
@@ -0,0 +1,147 @@
+/***********************************************************************************************//**
+ * @file		test_drv_sync.c
+ * @ingroup		test
+ * @brief 		Host tests of the synchronization of the wheels of the SWC @a drv
+ *
+ * Drives the model of drv_plant.c with two unequal motors straight ahead, with and without the
+ * cross-coupled synchronization: the left motor has 15% less gain and is slower, the right one
+ * has more friction. Reports the heading of the robot after 1 m in speed mode, after a move of
+ * 1 m in position mode and after the right wheel was blocked for 50 ms. Checks that the limited
+ * error keeps its sign while a blocked wheel falls behind its profile by far more than 2^15 steps.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#include <math.h>
+#include "host_test.h"
+#include "drv_plant.h"
+#include "drv_api.h"
+#include "drv_cfg.h"
+
+#define DIST_MM			(1000.0)
+#define SPD				(2000)
+#define MOT_LE			((PLANT_Mot_t){0.85 * 8000.0 / 0xFFFF, 0.100, 0.0, 0.0, 0})
+#define MOT_RI			((PLANT_Mot_t){8000.0 / 0xFFFF, 0.060, 120.0, 0.0, 0})
+
+static double HdgMax;
+
+static void Rec_Hdg(void)
+{
+	HdgMax = (fabs(PLANT_Hdg()) > HdgMax) ? fabs(PLANT_Hdg()) : HdgMax;
+}
+
+static void Init(DRV_Mode_t mode_, bool isSync_)
+{
+	PLANT_Init(MOT_LE, MOT_RI);
+	HdgMax = 0.0;
+	(void)DRV_Set_SyncEna(mode_, isSync_);
+	HT_CHECK(ERR_OK == DRV_SetMode(mode_), "mode %d not set", mode_);
+}
+
+/* heading in degrees after 1 m at SPD in speed mode, the right wheel is blocked for blkMs_ after
+ * 0.5 m if blkMs_ isn't 0 */
+static double Drive_Spd(bool isSync_, uint32_t blkMs_)
+{
+	Init(DRV_MODE_SPEED, isSync_);
+	(void)DRV_SetSpeed(SPD, SPD);
+	while((PLANT_Dist() < DIST_MM / 2.0) && (PlantTime < 5.0))
+	{
+		PLANT_Run(DRV_SMPL_TIME_MS, Rec_Hdg);
+	}
+	if(0u != blkMs_)
+	{
+		Plant[TACHO_ID_RIGHT].mot.isBlocked = TRUE;
+		PLANT_Run(blkMs_, Rec_Hdg);
+		Plant[TACHO_ID_RIGHT].mot.isBlocked = FALSE;
+	}
+	while((PLANT_Dist() < DIST_MM) && (PlantTime < 5.0))
+	{
+		PLANT_Run(DRV_SMPL_TIME_MS, Rec_Hdg);
+	}
+	HT_CHECK(PLANT_Dist() >= DIST_MM, "1 m not reached after 5 s");
+	return PLANT_Hdg();
+}
+
+/* heading in degrees after a move of 1 m in position mode */
+static double Drive_Pos(bool isSync_)
+{
+	int32_t trgt = (int32_t)lround(DIST_MM * PLANT_STEPS_PER_MM);
+
+	Init(DRV_MODE_POS, isSync_);
+	PLANT_Run(10u, NULL);
+	(void)DRV_SetPos(trgt, trgt);
+	PLANT_Run(5000u, Rec_Hdg);
+	HT_CHECK(TRUE == DRV_IsStopped(), "move of 1 m not settled");
+	return PLANT_Hdg();
+}
+
+static void Test_Spd(void)
+{
+	double hdgOff = Drive_Spd(FALSE, 0u), maxOff = HdgMax;
+	double hdgOn  = Drive_Spd(TRUE, 0u),  maxOn  = HdgMax;
+
+	printf("speed mode: heading after 1 m %.2f deg without, %.2f deg with synchronization (max %.2f/%.2f)\n",
+			hdgOff, hdgOn, maxOff, maxOn);
+	HT_CHECK(fabs(hdgOn) < 0.5, "heading %.2f deg after 1 m with synchronization", hdgOn);
+	HT_CHECK(fabs(hdgOn) < fabs(hdgOff) / 4.0, "synchronization reduces the heading from %.2f to %.2f deg only", hdgOff, hdgOn);
+}
+
+static void Test_Pos(void)
+{
+	double hdgOff = Drive_Pos(FALSE), maxOff = HdgMax;
+	double hdgOn  = Drive_Pos(TRUE),  maxOn  = HdgMax;
+
+	printf("position mode: heading after 1 m %.2f deg without, %.2f deg with synchronization (max %.2f/%.2f during the move)\n",
+			hdgOff, hdgOn, maxOff, maxOn);
+	/* both position loops end at their target, the synchronization keeps the robot on its line */
+	HT_CHECK(fabs(hdgOn) < 0.2, "heading %.2f deg after the move with synchronization", hdgOn);
+	HT_CHECK(maxOn < maxOff, "synchronization doesn't reduce the heading during the move, %.2f vs %.2f deg", maxOn, maxOff);
+}
+
+/* the change of the heading by the blocked wheel against the same drive without block */
+static void Test_Blk(void)
+{
+	double hdgOff = Drive_Spd(FALSE, 50u) - Drive_Spd(FALSE, 0u);
+	double hdgOn  = Drive_Spd(TRUE, 50u) - Drive_Spd(TRUE, 0u);
+
+	printf("right wheel blocked for 50 ms: heading changed by %.2f deg without, %.2f deg with synchronization\n",
+			hdgOff, hdgOn);
+	HT_CHECK(fabs(hdgOn) < 0.5, "heading changed by %.2f deg after the blocked wheel with synchronization", hdgOn);
+	HT_CHECK(fabs(hdgOn) < fabs(hdgOff) / 4.0, "synchronization recovers the heading from %.2f to %.2f deg only", hdgOff, hdgOn);
+}
+/* turn on the spot in position mode with the right wheel blocked, its profile runs away */
+static void Test_Lim(void)
+{
+	const DRV_Cfg_t *pCfg = Get_pDrvCfg();
+	int32_t err = 0, corr = 0, errMin = INT32_MAX, errMax = INT32_MIN;
+	int k;
+
+	Init(DRV_MODE_POS, TRUE);
+	Plant[TACHO_ID_RIGHT].mot.isBlocked = TRUE;
+	(void)DRV_SetPos(200000, -200000);
+	for(k = 0; k < 30000 / (int)DRV_SMPL_TIME_MS; k++)
+	{
+		PLANT_Run(DRV_SMPL_TIME_MS, NULL);
+		(void)DRV_Read_SyncErr(&err, &corr);
+		errMin = (err < errMin) ? err : errMin;
+		errMax = (err > errMax) ? err : errMax;
+	}
+	printf("right wheel blocked for 30 s: %.0f steps behind, synchronization error %d...%d steps\n",
+			Plant[TACHO_ID_LEFT].pos - Plant[TACHO_ID_RIGHT].pos, errMin, errMax);
+	HT_CHECK(Plant[TACHO_ID_LEFT].pos > 32768.0, "left wheel moved %.0f steps only", Plant[TACHO_ID_LEFT].pos);
+	HT_CHECK((0 <= errMin) && (pCfg->syncErrMax == errMax), "error %d...%d, expected 0...%d", errMin, errMax, pCfg->syncErrMax);
+}
+
+
+int main(void)
+{
+	Test_Spd();
+	Test_Pos();
+	Test_Blk();
+	Test_Lim();
+	return HT_Result();
+}
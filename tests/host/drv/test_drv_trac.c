@@ -0,0 +1,241 @@
+/***********************************************************************************************//**
+ * @file		test_drv_trac.c
+ * @ingroup		test
+ * @brief 		Host tests of the slip and stall detection of the SWC @a drv
+ *
+ * Feeds the detector of drv_trac.c with motor values and wheel speeds of a wheel, which follows
+ * the motor model of drv_cfg.c, and of a wheel, which slips, stalls and recovers. Checks the
+ * traction state after the configured number of calls, the release and the reactions. The test
+ * is built twice, as test_drv_trac with the default configuration, which only reports the state,
+ * and as test_drv_trac_rct with DRV_TRAC_RCT_INT_HOLD and DRV_TRAC_RCT_TRQ_LIM.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#include <string.h>
+#include "host_test.h"
+#include "Platform.h"
+#include "drv_api.h"
+#include "drv_cfg.h"
+#include "drv_trac.h"
+#include "mot.h"
+#include "mot_api.h"
+#include "nvm_api.h"
+#include "batt_api.h"
+#include "tacho_api.h"
+
+#define CTRL_MAX		(0xFFFF)
+#define IS_TRQ_LIM		(0u != (Get_pDrvCfg()->tracRct & DRV_TRAC_RCT_TRQ_LIM))
+#define IS_INT_HOLD		(0u != (Get_pDrvCfg()->tracRct & DRV_TRAC_RCT_INT_HOLD))
+
+static int16_t SimSpd[TACHO_ID_CNT];
+
+
+/*===================================== NVM, BATT and TACHO ======================================*/
+StdRtn_t NVM_Read_MotLinLeCfg(NVM_MotLinCfg_t *linCfg_) {(void)linCfg_; return ERR_VALUE;}
+StdRtn_t NVM_Read_MotLinRiCfg(NVM_MotLinCfg_t *linCfg_) {(void)linCfg_; return ERR_VALUE;}
+StdRtn_t NVM_Read_MotLimCfg(NVM_MotLimCfg_t *limCfg_) {(void)limCfg_; return ERR_VALUE;}
+
+StdRtn_t NVM_Read_Dflt_MotLinLeCfg(NVM_MotLinCfg_t *linCfg_)
+{
+	memset(linCfg_, 0, sizeof(*linCfg_));
+	return ERR_OK;
+}
+
+StdRtn_t NVM_Read_Dflt_MotLinRiCfg(NVM_MotLinCfg_t *linCfg_)
+{
+	memset(linCfg_, 0, sizeof(*linCfg_));
+	return ERR_OK;
+}
+
+/* no slew rate and no coast interval, the value is output at once */
+StdRtn_t NVM_Read_Dflt_MotLimCfg(NVM_MotLimCfg_t *limCfg_)
+{
+	limCfg_->slewRate = 0u;
+	limCfg_->coastMs  = 0u;
+	return ERR_OK;
+}
+
+StdRtn_t BATT_Read_FltVolt(uint16_t *cvP) {(void)cvP; return ERR_VALUE;}
+
+StdRtn_t TACHO_Read_SpdLe(int16_t *spd_) { *spd_ = SimSpd[TACHO_ID_LEFT];  return ERR_OK; }
+StdRtn_t TACHO_Read_SpdRi(int16_t *spd_) { *spd_ = SimSpd[TACHO_ID_RIGHT]; return ERR_OK; }
+
+
+/*============================================ helpers ===========================================*/
+/* motor value of the feedforward model at the speed spd_ and the change of the speed per call acc_ */
+static int32_t MdlVal(int32_t spd_, int32_t acc_)
+{
+	const DRV_Cfg_t *pCfg = Get_pDrvCfg();
+	int32_t val = (int32_t)(((int64_t)spd_ * pCfg->ffGain + (int64_t)acc_ * pCfg->ffAccGain) >> 16);
+
+	return val + ((spd_ > 0) ? pCfg->ffOffset : ((spd_ < 0) ? -pCfg->ffOffset : 0));
+}
+
+/* applies the signed motor value ctrl_ to the left wheel, the right one idles, then measures spd_ */
+static void Step(int32_t ctrl_, int32_t spd_)
+{
+	MOT_MotorDevice_t *pMot = MOT_GetMotorHandle(MOT_MOTOR_LEFT);
+	int32_t mag = (ctrl_ < 0) ? -ctrl_ : ctrl_;
+
+	MOT_SetDirection(pMot, (ctrl_ < 0) ? MOT_DIR_BACKWARD : MOT_DIR_FORWARD);
+	MOT_SetVal(pMot, (uint16_t)(CTRL_MAX - ((mag > CTRL_MAX) ? CTRL_MAX : mag)));
+	SimSpd[TACHO_ID_LEFT] = (int16_t)spd_;
+	DRV_Trac_Step();
+}
+
+static DRV_Trac_t Trac(void)
+{
+	DRV_Trac_t le = DRV_TRAC_OK, ri = DRV_TRAC_OK;
+
+	(void)DRV_Read_Trac(&le, &ri);
+	HT_CHECK(DRV_TRAC_OK == ri, "idle right wheel in state %d", ri);
+	return le;
+}
+
+/* the wheel follows the model, speeds up by acc_ per call from spd_ on for n_ calls, returns the speed */
+static int32_t Follow(int32_t spd_, int32_t acc_, unsigned n_)
+{
+	unsigned k;
+
+	for(k = 0u; k < n_; k++)
+	{
+		spd_ += acc_;
+		Step(MdlVal(spd_, acc_), spd_);
+	}
+	return spd_;
+}
+
+static void Restart(void)
+{
+	MOT_Init();
+	SimSpd[TACHO_ID_LEFT] = SimSpd[TACHO_ID_RIGHT] = 0;
+	DRV_Trac_Init();
+}
+
+
+/*============================================= tests ============================================*/
+static void Test_Follow(void)
+{
+	Restart();
+	Follow(0, 40, 50u);
+	Follow(2000, 0, 100u);
+	Follow(2000, -60, 60u);
+	HT_CHECK(DRV_TRAC_OK == Trac(), "wheel following the model in state %d", Trac());
+	HT_CHECK(CTRL_MAX == DRV_Trac_Get_CtrlMax(TACHO_ID_LEFT), "wheel following the model limited");
+	HT_CHECK(FALSE == DRV_Trac_Is_IntHold(TACHO_ID_LEFT), "wheel following the model holds the integral part");
+}
+
+/* the tyre breaks away at the speed spd_: the motor value stays, but the wheel accelerates by far
+ * more than the motor value explains */
+static void Test_Slip(int32_t spd_)
+{
+	const DRV_Cfg_t *pCfg = Get_pDrvCfg();
+	int32_t dir = (spd_ < 0) ? -1 : 1;
+	int32_t acc = dir * (int32_t)((((int64_t)2 * pCfg->slipResid) << 16) / pCfg->ffAccGain + 1);
+	int32_t spd = Follow(Follow(0, spd_ / 50, 50u), 0, 20u);
+	int32_t ctrl = MdlVal(spd, 0);
+	unsigned k;
+
+	/* one call less than the detection time is tolerated */
+	for(k = 0u; k + 1u < pCfg->slipCnt; k++)
+	{
+		spd += acc;
+		Step(ctrl, spd);
+	}
+	HT_CHECK(DRV_TRAC_OK == Trac(), "slip detected after %u calls", k);
+	spd = Follow(spd, 0, 1u);
+	for(k = 0u; k < pCfg->slipCnt; k++)
+	{
+		spd += acc;
+		Step(ctrl, spd);
+	}
+	printf("slip at %5d steps/s: state %d after %u calls, limit 0x%04x, integral hold %d\n", (int)spd_, Trac(), k,
+			(unsigned)DRV_Trac_Get_CtrlMax(TACHO_ID_LEFT), DRV_Trac_Is_IntHold(TACHO_ID_LEFT));
+	HT_CHECK(DRV_TRAC_SLIP == Trac(), "slip not detected after %u calls", k);
+	HT_CHECK((IS_TRQ_LIM ? (dir * ctrl - pCfg->slipCtrlRed) : CTRL_MAX) == DRV_Trac_Get_CtrlMax(TACHO_ID_LEFT),
+			"slipping wheel limited to 0x%04x", (unsigned)DRV_Trac_Get_CtrlMax(TACHO_ID_LEFT));
+	HT_CHECK(IS_INT_HOLD == DRV_Trac_Is_IntHold(TACHO_ID_LEFT), "integral hold of the slipping wheel wrong");
+
+	/* the tyre grips again, the state is released after the release time */
+	spd = Follow(spd, 0, pCfg->tracRlsCnt - 1u);
+	HT_CHECK(DRV_TRAC_SLIP == Trac(), "slip released before %u calls", (unsigned)pCfg->tracRlsCnt);
+	spd = Follow(spd, 0, 1u);
+	HT_CHECK(DRV_TRAC_OK == Trac(), "slip not released after %u calls", (unsigned)pCfg->tracRlsCnt);
+	HT_CHECK(CTRL_MAX == DRV_Trac_Get_CtrlMax(TACHO_ID_LEFT), "recovered wheel still limited");
+	HT_CHECK(FALSE == DRV_Trac_Is_IntHold(TACHO_ID_LEFT), "recovered wheel holds the integral part");
+}
+
+/* the wheel is blocked at ctrl_, it is released after the stall and spins up along the model */
+static void Test_Stall(int32_t ctrl_)
+{
+	const DRV_Cfg_t *pCfg = Get_pDrvCfg();
+	int32_t dir = (ctrl_ < 0) ? -1 : 1;
+	unsigned k;
+
+	Restart();
+	for(k = 0u; k + 1u < pCfg->stallCnt; k++)
+	{
+		Step(ctrl_, dir * pCfg->stallSpd);
+	}
+	HT_CHECK(DRV_TRAC_OK == Trac(), "stall detected after %u calls", k);
+	Step(ctrl_, 0);
+	printf("stall at %6d:       state %d after %u calls, limit 0x%04x, integral hold %d\n", (int)ctrl_, Trac(), k + 1u,
+			(unsigned)DRV_Trac_Get_CtrlMax(TACHO_ID_LEFT), DRV_Trac_Is_IntHold(TACHO_ID_LEFT));
+	HT_CHECK(DRV_TRAC_STALL == Trac(), "stall not detected after %u calls", k + 1u);
+	HT_CHECK(CTRL_MAX == DRV_Trac_Get_CtrlMax(TACHO_ID_LEFT), "stalled wheel limited to 0x%04x",
+			(unsigned)DRV_Trac_Get_CtrlMax(TACHO_ID_LEFT));
+	HT_CHECK(IS_INT_HOLD == DRV_Trac_Is_IntHold(TACHO_ID_LEFT), "integral hold of the stalled wheel wrong");
+
+	/* a lower motor value at standstill isn't a stall, it is released after the release time */
+	for(k = 0u; k < pCfg->tracRlsCnt; k++)
+	{
+		Step(ctrl_ / 4, 0);
+	}
+	HT_CHECK(DRV_TRAC_OK == Trac(), "stall not released after %u calls", k);
+	Follow(0, dir * 40, 50u);
+	HT_CHECK(DRV_TRAC_OK == Trac(), "recovered wheel in state %d", Trac());
+}
+
+/* a slipping wheel hits an obstacle and stalls, the stall lifts the limit of the slip */
+static void Test_SlipToStall(void)
+{
+	const DRV_Cfg_t *pCfg = Get_pDrvCfg();
+	int32_t spd = 0, ctrl = 0;
+	unsigned k;
+
+	Restart();
+	spd  = Follow(Follow(0, 30, 50u), 0, 20u);
+	ctrl = MdlVal(spd, 0);
+	for(k = 0u; k < pCfg->slipCnt; k++)
+	{
+		spd += 200;
+		Step(ctrl, spd);
+	}
+	HT_CHECK(DRV_TRAC_SLIP == Trac(), "slip not detected");
+	for(k = 0u; k < pCfg->stallCnt; k++)
+	{
+		Step(0x8000, 0);
+	}
+	HT_CHECK(DRV_TRAC_STALL == Trac(), "stall after slip not detected");
+	HT_CHECK(CTRL_MAX == DRV_Trac_Get_CtrlMax(TACHO_ID_LEFT), "stalled wheel still limited by the slip");
+	HT_CHECK(IS_INT_HOLD == DRV_Trac_Is_IntHold(TACHO_ID_LEFT), "integral hold of the stalled wheel wrong");
+}
+
+int main(void)
+{
+	printf("reactions 0x%02x of the configuration\n", (unsigned)Get_pDrvCfg()->tracRct);
+	Test_Follow();
+	Restart();
+	Test_Slip(2000);
+	Restart();
+	Test_Slip(-1500);
+	Test_Stall(0x8000);
+	Test_Stall(-0xC000);
+	Test_SlipToStall();
+	return HT_Result();
+}
@@ -0,0 +1,213 @@
+/***********************************************************************************************//**
+ * @file		test_kf.c
+ * @ingroup		test
+ * @brief 		Host tests of the innovation gate of the SWC @a kf
+ *
+ * Runs the tacho filters of kf_cfg.c on simulated wheel positions and noisy speed measurements and
+ * checks that the gate rejects single outliers, doesn't reject regular measurements and that the
+ * filter catches up with a true step of the speed which the gate rejects at first. Checks the gate
+ * comparison itself at its boundary and against a 128 bit reference.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#include "host_test.h"
+#include "Platform.h"
+#include "kf_cfg.h"
+#include "kf.h"
+#include "kf_api.h"
+#include "tacho_api.h"
+
+#define DT			(TACHO_SAMPLE_PERIOD_MS / 1000.0)
+#define SPD_SD		(141.0)		/* sqrt(R22) of kf_cfg.c */
+#define N_BENCH		(200000ul)
+
+static double SimPos = 0.0;
+static double SimSpd = 0.0;
+static double SimSpdMeas = 0.0;
+
+
+/*========================================= tacho stubs ==========================================*/
+StdRtn_t TACHO_Read_PosLe(int32_t *pos_)    { *pos_ = (int32_t)lround(SimPos); return ERR_OK; }
+StdRtn_t TACHO_Read_PosRi(int32_t *pos_)    { *pos_ = (int32_t)lround(SimPos); return ERR_OK; }
+StdRtn_t TACHO_Read_RawSpdLe(int16_t *spd_) { *spd_ = (int16_t)lround(SimSpdMeas); return ERR_OK; }
+StdRtn_t TACHO_Read_RawSpdRi(int16_t *spd_) { *spd_ = (int16_t)lround(SimSpdMeas); return ERR_OK; }
+
+
+/*============================================ helpers ===========================================*/
+static double Gauss(void)
+{
+	double u1 = HT_Uniform(1e-12, 1.0), u2 = HT_Uniform(0.0, 1.0);
+	return sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+}
+
+/* advances the simulated wheel by one sample and runs the filters, returns the estimated speed */
+static double Step(double spdMeasOffs_)
+{
+	int16_t est = 0;
+	SimPos    += SimSpd * DT;
+	SimSpdMeas = SimSpd + SPD_SD * Gauss() + spdMeasOffs_;
+	KF_Main();
+	KF_Read_i16EstdVal(&est, TACHO_ID_LEFT);
+	return (double)est;
+}
+
+static uint32_t Rejections(void)
+{
+	uint32_t cnt = 0u;
+	KF_Read_RejCntr(&cnt, TACHO_ID_LEFT);
+	return cnt;
+}
+
+static void Restart(double spd_)
+{
+	int k;
+	SimPos = 0.0;
+	SimSpd = spd_;
+	KF_Init();
+	/* settles from P0 = diag(alpha) to the steady state */
+	for(k = 0; k < 2000; k++)
+	{
+		Step(0.0);
+	}
+}
+
+
+/*============================================= tests ============================================*/
+static void Test_Steady(void)
+{
+	int k, n = 20000;
+	double err, sq = 0.0;
+	uint32_t rej0;
+
+	Restart(1500.0);
+	rej0 = Rejections();
+	for(k = 0; k < n; k++)
+	{
+		err = Step(0.0) - SimSpd;
+		sq += err * err;
+	}
+	printf("steady 1500 steps/s: rms error %.1f steps/s, %u of %d rejected\n", sqrt(sq / n), Rejections() - rej0, n);
+	/* 11 is the 99.9% quantile, the Q16.16 rounding of P is allowed to add some more */
+	HT_CHECK(Rejections() - rej0 < (uint32_t)(0.003 * n), "%u regular measurements rejected", Rejections() - rej0);
+	HT_CHECK(sqrt(sq / n) < 0.6 * SPD_SD, "rms error %.1f too large", sqrt(sq / n));
+}
+
+static void Test_Outlier(void)
+{
+	int k;
+	double before, after, maxDev = 0.0;
+	uint32_t rej0;
+
+	Restart(1500.0);
+	for(k = 0; k < 50; k++)
+	{
+		before = Step(0.0);
+		rej0   = Rejections();
+		after  = Step(5000.0);
+		HT_CHECK(Rejections() == rej0 + 1u, "outlier %d not rejected", k);
+		maxDev = fmax(maxDev, fabs(after - before));
+		Step(0.0);
+	}
+	printf("outliers of +5000 steps/s: max change of the estimate %.1f steps/s\n", maxDev);
+	HT_CHECK(maxDev < 3.0 * SPD_SD, "outliers moved the estimate by %.1f", maxDev);
+}
+
+static void Test_SpeedStep(void)
+{
+	static const double steps[] = {1000.0, 3000.0, -3000.0, 6000.0};
+	int i, k, settle;
+	double est = 0.0;
+	uint32_t rej0;
+
+	for(i = 0; i < (int)(sizeof(steps)/sizeof(steps[0])); i++)
+	{
+		Restart(0.0);
+		rej0   = Rejections();
+		SimSpd = steps[i];
+		settle = -1;
+		for(k = 0; (k < 400) && (settle < 0); k++)
+		{
+			est = Step(0.0);
+			if(fabs(est - SimSpd) < 3.0 * SPD_SD)
+			{
+				settle = k + 1;
+			}
+		}
+		printf("speed step 0 -> %5.0f steps/s: within 3 sd after %3d samples, %u rejected\n", steps[i], settle, Rejections() - rej0);
+		HT_CHECK( (settle > 0) && (settle <= (int)KF_DFLT_MAX_REJ_SEQ + 20), "step to %.0f not tracked after %d samples", steps[i], settle);
+	}
+}
+
+/* dy^2 > thld * (h P h' + r) exact in 128 bit */
+static bool Ref_IsNisGated(int32_t dym_, int64_t innVar_, fix16_t nisThld_)
+{
+	__int128 dySq = (__int128)dym_ * dym_;
+	__int128 bound = (0 < innVar_) ? (__int128)innVar_ * nisThld_ : 0;
+
+	return ( (0 < nisThld_) && (dySq > bound) ) ? TRUE : FALSE;
+}
+
+static void Test_GateBoundary(void)
+{
+	static const fix16_t thlds[] = {0x00010000, 0x00048000, 0x00190000, 0x7FFFFFFF, 1};
+	int i, k;
+	int64_t innVar;
+	int32_t dym;
+	fix16_t thld;
+	long bad = 0;
+
+	/* smallest variance which lets dy pass, one LSB less rejects */
+	for(i = 0; i < (int)(sizeof(thlds)/sizeof(thlds[0])); i++)
+	{
+		for(k = 0; k < 3; k++)
+		{
+			dym    = (0 == k) ? 0x00030000 : ((1 == k) ? -0x0123ABCD : INT32_MAX);
+			innVar = (((int64_t)dym * dym) + thlds[i] - 1) / thlds[i];
+			HT_CHECK(FALSE == KF_IsNisGated(dym, innVar, thlds[i]), "thld 0x%08x, dy 0x%08x gated at the boundary", thlds[i], dym);
+			HT_CHECK(TRUE == KF_IsNisGated(dym, innVar - 1, thlds[i]), "thld 0x%08x, dy 0x%08x passed below the boundary", thlds[i], dym);
+		}
+	}
+	HT_CHECK(FALSE == KF_IsNisGated(INT32_MAX, INT64_MAX, 0x7FFFFFFF), "saturated bound gated");
+	HT_CHECK(FALSE == KF_IsNisGated(INT32_MIN, INT64_MAX, 1), "saturated bound gated");
+	HT_CHECK(TRUE == KF_IsNisGated(1, 0, 0x00190000), "variance 0 passed");
+	HT_CHECK(TRUE == KF_IsNisGated(-1, -5, 0x00190000), "negative variance passed");
+	HT_CHECK(FALSE == KF_IsNisGated(0, 0, 0x00190000), "zero innovation gated");
+	HT_CHECK(FALSE == KF_IsNisGated(INT32_MAX, 0, 0), "thld 0 gated");
+	HT_CHECK(FALSE == KF_IsNisGated(INT32_MAX, 0, -1), "negative thld gated");
+
+	for(k = 0; k < 1000000; k++)
+	{
+		dym    = (int32_t)HT_Rand();
+		dym  >>= (HT_Rand() % 32u);
+		thld   = (fix16_t)(HT_Rand() >> (HT_Rand() % 32u));
+		innVar = (int64_t)(((uint64_t)HT_Rand() << 32) | HT_Rand()) >> (HT_Rand() % 64u);
+		bad   += (Ref_IsNisGated(dym, innVar, thld) != KF_IsNisGated(dym, innVar, thld)) ? 1 : 0;
+	}
+	printf("KF_IsNisGated: %ld of 1000000 random gates differ from the 128 bit reference\n", bad);
+	HT_CHECK(0 == bad, "%ld gates differ", bad);
+}
+
+static void Bench(void)
+{
+	double t;
+	Restart(1500.0);
+	HT_TIME(t, N_BENCH, KF_Main());
+	printf("KF_Main, two 2x2 filters: %.0f ns per call\n", t);
+}
+
+
+int main(void)
+{
+	HT_Seed(29u);
+	Test_Steady();
+	Test_Outlier();
+	Test_SpeedStep();
+	Test_GateBoundary();
+	Bench();
+	return HT_Result();
+}
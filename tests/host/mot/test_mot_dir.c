@@ -0,0 +1,194 @@
+/***********************************************************************************************//**
+ * @file		test_mot_dir.c
+ * @ingroup		test
+ * @brief 		Host tests of the direction output of the SWC @a mot
+ *
+ * Watches the direction bits and the PWM outputs of both motors while the motor values and
+ * directions are set in random order and with random limits, like the drive, the interrupt of the
+ * speed loops and the autotuner do. The direction bit may only toggle while the H-bridge is
+ * switched off, and the bridge may only drive in the direction set by MOT_SetDirection().
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#include <string.h>
+#include "host_test.h"
+#include "Platform.h"
+#include "Cpu.h"
+#include "KIN1.h"
+#include "mot.h"
+#include "mot_api.h"
+#include "nvm_api.h"
+#include "batt_api.h"
+#include "PWML.h"
+#include "PWMR.h"
+
+#define N_OPS			(200000u)
+#define CYC_PER_MS		(CPU_CORE_CLK_HZ / 1000u)
+
+/*========================================= NVM and BATT =========================================*/
+StdRtn_t NVM_Read_MotLinLeCfg(NVM_MotLinCfg_t *linCfg_) {(void)linCfg_; return ERR_VALUE;}
+StdRtn_t NVM_Read_MotLinRiCfg(NVM_MotLinCfg_t *linCfg_) {(void)linCfg_; return ERR_VALUE;}
+StdRtn_t NVM_Read_MotLimCfg(NVM_MotLimCfg_t *limCfg_) {(void)limCfg_; return ERR_VALUE;}
+
+StdRtn_t NVM_Read_Dflt_MotLinLeCfg(NVM_MotLinCfg_t *linCfg_)
+{
+	memset(linCfg_, 0, sizeof(*linCfg_));
+	return ERR_OK;
+}
+
+StdRtn_t NVM_Read_Dflt_MotLinRiCfg(NVM_MotLinCfg_t *linCfg_)
+{
+	memset(linCfg_, 0, sizeof(*linCfg_));
+	return ERR_OK;
+}
+
+StdRtn_t NVM_Read_Dflt_MotLimCfg(NVM_MotLimCfg_t *limCfg_)
+{
+	limCfg_->slewRate = 3277u;
+	limCfg_->coastMs  = 2u;
+	return ERR_OK;
+}
+
+StdRtn_t BATT_Read_FltVolt(uint16_t *cvP) {(void)cvP; return ERR_VALUE;}
+
+
+/*=========================================== outputs ============================================*/
+static MOT_MotorDevice_t *apMot[2];
+static uint8_t aDirPin[2];
+static uint16_t aRatio[2];
+static unsigned int NumToggle, NumToggleOn, NumWrongDir;
+
+/* the direction bit of the forward direction */
+static uint8_t Fwd_Pin(int side_)
+{
+	return apMot[side_]->inverted ? 0u : 1u;
+}
+
+static void Put_Dir(int side_, bool val_)
+{
+	if((uint8_t)val_ != aDirPin[side_])
+	{
+		NumToggle++;
+		NumToggleOn += (0xFFFF != aRatio[side_]) ? 1u : 0u;
+	}
+	aDirPin[side_] = (uint8_t)val_;
+}
+
+static uint8_t Set_Ratio(int side_, uint16_t ratio_)
+{
+	MOT_Direction_t dir = (Fwd_Pin(side_) == aDirPin[side_]) ? MOT_DIR_FORWARD : MOT_DIR_BACKWARD;
+
+	NumWrongDir += ((0xFFFF != ratio_) && (dir != MOT_GetDirection(apMot[side_]))) ? 1u : 0u;
+	aRatio[side_] = ratio_;
+	return ERR_OK;
+}
+
+static void Put_DirL(bool val_) {Put_Dir(0, val_);}
+static void Put_DirR(bool val_) {Put_Dir(1, val_);}
+static uint8_t Set_RatioL(uint16_t ratio_) {return Set_Ratio(0, ratio_);}
+static uint8_t Set_RatioR(uint16_t ratio_) {return Set_Ratio(1, ratio_);}
+
+static void Init(void)
+{
+	MOT_Init();
+	apMot[0] = MOT_GetMotorHandle(MOT_MOTOR_LEFT);
+	apMot[1] = MOT_GetMotorHandle(MOT_MOTOR_RIGHT);
+	aDirPin[0] = Fwd_Pin(0);
+	aDirPin[1] = Fwd_Pin(1);
+	aRatio[0] = aRatio[1] = 0xFFFF;
+	apMot[0]->DirPutVal  = Put_DirL;
+	apMot[1]->DirPutVal  = Put_DirR;
+	apMot[0]->SetRatio16 = Set_RatioL;
+	apMot[1]->SetRatio16 = Set_RatioR;
+	NumToggle = NumToggleOn = NumWrongDir = 0u;
+}
+
+
+/*============================================= tests ============================================*/
+/* full forward, then full backward with the value set before the direction like the callers did */
+static void Test_Rev(void)
+{
+	MOT_MotorDevice_t *pMot = NULL;
+	unsigned int ms = 0u;
+
+	Init();
+	pMot = apMot[0];
+	MOT_SetDirection(pMot, MOT_DIR_FORWARD);
+	MOT_SetVal(pMot, 0u);
+	for(ms = 0u; ms < 100u; ms++)
+	{
+		HT_CycCnt += CYC_PER_MS;
+		MOT_MainFct();
+	}
+	HT_CHECK((0u == aRatio[0]) && (Fwd_Pin(0) == aDirPin[0]), "not at full forward, ratio %u", aRatio[0]);
+	MOT_SetVal(pMot, 0u);
+	MOT_SetDirection(pMot, MOT_DIR_BACKWARD);
+	HT_CHECK(0u == NumToggle, "direction bit toggled at once");
+	HT_CHECK(0xFFFF == aRatio[0], "H-bridge not off during the coast interval, ratio %u", aRatio[0]);
+	for(ms = 0u; ms < 100u; ms++)
+	{
+		HT_CycCnt += CYC_PER_MS;
+		MOT_MainFct();
+	}
+	HT_CHECK((0u == aRatio[0]) && (Fwd_Pin(0) != aDirPin[0]), "not at full backward, ratio %u", aRatio[0]);
+	HT_CHECK((1u == NumToggle) && (0u == NumToggleOn), "direction bit toggled %u times, %u times with the bridge on",
+			NumToggle, NumToggleOn);
+}
+
+/* random values, directions and limits in random order */
+static void Test_Rand(void)
+{
+	MOT_MotorDevice_t *pMot = NULL;
+	unsigned int n = 0u;
+	int side = 0;
+
+	Init();
+	HT_Seed(48u);
+	for(n = 0u; n < N_OPS; n++)
+	{
+		side = (int)(HT_Rand() & 1u);
+		pMot = apMot[side];
+		switch(HT_Rand() % 8u)
+		{
+			case 0u: MOT_SetVal(pMot, (uint16_t)HT_Rand()); break;
+			case 1u: MOT_SetRawVal(pMot, (uint16_t)HT_Rand()); break;
+			case 2u: MOT_SetDirection(pMot, (HT_Rand() & 1u) ? MOT_DIR_FORWARD : MOT_DIR_BACKWARD); break;
+			case 3u: MOT_SetSpeedPercent(pMot, (MOT_SpeedPercent)((int)(HT_Rand() % 201u) - 100)); break;
+			case 4u: MOT_SetDutyQ15(pMot, (int16_t)HT_Rand()); break;
+			case 5u:
+				/* value before direction as well as direction before value */
+				if(HT_Rand() & 1u)
+				{
+					MOT_SetVal(pMot, (uint16_t)HT_Rand());
+					MOT_SetDirection(pMot, (HT_Rand() & 1u) ? MOT_DIR_FORWARD : MOT_DIR_BACKWARD);
+				}
+				else
+				{
+					MOT_SetDirection(pMot, (HT_Rand() & 1u) ? MOT_DIR_FORWARD : MOT_DIR_BACKWARD);
+					MOT_SetVal(pMot, (uint16_t)HT_Rand());
+				}
+				break;
+			case 6u: MOT_Set_Lim((HT_Rand() & 1u) ? 3277u : 0u, (uint16_t)(HT_Rand() % 4u)); break;
+			default: MOT_MainFct(); break;
+		}
+		HT_CycCnt += HT_Rand() % (3u * CYC_PER_MS);
+	}
+	printf("%u random operations: direction bit toggled %u times, %u times with the bridge on, %u outputs against the direction\n",
+			N_OPS, NumToggle, NumToggleOn, NumWrongDir);
+	HT_CHECK(0u < NumToggle, "direction bit never toggled");
+	HT_CHECK(0u == NumToggleOn, "direction bit toggled %u times with the bridge on", NumToggleOn);
+	HT_CHECK(0u == NumWrongDir, "%u outputs against the direction", NumWrongDir);
+}
+
+
+int main(void)
+{
+	Test_Rev();
+	Test_Rand();
+	return HT_Result();
+}
@@ -0,0 +1,291 @@
+/***********************************************************************************************//**
+ * @file		test_mot_lin.c
+ * @ingroup		test
+ * @brief 		Host bit-accuracy tests of the PWM linearization of the SWCs @a mot and @a atun
+ *
+ * Compares the tables of ATUN_Lin_Calc() for random duty sweeps with a reference, which rounds the
+ * exact inverse of the sweep at the same target speeds, and the interpolation of mot.c for every
+ * motor value with the exact interpolation of random tables, rounded down like the shift of mot.c.
+ * Both must match bit by bit. Finally a motor with a dead band and a nonlinear speed curve is
+ * calibrated and the deviation of its speed from a linear response is reported.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#include <math.h>
+#include <string.h>
+#include "host_test.h"
+#include "Platform.h"
+#include "mot.h"
+#include "mot_api.h"
+#include "atun_api.h"
+#include "atun_lin.h"
+#include "nvm_api.h"
+#include "batt_api.h"
+#include "PWML.h"
+
+#define N_SWEEP			(2000u)
+#define N_TBL			(200u)
+
+/*========================================= NVM and BATT =========================================*/
+/* the NVM is erased, the linearization is disabled and the limiter is off */
+StdRtn_t NVM_Read_MotLinLeCfg(NVM_MotLinCfg_t *linCfg_) {(void)linCfg_; return ERR_VALUE;}
+StdRtn_t NVM_Read_MotLinRiCfg(NVM_MotLinCfg_t *linCfg_) {(void)linCfg_; return ERR_VALUE;}
+StdRtn_t NVM_Read_MotLimCfg(NVM_MotLimCfg_t *limCfg_) {(void)limCfg_; return ERR_VALUE;}
+
+StdRtn_t NVM_Read_Dflt_MotLinLeCfg(NVM_MotLinCfg_t *linCfg_)
+{
+	memset(linCfg_, 0, sizeof(*linCfg_));
+	return ERR_OK;
+}
+
+StdRtn_t NVM_Read_Dflt_MotLinRiCfg(NVM_MotLinCfg_t *linCfg_)
+{
+	memset(linCfg_, 0, sizeof(*linCfg_));
+	return ERR_OK;
+}
+
+StdRtn_t NVM_Read_Dflt_MotLimCfg(NVM_MotLimCfg_t *limCfg_)
+{
+	limCfg_->slewRate = 0u;
+	limCfg_->coastMs  = 0u;
+	return ERR_OK;
+}
+
+StdRtn_t BATT_Read_FltVolt(uint16_t *cvP) {(void)cvP; return ERR_VALUE;}
+
+
+/*========================================= ATUN_Lin_Calc ========================================*/
+/* speed of a motor with a dead band up to dead_ and the speed curve spdMax_ * x^gamma_ above it */
+static double Mot_Spd(double duty_, double dead_, double gamma_, double spdMax_)
+{
+	double x = (duty_ / 0xFFFF - dead_) / (1.0 - dead_);
+
+	return (x > 0.0) ? spdMax_ * pow(x, gamma_) : 0.0;
+}
+
+/* the exact duty cycle at the speed spd_ of the segment k_ of the sweep, rounded */
+static uint16_t Ref_Interp(const int32_t *aSpd_, uint8_t k_, int32_t spd_)
+{
+	double duty = ATUN_Lin_Get_SweepDuty(k_);
+	double dDuty = (double)ATUN_Lin_Get_SweepDuty(k_ + 1u) - duty;
+	int32_t dSpd = aSpd_[k_ + 1u] - aSpd_[k_];
+
+	if(dSpd > 0)
+	{
+		duty += (double)(spd_ - aSpd_[k_]) * dDuty / dSpd;
+	}
+	duty = floor(duty + 0.5);
+	return (uint16_t)((duty < 0.0) ? 0.0 : ((duty > 0xFFFF) ? 0xFFFF : duty));
+}
+
+/* the table of ATUN_Lin_Calc() by the exact inverse of the monotone envelope of the sweep */
+static StdRtn_t Ref_Calc(const int32_t *aSpd_, uint16_t *aDuty_)
+{
+	int32_t aSpd[ATUN_LIN_PT_CNT], spdMax = 0, spd = 0;
+	uint8_t i = 0u, k = 0u;
+
+	for(i = 0u; i < ATUN_LIN_PT_CNT; i++)
+	{
+		spdMax  = (aSpd_[i] > spdMax) ? aSpd_[i] : spdMax;
+		aSpd[i] = spdMax;
+	}
+	if(spdMax <= 0)
+	{
+		return ERR_RANGE;
+	}
+	/* the dead band ends at 1/64 of the full speed, the points are at multiples of 1/16 */
+	spd = spdMax / 64;
+	while(aSpd[k + 1u] <= spd)
+	{
+		k++;
+	}
+	aDuty_[0] = Ref_Interp(aSpd, k, spd);
+	for(i = 1u; i < ATUN_LIN_PT_CNT - 1u; i++)
+	{
+		spd = (int32_t)floor((double)spdMax * i / (ATUN_LIN_PT_CNT - 1u));
+		while(aSpd[k + 1u] < spd)
+		{
+			k++;
+		}
+		aDuty_[i] = Ref_Interp(aSpd, k, spd);
+		aDuty_[i] = (aDuty_[i] < aDuty_[i - 1u]) ? aDuty_[i - 1u] : aDuty_[i];
+	}
+	aDuty_[ATUN_LIN_PT_CNT - 1u] = 0xFFFF;
+	return ERR_OK;
+}
+
+static void Test_Calc(void)
+{
+	int32_t aSpd[ATUN_LIN_PT_CNT];
+	uint16_t aDuty[ATUN_LIN_PT_CNT], aRef[ATUN_LIN_PT_CNT];
+	double dead = 0.0, gamma = 0.0, spdMax = 0.0, noise = 0.0;
+	unsigned int n = 0u, nDiff = 0u, nMono = 0u;
+	uint8_t i = 0u;
+
+	HT_Seed(46u);
+	for(n = 0u; n < N_SWEEP; n++)
+	{
+		dead   = HT_Uniform(0.0, 0.3);
+		gamma  = HT_Uniform(0.5, 2.0);
+		spdMax = HT_Uniform(300.0, 9000.0);
+		noise  = HT_Uniform(0.0, 0.03) * spdMax;
+		for(i = 0u; i < ATUN_LIN_PT_CNT; i++)
+		{
+			/* noise at standstill too, so the first point of the sweep may be above the dead band */
+			aSpd[i] = (int32_t)lround(Mot_Spd(ATUN_Lin_Get_SweepDuty(i), dead, gamma, spdMax) + HT_Uniform(-noise, noise));
+		}
+		HT_CHECK(ERR_OK == ATUN_Lin_Calc(aSpd, aDuty), "sweep %u rejected", n);
+		(void)Ref_Calc(aSpd, aRef);
+		if(0 != memcmp(aDuty, aRef, sizeof(aDuty)))
+		{
+			for(i = 0u; (0u == nDiff) && (i < ATUN_LIN_PT_CNT); i++)
+			{
+				if(aDuty[i] != aRef[i])
+				{
+					printf("sweep %u: point %u is %u instead of %u\n", n, i, aDuty[i], aRef[i]);
+				}
+			}
+			nDiff++;
+		}
+		for(i = 1u; i < ATUN_LIN_PT_CNT; i++)
+		{
+			nMono += (aDuty[i] < aDuty[i - 1u]) ? 1u : 0u;
+		}
+		HT_CHECK(0xFFFF == aDuty[ATUN_LIN_PT_CNT - 1u], "sweep %u: full duty cycle %u", n, aDuty[ATUN_LIN_PT_CNT - 1u]);
+	}
+	printf("ATUN_Lin_Calc: %u of %u random sweeps differ from the exact rounded inverse\n", nDiff, N_SWEEP);
+	HT_CHECK(0u == nDiff, "%u tables differ from the reference", nDiff);
+	HT_CHECK(0u == nMono, "%u points below their predecessor", nMono);
+
+	/* a motor which doesn't turn forward */
+	memset(aSpd, 0, sizeof(aSpd));
+	HT_CHECK(ERR_RANGE == ATUN_Lin_Calc(aSpd, aDuty), "standing motor accepted");
+	for(i = 0u; i < ATUN_LIN_PT_CNT; i++)
+	{
+		aSpd[i] = -(int32_t)(i * 100);
+	}
+	HT_CHECK(ERR_RANGE == ATUN_Lin_Calc(aSpd, aDuty), "backward motor accepted");
+}
+
+
+/*========================================== MOT_Lin_Val =========================================*/
+/* duty cycle of the left motor at the motor value val_ */
+static uint16_t Mot_Duty(uint16_t val_)
+{
+	MOT_SetVal(MOT_GetMotorHandle(MOT_MOTOR_LEFT), (uint16_t)(0xFFFF - val_));
+	return (uint16_t)(0xFFFF - HT_PwmlRatio);
+}
+
+/* the exact interpolation of the table, rounded down like the shift of mot.c */
+static uint16_t Ref_Lin(const uint16_t *aDuty_, uint16_t val_)
+{
+	uint32_t idx = (uint32_t)val_ >> MOT_LIN_SEG_SHIFT;
+	double frac = (double)(val_ & ((1u << MOT_LIN_SEG_SHIFT) - 1u)) / (1u << MOT_LIN_SEG_SHIFT);
+
+	return (0u == val_) ? 0u : (uint16_t)floor(aDuty_[idx] + frac * ((double)aDuty_[idx + 1u] - aDuty_[idx]));
+}
+
+static void Test_Lin(void)
+{
+	MOT_MotorDevice_t *pMot = MOT_GetMotorHandle(MOT_MOTOR_LEFT);
+	uint16_t aDuty[MOT_LIN_PT_CNT];
+	unsigned int n = 0u, nDiff = 0u, nMono = 0u;
+	uint32_t val = 0u;
+	uint16_t duty = 0u, prevDuty = 0u;
+	uint8_t i = 0u;
+
+	MOT_Init();
+	MOT_SetDirection(pMot, MOT_DIR_FORWARD);
+	for(val = 0u; val <= 0xFFFFu; val++)
+	{
+		nDiff += ((uint16_t)val != Mot_Duty((uint16_t)val)) ? 1u : 0u;
+	}
+	HT_CHECK(0u == nDiff, "%u motor values changed without table", nDiff);
+
+	HT_Seed(4646u);
+	for(n = 0u; n < N_TBL; n++)
+	{
+		/* monotone tables with a dead band, the last ones are random and may decrease */
+		aDuty[0] = (uint16_t)(HT_Rand() % 0x4000u);
+		for(i = 1u; i < MOT_LIN_PT_CNT; i++)
+		{
+			aDuty[i] = (n < N_TBL - 10u)
+				? (uint16_t)(aDuty[i - 1u] + HT_Rand() % ((0xFFFFu - aDuty[i - 1u]) / (MOT_LIN_PT_CNT - i) + 1u))
+				: (uint16_t)HT_Rand();
+		}
+		aDuty[MOT_LIN_PT_CNT - 1u] = (n < N_TBL - 10u) ? 0xFFFF : aDuty[MOT_LIN_PT_CNT - 1u];
+		(void)MOT_Set_LinTbl(pMot, aDuty);
+		prevDuty = 0u;
+		for(val = 0u; val <= 0xFFFFu; val++)
+		{
+			duty = Mot_Duty((uint16_t)val);
+			if(Ref_Lin(aDuty, (uint16_t)val) != duty)
+			{
+				if(0u == nDiff)
+				{
+					printf("table %u: motor value %u yields %u instead of %u\n", n, (unsigned int)val, duty, Ref_Lin(aDuty, (uint16_t)val));
+				}
+				nDiff++;
+			}
+			nMono += ((n < N_TBL - 10u) && (1u < val) && (duty < prevDuty)) ? 1u : 0u;
+			prevDuty = duty;
+		}
+	}
+	printf("MOT_Lin_Val: %u of %u motor values differ from the exact interpolation\n", nDiff, N_TBL * 0x10000u);
+	HT_CHECK(0u == nDiff, "%u motor values differ from the reference", nDiff);
+	HT_CHECK(0u == nMono, "%u motor values decrease the duty cycle", nMono);
+	(void)MOT_Set_LinTbl(pMot, NULL);
+}
+
+
+/*======================================== linear response =======================================*/
+/* maximum deviation of the speed from the linear response over all motor values */
+static double Dev_Max(double dead_, double gamma_, double spdMax_)
+{
+	double dev = 0.0, spd = 0.0;
+	uint32_t val = 0u;
+
+	for(val = 1u; val <= 0xFFFFu; val += 7u)
+	{
+		spd = Mot_Spd(Mot_Duty((uint16_t)val), dead_, gamma_, spdMax_);
+		dev = (fabs(spd - spdMax_ * val / 0xFFFF) > dev) ? fabs(spd - spdMax_ * val / 0xFFFF) : dev;
+	}
+	return dev;
+}
+
+static void Test_Resp(void)
+{
+	MOT_MotorDevice_t *pMot = MOT_GetMotorHandle(MOT_MOTOR_LEFT);
+	int32_t aSpd[ATUN_LIN_PT_CNT];
+	uint16_t aDuty[ATUN_LIN_PT_CNT];
+	double devOff = 0.0, devOn = 0.0;
+	uint8_t i = 0u;
+
+	for(i = 0u; i < ATUN_LIN_PT_CNT; i++)
+	{
+		aSpd[i] = (int32_t)lround(Mot_Spd(ATUN_Lin_Get_SweepDuty(i), 0.15, 1.6, 8000.0));
+	}
+	(void)ATUN_Lin_Calc(aSpd, aDuty);
+	(void)MOT_Set_LinTbl(pMot, NULL);
+	devOff = Dev_Max(0.15, 1.6, 8000.0);
+	(void)MOT_Set_LinTbl(pMot, aDuty);
+	devOn = Dev_Max(0.15, 1.6, 8000.0);
+	printf("dead band 15%%, speed ~ duty^1.6: deviation from the linear response %.0f steps/s without, %.0f steps/s with table\n",
+			devOff, devOn);
+	HT_CHECK(devOn < devOff / 4.0, "table reduces the deviation from %.0f to %.0f steps/s only", devOff, devOn);
+	(void)MOT_Set_LinTbl(pMot, NULL);
+}
+
+
+int main(void)
+{
+	Test_Calc();
+	Test_Lin();
+	Test_Resp();
+	return HT_Result();
+}
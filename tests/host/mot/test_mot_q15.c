@@ -0,0 +1,181 @@
+/***********************************************************************************************//**
+ * @file		test_mot_q15.c
+ * @ingroup		test
+ * @brief 		Host tests and benchmarks of the percent and Q15 conversions of the SWC @a mot
+ *
+ * Checks that the reciprocal multiplications of MOT_SetSpeedPercent and MOT_UpdatePercent are
+ * bit-exact to the divisions they replaced for every percent and every motor value, that
+ * MOT_SetDutyQ15 is exact to the rounded division for every Q15 duty and that every duty reads
+ * back unchanged by MOT_GetDutyQ15. Compares the time per call against the divisions.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#include <string.h>
+#include "host_test.h"
+#include "Platform.h"
+#include "mot.h"
+#include "mot_api.h"
+#include "nvm_api.h"
+#include "batt_api.h"
+
+#define N_BENCH			(20000000ul)
+
+/*========================================= NVM and BATT =========================================*/
+StdRtn_t NVM_Read_MotLinLeCfg(NVM_MotLinCfg_t *linCfg_) {(void)linCfg_; return ERR_VALUE;}
+StdRtn_t NVM_Read_MotLinRiCfg(NVM_MotLinCfg_t *linCfg_) {(void)linCfg_; return ERR_VALUE;}
+StdRtn_t NVM_Read_MotLimCfg(NVM_MotLimCfg_t *limCfg_) {(void)limCfg_; return ERR_VALUE;}
+
+StdRtn_t NVM_Read_Dflt_MotLinLeCfg(NVM_MotLinCfg_t *linCfg_)
+{
+	memset(linCfg_, 0, sizeof(*linCfg_));
+	return ERR_OK;
+}
+
+StdRtn_t NVM_Read_Dflt_MotLinRiCfg(NVM_MotLinCfg_t *linCfg_)
+{
+	memset(linCfg_, 0, sizeof(*linCfg_));
+	return ERR_OK;
+}
+
+/* no slew rate and no coast interval, the value is output at once */
+StdRtn_t NVM_Read_Dflt_MotLimCfg(NVM_MotLimCfg_t *limCfg_)
+{
+	limCfg_->slewRate = 0u;
+	limCfg_->coastMs  = 0u;
+	return ERR_OK;
+}
+
+StdRtn_t BATT_Read_FltVolt(uint16_t *cvP) {(void)cvP; return ERR_VALUE;}
+
+
+/*========================================== references ==========================================*/
+/* MOT_SetSpeedPercent and MOT_UpdatePercent with the divisions of the original implementation */
+static void Ref_SetSpeedPercent(MOT_MotorDevice_t *motor, MOT_SpeedPercent percent)
+{
+	uint32_t val;
+
+	if (percent>100) {
+		percent = 100;
+	} else if (percent<-100) {
+		percent = -100;
+	}
+	motor->currSpeedPercent = percent;
+	if (percent<0) {
+		MOT_SetDirection(motor, MOT_DIR_BACKWARD);
+		percent = -percent;
+	} else {
+		MOT_SetDirection(motor, MOT_DIR_FORWARD);
+	}
+	val = ((100-percent)*0xffff)/100;
+	MOT_SetVal(motor, (uint16_t)val);
+}
+
+static void Ref_UpdatePercent(MOT_MotorDevice_t *motor, MOT_Direction_t dir)
+{
+	motor->currSpeedPercent = ((0xffff-motor->currPWMvalue)*100)/0xffff;
+	if (dir==MOT_DIR_BACKWARD) {
+		motor->currSpeedPercent = -motor->currSpeedPercent;
+	}
+}
+
+/* motor value of the Q15 duty rounded to the nearest, the H-bridge is low active */
+static uint16_t Ref_Q15ToVal(int32_t duty_)
+{
+	uint32_t mag = (uint32_t)((0 > duty_) ? -duty_ : duty_);
+
+	return (uint16_t)(0xFFFFu - (mag * 0xFFFFu + 0x4000u) / 0x8000u);
+}
+
+
+/*============================================= tests ============================================*/
+static MOT_MotorDevice_t *pMot;
+
+static void Init(void)
+{
+	MOT_Init();
+	pMot = MOT_GetMotorHandle(MOT_MOTOR_LEFT);
+}
+
+static void Test_Percent(void)
+{
+	int32_t percent = 0, val = 0;
+	uint16_t valRef = 0u;
+	MOT_SpeedPercent percentRef = 0;
+	long bad = 0;
+
+	Init();
+	for(percent = -120; percent <= 120; percent++)
+	{
+		Ref_SetSpeedPercent(pMot, (MOT_SpeedPercent)percent);
+		valRef = MOT_GetVal(pMot);
+		percentRef = MOT_GetSpeedPercent(pMot);
+		MOT_SetSpeedPercent(pMot, (MOT_SpeedPercent)percent);
+		bad += ((valRef != MOT_GetVal(pMot)) || (percentRef != MOT_GetSpeedPercent(pMot))) ? 1 : 0;
+	}
+	printf("MOT_SetSpeedPercent: %ld of 241 percents differ from the division\n", bad);
+	HT_CHECK(0 == bad, "%ld percents differ", bad);
+
+	bad = 0;
+	for(val = 0; val <= 0xFFFF; val++)
+	{
+		MOT_SetVal(pMot, (uint16_t)val);
+		Ref_UpdatePercent(pMot, MOT_DIR_BACKWARD);
+		percentRef = MOT_GetSpeedPercent(pMot);
+		MOT_UpdatePercent(pMot, MOT_DIR_BACKWARD);
+		bad += (percentRef != MOT_GetSpeedPercent(pMot)) ? 1 : 0;
+	}
+	printf("MOT_UpdatePercent: %ld of 65536 values differ from the division\n", bad);
+	HT_CHECK(0 == bad, "%ld values differ", bad);
+}
+
+static void Test_Q15(void)
+{
+	int32_t duty = 0;
+	long badVal = 0, badRd = 0;
+
+	Init();
+	for(duty = -32768; duty <= 32767; duty++)
+	{
+		MOT_SetDutyQ15(pMot, (int16_t)duty);
+		badVal += (Ref_Q15ToVal(duty) != MOT_GetVal(pMot)) ? 1 : 0;
+		badRd  += (duty != MOT_GetDutyQ15(pMot)) ? 1 : 0;
+	}
+	printf("MOT_SetDutyQ15: %ld of 65536 duties differ from the division, %ld don't read back\n", badVal, badRd);
+	HT_CHECK(0 == badVal, "%ld duties differ from the division", badVal);
+	HT_CHECK(0 == badRd, "%ld duties don't read back", badRd);
+	MOT_SetDutyQ15(pMot, -32768);
+	HT_CHECK((0u == MOT_GetVal(pMot)) && (MOT_DIR_BACKWARD == MOT_GetDirection(pMot)) && (-100 == MOT_GetSpeedPercent(pMot)),
+			"duty -1.0 gives 0x%04x at %d %%", MOT_GetVal(pMot), MOT_GetSpeedPercent(pMot));
+}
+
+static void Bench(void)
+{
+	static volatile int32_t sink;
+	(void)sink;
+	double tSetRef, tSet, tUpdRef, tUpd, tQ15;
+
+	Init();
+	HT_TIME(tSetRef, N_BENCH, (Ref_SetSpeedPercent(pMot, (MOT_SpeedPercent)(ht_i_ % 201u) - 100), sink = MOT_GetVal(pMot)));
+	HT_TIME(tSet,    N_BENCH, (MOT_SetSpeedPercent(pMot, (MOT_SpeedPercent)(ht_i_ % 201u) - 100), sink = MOT_GetVal(pMot)));
+	HT_TIME(tUpdRef, N_BENCH, (pMot->currPWMvalue = (uint16_t)ht_i_, Ref_UpdatePercent(pMot, MOT_DIR_FORWARD),
+								sink = MOT_GetSpeedPercent(pMot)));
+	HT_TIME(tUpd,    N_BENCH, (pMot->currPWMvalue = (uint16_t)ht_i_, MOT_UpdatePercent(pMot, MOT_DIR_FORWARD),
+								sink = MOT_GetSpeedPercent(pMot)));
+	HT_TIME(tQ15,    N_BENCH, (MOT_SetDutyQ15(pMot, (int16_t)ht_i_), sink = MOT_GetDutyQ15(pMot)));
+	printf("time per call [ns]: SetSpeedPercent %.1f/%.1f, UpdatePercent %.1f/%.1f (division/reciprocal), "
+			"SetDutyQ15 and GetDutyQ15 %.1f\n", tSetRef, tSet, tUpdRef, tUpd, tQ15);
+}
+
+
+int main(void)
+{
+	Test_Percent();
+	Test_Q15();
+	Bench();
+	return HT_Result();
+}
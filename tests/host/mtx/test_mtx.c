@@ -0,0 +1,365 @@
+/***********************************************************************************************//**
+ * @file		test_mtx.c
+ * @ingroup		test
+ * @brief 		Host tests of the matrix views of the SWC @a mtx
+ *
+ * Checks the alias detection of the views and the decompositions and the solver, which work on
+ * the views in place, against double precision references on random matrices of up to 6x6.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#include <string.h>
+#include "host_test.h"
+#include "Platform.h"
+#include "mtx_api.h"
+
+#define N_MAX		(6)
+#define N_RAND		(200)
+
+
+/*============================================= helpers ==========================================*/
+static void ToFix(MTX_t *dest_, const double *src_)
+{
+	uint8_t r, c;
+	for(r = 0u; r < dest_->rows; r++)
+	{
+		for(c = 0u; c < dest_->columns; c++)
+		{
+			MTX_AT(dest_, r, c) = fix16_from_dbl(src_[r*dest_->columns + c]);
+		}
+	}
+}
+
+static double At(const MTX_t *mtx_, uint8_t r_, uint8_t c_)
+{
+	return fix16_to_dbl(MTX_AT(mtx_, r_, c_));
+}
+
+/* random matrix with entries in [-amp_, amp_) */
+static void RandMtx(double *dest_, int rows_, int cols_, double amp_)
+{
+	int i;
+	for(i = 0; i < rows_*cols_; i++)
+	{
+		dest_[i] = HT_Uniform(-amp_, amp_);
+	}
+}
+
+/* random symmetric positive definite matrix M*M' + n*I with entries of M in [-amp_, amp_) */
+static void RandSpd(double *dest_, int n_, double amp_)
+{
+	double m[N_MAX*N_MAX];
+	int i, j, k;
+	RandMtx(m, n_, n_, amp_);
+	for(i = 0; i < n_; i++)
+	{
+		for(j = 0; j < n_; j++)
+		{
+			dest_[i*n_ + j] = (i == j) ? n_ : 0.0;
+			for(k = 0; k < n_; k++)
+			{
+				dest_[i*n_ + j] += m[i*n_ + k] * m[j*n_ + k];
+			}
+		}
+	}
+}
+
+
+/*============================================== tests ===========================================*/
+static void Test_Alias(void)
+{
+	fix16_t buf[16] = {0};
+	MTX_t full = MTX_VIEW_INIT(4u, 4u, buf);
+	MTX_t left = {4u, 2u, 4u, 0u, &buf[0]};			/* columns 0..1 of full */
+	MTX_t right = {4u, 2u, 4u, 0u, &buf[2]};		/* columns 2..3 of full, interleaved with left */
+	MTX_t top = {2u, 4u, 4u, 0u, &buf[0]};			/* rows 0..1 */
+	MTX_t bottom = {2u, 4u, 4u, 0u, &buf[8]};		/* rows 2..3 */
+	MTX_t shifted = {2u, 4u, 4u, 0u, &buf[4]};		/* rows 1..2, overlaps top and bottom */
+	MTX_t compact = MTX_VIEW_INIT(2u, 2u, &buf[1]);	/* stride 2 inside row 0 of full */
+	MTX_t empty = MTX_VIEW_INIT(0u, 0u, NULL);
+	fix16_t a[4] = {1<<16, 2<<16, 3<<16, 4<<16}, b[4] = {0};
+	MTX_t ma = MTX_VIEW_INIT(2u, 2u, a), mb = MTX_VIEW_INIT(2u, 2u, b);
+
+	HT_CHECK(MTX_IS_ALIAS(&full, &left) && MTX_IS_ALIAS(&left, &full), "subview not detected");
+	HT_CHECK(MTX_IS_ALIAS(&left, &right), "interleaved views have to be reported as alias");
+	HT_CHECK(!MTX_IS_ALIAS(&top, &bottom), "disjoint row blocks reported as alias");
+	HT_CHECK(MTX_IS_ALIAS(&top, &shifted) && MTX_IS_ALIAS(&bottom, &shifted), "partial overlap not detected");
+	HT_CHECK(MTX_IS_ALIAS(&compact, &top), "overlap with different strides not detected");
+	HT_CHECK(!MTX_IS_ALIAS(&empty, &full), "empty view reported as alias");
+	HT_CHECK(MTX_IS_SAME(&full, &top) && !MTX_IS_SAME(&full, &shifted), "same view check");
+
+	/* products reject any overlap, also if the start addresses differ */
+	MTX_Mult(&shifted, &top, &full);
+	HT_CHECK(shifted.errors & FIXMATRIX_USEERR, "Mult with partially overlapping dest_ not rejected");
+	MTX_Mult(&mb, &ma, &ma);
+	HT_CHECK((0u == mb.errors) && (MTX_AT(&mb, 1, 1) == (22<<16)), "Mult on disjoint views failed");
+
+	/* element-wise operations work in place on the same view only */
+	MTX_Add(&ma, &ma, &ma);
+	HT_CHECK((0u == ma.errors) && (MTX_AT(&ma, 1, 0) == (6<<16)), "Add in place failed");
+	MTX_Add(&shifted, &top, &bottom);
+	HT_CHECK(shifted.errors & FIXMATRIX_USEERR, "Add with partially overlapping dest_ not rejected");
+	MTX_Sub(&bottom, &top, &shifted);
+	HT_CHECK(bottom.errors & FIXMATRIX_USEERR, "Sub with partially overlapping operand not rejected");
+	MTX_MultScalar(&shifted, &top, fix16_one);
+	HT_CHECK(shifted.errors & FIXMATRIX_USEERR, "MultScalar with partially overlapping dest_ not rejected");
+	MTX_Copy(&shifted, &top);
+	HT_CHECK(shifted.errors & FIXMATRIX_USEERR, "Copy with partially overlapping dest_ not rejected");
+	MTX_Copy(&bottom, &top);
+	HT_CHECK(0u == bottom.errors, "Copy on disjoint views failed");
+
+	/* in place transpose needs a square matrix and the same view */
+	MTX_Transpose(&ma, &ma);
+	HT_CHECK((0u == ma.errors) && (MTX_AT(&ma, 0, 1) == (6<<16)) && (MTX_AT(&ma, 1, 0) == (4<<16)), "Transpose in place failed");
+	MTX_Transpose(&compact, &ma);
+	HT_CHECK(0u == compact.errors, "Transpose on disjoint views failed");
+	MTX_Transpose(&compact, &left);
+	HT_CHECK(compact.errors & (FIXMATRIX_USEERR | FIXMATRIX_DIMERR), "Transpose with overlapping views not rejected");
+}
+
+static void Test_Append(void)
+{
+	fix16_t buf[12] = {0};
+	fix16_t bb[2] = {7<<16, 8<<16};
+	MTX_t dest = MTX_VIEW_INIT(3u, 4u, buf);
+	MTX_t aIn = {2u, 2u, 4u, 0u, buf};			/* upper left block of dest */
+	MTX_t aCompact = MTX_VIEW_INIT(2u, 2u, buf);	/* same start, but stride 2 */
+	MTX_t b = MTX_VIEW_INIT(1u, 2u, bb);
+	MTX_t bIn = {1u, 2u, 4u, 0u, &buf[10]};
+	int i;
+
+	for(i = 0; i < 12; i++)
+	{
+		buf[i] = (i+1) << 16;
+	}
+	/* in place: A = [1 2; 5 6] stays, B goes to (3,3), everything else is cleared */
+	MTX_AppendMatrix(&dest, &aIn, &b, 3u, 3u);
+	HT_CHECK(0u == dest.errors, "in place append failed");
+	HT_CHECK((buf[0] == (1<<16)) && (buf[1] == (2<<16)) && (buf[4] == (5<<16)) && (buf[5] == (6<<16)), "in place append changed A");
+	HT_CHECK((buf[10] == (7<<16)) && (buf[11] == (8<<16)), "in place append didn't write B");
+	HT_CHECK((buf[2] == 0) && (buf[3] == 0) && (buf[6] == 0) && (buf[7] == 0) && (buf[8] == 0) && (buf[9] == 0), "in place append didn't clear the rest");
+
+	/* A in the storage of dest_ with another stride would be overwritten while it is copied */
+	MTX_AppendMatrix(&dest, &aCompact, &b, 3u, 3u);
+	HT_CHECK(dest.errors & FIXMATRIX_USEERR, "append with differently strided A in dest_ not rejected");
+	/* B must not be in the storage of dest_ */
+	MTX_AppendMatrix(&dest, &aIn, &bIn, 3u, 3u);
+	HT_CHECK(dest.errors & FIXMATRIX_USEERR, "append with B in dest_ not rejected");
+}
+
+/* A = Q*R, Q'Q = I, R upper triangular */
+static void Test_Qr(void)
+{
+	double a[N_MAX*N_MAX];
+	fix16_t fa[N_MAX*N_MAX], fq[N_MAX*N_MAX], fr[N_MAX*N_MAX];
+	double errRec = 0.0, errOrth = 0.0, e;
+	int t, m, n, i, j, k, inPlace;
+
+	for(t = 0; t < N_RAND; t++)
+	{
+		n = 1 + (HT_Rand() % N_MAX);
+		m = n + (HT_Rand() % (N_MAX - n + 1));
+		inPlace = (t & 1);
+		{
+			MTX_t ma = MTX_VIEW_INIT(m, n, fa), mq = MTX_VIEW_INIT(m, n, fq), mr = MTX_VIEW_INIT(n, n, fr);
+			RandMtx(a, m, n, 10.0);
+			ToFix(&ma, a);
+			if(inPlace)
+			{
+				MTX_QrDecomposition(&ma, &mr, &ma, 1u);
+				mq = ma;
+			}
+			else
+			{
+				MTX_QrDecomposition(&mq, &mr, &ma, 1u);
+			}
+			HT_CHECK(0u == mq.errors, "QR of random %dx%d failed with %#x", m, n, mq.errors);
+			for(i = 0; i < m; i++)
+			{
+				for(j = 0; j < n; j++)
+				{
+					e = -a[i*n + j];
+					for(k = 0; k < n; k++)
+					{
+						e += At(&mq, i, k) * At(&mr, k, j);
+					}
+					errRec = fmax(errRec, fabs(e));
+				}
+			}
+			for(i = 0; i < n; i++)
+			{
+				for(j = 0; j < n; j++)
+				{
+					e = (i == j) ? -1.0 : 0.0;
+					for(k = 0; k < m; k++)
+					{
+						e += At(&mq, k, i) * At(&mq, k, j);
+					}
+					errOrth = fmax(errOrth, fabs(e));
+					if(i > j)
+					{
+						HT_CHECK(0 == MTX_AT(&mr, i, j), "R not upper triangular");
+					}
+				}
+			}
+		}
+	}
+	printf("QR       max |QR-A| = %.2e, max |Q'Q-I| = %.2e\n", errRec, errOrth);
+	HT_CHECK(errRec < 2e-3, "QR reconstruction error %.2e", errRec);
+	HT_CHECK(errOrth < 2e-3, "QR orthogonality error %.2e", errOrth);
+
+	/* linearly dependent columns, r_ overlapping the input */
+	{
+		fix16_t d[4] = {1<<16, 2<<16, 2<<16, 4<<16};
+		MTX_t md = MTX_VIEW_INIT(2u, 2u, d), mq = MTX_VIEW_INIT(2u, 2u, fq), mr = MTX_VIEW_INIT(2u, 2u, fr);
+		MTX_QrDecomposition(&mq, &mr, &md, 0u);
+		HT_CHECK((mq.errors & FIXMATRIX_SINGULAR) && (mr.errors & FIXMATRIX_SINGULAR), "singular matrix not detected");
+		MTX_QrDecomposition(&mq, &md, &md, 0u);
+		HT_CHECK(mq.errors & FIXMATRIX_USEERR, "r_ aliasing mtx_ not rejected");
+	}
+}
+
+/* Ax = b with A = QR */
+static void Test_Solve(void)
+{
+	double a[N_MAX*N_MAX], x[N_MAX*2], b[N_MAX*2];
+	fix16_t fa[N_MAX*N_MAX], fq[N_MAX*N_MAX], fr[N_MAX*N_MAX], fb[N_MAX*2], fx[N_MAX*2];
+	double err = 0.0;
+	int t, n, i, j, k;
+
+	for(t = 0; t < N_RAND; t++)
+	{
+		n = 1 + (HT_Rand() % N_MAX);
+		{
+			MTX_t ma = MTX_VIEW_INIT(n, n, fa), mq = MTX_VIEW_INIT(n, n, fq), mr = MTX_VIEW_INIT(n, n, fr);
+			MTX_t mb = MTX_VIEW_INIT(n, 2, fb), mx = MTX_VIEW_INIT(n, 2, fx);
+			/* diagonally dominant, hence well conditioned */
+			RandMtx(a, n, n, 1.0);
+			for(i = 0; i < n; i++)
+			{
+				a[i*n + i] += (a[i*n + i] >= 0.0) ? n : -n;
+			}
+			RandMtx(x, n, 2, 5.0);
+			ToFix(&ma, a);
+			for(i = 0; i < n; i++)
+			{
+				for(j = 0; j < 2; j++)
+				{
+					b[i*2 + j] = 0.0;
+					for(k = 0; k < n; k++)
+					{
+						b[i*2 + j] += At(&ma, i, k) * x[k*2 + j];
+					}
+				}
+			}
+			ToFix(&mb, b);
+			MTX_QrDecomposition(&mq, &mr, &ma, 1u);
+			MTX_Solve(&mx, &mq, &mr, &mb);
+			HT_CHECK(0u == mx.errors, "Solve of %dx%d failed with %#x", n, n, mx.errors);
+			for(i = 0; i < n*2; i++)
+			{
+				err = fmax(err, fabs(fix16_to_dbl(fx[i]) - x[i]));
+			}
+			MTX_Solve(&mb, &mq, &mr, &mb);
+			HT_CHECK(mb.errors & FIXMATRIX_USEERR, "dest_ aliasing mtx_ not rejected");
+		}
+	}
+	printf("Solve    max |x-x_ref| = %.2e\n", err);
+	HT_CHECK(err < 2e-3, "Solve error %.2e", err);
+}
+
+/* A = L*L' and A^-1 from L, both also in place */
+static void Test_CholeskyInvert(void)
+{
+	double a[N_MAX*N_MAX];
+	fix16_t fa[N_MAX*N_MAX], fl[N_MAX*N_MAX], fi[N_MAX*N_MAX];
+	double errL = 0.0, errInv = 0.0, e;
+	int t, n, i, j, k, inPlace;
+
+	for(t = 0; t < N_RAND; t++)
+	{
+		n = 1 + (HT_Rand() % N_MAX);
+		inPlace = (t & 1);
+		{
+			MTX_t ma = MTX_VIEW_INIT(n, n, fa), ml = MTX_VIEW_INIT(n, n, fl), mi = MTX_VIEW_INIT(n, n, fi);
+			RandSpd(a, n, 2.0);
+			ToFix(&ma, a);
+			if(inPlace)
+			{
+				memcpy(fl, fa, sizeof(fa));
+				MTX_Cholesky(&ml, &ml);
+			}
+			else
+			{
+				MTX_Cholesky(&ml, &ma);
+			}
+			HT_CHECK(0u == ml.errors, "Cholesky of %dx%d failed with %#x", n, n, ml.errors);
+			for(i = 0; i < n; i++)
+			{
+				for(j = 0; j < n; j++)
+				{
+					e = -At(&ma, i, j);
+					for(k = 0; k < n; k++)
+					{
+						e += At(&ml, i, k) * At(&ml, j, k);
+					}
+					errL = fmax(errL, fabs(e) / (1.0 + fabs(a[i*n + j])));
+					if(j > i)
+					{
+						HT_CHECK(0 == MTX_AT(&ml, i, j), "L not lower triangular");
+					}
+				}
+			}
+			if(inPlace)
+			{
+				MTX_InvertLowerTri(&ml, &ml);
+				mi = ml;
+			}
+			else
+			{
+				MTX_InvertLowerTri(&mi, &ml);
+			}
+			HT_CHECK(0u == mi.errors, "InvertLowerTri of %dx%d failed with %#x", n, n, mi.errors);
+			for(i = 0; i < n; i++)
+			{
+				for(j = 0; j < n; j++)
+				{
+					e = (i == j) ? -1.0 : 0.0;
+					for(k = 0; k < n; k++)
+					{
+						e += At(&ma, i, k) * At(&mi, k, j);
+					}
+					errInv = fmax(errInv, fabs(e));
+				}
+			}
+		}
+	}
+	printf("Cholesky max |LL'-A|/(1+|A|) = %.2e, max |A*A^-1-I| = %.2e\n", errL, errInv);
+	HT_CHECK(errL < 1e-4, "Cholesky error %.2e", errL);
+	HT_CHECK(errInv < 2e-3, "InvertLowerTri error %.2e", errInv);
+
+	/* indefinite matrix */
+	{
+		fix16_t d[4] = {1<<16, 2<<16, 2<<16, 1<<16};
+		MTX_t md = MTX_VIEW_INIT(2u, 2u, d), ml = MTX_VIEW_INIT(2u, 2u, fl);
+		MTX_Cholesky(&ml, &md);
+		HT_CHECK(ml.errors & FIXMATRIX_NEGATIVE, "indefinite matrix not detected");
+	}
+}
+
+
+int main(void)
+{
+	HT_Seed(26u);
+	Test_Alias();
+	Test_Append();
+	Test_Qr();
+	Test_Solve();
+	Test_CholeskyInvert();
+	return HT_Result();
+}
@@ -0,0 +1,488 @@
+/***********************************************************************************************//**
+ * @file		test_mtx_extend.c
+ * @ingroup		test
+ * @brief 		Host tests and benchmarks of the extensions of the SWC @a mtx
+ *
+ * Checks MTX_AppendMatrix, MTX_QlDecomposition and MTX_UdDecomposition against double precision
+ * references on random and ill-conditioned matrices, checks the error flags and measures the time
+ * per call. The errors of the ill-conditioned cases are printed as a table over the condition
+ * number, only the well-conditioned cases have hard limits.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#include <string.h>
+#include "host_test.h"
+#include "Platform.h"
+#include "mtx_api.h"
+
+#define N_MAX		(6)
+#define N_RAND		(500)
+#define N_BENCH		(200000ul)
+
+
+/*============================================= helpers ==========================================*/
+static void ToFix(MTX_t *dest_, const double *src_)
+{
+	uint8_t r, c;
+	for(r = 0u; r < dest_->rows; r++)
+	{
+		for(c = 0u; c < dest_->columns; c++)
+		{
+			MTX_AT(dest_, r, c) = fix16_from_dbl(src_[r*dest_->columns + c]);
+		}
+	}
+}
+
+static void ToDbl(double *dest_, const MTX_t *src_)
+{
+	uint8_t r, c;
+	for(r = 0u; r < src_->rows; r++)
+	{
+		for(c = 0u; c < src_->columns; c++)
+		{
+			dest_[r*src_->columns + c] = fix16_to_dbl(MTX_AT(src_, r, c));
+		}
+	}
+}
+
+static void RandMtx(double *dest_, int rows_, int cols_, double amp_)
+{
+	int i;
+	for(i = 0; i < rows_*cols_; i++)
+	{
+		dest_[i] = HT_Uniform(-amp_, amp_);
+	}
+}
+
+static double MaxAbs(const double *a_, int n_)
+{
+	double max = 0.0;
+	int i;
+	for(i = 0; i < n_; i++)
+	{
+		max = fmax(max, fabs(a_[i]));
+	}
+	return max;
+}
+
+/* random orthogonal n x n matrix by Gram-Schmidt of a random matrix */
+static void RandOrth(double *v_, int n_)
+{
+	int i, j, k;
+	double dot, norm;
+	RandMtx(v_, n_, n_, 1.0);
+	for(j = 0; j < n_; j++)
+	{
+		for(i = 0; i < j; i++)
+		{
+			dot = 0.0;
+			for(k = 0; k < n_; k++)
+			{
+				dot += v_[k*n_ + i] * v_[k*n_ + j];
+			}
+			for(k = 0; k < n_; k++)
+			{
+				v_[k*n_ + j] -= dot * v_[k*n_ + i];
+			}
+		}
+		norm = 0.0;
+		for(k = 0; k < n_; k++)
+		{
+			norm += v_[k*n_ + j] * v_[k*n_ + j];
+		}
+		for(k = 0; k < n_; k++)
+		{
+			v_[k*n_ + j] /= sqrt(norm);
+		}
+	}
+}
+
+/* symmetric positive definite P = V diag(lambda) V' with eigenvalues from lMax_ down to lMax_/cond_ */
+static void SpdWithCond(double *p_, int n_, double lMax_, double cond_)
+{
+	double v[N_MAX*N_MAX], lambda[N_MAX];
+	int i, j, k;
+	RandOrth(v, n_);
+	for(k = 0; k < n_; k++)
+	{
+		lambda[k] = (1 == n_) ? lMax_ : lMax_ * pow(cond_, -(double)k / (n_ - 1));
+	}
+	for(i = 0; i < n_; i++)
+	{
+		for(j = 0; j < n_; j++)
+		{
+			p_[i*n_ + j] = 0.0;
+			for(k = 0; k < n_; k++)
+			{
+				p_[i*n_ + j] += v[i*n_ + k] * lambda[k] * v[j*n_ + k];
+			}
+		}
+	}
+}
+
+
+/*=========================================== references =========================================*/
+/* P = U*D*U', U unit upper triangular, same recursion as MTX_UdDecomposition */
+static void RefUd(double *u_, double *d_, const double *p_, int n_)
+{
+	int i, j, k;
+	double sigma;
+	memset(u_, 0, sizeof(double)*n_*n_);
+	memset(d_, 0, sizeof(double)*n_*n_);
+	for(j = n_-1; j >= 0; j--)
+	{
+		for(i = j; i >= 0; i--)
+		{
+			sigma = p_[i*n_ + j];
+			for(k = j+1; k < n_; k++)
+			{
+				sigma -= u_[i*n_ + k] * d_[k*n_ + k] * u_[j*n_ + k];
+			}
+			if(i == j)
+			{
+				d_[j*n_ + j] = sigma;
+				u_[j*n_ + j] = 1.0;
+			}
+			else
+			{
+				u_[i*n_ + j] = sigma / d_[j*n_ + j];
+			}
+		}
+	}
+}
+
+/* A = Q*L, Q with orthogonal columns, L unit lower triangular, modified Gram-Schmidt from the right */
+static void RefQl(double *q_, double *l_, const double *a_, int m_, int n_)
+{
+	int i, j, k;
+	double dotaq, dotqq;
+	memcpy(q_, a_, sizeof(double)*m_*n_);
+	memset(l_, 0, sizeof(double)*n_*n_);
+	for(k = 0; k < n_; k++)
+	{
+		l_[k*n_ + k] = 1.0;
+	}
+	for(j = n_-2; j >= 0; j--)
+	{
+		for(i = n_-1; i > j; i--)
+		{
+			dotaq = dotqq = 0.0;
+			for(k = 0; k < m_; k++)
+			{
+				dotaq += q_[k*n_ + j] * q_[k*n_ + i];
+				dotqq += q_[k*n_ + i] * q_[k*n_ + i];
+			}
+			l_[i*n_ + j] = dotaq / dotqq;
+			for(k = 0; k < m_; k++)
+			{
+				q_[k*n_ + j] -= l_[i*n_ + j] * q_[k*n_ + i];
+			}
+		}
+	}
+}
+
+
+/*============================================== tests ===========================================*/
+static void Test_Append(void)
+{
+	fix16_t fd[N_MAX*N_MAX], fa[N_MAX*N_MAX], fb[N_MAX*N_MAX];
+	double a[N_MAX*N_MAX], b[N_MAX*N_MAX], exp;
+	int t, rows, cols, ar, ac, br, bc, pr, pc, r, c, bad = 0;
+
+	for(t = 0; t < N_RAND; t++)
+	{
+		rows = 2 + (HT_Rand() % (N_MAX-1));
+		cols = 2 + (HT_Rand() % (N_MAX-1));
+		ar = 1 + (HT_Rand() % (rows-1));
+		ac = 1 + (HT_Rand() % (cols-1));
+		/* B right of or below A */
+		if(HT_Rand() & 1u)
+		{
+			pr = 1 + (HT_Rand() % rows);
+			pc = ac + 1 + (HT_Rand() % (cols-ac));
+		}
+		else
+		{
+			pr = ar + 1 + (HT_Rand() % (rows-ar));
+			pc = 1 + (HT_Rand() % cols);
+		}
+		br = 1 + (HT_Rand() % (rows-pr+1));
+		bc = 1 + (HT_Rand() % (cols-pc+1));
+		{
+			MTX_t md = MTX_VIEW_INIT(rows, cols, fd), ma = MTX_VIEW_INIT(ar, ac, fa), mb = MTX_VIEW_INIT(br, bc, fb);
+			RandMtx(a, ar, ac, 100.0);
+			RandMtx(b, br, bc, 100.0);
+			ToFix(&ma, a);
+			ToFix(&mb, b);
+			MTX_Fill(&md, fix16_one); /* garbage which has to be cleared */
+			MTX_AppendMatrix(&md, &ma, &mb, pr, pc);
+			HT_CHECK(0u == md.errors, "append %dx%d at (%d,%d) of %dx%d failed with %#x", br, bc, pr, pc, rows, cols, md.errors);
+			for(r = 0; r < rows; r++)
+			{
+				for(c = 0; c < cols; c++)
+				{
+					if( (r < ar) && (c < ac) )
+					{
+						exp = fix16_to_dbl(MTX_AT(&ma, r, c));
+					}
+					else if( (r >= pr-1) && (r < pr-1+br) && (c >= pc-1) && (c < pc-1+bc) )
+					{
+						exp = fix16_to_dbl(MTX_AT(&mb, r-(pr-1), c-(pc-1)));
+					}
+					else
+					{
+						exp = 0.0;
+					}
+					bad += (fix16_to_dbl(MTX_AT(&md, r, c)) != exp);
+				}
+			}
+		}
+	}
+	HT_CHECK(0 == bad, "%d elements of the augmented matrices differ", bad);
+
+	/* error flags */
+	{
+		MTX_t md = MTX_VIEW_INIT(3u, 3u, fd), ma = MTX_VIEW_INIT(2u, 2u, fa), mb = MTX_VIEW_INIT(1u, 1u, fb);
+		MTX_t mBig = MTX_VIEW_INIT(4u, 1u, fa), mbBig = MTX_VIEW_INIT(2u, 2u, fb);
+		ma.errors = FIXMATRIX_OVERFLOW;
+		MTX_AppendMatrix(&md, &ma, &mb, 3u, 3u);
+		HT_CHECK(FIXMATRIX_OVERFLOW == md.errors, "errors of A not propagated");
+		ma.errors = 0u;
+		MTX_AppendMatrix(&md, &ma, &mb, 0u, 3u);
+		HT_CHECK(md.errors & FIXMATRIX_USEERR, "zero position not rejected");
+		MTX_AppendMatrix(&md, &ma, &mb, 2u, 2u);
+		HT_CHECK(md.errors & FIXMATRIX_USEERR, "B on top of A not rejected");
+		MTX_AppendMatrix(&md, &ma, &mbBig, 3u, 3u);
+		HT_CHECK(md.errors & FIXMATRIX_USEERR, "B exceeding dest_ not rejected");
+		MTX_AppendMatrix(&md, &mBig, &mb, 1u, 2u);
+		HT_CHECK(md.errors & FIXMATRIX_USEERR, "A exceeding dest_ not rejected");
+	}
+}
+
+static void Test_Ud(void)
+{
+	static const double conds[] = {1e1, 1e2, 1e3, 1e4, 1e5, 1e6};
+	double p[N_MAX*N_MAX], u[N_MAX*N_MAX], d[N_MAX*N_MAX], uRef[N_MAX*N_MAX], dRef[N_MAX*N_MAX], pFix[N_MAX*N_MAX];
+	fix16_t fp[N_MAX*N_MAX], fu[N_MAX*N_MAX], fd[N_MAX*N_MAX];
+	double errU, errD, errRec, e;
+	int ci, t, n, i, j, k, flagged;
+
+	printf("UD        cond   max|U-Uref|  max|D-Dref|/|D|  max|UDU'-P|/|P|  flagged\n");
+	for(ci = 0; ci < (int)(sizeof(conds)/sizeof(conds[0])); ci++)
+	{
+		errU = errD = errRec = 0.0;
+		flagged = 0;
+		for(t = 0; t < N_RAND; t++)
+		{
+			n = 2 + (HT_Rand() % (N_MAX-1));
+			{
+				MTX_t mp = MTX_VIEW_INIT(n, n, fp), mu = MTX_VIEW_INIT(n, n, fu), md = MTX_VIEW_INIT(n, n, fd);
+				SpdWithCond(p, n, 100.0, conds[ci]);
+				ToFix(&mp, p);
+				ToDbl(pFix, &mp);
+				MTX_UdDecomposition(&mu, &md, &mp);
+				if(0u != (mu.errors | md.errors))
+				{
+					flagged++;
+					continue;
+				}
+				ToDbl(u, &mu);
+				ToDbl(d, &md);
+				RefUd(uRef, dRef, pFix, n);
+				for(i = 0; i < n; i++)
+				{
+					errD = fmax(errD, fabs(d[i*n + i] - dRef[i*n + i]) / fabs(dRef[i*n + i]));
+					for(j = 0; j < n; j++)
+					{
+						errU = fmax(errU, fabs(u[i*n + j] - uRef[i*n + j]));
+						e = -pFix[i*n + j];
+						for(k = 0; k < n; k++)
+						{
+							e += u[i*n + k] * d[k*n + k] * u[j*n + k];
+						}
+						errRec = fmax(errRec, fabs(e) / MaxAbs(pFix, n*n));
+						if( ((i > j) && (0.0 != u[i*n + j])) || ((i != j) && (0.0 != d[i*n + j])) )
+						{
+							errU = INFINITY;
+						}
+					}
+				}
+			}
+		}
+		printf("UD    %8.0e   %10.2e  %15.2e  %15.2e  %7d\n", conds[ci], errU, errD, errRec, flagged);
+		if(conds[ci] <= 1e3)
+		{
+			HT_CHECK(0 == flagged, "%d well-conditioned UD flagged", flagged);
+			HT_CHECK(errU < 1e-2, "UD error of U %.2e at cond %.0e", errU, conds[ci]);
+			HT_CHECK(errD < 1e-2, "UD error of D %.2e at cond %.0e", errD, conds[ci]);
+			HT_CHECK(errRec < 1e-4, "UD reconstruction error %.2e at cond %.0e", errRec, conds[ci]);
+		}
+	}
+
+	/* error flags */
+	{
+		fix16_t z[4] = {0}, big[4] = {1<<16, 100<<16, 100<<16, 655}; /* [1 100; 100 0.01] */
+		MTX_t mz = MTX_VIEW_INIT(2u, 2u, z), mbig = MTX_VIEW_INIT(2u, 2u, big);
+		MTX_t mu = MTX_VIEW_INIT(2u, 2u, fu), md = MTX_VIEW_INIT(2u, 2u, fd), mu3 = MTX_VIEW_INIT(3u, 3u, fu);
+		MTX_t mRect = MTX_VIEW_INIT(2u, 3u, fp);
+		MTX_UdDecomposition(&mu, &md, &mz);
+		HT_CHECK((mu.errors & FIXMATRIX_SINGULAR) && (md.errors & FIXMATRIX_SINGULAR), "singular P not flagged");
+		MTX_UdDecomposition(&mu, &md, &mbig);
+		HT_CHECK((mu.errors & FIXMATRIX_OVERFLOW) && (md.errors & FIXMATRIX_OVERFLOW), "overflow not flagged");
+		MTX_UdDecomposition(&mu3, &md, &mz);
+		HT_CHECK(mu3.errors & FIXMATRIX_DIMERR, "wrong size of U not flagged");
+		MTX_UdDecomposition(&mu, &md, &mRect);
+		HT_CHECK(mu.errors & FIXMATRIX_DIMERR, "non-square P not flagged");
+	}
+}
+
+static void Test_Ql(void)
+{
+	static const double eps[] = {1.0, 1e-1, 1e-2, 1e-3, 1e-4};
+	double a[N_MAX*N_MAX], w[N_MAX*N_MAX], q[N_MAX*N_MAX], l[N_MAX*N_MAX], qRef[N_MAX*N_MAX], lRef[N_MAX*N_MAX], aFix[N_MAX*N_MAX];
+	fix16_t fa[N_MAX*N_MAX], fq[N_MAX*N_MAX], fl[N_MAX*N_MAX];
+	double errL, errRec, errOrth, errCos, e, nij, nii, njj, aii, ajj;
+	int ei, t, m, n, i, j, k, reOrth, flagged;
+
+	printf("QL reorth  eps   max|L-Lref|  max|QL-A|/|A|  max|qi'qj|/|ai||aj|  max cos(qi,qj)  flagged\n");
+	for(reOrth = 0; reOrth <= 1; reOrth++)
+	{
+		for(ei = 0; ei < (int)(sizeof(eps)/sizeof(eps[0])); ei++)
+		{
+			errL = errRec = errOrth = errCos = 0.0;
+			flagged = 0;
+			for(t = 0; t < N_RAND; t++)
+			{
+				n = 2 + (HT_Rand() % (N_MAX-1));
+				m = n + (HT_Rand() % (N_MAX-n+1));
+				/* the columns are a common random vector plus eps times individual random vectors */
+				RandMtx(w, m, n, 1.0);
+				RandMtx(a, m, 1, 1.0);
+				for(i = 0; i < m; i++)
+				{
+					for(j = 0; j < n; j++)
+					{
+						w[i*n + j] = 4.0 * ((1.0 == eps[ei]) ? w[i*n + j] : (a[i] + eps[ei] * w[i*n + j]));
+					}
+				}
+				{
+					MTX_t ma = MTX_VIEW_INIT(m, n, fa), mq = MTX_VIEW_INIT(m, n, fq), ml = MTX_VIEW_INIT(n, n, fl);
+					ToFix(&ma, w);
+					ToDbl(aFix, &ma);
+					MTX_QlDecomposition(&mq, &ml, &ma, reOrth);
+					if(0u != (mq.errors | ml.errors))
+					{
+						flagged++;
+						continue;
+					}
+					ToDbl(q, &mq);
+					ToDbl(l, &ml);
+					RefQl(qRef, lRef, aFix, m, n);
+					for(i = 0; i < n; i++)
+					{
+						for(j = 0; j < n; j++)
+						{
+							errL = fmax(errL, fabs(l[i*n + j] - lRef[i*n + j]));
+							if( ((i < j) && (0.0 != l[i*n + j])) || ((i == j) && (1.0 != l[i*n + j])) )
+							{
+								errL = INFINITY;
+							}
+							nij = nii = njj = aii = ajj = 0.0;
+							for(k = 0; k < m; k++)
+							{
+								nij += q[k*n + i] * q[k*n + j];
+								nii += q[k*n + i] * q[k*n + i];
+								njj += q[k*n + j] * q[k*n + j];
+								aii += aFix[k*n + i] * aFix[k*n + i];
+								ajj += aFix[k*n + j] * aFix[k*n + j];
+							}
+							/* the cosine is dominated by the rounding of short columns of Q, the
+							 * orthogonality relative to the columns of A is the meaningful measure */
+							if(i != j)
+							{
+								errOrth = fmax(errOrth, fabs(nij) / sqrt(aii * ajj));
+								errCos  = fmax(errCos, fabs(nij) / sqrt(nii * njj));
+							}
+						}
+					}
+					for(i = 0; i < m; i++)
+					{
+						for(j = 0; j < n; j++)
+						{
+							e = -aFix[i*n + j];
+							for(k = 0; k < n; k++)
+							{
+								e += q[i*n + k] * l[k*n + j];
+							}
+							errRec = fmax(errRec, fabs(e) / MaxAbs(aFix, m*n));
+						}
+					}
+				}
+			}
+			printf("QL %6d  %6.0e  %10.2e  %13.2e  %19.2e  %14.2e  %7d\n", reOrth, eps[ei], errL, errRec, errOrth, errCos, flagged);
+			if(eps[ei] >= 1e-1)
+			{
+				HT_CHECK(0 == flagged, "%d well-conditioned QL flagged", flagged);
+				HT_CHECK(errRec < 1e-3, "QL reconstruction error %.2e at eps %.0e, reorth %d", errRec, eps[ei], reOrth);
+				HT_CHECK(errOrth < ((0 == reOrth) ? 5e-4 : 1e-4), "QL orthogonality error %.2e at eps %.0e, reorth %d", errOrth, eps[ei], reOrth);
+				if(0 == reOrth)
+				{
+					HT_CHECK(errL < 1e-2, "QL error of L %.2e at eps %.0e", errL, eps[ei]);
+				}
+			}
+		}
+	}
+
+	/* error flags */
+	{
+		/* [1 0; 1 0] has a zero column, [30000 0.01; 0 0] a projection coefficient of 3e6 */
+		fix16_t z[4] = {1<<16, 0, 1<<16, 0}, big[4] = {30000<<16, 655, 0, 0};
+		MTX_t mz = MTX_VIEW_INIT(2u, 2u, z), mbig = MTX_VIEW_INIT(2u, 2u, big);
+		MTX_t mq = MTX_VIEW_INIT(2u, 2u, fq), ml = MTX_VIEW_INIT(2u, 2u, fl), ml3 = MTX_VIEW_INIT(3u, 3u, fl);
+		MTX_QlDecomposition(&mq, &ml, &mz, 0u);
+		HT_CHECK((mq.errors & FIXMATRIX_SINGULAR) && (ml.errors & FIXMATRIX_SINGULAR), "zero column not flagged");
+		MTX_QlDecomposition(&mq, &ml, &mbig, 0u);
+		HT_CHECK((mq.errors & FIXMATRIX_OVERFLOW) && (ml.errors & FIXMATRIX_OVERFLOW), "overflow not flagged");
+		MTX_QlDecomposition(&mq, &ml3, &mz, 0u);
+		HT_CHECK((mq.errors & FIXMATRIX_DIMERR) && (ml3.errors & FIXMATRIX_DIMERR), "wrong size of L not flagged");
+	}
+}
+
+static void Bench(void)
+{
+	fix16_t fd[N_MAX*(N_MAX+1)], fa[N_MAX*N_MAX], fb[N_MAX], fq[N_MAX*N_MAX], fl[N_MAX*N_MAX], fp[N_MAX*N_MAX];
+	double p[N_MAX*N_MAX], tApp, tQl0, tQl1, tUd;
+	int n;
+
+	printf("time per call [ns]   n   Append   QL(0)   QL(1)      UD\n");
+	for(n = 2; n <= N_MAX; n += 2)
+	{
+		MTX_t md = MTX_VIEW_INIT(n, n+1, fd), ma = MTX_VIEW_INIT(n, n, fa), mb = MTX_VIEW_INIT(n, 1, fb);
+		MTX_t mq = MTX_VIEW_INIT(n, n, fq), ml = MTX_VIEW_INIT(n, n, fl), mp = MTX_VIEW_INIT(n, n, fp);
+		SpdWithCond(p, n, 100.0, 10.0);
+		ToFix(&mp, p);
+		ToFix(&ma, p);
+		MTX_Fill(&mb, fix16_one);
+		HT_TIME(tApp, N_BENCH, MTX_AppendMatrix(&md, &ma, &mb, 1u, n+1));
+		HT_TIME(tQl0, N_BENCH, MTX_QlDecomposition(&mq, &ml, &ma, 0u));
+		HT_TIME(tQl1, N_BENCH, MTX_QlDecomposition(&mq, &ml, &ma, 1u));
+		HT_TIME(tUd,  N_BENCH, MTX_UdDecomposition(&mq, &ml, &mp));
+		printf("                    %2d  %7.1f %7.1f %7.1f %7.1f\n", n, tApp, tQl0, tQl1, tUd);
+	}
+}
+
+
+int main(void)
+{
+	HT_Seed(28u);
+	Test_Append();
+	Test_Ud();
+	Test_Ql();
+	Bench();
+	return HT_Result();
+}
@@ -0,0 +1,237 @@
+/***********************************************************************************************//**
+ * @file		test_mtx_kernel.c
+ * @ingroup		test
+ * @brief 		Host tests and benchmarks of the dot product kernels of the SWC @a mtx
+ *
+ * Checks MTX_Dot32d32, MTX_Dot48d16 and MTX_Dot bit by bit against an exact 128 bit reference and
+ * against fa16_dot of libfixmatrix, which the kernels replace, and compares their speed with
+ * fa16_dot and with a loop of fix16_mul and fix16_add. Checks the integer square root MTX_ISqrt at
+ * the squares and their neighbors and on random values of the whole 64 bit range.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#include "host_test.h"
+#include "Platform.h"
+#include "mtx_api.h"
+
+#define N_MAX		(8)
+#define STRIDE_MAX	(4)
+#define N_RAND		(200000)
+#define N_BENCH		(2000000ul)
+#define N_REP		(5)			/* the fastest of N_REP runs is reported */
+
+
+/*=========================================== references =========================================*/
+/* fa16_dot of libfixmatrix (fixarray.c) as used before the kernels were introduced, out of line
+ * like the library function, so the benchmark compares calls with calls */
+static __attribute__((noinline)) fix16_t Ref_Fa16Dot(const fix16_t *a_, uint8_t aStride_, const fix16_t *b_, uint8_t bStride_, uint8_t n_)
+{
+	int64_t sum = 0;
+	uint32_t upper = 0u;
+	fix16_t result = 0;
+
+	while(n_--)
+	{
+		if( (0 != *a_) && (0 != *b_) )
+		{
+			sum += (int64_t)(*a_) * (*b_);
+		}
+		a_ += aStride_;
+		b_ += bStride_;
+	}
+	upper = (uint32_t)(sum >> 47);
+	if(sum < 0)
+	{
+		upper = ~upper;
+		sum--;
+	}
+	if(0u != upper)
+	{
+		return fix16_overflow;
+	}
+	result  = (fix16_t)(sum >> 16);
+	result += (fix16_t)((sum & 0x8000) >> 15);
+	return result;
+}
+
+/* element-wise product and sum with the saturating libfixmath operations */
+static __attribute__((noinline)) fix16_t Ref_Fix16Dot(const fix16_t *a_, uint8_t aStride_, const fix16_t *b_, uint8_t bStride_, uint8_t n_)
+{
+	fix16_t sum = 0;
+
+	while(n_--)
+	{
+		sum = fix16_add(sum, fix16_mul(*a_, *b_));
+		a_ += aStride_;
+		b_ += bStride_;
+	}
+	return sum;
+}
+
+/* exact sum of products */
+static __int128 Ref_Exact(const fix16_t *a_, uint8_t aStride_, const fix16_t *b_, uint8_t bStride_, uint8_t n_)
+{
+	__int128 sum = 0;
+
+	while(n_--)
+	{
+		sum += (__int128)(*a_) * (*b_);
+		a_ += aStride_;
+		b_ += bStride_;
+	}
+	return sum;
+}
+
+/* Q32.32 to Q48.16, rounded to nearest with ties away from zero like fix16_mul */
+static int64_t Ref_Round(__int128 sum_)
+{
+	__int128 mag = (sum_ < 0) ? -sum_ : sum_;
+	mag = (mag + 0x8000) >> 16;
+	return (int64_t)((sum_ < 0) ? -mag : mag);
+}
+
+
+/*============================================== tests ===========================================*/
+static fix16_t RandFix(int bits_)
+{
+	int32_t val = (int32_t)(HT_Rand() >> (32 - bits_));
+	return (HT_Rand() & 1u) ? -val : val;
+}
+
+static void Test_Exact(void)
+{
+	fix16_t a[N_MAX*STRIDE_MAX], b[N_MAX*STRIDE_MAX];
+	int t, i, n, sa, sb, bits;
+	int bad32 = 0, bad48 = 0, bad16 = 0, badRef = 0, badOvf = 0, ties = 0, nOvf = 0;
+	__int128 exact;
+	int64_t rounded;
+	fix16_t dot, ref;
+
+	for(t = 0; t < N_RAND; t++)
+	{
+		n    = HT_Rand() % (N_MAX+1);
+		sa   = 1 + HT_Rand() % STRIDE_MAX;
+		sb   = 1 + HT_Rand() % STRIDE_MAX;
+		/* from a few LSB up to 2^28, 2^28 * 2^28 * 8 still fits into the 64 bit accumulator */
+		bits = 1 + HT_Rand() % 28;
+		for(i = 0; i < N_MAX*STRIDE_MAX; i++)
+		{
+			a[i] = RandFix(bits);
+			b[i] = RandFix(1 + HT_Rand() % 28);
+		}
+		/* every 8th case gets exact ties of the rounding */
+		if(0 == (t % 8))
+		{
+			a[0] = 1;
+			b[0] = (HT_Rand() & 1u) ? 0x8000 : -0x8000;
+			ties++;
+		}
+		exact   = Ref_Exact(a, sa, b, sb, n);
+		rounded = Ref_Round(exact);
+		bad32  += (MTX_Dot32d32(a, sa, b, sb, n) != (int64_t)exact);
+		bad48  += (MTX_Dot48d16(a, sa, b, sb, n) != rounded);
+
+		dot = MTX_Dot(a, sa, b, sb, n);
+		ref = Ref_Fa16Dot(a, sa, b, sb, n);
+		if( (rounded > (int64_t)fix16_maximum) || (rounded <= (int64_t)fix16_minimum) )
+		{
+			nOvf++;
+			badOvf += (fix16_overflow != dot);
+		}
+		else
+		{
+			bad16 += (dot != (fix16_t)rounded);
+			/* fa16_dot saturates from |sum| >= 2^47 on, i.e. one rounding step earlier */
+			badRef += ( (fix16_overflow != ref) && (dot != ref) );
+		}
+	}
+	printf("exactness: %d cases, %d ties, %d overflows\n", N_RAND, ties, nOvf);
+	HT_CHECK(0 == bad32, "MTX_Dot32d32 differs from the exact sum in %d cases", bad32);
+	HT_CHECK(0 == bad48, "MTX_Dot48d16 differs from the rounded sum in %d cases", bad48);
+	HT_CHECK(0 == bad16, "MTX_Dot differs from the rounded sum in %d cases", bad16);
+	HT_CHECK(0 == badRef, "MTX_Dot differs from fa16_dot in %d cases", badRef);
+	HT_CHECK(0 == badOvf, "MTX_Dot missed %d overflows", badOvf);
+	HT_CHECK(nOvf > 100, "only %d overflows tested", nOvf);
+
+	/* limits of the Q16.16 range */
+	{
+		fix16_t one = fix16_one, max = fix16_maximum, min = fix16_minimum + 1, two[2] = {fix16_maximum, 1};
+		HT_CHECK(fix16_maximum == MTX_Dot(&max, 1, &one, 1, 1), "maximum not representable");
+		HT_CHECK(-fix16_maximum == MTX_Dot(&min, 1, &one, 1, 1), "-maximum not representable");
+		HT_CHECK(fix16_overflow == MTX_Dot(two, 1, two, 0, 2), "maximum + LSB not detected");
+		HT_CHECK(0 == MTX_Dot(&max, 1, &one, 1, 0), "empty dot product not zero");
+	}
+}
+
+static void Test_ISqrt(void)
+{
+	uint64_t r = 0u, v = 0u;
+	uint32_t res = 0u;
+	long bad = 0;
+	int k;
+
+	/* r^2 - 1, r^2 and (r+1)^2 - 1 for every bit length of the root */
+	for(k = 0; k < 32; k++)
+	{
+		r = (((uint64_t)1u) << k) | ((uint64_t)HT_Rand() & ((((uint64_t)1u) << k) - 1u));
+		bad += ((r - 1u) != MTX_ISqrt(r * r - 1u)) ? 1 : 0;
+		bad += (r != MTX_ISqrt(r * r)) ? 1 : 0;
+		bad += (r != MTX_ISqrt(r * r + 2u * r)) ? 1 : 0;
+	}
+	HT_CHECK(0u == MTX_ISqrt(0u), "sqrt(0) wrong");
+	HT_CHECK(0xFFFFFFFFu == MTX_ISqrt(UINT64_MAX), "sqrt(2^64-1) wrong");
+	for(k = 0; k < 1000000; k++)
+	{
+		v   = (((uint64_t)HT_Rand() << 32) | HT_Rand()) >> (HT_Rand() % 64u);
+		res = MTX_ISqrt(v);
+		/* res^2 <= v < (res+1)^2 */
+		bad += ( ((uint64_t)res * res > v) || ((unsigned __int128)(res + 1ull) * (res + 1ull) <= v) ) ? 1 : 0;
+	}
+	printf("MTX_ISqrt: %ld roots wrong\n", bad);
+	HT_CHECK(0 == bad, "%ld roots wrong", bad);
+}
+
+static void Bench(void)
+{
+	static volatile fix16_t sink;
+	(void)sink;
+	fix16_t a[N_MAX*STRIDE_MAX], b[N_MAX*STRIDE_MAX];
+	double t, tKern, tFa16, tFix16;
+	int i, n, rep;
+
+	for(i = 0; i < N_MAX*STRIDE_MAX; i++)
+	{
+		a[i] = RandFix(18);
+		b[i] = RandFix(18);
+	}
+	printf("time per call [ns]   n   MTX_Dot  fa16_dot  fix16 loop\n");
+	for(n = 2; n <= 6; n += 2)
+	{
+		tKern = tFa16 = tFix16 = 1e9;
+		for(rep = 0; rep < N_REP; rep++)
+		{
+			HT_TIME(t, N_BENCH, sink = MTX_Dot(a, 1, b, n, n));
+			tKern = (t < tKern) ? t : tKern;
+			HT_TIME(t, N_BENCH, sink = Ref_Fa16Dot(a, 1, b, n, n));
+			tFa16 = (t < tFa16) ? t : tFa16;
+			HT_TIME(t, N_BENCH, sink = Ref_Fix16Dot(a, 1, b, n, n));
+			tFix16 = (t < tFix16) ? t : tFix16;
+		}
+		printf("                    %2d  %8.2f  %8.2f  %10.2f\n", n, tKern, tFa16, tFix16);
+	}
+}
+
+
+int main(void)
+{
+	HT_Seed(27u);
+	Test_Exact();
+	Test_ISqrt();
+	Bench();
+	return HT_Result();
+}
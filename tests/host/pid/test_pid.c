@@ -0,0 +1,161 @@
+/***********************************************************************************************//**
+ * @file		test_pid.c
+ * @ingroup		test
+ * @brief 		Host tests and benchmarks of the binary point PID engine of the SWC @a pid
+ *
+ * Checks that PIDq with gains converted by PID_Cvt_GainToQ is bit-exact to PIDext with the decimal
+ * scaled gains of the NVM layout, that PID_Batch is bit-exact to calling PID item by item, and
+ * compares the time per call.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#include <string.h>
+#include "host_test.h"
+#include "Platform.h"
+#include "pid.h"
+#include "pid_cfg.h"
+#include "pid_api.h"
+
+#define N_STEPS		(2000000l)
+#define N_RESET		(1000l)
+#define N_BENCH		(20000000ul)
+
+/* the default gains of pid_cfg.c and corner cases of the decimal scaling */
+static const PID_Gain_t Gains[] =
+{
+	{ 2000u,    80u,     0u,   100u, 0xFFFFu},		/* speed */
+	{ 1000u,     1u,    50u,   100u, 0xFFFFu},		/* position */
+	{  800u,    20u,     0u,   100u,    400u},		/* synchronization */
+	{  300u,     7u,    13u,    64u, 0x7FFFu},
+	{  123u,    45u,    67u,     1u, 0xFFFFu},
+	{    7u,     3u,     1u, 10000u, 0xFFFFu},
+	{65535u, 65535u, 65535u,   100u, 0xFFFFFu},
+};
+
+/* the errors are bounded so that kD * (err - prevErr) of PIDext doesn't overflow, PIDq is exact
+ * for |err| < 2^nShift / nScale */
+#define RANGE		(8000)
+
+/* two copies of the four motor items of pid_cfg.c, the first is calculated by PID_Batch, the
+ * second item by item by PID */
+#define ITM(gain_, form_, schedVar_) {{"", gain_, {NULL, NULL, NULL, NULL, NULL, NULL}, form_, schedVar_, PID_DSRC_MEAS, 2u, {0}, {{{0}}}}, {0}}
+static PID_Itm_t Items[] =
+{
+	ITM(((PID_Gain_t){2000u, 80u,  0u, 100u, 0xFFFFu}), PID_FORM_VEL, PID_SCHED_SET),
+	ITM(((PID_Gain_t){2000u, 80u,  0u, 100u, 0xFFFFu}), PID_FORM_VEL, PID_SCHED_SET),
+	ITM(((PID_Gain_t){1000u,  1u, 50u, 100u, 0xFFFFu}), PID_FORM_POS, PID_SCHED_NONE),
+	ITM(((PID_Gain_t){1000u,  1u, 50u, 100u, 0xFFFFu}), PID_FORM_POS, PID_SCHED_NONE),
+	ITM(((PID_Gain_t){2000u, 80u,  0u, 100u, 0xFFFFu}), PID_FORM_VEL, PID_SCHED_SET),
+	ITM(((PID_Gain_t){2000u, 80u,  0u, 100u, 0xFFFFu}), PID_FORM_VEL, PID_SCHED_SET),
+	ITM(((PID_Gain_t){1000u,  1u, 50u, 100u, 0xFFFFu}), PID_FORM_POS, PID_SCHED_NONE),
+	ITM(((PID_Gain_t){1000u,  1u, 50u, 100u, 0xFFFFu}), PID_FORM_POS, PID_SCHED_NONE),
+};
+static PID_ItmTbl_t ItemTable = {Items, sizeof(Items)/sizeof(Items[0])};
+
+PID_ItmTbl_t *Get_pPidItmTbl(void) {return &ItemTable;}
+
+
+/*============================================= tests ============================================*/
+static int32_t RandVal(int32_t range_)
+{
+	return (int32_t)(HT_Rand() % (uint32_t)(2*range_ + 1)) - range_;
+}
+
+static void Test_BitExact(void)
+{
+	PID_QGain_t qGain;
+	PID_Data_t dExt, dQ;
+	int32_t set, act, uExt, uQ;
+	long k, bad;
+	unsigned int g;
+
+	for(g = 0u; g < sizeof(Gains)/sizeof(Gains[0]); g++)
+	{
+		HT_CHECK(ERR_OK == PID_Cvt_GainToQ(&Gains[g], &qGain), "gain set %u not converted", g);
+		bad = 0;
+		for(k = 0; k < N_STEPS; k++)
+		{
+			if(0 == (k % N_RESET))
+			{
+				memset(&dExt, 0, sizeof(dExt));
+				memset(&dQ, 0, sizeof(dQ));
+			}
+			/* random walks hit the saturation of the integral part and leave it again */
+			set = RandVal(RANGE);
+			act = RandVal(RANGE);
+			PIDext(set, act, &Gains[g], &dExt, &uExt);
+			PIDq(set, act, &qGain, &dQ, &uQ);
+			if( (uExt != uQ) || (dExt.intVal != dQ.intVal) || (dExt.sat != dQ.sat) )
+			{
+				bad++;
+				dQ.intVal  = dExt.intVal;
+				dQ.sat     = dExt.sat;
+			}
+		}
+		printf("gains %5u/%5u/%5u/%5u: kP_q %10d kI_q %10d kD_q %10d >> %2u, %ld of %ld steps differ\n",
+				Gains[g].kP_scld, Gains[g].kI_scld, Gains[g].kD_scld, Gains[g].nScale,
+				qGain.kP_q, qGain.kI_q, qGain.kD_q, qGain.nShift, bad, N_STEPS);
+		HT_CHECK(0 == bad, "PIDq differs from PIDext in %ld steps for gain set %u", bad, g);
+	}
+	HT_CHECK(ERR_PARAM_VALUE == PID_Cvt_GainToQ(&(PID_Gain_t){1u, 1u, 1u, 0u, 1u}, &qGain), "zero scaling accepted");
+}
+
+static void Test_Batch(void)
+{
+	int32_t aSet[4], aAct[4], aBatch[4], u;
+	long k, bad = 0;
+	int i;
+
+	PID_Init();
+	for(k = 0; k < N_STEPS/10; k++)
+	{
+		for(i = 0; i < 4; i++)
+		{
+			aSet[i] = RandVal(8000);
+			aAct[i] = RandVal(8000);
+		}
+		PID_Batch(PID_ID_SPD_LE, 4u, aSet, aAct, NULL, aBatch);
+		for(i = 0; i < 4; i++)
+		{
+			PID(aSet[i], aAct[i], 4u + i, &u);
+			bad += (u != aBatch[i]);
+		}
+	}
+	printf("PID_Batch: %ld of %ld control values differ from PID\n", bad, 4*(N_STEPS/10));
+	HT_CHECK(0 == bad, "PID_Batch differs from PID in %ld values", bad);
+	HT_CHECK(ERR_PARAM_INDEX == PID_Batch(6u, 4u, aSet, aAct, NULL, aBatch), "batch beyond the table accepted");
+}
+
+static void Bench(void)
+{
+	static volatile int32_t sink;
+	(void)sink;
+	PID_QGain_t qGain;
+	PID_Data_t data = {0};
+	int32_t aSet[4] = {0}, aAct[4] = {0}, aCtrl[4], u = 0;
+	double tExt, tQ, tPid, tBatch;
+
+	PID_Cvt_GainToQ(&Gains[0], &qGain);
+	HT_TIME(tExt,   N_BENCH, (PIDext(ht_i_ & 1023, (ht_i_ >> 3) & 1023, &Gains[0], &data, &u), sink = u));
+	HT_TIME(tQ,     N_BENCH, (PIDq(ht_i_ & 1023, (ht_i_ >> 3) & 1023, &qGain, &data, &u), sink = u));
+	HT_TIME(tPid,   N_BENCH/4, (PID(ht_i_ & 1023, 0, 0u, &u), PID(ht_i_ & 1023, 0, 1u, &u),
+								PID(ht_i_ & 1023, 0, 2u, &u), PID(ht_i_ & 1023, 0, 3u, &u), sink = u));
+	HT_TIME(tBatch, N_BENCH/4, (aSet[0] = aSet[1] = aSet[2] = aSet[3] = ht_i_ & 1023,
+								PID_Batch(0u, 4u, aSet, aAct, NULL, aCtrl), sink = aCtrl[0]));
+	printf("time per call [ns]: PIDext %.1f, PIDq %.1f, 4x PID %.1f, PID_Batch of 4 %.1f\n", tExt, tQ, tPid, tBatch);
+}
+
+
+int main(void)
+{
+	HT_Seed(31u);
+	Test_BitExact();
+	Test_Batch();
+	Bench();
+	return HT_Result();
+}
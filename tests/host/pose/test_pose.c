@@ -0,0 +1,196 @@
+/***********************************************************************************************//**
+ * @file		test_pose.c
+ * @ingroup		test
+ * @brief 		Host tests of the dead reckoning of the SWC @a pose
+ *
+ * Drives simulated wheels on straight lines, arcs and turns on the spot and compares the pose
+ * read from the SWC with a double-precision integration of the same wheel increments along exact
+ * circular arcs. The position has to match within 1 mm and the heading within 0.1 deg, which is
+ * the resolution of both read functions.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	16.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#include "host_test.h"
+#include "Platform.h"
+#include "pose.h"
+#include "pose_api.h"
+#include "tacho_api.h"
+
+#define DT				(TACHO_SAMPLE_PERIOD_MS / 1000.0)
+#define MM_PER_STEP		(M_PI * CAU_SUMO_WHEEL_DIAMETER / CAU_SUMO_STEPS_PER_REV_AT_WHEEL)
+#define POS_TOL_MM		(1.0)
+#define HDG_TOL_DEG		(0.1)
+#define N_BENCH			(2000000ul)
+
+static double SimPos[TACHO_ID_CNT];		/* simulated wheel positions in steps */
+static int32_t SimCnt[TACHO_ID_CNT];	/* counter values read by the SWC */
+static double RefX, RefY, RefHdg;		/* reference pose in [mm] and [rad] */
+
+
+/*========================================= tacho stubs ==========================================*/
+StdRtn_t TACHO_Read_PosLe(int32_t *pos_) { *pos_ = SimCnt[TACHO_ID_LEFT];  return ERR_OK; }
+StdRtn_t TACHO_Read_PosRi(int32_t *pos_) { *pos_ = SimCnt[TACHO_ID_RIGHT]; return ERR_OK; }
+
+
+/*============================================ helpers ===========================================*/
+static void Restart(void)
+{
+	SimPos[TACHO_ID_LEFT] = SimPos[TACHO_ID_RIGHT] = 0.0;
+	SimCnt[TACHO_ID_LEFT] = SimCnt[TACHO_ID_RIGHT] = 0;
+	RefX = RefY = RefHdg = 0.0;
+	POSE_Init(NULL);
+}
+
+/* moves the wheels by one sample, the reference follows the exact arc of the counted increments */
+static void Step(double spdLe_, double spdRi_)
+{
+	int32_t cntLe = 0, cntRi = 0;
+	double dS = 0.0, dHdg = 0.0, chord = 0.0;
+
+	SimPos[TACHO_ID_LEFT]  += spdLe_ * DT;
+	SimPos[TACHO_ID_RIGHT] += spdRi_ * DT;
+	cntLe = (int32_t)lround(SimPos[TACHO_ID_LEFT]);
+	cntRi = (int32_t)lround(SimPos[TACHO_ID_RIGHT]);
+
+	dS    = 0.5 * (cntLe - SimCnt[TACHO_ID_LEFT] + cntRi - SimCnt[TACHO_ID_RIGHT]) * MM_PER_STEP;
+	dHdg  = (cntRi - SimCnt[TACHO_ID_RIGHT] - cntLe + SimCnt[TACHO_ID_LEFT]) * MM_PER_STEP / CAU_SUMO_AXIS_LENGTH;
+	chord = (0.0 != dHdg) ? dS * sin(0.5 * dHdg) / (0.5 * dHdg) : dS;
+	RefX   += chord * cos(RefHdg + 0.5 * dHdg);
+	RefY   += chord * sin(RefHdg + 0.5 * dHdg);
+	RefHdg += dHdg;
+
+	SimCnt[TACHO_ID_LEFT]  = cntLe;
+	SimCnt[TACHO_ID_RIGHT] = cntRi;
+	POSE_MainFct();
+}
+
+/* drives with constant wheel speeds in [steps/s] for the time tms_, returns the max errors */
+static void Drive(double spdLe_, double spdRi_, unsigned tms_, double *posErr_, double *hdgErr_)
+{
+	unsigned k;
+	int32_t x = 0, y = 0;
+	int16_t hdg = 0;
+	double refDeg = 0.0, dDeg = 0.0;
+
+	for(k = 0u; k < tms_ / TACHO_SAMPLE_PERIOD_MS; k++)
+	{
+		Step(spdLe_, spdRi_);
+		POSE_Read_PosX(&x);
+		POSE_Read_PosY(&y);
+		POSE_Read_Hdg(&hdg);
+		refDeg = remainder(RefHdg * 180.0 / M_PI, 360.0);
+		dDeg   = remainder(hdg / 10.0 - refDeg, 360.0);
+		*posErr_ = fmax(*posErr_, hypot(x - RefX, y - RefY));
+		*hdgErr_ = fmax(*hdgErr_, fabs(dDeg));
+	}
+}
+
+static void Report(const char *name_, double posErr_, double hdgErr_)
+{
+	printf("%-34s: x %8.1f mm, y %8.1f mm, hdg %7.1f deg, max error %.2f mm, %.4f deg\n",
+			name_, RefX, RefY, remainder(RefHdg * 180.0 / M_PI, 360.0), posErr_, hdgErr_);
+	HT_CHECK(posErr_ <= POS_TOL_MM, "%s: position off by %.2f mm", name_, posErr_);
+	HT_CHECK(hdgErr_ <= HDG_TOL_DEG, "%s: heading off by %.3f deg", name_, hdgErr_);
+}
+
+
+/*============================================= tests ============================================*/
+static void Test_Straight(void)
+{
+	double posErr = 0.0, hdgErr = 0.0;
+	int32_t y = 0;
+
+	Restart();
+	Drive(4000.0, 4000.0, 5000u, &posErr, &hdgErr);
+	POSE_Read_PosY(&y);
+	HT_CHECK(0 == y, "straight line drifted to y = %d mm", y);
+	Drive(-1234.5, -1234.5, 8000u, &posErr, &hdgErr);
+	Report("straight forward and back", posErr, hdgErr);
+}
+
+static void Test_Arc(void)
+{
+	double posErr = 0.0, hdgErr = 0.0;
+
+	Restart();
+	Drive(1000.0, 3000.0, 20000u, &posErr, &hdgErr);
+	Report("arcs to the left, 3.5 turns", posErr, hdgErr);
+
+	posErr = hdgErr = 0.0;
+	Restart();
+	Drive(4200.0, 3700.0, 30000u, &posErr, &hdgErr);
+	Drive(-2500.0, -500.0, 10000u, &posErr, &hdgErr);
+	Report("wide arc right, back left", posErr, hdgErr);
+}
+
+static void Test_Spin(void)
+{
+	double posErr = 0.0, hdgErr = 0.0;
+	int32_t x = 0, y = 0;
+
+	Restart();
+	Drive(-2000.0, 2000.0, 15000u, &posErr, &hdgErr);
+	Drive(3000.0, -3000.0, 4000u, &posErr, &hdgErr);
+	POSE_Read_PosX(&x);
+	POSE_Read_PosY(&y);
+	HT_CHECK((0 == x) && (0 == y), "spin in place moved to (%d, %d) mm", x, y);
+	Report("spin in place, both directions", posErr, hdgErr);
+}
+
+static void Test_Random(void)
+{
+	double posErr = 0.0, hdgErr = 0.0;
+	int i;
+
+	Restart();
+	for(i = 0; i < 200; i++)
+	{
+		Drive(HT_Uniform(-4400.0, 4400.0), HT_Uniform(-4400.0, 4400.0), 50u + (HT_Rand() % 500u), &posErr, &hdgErr);
+	}
+	Report("200 random segments", posErr, hdgErr);
+}
+
+static void Test_Reset(void)
+{
+	double posErr = 0.0, hdgErr = 0.0;
+	int32_t x = -1, y = -1;
+	int16_t hdg = -1;
+
+	Restart();
+	Drive(1000.0, 3000.0, 2000u, &posErr, &hdgErr);
+	HT_CHECK(ERR_OK == POSE_Set_RstReq(), "reset request refused");
+	POSE_MainFct();
+	POSE_Read_PosX(&x);
+	POSE_Read_PosY(&y);
+	POSE_Read_Hdg(&hdg);
+	HT_CHECK((0 == x) && (0 == y) && (0 == hdg), "reset gives (%d, %d) mm at %d", x, y, hdg);
+	HT_CHECK(ERR_PARAM_ADDRESS == POSE_Read_PosX(NULL), "NULL accepted");
+	HT_CHECK(ERR_PARAM_ADDRESS == POSE_Read_Hdg(NULL), "NULL accepted");
+}
+
+static void Bench(void)
+{
+	double t;
+
+	Restart();
+	HT_TIME(t, N_BENCH, (SimCnt[TACHO_ID_LEFT] += 7, SimCnt[TACHO_ID_RIGHT] += 11, POSE_MainFct()));
+	printf("POSE_MainFct: %.1f ns per call\n", t);
+}
+
+
+int main(void)
+{
+	HT_Seed(30u);
+	Test_Straight();
+	Test_Arc();
+	Test_Spin();
+	Test_Random();
+	Test_Reset();
+	Bench();
+	return HT_Result();
+}
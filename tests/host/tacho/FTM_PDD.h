@@ -0,0 +1,36 @@
+/***********************************************************************************************//**
+ * @file		FTM_PDD.h
+ * @ingroup		test
+ * @brief 		Host replacement of the FlexTimer PDD macros used by the SWC @a tacho
+ *
+ * The macros access the register model of IO_Map.h with the side effects of the hardware: QUADIR
+ * and TOFDIR are read-only, TOF is cleared by writing 0 after it was read as 1, and any write to
+ * CNT loads CNTIN.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#ifndef FTM_PDD_H_
+#define FTM_PDD_H_
+
+#include "IO_Map.h"
+
+#define FTM_QDCTRL_RO_MASK	(FTM_QDCTRL_TOFDIR_MASK | FTM_QDCTRL_QUADIR_MASK)
+
+#define FTM_PDD_WriteStatusControlReg(b_, v_) \
+	((b_)->SC = ((v_) & ~FTM_SC_TOF_MASK) | ((b_)->SC & (v_) & FTM_SC_TOF_MASK))
+#define FTM_PDD_WriteFeaturesModeReg(b_, v_)		((b_)->MODE = (v_))
+#define FTM_PDD_WriteModuloReg(b_, v_)				((b_)->MOD = (uint32_t)(v_) & 0xFFFFu)
+#define FTM_PDD_WriteInitialValueReg(b_, v_)		((b_)->CNTIN = (uint32_t)(v_) & 0xFFFFu)
+#define FTM_PDD_WriteFilterReg(b_, v_)				((b_)->FILTER = (v_))
+#define FTM_PDD_WriteQuadratureDecoderReg(b_, v_) \
+	((b_)->QDCTRL = ((v_) & ~FTM_QDCTRL_RO_MASK) | ((b_)->QDCTRL & FTM_QDCTRL_RO_MASK))
+#define FTM_PDD_ReadQuadratureDecoderReg(b_)		((b_)->QDCTRL)
+#define FTM_PDD_InitializeCounter(b_)				((b_)->CNT = (b_)->CNTIN)
+#define FTM_PDD_ReadCounterReg(b_)					((b_)->numCntRd++, (b_)->CNT)
+
+#endif /* !FTM_PDD_H_ */
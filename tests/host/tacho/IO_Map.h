@@ -0,0 +1,75 @@
+/***********************************************************************************************//**
+ * @file		IO_Map.h
+ * @ingroup		test
+ * @brief 		Host register model of the FlexTimers, SIM and PORT of the MK22F for the tests of
+ * 				the SWC @a tacho
+ *
+ * Replaces the peripheral memory map of Processor Expert by variables of ftm_model.c. Only the
+ * registers and bits used by tacho_qd.c are modelled, the FlexTimers FTM0...FTM3 are there so the
+ * tests can check that the quadrature decoders leave the PWM of FTM0 and the counter of RefCnt
+ * on FTM3 alone.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#ifndef IO_MAP_H_
+#define IO_MAP_H_
+
+#include <stdint.h>
+
+typedef struct FTM_MemMap
+{
+	uint32_t SC, CNT, MOD, CNTIN, MODE, QDCTRL, FILTER;
+	/* state of the model, not registers */
+	int inA, inB;				/* filtered levels of the phases */
+	unsigned long numCntRd;		/* reads of CNT */
+} volatile *FTM_MemMapPtr;
+
+typedef struct PORT_MemMap
+{
+	uint32_t PCR[32];
+} volatile *PORT_MemMapPtr;
+
+#define FTM_MDL_CNT					(4)
+
+extern struct FTM_MemMap FtmMdl[FTM_MDL_CNT];
+extern struct PORT_MemMap PortAMdl, PortBMdl;
+extern uint32_t SimScgc5Mdl, SimScgc6Mdl;
+
+#define FTM0_BASE_PTR				((FTM_MemMapPtr)&FtmMdl[0])
+#define FTM1_BASE_PTR				((FTM_MemMapPtr)&FtmMdl[1])
+#define FTM2_BASE_PTR				((FTM_MemMapPtr)&FtmMdl[2])
+#define FTM3_BASE_PTR				((FTM_MemMapPtr)&FtmMdl[3])
+#define PORTA_BASE_PTR				((PORT_MemMapPtr)&PortAMdl)
+#define PORTB_BASE_PTR				((PORT_MemMapPtr)&PortBMdl)
+
+#define SIM_SCGC5					SimScgc5Mdl
+#define SIM_SCGC6					SimScgc6Mdl
+#define SIM_SCGC5_PORTA_MASK		(0x200u)
+#define SIM_SCGC5_PORTB_MASK		(0x400u)
+#define SIM_SCGC6_FTM0_MASK			(0x1000000u)
+#define SIM_SCGC6_FTM1_MASK			(0x2000000u)
+#define SIM_SCGC6_FTM2_MASK			(0x4000000u)
+
+#define FTM_SC_PS(x)				((uint32_t)(x) & 0x7u)
+#define FTM_SC_CLKS_MASK			(0x18u)
+#define FTM_SC_CLKS(x)				(((uint32_t)(x) << 3) & FTM_SC_CLKS_MASK)
+#define FTM_SC_TOF_MASK				(0x80u)
+#define FTM_MODE_FTMEN_MASK			(0x1u)
+#define FTM_MODE_WPDIS_MASK			(0x4u)
+#define FTM_QDCTRL_QUADEN_MASK		(0x1u)
+#define FTM_QDCTRL_TOFDIR_MASK		(0x2u)
+#define FTM_QDCTRL_QUADIR_MASK		(0x4u)
+#define FTM_QDCTRL_QUADMODE_MASK	(0x8u)
+#define FTM_QDCTRL_PHBPOL_MASK		(0x10u)
+#define FTM_QDCTRL_PHAPOL_MASK		(0x20u)
+#define FTM_QDCTRL_PHBFLTREN_MASK	(0x40u)
+#define FTM_QDCTRL_PHAFLTREN_MASK	(0x80u)
+#define FTM_FILTER_CH0FVAL(x)		((uint32_t)(x) & 0xFu)
+#define FTM_FILTER_CH1FVAL(x)		(((uint32_t)(x) << 4) & 0xF0u)
+
+#endif /* !IO_MAP_H_ */
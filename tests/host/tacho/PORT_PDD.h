@@ -0,0 +1,25 @@
+/***********************************************************************************************//**
+ * @file		PORT_PDD.h
+ * @ingroup		test
+ * @brief 		Host replacement of the PORT PDD macros used by the SWC @a tacho
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#ifndef PORT_PDD_H_
+#define PORT_PDD_H_
+
+#include "IO_Map.h"
+
+#define PORT_PDD_MUX_CONTROL_MASK	(0x700u)
+#define PORT_PDD_MUX_CONTROL_ALT6	(0x600u)
+#define PORT_PDD_MUX_CONTROL_ALT7	(0x700u)
+
+#define PORT_PDD_SetPinMuxControl(b_, pin_, mux_) \
+	((b_)->PCR[(pin_)] = ((b_)->PCR[(pin_)] & ~PORT_PDD_MUX_CONTROL_MASK) | (mux_))
+
+#endif /* !PORT_PDD_H_ */
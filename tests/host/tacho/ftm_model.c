@@ -0,0 +1,86 @@
+/***********************************************************************************************//**
+ * @file		ftm_model.c
+ * @ingroup		test
+ * @brief 		Host model of the quadrature decoder of the FlexTimer for the tests of the SWC @a tacho
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#include <string.h>
+#include "ftm_model.h"
+
+struct FTM_MemMap FtmMdl[FTM_MDL_CNT];
+struct PORT_MemMap PortAMdl, PortBMdl;
+uint32_t SimScgc5Mdl, SimScgc6Mdl;
+
+/* index of the phase levels in the order 00, 10, 11, 01 of a forward turn */
+static int Phase_Idx(int a_, int b_)
+{
+	static const int aIdx[4] = {0, 3, 1, 2};
+
+	return aIdx[(a_ << 1) | b_];
+}
+
+void FTM_MDL_Reset(void)
+{
+	memset(FtmMdl, 0, sizeof(FtmMdl));
+	memset(&PortAMdl, 0, sizeof(PortAMdl));
+	memset(&PortBMdl, 0, sizeof(PortBMdl));
+	SimScgc5Mdl = SimScgc6Mdl = 0u;
+}
+
+void FTM_MDL_Input(FTM_MemMapPtr pFtm_, int a_, int b_, unsigned int holdCyc_)
+{
+	int a = pFtm_->inA, b = pFtm_->inB, d = 0;
+
+	if((0u == (pFtm_->SC & FTM_SC_CLKS_MASK)) || (0u == (pFtm_->QDCTRL & FTM_QDCTRL_QUADEN_MASK))
+			|| (0u == (pFtm_->MODE & FTM_MODE_FTMEN_MASK)))
+	{
+		return;
+	}
+	a_ = (0u != (pFtm_->QDCTRL & FTM_QDCTRL_PHAPOL_MASK)) ? !a_ : a_;
+	b_ = (0u != (pFtm_->QDCTRL & FTM_QDCTRL_PHBPOL_MASK)) ? !b_ : b_;
+	if((0u == (pFtm_->QDCTRL & FTM_QDCTRL_PHAFLTREN_MASK)) || (holdCyc_ >= 4u * (pFtm_->FILTER & 0xFu)))
+	{
+		a = a_;
+	}
+	if((0u == (pFtm_->QDCTRL & FTM_QDCTRL_PHBFLTREN_MASK)) || (holdCyc_ >= 4u * ((pFtm_->FILTER >> 4) & 0xFu)))
+	{
+		b = b_;
+	}
+	d = (Phase_Idx(a, b) - Phase_Idx(pFtm_->inA, pFtm_->inB)) & 3;
+	pFtm_->inA = a;
+	pFtm_->inB = b;
+	if(1 == d)
+	{
+		pFtm_->QDCTRL |= FTM_QDCTRL_QUADIR_MASK;
+		if(pFtm_->CNT == pFtm_->MOD)
+		{
+			pFtm_->CNT     = pFtm_->CNTIN;
+			pFtm_->SC     |= FTM_SC_TOF_MASK;
+			pFtm_->QDCTRL |= FTM_QDCTRL_TOFDIR_MASK;
+		}
+		else
+		{
+			pFtm_->CNT = (pFtm_->CNT + 1u) & 0xFFFFu;
+		}
+	}
+	else if(3 == d)
+	{
+		pFtm_->QDCTRL &= ~FTM_QDCTRL_QUADIR_MASK;
+		if(pFtm_->CNT == pFtm_->CNTIN)
+		{
+			pFtm_->CNT     = pFtm_->MOD;
+			pFtm_->SC     |= FTM_SC_TOF_MASK;
+			pFtm_->QDCTRL &= ~FTM_QDCTRL_TOFDIR_MASK;
+		}
+		else
+		{
+			pFtm_->CNT = (pFtm_->CNT - 1u) & 0xFFFFu;
+		}
+	}
+}
@@ -0,0 +1,30 @@
+/***********************************************************************************************//**
+ * @file		ftm_model.h
+ * @ingroup		test
+ * @brief 		Host model of the quadrature decoder of the FlexTimer for the tests of the SWC @a tacho
+ *
+ * Models the counter of a FlexTimer in quadrature decoder mode with phase A/B encoding: each edge
+ * of both phases counts, the digital filter suppresses pulses shorter than 4*FVAL cycles of the
+ * bus clock, the polarity bits invert the phases, and the counter wraps between CNTIN and MOD
+ * with TOF, TOFDIR and QUADIR set like the hardware does.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#ifndef FTM_MODEL_H_
+#define FTM_MODEL_H_
+
+#include "IO_Map.h"
+
+/* resets all registers of the model */
+void FTM_MDL_Reset(void);
+
+/* applies the levels a_ and b_ of the phases, which stay stable for holdCyc_ cycles of the bus
+ * clock, the counter only counts if it is clocked and in quadrature decoder mode */
+void FTM_MDL_Input(FTM_MemMapPtr pFtm_, int a_, int b_, unsigned int holdCyc_);
+
+#endif /* !FTM_MODEL_H_ */
@@ -0,0 +1,225 @@
+/***********************************************************************************************//**
+ * @file		test_tacho_qd.c
+ * @ingroup		test
+ * @brief 		Host tests of the quadrature decoder backend of the SWC @a tacho
+ *
+ * Runs tacho_qd.c against the register model of the FlexTimers of ftm_model.c. Two encoders turn
+ * the wheels step by step, forward and backward over several overflows of the 16 bit counters and
+ * in a random walk with glitches shorter than the input filter, the positions read by
+ * TACHO_QD_Get_Pos must follow them exactly. Checks the limit of the extension to 32 bit, setting
+ * the position, the inverted counting direction and that only FTM1 and FTM2 are used, FTM0 runs the
+ * PWM of the motors and FTM3 the counter RefCnt of the reflectance sensors.
+ *
+ * @author 	G. Freudenthaler, gefr@tf.uni-kiel.de, Chair of Automatic Control, University Kiel
+ * @date 	23.04.2018
+ *
+ * @copyright @LGPL2_1
+ *
+ **************************************************************************************************/
+
+#include <string.h>
+#include "host_test.h"
+#include "ftm_model.h"
+#include "PORT_PDD.h"
+#include "tacho_qd.h"
+
+#define HOLD_CYC		(100u)		/* phases stable for much longer than the filter */
+
+/* an encoder at the phase pIdx in the order of a forward turn and the true position of its wheel */
+typedef struct Enc_s
+{
+	FTM_MemMapPtr pFtm;
+	int pIdx;
+	long pos;
+} Enc_t;
+
+static const int aPhA[4] = {0, 1, 1, 0}, aPhB[4] = {0, 0, 1, 1};
+static Enc_t EncLe, EncRi;
+
+static void Enc_Step(Enc_t *pEnc_, int dir_)
+{
+	pEnc_->pIdx = (pEnc_->pIdx + ((0 < dir_) ? 1 : 3)) & 3;
+	pEnc_->pos += dir_;
+	FTM_MDL_Input(pEnc_->pFtm, aPhA[pEnc_->pIdx], aPhB[pEnc_->pIdx], HOLD_CYC);
+}
+
+static void Enc_Steps(Enc_t *pEnc_, int dir_, long n_)
+{
+	long i = 0;
+
+	for(i = 0; i < n_; i++)
+	{
+		Enc_Step(pEnc_, dir_);
+	}
+}
+
+/* a pulse to the next phase, one cycle shorter than the filter of tacho_qd.h */
+static void Enc_Glitch(Enc_t *pEnc_)
+{
+	int pIdx = (pEnc_->pIdx + 1) & 3;
+
+	FTM_MDL_Input(pEnc_->pFtm, aPhA[pIdx], aPhB[pIdx], 4u * TACHO_QD_FLTR_VAL - 1u);
+	FTM_MDL_Input(pEnc_->pFtm, aPhA[pEnc_->pIdx], aPhB[pEnc_->pIdx], HOLD_CYC);
+}
+
+/* overflows of the counter since the last call */
+static unsigned int Clr_Tof(FTM_MemMapPtr pFtm_)
+{
+	unsigned int tof = (0u != (pFtm_->SC & FTM_SC_TOF_MASK)) ? 1u : 0u;
+
+	pFtm_->SC &= ~FTM_SC_TOF_MASK;
+	return tof;
+}
+
+
+/*============================================= tests ============================================*/
+static void Test_Init(void)
+{
+	FTM_MDL_Reset();
+	HT_CHECK((0 == TACHO_QD_Get_Pos(TACHO_ID_LEFT)) && (0u == FTM1_BASE_PTR->numCntRd), "counter read before the initialization");
+	/* the counters come up with arbitrary values */
+	FTM1_BASE_PTR->CNT = 0x1234u;
+	FTM2_BASE_PTR->CNT = 0xFFF0u;
+	TACHO_QD_Init();
+	EncLe = (Enc_t){FTM1_BASE_PTR, 0, 0};
+	EncRi = (Enc_t){FTM2_BASE_PTR, 0, 0};
+	HT_CHECK((PORT_PDD_MUX_CONTROL_ALT7 == (PortAMdl.PCR[12] & PORT_PDD_MUX_CONTROL_MASK)) && (PORT_PDD_MUX_CONTROL_ALT7 == (PortAMdl.PCR[13] & PORT_PDD_MUX_CONTROL_MASK)),
+			"left phases not routed to FTM1");
+	HT_CHECK((PORT_PDD_MUX_CONTROL_ALT6 == (PortBMdl.PCR[18] & PORT_PDD_MUX_CONTROL_MASK)) && (PORT_PDD_MUX_CONTROL_ALT6 == (PortBMdl.PCR[19] & PORT_PDD_MUX_CONTROL_MASK)),
+			"right phases not routed to FTM2");
+	HT_CHECK((0xFFFFu == FTM1_BASE_PTR->MOD) && (0u == FTM1_BASE_PTR->CNTIN) && (0u == FTM1_BASE_PTR->CNT), "counter of FTM1 not initialized");
+	HT_CHECK((0xFFFFu == FTM2_BASE_PTR->MOD) && (0u == FTM2_BASE_PTR->CNTIN) && (0u == FTM2_BASE_PTR->CNT), "counter of FTM2 not initialized");
+	HT_CHECK((0 == TACHO_QD_Get_Pos(TACHO_ID_LEFT)) && (0 == TACHO_QD_Get_Pos(TACHO_ID_RIGHT)), "position not 0 after the initialization");
+}
+
+/* FTM0 is the PWM of the motors and FTM3 the counter RefCnt, see ProcessorExpert.pe */
+static void Test_Alloc(void)
+{
+	static const struct FTM_MemMap ftmRst;
+
+	HT_CHECK((SIM_SCGC6_FTM1_MASK | SIM_SCGC6_FTM2_MASK) == SimScgc6Mdl, "clock gates 0x%08x instead of FTM1 and FTM2",
+			(unsigned int)SimScgc6Mdl);
+	HT_CHECK(0 == memcmp((const void *)FTM0_BASE_PTR, &ftmRst, sizeof(ftmRst)), "FTM0 of the PWM changed");
+	HT_CHECK(0 == memcmp((const void *)FTM3_BASE_PTR, &ftmRst, sizeof(ftmRst)), "FTM3 of RefCnt changed");
+}
+
+static void Test_Fwd(void)
+{
+	unsigned int numTof = 0u;
+	long i = 0;
+
+	for(i = 0; i < 200000; i++)
+	{
+		Enc_Step(&EncLe, 1);
+		Enc_Step(&EncRi, 1);
+		numTof += Clr_Tof(EncLe.pFtm);
+		if(0 == i % 1000)
+		{
+			(void)TACHO_QD_Get_Pos(TACHO_ID_LEFT);
+			(void)TACHO_QD_Get_Pos(TACHO_ID_RIGHT);
+		}
+	}
+	printf("forward: %ld steps with %u overflows, position %ld/%ld\n", EncLe.pos, numTof,
+			(long)TACHO_QD_Get_Pos(TACHO_ID_LEFT), (long)TACHO_QD_Get_Pos(TACHO_ID_RIGHT));
+	HT_CHECK(EncLe.pos == TACHO_QD_Get_Pos(TACHO_ID_LEFT), "left position %ld instead of %ld", (long)TACHO_QD_Get_Pos(TACHO_ID_LEFT), EncLe.pos);
+	HT_CHECK(EncRi.pos == TACHO_QD_Get_Pos(TACHO_ID_RIGHT), "right position %ld instead of %ld", (long)TACHO_QD_Get_Pos(TACHO_ID_RIGHT), EncRi.pos);
+	HT_CHECK(3u == numTof, "%u overflows", numTof);
+	HT_CHECK((0u != (EncLe.pFtm->QDCTRL & FTM_QDCTRL_QUADIR_MASK)) && (0u != (EncLe.pFtm->QDCTRL & FTM_QDCTRL_TOFDIR_MASK)),
+			"counting direction not up");
+}
+
+/* backward through 0 to negative positions */
+static void Test_Bwd(void)
+{
+	unsigned int numTof = 0u;
+	long i = 0;
+
+	for(i = 0; i < 330000; i++)
+	{
+		Enc_Step(&EncLe, -1);
+		numTof += Clr_Tof(EncLe.pFtm);
+		if(0 == i % 20000)
+		{
+			(void)TACHO_QD_Get_Pos(TACHO_ID_LEFT);
+		}
+	}
+	printf("backward: 330000 steps with %u underflows, position %ld\n", numTof, (long)TACHO_QD_Get_Pos(TACHO_ID_LEFT));
+	HT_CHECK(EncLe.pos == TACHO_QD_Get_Pos(TACHO_ID_LEFT), "position %ld instead of %ld", (long)TACHO_QD_Get_Pos(TACHO_ID_LEFT), EncLe.pos);
+	HT_CHECK((0u == (EncLe.pFtm->QDCTRL & FTM_QDCTRL_QUADIR_MASK)) && (0u == (EncLe.pFtm->QDCTRL & FTM_QDCTRL_TOFDIR_MASK)),
+			"counting direction not down");
+}
+
+/* random walk with glitches, the reads are at most 32767 steps apart */
+static void Test_Walk(void)
+{
+	long n = 0, i = 0, gap = 0, numBad = 0;
+	int dir = 0;
+
+	HT_Seed(50u);
+	for(n = 0; n < 2000; n++)
+	{
+		gap = 1 + (long)(HT_Rand() % 32767u);
+		dir = (HT_Rand() & 1u) ? 1 : -1;
+		for(i = 0; i < gap; i++)
+		{
+			Enc_Step(&EncRi, (0u != HT_Rand() % 8u) ? dir : -dir);
+			if(0u == HT_Rand() % 16u)
+			{
+				Enc_Glitch(&EncRi);
+			}
+		}
+		numBad += (EncRi.pos != TACHO_QD_Get_Pos(TACHO_ID_RIGHT)) ? 1 : 0;
+	}
+	printf("random walk: %ld of 2000 reads differ, position %ld\n", numBad, (long)TACHO_QD_Get_Pos(TACHO_ID_RIGHT));
+	HT_CHECK(0 == numBad, "%ld reads differ", numBad);
+}
+
+/* 32768 steps between two reads alias to -32768 */
+static void Test_Lim(void)
+{
+	Enc_Steps(&EncRi, 1, 32767);
+	HT_CHECK(EncRi.pos == TACHO_QD_Get_Pos(TACHO_ID_RIGHT), "32767 steps between two reads lost");
+	Enc_Steps(&EncRi, 1, 32768);
+	HT_CHECK(EncRi.pos - 65536 == TACHO_QD_Get_Pos(TACHO_ID_RIGHT), "error %ld after 32768 steps between two reads",
+			(long)TACHO_QD_Get_Pos(TACHO_ID_RIGHT) - EncRi.pos);
+	EncRi.pos = TACHO_QD_Get_Pos(TACHO_ID_RIGHT);
+}
+
+static void Test_SetPos(void)
+{
+	TACHO_QD_Set_Pos(TACHO_ID_LEFT, 1000000);
+	EncLe.pos = 1000000;
+	Enc_Steps(&EncLe, -1, 5000);
+	HT_CHECK(EncLe.pos == TACHO_QD_Get_Pos(TACHO_ID_LEFT), "position %ld instead of %ld", (long)TACHO_QD_Get_Pos(TACHO_ID_LEFT), EncLe.pos);
+	TACHO_QD_Set_Pos(TACHO_ID_LEFT, 0x7FFFFFF0);
+	EncLe.pos = 0x7FFFFFF0;
+	Enc_Steps(&EncLe, 1, 10);
+	HT_CHECK(EncLe.pos == TACHO_QD_Get_Pos(TACHO_ID_LEFT), "position %ld instead of %ld", (long)TACHO_QD_Get_Pos(TACHO_ID_LEFT), EncLe.pos);
+	HT_CHECK(0 == TACHO_QD_Get_Pos((TACHO_ID_t)TACHO_ID_CNT), "position of an invalid wheel");
+}
+
+/* the inverted phase B of TACHO_QD_xx_INV counts backward */
+static void Test_Inv(void)
+{
+	EncLe.pFtm->QDCTRL |= FTM_QDCTRL_PHBPOL_MASK;
+	/* the change of the polarity is an edge itself */
+	EncLe.pIdx = (EncLe.pIdx + 1) & 3;
+	Enc_Step(&EncLe, -1);
+	TACHO_QD_Set_Pos(TACHO_ID_LEFT, 0);
+	Enc_Steps(&EncLe, 1, 100);
+	HT_CHECK(-100 == TACHO_QD_Get_Pos(TACHO_ID_LEFT), "position %ld instead of -100", (long)TACHO_QD_Get_Pos(TACHO_ID_LEFT));
+}
+
+
+int main(void)
+{
+	Test_Init();
+	Test_Alloc();
+	Test_Fwd();
+	Test_Bwd();
+	Test_Walk();
+	Test_Lim();
+	Test_SetPos();
+	Test_Inv();
+	return HT_Result();
+}